@@ -6,6 +6,7 @@ link is swept around a capacity for the HL3-HL5 scenario.
 
 
 
+import glob
 import os
 import time 
 
@@ -75,6 +76,24 @@ Budget = C - nnodes*SiteLimit
 
 BHswept = np.arange(25, (Budget/1e9)-5, 2.5)
 
+# Analytic screening (scratch/hl3-hl5screen.cc): only the points whose margin to the
+# feasibility boundary (utilization, or FH delay bound against FHDelayBudget) is within
+# ScreenMargin are simulated; the others keep the analytic result in screen.json
+Screening = True
+ScreenMargin = 0.05
+FHDelayBudget = 0  # us, 0 to screen on the utilization only
+
+
+def screen(jsonpath):
+    """Evaluate a scenario file with the analytic model and return its result."""
+    binaries = glob.glob("../build/scratch/ns3*-hl3-hl5screen*")
+    if not binaries:
+        subprocess.run(["../ns3", "build", "scratch/hl3-hl5screen"], check=True)
+        binaries = glob.glob("../build/scratch/ns3*-hl3-hl5screen*")
+    out = subprocess.run([binaries[0], f"--json={jsonpath}", f"--budget={FHDelayBudget}"],
+                         check=True, capture_output=True, text=True).stdout
+    return json.loads(out)
+
 
 def main():
     for du in DU_loc:
@@ -154,6 +173,14 @@ def main():
                             with open("../scratch/hl3-hl5ex.json", "w") as jsonFileReceiver:
                                 json.dump(data, jsonFileReceiver)
 
+                            if Screening:
+                                result = screen("../scratch/hl3-hl5ex.json")
+                                with open(f"../sim_results/{filename}{c}/screen.json", "w") as screenFile:
+                                    json.dump(result, screenFile)
+                                if abs(result["margin"]) > ScreenMargin:
+                                    print(f"Screened out {filename}{c}: margin {result['margin']:.3f}")
+                                    continue
+
                             cmd = "../ns3 run scratch/hl3-hl5theocombi.cc" 
                             os.system(cmd) 
                  
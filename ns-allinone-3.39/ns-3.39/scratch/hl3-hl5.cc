@@ -32,6 +32,8 @@
         std::ifstream f(JSONpath);
         json data = json::parse(f);
         uint32_t netMTU = data["netmtu"]; 
+        // the sources are connected UDP sockets over global routing (no ECMP): reuse their routes
+        Config::SetDefault("ns3::UdpSocketImpl::RouteCache", BooleanValue(data.value("UdpRouteCache", true)));
         bool enabletracing = true, enablepcap = false, enablehqos = data.at("EnableHQoS"), enableswitching = data.at("Enableswitching");
         bool enabletraceTimeStamps = data.at("EnableTraceTimeStamps");
         bool enablemodel = data.at("EnableModel");
@@ -491,9 +493,19 @@
         
 
 
+        // Optional "FlowMonitor": {"EndpointsOnly": bool, "SamplingRate": N,
+        // "BinsPerDecade": N, "Format": "xml" | "csv" | "binary"}
+        json fmConf = data.contains("FlowMonitor") ? data["FlowMonitor"] : json::object();
+        std::string fmFormat = fmConf.value("Format", "xml");
         Ptr<FlowMonitor> flowMonitor;
         FlowMonitorHelper flowHelper;
-        flowMonitor = flowHelper.InstallAll();
+        flowHelper.SetMonitorAttribute("SamplingRate", UintegerValue(fmConf.value("SamplingRate", 1)));
+        flowHelper.SetMonitorAttribute("HistogramBinsPerDecade", UintegerValue(fmConf.value("BinsPerDecade", 0)));
+        if (fmConf.value("EndpointsOnly", false)){
+            flowMonitor = flowHelper.InstallEndpoints();
+        } else {
+            flowMonitor = flowHelper.InstallAll();
+        }
 
 
         Ptr<PacketSink> Server_trace1 = StaticCast<PacketSink>(Server_appRU.Get(0));
@@ -504,10 +516,17 @@
         Simulator::Stop(Seconds(data.at("Seconds_sim")));
         Simulator::Schedule(Seconds(0), &PrintTotalRx, Server_trace1);
         Simulator::Run();
+        PrintFragmentationReport();
         Simulator::Destroy();
         
         std::cout << GREEN << "Simulation has finished" << RESET << std::endl;
-        flowMonitor->SerializeToXmlFile("./sim_results/DelayXml.xml", false, true);
+        if (fmFormat == "csv"){
+            flowMonitor->SerializeToCsvFile("./sim_results/Delay.csv", "./sim_results/DelayHistograms.csv");
+        } else if (fmFormat == "binary"){
+            flowMonitor->SerializeToBinaryFile("./sim_results/Delay.bin", true);
+        } else {
+            flowMonitor->SerializeToXmlFile("./sim_results/DelayXml.xml", false, true);
+        }
        
         // std::cout << MAGENTA << "INFO: " << RESET << "Sink: Total RX - " << Server_trace->GetTotalRx() << " bytes" << std::endl;
         return 0;
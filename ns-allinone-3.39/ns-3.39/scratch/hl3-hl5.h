@@ -26,6 +26,8 @@
     #include "ns3/udp-header.h"
     #include "ns3/traffic-control-module.h"
     #include "ns3/flow-monitor-helper.h"
+    #include "ns3/ipv4-flow-classifier.h"
+    #include "ns3/network-calculus-helper.h"
     #include "json.hpp"
     #include "logs.h"
 
@@ -173,6 +175,23 @@ void PrintTotalRx(Ptr<PacketSink> serverSink) {
         Simulator::Schedule(Seconds(Simulator::Now().GetSeconds()+0.01), &PrintTotalRx, serverSink);
     }
 
+    // Function to report the interfaces that fragmented or reassembled packets (MTU mismatches)
+void PrintFragmentationReport() {
+        for (uint32_t n = 0; n < NodeList::GetNNodes(); n++){
+            Ptr<Ipv4L3Protocol> ipv4 = NodeList::GetNode(n)->GetObject<Ipv4L3Protocol>();
+            if (!ipv4){
+                continue;
+            }
+            for (uint32_t i = 0; i < ipv4->GetNInterfaces(); i++){
+                const Ipv4Interface::FragmentationStats& stats = ipv4->GetInterface(i)->GetFragmentationStats();
+                if (stats.nFragmentedPackets > 0 || stats.nFragmentsReceived > 0){
+                    std::cout << BG_ORANGE << "WARNING:" << RESET << " Node " << n << " interface " << i
+                              << " (MTU " << ipv4->GetMtu(i) << "): " << stats << std::endl;
+                }
+            }
+        }
+    }
+
 
 
 void configureApplications(NodeContainer nodes, int FHnodes, int lastFHnode, const json& data, Ipv4InterfaceContainer DUAccess, Ipv4InterfaceContainer RUsAccess, Ipv4InterfaceContainer BHAccess ,int totnodes,
@@ -406,6 +425,78 @@ void configureAppPoisson(NodeContainer nodes, int FHnodes, int lastFHnode, const
     }
 
 
+/**
+ * DSCP marked by the MarkerQueueDisc on a destination port: "Marking_Port" maps
+ * the ports [p, p + 1000) to a DSCP, the other ports are marked EF (46).
+ * Without HQoS the packets are not marked.
+ */
+uint8_t markedDscp(const json& data, int port){
+    if (!data.at("EnableHQoS").get<bool>()){
+        return 0;
+    }
+    std::istringstream iss(data.at("Marking_Port").get<std::string>());
+    int first, dscp;
+    while (iss >> first >> dscp){
+        if (port >= first && port < first + 1000){
+            return dscp;
+        }
+    }
+    return 46;
+}
+
+/**
+ * Add the flows of configureApplications / configureAppPoisson to a
+ * NetworkCalculusHelper.  The flows are token buckets of their mean rate and a
+ * burst of "UBurstSize" (per cell) or "BurstSize" (per BH slice) bytes, one
+ * packet by default: Poisson sources are not token-bucket constrained, so the
+ * bounds only hold for the traffic that conforms to these buckets.
+ */
+void configureNetworkCalculus(NetworkCalculusHelper& calculus, NodeContainer nodes, int FHnodes, int lastFHnode, const json& data,
+    Ipv4InterfaceContainer RUsAccess, Ipv4InterfaceContainer BHAccess, int totnodes){
+        int port1 = 8080;
+        int port2 = 9090;
+        int portBH = 11000;
+        int napp = 0;
+        int site_inode = 1;
+        bool poisson = data.at("Poisson");
+        for (const auto& nodeagreggation : data["Hl5Agreggration"]) {
+            int DU_i = 0;
+            for (const auto& siteInfo : nodeagreggation["Sites"]) {
+                for (const auto& cellFeature : siteInfo["CellFeatures"]) {
+                    int nRU  =  (site_inode-1)*2 + 1;
+                    uint32_t uPacketSize = cellFeature["UPacketSize"].get<uint32_t>();
+                    double uBurst = cellFeature.value("UBurstSize", double(uPacketSize));
+                    calculus.AddFlow("FH" + std::to_string(napp), nodes.Get(totnodes+DU_i), RUsAccess.GetAddress(nRU, 0), port1 + napp,
+                                     cellFeature["URatenum"].get<double>(), uBurst, uPacketSize, markedDscp(data, port1 + napp));
+                    if (!poisson && cellFeature["CUPlane"].get<bool>()){
+                        uint32_t cPacketSize = cellFeature["CPacketSize"].get<uint32_t>();
+                        calculus.AddFlow("FHC" + std::to_string(napp), nodes.Get(totnodes+DU_i), RUsAccess.GetAddress(nRU, 0), port2 + napp,
+                                         cellFeature["CRatenum"].get<double>(), cPacketSize, cPacketSize, markedDscp(data, port2 + napp));
+                    }
+                    napp++;
+                }
+                site_inode++;
+                DU_i++;
+            }
+        }
+
+        if (data.value("Backhaulenable", false)) {
+            int slice_index = 0;
+            for (const auto& slice : data["BHFeatures"]) {
+                for (int flow = 0; flow < data["FlowsPerSlice"]; flow++) {
+                    int auxPort = portBH + slice_index * 1000 + flow;
+                    uint32_t packetSize = slice["PacketSize"].get<uint32_t>();
+                    double burst = slice.value("BurstSize", double(packetSize));
+                    calculus.AddFlow("BH" + std::to_string(slice_index) + "_" + std::to_string(flow), nodes.Get(lastFHnode + 1),
+                                     BHAccess.GetAddress(2, 0), auxPort, parseMbpsTo1e9(slice["Rate"]), burst, packetSize,
+                                     markedDscp(data, auxPort));
+                }
+                slice_index++;
+            }
+        }
+    }
+
+
 void tracerlogging(int hl5nodes, const std::vector<std::unique_ptr<RxTracerHelper>>& rxTracersRUSite1, 
                     const std::vector<std::unique_ptr<TxTracerHelper>>& txTracersRUSite1,
                     const std::vector<std::unique_ptr<TxTracerHelper>>& txTracers1, 
@@ -419,6 +510,10 @@ void tracerlogging(int hl5nodes, const std::vector<std::unique_ptr<RxTracerHelpe
             int nuser = 0, ncontrol = 0;
             int DUapps = 0;
             int txnode8 = 0, txnode9 = 0;    
+            // compiled once, resolved per flow without re-parsing the path
+            Config::PathMatcher ofhPaths("/NodeList/{}/ApplicationList/{}/$ns3::ofhapplication");
+            Config::PathMatcher onOffPaths("/NodeList/{}/ApplicationList/{}/$ns3::OnOffApplication");
+            Config::PathMatcher sinkPaths("/NodeList/{}/ApplicationList/{}/$ns3::PacketSink");
             // std::cout << "HL5 nodes with traffic: " << data["Hl5Agreggration"].size() << std::endl;
             for (int i = 0; i < data["Hl5Agreggration"].size(); i++) {  // TO ADJUST TO the size of hl5aggregation
                 int sites = data["Hl5Agreggration"][i]["Sites"].size();
@@ -432,19 +527,14 @@ void tracerlogging(int hl5nodes, const std::vector<std::unique_ptr<RxTracerHelpe
                         if(j == 0){
                             int Planes = 2;
                             // if (!links[i]){
-                                std::string txCallbackPath = "/NodeList/" + std::to_string(totnodes) + "/ApplicationList/" + std::to_string(DUapps) + "/$ns3::ofhapplication/TxWithAddresses";
-                                // std::cout << txCallbackPath << std::endl;
-                                // std::cout << n_user_call_site1 << std::endl;
-                                Config::ConnectWithoutContext(txCallbackPath, MakeCallback(&TxTracerHelper::TxTracer, txTracersRUSite1[n_user_call_site1].get()));
+                                ofhPaths.Lookup({std::size_t(totnodes), std::size_t(DUapps)})
+                                    .ConnectWithoutContext("TxWithAddresses", MakeCallback(&TxTracerHelper::TxTracer, txTracersRUSite1[n_user_call_site1].get()));
                                 bool CPlaneflag = data["Hl5Agreggration"][i]["Sites"][j]["CellFeatures"][z]["CUPlane"];
                                 if (!CPlaneflag) { Planes = 1; }
                         
                                 for (int planes = 0; planes < Planes; planes++) {
-                                    std::string rxCallbackPath = "/NodeList/" + std::to_string((FHnodes) + sites*i +j) + "/ApplicationList/" + std::to_string(z*Planes + planes) + "/$ns3::PacketSink/Rx";
-                                    // std::cout << rxCallbackPath << std::endl;
-                                    // Connect the RxTracerHelper callback
-                                    // std::cout << "Site1: Instance control: " << n_controll_call_site1 << std::endl;
-                                    Config::ConnectWithoutContext(rxCallbackPath, MakeCallback(&RxTracerHelper::RxTracerWithAdresses, rxTracersRUSite1[n_controll_call_site1].get()));
+                                    sinkPaths.Lookup({std::size_t((FHnodes) + sites*i +j), std::size_t(z*Planes + planes)})
+                                        .ConnectWithoutContext("Rx", MakeCallback(&RxTracerHelper::RxTracerWithAdresses, rxTracersRUSite1[n_controll_call_site1].get()));
                                     n_controll_call_site1++;
                                 }
                                 DUapps++;
@@ -465,12 +555,10 @@ void tracerlogging(int hl5nodes, const std::vector<std::unique_ptr<RxTracerHelpe
                 for (const auto& slice : data["BHFeatures"]) {
                     for (int flow = 0; flow < data["FlowsPerSlice"]; flow++) {
                         
-                        std::string txCallbackPath = "/NodeList/" + std::to_string(totnodes + 1) + "/ApplicationList/" + std::to_string(txnode8) + "/$ns3::OnOffApplication/TxWithAddresses";
-                        // std::cout << txCallbackPath << std::endl;
-                        Config::ConnectWithoutContext(txCallbackPath, MakeCallback(&TxTracerHelper::TxTracer, txTracers1[txnode8].get()));
-                        std::string rxCallbackPath = "/NodeList/" + std::to_string(totnodes + 2) + "/ApplicationList/" + std::to_string(txnode9) + "/$ns3::PacketSink/Rx";
-                        //  std::cout << txCallbackPath << std::endl;
-                        Config::ConnectWithoutContext(rxCallbackPath, MakeCallback(&RxTracerHelper::RxTracerWithAdresses, rxTracers1[txnode9].get()));
+                        onOffPaths.Lookup({std::size_t(totnodes + 1), std::size_t(txnode8)})
+                            .ConnectWithoutContext("TxWithAddresses", MakeCallback(&TxTracerHelper::TxTracer, txTracers1[txnode8].get()));
+                        sinkPaths.Lookup({std::size_t(totnodes + 2), std::size_t(txnode9)})
+                            .ConnectWithoutContext("Rx", MakeCallback(&RxTracerHelper::RxTracerWithAdresses, rxTracers1[txnode9].get()));
                         txnode8++;
                         txnode9++;
                     }
@@ -493,6 +581,9 @@ void tracerloggingPoissonApps(int hl5nodes, const std::vector<std::unique_ptr<Rx
             int nuser = 0, ncontrol = 0;
             int txnode6 = 0, txnode7 = 0;
             int txnode8 = 0, txnode9 = 0;    
+            // compiled once, resolved per flow without re-parsing the path
+            Config::PathMatcher poissonPaths("/NodeList/{}/ApplicationList/{}/$ns3::Poissonapp");
+            Config::PathMatcher sinkPaths("/NodeList/{}/ApplicationList/{}/$ns3::PacketSink");
 
             for (int i = 0; i < hl5nodes; i++) {  // TO ADJUST TO the size of hl5aggregation
                 int sites = data["Hl5Agreggration"][i]["Sites"].size();
@@ -502,19 +593,14 @@ void tracerloggingPoissonApps(int hl5nodes, const std::vector<std::unique_ptr<Rx
                         if(j == 0){
                             int Planes = 2;
                             // if (!links[i]){
-                                std::string txCallbackPath = "/NodeList/" + std::to_string(totnodes) + "/ApplicationList/" + std::to_string(txnode6) + "/$ns3::Poissonapp/TxWithAddresses";
-                                // std::cout << txCallbackPath << std::endl;
-                                // std::cout << n_user_call_site1 << std::endl;
-                                Config::ConnectWithoutContext(txCallbackPath, MakeCallback(&TxTracerHelper::TxTracer, txTracersRUSite1[n_user_call_site1].get()));
+                                poissonPaths.Lookup({std::size_t(totnodes), std::size_t(txnode6)})
+                                    .ConnectWithoutContext("TxWithAddresses", MakeCallback(&TxTracerHelper::TxTracer, txTracersRUSite1[n_user_call_site1].get()));
                                 bool CPlaneflag = data["Hl5Agreggration"][i]["Sites"][j]["CellFeatures"][z]["CUPlane"];
                                 if (!CPlaneflag) { Planes = 1; }
                         
                                 for (int planes = 0; planes < Planes; planes++) {
-                                    std::string rxCallbackPath = "/NodeList/" + std::to_string((FHnodes) + sites*i +j) + "/ApplicationList/" + std::to_string(z*2 + planes) + "/$ns3::PacketSink/Rx";
-                                    // std::cout << rxCallbackPath << std::endl;
-                                    // Connect the RxTracerHelper callback
-                                    // std::cout << "Site1: Instance control: " << n_controll_call_site1 << std::endl;
-                                    Config::ConnectWithoutContext(rxCallbackPath, MakeCallback(&RxTracerHelper::RxTracerWithAdresses, rxTracersRUSite1[n_controll_call_site1].get()));
+                                    sinkPaths.Lookup({std::size_t((FHnodes) + sites*i +j), std::size_t(z*2 + planes)})
+                                        .ConnectWithoutContext("Rx", MakeCallback(&RxTracerHelper::RxTracerWithAdresses, rxTracersRUSite1[n_controll_call_site1].get()));
                                     n_controll_call_site1++;
                                 }
                                 txnode6++;
@@ -535,12 +621,10 @@ void tracerloggingPoissonApps(int hl5nodes, const std::vector<std::unique_ptr<Rx
                 for (const auto& slice : data["BHFeatures"]) {
                     for (int flow = 0; flow < data["FlowsPerSlice"]; flow++) {
                         
-                        std::string txCallbackPath = "/NodeList/" + std::to_string(totnodes + 1) + "/ApplicationList/" + std::to_string(txnode8) + "/$ns3::Poissonapp/TxWithAddresses";
-                        // std::cout << txCallbackPath << std::endl;
-                        Config::ConnectWithoutContext(txCallbackPath, MakeCallback(&TxTracerHelper::TxTracer, txTracers1[txnode8].get()));
-                        std::string rxCallbackPath = "/NodeList/" + std::to_string(totnodes + 2) + "/ApplicationList/" + std::to_string(txnode9) + "/$ns3::PacketSink/Rx";
-                        //  std::cout << txCallbackPath << std::endl;
-                        Config::ConnectWithoutContext(rxCallbackPath, MakeCallback(&RxTracerHelper::RxTracerWithAdresses, rxTracers1[txnode9].get()));
+                        poissonPaths.Lookup({std::size_t(totnodes + 1), std::size_t(txnode8)})
+                            .ConnectWithoutContext("TxWithAddresses", MakeCallback(&TxTracerHelper::TxTracer, txTracers1[txnode8].get()));
+                        sinkPaths.Lookup({std::size_t(totnodes + 2), std::size_t(txnode9)})
+                            .ConnectWithoutContext("Rx", MakeCallback(&RxTracerHelper::RxTracerWithAdresses, rxTracers1[txnode9].get()));
                         txnode8++;
                         txnode9++;
                     }
@@ -566,66 +650,46 @@ void traceTimeStamps(int hl5nodes,
                     const std::vector<std::unique_ptr<SnifferHelper>>& Tshl5nodesCallbacks,  const std::vector<std::unique_ptr<SnifferHelper>>& TshlxnodesCallbacks,
                     const json& data, int totnodes){
 
-        std::string CallbackPath;                    
+        Config::PathMatcher devicePaths("/NodeList/{}/DeviceList/*/$ns3::PointToPointNetDevice");
         if (data["hl4level"]){
             std::cout << YELLOW << "HL4-HL5 level" << RESET << std::endl;
 
-            CallbackPath = "/NodeList/" + std::to_string(totnodes) + "/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTwait";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::Sniffer, TwaithlxnodesCallbacks[0].get()));
-            CallbackPath = "/NodeList/" + std::to_string(totnodes) + "/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTs";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::SnifferStatus, TshlxnodesCallbacks[0].get()));
+            devicePaths.Lookup({std::size_t(totnodes)}).ConnectWithoutContext("SnifferTwait", MakeCallback(&SnifferHelper::Sniffer, TwaithlxnodesCallbacks[0].get()));
+            devicePaths.Lookup({std::size_t(totnodes)}).ConnectWithoutContext("SnifferTs", MakeCallback(&SnifferHelper::SnifferStatus, TshlxnodesCallbacks[0].get()));
 
 
-            CallbackPath = "/NodeList/2/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTprocServ";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::SnifferStatus, TprocServhlxnodesCallbacks[0].get()));
-            CallbackPath = "/NodeList/2/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTprocWait";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::Sniffer, TprocWaithlxnodesCallbacks[0].get()));
-            CallbackPath = "/NodeList/2/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTwait";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::Sniffer, TwaithlxnodesCallbacks[1].get()));
-            CallbackPath = "/NodeList/2/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTs";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::SnifferStatus, TshlxnodesCallbacks[1].get()));
+            devicePaths.Lookup({2}).ConnectWithoutContext("SnifferTprocServ", MakeCallback(&SnifferHelper::SnifferStatus, TprocServhlxnodesCallbacks[0].get()));
+            devicePaths.Lookup({2}).ConnectWithoutContext("SnifferTprocWait", MakeCallback(&SnifferHelper::Sniffer, TprocWaithlxnodesCallbacks[0].get()));
+            devicePaths.Lookup({2}).ConnectWithoutContext("SnifferTwait", MakeCallback(&SnifferHelper::Sniffer, TwaithlxnodesCallbacks[1].get()));
+            devicePaths.Lookup({2}).ConnectWithoutContext("SnifferTs", MakeCallback(&SnifferHelper::SnifferStatus, TshlxnodesCallbacks[1].get()));
         }else{
             std::cout << YELLOW << "HL3-HL5 level" << RESET << std::endl;
 
-            CallbackPath = "/NodeList/" + std::to_string(totnodes) + "/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTwait";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::Sniffer, TwaithlxnodesCallbacks[0].get()));
-            CallbackPath = "/NodeList/" + std::to_string(totnodes) + "/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTs";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::SnifferStatus, TshlxnodesCallbacks[0].get()));
+            devicePaths.Lookup({std::size_t(totnodes)}).ConnectWithoutContext("SnifferTwait", MakeCallback(&SnifferHelper::Sniffer, TwaithlxnodesCallbacks[0].get()));
+            devicePaths.Lookup({std::size_t(totnodes)}).ConnectWithoutContext("SnifferTs", MakeCallback(&SnifferHelper::SnifferStatus, TshlxnodesCallbacks[0].get()));
 
 
-            CallbackPath = "/NodeList/0/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTprocServ";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::SnifferStatus, TprocServhlxnodesCallbacks[0].get()));
-            CallbackPath = "/NodeList/0/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTprocWait";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::Sniffer, TprocWaithlxnodesCallbacks[0].get()));
-            CallbackPath = "/NodeList/0/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTwait";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::Sniffer, TwaithlxnodesCallbacks[1].get()));
-            CallbackPath = "/NodeList/0/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTs";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::SnifferStatus, TshlxnodesCallbacks[1].get()));
+            devicePaths.Lookup({0}).ConnectWithoutContext("SnifferTprocServ", MakeCallback(&SnifferHelper::SnifferStatus, TprocServhlxnodesCallbacks[0].get()));
+            devicePaths.Lookup({0}).ConnectWithoutContext("SnifferTprocWait", MakeCallback(&SnifferHelper::Sniffer, TprocWaithlxnodesCallbacks[0].get()));
+            devicePaths.Lookup({0}).ConnectWithoutContext("SnifferTwait", MakeCallback(&SnifferHelper::Sniffer, TwaithlxnodesCallbacks[1].get()));
+            devicePaths.Lookup({0}).ConnectWithoutContext("SnifferTs", MakeCallback(&SnifferHelper::SnifferStatus, TshlxnodesCallbacks[1].get()));
 
 
 
-            CallbackPath = "/NodeList/2/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTprocServ";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::SnifferStatus, TprocServhlxnodesCallbacks[1].get()));
-            CallbackPath = "/NodeList/2/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTprocWait";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::Sniffer, TprocWaithlxnodesCallbacks[1].get()));
-            CallbackPath = "/NodeList/2/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTwait";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::Sniffer, TwaithlxnodesCallbacks[2].get()));
-            CallbackPath = "/NodeList/2/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTs";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::SnifferStatus, TshlxnodesCallbacks[2].get()));
+            devicePaths.Lookup({2}).ConnectWithoutContext("SnifferTprocServ", MakeCallback(&SnifferHelper::SnifferStatus, TprocServhlxnodesCallbacks[1].get()));
+            devicePaths.Lookup({2}).ConnectWithoutContext("SnifferTprocWait", MakeCallback(&SnifferHelper::Sniffer, TprocWaithlxnodesCallbacks[1].get()));
+            devicePaths.Lookup({2}).ConnectWithoutContext("SnifferTwait", MakeCallback(&SnifferHelper::Sniffer, TwaithlxnodesCallbacks[2].get()));
+            devicePaths.Lookup({2}).ConnectWithoutContext("SnifferTs", MakeCallback(&SnifferHelper::SnifferStatus, TshlxnodesCallbacks[2].get()));
 
         }
 
         
     
         for (int i = 0;  i < hl5nodes; i++){
-            CallbackPath = "/NodeList/" + std::to_string(4 + i) + "/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTprocServ";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::SnifferStatus, TprocServhl5nodesCallbacks[i].get()));
-            CallbackPath = "/NodeList/" + std::to_string(4 + i) + "/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTprocWait";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::Sniffer, TprocWaithl5nodesCallbacks[i].get()));
-            CallbackPath = "/NodeList/" + std::to_string(4 + i) + "/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTwait";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::Sniffer, Twaithl5nodesCallbacks[i].get()));
-            CallbackPath = "/NodeList/" + std::to_string(4 + i) + "/DeviceList/*/$ns3::PointToPointNetDevice/SnifferTs";
-            Config::ConnectWithoutContext(CallbackPath, MakeCallback(&SnifferHelper::SnifferStatus, Tshl5nodesCallbacks[i].get()));
+            devicePaths.Lookup({std::size_t(4 + i)}).ConnectWithoutContext("SnifferTprocServ", MakeCallback(&SnifferHelper::SnifferStatus, TprocServhl5nodesCallbacks[i].get()));
+            devicePaths.Lookup({std::size_t(4 + i)}).ConnectWithoutContext("SnifferTprocWait", MakeCallback(&SnifferHelper::Sniffer, TprocWaithl5nodesCallbacks[i].get()));
+            devicePaths.Lookup({std::size_t(4 + i)}).ConnectWithoutContext("SnifferTwait", MakeCallback(&SnifferHelper::Sniffer, Twaithl5nodesCallbacks[i].get()));
+            devicePaths.Lookup({std::size_t(4 + i)}).ConnectWithoutContext("SnifferTs", MakeCallback(&SnifferHelper::SnifferStatus, Tshl5nodesCallbacks[i].get()));
 
         }
 
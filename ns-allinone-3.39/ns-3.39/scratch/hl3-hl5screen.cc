@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/*
+ * Analytic screening of an hl3-hl5 scenario.
+ *
+ * Reads the same JSON as hl3-hl5theo.cc (--json, by default
+ * ./scratch/hl3-hl5ex.json), builds the queueing stations that the
+ * simulation has on the paths of the flows (the HL3-HL4 bottleneck with its
+ * HQoS policy, and the switching backplanes of the receiving devices when
+ * Enableswitching is set) and evaluates them with ns3::QueueingAnalysis.
+ * The result is printed as JSON (times in microseconds):
+ *
+ * - per station, its utilization;
+ * - per flow, the mean end-to-end delay and its (1 - epsilon) quantile bound;
+ * - the margin to the feasibility boundary: the smallest of one minus the
+ *   maximum utilization and, if a fronthaul delay budget is given (--budget,
+ *   or "FHDelayBudget" in the JSON, in us), the budget minus the largest
+ *   fronthaul delay bound relative to the budget.
+ *
+ * The sweep drivers only simulate the points whose margin is close to zero.
+ */
+
+#include "json.hpp"
+
+#include "ns3/core-module.h"
+#include "ns3/data-rate.h"
+#include "ns3/queueing-analysis.h"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using json = nlohmann::json;
+
+NS_LOG_COMPONENT_DEFINE("hl3-hl5screen");
+
+/**
+ * Parse a string of pairs of numbers, as the Marking_Port and MapQueue keys.
+ * \param pairs the string
+ * \return the pairs, in order
+ */
+static std::vector<std::pair<uint32_t, uint32_t>>
+ParsePairs(const std::string& pairs)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> result;
+    std::istringstream iss(pairs);
+    uint32_t first;
+    uint32_t second;
+    while (iss >> first >> second)
+    {
+        result.emplace_back(first, second);
+    }
+    return result;
+}
+
+/**
+ * DSCP given by the MarkerQueueDisc to a destination port.
+ * \param marking the marking pairs (first port of a range of 1000, DSCP)
+ * \param port the destination port
+ * \return the DSCP (EF if the port is not marked)
+ */
+static uint32_t
+GetDscp(const std::vector<std::pair<uint32_t, uint32_t>>& marking, uint32_t port)
+{
+    for (const auto& range : marking)
+    {
+        if (port >= range.first && port < range.first + 1000)
+        {
+            return range.second;
+        }
+    }
+    return 46;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string jsonPath = "./scratch/hl3-hl5ex.json";
+    double epsilon = 1e-3;
+    double budget = 0;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("json", "Scenario file", jsonPath);
+    cmd.AddValue("epsilon", "Violation probability of the delay bounds", epsilon);
+    cmd.AddValue("budget", "Fronthaul delay budget in us (0 to use FHDelayBudget, if any)", budget);
+    cmd.Parse(argc, argv);
+
+    std::ifstream f(jsonPath);
+    if (!f.is_open())
+    {
+        NS_FATAL_ERROR("Cannot open " << jsonPath);
+    }
+    json data = json::parse(f);
+    if (budget == 0)
+    {
+        budget = data.value("FHDelayBudget", 0.0);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    bool enablehqos = data.at("EnableHQoS");
+    bool enableswitching = data.at("Enableswitching");
+    bool enablemodel = data.at("EnableModel");
+    bool hl4level = data.at("hl4level");
+    bool poisson = data.at("Poisson");
+    std::string model = data.value("Model", "mm1");
+    uint32_t netMTU = data["netmtu"];
+    // bytes on the wire and through the switching fabric over the UDP
+    // payload (UDP, IP and PPP headers), as in PointToPointNetDevice
+    uint32_t linkOverhead = enablemodel ? 2 : 30;
+    uint32_t switchOverhead = enablemodel ? 0 : 30;
+    // as in hl3-hl5theo.cc: arrivals and packet sizes of the Poissonapps, or
+    // constant rate OFH and OnOff applications
+    double arrivalScv = poisson && model != "cte" ? 1 : 0;
+    double sizeScv = poisson && model == "mm1" ? 1 : 0;
+
+    auto marking = ParsePairs(data.at("Marking_Port"));
+    std::map<uint32_t, uint32_t> mapQueue;
+    for (const auto& entry : ParsePairs(data.value("MapQueue", "")))
+    {
+        mapQueue[entry.first] = entry.second;
+    }
+    std::vector<double> weights;
+    std::istringstream weightStream(data.value("Weights", std::string("1")));
+    double weight;
+    while (weightStream >> weight)
+    {
+        weights.push_back(weight);
+    }
+
+    // traffic classes: 0 for EF (strict priority), 1 + the WRR queue otherwise
+    auto trafficClass = [&](uint32_t port) -> uint32_t {
+        uint32_t dscp = GetDscp(marking, port);
+        if (dscp == 46)
+        {
+            return 0;
+        }
+        auto it = mapQueue.find(dscp);
+        return 1 + (it == mapQueue.end() ? 0 : it->second);
+    };
+
+    QueueingAnalysis analysis;
+    double delayHl3Hl4 = data["del-hl3hl4"].get<double>() * 1e-6;
+    double delayHl4Hl5 = data["del-hl4hl5"].get<double>() * 1e-6;
+    double linkCap = DataRate(data.at("LinkCap").get<std::string>()).GetBitRate();
+    // the dedicated links of the simulation have no queueing
+    double dedicated = std::numeric_limits<double>::infinity();
+
+    uint32_t bottleneck = analysis.AddStation("HL3_02", linkCap, delayHl3Hl4, linkOverhead);
+    if (enablehqos)
+    {
+        analysis.SetQueue(bottleneck, 0, 0);
+        for (std::size_t q = 0; q < weights.size(); q++)
+        {
+            analysis.SetQueue(bottleneck, 1 + q, 1, weights[q]);
+        }
+    }
+    std::vector<uint32_t> bhRoute{bottleneck};
+    std::vector<uint32_t> duRoute;
+    if (enableswitching)
+    {
+        uint32_t du = analysis.AddStation(hl4level ? "HL4 backplane (DU0)" : "HL3 backplane (DU0)",
+                                          2000e9,
+                                          0,
+                                          switchOverhead);
+        duRoute.push_back(du);
+        if (!enablehqos)
+        {
+            // the bottleneck device switches at the receiver without traffic control
+            bhRoute.push_back(analysis.AddStation("HL4 backplane (HL3_02)", 2000e9, 0, switchOverhead));
+        }
+    }
+    if (!hl4level)
+    {
+        duRoute.insert(duRoute.end(), bhRoute.begin(), bhRoute.end());
+    }
+
+    // fronthaul flows, in the order of configureApplications
+    std::vector<uint32_t> fhFlows;
+    uint32_t napp = 0;
+    uint32_t hl5 = 0;
+    for (const auto& aggregation : data["Hl5Agreggration"])
+    {
+        std::ostringstream name;
+        name << "HL5_" << hl5 << (enableswitching ? " backplane" : "");
+        uint32_t station = analysis.AddStation(name.str(),
+                                               enableswitching ? 100e9 : dedicated,
+                                               delayHl4Hl5,
+                                               switchOverhead);
+        std::vector<uint32_t> route = duRoute;
+        route.push_back(station);
+        for (const auto& site : aggregation["Sites"])
+        {
+            for (const auto& cell : site["CellFeatures"])
+            {
+                double size = cell["UPacketSize"].get<double>();
+                if (size + 28 > netMTU)
+                {
+                    std::cerr << "Fragmented U-plane packets are not modelled" << std::endl;
+                }
+                std::ostringstream flowName;
+                flowName << "FH" << napp << "-U";
+                fhFlows.push_back(analysis.AddFlow(flowName.str(),
+                                                   cell["URatenum"].get<double>(),
+                                                   size,
+                                                   route,
+                                                   trafficClass(8080 + napp),
+                                                   arrivalScv,
+                                                   sizeScv));
+                if (cell["CUPlane"].get<bool>() && !poisson)
+                {
+                    flowName.str("");
+                    flowName << "FH" << napp << "-C";
+                    fhFlows.push_back(analysis.AddFlow(flowName.str(),
+                                                       cell["CRatenum"].get<double>(),
+                                                       cell["CPacketSize"].get<double>(),
+                                                       route,
+                                                       trafficClass(9090 + napp),
+                                                       arrivalScv,
+                                                       sizeScv));
+                }
+                napp++;
+            }
+        }
+        hl5++;
+    }
+
+    if (data.value("Backhaulenable", false))
+    {
+        uint32_t slice = 0;
+        for (const auto& features : data["BHFeatures"])
+        {
+            for (uint32_t flow = 0; flow < data["FlowsPerSlice"].get<uint32_t>(); flow++)
+            {
+                std::ostringstream flowName;
+                flowName << "BH" << slice << "-" << flow;
+                analysis.AddFlow(flowName.str(),
+                                 DataRate(features.at("Rate").get<std::string>()).GetBitRate(),
+                                 features.at("PacketSize").get<double>(),
+                                 bhRoute,
+                                 trafficClass(11000 + slice * 1000 + flow),
+                                 arrivalScv,
+                                 sizeScv);
+            }
+            slice++;
+        }
+    }
+
+    analysis.Evaluate();
+
+    json result;
+    result["stable"] = analysis.IsStable();
+    result["maxUtilization"] = analysis.GetMaxUtilization();
+    for (uint32_t i = 0; i < analysis.GetNStations(); i++)
+    {
+        result["stations"].push_back(
+            {{"name", analysis.GetStationName(i)}, {"utilization", analysis.GetUtilization(i)}});
+    }
+    double fhBound = 0;
+    for (uint32_t i = 0; i < analysis.GetNFlows(); i++)
+    {
+        double mean = analysis.GetMeanDelay(i) * 1e6;
+        double bound = analysis.GetDelayQuantile(i, epsilon) * 1e6;
+        if (std::find(fhFlows.begin(), fhFlows.end(), i) != fhFlows.end())
+        {
+            fhBound = std::max(fhBound, bound);
+        }
+        // JSON has no infinity
+        result["flows"].push_back({{"name", analysis.GetFlowName(i)},
+                                   {"meanDelay", std::isinf(mean) ? -1 : mean},
+                                   {"delayQuantile", std::isinf(bound) ? -1 : bound}});
+    }
+    double margin = 1 - analysis.GetMaxUtilization();
+    if (budget > 0)
+    {
+        margin = std::min(margin, std::isinf(fhBound) ? -1 : (budget - fhBound) / budget);
+    }
+    result["fhDelayQuantile"] = std::isinf(fhBound) ? -1 : fhBound;
+    result["margin"] = margin;
+    result["feasible"] = margin > 0;
+    result["screenTime"] =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << result.dump(2) << std::endl;
+    return 0;
+}
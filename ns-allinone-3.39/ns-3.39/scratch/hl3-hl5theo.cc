@@ -32,6 +32,8 @@
         std::ifstream f(JSONpath);
         json data = json::parse(f);
         uint32_t netMTU = data["netmtu"]; 
+        // the sources are connected UDP sockets over global routing (no ECMP): reuse their routes
+        Config::SetDefault("ns3::UdpSocketImpl::RouteCache", BooleanValue(data.value("UdpRouteCache", true)));
         bool enabletracing = true, enablepcap = false, enablehqos = data.at("EnableHQoS"), enableswitching = data.at("Enableswitching");
         bool enabletraceTimeStamps = data.at("EnableTraceTimeStamps");
         bool enablemodel = data.at("EnableModel");
@@ -197,7 +199,17 @@
         hl3hl4p2p_tc.SetDeviceAttribute("EnableModel", BooleanValue(enablemodel));
         // hl3hl4p2p_tc.SetDeviceAttribute("EnableSwithcingTime", BooleanValue(false));
         // hl3hl4p2p_tc.SetDeviceAttribute("SwitchingCapacity", StringValue("1700Gbps"));
-        hl3hl4p2p_tc.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("1p")); // 1 packet queue size in case of traffic control is used
+        // with byte queue limits the device queue is bounded by DQL (in bytes, including the
+        // packet on the wire) instead of a 1 packet queue, so that the queue disc hands several
+        // packets to the device per wake-up
+        bool byteQueueLimits = data.contains("ByteQueueLimits") && data["ByteQueueLimits"];
+        if (byteQueueLimits){
+            hl3hl4p2p_tc.SetDeviceAttribute("ByteQueueLimits", BooleanValue(true));
+            hl3hl4p2p_tc.SetDeviceAttribute("CompletionBatch", UintegerValue(data.value("CompletionBatch", 1)));
+            hl3hl4p2p_tc.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("100p"));
+        }else{
+            hl3hl4p2p_tc.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("1p")); // 1 packet queue size in case of traffic control is used
+        }
 
         PointToPointHelper hl4hl5p2p;
         hl4hl5p2p.SetDeviceAttribute("DataRate", StringValue(std::to_string(dedicatedlink)+ "Gbps"));
@@ -345,6 +357,9 @@
             tch2.AddChildQueueDisc(rootHandle, cid[0], "ns3::FifoQueueDisc");
             // tch2.AddChildQueueDisc(rootHandle, cid[1], "ns3::FifoQueueDisc");
             tch2.AddChildQueueDisc(rootHandle, cid[1], "ns3::WrrQueueDisc", "Quantum", StringValue(data.at("Weights")), "MapQueue", StringValue(data.at("MapQueue")));
+            if (byteQueueLimits){
+                tch2.SetQueueLimits("ns3::DynamicQueueLimits");
+            }
 
 
 
@@ -430,6 +445,19 @@
         std::cout << YELLOW << "Populating routing tables" << RESET << std::endl;
         Ipv4GlobalRoutingHelper::PopulateRoutingTables();
 
+        // deterministic delay bounds of the flows, before (BoundsOnly) or against the simulation
+        NetworkCalculusHelper calculus;
+        bool networkCalculus = data.value("NetworkCalculus", false);
+        if (networkCalculus){
+            configureNetworkCalculus(calculus, nodes, FHnodes, lastFHnode, data, RUsAccess, BHAccess, totnodes);
+            calculus.Evaluate();
+            calculus.PrintBounds(std::cout);
+            if (data.value("BoundsOnly", false)){
+                Simulator::Destroy();
+                return 0;
+            }
+        }
+
 
        /*******************************************************************
         ********************** RU node configuration ***********************
@@ -486,6 +514,13 @@
         FlowMonitorHelper flowHelper;
         flowMonitor = flowHelper.InstallAll();
 
+        // time-weighted occupancy of the device queues and queue discs
+        Ptr<QueueMonitor> queueMonitor;
+        if (data.value("QueueMonitor", false)){
+            queueMonitor = CreateObjectWithAttributes<QueueMonitor>(
+                "Interval", TimeValue(Seconds(data.value("QueueMonitorInterval", 0.0))));
+            queueMonitor->AddAll();
+        }
 
         Ptr<PacketSink> Server_trace1 = StaticCast<PacketSink>(Server_appRU.Get(0));
 
@@ -495,6 +530,14 @@
         Simulator::Stop(Seconds(data.at("Seconds_sim")));
         Simulator::Schedule(Seconds(0), &PrintTotalRx, Server_trace1);
         Simulator::Run();
+        PrintFragmentationReport();
+        if (networkCalculus){
+            uint32_t violations = calculus.Compare(flowMonitor, DynamicCast<Ipv4FlowClassifier>(flowHelper.GetClassifier()), std::cout);
+            std::cout << "Flows above their delay bound: " << violations << std::endl;
+        }
+        if (queueMonitor){
+            queueMonitor->WriteFiles(resultsPathname + "queue-occupancy");
+        }
         Simulator::Destroy();
         
         std::cout << GREEN << "Simulation has finished" << RESET << std::endl;
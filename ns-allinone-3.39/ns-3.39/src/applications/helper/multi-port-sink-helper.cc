@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "multi-port-sink-helper.h"
+
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+MultiPortSinkHelper::MultiPortSinkHelper(std::string protocol, Address address, uint16_t nPorts)
+{
+    m_factory.SetTypeId("ns3::MultiPortSink");
+    m_factory.Set("Protocol", StringValue(protocol));
+    m_factory.Set("Local", AddressValue(address));
+    m_factory.Set("NPorts", UintegerValue(nPorts));
+}
+
+void
+MultiPortSinkHelper::SetAttribute(std::string name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
+ApplicationContainer
+MultiPortSinkHelper::Install(Ptr<Node> node) const
+{
+    return ApplicationContainer(InstallPriv(node));
+}
+
+ApplicationContainer
+MultiPortSinkHelper::Install(NodeContainer c) const
+{
+    ApplicationContainer apps;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        apps.Add(InstallPriv(*i));
+    }
+
+    return apps;
+}
+
+Ptr<Application>
+MultiPortSinkHelper::InstallPriv(Ptr<Node> node) const
+{
+    Ptr<Application> app = m_factory.Create<Application>();
+    node->AddApplication(app);
+
+    return app;
+}
+
+} // namespace ns3
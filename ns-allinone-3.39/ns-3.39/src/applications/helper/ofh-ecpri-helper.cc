@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ofh-ecpri-helper.h"
+
+#include "ns3/ofh-ecpri-application.h"
+
+namespace ns3
+{
+
+OfhEcpriHelper::OfhEcpriHelper(const Address& remote)
+{
+    m_factory.SetTypeId("ns3::OfhEcpriApplication");
+    m_factory.Set("Remote", AddressValue(remote));
+}
+
+void
+OfhEcpriHelper::SetAttribute(std::string name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
+ApplicationContainer
+OfhEcpriHelper::Install(Ptr<Node> node) const
+{
+    return ApplicationContainer(InstallPriv(node));
+}
+
+ApplicationContainer
+OfhEcpriHelper::Install(NodeContainer c) const
+{
+    ApplicationContainer apps;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        apps.Add(InstallPriv(*i));
+    }
+
+    return apps;
+}
+
+Ptr<Application>
+OfhEcpriHelper::InstallPriv(Ptr<Node> node) const
+{
+    Ptr<Application> app = m_factory.Create<Application>();
+    node->AddApplication(app);
+
+    return app;
+}
+
+int64_t
+OfhEcpriHelper::AssignStreams(NodeContainer c, int64_t stream)
+{
+    int64_t currentStream = stream;
+    Ptr<Node> node;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        node = (*i);
+        for (uint32_t j = 0; j < node->GetNApplications(); j++)
+        {
+            Ptr<OfhEcpriApplication> app =
+                DynamicCast<OfhEcpriApplication>(node->GetApplication(j));
+            if (app)
+            {
+                currentStream += app->AssignStreams(currentStream);
+            }
+        }
+    }
+    return (currentStream - stream);
+}
+
+} // namespace ns3
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcap-replay-helper.h"
+
+#include "ns3/pcap-replay-application.h"
+#include "ns3/string.h"
+
+namespace ns3
+{
+
+PcapReplayHelper::PcapReplayHelper(Address address, std::string files)
+{
+    m_factory.SetTypeId("ns3::PcapReplayApplication");
+    m_factory.Set("Remote", AddressValue(address));
+    m_factory.Set("Files", StringValue(files));
+}
+
+void
+PcapReplayHelper::SetAttribute(std::string name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
+ApplicationContainer
+PcapReplayHelper::Install(Ptr<Node> node) const
+{
+    return ApplicationContainer(InstallPriv(node));
+}
+
+ApplicationContainer
+PcapReplayHelper::Install(NodeContainer c) const
+{
+    ApplicationContainer apps;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        apps.Add(InstallPriv(*i));
+    }
+
+    return apps;
+}
+
+Ptr<Application>
+PcapReplayHelper::InstallPriv(Ptr<Node> node) const
+{
+    Ptr<Application> app = m_factory.Create<Application>();
+    node->AddApplication(app);
+
+    return app;
+}
+
+int64_t
+PcapReplayHelper::AssignStreams(NodeContainer c, int64_t stream)
+{
+    int64_t currentStream = stream;
+    Ptr<Node> node;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        node = (*i);
+        for (uint32_t j = 0; j < node->GetNApplications(); j++)
+        {
+            Ptr<PcapReplayApplication> app =
+                DynamicCast<PcapReplayApplication>(node->GetApplication(j));
+            if (app)
+            {
+                currentStream += app->AssignStreams(currentStream);
+            }
+        }
+    }
+    return (currentStream - stream);
+}
+
+} // namespace ns3
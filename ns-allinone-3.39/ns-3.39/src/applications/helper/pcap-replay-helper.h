@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_REPLAY_HELPER_H
+#define PCAP_REPLAY_HELPER_H
+
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/attribute.h"
+#include "ns3/node-container.h"
+#include "ns3/object-factory.h"
+
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applications
+ * \brief A helper to make it easier to instantiate an ns3::PcapReplayApplication
+ * on a set of nodes.
+ */
+class PcapReplayHelper
+{
+  public:
+    /**
+     * Create a PcapReplayHelper to make it easier to work with PcapReplayApplications
+     *
+     * \param address the address of the remote node to send traffic to
+     * \param files comma separated list of the captures to replay
+     */
+    PcapReplayHelper(Address address, std::string files);
+
+    /**
+     * Helper function used to set the underlying application attributes.
+     *
+     * \param name the name of the application attribute to set
+     * \param value the value of the application attribute to set
+     */
+    void SetAttribute(std::string name, const AttributeValue& value);
+
+    /**
+     * Install an ns3::PcapReplayApplication on each node of the input container
+     * configured with all the attributes set with SetAttribute.
+     *
+     * \param c NodeContainer of the set of nodes on which a PcapReplayApplication
+     * will be installed.
+     * \returns Container of Ptr to the applications installed.
+     */
+    ApplicationContainer Install(NodeContainer c) const;
+
+    /**
+     * Install an ns3::PcapReplayApplication on the node configured with all the
+     * attributes set with SetAttribute.
+     *
+     * \param node The node on which a PcapReplayApplication will be installed.
+     * \returns Container of Ptr to the applications installed.
+     */
+    ApplicationContainer Install(Ptr<Node> node) const;
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by the applications.
+     *
+     * \param c NodeContainer of the set of nodes for which the applications
+     *          should be modified to use a fixed stream
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this helper
+     */
+    int64_t AssignStreams(NodeContainer c, int64_t stream);
+
+  private:
+    /**
+     * Install an ns3::PcapReplayApplication on the node configured with all the
+     * attributes set with SetAttribute.
+     *
+     * \param node The node on which a PcapReplayApplication will be installed.
+     * \returns Ptr to the application installed.
+     */
+    Ptr<Application> InstallPriv(Ptr<Node> node) const;
+
+    ObjectFactory m_factory; //!< Object factory.
+};
+
+} // namespace ns3
+
+#endif /* PCAP_REPLAY_HELPER_H */
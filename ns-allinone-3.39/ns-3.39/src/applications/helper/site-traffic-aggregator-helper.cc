@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "site-traffic-aggregator-helper.h"
+
+#include "ns3/site-traffic-aggregator.h"
+#include "ns3/string.h"
+
+namespace ns3
+{
+
+SiteTrafficAggregatorHelper::SiteTrafficAggregatorHelper(std::string protocol)
+{
+    m_factory.SetTypeId("ns3::SiteTrafficAggregator");
+    m_factory.Set("Protocol", StringValue(protocol));
+}
+
+void
+SiteTrafficAggregatorHelper::SetAttribute(std::string name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
+void
+SiteTrafficAggregatorHelper::AddPoissonFlow(const Address& peer,
+                                            uint32_t packetSize,
+                                            double interval,
+                                            const std::string& packetGen,
+                                            uint64_t maxBytes)
+{
+    m_flows.push_back(PoissonFlow{peer, packetSize, interval, packetGen, maxBytes});
+}
+
+void
+SiteTrafficAggregatorHelper::ClearFlows()
+{
+    m_flows.clear();
+}
+
+ApplicationContainer
+SiteTrafficAggregatorHelper::Install(Ptr<Node> node) const
+{
+    return ApplicationContainer(InstallPriv(node));
+}
+
+ApplicationContainer
+SiteTrafficAggregatorHelper::Install(NodeContainer c) const
+{
+    ApplicationContainer apps;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        apps.Add(InstallPriv(*i));
+    }
+
+    return apps;
+}
+
+Ptr<Application>
+SiteTrafficAggregatorHelper::InstallPriv(Ptr<Node> node) const
+{
+    Ptr<SiteTrafficAggregator> app = m_factory.Create<SiteTrafficAggregator>();
+    for (const auto& flow : m_flows)
+    {
+        app->AddPoissonFlow(flow.peer,
+                            flow.packetSize,
+                            flow.interval,
+                            flow.packetGen,
+                            flow.maxBytes);
+    }
+    node->AddApplication(app);
+
+    return app;
+}
+
+int64_t
+SiteTrafficAggregatorHelper::AssignStreams(NodeContainer c, int64_t stream)
+{
+    int64_t currentStream = stream;
+    Ptr<Node> node;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        node = (*i);
+        for (uint32_t j = 0; j < node->GetNApplications(); j++)
+        {
+            Ptr<SiteTrafficAggregator> app =
+                DynamicCast<SiteTrafficAggregator>(node->GetApplication(j));
+            if (app)
+            {
+                currentStream += app->AssignStreams(currentStream);
+            }
+        }
+    }
+    return (currentStream - stream);
+}
+
+} // namespace ns3
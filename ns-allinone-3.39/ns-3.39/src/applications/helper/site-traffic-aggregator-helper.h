@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SITE_TRAFFIC_AGGREGATOR_HELPER_H
+#define SITE_TRAFFIC_AGGREGATOR_HELPER_H
+
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/attribute.h"
+#include "ns3/node-container.h"
+#include "ns3/object-factory.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applications
+ * \brief A helper to make it easier to instantiate an ns3::SiteTrafficAggregator
+ * on a set of nodes.
+ *
+ * The flows added with AddPoissonFlow are installed in every application.
+ */
+class SiteTrafficAggregatorHelper
+{
+  public:
+    /**
+     * Create a SiteTrafficAggregatorHelper to make it easier to work with
+     * SiteTrafficAggregators
+     *
+     * \param protocol the name of the protocol to use to send traffic
+     *        by the applications. This string identifies the socket
+     *        factory type used to create sockets for the applications.
+     *        A typical value would be ns3::UdpSocketFactory.
+     */
+    SiteTrafficAggregatorHelper(std::string protocol);
+
+    /**
+     * Helper function used to set the underlying application attributes.
+     *
+     * \param name the name of the application attribute to set
+     * \param value the value of the application attribute to set
+     */
+    void SetAttribute(std::string name, const AttributeValue& value);
+
+    /**
+     * Add a flow with the distributions of a Poissonapp
+     * (see SiteTrafficAggregator::AddPoissonFlow).
+     *
+     * \param peer the destination of the packets
+     * \param packetSize the (mean) packet size in bytes
+     * \param interval the (mean) inter-arrival time in seconds
+     * \param packetGen the generation model, as the PacketGen attribute of Poissonapp
+     * \param maxBytes the bytes to send, or zero without limit
+     */
+    void AddPoissonFlow(const Address& peer,
+                        uint32_t packetSize,
+                        double interval,
+                        const std::string& packetGen = "mm1",
+                        uint64_t maxBytes = 0);
+
+    /// Remove the flows added so far
+    void ClearFlows();
+
+    /**
+     * Install an ns3::SiteTrafficAggregator on each node of the input container
+     * configured with all the attributes set with SetAttribute and the flows.
+     *
+     * \param c NodeContainer of the set of nodes on which a SiteTrafficAggregator
+     * will be installed.
+     * \returns Container of Ptr to the applications installed.
+     */
+    ApplicationContainer Install(NodeContainer c) const;
+
+    /**
+     * Install an ns3::SiteTrafficAggregator on the node configured with all the
+     * attributes set with SetAttribute and the flows.
+     *
+     * \param node The node on which a SiteTrafficAggregator will be installed.
+     * \returns Container of Ptr to the applications installed.
+     */
+    ApplicationContainer Install(Ptr<Node> node) const;
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by the applications.
+     *
+     * \param c NodeContainer of the set of nodes for which the applications
+     *          should be modified to use a fixed stream
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this helper
+     */
+    int64_t AssignStreams(NodeContainer c, int64_t stream);
+
+  private:
+    /**
+     * Install an ns3::SiteTrafficAggregator on the node configured with all the
+     * attributes set with SetAttribute and the flows.
+     *
+     * \param node The node on which a SiteTrafficAggregator will be installed.
+     * \returns Ptr to the application installed.
+     */
+    Ptr<Application> InstallPriv(Ptr<Node> node) const;
+
+    /// Flow of a Poissonapp
+    struct PoissonFlow
+    {
+        Address peer;          //!< Destination
+        uint32_t packetSize;   //!< (Mean) packet size
+        double interval;       //!< (Mean) inter-arrival time
+        std::string packetGen; //!< Generation model
+        uint64_t maxBytes;     //!< Bytes to send
+    };
+
+    ObjectFactory m_factory;           //!< Object factory.
+    std::vector<PoissonFlow> m_flows;  //!< Flows to install
+};
+
+} // namespace ns3
+
+#endif /* SITE_TRAFFIC_AGGREGATOR_HELPER_H */
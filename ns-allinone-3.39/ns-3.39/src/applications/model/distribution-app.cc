@@ -106,7 +106,7 @@ Distributionapp::GetTypeId()
                         MakeDoubleAccessor(&Distributionapp::m_interval),
                         MakeDoubleChecker<double>())
             .AddAttribute("PacketGen",
-                        "Specifies the packet arrival distribution type. Available options are: CBR, Exp, Uni",
+                        "Specifies the packet arrival distribution type. Available options are: CBR, Exp, Uni, Profile",
                         StringValue("Constant"),
                         MakeStringAccessor(&Distributionapp::m_packetgentype),
                         MakeStringChecker())
@@ -121,7 +121,7 @@ Distributionapp::GetTypeId()
                         MakeDoubleAccessor(&Distributionapp::m_scv_pkt),
                         MakeDoubleChecker<double>())
             .AddAttribute("ArrivalGen",
-                        "Distribution of the packet size. Available options are: CBR, Exp, Uni",
+                        "Distribution of the packet size. Available options are: CBR, Exp, Uni, Profile",
                         StringValue("Constant"),
                         MakeStringAccessor(&Distributionapp::m_arrivalgentype),
                         MakeStringChecker())
@@ -136,6 +136,12 @@ Distributionapp::GetTypeId()
                         DoubleValue(0),
                         MakeDoubleAccessor(&Distributionapp::m_pktSizeMin),
                         MakeDoubleChecker<double>())
+            .AddAttribute("ProfileFile",
+                        "Traffic profile (see ns3::TrafficProfile) used when PacketGen or "
+                        "ArrivalGen is Profile",
+                        StringValue(""),
+                        MakeStringAccessor(&Distributionapp::m_profileFile),
+                        MakeStringChecker())
 
             .AddTraceSource("Tx",
                             "A new packet is created and is sent",
@@ -190,6 +196,7 @@ Distributionapp::DoDispose()
     NS_LOG_FUNCTION(this);
     m_socket = nullptr;
     m_unsentPacket = nullptr;
+    m_profile = nullptr;
 
 
 
@@ -203,7 +210,16 @@ Distributionapp::DoDispose()
 void
 Distributionapp::InitializeParams()
 {
-    
+    if (m_packetgentype == "Profile" || m_arrivalgentype == "Profile")
+    {
+        NS_ABORT_MSG_IF(m_profileFile.empty(), "Profile generation without ProfileFile");
+        m_profile = TrafficProfile::Load(m_profileFile);
+        m_profileState = 0;
+        if (!m_profileRng)
+        {
+            m_profileRng = CreateObject<UniformRandomVariable>();
+        }
+    }
 
     if (m_packetgentype == "Exp")
     {
@@ -226,6 +242,10 @@ Distributionapp::InitializeParams()
         m_packet_gen->SetAttribute("Alpha", DoubleValue(alfa));
         m_packet_gen->SetAttribute("Beta", DoubleValue(beta));
     }
+    else if (m_packetgentype == "Profile")
+    {
+        m_packet_gen = nullptr;
+    }
     else
     {
         m_packet_gen = CreateObject<ConstantRandomVariable>();
@@ -251,6 +271,10 @@ Distributionapp::InitializeParams()
         m_time_id->SetAttribute("Min", DoubleValue(0));
         m_time_id->SetAttribute("Max", DoubleValue(m_interval));
     }
+    else if (m_arrivalgentype == "Profile")
+    {
+        m_time_id = nullptr;
+    }
     else
     {
         m_time_id = CreateObject<ConstantRandomVariable>();
@@ -317,7 +341,7 @@ Distributionapp::StartApplication() // Called at time specified by Start
     if (m_connected)
     {   
         InitializeParams();
-        m_sendEvent = Simulator::Schedule(Seconds(m_time_id->GetValue()), &Distributionapp::SendPacket, this);
+        m_sendEvent = Simulator::Schedule(Seconds(NextGap()), &Distributionapp::SendPacket, this);
     }
 }
 
@@ -366,7 +390,7 @@ Distributionapp::SendPacket()
     else
     {
       
-        size  = m_packet_gen->GetValue();
+        size  = NextPacketSize();
         if (size > m_pktSizeMax){ // To bound the packet size 
             size = 0;
         }
@@ -418,7 +442,7 @@ Distributionapp::SendPacket()
 
     if (m_maxBytes == 0 || m_totBytes < m_maxBytes)
     {
-        m_sendEvent = Simulator::Schedule(Seconds((m_time_id->GetValue())), &Distributionapp::SendPacket, this);      
+        m_sendEvent = Simulator::Schedule(Seconds(NextGap()), &Distributionapp::SendPacket, this);
     }
     else
     { 
@@ -426,6 +450,35 @@ Distributionapp::SendPacket()
     }
 }
 
+uint32_t
+Distributionapp::NextPacketSize()
+{
+    if (m_packetgentype == "Profile")
+    {
+        return m_profile->GetPacketSize(m_profileState, m_profileRng->GetValue());
+    }
+    return m_packet_gen->GetValue();
+}
+
+double
+Distributionapp::NextGap()
+{
+    double gap;
+    if (m_arrivalgentype == "Profile")
+    {
+        gap = m_profile->GetGap(m_profileState, m_profileRng->GetValue());
+    }
+    else
+    {
+        gap = m_time_id->GetValue();
+    }
+    if (m_profile)
+    {
+        m_profileState = m_profile->GetNextState(m_profileState, m_profileRng->GetValue());
+    }
+    return gap;
+}
+
 void
 Distributionapp::ConnectionSucceeded(Ptr<Socket> socket)
 {
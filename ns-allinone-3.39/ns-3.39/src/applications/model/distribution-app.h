@@ -33,6 +33,7 @@
 #include "ns3/traced-callback.h"
 #include "ns3/double.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/traffic-profile.h"
 
 namespace ns3
 {
@@ -141,6 +142,19 @@ class Distributionapp : public Application
      */
     void SendPacket();
 
+    /**
+     * \brief Draw the size of the next packet
+     * \return the size, from the profile if PacketGen is "Profile"
+     */
+    uint32_t NextPacketSize();
+
+    /**
+     * \brief Draw the gap to the next packet and move to the state of the
+     * next packet of the profile, if any
+     * \return the gap in seconds, from the profile if ArrivalGen is "Profile"
+     */
+    double NextGap();
+
     Ptr<Socket> m_socket;                //!< Associated socket
     Address m_peer;                      //!< Peer address
     Address m_local;                     //!< Local address to bind to
@@ -163,6 +177,10 @@ class Distributionapp : public Application
     double m_interval;
     Ptr<RandomVariableStream> m_time_id;
     Ptr<RandomVariableStream> m_packet_gen;
+    std::string m_profileFile;             //!< File of the traffic profile
+    Ptr<const TrafficProfile> m_profile;   //!< Traffic profile, if used
+    Ptr<UniformRandomVariable> m_profileRng; //!< Uniforms for the traffic profile
+    uint32_t m_profileState{0};            //!< Current state of the traffic profile
 
     TypeId m_tid;                        //!< Type of the socket used
     uint32_t m_seq{0};                   //!< Sequence
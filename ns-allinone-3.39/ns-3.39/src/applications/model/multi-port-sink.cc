@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "multi-port-sink.h"
+
+#include "seq-ts-header.h"
+
+#include "ns3/boolean.h"
+#include "ns3/event-profiler.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/socket-factory.h"
+#include "ns3/socket.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MultiPortSink");
+
+NS_OBJECT_ENSURE_REGISTERED(MultiPortSink);
+
+/**
+ * \ingroup applications
+ * Packets received by the MultiPortSinks of the simulation of the thread.
+ */
+static thread_local uint64_t g_delivered = 0;
+
+/// Packets received by the MultiPortSinks, added to those of the other sinks
+static EventProfiler::CounterRegistration g_multiPortSinkProfilerCounter(
+    "packets delivered",
+    []() -> uint64_t { return g_delivered; });
+
+TypeId
+MultiPortSink::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultiPortSink")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<MultiPortSink>()
+            .AddAttribute("Local",
+                          "The Address on which to Bind the rx sockets, with the first port.",
+                          AddressValue(),
+                          MakeAddressAccessor(&MultiPortSink::m_local),
+                          MakeAddressChecker())
+            .AddAttribute("NPorts",
+                          "The number of consecutive ports to listen on.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&MultiPortSink::m_nPorts),
+                          MakeUintegerChecker<uint16_t>(1))
+            .AddAttribute("Protocol",
+                          "The type id of the protocol to use for the rx sockets.",
+                          TypeIdValue(UdpSocketFactory::GetTypeId()),
+                          MakeTypeIdAccessor(&MultiPortSink::m_tid),
+                          MakeTypeIdChecker())
+            .AddAttribute("EnableSeqTsHeader",
+                          "Measure the delay of the packets from their SeqTsHeader.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&MultiPortSink::m_enableSeqTsHeader),
+                          MakeBooleanChecker())
+            .AddTraceSource("Rx",
+                            "A packet has been received on a port",
+                            MakeTraceSourceAccessor(&MultiPortSink::m_rxTrace),
+                            "ns3::MultiPortSink::RxPortTracedCallback");
+    return tid;
+}
+
+MultiPortSink::MultiPortSink()
+    : m_firstPort(0),
+      m_totalRx(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MultiPortSink::~MultiPortSink()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultiPortSink::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_sockets.clear();
+    m_accepted.clear();
+    Application::DoDispose();
+}
+
+uint16_t
+MultiPortSink::GetFirstPort() const
+{
+    return m_firstPort;
+}
+
+uint16_t
+MultiPortSink::GetNPorts() const
+{
+    return m_nPorts;
+}
+
+uint64_t
+MultiPortSink::GetTotalRx() const
+{
+    return m_totalRx;
+}
+
+uint16_t
+MultiPortSink::GetOffset(uint16_t port) const
+{
+    NS_ABORT_MSG_IF(port < m_firstPort || port - m_firstPort >= static_cast<int>(m_stats.size()),
+                    "Port " << port << " out of the range of the sink");
+    return port - m_firstPort;
+}
+
+uint64_t
+MultiPortSink::GetRxPackets(uint16_t port) const
+{
+    return m_stats[GetOffset(port)].rxPackets;
+}
+
+uint64_t
+MultiPortSink::GetRxBytes(uint16_t port) const
+{
+    return m_stats[GetOffset(port)].rxBytes;
+}
+
+Time
+MultiPortSink::GetMeanDelay(uint16_t port) const
+{
+    const PortStats& stats = m_stats[GetOffset(port)];
+    if (stats.delayPackets == 0)
+    {
+        return Time(0);
+    }
+    return stats.delaySum / static_cast<int64_t>(stats.delayPackets);
+}
+
+Time
+MultiPortSink::GetMinDelay(uint16_t port) const
+{
+    return m_stats[GetOffset(port)].delayMin;
+}
+
+Time
+MultiPortSink::GetMaxDelay(uint16_t port) const
+{
+    return m_stats[GetOffset(port)].delayMax;
+}
+
+void
+MultiPortSink::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_sockets.empty())
+    {
+        return;
+    }
+
+    bool ipv6 = Inet6SocketAddress::IsMatchingType(m_local);
+    if (ipv6)
+    {
+        m_firstPort = Inet6SocketAddress::ConvertFrom(m_local).GetPort();
+    }
+    else if (InetSocketAddress::IsMatchingType(m_local))
+    {
+        m_firstPort = InetSocketAddress::ConvertFrom(m_local).GetPort();
+    }
+    else
+    {
+        NS_FATAL_ERROR("MultiPortSink needs an InetSocketAddress or Inet6SocketAddress");
+    }
+    NS_ABORT_MSG_IF(m_firstPort + m_nPorts - 1 > 65535, "Port range beyond port 65535");
+    m_stats.assign(m_nPorts, PortStats());
+
+    for (uint16_t offset = 0; offset < m_nPorts; offset++)
+    {
+        Address local;
+        if (ipv6)
+        {
+            Inet6SocketAddress address = Inet6SocketAddress::ConvertFrom(m_local);
+            address.SetPort(m_firstPort + offset);
+            local = address;
+        }
+        else
+        {
+            InetSocketAddress address = InetSocketAddress::ConvertFrom(m_local);
+            address.SetPort(m_firstPort + offset);
+            local = address;
+        }
+        Ptr<Socket> socket = Socket::CreateSocket(GetNode(), m_tid);
+        if (socket->Bind(local) == -1)
+        {
+            NS_FATAL_ERROR("Failed to bind socket to port " << m_firstPort + offset);
+        }
+        socket->Listen();
+        socket->ShutdownSend();
+        socket->SetRecvCallback(MakeCallback(&MultiPortSink::HandleRead, this).Bind(offset));
+        socket->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                                  MakeCallback(&MultiPortSink::HandleAccept, this).Bind(offset));
+        m_sockets.push_back(socket);
+    }
+}
+
+void
+MultiPortSink::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& socket : m_accepted)
+    {
+        socket->Close();
+    }
+    m_accepted.clear();
+    for (auto& socket : m_sockets)
+    {
+        socket->Close();
+        socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+    m_sockets.clear();
+}
+
+void
+MultiPortSink::HandleRead(uint16_t offset, Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << offset << socket);
+    PortStats& stats = m_stats[offset];
+    uint16_t port = m_firstPort + offset;
+    Ptr<Packet> packet;
+    Address from;
+    while ((packet = socket->RecvFrom(from)))
+    {
+        uint32_t size = packet->GetSize();
+        if (size == 0)
+        { // EOF
+            break;
+        }
+        stats.rxPackets++;
+        stats.rxBytes += size;
+        m_totalRx += size;
+        g_delivered++;
+        NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " multi-port sink received "
+                               << size << " bytes on port " << port << " from " << from);
+
+        // a packet too short for the header is counted without a delay
+        if (m_enableSeqTsHeader && size >= SeqTsHeader().GetSerializedSize())
+        {
+            SeqTsHeader header;
+            packet->PeekHeader(header);
+            Time delay = Simulator::Now() - header.GetTs();
+            if (stats.delayPackets == 0 || delay < stats.delayMin)
+            {
+                stats.delayMin = delay;
+            }
+            if (stats.delayPackets == 0 || delay > stats.delayMax)
+            {
+                stats.delayMax = delay;
+            }
+            stats.delaySum += delay;
+            stats.delayPackets++;
+        }
+        m_rxTrace(packet, from, port);
+    }
+}
+
+void
+MultiPortSink::HandleAccept(uint16_t offset, Ptr<Socket> socket, const Address& from)
+{
+    NS_LOG_FUNCTION(this << offset << socket << from);
+    socket->SetRecvCallback(MakeCallback(&MultiPortSink::HandleRead, this).Bind(offset));
+    m_accepted.push_back(socket);
+}
+
+} // namespace ns3
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MULTI_PORT_SINK_H
+#define MULTI_PORT_SINK_H
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+class Socket;
+class Packet;
+
+/**
+ * \ingroup applications
+ *
+ * \brief Receive the packets sent to a range of ports with one application.
+ *
+ * The sink listens on the ports [first, first + NPorts), where first is the
+ * port of the Local address.  There is one socket per port, as the transport
+ * protocols demultiplex by port, but all of them share the same receive
+ * handler, which is bound to the offset of the port in the range.  The
+ * counters of each port (packets, bytes and, optionally, delays) are kept in
+ * a flat array indexed by that offset, and a single trace source reports the
+ * port of every packet.  Unlike PacketSink, the received packets are not
+ * buffered per sender to rebuild SeqTsSizeHeader streams.
+ *
+ * When EnableSeqTsHeader is set, the packets are expected to start with a
+ * SeqTsHeader and the delay since its timestamp is accumulated per port.
+ */
+class MultiPortSink : public Application
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    MultiPortSink();
+    ~MultiPortSink() override;
+
+    /// \return the first port of the range
+    uint16_t GetFirstPort() const;
+
+    /// \return the number of ports of the range
+    uint16_t GetNPorts() const;
+
+    /// \return the total bytes received on all the ports
+    uint64_t GetTotalRx() const;
+
+    /**
+     * \param port the port
+     * \return the packets received on the port
+     */
+    uint64_t GetRxPackets(uint16_t port) const;
+
+    /**
+     * \param port the port
+     * \return the bytes received on the port
+     */
+    uint64_t GetRxBytes(uint16_t port) const;
+
+    /**
+     * \param port the port
+     * \return the mean delay of the packets received on the port, or zero
+     *         without delay measurements
+     */
+    Time GetMeanDelay(uint16_t port) const;
+
+    /**
+     * \param port the port
+     * \return the minimum delay of the packets received on the port
+     */
+    Time GetMinDelay(uint16_t port) const;
+
+    /**
+     * \param port the port
+     * \return the maximum delay of the packets received on the port
+     */
+    Time GetMaxDelay(uint16_t port) const;
+
+    /**
+     * TracedCallback signature for a reception on a port.
+     *
+     * \param [in] packet the packet received
+     * \param [in] from the source address
+     * \param [in] port the local port
+     */
+    typedef void (*RxPortTracedCallback)(Ptr<const Packet> packet,
+                                         const Address& from,
+                                         uint16_t port);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /**
+     * \brief Handle the packets received on a port.
+     * \param offset the offset of the port in the range
+     * \param socket the socket of the port
+     */
+    void HandleRead(uint16_t offset, Ptr<Socket> socket);
+
+    /**
+     * \brief Handle an incoming connection on a port.
+     * \param offset the offset of the port in the range
+     * \param socket the connected socket
+     * \param from the address of the peer
+     */
+    void HandleAccept(uint16_t offset, Ptr<Socket> socket, const Address& from);
+
+    /**
+     * \param port the port
+     * \return the offset of the port in the range
+     */
+    uint16_t GetOffset(uint16_t port) const;
+
+    /// Counters of a port
+    struct PortStats
+    {
+        uint64_t rxPackets{0};    //!< Packets received
+        uint64_t rxBytes{0};      //!< Bytes received
+        uint64_t delayPackets{0}; //!< Packets with a delay measurement
+        Time delaySum;            //!< Sum of the delays
+        Time delayMin;            //!< Minimum delay
+        Time delayMax;            //!< Maximum delay
+    };
+
+    Address m_local;                      //!< Local address and first port
+    uint16_t m_nPorts;                    //!< Number of ports
+    TypeId m_tid;                         //!< Protocol TypeId
+    bool m_enableSeqTsHeader;             //!< Measure the delays with a SeqTsHeader
+    std::vector<Ptr<Socket>> m_sockets;   //!< Listening socket of each port
+    std::vector<Ptr<Socket>> m_accepted;  //!< Accepted sockets
+    std::vector<PortStats> m_stats;       //!< Counters, by port offset
+    uint16_t m_firstPort;                 //!< First port
+    uint64_t m_totalRx;                   //!< Total bytes received
+
+    /// Traced Callback: received packets, source address and local port.
+    TracedCallback<Ptr<const Packet>, const Address&, uint16_t> m_rxTrace;
+};
+
+} // namespace ns3
+
+#endif /* MULTI_PORT_SINK_H */
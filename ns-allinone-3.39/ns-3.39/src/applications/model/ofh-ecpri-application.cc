@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ofh-ecpri-application.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/ecpri-header.h"
+#include "ns3/log.h"
+#include "ns3/packet-socket-address.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
+#include "ns3/vlan-header.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("OfhEcpriApplication");
+
+NS_OBJECT_ENSURE_REGISTERED(OfhEcpriApplication);
+
+TypeId
+OfhEcpriApplication::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::OfhEcpriApplication")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<OfhEcpriApplication>()
+            .AddAttribute("Remote",
+                          "The PacketSocketAddress of the destination (device and MAC address)",
+                          AddressValue(),
+                          MakeAddressAccessor(&OfhEcpriApplication::m_peer),
+                          MakeAddressChecker())
+            .AddAttribute("U-PacketSize",
+                          "The bytes of the U-plane messages after the eCPRI headers",
+                          UintegerValue(1000),
+                          MakeUintegerAccessor(&OfhEcpriApplication::m_uPktSize),
+                          MakeUintegerChecker<uint32_t>(1, 65531))
+            .AddAttribute("C-PacketSize",
+                          "The bytes of the C-plane messages after the eCPRI headers",
+                          UintegerValue(100),
+                          MakeUintegerAccessor(&OfhEcpriApplication::m_cPktSize),
+                          MakeUintegerChecker<uint32_t>(1, 65531))
+            .AddAttribute("U-Interval",
+                          "A RandomVariableStream used to pick the time (s) between U-plane "
+                          "messages",
+                          StringValue("ns3::ConstantRandomVariable[Constant=0.0001]"),
+                          MakePointerAccessor(&OfhEcpriApplication::m_uInterval),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("C-Interval",
+                          "A RandomVariableStream used to pick the time (s) between C-plane "
+                          "messages",
+                          StringValue("ns3::ConstantRandomVariable[Constant=0.001]"),
+                          MakePointerAccessor(&OfhEcpriApplication::m_cInterval),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("CUPlane",
+                          "Enable both planes Control and User Plane (CU-Plane)",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&OfhEcpriApplication::m_enableCPlane),
+                          MakeBooleanChecker())
+            .AddAttribute("U-Pcp",
+                          "The PCP of the U-plane frames",
+                          UintegerValue(7),
+                          MakeUintegerAccessor(&OfhEcpriApplication::m_uPcp),
+                          MakeUintegerChecker<uint8_t>(0, 7))
+            .AddAttribute("C-Pcp",
+                          "The PCP of the C-plane frames",
+                          UintegerValue(7),
+                          MakeUintegerAccessor(&OfhEcpriApplication::m_cPcp),
+                          MakeUintegerChecker<uint8_t>(0, 7))
+            .AddAttribute("Vid",
+                          "The VLAN of the frames",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&OfhEcpriApplication::m_vid),
+                          MakeUintegerChecker<uint16_t>(0, 4095))
+            .AddAttribute("PcId",
+                          "The PC_ID of the eAxC",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&OfhEcpriApplication::m_pcId),
+                          MakeUintegerChecker<uint16_t>())
+            .AddAttribute("MaxBytes",
+                          "The total number of bytes to send. Once these bytes are sent, "
+                          "no packet is sent again. The value zero means that there is no limit.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&OfhEcpriApplication::m_maxBytes),
+                          MakeUintegerChecker<uint64_t>())
+            .AddTraceSource("Tx",
+                            "A new packet is created and is sent",
+                            MakeTraceSourceAccessor(&OfhEcpriApplication::m_txTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("TxWithAddresses",
+                            "A new packet is created and is sent",
+                            MakeTraceSourceAccessor(&OfhEcpriApplication::m_txTraceWithAddresses),
+                            "ns3::Packet::TwoAddressTracedCallback");
+    return tid;
+}
+
+OfhEcpriApplication::OfhEcpriApplication()
+    : m_uSeq(0),
+      m_cSeq(0),
+      m_uPackets(0),
+      m_cPackets(0),
+      m_totBytes(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+OfhEcpriApplication::~OfhEcpriApplication()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+OfhEcpriApplication::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_socket = nullptr;
+    Application::DoDispose();
+}
+
+int64_t
+OfhEcpriApplication::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_uInterval->SetStream(stream);
+    m_cInterval->SetStream(stream + 1);
+    return 2;
+}
+
+uint64_t
+OfhEcpriApplication::GetUserPackets() const
+{
+    return m_uPackets;
+}
+
+uint64_t
+OfhEcpriApplication::GetControlPackets() const
+{
+    return m_cPackets;
+}
+
+uint64_t
+OfhEcpriApplication::GetTotalBytes() const
+{
+    return m_totBytes;
+}
+
+void
+OfhEcpriApplication::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_socket)
+    {
+        NS_ABORT_MSG_UNLESS(PacketSocketAddress::IsMatchingType(m_peer),
+                            "The Remote of an OfhEcpriApplication must be a PacketSocketAddress");
+        PacketSocketAddress peer = PacketSocketAddress::ConvertFrom(m_peer);
+        peer.SetProtocol(EcpriHeader::PROT_NUMBER);
+
+        m_socket = Socket::CreateSocket(GetNode(), TypeId::LookupByName("ns3::PacketSocketFactory"));
+        if (m_socket->Bind() == -1 || m_socket->Connect(peer) == -1)
+        {
+            NS_FATAL_ERROR("Failed to connect the packet socket");
+        }
+        m_socket->ShutdownRecv();
+        m_socket->GetSockName(m_sockName);
+        m_peer = peer;
+    }
+
+    // as the C-plane message that describes the U-plane data precedes it
+    if (m_enableCPlane)
+    {
+        m_cSendEvent = Simulator::ScheduleNow(&OfhEcpriApplication::ControlSendPacket, this);
+    }
+    m_uSendEvent = Simulator::ScheduleNow(&OfhEcpriApplication::UserSendPacket, this);
+}
+
+void
+OfhEcpriApplication::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    m_uSendEvent.Cancel();
+    m_cSendEvent.Cancel();
+    if (m_socket)
+    {
+        m_socket->Close();
+    }
+    else
+    {
+        NS_LOG_WARN("OfhEcpriApplication found null socket to close in StopApplication");
+    }
+}
+
+void
+OfhEcpriApplication::UserSendPacket()
+{
+    NS_LOG_FUNCTION(this);
+    if (SendMessage(EcpriHeader::IQ_DATA, m_uPktSize, m_uPcp, m_uSeq))
+    {
+        m_uSeq++;
+        m_uPackets++;
+    }
+    if (m_maxBytes == 0 || m_totBytes < m_maxBytes)
+    {
+        m_uSendEvent = Simulator::Schedule(Seconds(m_uInterval->GetValue()),
+                                           &OfhEcpriApplication::UserSendPacket,
+                                           this);
+    }
+}
+
+void
+OfhEcpriApplication::ControlSendPacket()
+{
+    NS_LOG_FUNCTION(this);
+    if (SendMessage(EcpriHeader::REAL_TIME_CONTROL, m_cPktSize, m_cPcp, m_cSeq))
+    {
+        m_cSeq++;
+        m_cPackets++;
+    }
+    if (m_maxBytes == 0 || m_totBytes < m_maxBytes)
+    {
+        m_cSendEvent = Simulator::Schedule(Seconds(m_cInterval->GetValue()),
+                                           &OfhEcpriApplication::ControlSendPacket,
+                                           this);
+    }
+}
+
+bool
+OfhEcpriApplication::SendMessage(uint8_t type, uint32_t size, uint8_t pcp, uint8_t seq)
+{
+    NS_LOG_FUNCTION(this << +type << size << +pcp << +seq);
+
+    EcpriHeader ecpri;
+    ecpri.SetMessageType(type);
+    ecpri.SetPcId(m_pcId);
+    // sequence number, E bit (last subsequence) and subsequence 0
+    ecpri.SetSeqId((seq << 8) | 0x80);
+    ecpri.SetPayloadSize(size + ecpri.GetSerializedSize() - 4);
+
+    Ptr<Packet> packet = Create<Packet>(size);
+    packet->AddHeader(ecpri);
+    packet->AddPacketTag(VlanTag(pcp, m_vid));
+
+    // trace before sending, the device adds its headers to the packet
+    m_txTrace(packet);
+    m_txTraceWithAddresses(packet, m_sockName, m_peer);
+    uint32_t bytes = packet->GetSize();
+    if (m_socket->Send(packet) != static_cast<int>(bytes))
+    {
+        NS_LOG_DEBUG("Unable to send eCPRI message of type " << +type);
+        return false;
+    }
+    m_totBytes += bytes;
+    NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " eCPRI message of type " << +type
+                           << " and " << bytes << " bytes sent to " << m_peer);
+    return true;
+}
+
+} // namespace ns3
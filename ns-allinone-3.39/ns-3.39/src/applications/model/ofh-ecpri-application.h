@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef OFH_ECPRI_APPLICATION_H
+#define OFH_ECPRI_APPLICATION_H
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3
+{
+
+class RandomVariableStream;
+class Socket;
+class Packet;
+
+/**
+ * \ingroup applications
+ *
+ * \brief Generate the O-RAN fronthaul traffic of an eAxC as eCPRI messages
+ * carried directly over Ethernet.
+ *
+ * The messages are sent through a packet socket, to the PacketSocketAddress
+ * of the Remote attribute (the outgoing device and the MAC address of the
+ * radio unit), with Ethertype 0xAEFE; no IP stack is needed.  The U-plane
+ * messages are IQ data messages, the C-plane messages (enabled with
+ * CUPlane) real-time control messages; both carry the PC_ID of the eAxC and
+ * a SEQ_ID with a sequence number per plane.  Every packet gets a VlanTag
+ * with the VID and the PCP of its plane, which the devices that frame the
+ * packets as Ethernet (PointToPointNetDevice) turn into the 802.1Q header
+ * of the frame and the queue discs can classify (PcpPacketFilter).
+ *
+ * As with ofhapplication, the sizes are the bytes after the eCPRI headers
+ * and the first messages of both planes are sent when the application
+ * starts; the next ones follow the intervals drawn from the U-Interval and
+ * C-Interval random variables (in seconds).
+ */
+class OfhEcpriApplication : public Application
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    OfhEcpriApplication();
+    ~OfhEcpriApplication() override;
+
+    /**
+     * \brief Assign a fixed random variable stream number to the random variables
+     * used by this model.
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
+    /// \return the number of U-plane messages sent
+    uint64_t GetUserPackets() const;
+
+    /// \return the number of C-plane messages sent
+    uint64_t GetControlPackets() const;
+
+    /// \return the number of bytes sent, eCPRI headers included
+    uint64_t GetTotalBytes() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /// Send a U-plane message and schedule the next one
+    void UserSendPacket();
+
+    /// Send a C-plane message and schedule the next one
+    void ControlSendPacket();
+
+    /**
+     * \brief Send an eCPRI message.
+     * \param type the message type
+     * \param size the bytes after the eCPRI headers
+     * \param pcp the PCP of the frame
+     * \param seq the sequence number of the plane
+     * \return true if the message was sent
+     */
+    bool SendMessage(uint8_t type, uint32_t size, uint8_t pcp, uint8_t seq);
+
+    Address m_peer;                       //!< Remote PacketSocketAddress
+    uint32_t m_uPktSize;                  //!< U-plane message size
+    uint32_t m_cPktSize;                  //!< C-plane message size
+    Ptr<RandomVariableStream> m_uInterval; //!< U-plane inter-message times
+    Ptr<RandomVariableStream> m_cInterval; //!< C-plane inter-message times
+    bool m_enableCPlane;                  //!< Send C-plane messages
+    uint8_t m_uPcp;                       //!< PCP of the U-plane
+    uint8_t m_cPcp;                       //!< PCP of the C-plane
+    uint16_t m_vid;                       //!< VLAN of the eAxC
+    uint16_t m_pcId;                      //!< PC_ID of the eAxC
+    uint64_t m_maxBytes;                  //!< Bytes to send (0 without limit)
+
+    Ptr<Socket> m_socket;                 //!< Packet socket
+    Address m_sockName;                   //!< Local address of the socket
+    EventId m_uSendEvent;                 //!< Next U-plane message
+    EventId m_cSendEvent;                 //!< Next C-plane message
+    uint8_t m_uSeq;                       //!< U-plane sequence number
+    uint8_t m_cSeq;                       //!< C-plane sequence number
+    uint64_t m_uPackets;                  //!< U-plane messages sent
+    uint64_t m_cPackets;                  //!< C-plane messages sent
+    uint64_t m_totBytes;                  //!< Bytes sent
+
+    /// Traced Callback: transmitted packets.
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+    /// Traced Callback: transmitted packets, with the local and remote addresses.
+    TracedCallback<Ptr<const Packet>, const Address&, const Address&> m_txTraceWithAddresses;
+};
+
+} // namespace ns3
+
+#endif /* OFH_ECPRI_APPLICATION_H */
@@ -21,6 +21,7 @@
 #include "ns3/address-utils.h"
 #include "ns3/address.h"
 #include "ns3/boolean.h"
+#include "ns3/event-profiler.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/inet6-socket-address.h"
 #include "ns3/ipv4-packet-info-tag.h"
@@ -42,6 +43,17 @@ NS_LOG_COMPONENT_DEFINE("PacketSink");
 
 NS_OBJECT_ENSURE_REGISTERED(PacketSink);
 
+/**
+ * \ingroup applications
+ * Packets received by the PacketSinks of the simulation of the thread.
+ */
+static thread_local uint64_t g_delivered = 0;
+
+/// Packets received by the PacketSinks, added to those of the other sinks
+static EventProfiler::CounterRegistration g_packetSinkProfilerCounter(
+    "packets delivered",
+    []() -> uint64_t { return g_delivered; });
+
 TypeId
 PacketSink::GetTypeId()
 {
@@ -205,6 +217,7 @@ PacketSink::HandleRead(Ptr<Socket> socket)
             break;
         }
         m_totalRx += packet->GetSize();
+        g_delivered++;
         if (InetSocketAddress::IsMatchingType(from))
         {
             NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " packet sink received "
@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcap-replay-application.h"
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet-socket-address.h"
+#include "ns3/packet.h"
+#include "ns3/pcap-file.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/socket-factory.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/udp-socket-factory.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapReplayApplication");
+
+NS_OBJECT_ENSURE_REGISTERED(PcapReplayApplication);
+
+/// Size of the pcap global header
+static const uint32_t PCAP_FILE_HEADER_SIZE = 24;
+/// Size of a pcap record header
+static const uint32_t PCAP_RECORD_HEADER_SIZE = 16;
+/// Ethernet link type
+static const uint32_t PCAP_LINKTYPE_ETHERNET = 1;
+/// eCPRI EtherType
+static const uint16_t ETHERTYPE_ECPRI = 0xAEFE;
+
+TypeId
+PcapReplayApplication::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PcapReplayApplication")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<PcapReplayApplication>()
+            .AddAttribute("Files",
+                          "Comma separated list of Ethernet pcap files to replay",
+                          StringValue(""),
+                          MakeStringAccessor(&PcapReplayApplication::m_files),
+                          MakeStringChecker())
+            .AddAttribute("Remote",
+                          "The address of the destination",
+                          AddressValue(),
+                          MakeAddressAccessor(&PcapReplayApplication::m_peer),
+                          MakeAddressChecker())
+            .AddAttribute("Protocol",
+                          "The type of protocol to use. This should be "
+                          "a subclass of ns3::SocketFactory",
+                          TypeIdValue(UdpSocketFactory::GetTypeId()),
+                          MakeTypeIdAccessor(&PcapReplayApplication::m_tid),
+                          MakeTypeIdChecker())
+            .AddAttribute("TimeScale",
+                          "Multiplier of the inter-frame times of the captures",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&PcapReplayApplication::m_timeScale),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("Phase",
+                          "A RandomVariableStream used to pick the start delay of each "
+                          "capture, in seconds",
+                          StringValue("ns3::ConstantRandomVariable[Constant=0]"),
+                          MakePointerAccessor(&PcapReplayApplication::m_phase),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("Loop",
+                          "Start a capture again when it ends",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapReplayApplication::m_loop),
+                          MakeBooleanChecker())
+            .AddAttribute("BurstThreshold",
+                          "Frames within this time of the first frame of a burst are sent "
+                          "in the same event",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&PcapReplayApplication::m_burstThreshold),
+                          MakeTimeChecker())
+            .AddAttribute("Filter",
+                          "Frames to replay",
+                          EnumValue(ECPRI_MESSAGES),
+                          MakeEnumAccessor(&PcapReplayApplication::m_filter),
+                          MakeEnumChecker(ALL_FRAMES,
+                                          "All",
+                                          ECPRI_MESSAGES,
+                                          "eCPRI",
+                                          IQ_DATA,
+                                          "IqData",
+                                          RT_CONTROL,
+                                          "RtControl"))
+            .AddAttribute("CopyPayload",
+                          "Send the captured bytes instead of a zero-filled payload",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapReplayApplication::m_copyPayload),
+                          MakeBooleanChecker())
+            .AddTraceSource("Tx",
+                            "A new packet is created and is sent",
+                            MakeTraceSourceAccessor(&PcapReplayApplication::m_txTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("TxEcpri",
+                            "An eCPRI frame is sent",
+                            MakeTraceSourceAccessor(&PcapReplayApplication::m_txEcpriTrace),
+                            "ns3::PcapReplayApplication::TxEcpriTracedCallback");
+    return tid;
+}
+
+PcapReplayApplication::PcapReplayApplication()
+    : m_sentPackets(0),
+      m_sentBytes(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PcapReplayApplication::~PcapReplayApplication()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+PcapReplayApplication::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& capture : m_captures)
+    {
+        CloseCapture(capture);
+    }
+    m_captures.clear();
+    m_socket = nullptr;
+    Application::DoDispose();
+}
+
+int64_t
+PcapReplayApplication::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_phase->SetStream(stream);
+    return 1;
+}
+
+uint64_t
+PcapReplayApplication::GetSentPackets() const
+{
+    return m_sentPackets;
+}
+
+uint64_t
+PcapReplayApplication::GetSentBytes() const
+{
+    return m_sentBytes;
+}
+
+bool
+PcapReplayApplication::DecodeEcpri(const uint8_t* frame, uint32_t length, EcpriInfo& info)
+{
+    info = EcpriInfo();
+    if (length < 14)
+    {
+        return false;
+    }
+    uint32_t offset = 12;
+    uint16_t etherType = (frame[offset] << 8) | frame[offset + 1];
+    offset += 2;
+    // 802.1Q and 802.1ad tags
+    while ((etherType == 0x8100 || etherType == 0x88A8) && offset + 4 <= length)
+    {
+        uint16_t tci = (frame[offset] << 8) | frame[offset + 1];
+        info.pcp = tci >> 13;
+        info.vlanId = tci & 0x0FFF;
+        etherType = (frame[offset + 2] << 8) | frame[offset + 3];
+        offset += 4;
+    }
+    info.headerLength = offset;
+    if (etherType != ETHERTYPE_ECPRI || offset + 4 > length)
+    {
+        return false;
+    }
+
+    // eCPRI common header: revision, message type and payload size
+    const uint8_t* ecpri = frame + offset;
+    info.messageType = ecpri[1];
+    info.payloadSize = (ecpri[2] << 8) | ecpri[3];
+    if ((info.messageType != 0 && info.messageType != 2) || offset + 8 > length)
+    {
+        return true;
+    }
+    info.pcId = (ecpri[4] << 8) | ecpri[5];
+    info.seqId = ecpri[6];
+
+    // O-RAN radio application common header
+    const uint8_t* radio = ecpri + 8;
+    if (offset + 12 > length)
+    {
+        return true;
+    }
+    info.oran = true;
+    info.dataDirection = radio[0] >> 7;
+    info.frameId = radio[1];
+    info.subframeId = radio[2] >> 4;
+    info.slotId = ((radio[2] & 0x0F) << 2) | (radio[3] >> 6);
+    info.symbolId = radio[3] & 0x3F;
+
+    // first section header, after the section type specific common fields
+    const uint8_t* section = radio + 4;
+    if (info.messageType == 2)
+    {
+        uint8_t sectionType = offset + 14 <= length ? radio[5] : 1;
+        section = radio + (sectionType == 0 || sectionType == 3 ? 12 : 8);
+    }
+    if (section + 4 <= frame + length)
+    {
+        info.sectionId = (section[0] << 4) | (section[1] >> 4);
+        info.startPrb = ((section[1] & 0x03) << 8) | section[2];
+        info.numPrb = section[3];
+    }
+    return true;
+}
+
+void
+PcapReplayApplication::OpenCapture(Capture& capture, Time start)
+{
+    NS_LOG_FUNCTION(this << capture.fileName << start);
+#ifdef __WIN32__
+    NS_FATAL_ERROR("PcapReplayApplication requires mmap(), which is not available on this "
+                   "platform");
+#else
+    // the global header is validated by PcapFile, the records are mapped
+    PcapFile file;
+    file.Open(capture.fileName, std::ios::in);
+    NS_ABORT_MSG_IF(file.Fail(), "Cannot open the capture " << capture.fileName);
+    NS_ABORT_MSG_IF(file.GetDataLinkType() != PCAP_LINKTYPE_ETHERNET,
+                    "The capture " << capture.fileName << " is not an Ethernet capture");
+    capture.swap = file.GetSwapMode();
+    capture.nanoSec = file.IsNanoSecMode();
+    file.Close();
+
+    int fd = open(capture.fileName.c_str(), O_RDONLY);
+    NS_ABORT_MSG_IF(fd < 0, "Cannot open the capture " << capture.fileName);
+    struct stat st;
+    NS_ABORT_MSG_IF(fstat(fd, &st) != 0, "Cannot stat the capture " << capture.fileName);
+    capture.size = st.st_size;
+    void* data = mmap(nullptr, capture.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    NS_ABORT_MSG_IF(data == MAP_FAILED, "Cannot map the capture " << capture.fileName);
+    madvise(data, capture.size, MADV_SEQUENTIAL);
+    capture.data = static_cast<const uint8_t*>(data);
+    capture.offset = PCAP_FILE_HEADER_SIZE;
+    capture.firstTs = -1;
+    capture.base = start;
+    capture.lastRel = Seconds(0);
+    capture.firstGap = Seconds(0);
+#endif
+}
+
+void
+PcapReplayApplication::CloseCapture(Capture& capture)
+{
+    NS_LOG_FUNCTION(this << capture.fileName);
+#ifndef __WIN32__
+    if (capture.data)
+    {
+        munmap(const_cast<uint8_t*>(capture.data), capture.size);
+        capture.data = nullptr;
+    }
+#endif
+}
+
+bool
+PcapReplayApplication::Advance(Capture& capture)
+{
+    while (true)
+    {
+        if (capture.offset + PCAP_RECORD_HEADER_SIZE > capture.size)
+        {
+            // the next pass starts one initial gap after the last frame
+            Time period = capture.lastRel + capture.firstGap;
+            if (!m_loop || capture.firstTs < 0 || !period.IsStrictlyPositive())
+            {
+                return false;
+            }
+            NS_LOG_LOGIC("Looping " << capture.fileName);
+            capture.base += period;
+            capture.offset = PCAP_FILE_HEADER_SIZE;
+            continue;
+        }
+
+        uint32_t fields[4];
+        std::memcpy(fields, capture.data + capture.offset, sizeof(fields));
+        if (capture.swap)
+        {
+            for (auto& field : fields)
+            {
+                field = __builtin_bswap32(field);
+            }
+        }
+        if (capture.offset + PCAP_RECORD_HEADER_SIZE + fields[2] > capture.size)
+        {
+            NS_LOG_WARN("Truncated record in " << capture.fileName);
+            capture.offset = capture.size;
+            continue;
+        }
+
+        int64_t ts = int64_t(fields[0]) * 1000000000 + fields[1] * (capture.nanoSec ? 1 : 1000);
+        if (capture.firstTs < 0)
+        {
+            capture.firstTs = ts;
+        }
+        Time rel = NanoSeconds(int64_t((ts - capture.firstTs) * m_timeScale));
+        if (rel > capture.lastRel)
+        {
+            if (capture.firstGap.IsZero())
+            {
+                capture.firstGap = rel;
+            }
+            capture.lastRel = rel;
+        }
+        capture.next = capture.base + rel;
+        capture.frame = capture.data + capture.offset + PCAP_RECORD_HEADER_SIZE;
+        capture.capLength = fields[2];
+        capture.origLength = fields[3];
+        capture.offset += PCAP_RECORD_HEADER_SIZE + fields[2];
+        return true;
+    }
+}
+
+void
+PcapReplayApplication::SendFrame(const Capture& capture)
+{
+    EcpriInfo info;
+    bool ecpri = DecodeEcpri(capture.frame, capture.capLength, info);
+    if ((m_filter != ALL_FRAMES && !ecpri) || (m_filter == IQ_DATA && info.messageType != 0) ||
+        (m_filter == RT_CONTROL && info.messageType != 2) ||
+        capture.origLength <= info.headerLength)
+    {
+        return;
+    }
+
+    uint32_t size = capture.origLength - info.headerLength;
+    Ptr<Packet> packet;
+    if (m_copyPayload)
+    {
+        uint32_t captured = std::min(size, capture.capLength - info.headerLength);
+        packet = Create<Packet>(capture.frame + info.headerLength, captured);
+        packet->AddPaddingAtEnd(size - captured);
+    }
+    else
+    {
+        packet = Create<Packet>(size);
+    }
+
+    m_txTrace(packet);
+    if (ecpri)
+    {
+        m_txEcpriTrace(packet, info);
+    }
+    m_socket->Send(packet);
+    m_sentPackets++;
+    m_sentBytes += size;
+}
+
+void
+PcapReplayApplication::SendBurst()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    Time limit = now + m_burstThreshold;
+    while (!m_pending.empty() && m_pending.top().first <= limit)
+    {
+        uint32_t index = m_pending.top().second;
+        m_pending.pop();
+        Capture& capture = m_captures[index];
+        SendFrame(capture);
+        if (Advance(capture))
+        {
+            m_pending.emplace(capture.next, index);
+        }
+        else
+        {
+            NS_LOG_INFO("End of " << capture.fileName);
+            CloseCapture(capture);
+        }
+    }
+    if (!m_pending.empty())
+    {
+        m_sendEvent = Simulator::Schedule(Max(m_pending.top().first - now, Seconds(0)),
+                                          &PcapReplayApplication::SendBurst,
+                                          this);
+    }
+}
+
+void
+PcapReplayApplication::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_socket)
+    {
+        m_socket = Socket::CreateSocket(GetNode(), m_tid);
+        int ret = -1;
+        if (Inet6SocketAddress::IsMatchingType(m_peer))
+        {
+            ret = m_socket->Bind6();
+        }
+        else if (InetSocketAddress::IsMatchingType(m_peer) ||
+                 PacketSocketAddress::IsMatchingType(m_peer))
+        {
+            ret = m_socket->Bind();
+        }
+        if (ret == -1)
+        {
+            NS_FATAL_ERROR("Failed to bind socket");
+        }
+        m_socket->Connect(m_peer);
+        m_socket->SetAllowBroadcast(true);
+        m_socket->ShutdownRecv();
+    }
+
+    NS_ABORT_MSG_IF(m_files.empty(), "No capture to replay");
+    std::vector<std::string> files;
+    std::istringstream list(m_files);
+    for (std::string file; std::getline(list, file, ',');)
+    {
+        files.push_back(file);
+    }
+    m_captures.clear();
+    m_captures.resize(files.size());
+    for (uint32_t i = 0; i < files.size(); i++)
+    {
+        m_captures[i].fileName = files[i];
+        OpenCapture(m_captures[i], Simulator::Now() + Seconds(m_phase->GetValue()));
+        if (Advance(m_captures[i]))
+        {
+            m_pending.emplace(m_captures[i].next, i);
+        }
+    }
+    if (!m_pending.empty())
+    {
+        m_sendEvent = Simulator::Schedule(Max(m_pending.top().first - Simulator::Now(), Seconds(0)),
+                                          &PcapReplayApplication::SendBurst,
+                                          this);
+    }
+}
+
+void
+PcapReplayApplication::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    m_sendEvent.Cancel();
+    m_pending = decltype(m_pending)();
+    for (auto& capture : m_captures)
+    {
+        CloseCapture(capture);
+    }
+    if (m_socket)
+    {
+        m_socket->Close();
+    }
+}
+
+} // namespace ns3
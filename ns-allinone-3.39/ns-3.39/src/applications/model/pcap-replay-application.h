@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_REPLAY_APPLICATION_H
+#define PCAP_REPLAY_APPLICATION_H
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class RandomVariableStream;
+class Socket;
+class Packet;
+
+/**
+ * \ingroup applications
+ *
+ * \brief Replay the frames of real fronthaul captures (Ethernet pcap files).
+ *
+ * The captures listed in "Files" (comma separated) are mapped in memory and
+ * streamed record by record, so that they are never loaded as a whole.  For
+ * every frame the Ethernet and VLAN headers are stripped and, if the
+ * EtherType is eCPRI, the eCPRI common header and the O-RAN radio
+ * application and section headers are decoded (see DecodeEcpri).  The
+ * remaining PDU (starting at the eCPRI header) is sent to "Remote" with its
+ * original size, either as a zero-filled (virtual) payload or, with
+ * "CopyPayload", with the captured bytes.
+ *
+ * The inter-frame timing of each capture is preserved, multiplied by
+ * "TimeScale".  When several captures are given they are merged, each one
+ * starting after a delay drawn from "Phase" (e.g. a uniform random variable
+ * to emulate radios with random relative phase).  With "Loop" a capture
+ * starts again when it ends.
+ *
+ * A single event is scheduled per burst: all the frames whose time lies
+ * within "BurstThreshold" of the first frame of the burst are sent in the
+ * same event.  With the default threshold of zero only frames with
+ * identical timestamps are grouped, which preserves the timing exactly.
+ */
+class PcapReplayApplication : public Application
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    PcapReplayApplication();
+    ~PcapReplayApplication() override;
+
+    /// Frames to replay, by eCPRI message type
+    enum MessageFilter
+    {
+        ALL_FRAMES,     //!< All the frames, eCPRI or not
+        ECPRI_MESSAGES, //!< All the eCPRI messages
+        IQ_DATA,        //!< eCPRI IQ data messages (O-RAN U-plane)
+        RT_CONTROL      //!< eCPRI real-time control messages (O-RAN C-plane)
+    };
+
+    /// Headers of an eCPRI frame carrying O-RAN fronthaul messages
+    struct EcpriInfo
+    {
+        uint16_t vlanId{0};        //!< VLAN identifier (0 if untagged)
+        uint8_t pcp{0};            //!< VLAN priority code point
+        uint8_t messageType{0};    //!< eCPRI message type
+        uint16_t payloadSize{0};   //!< eCPRI payload size
+        uint16_t pcId{0};          //!< eAxC identifier (PC_ID/RTC_ID)
+        uint8_t seqId{0};          //!< Sequence identifier
+        bool oran{false};          //!< O-RAN headers were decoded
+        uint8_t dataDirection{0};  //!< 1 for downlink, 0 for uplink
+        uint8_t frameId{0};        //!< Radio frame
+        uint8_t subframeId{0};     //!< Subframe
+        uint8_t slotId{0};         //!< Slot
+        uint8_t symbolId{0};       //!< First symbol
+        uint16_t sectionId{0};     //!< First section
+        uint16_t startPrb{0};      //!< First PRB of the first section
+        uint16_t numPrb{0};        //!< Number of PRBs of the first section (0 means all)
+        uint32_t headerLength{0};  //!< Bytes before the eCPRI header (Ethernet and VLANs)
+    };
+
+    /**
+     * \brief Decode the headers of an Ethernet frame carrying eCPRI.
+     * \param frame the frame, starting at the Ethernet destination address
+     * \param length the number of available bytes
+     * \param info the decoded headers
+     * \return true if the frame is an eCPRI frame
+     */
+    static bool DecodeEcpri(const uint8_t* frame, uint32_t length, EcpriInfo& info);
+
+    /**
+     * \brief Assign a fixed random variable stream number to the random variables
+     * used by this model.
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
+    /// \return the number of frames sent
+    uint64_t GetSentPackets() const;
+
+    /// \return the number of bytes sent
+    uint64_t GetSentBytes() const;
+
+    /**
+     * TracedCallback signature for sent eCPRI frames.
+     *
+     * \param [in] packet the packet sent
+     * \param [in] info the decoded headers of the frame
+     */
+    typedef void (*TxEcpriTracedCallback)(Ptr<const Packet> packet, const EcpriInfo& info);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /// A capture mapped in memory
+    struct Capture
+    {
+        std::string fileName;        //!< File name
+        const uint8_t* data{nullptr}; //!< Mapped file
+        std::size_t size{0};          //!< Size of the file
+        std::size_t offset{0};        //!< Offset of the next record header
+        bool swap{false};             //!< Records in the other byte order
+        bool nanoSec{false};          //!< Nanosecond timestamps
+        int64_t firstTs{-1};          //!< Timestamp of the first record (ns)
+        Time base;                    //!< Simulation time of the first record
+        Time lastRel;                 //!< Scaled time of the last record from the first one
+        Time firstGap;                //!< Scaled gap between the first two records
+        Time next;                    //!< Simulation time of the current record
+        const uint8_t* frame{nullptr}; //!< Current frame
+        uint32_t capLength{0};        //!< Captured length of the current frame
+        uint32_t origLength{0};       //!< Original length of the current frame
+    };
+
+    /**
+     * \brief Map a capture and read its first record.
+     * \param capture the capture
+     * \param start simulation time of the first record
+     */
+    void OpenCapture(Capture& capture, Time start);
+    /**
+     * \brief Unmap a capture.
+     * \param capture the capture
+     */
+    void CloseCapture(Capture& capture);
+    /**
+     * \brief Read the next record of a capture, looping if enabled.
+     * \param capture the capture
+     * \return false if the capture has no more records
+     */
+    bool Advance(Capture& capture);
+    /**
+     * \brief Send the current frame of a capture, if it passes the filter.
+     * \param capture the capture
+     */
+    void SendFrame(const Capture& capture);
+    /// Send all the frames of the burst starting now and schedule the next one
+    void SendBurst();
+
+    /// Pending capture, ordered by the time of its current record
+    typedef std::pair<Time, uint32_t> Pending;
+
+    std::string m_files;                  //!< Comma separated capture files
+    Address m_peer;                       //!< Remote address
+    TypeId m_tid;                         //!< Socket factory type
+    double m_timeScale;                   //!< Inter-frame time multiplier
+    Ptr<RandomVariableStream> m_phase;    //!< Start delay of each capture (s)
+    bool m_loop;                          //!< Restart the captures when they end
+    Time m_burstThreshold;                //!< Maximum spread of a burst
+    MessageFilter m_filter;               //!< Frames to replay
+    bool m_copyPayload;                   //!< Send the captured bytes
+    std::vector<Capture> m_captures;      //!< Open captures
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>>
+        m_pending;                        //!< Captures by time of the next frame
+    Ptr<Socket> m_socket;                 //!< Socket
+    EventId m_sendEvent;                  //!< Next burst
+    uint64_t m_sentPackets;               //!< Frames sent
+    uint64_t m_sentBytes;                 //!< Bytes sent
+
+    /// Traced Callback: transmitted packets.
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+    /// Traced Callback: transmitted eCPRI frames with their decoded headers.
+    TracedCallback<Ptr<const Packet>, const EcpriInfo&> m_txEcpriTrace;
+};
+
+} // namespace ns3
+
+#endif /* PCAP_REPLAY_APPLICATION_H */
@@ -228,6 +228,9 @@ Poissonapp::StartApplication() // Called at time specified by Start
             m_packet_gen->SetAttribute("Mean", DoubleValue (m_pktSize));
             m_packet_gen->SetAttribute("Bound", DoubleValue (60000));
         }
+        // discard the values drawn with the previous parameters
+        m_nextInterArrival = m_interArrivals.size();
+        m_nextPacketSize = m_packetSizes.size();
         m_sendEvent = Simulator::Schedule(Seconds(0), &Poissonapp::SendPacket, this);
         // std::cout << "Connected" << std::endl;
     }
@@ -250,6 +253,19 @@ Poissonapp::StopApplication() // Called at time specified by Stop
 
 
 
+double
+Poissonapp::DrawNext(Ptr<RandomVariableStream> rv, std::vector<double>& block, std::size_t& next)
+{
+    if (next == block.size())
+    {
+        // one call per block instead of one virtual call per value
+        block.resize(64);
+        rv->GetValues(block.data(), block.size());
+        next = 0;
+    }
+    return block[next++];
+}
+
 void
 Poissonapp::SendPacket()
 {
@@ -262,23 +278,19 @@ Poissonapp::SendPacket()
     Ptr<Packet> packet;
     if (m_enableSeqTsSizeHeader)
     {
-        Address from;
-        Address to;
-        m_socket->GetSockName(from);
-        m_socket->GetPeerName(to);
         SeqTsSizeHeader header;
         header.SetSeq(m_seq++);
         header.SetSize(m_pktSize);
         NS_ABORT_IF(m_pktSize < header.GetSerializedSize());
         packet = Create<Packet>(m_pktSize - header.GetSerializedSize());
         // Trace before adding header, for consistency with PacketSink
-        m_txTraceWithSeqTsSize(packet, from, to, header);
+        m_txTraceWithSeqTsSize(packet, m_sockName, m_peerName, header);
         packet->AddHeader(header);
     }
     else
     {
         if (m_packetgentype == "mm1"){
-            size  = m_packet_gen->GetValue();
+            size  = DrawNext(m_packet_gen, m_packetSizes, m_nextPacketSize);
             if (size == 0){
                 size = 1;
             }
@@ -296,8 +308,6 @@ Poissonapp::SendPacket()
         m_txTrace(packet);
         m_totBytes += m_pktSize;
         m_unsentPacket = nullptr;
-        Address localAddress;
-        m_socket->GetSockName(localAddress);
         if (InetSocketAddress::IsMatchingType(m_peer))
         {
             NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " poisson application sent "
@@ -305,7 +315,7 @@ Poissonapp::SendPacket()
                                    << InetSocketAddress::ConvertFrom(m_peer).GetIpv4() << " port "
                                    << InetSocketAddress::ConvertFrom(m_peer).GetPort()
                                    << " total Tx " << m_totBytes << " bytes");
-            m_txTraceWithAddresses(packet, localAddress, InetSocketAddress::ConvertFrom(m_peer));
+            m_txTraceWithAddresses(packet, m_sockName, m_peer);
         }
         else if (Inet6SocketAddress::IsMatchingType(m_peer))
         {
@@ -314,7 +324,7 @@ Poissonapp::SendPacket()
                                    << Inet6SocketAddress::ConvertFrom(m_peer).GetIpv6() << " port "
                                    << Inet6SocketAddress::ConvertFrom(m_peer).GetPort()
                                    << " total Tx " << m_totBytes << " bytes");
-            m_txTraceWithAddresses(packet, localAddress, Inet6SocketAddress::ConvertFrom(m_peer));
+            m_txTraceWithAddresses(packet, m_sockName, m_peer);
         }
     }
     else
@@ -332,7 +342,7 @@ Poissonapp::SendPacket()
         if (m_packetgentype == "cte"){
             m_sendEvent = Simulator::Schedule(Seconds(m_interval), &Poissonapp::SendPacket, this);
         }else{
-            m_sendEvent = Simulator::Schedule(Seconds((m_time_id->GetValue())), &Poissonapp::SendPacket, this);
+            m_sendEvent = Simulator::Schedule(Seconds(DrawNext(m_time_id, m_interArrivals, m_nextInterArrival)), &Poissonapp::SendPacket, this);
         }
            
     }
@@ -347,6 +357,10 @@ Poissonapp::ConnectionSucceeded(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
 
+    // the addresses of a connected socket do not change, hence they are
+    // retrieved once here rather than for every traced packet
+    socket->GetSockName(m_sockName);
+    socket->GetPeerName(m_peerName);
     m_connected = true;
 }
 
@@ -34,6 +34,8 @@
 #include "ns3/double.h"
 #include "ns3/random-variable-stream.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -141,9 +143,21 @@ class Poissonapp : public Application
      */
     void SendPacket();
 
+    /**
+     * \brief Get the next value of a random variable, drawn in blocks
+     *        with RandomVariableStream::GetValues
+     * \param rv the random variable
+     * \param block the values drawn
+     * \param next the next value of the block
+     * \return the value
+     */
+    double DrawNext(Ptr<RandomVariableStream> rv, std::vector<double>& block, std::size_t& next);
+
     Ptr<Socket> m_socket;                //!< Associated socket
     Address m_peer;                      //!< Peer address
     Address m_local;                     //!< Local address to bind to
+    Address m_sockName;                  //!< Local address of the socket (cached for tracing)
+    Address m_peerName;                  //!< Peer address of the socket (cached for tracing)
     bool m_connected;                    //!< True if connected
     DataRate m_cbrRate;                  //!< Rate that data is generated
     DataRate m_cbrRateFailSafe;          //!< Rate that data is generated (check copy)
@@ -158,6 +172,10 @@ class Poissonapp : public Application
     double m_interval;
     Ptr<ExponentialRandomVariable> m_time_id;
     Ptr<ExponentialRandomVariable> m_packet_gen;
+    std::vector<double> m_interArrivals; //!< Inter-arrival times drawn in a block
+    std::size_t m_nextInterArrival{0};   //!< Next inter-arrival time of the block
+    std::vector<double> m_packetSizes;   //!< Packet sizes drawn in a block
+    std::size_t m_nextPacketSize{0};     //!< Next packet size of the block
     TypeId m_tid;                        //!< Type of the socket used
     uint32_t m_seq{0};                   //!< Sequence
     Ptr<Packet> m_unsentPacket;          //!< Unsent packet cached for future attempt
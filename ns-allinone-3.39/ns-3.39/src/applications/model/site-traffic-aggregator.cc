@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "site-traffic-aggregator.h"
+
+#include "ns3/double.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/socket-factory.h"
+#include "ns3/socket.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SiteTrafficAggregator");
+
+NS_OBJECT_ENSURE_REGISTERED(SiteTrafficAggregator);
+
+TypeId
+SiteTrafficAggregator::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SiteTrafficAggregator")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<SiteTrafficAggregator>()
+            .AddAttribute("Local",
+                          "The Address on which to bind the socket. If not set, it is generated "
+                          "automatically.",
+                          AddressValue(),
+                          MakeAddressAccessor(&SiteTrafficAggregator::m_local),
+                          MakeAddressChecker())
+            .AddAttribute("Protocol",
+                          "The type of protocol to use. This should be "
+                          "a subclass of ns3::SocketFactory",
+                          TypeIdValue(UdpSocketFactory::GetTypeId()),
+                          MakeTypeIdAccessor(&SiteTrafficAggregator::m_tid),
+                          MakeTypeIdChecker())
+            .AddTraceSource("Tx",
+                            "A new packet is created and is sent",
+                            MakeTraceSourceAccessor(&SiteTrafficAggregator::m_txTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("TxWithAddresses",
+                            "A new packet is created and is sent",
+                            MakeTraceSourceAccessor(&SiteTrafficAggregator::m_txTraceWithAddresses),
+                            "ns3::Packet::TwoAddressTracedCallback")
+            .AddTraceSource("TxFlow",
+                            "A new packet of a flow is created and is sent",
+                            MakeTraceSourceAccessor(&SiteTrafficAggregator::m_txFlowTrace),
+                            "ns3::SiteTrafficAggregator::TxFlowTracedCallback");
+    return tid;
+}
+
+SiteTrafficAggregator::SiteTrafficAggregator()
+    : m_failedPackets(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SiteTrafficAggregator::~SiteTrafficAggregator()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+SiteTrafficAggregator::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_socket = nullptr;
+    m_flows.clear();
+    m_pending = decltype(m_pending)();
+    Application::DoDispose();
+}
+
+uint32_t
+SiteTrafficAggregator::AddFlow(const Address& peer,
+                               Ptr<RandomVariableStream> packetSize,
+                               Ptr<RandomVariableStream> interArrival,
+                               uint64_t maxBytes)
+{
+    NS_LOG_FUNCTION(this << peer << packetSize << interArrival << maxBytes);
+    m_flows.push_back(Flow{peer, packetSize, interArrival, maxBytes, 0, 0});
+    return m_flows.size() - 1;
+}
+
+uint32_t
+SiteTrafficAggregator::AddPoissonFlow(const Address& peer,
+                                      uint32_t packetSize,
+                                      double interval,
+                                      const std::string& packetGen,
+                                      uint64_t maxBytes)
+{
+    NS_LOG_FUNCTION(this << peer << packetSize << interval << packetGen << maxBytes);
+    Ptr<RandomVariableStream> size;
+    if (packetGen == "mm1")
+    {
+        size = CreateObjectWithAttributes<ExponentialRandomVariable>("Mean",
+                                                                     DoubleValue(packetSize),
+                                                                     "Bound",
+                                                                     DoubleValue(60000));
+    }
+    else
+    {
+        size = CreateObjectWithAttributes<ConstantRandomVariable>("Constant",
+                                                                  DoubleValue(packetSize));
+    }
+    Ptr<RandomVariableStream> gap;
+    if (packetGen == "cte")
+    {
+        gap = CreateObjectWithAttributes<ConstantRandomVariable>("Constant", DoubleValue(interval));
+    }
+    else
+    {
+        gap = CreateObjectWithAttributes<ExponentialRandomVariable>("Mean", DoubleValue(interval));
+    }
+    return AddFlow(peer, size, gap, maxBytes);
+}
+
+uint32_t
+SiteTrafficAggregator::GetNFlows() const
+{
+    return m_flows.size();
+}
+
+Address
+SiteTrafficAggregator::GetPeer(uint32_t flow) const
+{
+    return m_flows.at(flow).peer;
+}
+
+uint64_t
+SiteTrafficAggregator::GetSentPackets(uint32_t flow) const
+{
+    return m_flows.at(flow).sentPackets;
+}
+
+uint64_t
+SiteTrafficAggregator::GetSentBytes(uint32_t flow) const
+{
+    return m_flows.at(flow).sentBytes;
+}
+
+uint64_t
+SiteTrafficAggregator::GetFailedPackets() const
+{
+    return m_failedPackets;
+}
+
+int64_t
+SiteTrafficAggregator::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    int64_t current = stream;
+    for (auto& flow : m_flows)
+    {
+        flow.packetSize->SetStream(current++);
+        flow.interArrival->SetStream(current++);
+    }
+    return current - stream;
+}
+
+void
+SiteTrafficAggregator::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_flows.empty())
+    {
+        return;
+    }
+
+    if (!m_socket)
+    {
+        m_socket = Socket::CreateSocket(GetNode(), m_tid);
+        int ret;
+        if (!m_local.IsInvalid())
+        {
+            ret = m_socket->Bind(m_local);
+        }
+        else if (Inet6SocketAddress::IsMatchingType(m_flows.front().peer))
+        {
+            ret = m_socket->Bind6();
+        }
+        else
+        {
+            ret = m_socket->Bind();
+        }
+        if (ret == -1)
+        {
+            NS_FATAL_ERROR("Failed to bind socket");
+        }
+        m_socket->SetAllowBroadcast(true);
+        m_socket->ShutdownRecv();
+        m_socket->GetSockName(m_sockName);
+    }
+
+    // as a Poissonapp, every flow sends its first packet at start
+    Time now = Simulator::Now();
+    for (uint32_t i = 0; i < m_flows.size(); i++)
+    {
+        m_pending.emplace(now, i);
+    }
+    m_sendEvent = Simulator::ScheduleNow(&SiteTrafficAggregator::SendDue, this);
+}
+
+void
+SiteTrafficAggregator::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    m_sendEvent.Cancel();
+    m_pending = decltype(m_pending)();
+    if (m_socket)
+    {
+        m_socket->Close();
+    }
+    else
+    {
+        NS_LOG_WARN("SiteTrafficAggregator found null socket to close in StopApplication");
+    }
+}
+
+void
+SiteTrafficAggregator::SendDue()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    while (!m_pending.empty() && m_pending.top().first <= now)
+    {
+        uint32_t index = m_pending.top().second;
+        m_pending.pop();
+        SendPacket(index);
+        Flow& flow = m_flows[index];
+        if (flow.maxBytes == 0 || flow.sentBytes < flow.maxBytes)
+        {
+            m_pending.emplace(now + Seconds(flow.interArrival->GetValue()), index);
+        }
+    }
+    if (!m_pending.empty())
+    {
+        m_sendEvent =
+            Simulator::Schedule(m_pending.top().first - now, &SiteTrafficAggregator::SendDue, this);
+    }
+}
+
+void
+SiteTrafficAggregator::SendPacket(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    Flow& flow = m_flows[index];
+    uint32_t size = static_cast<uint32_t>(flow.packetSize->GetValue());
+    if (size == 0)
+    {
+        size = 1;
+    }
+    Ptr<Packet> packet = Create<Packet>(size);
+    int actual = m_socket->SendTo(packet, 0, flow.peer);
+    if (actual == static_cast<int>(size))
+    {
+        flow.sentPackets++;
+        flow.sentBytes += size;
+        NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " flow " << index << " sent "
+                               << size << " bytes to " << flow.peer);
+        m_txTrace(packet);
+        m_txTraceWithAddresses(packet, m_sockName, flow.peer);
+        m_txFlowTrace(packet, index);
+    }
+    else
+    {
+        NS_LOG_DEBUG("Unable to send packet of flow " << index << "; actual " << actual
+                                                      << " size " << size);
+        m_failedPackets++;
+    }
+}
+
+} // namespace ns3
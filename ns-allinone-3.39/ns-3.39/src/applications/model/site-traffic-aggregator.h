@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SITE_TRAFFIC_AGGREGATOR_H
+#define SITE_TRAFFIC_AGGREGATOR_H
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class RandomVariableStream;
+class Socket;
+class Packet;
+
+/**
+ * \ingroup applications
+ *
+ * \brief Generate the traffic of all the cells of a site from one application.
+ *
+ * Each cell (or plane of a cell) is a flow with its own destination, packet
+ * size and inter-arrival time random variables.  Instead of one application,
+ * socket and event chain per flow, the flows are merged: the time of the
+ * next packet of every flow is kept in a min-heap and a single event is
+ * scheduled, for the earliest one.  All the packets are sent through one
+ * unconnected socket to the address (and port) of their flow, so the
+ * receivers see the same ports as with one application per flow.
+ *
+ * Every flow behaves as a Poissonapp: its first packet is sent when the
+ * application starts, the next ones after the drawn inter-arrival times,
+ * until the flow has sent its maximum number of bytes (if not zero).
+ * Packets due at the same time are sent in the order of their flows.
+ */
+class SiteTrafficAggregator : public Application
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SiteTrafficAggregator();
+    ~SiteTrafficAggregator() override;
+
+    /**
+     * \brief Add a flow.
+     * \param peer the destination of the packets
+     * \param packetSize the packet sizes in bytes (at least one byte is sent)
+     * \param interArrival the inter-arrival times in seconds
+     * \param maxBytes the bytes to send, or zero without limit
+     * \return the index of the flow
+     */
+    uint32_t AddFlow(const Address& peer,
+                     Ptr<RandomVariableStream> packetSize,
+                     Ptr<RandomVariableStream> interArrival,
+                     uint64_t maxBytes = 0);
+
+    /**
+     * \brief Add a flow with the distributions of a Poissonapp.
+     *
+     * With \p packetGen "mm1" the packet sizes are exponential (bounded to
+     * 60000 bytes), otherwise constant.  With "cte" the inter-arrival times
+     * are constant, otherwise exponential.
+     *
+     * \param peer the destination of the packets
+     * \param packetSize the (mean) packet size in bytes
+     * \param interval the (mean) inter-arrival time in seconds
+     * \param packetGen the generation model, as the PacketGen attribute of Poissonapp
+     * \param maxBytes the bytes to send, or zero without limit
+     * \return the index of the flow
+     */
+    uint32_t AddPoissonFlow(const Address& peer,
+                            uint32_t packetSize,
+                            double interval,
+                            const std::string& packetGen = "mm1",
+                            uint64_t maxBytes = 0);
+
+    /// \return the number of flows
+    uint32_t GetNFlows() const;
+
+    /**
+     * \param flow the index of the flow
+     * \return the destination of the flow
+     */
+    Address GetPeer(uint32_t flow) const;
+
+    /**
+     * \param flow the index of the flow
+     * \return the number of packets sent by the flow
+     */
+    uint64_t GetSentPackets(uint32_t flow) const;
+
+    /**
+     * \param flow the index of the flow
+     * \return the number of bytes sent by the flow
+     */
+    uint64_t GetSentBytes(uint32_t flow) const;
+
+    /// \return the number of packets refused by the socket
+    uint64_t GetFailedPackets() const;
+
+    /**
+     * \brief Assign a fixed random variable stream number to the random variables
+     * used by this model.
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
+    /**
+     * TracedCallback signature for the packets of a flow.
+     *
+     * \param [in] packet the packet sent
+     * \param [in] flow the index of the flow
+     */
+    typedef void (*TxFlowTracedCallback)(Ptr<const Packet> packet, uint32_t flow);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /// Send the packets due now and schedule the next ones
+    void SendDue();
+
+    /**
+     * \brief Send a packet of a flow.
+     * \param flow the index of the flow
+     */
+    void SendPacket(uint32_t flow);
+
+    /// A merged flow
+    struct Flow
+    {
+        Address peer;                          //!< Destination
+        Ptr<RandomVariableStream> packetSize;  //!< Packet sizes (bytes)
+        Ptr<RandomVariableStream> interArrival; //!< Inter-arrival times (s)
+        uint64_t maxBytes;                     //!< Bytes to send (0 without limit)
+        uint64_t sentPackets;                  //!< Packets sent
+        uint64_t sentBytes;                    //!< Bytes sent
+    };
+
+    /// Flow waiting for its next packet, ordered by the time of the packet
+    typedef std::pair<Time, uint32_t> Pending;
+
+    TypeId m_tid;                          //!< Socket factory type
+    Address m_local;                       //!< Local address to bind to
+    std::vector<Flow> m_flows;             //!< The flows
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>>
+        m_pending;                         //!< Flows by time of their next packet
+    Ptr<Socket> m_socket;                  //!< Socket shared by the flows
+    Address m_sockName;                    //!< Local address of the socket
+    EventId m_sendEvent;                   //!< Next packets
+    uint64_t m_failedPackets;              //!< Packets refused by the socket
+
+    /// Traced Callback: transmitted packets.
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+    /// Traced Callback: transmitted packets, with the local and remote addresses.
+    TracedCallback<Ptr<const Packet>, const Address&, const Address&> m_txTraceWithAddresses;
+    /// Traced Callback: transmitted packets, with their flow.
+    TracedCallback<Ptr<const Packet>, uint32_t> m_txFlowTrace;
+};
+
+} // namespace ns3
+
+#endif /* SITE_TRAFFIC_AGGREGATOR_H */
@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "traffic-profile.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TrafficProfile");
+
+namespace
+{
+
+/// Magic number of the profile files
+const char PROFILE_MAGIC[8] = {'n', 's', '3', 't', 'p', 'r', 'o', 'f'};
+/// Version of the profile files
+const uint32_t PROFILE_VERSION = 1;
+
+/**
+ * Write a 32 bit unsigned integer in little-endian byte order.
+ * \param os the stream
+ * \param value the value
+ */
+void
+WriteU32(std::ostream& os, uint32_t value)
+{
+    char bytes[4];
+    for (int i = 0; i < 4; i++)
+    {
+        bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+    os.write(bytes, 4);
+}
+
+/**
+ * Write a double in little-endian byte order.
+ * \param os the stream
+ * \param value the value
+ */
+void
+WriteF64(std::ostream& os, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    WriteU32(os, static_cast<uint32_t>(bits));
+    WriteU32(os, static_cast<uint32_t>(bits >> 32));
+}
+
+/**
+ * Read a 32 bit unsigned integer in little-endian byte order.
+ * \param is the stream
+ * \param filename the file name, for the error messages
+ * \return the value
+ */
+uint32_t
+ReadU32(std::istream& is, const std::string& filename)
+{
+    unsigned char bytes[4];
+    is.read(reinterpret_cast<char*>(bytes), 4);
+    NS_ABORT_MSG_IF(!is, "Truncated traffic profile " << filename);
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+/**
+ * Read a double in little-endian byte order.
+ * \param is the stream
+ * \param filename the file name, for the error messages
+ * \return the value
+ */
+double
+ReadF64(std::istream& is, const std::string& filename)
+{
+    uint64_t bits = ReadU32(is, filename);
+    bits |= static_cast<uint64_t>(ReadU32(is, filename)) << 32;
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Quantiles of a sample, interpolated linearly between order statistics.
+ * \param values the sample
+ * \param n the number of quantiles, at probabilities i / (n - 1)
+ * \return the quantiles
+ */
+std::vector<double>
+Quantiles(std::vector<double> values, uint32_t n)
+{
+    std::sort(values.begin(), values.end());
+    std::vector<double> quantiles(n);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double position = static_cast<double>(i) * (values.size() - 1) / (n - 1);
+        std::size_t k = static_cast<std::size_t>(position);
+        if (k + 1 >= values.size())
+        {
+            quantiles[i] = values.back();
+        }
+        else
+        {
+            quantiles[i] = values[k] + (position - k) * (values[k + 1] - values[k]);
+        }
+    }
+    return quantiles;
+}
+
+} // namespace
+
+uint32_t
+TrafficProfile::AliasTable::Sample(double u) const
+{
+    double x = u * alias.size();
+    uint32_t i = std::min(static_cast<uint32_t>(x), static_cast<uint32_t>(alias.size() - 1));
+    return (x - i < threshold[i]) ? i : alias[i];
+}
+
+TrafficProfile::TrafficProfile()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TrafficProfile::BuildAliasTable(const std::vector<double>& weights,
+                                std::vector<uint32_t>& alias,
+                                std::vector<double>& threshold)
+{
+    NS_LOG_FUNCTION(weights.size());
+    uint32_t n = weights.size();
+    double total = 0;
+    for (double w : weights)
+    {
+        NS_ABORT_MSG_IF(w < 0, "Negative weight " << w);
+        total += w;
+    }
+    NS_ABORT_MSG_IF(n == 0 || total <= 0, "No weight in the alias table");
+
+    alias.assign(n, 0);
+    threshold.assign(n, 1);
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        alias[i] = i;
+        scaled[i] = weights[i] * n / total;
+        (scaled[i] < 1 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty())
+    {
+        uint32_t s = small.back();
+        small.pop_back();
+        uint32_t l = large.back();
+        threshold[s] = scaled[s];
+        alias[s] = l;
+        scaled[l] -= 1 - scaled[s];
+        if (scaled[l] < 1)
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // the remaining entries are kept with probability one (up to rounding)
+}
+
+uint32_t
+TrafficProfile::AddState(const std::vector<uint32_t>& sizes,
+                         const std::vector<double>& weights,
+                         const std::vector<double>& gaps)
+{
+    NS_LOG_FUNCTION(this << sizes.size() << gaps.size());
+    NS_ABORT_MSG_IF(sizes.empty() || sizes.size() != weights.size(),
+                    "The sizes and their weights do not match");
+    NS_ABORT_MSG_IF(gaps.empty(), "No gap quantile");
+    NS_ABORT_MSG_IF(!std::is_sorted(gaps.begin(), gaps.end()) || gaps.front() < 0,
+                    "The gap quantiles must be non-negative and in increasing order");
+
+    State state;
+    state.sizes = sizes;
+    BuildAliasTable(weights, state.sizeTable.alias, state.sizeTable.threshold);
+    state.gaps = gaps;
+    m_states.push_back(state);
+    return m_states.size() - 1;
+}
+
+void
+TrafficProfile::SetTransitions(const std::vector<std::vector<double>>& matrix)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(matrix.size() != m_states.size(), "One row per state expected");
+    for (uint32_t i = 0; i < m_states.size(); i++)
+    {
+        NS_ABORT_MSG_IF(matrix[i].size() != m_states.size(), "One column per state expected");
+        BuildAliasTable(matrix[i], m_states[i].nextTable.alias, m_states[i].nextTable.threshold);
+    }
+}
+
+uint32_t
+TrafficProfile::GetNStates() const
+{
+    return m_states.size();
+}
+
+uint32_t
+TrafficProfile::GetPacketSize(uint32_t state, double u) const
+{
+    const State& s = m_states[state];
+    return s.sizes[s.sizeTable.Sample(u)];
+}
+
+double
+TrafficProfile::GetGap(uint32_t state, double u) const
+{
+    const std::vector<double>& gaps = m_states[state].gaps;
+    double x = u * (gaps.size() - 1);
+    std::size_t i = static_cast<std::size_t>(x);
+    if (i + 1 >= gaps.size())
+    {
+        return gaps.back();
+    }
+    return gaps[i] + (x - i) * (gaps[i + 1] - gaps[i]);
+}
+
+uint32_t
+TrafficProfile::GetNextState(uint32_t state, double u) const
+{
+    const AliasTable& table = m_states[state].nextTable;
+    if (table.alias.empty())
+    {
+        return state;
+    }
+    return table.Sample(u);
+}
+
+void
+TrafficProfile::Save(const std::string& filename) const
+{
+    NS_LOG_FUNCTION(this << filename);
+    std::ofstream os(filename, std::ios::binary);
+    NS_ABORT_MSG_IF(!os, "Cannot open " << filename);
+
+    os.write(PROFILE_MAGIC, sizeof(PROFILE_MAGIC));
+    WriteU32(os, PROFILE_VERSION);
+    WriteU32(os, m_states.size());
+    for (const auto& state : m_states)
+    {
+        WriteU32(os, state.sizes.size());
+        for (uint32_t i = 0; i < state.sizes.size(); i++)
+        {
+            WriteU32(os, state.sizes[i]);
+            WriteU32(os, state.sizeTable.alias[i]);
+            WriteF64(os, state.sizeTable.threshold[i]);
+        }
+        WriteU32(os, state.gaps.size());
+        for (double gap : state.gaps)
+        {
+            WriteF64(os, gap);
+        }
+    }
+    if (m_states.size() > 1)
+    {
+        for (uint32_t i = 0; i < m_states.size(); i++)
+        {
+            const AliasTable& table = m_states[i].nextTable;
+            for (uint32_t j = 0; j < m_states.size(); j++)
+            {
+                // a state without transitions always goes to itself
+                if (table.alias.empty())
+                {
+                    WriteU32(os, i);
+                    WriteF64(os, 0);
+                }
+                else
+                {
+                    WriteU32(os, table.alias[j]);
+                    WriteF64(os, table.threshold[j]);
+                }
+            }
+        }
+    }
+    NS_ABORT_MSG_IF(!os, "Cannot write " << filename);
+}
+
+Ptr<const TrafficProfile>
+TrafficProfile::Load(const std::string& filename)
+{
+    NS_LOG_FUNCTION(filename);
+    static thread_local std::map<std::string, Ptr<const TrafficProfile>> loaded;
+    auto it = loaded.find(filename);
+    if (it != loaded.end())
+    {
+        return it->second;
+    }
+
+    std::ifstream is(filename, std::ios::binary);
+    NS_ABORT_MSG_IF(!is, "Cannot open traffic profile " << filename);
+    char magic[sizeof(PROFILE_MAGIC)];
+    is.read(magic, sizeof(magic));
+    NS_ABORT_MSG_IF(!is || std::memcmp(magic, PROFILE_MAGIC, sizeof(magic)) != 0,
+                    filename << " is not a traffic profile");
+    uint32_t version = ReadU32(is, filename);
+    NS_ABORT_MSG_IF(version != PROFILE_VERSION,
+                    "Unsupported version " << version << " of traffic profile " << filename);
+
+    Ptr<TrafficProfile> profile = Create<TrafficProfile>();
+    uint32_t nStates = ReadU32(is, filename);
+    NS_ABORT_MSG_IF(nStates == 0, "No state in traffic profile " << filename);
+    profile->m_states.resize(nStates);
+    for (auto& state : profile->m_states)
+    {
+        uint32_t nSizes = ReadU32(is, filename);
+        NS_ABORT_MSG_IF(nSizes == 0, "No packet size in traffic profile " << filename);
+        state.sizes.resize(nSizes);
+        state.sizeTable.alias.resize(nSizes);
+        state.sizeTable.threshold.resize(nSizes);
+        for (uint32_t i = 0; i < nSizes; i++)
+        {
+            state.sizes[i] = ReadU32(is, filename);
+            state.sizeTable.alias[i] = ReadU32(is, filename);
+            state.sizeTable.threshold[i] = ReadF64(is, filename);
+            NS_ABORT_MSG_IF(state.sizeTable.alias[i] >= nSizes,
+                            "Wrong alias in traffic profile " << filename);
+        }
+        uint32_t nGaps = ReadU32(is, filename);
+        NS_ABORT_MSG_IF(nGaps == 0, "No gap quantile in traffic profile " << filename);
+        state.gaps.resize(nGaps);
+        for (uint32_t i = 0; i < nGaps; i++)
+        {
+            state.gaps[i] = ReadF64(is, filename);
+        }
+    }
+    if (nStates > 1)
+    {
+        for (auto& state : profile->m_states)
+        {
+            state.nextTable.alias.resize(nStates);
+            state.nextTable.threshold.resize(nStates);
+            for (uint32_t j = 0; j < nStates; j++)
+            {
+                state.nextTable.alias[j] = ReadU32(is, filename);
+                state.nextTable.threshold[j] = ReadF64(is, filename);
+                NS_ABORT_MSG_IF(state.nextTable.alias[j] >= nStates,
+                                "Wrong state in traffic profile " << filename);
+            }
+        }
+    }
+    NS_LOG_INFO("Loaded " << nStates << " states from " << filename);
+    loaded[filename] = profile;
+    return profile;
+}
+
+Ptr<TrafficProfile>
+TrafficProfile::Fit(const std::vector<uint32_t>& sizes,
+                    const std::vector<double>& gaps,
+                    double burstGap,
+                    uint32_t quantiles)
+{
+    NS_LOG_FUNCTION(sizes.size() << burstGap << quantiles);
+    NS_ABORT_MSG_IF(sizes.empty() || sizes.size() != gaps.size(),
+                    "One gap per packet expected");
+    NS_ABORT_MSG_IF(quantiles < 2, "At least two gap quantiles expected");
+
+    std::vector<uint32_t> stateOf(sizes.size(), 0);
+    uint32_t nStates = 1;
+    if (burstGap > 0)
+    {
+        for (std::size_t i = 0; i < gaps.size(); i++)
+        {
+            stateOf[i] = (gaps[i] > burstGap) ? 1 : 0;
+        }
+        // both states are needed for a burst model
+        std::size_t ends = std::count(stateOf.begin(), stateOf.end(), 1);
+        if (ends > 0 && ends < stateOf.size())
+        {
+            nStates = 2;
+        }
+        else
+        {
+            stateOf.assign(sizes.size(), 0);
+        }
+    }
+
+    Ptr<TrafficProfile> profile = Create<TrafficProfile>();
+    for (uint32_t s = 0; s < nStates; s++)
+    {
+        std::map<uint32_t, double> histogram;
+        std::vector<double> stateGaps;
+        for (std::size_t i = 0; i < sizes.size(); i++)
+        {
+            if (stateOf[i] == s)
+            {
+                histogram[sizes[i]]++;
+                stateGaps.push_back(gaps[i]);
+            }
+        }
+        std::vector<uint32_t> values;
+        std::vector<double> weights;
+        for (const auto& [size, count] : histogram)
+        {
+            values.push_back(size);
+            weights.push_back(count);
+        }
+        profile->AddState(values, weights, Quantiles(stateGaps, quantiles));
+    }
+
+    if (nStates > 1)
+    {
+        std::vector<std::vector<double>> matrix(nStates, std::vector<double>(nStates, 0));
+        for (std::size_t i = 0; i + 1 < sizes.size(); i++)
+        {
+            matrix[stateOf[i]][stateOf[i + 1]]++;
+        }
+        for (uint32_t s = 0; s < nStates; s++)
+        {
+            // the state of the last packet may have no transition
+            if (std::count(matrix[s].begin(), matrix[s].end(), 0.0) == nStates)
+            {
+                matrix[s][s] = 1;
+            }
+        }
+        profile->SetTransitions(matrix);
+    }
+    return profile;
+}
+
+} // namespace ns3
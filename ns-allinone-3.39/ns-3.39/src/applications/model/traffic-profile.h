@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TRAFFIC_PROFILE_H
+#define TRAFFIC_PROFILE_H
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applications
+ *
+ * \brief Packet size and inter-arrival distributions fitted from captures.
+ *
+ * A profile is made of one or more states.  Each state has a discrete
+ * distribution of packet sizes, stored as an alias table (Walker/Vose), and
+ * a distribution of the gaps between packets, stored as its quantiles at
+ * equally spaced probabilities (a piecewise-linear CDF).  With several
+ * states, the state changes after every packet according to a Markov chain
+ * whose rows are alias tables too, which models bursts (e.g. a state for
+ * the gaps within a burst and a state for the gaps between bursts).
+ *
+ * Every sample takes a single uniform and constant time, whatever the
+ * number of sizes or quantiles, instead of the binary search of
+ * EmpiricalRandomVariable.
+ *
+ * Profiles are written in a compact binary format (all the fields in
+ * little-endian byte order):
+ *
+ * \verbatim
+   char[8]  magic "ns3tprof"
+   uint32   version (1)
+   uint32   number of states S
+   S times:
+     uint32   number of sizes N
+     N times: uint32 size, uint32 alias, float64 threshold
+     uint32   number of gap quantiles M
+     M times: float64 gap (seconds) at probability i / (M - 1)
+   if S > 1, S times (row of the transition matrix):
+     S times: uint32 alias, float64 threshold
+   \endverbatim
+ *
+ * The threshold of entry i of an alias table is the probability of keeping
+ * i when the uniform falls in its 1/N-wide bucket; otherwise the alias is
+ * taken.  Profiles can be created with Fit() (see the
+ * traffic-profile-from-pcap program) or with the traffic_profile.py module
+ * of the capture analysis notebooks.
+ */
+class TrafficProfile : public SimpleRefCount<TrafficProfile>
+{
+  public:
+    TrafficProfile();
+
+    /**
+     * \brief Add a state.
+     * \param sizes the packet sizes
+     * \param weights the (not necessarily normalized) weights of the sizes
+     * \param gaps the gaps in seconds at probabilities i / (gaps.size () - 1),
+     *        in increasing order
+     * \return the index of the state
+     */
+    uint32_t AddState(const std::vector<uint32_t>& sizes,
+                      const std::vector<double>& weights,
+                      const std::vector<double>& gaps);
+
+    /**
+     * \brief Set the transition matrix of the states.
+     *
+     * Without transitions a profile stays in its first state.
+     *
+     * \param matrix the (not necessarily normalized) weights of the
+     *        transitions, matrix[i][j] from state i to state j
+     */
+    void SetTransitions(const std::vector<std::vector<double>>& matrix);
+
+    /// \return the number of states
+    uint32_t GetNStates() const;
+
+    /**
+     * \brief Draw a packet size.
+     * \param state the state
+     * \param u a uniform in [0, 1)
+     * \return the packet size
+     */
+    uint32_t GetPacketSize(uint32_t state, double u) const;
+
+    /**
+     * \brief Draw the gap to the next packet.
+     * \param state the state
+     * \param u a uniform in [0, 1)
+     * \return the gap in seconds
+     */
+    double GetGap(uint32_t state, double u) const;
+
+    /**
+     * \brief Draw the state of the next packet.
+     * \param state the current state
+     * \param u a uniform in [0, 1)
+     * \return the next state
+     */
+    uint32_t GetNextState(uint32_t state, double u) const;
+
+    /**
+     * \brief Write the profile.
+     * \param filename the file name
+     */
+    void Save(const std::string& filename) const;
+
+    /**
+     * \brief Read a profile.
+     *
+     * The profiles are read once: later calls with the same file name
+     * return the same profile.
+     *
+     * \param filename the file name
+     * \return the profile
+     */
+    static Ptr<const TrafficProfile> Load(const std::string& filename);
+
+    /**
+     * \brief Fit a profile to a sequence of packets.
+     *
+     * With a positive \p burstGap the profile has two states: the packets
+     * followed by a gap not longer than \p burstGap (state 0, within a
+     * burst) and the others (state 1, end of a burst).  The transitions are
+     * counted between consecutive packets.
+     *
+     * \param sizes the sizes of the packets
+     * \param gaps the gap in seconds after each packet
+     * \param burstGap the longest gap within a burst, or zero for a single state
+     * \param quantiles the number of gap quantiles per state (at least 2)
+     * \return the profile
+     */
+    static Ptr<TrafficProfile> Fit(const std::vector<uint32_t>& sizes,
+                                   const std::vector<double>& gaps,
+                                   double burstGap,
+                                   uint32_t quantiles = 1001);
+
+    /**
+     * \brief Build an alias table with the method of Vose.
+     * \param weights the (not necessarily normalized) weights
+     * \param alias the aliases
+     * \param threshold the probabilities of not taking the alias
+     */
+    static void BuildAliasTable(const std::vector<double>& weights,
+                                std::vector<uint32_t>& alias,
+                                std::vector<double>& threshold);
+
+  private:
+    /// Alias table of a discrete distribution
+    struct AliasTable
+    {
+        std::vector<uint32_t> alias;    //!< Alias of each entry
+        std::vector<double> threshold;  //!< Probability of keeping each entry
+
+        /**
+         * \brief Draw an entry.
+         * \param u a uniform in [0, 1)
+         * \return the entry
+         */
+        uint32_t Sample(double u) const;
+    };
+
+    /// State of the profile
+    struct State
+    {
+        std::vector<uint32_t> sizes; //!< Packet sizes
+        AliasTable sizeTable;        //!< Distribution of the packet sizes
+        std::vector<double> gaps;    //!< Quantiles of the gaps
+        AliasTable nextTable;        //!< Distribution of the next state
+    };
+
+    std::vector<State> m_states; //!< The states
+};
+
+} // namespace ns3
+
+#endif /* TRAFFIC_PROFILE_H */
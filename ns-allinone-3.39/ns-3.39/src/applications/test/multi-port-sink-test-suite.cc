@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/boolean.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/multi-port-sink-helper.h"
+#include "ns3/multi-port-sink.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/test.h"
+#include "ns3/udp-client-server-helper.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <map>
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Check the per-port counters, delays and trace of a MultiPortSink.
+ */
+class MultiPortSinkTestCase : public TestCase
+{
+  public:
+    MultiPortSinkTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record a received packet.
+     * \param packet the packet
+     * \param from the source address
+     * \param port the local port
+     */
+    void Received(Ptr<const Packet> packet, const Address& from, uint16_t port);
+
+    std::map<uint16_t, uint64_t> m_traced; //!< Packets traced per port
+};
+
+MultiPortSinkTestCase::MultiPortSinkTestCase()
+    : TestCase("MultiPortSink counters per port")
+{
+}
+
+void
+MultiPortSinkTestCase::Received(Ptr<const Packet> packet, const Address& from, uint16_t port)
+{
+    m_traced[port]++;
+}
+
+void
+MultiPortSinkTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetChannelAttribute("Delay", TimeValue(MicroSeconds(50)));
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    // one sink for ports 8080-8083
+    MultiPortSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                   InetSocketAddress(Ipv4Address::GetAny(), 8080),
+                                   4);
+    sinkHelper.SetAttribute("EnableSeqTsHeader", BooleanValue(true));
+    ApplicationContainer sinkApps = sinkHelper.Install(nodes.Get(1));
+    sinkApps.Start(Seconds(0));
+    sinkApps.Get(0)->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&MultiPortSinkTestCase::Received, this));
+
+    // port 8080 + i receives 10 * (i + 1) packets of 100 * (i + 1) bytes,
+    // port 8082 only a packet shorter than the SeqTsHeader
+    ApplicationContainer clients;
+    for (uint16_t i = 0; i < 4; i++)
+    {
+        if (i == 2)
+        {
+            continue;
+        }
+        UdpClientHelper clientHelper(interfaces.GetAddress(1), 8080 + i);
+        clientHelper.SetAttribute("MaxPackets", UintegerValue(10 * (i + 1)));
+        clientHelper.SetAttribute("PacketSize", UintegerValue(100 * (i + 1)));
+        clientHelper.SetAttribute("Interval", TimeValue(MilliSeconds(1)));
+        clients.Add(clientHelper.Install(nodes.Get(0)));
+    }
+    clients.Start(Seconds(1));
+    Ptr<Socket> shortSource = Socket::CreateSocket(nodes.Get(0), UdpSocketFactory::GetTypeId());
+    shortSource->Connect(InetSocketAddress(interfaces.GetAddress(1), 8082));
+    Simulator::Schedule(Seconds(1), [shortSource]() { shortSource->Send(Create<Packet>(4)); });
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    Ptr<MultiPortSink> sink = DynamicCast<MultiPortSink>(sinkApps.Get(0));
+    NS_TEST_EXPECT_MSG_EQ(sink->GetFirstPort(), 8080, "Wrong first port");
+    NS_TEST_EXPECT_MSG_EQ(sink->GetNPorts(), 4, "Wrong number of ports");
+    NS_TEST_EXPECT_MSG_EQ(m_traced.size(), 4, "Packets traced on unexpected ports");
+    uint64_t total = 0;
+    for (uint16_t i = 0; i < 4; i++)
+    {
+        uint16_t port = 8080 + i;
+        uint64_t packets = (i == 2) ? 1 : 10 * (i + 1);
+        uint64_t bytes = (i == 2) ? 4 : packets * 100 * (i + 1);
+        NS_TEST_EXPECT_MSG_EQ(sink->GetRxPackets(port), packets, "Wrong packets on " << port);
+        NS_TEST_EXPECT_MSG_EQ(sink->GetRxBytes(port), bytes, "Wrong bytes on " << port);
+        NS_TEST_EXPECT_MSG_EQ(m_traced[port], packets, "Wrong traced packets on " << port);
+        total += sink->GetRxBytes(port);
+        if (i != 2)
+        {
+            // instantaneous devices: the delay is the one of the channel
+            NS_TEST_EXPECT_MSG_EQ(sink->GetMinDelay(port), MicroSeconds(50), "Wrong delay");
+            NS_TEST_EXPECT_MSG_EQ(sink->GetMaxDelay(port), MicroSeconds(50), "Wrong delay");
+            NS_TEST_EXPECT_MSG_EQ(sink->GetMeanDelay(port), MicroSeconds(50), "Wrong delay");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(sink->GetMeanDelay(8082), Time(0), "Delay of a short packet");
+    NS_TEST_EXPECT_MSG_EQ(sink->GetTotalRx(), total, "Wrong total bytes");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief MultiPortSink TestSuite
+ */
+class MultiPortSinkTestSuite : public TestSuite
+{
+  public:
+    MultiPortSinkTestSuite();
+};
+
+MultiPortSinkTestSuite::MultiPortSinkTestSuite()
+    : TestSuite("multi-port-sink", UNIT)
+{
+    AddTestCase(new MultiPortSinkTestCase, TestCase::QUICK);
+}
+
+static MultiPortSinkTestSuite g_multiPortSinkTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/ipv4-packet-info-tag.h"
+#include "ns3/ipv4.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/udp-socket-factory.h"
+
+#include <limits>
+#include <set>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Check that the global routes recomputed while a
+ * MultithreadedSimulatorImpl runs give the same receptions as with the
+ * default simulator.
+ *
+ * Three nodes, each in its own partition, are joined by three links.  The
+ * first node sends to the third one through the direct link, which the
+ * first node takes down at 1 s before the routes are recomputed, so the
+ * packets go through the second node afterwards.  These events have no
+ * node context: they run alone and reach the nodes of every partition
+ * through the NodeList.  The packets created by the partitions and by the
+ * main thread have distinct uids.
+ */
+class MultithreadedGlobalRoutingTestCase : public TestCase
+{
+  public:
+    MultithreadedGlobalRoutingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Receptions at the third node: (time, device)
+    typedef std::vector<std::pair<Time, uint32_t>> Receptions;
+
+    /**
+     * Run the nodes.
+     * \param multithreaded whether the nodes run in three partitions
+     * \param [out] receptions the receptions at the third node
+     * \param [out] uids the uids of a packet created in the main thread and
+     *              of a packet created by every node
+     */
+    void RunTriangle(bool multithreaded, Receptions& receptions, std::vector<uint64_t>& uids);
+
+    /**
+     * Send a packet and the next one after an interval.
+     * \param socket the sending socket
+     * \param count the packets left to send
+     */
+    static void Send(Ptr<Socket> socket, uint32_t count);
+
+    /**
+     * Record the uid of a new packet.
+     * \param uid the uid
+     */
+    static void CreatePacket(uint64_t* uid);
+
+    /**
+     * Record the received packets.
+     * \param receptions the receptions
+     * \param socket the receiving socket
+     */
+    static void Receive(Receptions* receptions, Ptr<Socket> socket);
+};
+
+MultithreadedGlobalRoutingTestCase::MultithreadedGlobalRoutingTestCase()
+    : TestCase("Global routes recomputed with partitions")
+{
+}
+
+void
+MultithreadedGlobalRoutingTestCase::Send(Ptr<Socket> socket, uint32_t count)
+{
+    socket->Send(Create<Packet>(100));
+    if (count > 1)
+    {
+        Simulator::Schedule(MilliSeconds(10), &Send, socket, count - 1);
+    }
+}
+
+void
+MultithreadedGlobalRoutingTestCase::CreatePacket(uint64_t* uid)
+{
+    *uid = Create<Packet>(10)->GetUid();
+}
+
+void
+MultithreadedGlobalRoutingTestCase::Receive(Receptions* receptions, Ptr<Socket> socket)
+{
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv(std::numeric_limits<uint32_t>::max(), 0)))
+    {
+        Ipv4PacketInfoTag tag;
+        packet->RemovePacketTag(tag);
+        receptions->emplace_back(Simulator::Now(), tag.GetRecvIf());
+    }
+}
+
+void
+MultithreadedGlobalRoutingTestCase::RunTriangle(bool multithreaded,
+                                                Receptions& receptions,
+                                                std::vector<uint64_t>& uids)
+{
+    Ptr<MultithreadedSimulatorImpl> impl;
+    if (multithreaded)
+    {
+        impl = CreateObject<MultithreadedSimulatorImpl>();
+        Simulator::SetImplementation(impl);
+    }
+
+    NodeContainer nodes;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        nodes.Create(1, multithreaded ? i : 0);
+    }
+    PointToPointHelper p2p;
+    p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    NetDeviceContainer direct = p2p.Install(nodes.Get(0), nodes.Get(2));
+    NetDeviceContainer first = p2p.Install(nodes.Get(0), nodes.Get(1));
+    NetDeviceContainer second = p2p.Install(nodes.Get(1), nodes.Get(2));
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer directInterfaces = ipv4.Assign(direct);
+    ipv4.SetBase("10.1.2.0", "255.255.255.0");
+    ipv4.Assign(first);
+    ipv4.SetBase("10.1.3.0", "255.255.255.0");
+    ipv4.Assign(second);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    Ptr<Socket> sink = Socket::CreateSocket(nodes.Get(2), UdpSocketFactory::GetTypeId());
+    sink->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9));
+    sink->SetRecvPktInfo(true);
+    sink->SetRecvCallback(MakeBoundCallback(&Receive, &receptions));
+    Ptr<Socket> source = Socket::CreateSocket(nodes.Get(0), UdpSocketFactory::GetTypeId());
+    source->Connect(InetSocketAddress(directInterfaces.GetAddress(1), 9));
+    Simulator::ScheduleWithContext(0, MilliSeconds(5), &Send, source, 200);
+
+    // without a node context, as usual in a script
+    Ptr<Ipv4> sourceIpv4 = nodes.Get(0)->GetObject<Ipv4>();
+    uint32_t directInterface = sourceIpv4->GetInterfaceForDevice(direct.Get(0));
+    Simulator::Schedule(Seconds(1), &Ipv4::SetDown, sourceIpv4, directInterface);
+    Simulator::Schedule(Seconds(1), &Ipv4GlobalRoutingHelper::RecomputeRoutingTables);
+
+    uids.assign(4, 0);
+    uids[0] = Create<Packet>(10)->GetUid();
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Simulator::ScheduleWithContext(i, MilliSeconds(500), &CreatePacket, &uids[i + 1]);
+    }
+
+    Simulator::Run();
+    if (impl)
+    {
+        NS_TEST_EXPECT_MSG_EQ(impl->GetNPartitions(), 3, "Wrong number of partitions");
+    }
+    Simulator::Destroy();
+}
+
+void
+MultithreadedGlobalRoutingTestCase::DoRun()
+{
+    Receptions receptionsRef;
+    std::vector<uint64_t> uidsRef;
+    RunTriangle(false, receptionsRef, uidsRef);
+    Receptions receptions;
+    std::vector<uint64_t> uids;
+    RunTriangle(true, receptions, uids);
+
+    // through the direct link (device 0), then through the second node
+    // (device 1)
+    NS_TEST_ASSERT_MSG_EQ(receptionsRef.size(), 200, "Packets lost");
+    NS_TEST_EXPECT_MSG_EQ(receptionsRef.front().second, 0, "Wrong device before 1 s");
+    NS_TEST_EXPECT_MSG_EQ(receptionsRef.back().second, 1, "Wrong device after 1 s");
+    NS_TEST_ASSERT_MSG_EQ(receptions.size(), receptionsRef.size(), "Different packets");
+    for (std::size_t k = 0; k < receptions.size(); k++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(receptions[k].first, receptionsRef[k].first, "Different time");
+        NS_TEST_EXPECT_MSG_EQ(receptions[k].second, receptionsRef[k].second, "Different route");
+    }
+
+    std::set<uint64_t> distinct;
+    for (uint64_t uid : uids)
+    {
+        // the lower 32 bits, as the upper ones are the partition
+        distinct.insert(uid & 0xffffffff);
+    }
+    NS_TEST_EXPECT_MSG_EQ(distinct.size(),
+                          uids.size(),
+                          "Packets of the partitions with the same uid");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief TestSuite for the global routing with the MultithreadedSimulatorImpl
+ */
+class MultithreadedGlobalRoutingTestSuite : public TestSuite
+{
+  public:
+    MultithreadedGlobalRoutingTestSuite();
+};
+
+MultithreadedGlobalRoutingTestSuite::MultithreadedGlobalRoutingTestSuite()
+    : TestSuite("multithreaded-global-routing", UNIT)
+{
+    AddTestCase(new MultithreadedGlobalRoutingTestCase, TestCase::QUICK);
+}
+
+static MultithreadedGlobalRoutingTestSuite
+    g_multithreadedGlobalRoutingTestSuite; //!< The test suite
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/boolean.h"
+#include "ns3/bridge-helper.h"
+#include "ns3/bridge-net-device.h"
+#include "ns3/data-rate.h"
+#include "ns3/ecpri-header.h"
+#include "ns3/node-container.h"
+#include "ns3/ofh-ecpri-application.h"
+#include "ns3/ofh-ecpri-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/packet-socket-address.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/queue-disc.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/uinteger.h"
+#include "ns3/vlan-header.h"
+
+using namespace ns3;
+
+/**
+ * Count a packet.
+ * \param count the counter
+ * \param packet the packet
+ */
+static void
+Count(uint64_t* count, Ptr<const Packet> packet)
+{
+    (*count)++;
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Topology of the L2 fronthaul tests: a DU and a second source
+ * connected to an RU through a bridge, over point-to-point links.
+ */
+struct OfhL2Topology
+{
+    /**
+     * Build the topology.
+     * \param ruRate the rate of the link between the bridge and the RU
+     */
+    OfhL2Topology(const std::string& ruRate)
+    {
+        nodes.Create(4);
+        PointToPointHelper p2p;
+        p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+        p2p.SetChannelAttribute("Delay", StringValue("2us"));
+        NetDeviceContainer duLink = p2p.Install(GetDu(), GetSwitch());
+        NetDeviceContainer bhLink = p2p.Install(GetSource(), GetSwitch());
+        p2p.SetDeviceAttribute("DataRate", StringValue(ruRate));
+        NetDeviceContainer ruLink = p2p.Install(GetSwitch(), GetRu());
+        duDevice = duLink.Get(0);
+        sourceDevice = bhLink.Get(0);
+        ruDevice = ruLink.Get(1);
+        ruPort = ruLink.Get(0);
+
+        NetDeviceContainer ports(duLink.Get(1), bhLink.Get(1));
+        ports.Add(ruPort);
+        BridgeHelper bridge;
+        bridge.Install(GetSwitch(), ports);
+
+        PacketSocketHelper packetSocket;
+        packetSocket.Install(nodes);
+    }
+
+    /// \return the DU
+    Ptr<Node> GetDu() const
+    {
+        return nodes.Get(0);
+    }
+
+    /// \return the bridge
+    Ptr<Node> GetSwitch() const
+    {
+        return nodes.Get(1);
+    }
+
+    /// \return the RU
+    Ptr<Node> GetRu() const
+    {
+        return nodes.Get(2);
+    }
+
+    /// \return the second source, on its own bridge port
+    Ptr<Node> GetSource() const
+    {
+        return nodes.Get(3);
+    }
+
+    /**
+     * \param from the sending device
+     * \param to the receiving device
+     * \return the address of the device \p to as seen from the device \p from
+     */
+    static PacketSocketAddress GetAddress(Ptr<NetDevice> from, Ptr<NetDevice> to)
+    {
+        PacketSocketAddress address;
+        address.SetSingleDevice(from->GetIfIndex());
+        address.SetPhysicalAddress(to->GetAddress());
+        address.SetProtocol(EcpriHeader::PROT_NUMBER);
+        return address;
+    }
+
+    /**
+     * Install a sink of eCPRI messages.
+     * \param device the receiving device
+     * \return the sink
+     */
+    Ptr<PacketSink> InstallSink(Ptr<NetDevice> device) const
+    {
+        PacketSocketAddress local;
+        local.SetSingleDevice(device->GetIfIndex());
+        local.SetProtocol(EcpriHeader::PROT_NUMBER);
+        PacketSinkHelper sinkHelper("ns3::PacketSocketFactory", local);
+        ApplicationContainer apps = sinkHelper.Install(device->GetNode());
+        apps.Start(Seconds(0));
+        return DynamicCast<PacketSink>(apps.Get(0));
+    }
+
+    NodeContainer nodes;          //!< DU, bridge, RU and second source
+    Ptr<NetDevice> duDevice;      //!< Device of the DU
+    Ptr<NetDevice> sourceDevice;  //!< Device of the second source
+    Ptr<NetDevice> ruDevice;      //!< Device of the RU
+    Ptr<NetDevice> ruPort;        //!< Bridge port towards the RU
+};
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Check that eCPRI messages cross a bridge in tagged Ethernet frames,
+ * and that the bridge floods only until it learns the destination.
+ */
+class OfhEcpriBridgeTestCase : public TestCase
+{
+  public:
+    OfhEcpriBridgeTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check a message received by the DU.
+     * \param packet the packet
+     * \param from the source address
+     */
+    void ReceivedByDu(Ptr<const Packet> packet, const Address& from);
+
+    uint64_t m_duReceived{0};     //!< Messages received by the DU
+    bool m_duTagsOk{true};        //!< The messages received by the DU were as sent
+};
+
+OfhEcpriBridgeTestCase::OfhEcpriBridgeTestCase()
+    : TestCase("eCPRI messages over a learning bridge")
+{
+}
+
+void
+OfhEcpriBridgeTestCase::ReceivedByDu(Ptr<const Packet> packet, const Address& from)
+{
+    m_duReceived++;
+    Ptr<Packet> copy = packet->Copy();
+    VlanTag tag;
+    EcpriHeader ecpri;
+    bool tagged = copy->PeekPacketTag(tag);
+    copy->RemoveHeader(ecpri);
+    m_duTagsOk = m_duTagsOk && tagged && tag.GetPcp() == 5 && tag.GetVid() == 10 &&
+                 ecpri.GetMessageType() == EcpriHeader::IQ_DATA && ecpri.GetPcId() == 3 &&
+                 ecpri.GetPayloadSize() == 300 + ecpri.GetSerializedSize() - 4 &&
+                 copy->GetSize() == 300;
+}
+
+void
+OfhEcpriBridgeTestCase::DoRun()
+{
+    OfhL2Topology topology("1Gbps");
+    Ptr<PacketSink> duSink = topology.InstallSink(topology.duDevice);
+    duSink->TraceConnectWithoutContext("Rx",
+                                       MakeCallback(&OfhEcpriBridgeTestCase::ReceivedByDu, this));
+    Ptr<PacketSink> ruSink = topology.InstallSink(topology.ruDevice);
+
+    // uplink from the RU before the DU is known to the bridge: flooded
+    OfhEcpriHelper uplink(OfhL2Topology::GetAddress(topology.ruDevice, topology.duDevice));
+    uplink.SetAttribute("U-PacketSize", UintegerValue(300));
+    uplink.SetAttribute("U-Interval", StringValue("ns3::ConstantRandomVariable[Constant=0.001]"));
+    uplink.SetAttribute("U-Pcp", UintegerValue(5));
+    uplink.SetAttribute("Vid", UintegerValue(10));
+    uplink.SetAttribute("PcId", UintegerValue(3));
+    ApplicationContainer ruApps = uplink.Install(topology.GetRu());
+    ruApps.Start(Seconds(0.9005));
+
+    // downlink with both planes in the same VLAN, as the bridge learns per
+    // VLAN; once the DU has spoken, the uplink is unicast
+    OfhEcpriHelper downlink(OfhL2Topology::GetAddress(topology.duDevice, topology.ruDevice));
+    downlink.SetAttribute("CUPlane", BooleanValue(true));
+    downlink.SetAttribute("Vid", UintegerValue(10));
+    ApplicationContainer duApps = downlink.Install(topology.GetDu());
+    duApps.Start(Seconds(1));
+
+    uint64_t floodedFrames = 0;
+    topology.sourceDevice->TraceConnectWithoutContext("MacRx",
+                                                      MakeBoundCallback(&Count, &floodedFrames));
+
+    Simulator::Stop(Seconds(1.1));
+    Simulator::Run();
+
+    Ptr<OfhEcpriApplication> du = DynamicCast<OfhEcpriApplication>(duApps.Get(0));
+    Ptr<OfhEcpriApplication> ru = DynamicCast<OfhEcpriApplication>(ruApps.Get(0));
+    NS_TEST_EXPECT_MSG_EQ(du->GetUserPackets(), 1000, "Wrong number of U-plane messages");
+    NS_TEST_EXPECT_MSG_EQ(du->GetControlPackets(), 100, "Wrong number of C-plane messages");
+    NS_TEST_EXPECT_MSG_EQ(ruSink->GetTotalRx(), du->GetTotalBytes(), "Downlink bytes lost");
+    NS_TEST_EXPECT_MSG_EQ(ru->GetUserPackets(), 200, "Wrong number of uplink messages");
+    NS_TEST_EXPECT_MSG_EQ(m_duReceived, ru->GetUserPackets(), "Uplink messages lost");
+    NS_TEST_EXPECT_MSG_EQ(duSink->GetTotalRx(), ru->GetTotalBytes(), "Uplink bytes lost");
+    NS_TEST_EXPECT_MSG_EQ(m_duTagsOk, true, "Wrong VLAN tag or eCPRI header");
+    NS_TEST_EXPECT_MSG_EQ(floodedFrames, 100, "Only the frames before learning are flooded");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Check that a PrioQueueDisc with a PcpPacketFilter on a bridge port
+ * protects the high priority fronthaul from a lower priority overload.
+ */
+class OfhEcpriPcpTestCase : public TestCase
+{
+  public:
+    OfhEcpriPcpTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Count a message received by the RU by its PCP.
+     * \param packet the packet
+     * \param from the source address
+     */
+    void ReceivedByRu(Ptr<const Packet> packet, const Address& from);
+
+    uint64_t m_highReceived{0}; //!< Messages received with PCP 7
+    uint64_t m_lowReceived{0};  //!< Messages received with PCP 0
+};
+
+OfhEcpriPcpTestCase::OfhEcpriPcpTestCase()
+    : TestCase("eCPRI messages through a PCP priority queue disc on a bridge port")
+{
+}
+
+void
+OfhEcpriPcpTestCase::ReceivedByRu(Ptr<const Packet> packet, const Address& from)
+{
+    VlanTag tag;
+    if (packet->PeekPacketTag(tag))
+    {
+        (tag.GetPcp() == 7 ? m_highReceived : m_lowReceived)++;
+    }
+}
+
+void
+OfhEcpriPcpTestCase::DoRun()
+{
+    // 40 Mb/s of fronthaul and 160 Mb/s of best effort towards a 100 Mb/s port
+    OfhL2Topology topology("100Mbps");
+    Ptr<Node> sw = topology.GetSwitch();
+    sw->AggregateObject(CreateObject<TrafficControlLayer>());
+    for (uint32_t i = 0; i < sw->GetNDevices(); i++)
+    {
+        Ptr<BridgeNetDevice> bridge = DynamicCast<BridgeNetDevice>(sw->GetDevice(i));
+        if (bridge)
+        {
+            bridge->SetAttribute("EnableTrafficControl", BooleanValue(true));
+        }
+    }
+    TrafficControlHelper tch;
+    uint16_t handle = tch.SetRootQueueDisc("ns3::PrioQueueDisc");
+    tch.AddPacketFilter(handle, "ns3::PcpPacketFilter", "NBands", UintegerValue(3));
+    TrafficControlHelper::ClassIdList cid = tch.AddQueueDiscClasses(handle, 3, "ns3::QueueDiscClass");
+    tch.AddChildQueueDiscs(handle, cid, "ns3::FifoQueueDisc", "MaxSize", StringValue("100p"));
+    QueueDiscContainer qdiscs = tch.Install(topology.ruPort);
+
+    Ptr<PacketSink> ruSink = topology.InstallSink(topology.ruDevice);
+    ruSink->TraceConnectWithoutContext("Rx",
+                                       MakeCallback(&OfhEcpriPcpTestCase::ReceivedByRu, this));
+
+    OfhEcpriHelper fronthaul(OfhL2Topology::GetAddress(topology.duDevice, topology.ruDevice));
+    fronthaul.SetAttribute("U-Interval",
+                           StringValue("ns3::ConstantRandomVariable[Constant=0.0002]"));
+    ApplicationContainer duApps = fronthaul.Install(topology.GetDu());
+
+    OfhEcpriHelper bestEffort(OfhL2Topology::GetAddress(topology.sourceDevice, topology.ruDevice));
+    bestEffort.SetAttribute("U-Interval",
+                            StringValue("ns3::ConstantRandomVariable[Constant=0.00005]"));
+    bestEffort.SetAttribute("U-Pcp", UintegerValue(0));
+    ApplicationContainer sourceApps = bestEffort.Install(topology.GetSource());
+
+    duApps.Start(Seconds(1));
+    sourceApps.Start(Seconds(1));
+    duApps.Stop(Seconds(1.1));
+    sourceApps.Stop(Seconds(1.1));
+    Simulator::Stop(Seconds(1.2));
+    Simulator::Run();
+
+    Ptr<OfhEcpriApplication> du = DynamicCast<OfhEcpriApplication>(duApps.Get(0));
+    Ptr<QueueDisc> prio = qdiscs.Get(0);
+    Ptr<QueueDisc> high = prio->GetQueueDiscClass(0)->GetQueueDisc();
+    Ptr<QueueDisc> low = prio->GetQueueDiscClass(2)->GetQueueDisc();
+    NS_TEST_EXPECT_MSG_EQ(du->GetUserPackets(), 500, "Wrong number of fronthaul messages");
+    NS_TEST_EXPECT_MSG_EQ(m_highReceived, du->GetUserPackets(), "Fronthaul messages lost");
+    NS_TEST_EXPECT_MSG_EQ(high->GetStats().nTotalDroppedPackets, 0, "Fronthaul dropped");
+    NS_TEST_EXPECT_MSG_GT(m_lowReceived, 0, "No best effort message received");
+    NS_TEST_EXPECT_MSG_GT(low->GetStats().nTotalDroppedPackets, 0, "Best effort not dropped");
+    NS_TEST_EXPECT_MSG_EQ(prio->GetQueueDiscClass(1)->GetQueueDisc()->GetStats().nTotalReceivedPackets,
+                          0,
+                          "No PCP maps to the middle band");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief eCPRI over Ethernet TestSuite
+ */
+class OfhEcpriL2TestSuite : public TestSuite
+{
+  public:
+    OfhEcpriL2TestSuite();
+};
+
+OfhEcpriL2TestSuite::OfhEcpriL2TestSuite()
+    : TestSuite("ofh-ecpri-l2", UNIT)
+{
+    AddTestCase(new OfhEcpriBridgeTestCase, TestCase::QUICK);
+    AddTestCase(new OfhEcpriPcpTestCase, TestCase::QUICK);
+}
+
+static OfhEcpriL2TestSuite g_ofhEcpriL2TestSuite; //!< Static variable for test initialization
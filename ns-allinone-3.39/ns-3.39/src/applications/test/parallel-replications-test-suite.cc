@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4.h"
+#include "ns3/mac48-address.h"
+#include "ns3/names.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/node-list.h"
+#include "ns3/packet.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/poisson-helper.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulation-context.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Check that replications of a network run in parallel threads give
+ * the same results as run one after the other.
+ *
+ * Every replication builds the nodes, devices and IPv4 stack, names the
+ * sink node and connects to its trace through Config, so the node list,
+ * names, configuration, address allocation and packet uids are checked to
+ * be per replication.
+ *
+ * With the UDP route cache, every replication also adds addresses to the
+ * sink node while it runs, so the route generation shared by the threads
+ * is invalidated concurrently; the results must not change.
+ */
+class ParallelReplicationsTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param routeCache whether the UDP sockets cache their routes
+     */
+    ParallelReplicationsTestCase(bool routeCache);
+
+  private:
+    void DoRun() override;
+
+    /// Result of a replication
+    struct Result
+    {
+        uint32_t nodes{0};     //!< Nodes in the node list
+        Mac48Address address;  //!< Address of the first device
+        uint64_t packets{0};   //!< Packets received
+        uint64_t bytes{0};     //!< Bytes received
+        uint64_t firstUid{0};  //!< Uid of the first packet received
+        Time last;             //!< Time of the last packet received
+        std::string context;   //!< Context of the trace
+    };
+
+    /**
+     * Record a received packet.
+     * \param result the result of the replication
+     * \param context the context of the trace
+     * \param packet the packet
+     * \param from the source address
+     */
+    static void Received(Result* result,
+                         std::string context,
+                         Ptr<const Packet> packet,
+                         const Address& from);
+
+    /**
+     * Run a replication.
+     * \param replication the index of the replication
+     * \param routeCache whether the routes change while the replication runs
+     * \param result the result of the replication
+     */
+    static void RunReplication(uint32_t replication, bool routeCache, Result& result);
+
+    /**
+     * Run the replications.
+     * \param threads the number of threads
+     * \param routeCache whether the UDP sockets cache their routes
+     * \return the results of the replications
+     */
+    static std::vector<Result> RunAll(uint32_t threads, bool routeCache);
+
+    bool m_routeCache; //!< Whether the UDP sockets cache their routes
+};
+
+ParallelReplicationsTestCase::ParallelReplicationsTestCase(bool routeCache)
+    : TestCase(routeCache ? "Parallel replications of a network with the UDP route cache"
+                          : "Parallel replications of a network against sequential ones"),
+      m_routeCache(routeCache)
+{
+}
+
+void
+ParallelReplicationsTestCase::Received(Result* result,
+                                       std::string context,
+                                       Ptr<const Packet> packet,
+                                       const Address& from)
+{
+    if (result->packets == 0)
+    {
+        result->firstUid = packet->GetUid();
+    }
+    result->packets++;
+    result->bytes += packet->GetSize();
+    result->last = Simulator::Now();
+    result->context = context;
+}
+
+void
+ParallelReplicationsTestCase::RunReplication(uint32_t replication,
+                                             bool routeCache,
+                                             Result& result)
+{
+    RngSeedManager::SetRun(replication + 1);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    Names::Add("sink", nodes.Get(1));
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    InetSocketAddress address(interfaces.GetAddress(1), 9);
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory", address);
+    ApplicationContainer sinkApps = sinkHelper.Install("sink");
+    PoissonHelper poissonHelper("ns3::UdpSocketFactory", address);
+    poissonHelper.SetAttribute("PacketSize", UintegerValue(500));
+    poissonHelper.SetAttribute("Interval", DoubleValue(1e-4));
+    ApplicationContainer sources = poissonHelper.Install(nodes.Get(0));
+    sinkApps.Start(Seconds(0));
+    sources.Start(Seconds(0));
+    Config::Connect("/Names/sink/ApplicationList/*/$ns3::PacketSink/Rx",
+                    MakeBoundCallback(&ParallelReplicationsTestCase::Received, &result));
+    if (routeCache)
+    {
+        // every new address invalidates the routes cached by the sockets
+        Ptr<Ipv4> sinkIpv4 = nodes.Get(1)->GetObject<Ipv4>();
+        for (uint32_t i = 1; i < 100; i++)
+        {
+            Simulator::Schedule(MilliSeconds(i), [sinkIpv4, i]() {
+                sinkIpv4->AddAddress(1,
+                                     Ipv4InterfaceAddress(Ipv4Address(0x0a020000 + i),
+                                                          Ipv4Mask("255.255.0.0")));
+            });
+        }
+    }
+
+    Simulator::Stop(Seconds(0.1));
+    Simulator::Run();
+
+    result.nodes = NodeList::GetNNodes();
+    result.address = Mac48Address::ConvertFrom(devices.Get(0)->GetAddress());
+}
+
+std::vector<ParallelReplicationsTestCase::Result>
+ParallelReplicationsTestCase::RunAll(uint32_t threads, bool routeCache)
+{
+    std::vector<Result> results(4);
+    Config::SetDefault("ns3::UdpSocketImpl::RouteCache", BooleanValue(routeCache));
+    SimulationContext::Run(
+        results.size(),
+        [&results, routeCache](uint32_t replication) {
+            RunReplication(replication, routeCache, results[replication]);
+        },
+        threads);
+    Config::SetDefault("ns3::UdpSocketImpl::RouteCache", BooleanValue(false));
+    return results;
+}
+
+void
+ParallelReplicationsTestCase::DoRun()
+{
+    uint64_t generation = Ipv4RoutingProtocol::GetRouteGeneration();
+    std::vector<Result> sequential = RunAll(1, m_routeCache);
+    uint64_t sequentialInvalidations = Ipv4RoutingProtocol::GetRouteGeneration() - generation;
+    generation = Ipv4RoutingProtocol::GetRouteGeneration();
+    std::vector<Result> parallel = RunAll(4, m_routeCache);
+    NS_TEST_EXPECT_MSG_EQ(Ipv4RoutingProtocol::GetRouteGeneration() - generation,
+                          sequentialInvalidations,
+                          "Invalidations of the routes lost by the threads");
+
+    for (std::size_t i = 0; i < sequential.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(sequential[i].nodes, 2, "Nodes of other replications");
+        NS_TEST_EXPECT_MSG_EQ(sequential[i].address,
+                              sequential[0].address,
+                              "Addresses allocated by other replications");
+        NS_TEST_EXPECT_MSG_EQ(sequential[i].firstUid,
+                              sequential[0].firstUid,
+                              "Packets created by other replications");
+        NS_TEST_EXPECT_MSG_GT(sequential[i].packets, 500, "Too few packets received");
+        NS_TEST_EXPECT_MSG_EQ(sequential[i].context,
+                              "/Names/sink/ApplicationList/0/$ns3::PacketSink/Rx",
+                              "Wrong context");
+        if (i > 0)
+        {
+            NS_TEST_EXPECT_MSG_NE(sequential[i].bytes, sequential[0].bytes, "Same traffic");
+        }
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].nodes, sequential[i].nodes, "Different nodes");
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].address, sequential[i].address, "Different address");
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].firstUid, sequential[i].firstUid, "Different uid");
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].packets, sequential[i].packets, "Different packets");
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].bytes, sequential[i].bytes, "Different bytes");
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].last, sequential[i].last, "Different last packet");
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].context, sequential[i].context, "Different context");
+    }
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Parallel replications TestSuite
+ */
+class ParallelReplicationsTestSuite : public TestSuite
+{
+  public:
+    ParallelReplicationsTestSuite();
+};
+
+ParallelReplicationsTestSuite::ParallelReplicationsTestSuite()
+    : TestSuite("parallel-replications", UNIT)
+{
+    AddTestCase(new ParallelReplicationsTestCase(false), TestCase::QUICK);
+    AddTestCase(new ParallelReplicationsTestCase(true), TestCase::QUICK);
+}
+
+static ParallelReplicationsTestSuite g_parallelReplicationsTestSuite; //!< Static variable for test initialization
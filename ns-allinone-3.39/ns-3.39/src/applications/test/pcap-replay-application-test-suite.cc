@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/double.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/pcap-file.h"
+#include "ns3/pcap-replay-application.h"
+#include "ns3/pcap-replay-helper.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Build an Ethernet frame with a VLAN tag carrying an O-RAN eCPRI message.
+ * \param messageType eCPRI message type (0 for U-plane, 2 for C-plane)
+ * \param pcId eAxC identifier
+ * \param size total frame size
+ * \return the frame
+ */
+static std::vector<uint8_t>
+MakeEcpriFrame(uint8_t messageType, uint16_t pcId, uint32_t size)
+{
+    std::vector<uint8_t> frame(size, 0);
+    frame[12] = 0x81; // 802.1Q, PCP 7, VLAN 5
+    frame[13] = 0x00;
+    frame[14] = 0xE0;
+    frame[15] = 0x05;
+    frame[16] = 0xAE; // eCPRI
+    frame[17] = 0xFE;
+    uint8_t* ecpri = &frame[18];
+    ecpri[0] = 0x10;
+    ecpri[1] = messageType;
+    ecpri[2] = (size - 22) >> 8;
+    ecpri[3] = (size - 22) & 0xFF;
+    ecpri[4] = pcId >> 8;
+    ecpri[5] = pcId & 0xFF;
+    ecpri[6] = 9;
+    ecpri[7] = 0x80;
+    uint8_t* radio = ecpri + 8;
+    radio[0] = 0x90; // downlink, payload version 1
+    radio[1] = 3;    // frame 3, subframe 2, slot 5, symbol 7
+    radio[2] = 0x21;
+    radio[3] = 0x47;
+    uint8_t* section = radio + 4;
+    if (messageType == 2)
+    {
+        radio[4] = 1; // one section of type 1
+        radio[5] = 1;
+        section = radio + 8;
+    }
+    section[0] = 0x12; // section 0x123, start PRB 10, 20 PRBs
+    section[1] = 0x30;
+    section[2] = 10;
+    section[3] = 20;
+    return frame;
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Decoding of the eCPRI and O-RAN headers.
+ */
+class EcpriDecodeTestCase : public TestCase
+{
+  public:
+    EcpriDecodeTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EcpriDecodeTestCase::EcpriDecodeTestCase()
+    : TestCase("eCPRI header decoding")
+{
+}
+
+void
+EcpriDecodeTestCase::DoRun()
+{
+    PcapReplayApplication::EcpriInfo info;
+    std::vector<uint8_t> uplane = MakeEcpriFrame(0, 0x0102, 1000);
+    NS_TEST_ASSERT_MSG_EQ(PcapReplayApplication::DecodeEcpri(uplane.data(), uplane.size(), info),
+                          true,
+                          "U-plane frame not decoded");
+    NS_TEST_EXPECT_MSG_EQ(info.vlanId, 5, "Wrong VLAN");
+    NS_TEST_EXPECT_MSG_EQ(+info.pcp, 7, "Wrong PCP");
+    NS_TEST_EXPECT_MSG_EQ(info.headerLength, 18, "Wrong header length");
+    NS_TEST_EXPECT_MSG_EQ(+info.messageType, 0, "Wrong message type");
+    NS_TEST_EXPECT_MSG_EQ(info.payloadSize, 978, "Wrong payload size");
+    NS_TEST_EXPECT_MSG_EQ(info.pcId, 0x0102, "Wrong eAxC");
+    NS_TEST_EXPECT_MSG_EQ(+info.seqId, 9, "Wrong sequence");
+    NS_TEST_EXPECT_MSG_EQ(info.oran, true, "O-RAN headers not decoded");
+    NS_TEST_EXPECT_MSG_EQ(+info.dataDirection, 1, "Wrong direction");
+    NS_TEST_EXPECT_MSG_EQ(+info.frameId, 3, "Wrong frame");
+    NS_TEST_EXPECT_MSG_EQ(+info.subframeId, 2, "Wrong subframe");
+    NS_TEST_EXPECT_MSG_EQ(+info.slotId, 5, "Wrong slot");
+    NS_TEST_EXPECT_MSG_EQ(+info.symbolId, 7, "Wrong symbol");
+    NS_TEST_EXPECT_MSG_EQ(info.sectionId, 0x123, "Wrong section");
+    NS_TEST_EXPECT_MSG_EQ(info.startPrb, 10, "Wrong start PRB");
+    NS_TEST_EXPECT_MSG_EQ(info.numPrb, 20, "Wrong number of PRBs");
+
+    std::vector<uint8_t> cplane = MakeEcpriFrame(2, 7, 60);
+    NS_TEST_ASSERT_MSG_EQ(PcapReplayApplication::DecodeEcpri(cplane.data(), cplane.size(), info),
+                          true,
+                          "C-plane frame not decoded");
+    NS_TEST_EXPECT_MSG_EQ(+info.messageType, 2, "Wrong message type");
+    NS_TEST_EXPECT_MSG_EQ(info.sectionId, 0x123, "Wrong section");
+    NS_TEST_EXPECT_MSG_EQ(info.numPrb, 20, "Wrong number of PRBs");
+
+    std::vector<uint8_t> ipv4(60, 0);
+    ipv4[12] = 0x08;
+    NS_TEST_EXPECT_MSG_EQ(PcapReplayApplication::DecodeEcpri(ipv4.data(), ipv4.size(), info),
+                          false,
+                          "IPv4 frame decoded as eCPRI");
+    NS_TEST_EXPECT_MSG_EQ(info.headerLength, 14, "Wrong header length");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Timing of two merged, time-scaled captures.
+ */
+class PcapReplayTestCase : public TestCase
+{
+  public:
+    PcapReplayTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Record a sent eCPRI frame.
+     * \param packet the packet
+     * \param info the decoded headers
+     */
+    void Sent(Ptr<const Packet> packet, const PcapReplayApplication::EcpriInfo& info);
+
+    std::vector<Time> m_times;        //!< Transmission times
+    std::vector<uint32_t> m_sizes;    //!< Packet sizes
+    std::vector<uint8_t> m_messages;  //!< eCPRI message types
+};
+
+PcapReplayTestCase::PcapReplayTestCase()
+    : TestCase("PCAP replay timing and merging")
+{
+}
+
+void
+PcapReplayTestCase::Sent(Ptr<const Packet> packet, const PcapReplayApplication::EcpriInfo& info)
+{
+    m_times.push_back(Simulator::Now());
+    m_sizes.push_back(packet->GetSize());
+    m_messages.push_back(info.messageType);
+}
+
+void
+PcapReplayTestCase::DoRun()
+{
+    std::string uplaneFile = CreateTempDirFilename("uplane.pcap");
+    std::string cplaneFile = CreateTempDirFilename("cplane.pcap");
+    {
+        PcapFile file;
+        file.Open(uplaneFile, std::ios::out);
+        file.Init(1, 65535, 0, false, true);
+        std::vector<uint8_t> frame = MakeEcpriFrame(0, 1, 1000);
+        std::vector<uint8_t> ipv4(100, 0);
+        ipv4[12] = 0x08;
+        file.Write(10, 1000, frame.data(), frame.size());
+        file.Write(10, 1000, frame.data(), frame.size());
+        file.Write(10, 2000, ipv4.data(), ipv4.size());
+        file.Write(10, 101000, frame.data(), frame.size());
+        file.Write(10, 251000, frame.data(), frame.size());
+        file.Close();
+        file.Open(cplaneFile, std::ios::out);
+        file.Init(1, 65535, 0, false, false);
+        frame = MakeEcpriFrame(2, 1, 60);
+        file.Write(3, 0, frame.data(), frame.size());
+        file.Write(3, 50, frame.data(), frame.size());
+        file.Close();
+    }
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+    // the ARP pending queue would drop the frames of the first burst
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    uint16_t port = 9;
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sinkHelper.Install(nodes.Get(1));
+    sinkApps.Start(Seconds(0));
+
+    PcapReplayHelper replayHelper(InetSocketAddress(interfaces.GetAddress(1), port),
+                                  uplaneFile + "," + cplaneFile);
+    replayHelper.SetAttribute("TimeScale", DoubleValue(2));
+    replayHelper.SetAttribute("Phase", StringValue("ns3::ConstantRandomVariable[Constant=0.001]"));
+    ApplicationContainer replayApps = replayHelper.Install(nodes.Get(0));
+    replayApps.Start(Seconds(1));
+    replayApps.Get(0)->TraceConnectWithoutContext("TxEcpri",
+                                                  MakeCallback(&PcapReplayTestCase::Sent, this));
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    Ptr<PcapReplayApplication> replay = DynamicCast<PcapReplayApplication>(replayApps.Get(0));
+    NS_TEST_EXPECT_MSG_EQ(replay->GetSentPackets(), 6, "Wrong number of frames sent");
+    NS_TEST_EXPECT_MSG_EQ(replay->GetSentBytes(), 4 * 982 + 2 * 42, "Wrong number of bytes sent");
+    Ptr<PacketSink> sink = DynamicCast<PacketSink>(sinkApps.Get(0));
+    NS_TEST_EXPECT_MSG_EQ(sink->GetTotalRx(), 4 * 982 + 2 * 42, "Wrong number of bytes received");
+
+    // start at 1 s plus a 1 ms phase, inter-frame times doubled
+    const std::vector<Time> times = {MilliSeconds(1001),
+                                     MilliSeconds(1001),
+                                     MilliSeconds(1001),
+                                     MicroSeconds(1001100),
+                                     MicroSeconds(1001200),
+                                     MicroSeconds(1001500)};
+    const std::vector<uint8_t> messages = {0, 0, 2, 2, 0, 0};
+    NS_TEST_ASSERT_MSG_EQ(m_times.size(), times.size(), "Wrong number of eCPRI frames");
+    for (std::size_t i = 0; i < times.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_times[i], times[i], "Wrong transmission time of frame " << i);
+        NS_TEST_EXPECT_MSG_EQ(+m_messages[i], +messages[i], "Wrong message of frame " << i);
+        uint32_t size = messages[i] ? 42 : 982;
+        NS_TEST_EXPECT_MSG_EQ(m_sizes[i], size, "Wrong size of frame " << i);
+    }
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief PcapReplayApplication TestSuite
+ */
+class PcapReplayTestSuite : public TestSuite
+{
+  public:
+    PcapReplayTestSuite();
+};
+
+PcapReplayTestSuite::PcapReplayTestSuite()
+    : TestSuite("pcap-replay-application", UNIT)
+{
+    AddTestCase(new EcpriDecodeTestCase, TestCase::QUICK);
+    AddTestCase(new PcapReplayTestCase, TestCase::QUICK);
+}
+
+static PcapReplayTestSuite g_pcapReplayTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/double.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/poisson-helper.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/site-traffic-aggregator-helper.h"
+#include "ns3/site-traffic-aggregator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Record the reception time of a packet.
+ * \param times the reception times
+ * \param packet the packet
+ * \param from the source address
+ */
+static void
+Received(std::vector<Time>* times, Ptr<const Packet> packet, const Address& from)
+{
+    times->push_back(Simulator::Now());
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Check that a SiteTrafficAggregator sends the same packets as one
+ * Poissonapp per flow, to the same ports.
+ */
+class SiteTrafficAggregatorTestCase : public TestCase
+{
+  public:
+    SiteTrafficAggregatorTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run two nodes with a sink per port on the second one.
+     * \param aggregate use a SiteTrafficAggregator instead of Poissonapps
+     * \param times the reception times, per port
+     * \param bytes the bytes received, per port
+     */
+    void RunFlows(bool aggregate,
+                  std::vector<std::vector<Time>>& times,
+                  std::vector<uint64_t>& bytes);
+};
+
+SiteTrafficAggregatorTestCase::SiteTrafficAggregatorTestCase()
+    : TestCase("SiteTrafficAggregator against one Poissonapp per flow")
+{
+}
+
+void
+SiteTrafficAggregatorTestCase::RunFlows(bool aggregate,
+                                        std::vector<std::vector<Time>>& times,
+                                        std::vector<uint64_t>& bytes)
+{
+    // three cells: constant rate flows of different sizes and periods, the
+    // last one limited in bytes
+    const uint16_t ports[] = {8080, 8081, 9090};
+    const uint32_t sizes[] = {1000, 3000, 200};
+    const double intervals[] = {100e-6, 250e-6, 100e-6};
+    const uint64_t maxBytes[] = {0, 0, 2000};
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    times.assign(3, {});
+    ApplicationContainer sinkApps;
+    SiteTrafficAggregatorHelper aggregatorHelper("ns3::UdpSocketFactory");
+    ApplicationContainer sources;
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        InetSocketAddress address(interfaces.GetAddress(1), ports[i]);
+        PacketSinkHelper sinkHelper("ns3::UdpSocketFactory", address);
+        sinkApps.Add(sinkHelper.Install(nodes.Get(1)));
+        sinkApps.Get(i)->TraceConnectWithoutContext(
+            "Rx",
+            MakeBoundCallback(&Received, &times[i]));
+        if (aggregate)
+        {
+            aggregatorHelper.AddPoissonFlow(address, sizes[i], intervals[i], "cte", maxBytes[i]);
+        }
+        else
+        {
+            PoissonHelper poissonHelper("ns3::UdpSocketFactory", address);
+            poissonHelper.SetAttribute("PacketGen", StringValue("cte"));
+            poissonHelper.SetAttribute("PacketSize", UintegerValue(sizes[i]));
+            poissonHelper.SetAttribute("Interval", DoubleValue(intervals[i]));
+            poissonHelper.SetAttribute("MaxBytes", UintegerValue(maxBytes[i]));
+            sources.Add(poissonHelper.Install(nodes.Get(0)));
+        }
+    }
+    if (aggregate)
+    {
+        sources = aggregatorHelper.Install(nodes.Get(0));
+        Ptr<SiteTrafficAggregator> aggregator =
+            DynamicCast<SiteTrafficAggregator>(sources.Get(0));
+        NS_TEST_EXPECT_MSG_EQ(aggregator->GetNFlows(), 3, "Wrong number of flows");
+    }
+    sinkApps.Start(Seconds(0));
+    sources.Start(Seconds(1));
+
+    Simulator::Stop(Seconds(1.01));
+    Simulator::Run();
+
+    bytes.clear();
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        bytes.push_back(DynamicCast<PacketSink>(sinkApps.Get(i))->GetTotalRx());
+    }
+    if (aggregate)
+    {
+        Ptr<SiteTrafficAggregator> aggregator =
+            DynamicCast<SiteTrafficAggregator>(sources.Get(0));
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(aggregator->GetSentBytes(i), bytes[i], "Wrong sent bytes");
+        }
+        NS_TEST_EXPECT_MSG_EQ(aggregator->GetFailedPackets(), 0, "Packets refused");
+    }
+    Simulator::Destroy();
+}
+
+void
+SiteTrafficAggregatorTestCase::DoRun()
+{
+    std::vector<std::vector<Time>> appTimes;
+    std::vector<uint64_t> appBytes;
+    RunFlows(false, appTimes, appBytes);
+    std::vector<std::vector<Time>> siteTimes;
+    std::vector<uint64_t> siteBytes;
+    RunFlows(true, siteTimes, siteBytes);
+
+    NS_TEST_EXPECT_MSG_EQ(siteBytes[0], 100 * 1000, "Wrong bytes of the first flow");
+    NS_TEST_EXPECT_MSG_EQ(siteBytes[2], 2000, "The last flow did not stop");
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(siteBytes[i], appBytes[i], "Different bytes on port " << i);
+        NS_TEST_ASSERT_MSG_EQ(siteTimes[i].size(),
+                              appTimes[i].size(),
+                              "Different packets on port " << i);
+        for (std::size_t k = 0; k < siteTimes[i].size(); k++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(siteTimes[i][k], appTimes[i][k], "Different reception time");
+        }
+    }
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Check the rate of the merged Poisson flows of a SiteTrafficAggregator.
+ */
+class SiteTrafficAggregatorPoissonTestCase : public TestCase
+{
+  public:
+    SiteTrafficAggregatorPoissonTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Record a sent packet.
+     * \param packet the packet
+     * \param flow the flow
+     */
+    void Sent(Ptr<const Packet> packet, uint32_t flow);
+
+    std::vector<uint64_t> m_packets; //!< Packets sent per flow
+    Time m_last;                     //!< Time of the last packet
+    bool m_ordered{true};            //!< The packets were sent in time order
+};
+
+SiteTrafficAggregatorPoissonTestCase::SiteTrafficAggregatorPoissonTestCase()
+    : TestCase("SiteTrafficAggregator Poisson flows")
+{
+}
+
+void
+SiteTrafficAggregatorPoissonTestCase::Sent(Ptr<const Packet> packet, uint32_t flow)
+{
+    m_packets[flow]++;
+    m_ordered = m_ordered && Simulator::Now() >= m_last;
+    m_last = Simulator::Now();
+}
+
+void
+SiteTrafficAggregatorPoissonTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    // ten cells of 1000 packets/s on average
+    SiteTrafficAggregatorHelper helper("ns3::UdpSocketFactory");
+    for (uint16_t i = 0; i < 10; i++)
+    {
+        helper.AddPoissonFlow(InetSocketAddress(interfaces.GetAddress(1), 8080 + i), 500, 1e-3);
+    }
+    ApplicationContainer apps = helper.Install(nodes.Get(0));
+    NS_TEST_EXPECT_MSG_EQ(helper.AssignStreams(nodes, 100), 20, "Two streams per flow expected");
+    apps.Start(Seconds(0));
+    apps.Get(0)->TraceConnectWithoutContext(
+        "TxFlow",
+        MakeCallback(&SiteTrafficAggregatorPoissonTestCase::Sent, this));
+    m_packets.assign(10, 0);
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_ordered, true, "Packets sent out of order");
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        // 10000 packets on average, 5 standard deviations
+        NS_TEST_EXPECT_MSG_EQ_TOL(m_packets[i], 10000, 500, "Wrong rate of flow " << i);
+    }
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief SiteTrafficAggregator TestSuite
+ */
+class SiteTrafficAggregatorTestSuite : public TestSuite
+{
+  public:
+    SiteTrafficAggregatorTestSuite();
+};
+
+SiteTrafficAggregatorTestSuite::SiteTrafficAggregatorTestSuite()
+    : TestSuite("site-traffic-aggregator", UNIT)
+{
+    AddTestCase(new SiteTrafficAggregatorTestCase, TestCase::QUICK);
+    AddTestCase(new SiteTrafficAggregatorPoissonTestCase, TestCase::QUICK);
+}
+
+static SiteTrafficAggregatorTestSuite g_siteTrafficAggregatorTestSuite; //!< Static variable for test initialization
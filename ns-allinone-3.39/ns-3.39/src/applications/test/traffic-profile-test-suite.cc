@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/distribution-helper.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/traffic-profile.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Sizes and gaps of a periodic burst: three packets of 1500 bytes 1 us
+ * apart, then a packet of 64 bytes followed by a gap of 100 us.
+ * \param bursts the number of bursts
+ * \param sizes the packet sizes
+ * \param gaps the gap after each packet
+ */
+static void
+MakeBursts(uint32_t bursts, std::vector<uint32_t>& sizes, std::vector<double>& gaps)
+{
+    for (uint32_t b = 0; b < bursts; b++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            sizes.push_back(1500);
+            gaps.push_back(1e-6);
+        }
+        sizes.push_back(64);
+        gaps.push_back(100e-6);
+    }
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Check the alias tables, the gap quantiles, the fitting and the
+ * file format of the traffic profiles.
+ */
+class TrafficProfileTestCase : public TestCase
+{
+  public:
+    TrafficProfileTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+TrafficProfileTestCase::TrafficProfileTestCase()
+    : TestCase("Traffic profile tables, fitting and files")
+{
+}
+
+void
+TrafficProfileTestCase::DoRun()
+{
+    // the probability of every entry of an alias table is its weight
+    const std::vector<double> weights = {1, 2, 3, 4, 0, 10};
+    std::vector<uint32_t> alias;
+    std::vector<double> threshold;
+    TrafficProfile::BuildAliasTable(weights, alias, threshold);
+    std::vector<double> probability(weights.size(), 0);
+    for (std::size_t i = 0; i < weights.size(); i++)
+    {
+        probability[i] += threshold[i] / weights.size();
+        probability[alias[i]] += (1 - threshold[i]) / weights.size();
+    }
+    for (std::size_t i = 0; i < weights.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(probability[i], weights[i] / 20, 1e-12, "Wrong probability");
+    }
+
+    Ptr<TrafficProfile> profile = Create<TrafficProfile>();
+    profile->AddState({100, 200}, {1, 3}, {0, 1e-3, 3e-3});
+    NS_TEST_EXPECT_MSG_EQ(profile->GetPacketSize(0, 0.1), 100, "Wrong size");
+    NS_TEST_EXPECT_MSG_EQ(profile->GetPacketSize(0, 0.9), 200, "Wrong size");
+    NS_TEST_EXPECT_MSG_EQ_TOL(profile->GetGap(0, 0.25), 0.5e-3, 1e-15, "Wrong gap");
+    NS_TEST_EXPECT_MSG_EQ_TOL(profile->GetGap(0, 0.75), 2e-3, 1e-15, "Wrong gap");
+    NS_TEST_EXPECT_MSG_EQ(profile->GetNextState(0, 0.5), 0, "A single state has no transition");
+
+    // two states fitted to regular bursts
+    std::vector<uint32_t> sizes;
+    std::vector<double> gaps;
+    MakeBursts(100, sizes, gaps);
+    profile = TrafficProfile::Fit(sizes, gaps, 10e-6, 11);
+    NS_TEST_ASSERT_MSG_EQ(profile->GetNStates(), 2, "Wrong number of states");
+    const uint32_t n = 3000;
+    uint32_t stay = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double u = (i + 0.5) / n;
+        NS_TEST_EXPECT_MSG_EQ(profile->GetPacketSize(0, u), 1500, "Wrong size in a burst");
+        NS_TEST_EXPECT_MSG_EQ(profile->GetPacketSize(1, u), 64, "Wrong size at the end of a burst");
+        NS_TEST_EXPECT_MSG_EQ_TOL(profile->GetGap(0, u), 1e-6, 1e-15, "Wrong gap in a burst");
+        NS_TEST_EXPECT_MSG_EQ_TOL(profile->GetGap(1, u), 100e-6, 1e-15, "Wrong gap between bursts");
+        NS_TEST_EXPECT_MSG_EQ(profile->GetNextState(1, u), 0, "A burst follows a burst end");
+        stay += (profile->GetNextState(0, u) == 0);
+    }
+    // 200 transitions within the bursts, 100 to their end
+    NS_TEST_EXPECT_MSG_EQ_TOL(stay, 2 * n / 3, 1, "Wrong transition probability");
+    NS_TEST_EXPECT_MSG_EQ(TrafficProfile::Fit(sizes, gaps, 1, 11)->GetNStates(),
+                          1,
+                          "A single state expected without burst ends");
+
+    // the file keeps the tables as they are
+    std::string filename = CreateTempDirFilename("bursts.tprof");
+    profile->Save(filename);
+    Ptr<const TrafficProfile> loaded = TrafficProfile::Load(filename);
+    NS_TEST_ASSERT_MSG_EQ(loaded->GetNStates(), 2, "Wrong number of loaded states");
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double u = (i + 0.5) / n;
+        for (uint32_t s = 0; s < 2; s++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(loaded->GetPacketSize(s, u),
+                                  profile->GetPacketSize(s, u),
+                                  "Wrong loaded size");
+            NS_TEST_EXPECT_MSG_EQ(loaded->GetGap(s, u), profile->GetGap(s, u), "Wrong loaded gap");
+            NS_TEST_EXPECT_MSG_EQ(loaded->GetNextState(s, u),
+                                  profile->GetNextState(s, u),
+                                  "Wrong loaded transition");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(TrafficProfile::Load(filename), loaded, "The profile is loaded once");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Check the traffic of a Distributionapp driven by a traffic profile.
+ */
+class TrafficProfileApplicationTestCase : public TestCase
+{
+  public:
+    TrafficProfileApplicationTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Record a sent packet.
+     * \param packet the packet
+     */
+    void Sent(Ptr<const Packet> packet);
+
+    std::vector<Time> m_times;     //!< Transmission times
+    std::vector<uint32_t> m_sizes; //!< Packet sizes
+};
+
+TrafficProfileApplicationTestCase::TrafficProfileApplicationTestCase()
+    : TestCase("Distributionapp with a traffic profile")
+{
+}
+
+void
+TrafficProfileApplicationTestCase::Sent(Ptr<const Packet> packet)
+{
+    m_times.push_back(Simulator::Now());
+    m_sizes.push_back(packet->GetSize());
+}
+
+void
+TrafficProfileApplicationTestCase::DoRun()
+{
+    std::vector<uint32_t> sizes;
+    std::vector<double> gaps;
+    MakeBursts(10, sizes, gaps);
+    std::string filename = CreateTempDirFilename("app.tprof");
+    TrafficProfile::Fit(sizes, gaps, 10e-6, 11)->Save(filename);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    uint16_t port = 9;
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sinkHelper.Install(nodes.Get(1));
+    sinkApps.Start(Seconds(0));
+
+    DistributionHelper helper("ns3::UdpSocketFactory",
+                              InetSocketAddress(interfaces.GetAddress(1), port));
+    helper.SetAttribute("PacketGen", StringValue("Profile"));
+    helper.SetAttribute("ArrivalGen", StringValue("Profile"));
+    helper.SetAttribute("ProfileFile", StringValue(filename));
+    ApplicationContainer apps = helper.Install(nodes.Get(0));
+    apps.Start(Seconds(1));
+    apps.Get(0)->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&TrafficProfileApplicationTestCase::Sent, this));
+
+    Simulator::Stop(Seconds(1.01));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // the profile reproduces the bursts: 1500 bytes 1 us before the next
+    // packet, 64 bytes 100 us before the next burst
+    NS_TEST_ASSERT_MSG_GT(m_sizes.size(), 300, "Too few packets sent");
+    uint64_t bytes = 0;
+    for (std::size_t i = 0; i + 1 < m_sizes.size(); i++)
+    {
+        bytes += m_sizes[i];
+        Time gap = m_sizes[i] == 1500 ? MicroSeconds(1) : MicroSeconds(100);
+        NS_TEST_ASSERT_MSG_EQ(m_times[i + 1] - m_times[i], gap, "Wrong gap after packet " << i);
+    }
+    bytes += m_sizes.back();
+    Ptr<PacketSink> sink = DynamicCast<PacketSink>(sinkApps.Get(0));
+    NS_TEST_EXPECT_MSG_EQ(sink->GetTotalRx(), bytes, "Wrong number of bytes received");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief TrafficProfile TestSuite
+ */
+class TrafficProfileTestSuite : public TestSuite
+{
+  public:
+    TrafficProfileTestSuite();
+};
+
+TrafficProfileTestSuite::TrafficProfileTestSuite()
+    : TestSuite("traffic-profile", UNIT)
+{
+    AddTestCase(new TrafficProfileTestCase, TestCase::QUICK);
+    AddTestCase(new TrafficProfileApplicationTestCase, TestCase::QUICK);
+}
+
+static TrafficProfileTestSuite g_trafficProfileTestSuite; //!< Static variable for test initialization
@@ -16,13 +16,17 @@
  */
 #include "bridge-net-device.h"
 
+#include "ethernet-queue-disc-item.h"
+
 #include "ns3/boolean.h"
 #include "ns3/channel.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
+#include "ns3/vlan-header.h"
 
 /**
  * \file
@@ -59,7 +63,13 @@ BridgeNetDevice::GetTypeId()
                           "Time it takes for learned MAC state entry to expire.",
                           TimeValue(Seconds(300)),
                           MakeTimeAccessor(&BridgeNetDevice::m_expirationTime),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("EnableTrafficControl",
+                          "Forward the frames through the traffic control layer of the node, "
+                          "if any, so that the queue discs of the ports schedule them",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&BridgeNetDevice::m_enableTrafficControl),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -86,8 +96,10 @@ BridgeNetDevice::DoDispose()
         *iter = nullptr;
     }
     m_ports.clear();
+    m_learnState.clear();
     m_channel = nullptr;
     m_node = nullptr;
+    m_tc = nullptr;
     NetDevice::DoDispose();
 }
 
@@ -115,7 +127,7 @@ BridgeNetDevice::ReceiveFromDevice(Ptr<NetDevice> incomingPort,
     case PACKET_HOST:
         if (dst48 == m_address)
         {
-            Learn(src48, incomingPort);
+            Learn(src48, incomingPort, GetVid(packet));
             m_rxCallback(this, packet, protocol, src);
         }
         break;
@@ -129,7 +141,7 @@ BridgeNetDevice::ReceiveFromDevice(Ptr<NetDevice> incomingPort,
     case PACKET_OTHERHOST:
         if (dst48 == m_address)
         {
-            Learn(src48, incomingPort);
+            Learn(src48, incomingPort, GetVid(packet));
             m_rxCallback(this, packet, protocol, src);
         }
         else
@@ -152,13 +164,14 @@ BridgeNetDevice::ForwardUnicast(Ptr<NetDevice> incomingPort,
                  << incomingPort->GetInstanceTypeId().GetName() << ", packet=" << packet
                  << ", protocol=" << protocol << ", src=" << src << ", dst=" << dst << ")");
 
-    Learn(src, incomingPort);
-    Ptr<NetDevice> outPort = GetLearnedState(dst);
+    uint16_t vid = GetVid(packet);
+    Learn(src, incomingPort, vid);
+    Ptr<NetDevice> outPort = GetLearnedState(dst, vid);
     if (outPort && outPort != incomingPort)
     {
         NS_LOG_LOGIC("Learning bridge state says to use port `"
                      << outPort->GetInstanceTypeId().GetName() << "'");
-        outPort->SendFrom(packet->Copy(), src, dst, protocol);
+        SendOnPort(outPort, packet->Copy(), protocol, src, dst);
     }
     else
     {
@@ -174,7 +187,7 @@ BridgeNetDevice::ForwardUnicast(Ptr<NetDevice> incomingPort,
                              << "): " << incomingPort->GetInstanceTypeId().GetName() << " --> "
                              << port->GetInstanceTypeId().GetName() << " (UID " << packet->GetUid()
                              << ").");
-                port->SendFrom(packet->Copy(), src, dst, protocol);
+                SendOnPort(port, packet->Copy(), protocol, src, dst);
             }
         }
     }
@@ -191,7 +204,7 @@ BridgeNetDevice::ForwardBroadcast(Ptr<NetDevice> incomingPort,
     NS_LOG_DEBUG("LearningBridgeForward (incomingPort="
                  << incomingPort->GetInstanceTypeId().GetName() << ", packet=" << packet
                  << ", protocol=" << protocol << ", src=" << src << ", dst=" << dst << ")");
-    Learn(src, incomingPort);
+    Learn(src, incomingPort, GetVid(packet));
 
     for (std::vector<Ptr<NetDevice>>::iterator iter = m_ports.begin(); iter != m_ports.end();
          iter++)
@@ -203,31 +216,74 @@ BridgeNetDevice::ForwardBroadcast(Ptr<NetDevice> incomingPort,
                                                    << incomingPort->GetInstanceTypeId().GetName()
                                                    << " --> " << port->GetInstanceTypeId().GetName()
                                                    << " (UID " << packet->GetUid() << ").");
-            port->SendFrom(packet->Copy(), src, dst, protocol);
+            SendOnPort(port, packet->Copy(), protocol, src, dst);
         }
     }
 }
 
 void
-BridgeNetDevice::Learn(Mac48Address source, Ptr<NetDevice> port)
+BridgeNetDevice::SendOnPort(Ptr<NetDevice> port,
+                            Ptr<Packet> packet,
+                            uint16_t protocol,
+                            Mac48Address src,
+                            Mac48Address dst)
+{
+    NS_LOG_FUNCTION_NOARGS();
+    if (m_enableTrafficControl && !m_tc)
+    {
+        m_tc = m_node->GetObject<TrafficControlLayer>();
+    }
+    if (m_enableTrafficControl && m_tc)
+    {
+        m_tc->Send(port, Create<EthernetQueueDiscItem>(packet, src, dst, protocol));
+    }
+    else
+    {
+        port->SendFrom(packet, src, dst, protocol);
+    }
+}
+
+uint16_t
+BridgeNetDevice::GetVid(Ptr<const Packet> packet)
+{
+    VlanTag tag;
+    packet->PeekPacketTag(tag);
+    return tag.GetVid();
+}
+
+uint64_t
+BridgeNetDevice::GetLearnKey(Mac48Address address, uint16_t vid)
+{
+    uint8_t buffer[6];
+    address.CopyTo(buffer);
+    uint64_t key = vid;
+    for (uint8_t byte : buffer)
+    {
+        key = (key << 8) | byte;
+    }
+    return key;
+}
+
+void
+BridgeNetDevice::Learn(Mac48Address source, Ptr<NetDevice> port, uint16_t vid)
 {
     NS_LOG_FUNCTION_NOARGS();
     if (m_enableLearning)
     {
-        LearnedState& state = m_learnState[source];
+        LearnedState& state = m_learnState[GetLearnKey(source, vid)];
         state.associatedPort = port;
         state.expirationTime = Simulator::Now() + m_expirationTime;
     }
 }
 
 Ptr<NetDevice>
-BridgeNetDevice::GetLearnedState(Mac48Address source)
+BridgeNetDevice::GetLearnedState(Mac48Address source, uint16_t vid)
 {
     NS_LOG_FUNCTION_NOARGS();
     if (m_enableLearning)
     {
         Time now = Simulator::Now();
-        std::map<Mac48Address, LearnedState>::iterator iter = m_learnState.find(source);
+        auto iter = m_learnState.find(GetLearnKey(source, vid));
         if (iter != m_learnState.end())
         {
             LearnedState& state = iter->second;
@@ -409,7 +465,7 @@ BridgeNetDevice::SendFrom(Ptr<Packet> packet,
     // try to use the learned state if data is unicast
     if (!dst.IsGroup())
     {
-        Ptr<NetDevice> outPort = GetLearnedState(dst);
+        Ptr<NetDevice> outPort = GetLearnedState(dst, GetVid(packet));
         if (outPort)
         {
             outPort->SendFrom(packet, src, dest, protocolNumber);
@@ -22,9 +22,9 @@
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
 
-#include <map>
 #include <stdint.h>
 #include <string>
+#include <unordered_map>
 
 /**
  * \file
@@ -36,6 +36,7 @@ namespace ns3
 {
 
 class Node;
+class TrafficControlLayer;
 
 /**
  * \defgroup bridge Bridge Network Device
@@ -63,6 +64,18 @@ class Node;
  * \attention If including a WifiNetDevice in a bridge, the wifi
  * device must be in Access Point mode.  Adhoc mode is not supported
  * with bridging.
+ *
+ * The learned addresses are kept per VLAN (IEEE 802.1Q independent VLAN
+ * learning): the VLAN of a frame is the VID of its VlanTag, or zero if the
+ * frame is untagged.  The learning table is a hash table.
+ *
+ * With the EnableTrafficControl attribute, the forwarded frames go through
+ * the traffic control layer of the node (if any) as EthernetQueueDiscItems,
+ * so that the queue disc installed on the outgoing port queues and
+ * schedules them (by their PCP, for instance, with a PcpPacketFilter).
+ * The ports must then accept the frames of Ethertype 0x6558 (transparent
+ * Ethernet bridging) and send them as they are, as PointToPointNetDevice
+ * does.
  */
 
 /**
@@ -193,17 +206,47 @@ class BridgeNetDevice : public NetDevice
      * \brief Learns the port a MAC address is sending from
      * \param source source address
      * \param port the port the source is sending from
+     * \param vid the VLAN of the frame
      */
-    void Learn(Mac48Address source, Ptr<NetDevice> port);
+    void Learn(Mac48Address source, Ptr<NetDevice> port, uint16_t vid = 0);
 
     /**
      * \brief Gets the port associated to a source address
      * \param source the source address
+     * \param vid the VLAN of the frame
      * \returns the port the source is associated to, or NULL if no association is known.
      */
-    Ptr<NetDevice> GetLearnedState(Mac48Address source);
+    Ptr<NetDevice> GetLearnedState(Mac48Address source, uint16_t vid = 0);
+
+    /**
+     * \brief Sends a forwarded frame through a port, either directly or
+     * through the traffic control layer
+     * \param port the outgoing port
+     * \param packet the packet
+     * \param protocol the packet protocol (e.g., Ethertype)
+     * \param src the packet source
+     * \param dst the packet destination
+     */
+    void SendOnPort(Ptr<NetDevice> port,
+                    Ptr<Packet> packet,
+                    uint16_t protocol,
+                    Mac48Address src,
+                    Mac48Address dst);
 
   private:
+    /**
+     * \param packet a frame
+     * \return the VLAN of the frame
+     */
+    static uint16_t GetVid(Ptr<const Packet> packet);
+
+    /**
+     * \param address a MAC address
+     * \param vid a VLAN
+     * \return the key of the address in the VLAN in the learning table
+     */
+    static uint64_t GetLearnKey(Mac48Address address, uint16_t vid);
+
     NetDevice::ReceiveCallback m_rxCallback;               //!< receive callback
     NetDevice::PromiscReceiveCallback m_promiscRxCallback; //!< promiscuous receive callback
 
@@ -220,13 +263,16 @@ class BridgeNetDevice : public NetDevice
         Time expirationTime;           //!< time it takes for learned MAC state to expire
     };
 
-    std::map<Mac48Address, LearnedState> m_learnState; //!< Container for known address statuses
-    Ptr<Node> m_node;                                  //!< node owning this NetDevice
-    Ptr<BridgeChannel> m_channel;                      //!< virtual bridged channel
-    std::vector<Ptr<NetDevice>> m_ports;               //!< bridged ports
-    uint32_t m_ifIndex;                                //!< Interface index
-    uint16_t m_mtu;                                    //!< MTU of the bridged NetDevice
+    /// Container for known address statuses, by VLAN and address
+    std::unordered_map<uint64_t, LearnedState> m_learnState;
+    Ptr<Node> m_node;                    //!< node owning this NetDevice
+    Ptr<BridgeChannel> m_channel;        //!< virtual bridged channel
+    std::vector<Ptr<NetDevice>> m_ports; //!< bridged ports
+    uint32_t m_ifIndex;                  //!< Interface index
+    uint16_t m_mtu;                      //!< MTU of the bridged NetDevice
     bool m_enableLearning; //!< true if the bridge will learn the node status
+    bool m_enableTrafficControl; //!< true to forward through the traffic control layer
+    Ptr<TrafficControlLayer> m_tc; //!< traffic control layer of the node
 };
 
 } // namespace ns3
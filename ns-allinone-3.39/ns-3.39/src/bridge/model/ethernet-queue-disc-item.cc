@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ethernet-queue-disc-item.h"
+
+#include "ns3/ethernet-header.h"
+#include "ns3/hash.h"
+#include "ns3/log.h"
+#include "ns3/vlan-header.h"
+
+/**
+ * \file
+ * \ingroup bridge
+ * ns3::EthernetQueueDiscItem implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EthernetQueueDiscItem");
+
+EthernetQueueDiscItem::EthernetQueueDiscItem(Ptr<Packet> p,
+                                             Mac48Address source,
+                                             Mac48Address dest,
+                                             uint16_t protocol)
+    : QueueDiscItem(p, dest, PROT_NUMBER),
+      m_source(source),
+      m_payloadProtocol(protocol),
+      m_headerAdded(false)
+{
+}
+
+EthernetQueueDiscItem::~EthernetQueueDiscItem()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+EthernetQueueDiscItem::GetSize() const
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<Packet> p = GetPacket();
+    NS_ASSERT(p);
+    uint32_t ret = p->GetSize();
+    if (!m_headerAdded)
+    {
+        ret += EthernetHeader(false).GetSerializedSize();
+        VlanTag tag;
+        if (p->PeekPacketTag(tag))
+        {
+            ret += VlanHeader().GetSerializedSize();
+        }
+    }
+    return ret;
+}
+
+Mac48Address
+EthernetQueueDiscItem::GetSource() const
+{
+    return m_source;
+}
+
+uint16_t
+EthernetQueueDiscItem::GetPayloadProtocol() const
+{
+    return m_payloadProtocol;
+}
+
+void
+EthernetQueueDiscItem::AddHeader()
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ASSERT_MSG(!m_headerAdded, "The header has been already added to the packet");
+    Ptr<Packet> p = GetPacket();
+    NS_ASSERT(p);
+    uint16_t type = m_payloadProtocol;
+    VlanTag tag;
+    if (p->RemovePacketTag(tag))
+    {
+        p->AddHeader(VlanHeader(tag, type));
+        type = VlanHeader::TPID;
+    }
+    EthernetHeader ethernet(false);
+    ethernet.SetSource(m_source);
+    ethernet.SetDestination(Mac48Address::ConvertFrom(GetAddress()));
+    ethernet.SetLengthType(type);
+    p->AddHeader(ethernet);
+    m_headerAdded = true;
+}
+
+void
+EthernetQueueDiscItem::Print(std::ostream& os) const
+{
+    os << m_source << " > " << GetAddress() << " type 0x" << std::hex << m_payloadProtocol
+       << std::dec << " ";
+    QueueDiscItem::Print(os);
+}
+
+bool
+EthernetQueueDiscItem::Mark()
+{
+    NS_LOG_FUNCTION(this);
+    return false;
+}
+
+uint32_t
+EthernetQueueDiscItem::Hash(uint32_t perturbation) const
+{
+    NS_LOG_FUNCTION(this << perturbation);
+
+    uint8_t buf[20];
+    m_source.CopyTo(buf);
+    Mac48Address::ConvertFrom(GetAddress()).CopyTo(buf + 6);
+    VlanTag tag;
+    GetPacket()->PeekPacketTag(tag);
+    uint16_t vid = tag.GetVid();
+    buf[12] = vid >> 8;
+    buf[13] = vid & 0xff;
+    buf[14] = m_payloadProtocol >> 8;
+    buf[15] = m_payloadProtocol & 0xff;
+    buf[16] = (perturbation >> 24) & 0xff;
+    buf[17] = (perturbation >> 16) & 0xff;
+    buf[18] = (perturbation >> 8) & 0xff;
+    buf[19] = perturbation & 0xff;
+
+    uint32_t hash = Hash32((char*)buf, 20);
+
+    NS_LOG_DEBUG("Hash value " << hash);
+
+    return hash;
+}
+
+} // namespace ns3
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ETHERNET_QUEUE_DISC_ITEM_H
+#define ETHERNET_QUEUE_DISC_ITEM_H
+
+#include "ns3/mac48-address.h"
+#include "ns3/packet.h"
+#include "ns3/queue-item.h"
+
+/**
+ * \file
+ * \ingroup bridge
+ * ns3::EthernetQueueDiscItem declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup bridge
+ * \ingroup traffic-control
+ *
+ * EthernetQueueDiscItem is a subclass of QueueDiscItem which stores the
+ * frames forwarded by a BridgeNetDevice through the traffic control layer.
+ * The addresses of the frame are kept apart and the 802.1Q tag stays a
+ * VlanTag, so that the packet filters can classify the frame by its PCP;
+ * the Ethernet (and 802.1Q) header is added when the frame is dequeued,
+ * and the frame is handed to the device as Ethertype 0x6558 (transparent
+ * Ethernet bridging).
+ */
+class EthernetQueueDiscItem : public QueueDiscItem
+{
+  public:
+    /// Ethertype of a packet that carries an Ethernet frame
+    static const uint16_t PROT_NUMBER = 0x6558;
+
+    /**
+     * \brief Create a queue disc item containing an Ethernet frame.
+     * \param p the payload of the frame
+     * \param source the source MAC address
+     * \param dest the destination MAC address
+     * \param protocol the Ethertype of the payload
+     */
+    EthernetQueueDiscItem(Ptr<Packet> p,
+                          Mac48Address source,
+                          Mac48Address dest,
+                          uint16_t protocol);
+
+    ~EthernetQueueDiscItem() override;
+
+    // Delete default constructor, copy constructor and assignment operator to avoid misuse
+    EthernetQueueDiscItem() = delete;
+    EthernetQueueDiscItem(const EthernetQueueDiscItem&) = delete;
+    EthernetQueueDiscItem& operator=(const EthernetQueueDiscItem&) = delete;
+
+    /**
+     * \return the size of the frame (headers plus payload).
+     */
+    uint32_t GetSize() const override;
+
+    /// \return the source MAC address
+    Mac48Address GetSource() const;
+
+    /// \return the Ethertype of the payload
+    uint16_t GetPayloadProtocol() const;
+
+    /**
+     * \brief Add the Ethernet (and 802.1Q) header to the packet
+     */
+    void AddHeader() override;
+
+    /**
+     * \brief Print the item contents.
+     * \param os output stream in which the data should be printed.
+     */
+    void Print(std::ostream& os) const override;
+
+    /**
+     * \brief Ethernet frames are not marked.
+     * \return false
+     */
+    bool Mark() override;
+
+    /**
+     * \brief Computes the hash of the addresses, the VLAN and the Ethertype
+     * of the frame
+     * \param perturbation hash perturbation value
+     * \return the hash of the frame
+     */
+    uint32_t Hash(uint32_t perturbation) const override;
+
+  private:
+    Mac48Address m_source;      //!< Source address
+    uint16_t m_payloadProtocol; //!< Ethertype of the payload
+    bool m_headerAdded;         //!< True if the header has already been added to the packet.
+};
+
+} // namespace ns3
+
+#endif /* ETHERNET_QUEUE_DISC_ITEM_H */
@@ -22,6 +22,7 @@
 #include "ptr.h"
 #include "simple-ref-count.h"
 
+#include <atomic>
 #include <stdint.h>
 #include <string>
 
@@ -66,7 +67,10 @@ class ObjectBase;
  * Most subclasses of this base class are implemented by the
  * ATTRIBUTE_HELPER_* macros.
  */
-class AttributeValue : public SimpleRefCount<AttributeValue>
+class AttributeValue : public SimpleRefCount<AttributeValue,
+                                             Empty,
+                                             DefaultDeleter<AttributeValue>,
+                                             std::atomic<uint32_t>>
 {
   public:
     AttributeValue();
@@ -112,7 +116,10 @@ class AttributeValue : public SimpleRefCount<AttributeValue>
  * of this base class are usually provided through the MakeAccessorHelper
  * template functions, hidden behind an ATTRIBUTE_HELPER_* macro.
  */
-class AttributeAccessor : public SimpleRefCount<AttributeAccessor>
+class AttributeAccessor : public SimpleRefCount<AttributeAccessor,
+                                                Empty,
+                                                DefaultDeleter<AttributeAccessor>,
+                                                std::atomic<uint32_t>>
 {
   public:
     AttributeAccessor();
@@ -164,7 +171,10 @@ class AttributeAccessor : public SimpleRefCount<AttributeAccessor>
  * Most subclasses of this base class are implemented by the
  * ATTRIBUTE_HELPER_HEADER and ATTRIBUTE_HELPER_CPP macros.
  */
-class AttributeChecker : public SimpleRefCount<AttributeChecker>
+class AttributeChecker : public SimpleRefCount<AttributeChecker,
+                                               Empty,
+                                               DefaultDeleter<AttributeChecker>,
+                                               std::atomic<uint32_t>>
 {
   public:
     AttributeChecker();
@@ -18,13 +18,14 @@
  */
 #include "config.h"
 
+#include "abort.h"
 #include "global-value.h"
 #include "log.h"
 #include "names.h"
 #include "object-ptr-container.h"
 #include "object.h"
 #include "pointer.h"
-#include "singleton.h"
+#include "simulation-context.h"
 
 #include <sstream>
 
@@ -632,11 +633,19 @@ Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& contai
 
 /**
  * \ingroup config-impl
- * Config system implementation class.
+ * Config system implementation class, shared by the threads of the
+ * process; every replication of a SimulationContext has its own root
+ * namespace objects.
  */
-class ConfigImpl : public Singleton<ConfigImpl>
+class ConfigImpl
 {
   public:
+    /**
+     * Get the instance of the process, or of the calling replication.
+     * \return A pointer to the instance.
+     */
+    static ConfigImpl* Get();
+
     // Keep Set and SetFailSafe since their errors are triggered
     // by the underlying ObjectBase functions.
     /** \copydoc ns3::Config::Set() */
@@ -682,6 +691,14 @@ class ConfigImpl : public Singleton<ConfigImpl>
 
 }; // class ConfigImpl
 
+ConfigImpl*
+ConfigImpl::Get()
+{
+    static ConfigImpl config;
+    static thread_local ConfigImpl replicationConfig;
+    return SimulationContext::GetReplication() >= 0 ? &replicationConfig : &config;
+}
+
 void
 ConfigImpl::ParsePath(std::string path, std::string* root, std::string* leaf) const
 {
@@ -1002,6 +1019,262 @@ LookupMatches(std::string path)
     return ConfigImpl::Get()->LookupMatches(path);
 }
 
+PathMatcher::PathMatcher()
+    : m_nParameters(0),
+      m_names(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PathMatcher::PathMatcher(std::string path)
+    : m_path(path),
+      m_nParameters(0),
+      m_names(false)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    std::string::size_type start = 0;
+    while (start < path.size())
+    {
+        std::string::size_type end = path.find('/', start);
+        if (end == std::string::npos)
+        {
+            end = path.size();
+        }
+        if (end > start)
+        {
+            Segment segment;
+            segment.item = path.substr(start, end - start);
+            segment.getObject = false;
+            segment.parameter = -1;
+            segment.exact = false;
+            segment.index = 0;
+            if (segment.item == "{}")
+            {
+                segment.parameter = m_nParameters++;
+            }
+            else if (segment.item[0] == '$')
+            {
+                segment.getObject = true;
+                // an unknown type is left as an invalid TypeId, which
+                // matches nothing
+                TypeId::LookupByNameFailSafe(segment.item.substr(1), &segment.tid);
+            }
+            else if (segment.item.find_first_not_of("0123456789") == std::string::npos)
+            {
+                segment.exact = true;
+                segment.index = std::stoul(segment.item);
+            }
+            m_segments.push_back(segment);
+        }
+        start = end + 1;
+    }
+    m_names = !m_segments.empty() && m_segments.front().item == "Names";
+}
+
+std::string
+PathMatcher::GetPath() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_path;
+}
+
+std::size_t
+PathMatcher::GetNParameters() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_nParameters;
+}
+
+MatchContainer
+PathMatcher::Lookup(const std::vector<std::size_t>& indices) const
+{
+    NS_LOG_FUNCTION(this << indices.size());
+    NS_ABORT_MSG_IF(indices.size() != m_nParameters,
+                    "Path " << m_path << " expects " << m_nParameters << " indices, got "
+                            << indices.size());
+
+    if (m_names)
+    {
+        std::string path;
+        for (const auto& segment : m_segments)
+        {
+            path += "/";
+            path += segment.parameter < 0 ? segment.item
+                                          : std::to_string(indices[segment.parameter]);
+        }
+        return LookupMatches(path);
+    }
+
+    std::vector<Ptr<Object>> objects;
+    std::vector<std::string> contexts;
+    std::string context = "/";
+    for (std::size_t i = 0; i < GetRootNamespaceObjectN(); i++)
+    {
+        DoLookup(0, GetRootNamespaceObject(i), indices, context, objects, contexts);
+    }
+    return MatchContainer(objects, contexts, m_path);
+}
+
+const std::vector<PathMatcher::Step>&
+PathMatcher::GetSteps(const Segment& segment, TypeId tid) const
+{
+    NS_LOG_FUNCTION(this << segment.item << tid);
+
+    auto it = segment.steps.find(tid.GetUid());
+    if (it != segment.steps.end())
+    {
+        return it->second;
+    }
+
+    // same search as Resolver::DoResolve, done once per TypeId
+    std::vector<Step>& steps = segment.steps[tid.GetUid()];
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            if (info.name != segment.item && segment.item != "*")
+            {
+                continue;
+            }
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                steps.push_back({info.name, info.accessor, nullptr});
+            }
+            else if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                     nullptr)
+            {
+                const auto container =
+                    dynamic_cast<const ObjectPtrContainerAccessor*>(PeekPointer(info.accessor));
+                NS_ABORT_MSG_IF(container == nullptr,
+                                "Attribute " << info.name << " of " << tid.GetName()
+                                             << " has no object container accessor");
+                steps.push_back({info.name, info.accessor, container});
+            }
+        }
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+    return steps;
+}
+
+void
+PathMatcher::DoLookup(std::size_t s,
+                      Ptr<Object> object,
+                      const std::vector<std::size_t>& indices,
+                      std::string& context,
+                      std::vector<Ptr<Object>>& objects,
+                      std::vector<std::string>& contexts) const
+{
+    NS_LOG_FUNCTION(this << s << object << context);
+
+    if (s == m_segments.size())
+    {
+        objects.push_back(object);
+        contexts.push_back(context);
+        return;
+    }
+
+    const Segment& segment = m_segments[s];
+    std::string::size_type length = context.size();
+    if (segment.getObject)
+    {
+        if (segment.tid.GetUid() == 0)
+        {
+            return;
+        }
+        Ptr<Object> next = object->GetObject<Object>(segment.tid);
+        if (next)
+        {
+            context += segment.item + "/";
+            DoLookup(s + 1, next, indices, context, objects, contexts);
+            context.resize(length);
+        }
+        return;
+    }
+
+    for (const auto& step : GetSteps(segment, object->GetInstanceTypeId()))
+    {
+        context += step.name + "/";
+        if (step.container == nullptr)
+        {
+            PointerValue value;
+            step.accessor->Get(PeekPointer(object), value);
+            Ptr<Object> next = value.Get<Object>();
+            if (next)
+            {
+                DoLookup(s + 1, next, indices, context, objects, contexts);
+            }
+        }
+        else if (s + 1 < m_segments.size())
+        {
+            DoContainerLookup(s + 1, object, step, indices, context, objects, contexts);
+        }
+        context.resize(length);
+    }
+}
+
+void
+PathMatcher::DoContainerLookup(std::size_t s,
+                               Ptr<Object> object,
+                               const Step& step,
+                               const std::vector<std::size_t>& indices,
+                               std::string& context,
+                               std::vector<Ptr<Object>>& objects,
+                               std::vector<std::string>& contexts) const
+{
+    NS_LOG_FUNCTION(this << s << object << step.name << context);
+
+    std::size_t n;
+    if (!step.container->GetN(PeekPointer(object), &n))
+    {
+        return;
+    }
+
+    const Segment& segment = m_segments[s];
+    std::string::size_type length = context.size();
+    if (segment.exact || segment.parameter >= 0)
+    {
+        std::size_t wanted = segment.parameter < 0 ? segment.index : indices[segment.parameter];
+        std::size_t index;
+        Ptr<Object> next;
+        bool found = false;
+        // the containers are usually indexed by position, so try that first
+        if (wanted < n)
+        {
+            next = step.container->GetItem(PeekPointer(object), wanted, &index);
+            found = (index == wanted);
+        }
+        for (std::size_t i = 0; !found && i < n; i++)
+        {
+            next = step.container->GetItem(PeekPointer(object), i, &index);
+            found = (index == wanted);
+        }
+        if (found && next)
+        {
+            context += std::to_string(wanted) + "/";
+            DoLookup(s + 1, next, indices, context, objects, contexts);
+            context.resize(length);
+        }
+        return;
+    }
+
+    ArrayMatcher matcher(segment.item);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        std::size_t index;
+        Ptr<Object> next = step.container->GetItem(PeekPointer(object), i, &index);
+        if (next && matcher.Matches(index))
+        {
+            context += std::to_string(index) + "/";
+            DoLookup(s + 1, next, indices, context, objects, contexts);
+            context.resize(length);
+        }
+    }
+}
+
 void
 RegisterRootNamespaceObject(Ptr<Object> obj)
 {
@@ -20,7 +20,9 @@
 #define CONFIG_H
 
 #include "ptr.h"
+#include "type-id.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -36,6 +38,7 @@ namespace ns3
 class AttributeValue;
 class Object;
 class CallbackBase;
+class ObjectPtrContainerAccessor;
 
 /**
  * \ingroup core
@@ -361,6 +364,130 @@ class MatchContainer
  */
 MatchContainer LookupMatches(std::string path);
 
+/**
+ * \ingroup config
+ * A Config path compiled once and resolved many times.
+ *
+ * The path is split into its segments when the matcher is constructed,
+ * the TypeIds of the "$ns3::Type" segments are looked up at that time and
+ * the attributes matching every segment are looked up once per TypeId.
+ * The indices of the object containers ("/NodeList/3") are read one by
+ * one from the container, instead of copying the whole container as
+ * LookupMatches does, so the cost of a lookup does not grow with the
+ * number of nodes, devices or applications.
+ *
+ * A "{}" segment is a placeholder for a container index that is given
+ * when the path is resolved, so a single matcher serves all the paths
+ * that only differ in their indices:
+ * \code
+ *   Config::PathMatcher sinks("/NodeList/{}/ApplicationList/{}/$ns3::PacketSink");
+ *   sinks.Lookup({node, app}).ConnectWithoutContext("Rx", MakeCallback(&RxTrace));
+ * \endcode
+ *
+ * The other segments accept the same syntax as LookupMatches.  Names
+ * registered with ns3::Names are only resolved in paths that start with
+ * "/Names", and such paths are always resolved with LookupMatches.
+ */
+class PathMatcher
+{
+  public:
+    PathMatcher();
+    /**
+     * Compile a path.
+     *
+     * \param [in] path The object path, optionally with "{}" placeholders.
+     */
+    PathMatcher(std::string path);
+
+    /**
+     * \returns The compiled path.
+     */
+    std::string GetPath() const;
+    /**
+     * \returns The number of "{}" placeholders in the path.
+     */
+    std::size_t GetNParameters() const;
+
+    /**
+     * Resolve the path against the root namespace objects.
+     *
+     * \param [in] indices The values of the "{}" placeholders, in order.
+     * \returns A container which contains all the objects which match the path.
+     */
+    MatchContainer Lookup(const std::vector<std::size_t>& indices = {}) const;
+
+  private:
+    /** An attribute through which a segment of the path walks. */
+    struct Step
+    {
+        std::string name;                      //!< Attribute name
+        Ptr<const AttributeAccessor> accessor; //!< Attribute accessor
+        /** The accessor of an object container attribute, or nullptr for a pointer */
+        const ObjectPtrContainerAccessor* container;
+    };
+
+    /** A segment of the compiled path. */
+    struct Segment
+    {
+        std::string item;  //!< The text of the segment
+        bool getObject;    //!< Whether the segment is a "$ns3::Type" segment
+        TypeId tid;        //!< The TypeId of a "$ns3::Type" segment
+        int32_t parameter; //!< The placeholder number, or -1
+        bool exact;        //!< Whether the segment is a single container index
+        std::size_t index; //!< The container index of an exact segment
+        /** The attributes matching the segment, per TypeId uid */
+        mutable std::map<uint16_t, std::vector<Step>> steps;
+    };
+
+    /**
+     * Get the attributes of a TypeId (or its parents) matching a segment.
+     *
+     * \param [in] segment The segment.
+     * \param [in] tid The TypeId of the current object.
+     * \returns The matching pointer and object container attributes.
+     */
+    const std::vector<Step>& GetSteps(const Segment& segment, TypeId tid) const;
+    /**
+     * Resolve the path from an object.
+     *
+     * \param [in] s The next segment to resolve.
+     * \param [in] object The object reached by the previous segments.
+     * \param [in] indices The values of the placeholders.
+     * \param [in,out] context The path matched so far.
+     * \param [in,out] objects The matching objects.
+     * \param [in,out] contexts The matched paths of the objects.
+     */
+    void DoLookup(std::size_t s,
+                  Ptr<Object> object,
+                  const std::vector<std::size_t>& indices,
+                  std::string& context,
+                  std::vector<Ptr<Object>>& objects,
+                  std::vector<std::string>& contexts) const;
+    /**
+     * Resolve the path from an object container.
+     *
+     * \param [in] s The segment with the container indices.
+     * \param [in] object The object holding the container.
+     * \param [in] step The container attribute.
+     * \param [in] indices The values of the placeholders.
+     * \param [in,out] context The path matched so far.
+     * \param [in,out] objects The matching objects.
+     * \param [in,out] contexts The matched paths of the objects.
+     */
+    void DoContainerLookup(std::size_t s,
+                           Ptr<Object> object,
+                           const Step& step,
+                           const std::vector<std::size_t>& indices,
+                           std::string& context,
+                           std::vector<Ptr<Object>>& objects,
+                           std::vector<std::string>& contexts) const;
+
+    std::string m_path;              //!< The compiled path
+    std::vector<Segment> m_segments; //!< The segments of the path
+    std::size_t m_nParameters;       //!< The number of placeholders
+    bool m_names;                    //!< Whether the path is in the "/Names" namespace
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
@@ -23,6 +23,7 @@
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "uinteger.h"
 
 #include <cmath>
 
@@ -45,10 +46,18 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("ProfilingPeriod",
+                          "The average number of events per event profiled by an "
+                          "EventProfiler, or zero to disable the profiling.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::SetProfilingPeriod,
+                                               &DefaultSimulatorImpl::GetProfilingPeriod),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -83,6 +92,7 @@ DefaultSimulatorImpl::DoDispose()
         next.impl->Unref();
     }
     m_events = nullptr;
+    m_profiler = nullptr;
     SimulatorImpl::DoDispose();
 }
 
@@ -90,6 +100,10 @@ void
 DefaultSimulatorImpl::Destroy()
 {
     NS_LOG_FUNCTION(this);
+    if (m_profiler)
+    {
+        m_profiler->Report(TimeStep(m_currentTs), m_eventCount);
+    }
     while (!m_destroyEvents.empty())
     {
         Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
@@ -119,6 +133,34 @@ DefaultSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
     m_events = scheduler;
 }
 
+void
+DefaultSimulatorImpl::SetProfilingPeriod(uint32_t period)
+{
+    NS_LOG_FUNCTION(this << period);
+    if (period == 0)
+    {
+        m_profiler = nullptr;
+        return;
+    }
+    if (!m_profiler)
+    {
+        m_profiler = CreateObject<EventProfiler>();
+    }
+    m_profiler->SetPeriod(period);
+}
+
+uint32_t
+DefaultSimulatorImpl::GetProfilingPeriod() const
+{
+    return m_profiler ? m_profiler->GetPeriod() : 0;
+}
+
+Ptr<EventProfiler>
+DefaultSimulatorImpl::GetEventProfiler() const
+{
+    return m_profiler;
+}
+
 // System ID for non-distributed simulation is always zero
 uint32_t
 DefaultSimulatorImpl::GetSystemId() const
@@ -141,7 +183,14 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler)
+    {
+        m_profiler->Invoke(next.impl);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -191,6 +240,10 @@ DefaultSimulatorImpl::Run()
     m_mainThreadId = std::this_thread::get_id();
     ProcessEventsWithContext();
     m_stop = false;
+    if (m_profiler)
+    {
+        m_profiler->Start();
+    }
 
     while (!m_events->IsEmpty() && !m_stop)
     {
@@ -20,6 +20,7 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
 #include "simulator-impl.h"
 
 #include <list>
@@ -42,6 +43,9 @@ class Scheduler;
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * With a ProfilingPeriod, the events are run through an EventProfiler,
+ * which prints its report at Simulator::Destroy.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -78,9 +82,27 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
 
+    /**
+     * Get the event profiler.
+     * \return the profiler, or null if the ProfilingPeriod is zero
+     */
+    Ptr<EventProfiler> GetEventProfiler() const;
+
   private:
     void DoDispose() override;
 
+    /**
+     * Set the ProfilingPeriod: create or remove the profiler.
+     * \param [in] period the average number of events per profiled event,
+     *             or zero to disable the profiling
+     */
+    void SetProfilingPeriod(uint32_t period);
+    /**
+     * Get the ProfilingPeriod.
+     * \return the average number of events per profiled event, or zero
+     */
+    uint32_t GetProfilingPeriod() const;
+
     /** Process the next event. */
     void ProcessOneEvent();
     /** Move events from a different context into the main event queue. */
@@ -136,6 +158,9 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** The event profiler, if enabled. */
+    Ptr<EventProfiler> m_profiler;
 };
 
 } // namespace ns3
@@ -67,4 +67,10 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+const void*
+EventImpl::PeekFunction() const
+{
+    return nullptr;
+}
+
 } // namespace ns3
@@ -66,6 +66,14 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * Checked by the simulation engine before calling Invoke().
      */
     bool IsCancelled();
+    /**
+     * \returns The code of the function or class method invoked by the
+     * event, or nullptr if unknown.
+     *
+     * The EventProfiler attributes the events to this function, and to
+     * the type of the event.
+     */
+    virtual const void* PeekFunction() const;
 
   protected:
     /**
@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+
+#include "abort.h"
+#include "log.h"
+#include "string.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__GNUC__) && !defined(_WIN32)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#define NS3_EVENT_PROFILER_SYMBOLS
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+NS_OBJECT_ENSURE_REGISTERED(EventProfiler);
+
+namespace
+{
+
+/**
+ * \ingroup simulator
+ * The counters registered with EventProfiler::AddCounter, by name.
+ * \return the counters
+ */
+std::vector<std::pair<std::string, std::vector<EventProfiler::Counter>>>&
+GetCounters()
+{
+    static std::vector<std::pair<std::string, std::vector<EventProfiler::Counter>>> counters;
+    return counters;
+}
+
+/**
+ * \ingroup simulator
+ * Demangle a symbol or type name.
+ * \param [in] mangled the mangled name
+ * \return the demangled name, or \p mangled if it cannot be demangled
+ */
+std::string
+Demangle(const char* mangled)
+{
+#ifdef NS3_EVENT_PROFILER_SYMBOLS
+    int status;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status == 0 && demangled)
+    {
+        std::string name(demangled);
+        std::free(demangled);
+        return name;
+    }
+    std::free(demangled);
+#endif
+    return mangled;
+}
+
+} // unnamed namespace
+
+TypeId
+EventProfiler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::EventProfiler")
+            .SetParent<Object>()
+            .SetGroupName("Core")
+            .AddConstructor<EventProfiler>()
+            .AddAttribute("TopN",
+                          "The number of targets in the report.",
+                          UintegerValue(20),
+                          MakeUintegerAccessor(&EventProfiler::m_topN),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("OutputFile",
+                          "The file of the report. If empty, it is printed to std::clog.",
+                          StringValue(""),
+                          MakeStringAccessor(&EventProfiler::m_outputFile),
+                          MakeStringChecker());
+    return tid;
+}
+
+EventProfiler::EventProfiler()
+    : m_period(1),
+      m_countdown(1),
+      m_random(0x9e3779b97f4a7c15ULL),
+      m_started(false),
+      m_sampled(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+EventProfiler::~EventProfiler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+EventProfiler::AddCounter(const std::string& name, Counter counter)
+{
+    auto& counters = GetCounters();
+    auto it = std::find_if(counters.begin(), counters.end(), [&name](const auto& entry) {
+        return entry.first == name;
+    });
+    if (it == counters.end())
+    {
+        counters.emplace_back(name, std::vector<Counter>{counter});
+    }
+    else
+    {
+        it->second.push_back(counter);
+    }
+}
+
+void
+EventProfiler::SetPeriod(uint32_t period)
+{
+    NS_LOG_FUNCTION(this << period);
+    NS_ABORT_MSG_IF(period == 0, "The profiling period must be at least one event");
+    m_period = period;
+    m_countdown = NextGap();
+}
+
+uint32_t
+EventProfiler::GetPeriod() const
+{
+    return m_period;
+}
+
+void
+EventProfiler::Start()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_started)
+    {
+        m_started = true;
+        m_start = std::chrono::steady_clock::now();
+        m_startCounters = ReadCounters();
+    }
+}
+
+uint32_t
+EventProfiler::NextGap()
+{
+    // xorshift64, so that the random variables of the simulation do not change
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 7;
+    m_random ^= m_random << 17;
+    return 1 + m_random % (2 * static_cast<uint64_t>(m_period) - 1);
+}
+
+std::vector<uint64_t>
+EventProfiler::ReadCounters() const
+{
+    const auto& counters = GetCounters();
+    std::vector<uint64_t> values(counters.size(), 0);
+    for (std::size_t i = 0; i < counters.size(); i++)
+    {
+        for (const auto counter : counters[i].second)
+        {
+            values[i] += counter();
+        }
+    }
+    return values;
+}
+
+void
+EventProfiler::Profile(EventImpl* event)
+{
+    if (event->IsCancelled())
+    {
+        // nothing to measure: profile the next event
+        m_countdown = 1;
+        event->Invoke();
+        return;
+    }
+    m_countdown = NextGap();
+    Key key(typeid(*event), event->PeekFunction());
+
+    std::vector<uint64_t> before = ReadCounters();
+    auto start = std::chrono::steady_clock::now();
+    event->Invoke();
+    auto end = std::chrono::steady_clock::now();
+    std::vector<uint64_t> after = ReadCounters();
+
+    Samples& samples = m_targets[key];
+    samples.events++;
+    samples.time += end - start;
+    samples.counters.resize(after.size(), 0);
+    for (std::size_t i = 0; i < after.size(); i++)
+    {
+        samples.counters[i] += after[i] - before[i];
+    }
+    m_sampled++;
+}
+
+std::string
+EventProfiler::GetTargetName(const std::type_index& type, const void* function)
+{
+#ifdef NS3_EVENT_PROFILER_SYMBOLS
+    Dl_info info;
+    // dladdr finds the closest symbol: check that it is the function
+    if (function && dladdr(function, &info) != 0 && info.dli_sname && info.dli_saddr == function)
+    {
+        return Demangle(info.dli_sname);
+    }
+#endif
+    std::string name = Demangle(type.name());
+    // keep the template arguments of MakeEvent, which give the target
+    std::size_t begin = name.find("MakeEvent<");
+    if (begin != std::string::npos)
+    {
+        std::size_t end = name.find(">(", begin);
+        if (end != std::string::npos)
+        {
+            name = name.substr(begin, end + 1 - begin);
+        }
+    }
+    if (function)
+    {
+        std::ostringstream oss;
+        oss << name << " at " << function;
+        name = oss.str();
+    }
+    return name;
+}
+
+std::vector<std::string>
+EventProfiler::GetCounterNames() const
+{
+    std::vector<std::string> names;
+    for (const auto& counter : GetCounters())
+    {
+        names.push_back(counter.first);
+    }
+    return names;
+}
+
+std::vector<EventProfiler::Target>
+EventProfiler::GetTargets() const
+{
+    // targets of different types may resolve to the same function
+    std::vector<Target> targets;
+    for (const auto& [key, samples] : m_targets)
+    {
+        std::string name = GetTargetName(key.first, key.second);
+        auto it = std::find_if(targets.begin(), targets.end(), [&name](const Target& target) {
+            return target.name == name;
+        });
+        if (it == targets.end())
+        {
+            targets.push_back(Target{name, 0, 0, 0, {}});
+            it = targets.end() - 1;
+        }
+        it->sampled += samples.events;
+        it->seconds += std::chrono::duration<double>(samples.time).count();
+        it->perEvent.resize(samples.counters.size(), 0);
+        for (std::size_t i = 0; i < samples.counters.size(); i++)
+        {
+            it->perEvent[i] += samples.counters[i];
+        }
+    }
+    for (auto& target : targets)
+    {
+        target.events = target.sampled * m_period;
+        target.seconds *= m_period;
+        for (auto& value : target.perEvent)
+        {
+            value /= target.sampled;
+        }
+    }
+    std::sort(targets.begin(), targets.end(), [](const Target& a, const Target& b) {
+        return a.seconds > b.seconds;
+    });
+    return targets;
+}
+
+uint64_t
+EventProfiler::GetSampledEvents() const
+{
+    return m_sampled;
+}
+
+void
+EventProfiler::Report(std::ostream& os, Time now, uint64_t events) const
+{
+    double wall = 0;
+    std::vector<uint64_t> counters = ReadCounters();
+    if (m_started)
+    {
+        wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+        for (std::size_t i = 0; i < m_startCounters.size(); i++)
+        {
+            counters[i] -= m_startCounters[i];
+        }
+    }
+    std::vector<std::string> names = GetCounterNames();
+    std::vector<Target> targets = GetTargets();
+    double sampledSeconds = 0;
+    for (const auto& target : targets)
+    {
+        sampledSeconds += target.seconds;
+    }
+
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::setprecision(4);
+    os << "Event profile: " << events << " events, " << now.GetSeconds() << " s simulated, "
+       << wall << " s wall clock" << std::endl;
+    if (now.IsStrictlyPositive())
+    {
+        os << "  " << events / now.GetSeconds() << " events per simulated second" << std::endl;
+    }
+    if (wall > 0)
+    {
+        os << "  " << events / wall << " events per wall clock second" << std::endl;
+    }
+    for (std::size_t i = 0; i < names.size(); i++)
+    {
+        os << "  " << names[i] << ": " << counters[i];
+        if (counters[i] > 0)
+        {
+            os << " (" << static_cast<double>(events) / counters[i] << " events each)";
+        }
+        os << std::endl;
+    }
+    os << "  " << m_sampled << " events profiled, one in " << m_period << " on average"
+       << std::endl;
+
+    os << std::setw(8) << "time%" << std::setw(12) << "events" << std::setw(10) << "ns/event";
+    for (const auto& name : names)
+    {
+        os << "  " << name << "/event";
+    }
+    os << "  target" << std::endl;
+    for (std::size_t i = 0; i < targets.size() && i < m_topN; i++)
+    {
+        const Target& target = targets[i];
+        os << std::setw(8) << std::fixed << std::setprecision(2)
+           << 100 * target.seconds / sampledSeconds << std::setw(12) << target.events
+           << std::setw(10) << std::setprecision(0) << 1e9 * target.seconds / target.events;
+        os << std::setprecision(3);
+        for (std::size_t k = 0; k < names.size(); k++)
+        {
+            os << std::setw(names[k].size() + 8) << target.perEvent[k];
+        }
+        os << "  " << target.name << std::endl;
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void
+EventProfiler::Report(Time now, uint64_t events) const
+{
+    NS_LOG_FUNCTION(this << now << events);
+    if (m_sampled == 0)
+    {
+        return;
+    }
+    if (m_outputFile.empty())
+    {
+        Report(std::clog, now, events);
+        return;
+    }
+    std::ofstream os(m_outputFile);
+    NS_ABORT_MSG_UNLESS(os.is_open(), "Cannot open the event profile file " << m_outputFile);
+    Report(os, now, events);
+}
+
+} // namespace ns3
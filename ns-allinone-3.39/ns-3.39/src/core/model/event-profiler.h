@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include "event-impl.h"
+#include "nstime.h"
+#include "object.h"
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Attribute the executed events and their wall clock time to the
+ * functions they invoke.
+ *
+ * The DefaultSimulatorImpl runs its events through an EventProfiler when
+ * its ProfilingPeriod attribute is not zero, for instance with
+ * \c --ns3::DefaultSimulatorImpl::ProfilingPeriod=100 on the command line
+ * or in \c NS_ATTRIBUTE_DEFAULT, and prints the report when the simulator
+ * is destroyed.  Without profiling, the simulator only tests a null pointer
+ * per event.
+ *
+ * One event in ProfilingPeriod, on average, is profiled: its wall clock
+ * time and the changes of the counters (see AddCounter) while it runs are
+ * attributed to its target, the function or class method the event
+ * invokes (see EventImpl::PeekFunction), or the type of the event if the
+ * function is unknown (lambdas and timers).  The gaps between the
+ * profiled events are drawn uniformly, so that periodic events do not
+ * bias the sample, from a generator of the profiler, so that the random
+ * variables of the simulation do not change.  The events and time per
+ * target are estimated by scaling the sample by the period.
+ *
+ * The report gives the total events, the events per simulated second and
+ * per unit of each counter (e.g., per packet delivered), and the targets
+ * with the most wall clock time.
+ */
+class EventProfiler : public Object
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    EventProfiler();
+    ~EventProfiler() override;
+
+    /**
+     * A counter of the simulation, such as the packets created, read
+     * before and after the profiled events.
+     * \return the value of the counter in the simulation of the calling thread
+     */
+    typedef uint64_t (*Counter)();
+
+    /**
+     * Register a counter, usually from a static initializer of a module.
+     * The counters with the same name are added.
+     * \param [in] name the name of the counter, e.g., "packets created"
+     * \param [in] counter the function returning its value
+     */
+    static void AddCounter(const std::string& name, Counter counter);
+
+    /**
+     * Register a counter when constructed, for a module to register its
+     * counters from a static variable, e.g.,
+     * \code
+     *   static EventProfiler::CounterRegistration g_counter("packets created",
+     *                                                       &Packet::GetNPacketsCreated);
+     * \endcode
+     */
+    class CounterRegistration
+    {
+      public:
+        /**
+         * Register a counter (see AddCounter).
+         * \param [in] name the name of the counter
+         * \param [in] counter the function returning its value
+         */
+        CounterRegistration(const std::string& name, Counter counter)
+        {
+            AddCounter(name, counter);
+        }
+    };
+
+    /// The profile of a target
+    struct Target
+    {
+        std::string name;      //!< Function, class method or event type
+        uint64_t events;       //!< Estimated events
+        double seconds;        //!< Estimated wall clock time
+        uint64_t sampled;      //!< Profiled events
+        std::vector<double> perEvent; //!< Mean change of each counter per event
+    };
+
+    /**
+     * Set the average number of events per profiled event.
+     * \param [in] period the period, at least one
+     */
+    void SetPeriod(uint32_t period);
+
+    /// \return the average number of events per profiled event
+    uint32_t GetPeriod() const;
+
+    /// Start measuring the wall clock time and the counters, if not started
+    void Start();
+
+    /**
+     * Run an event, profiling it if it is its turn.
+     * \param [in] event the event
+     */
+    void Invoke(EventImpl* event);
+
+    /// \return the names of the counters
+    std::vector<std::string> GetCounterNames() const;
+
+    /// \return the targets, by decreasing wall clock time
+    std::vector<Target> GetTargets() const;
+
+    /// \return the profiled events
+    uint64_t GetSampledEvents() const;
+
+    /**
+     * Print the report.
+     * \param [in,out] os the output stream
+     * \param [in] now the simulation time
+     * \param [in] events the events executed by the simulator
+     */
+    void Report(std::ostream& os, Time now, uint64_t events) const;
+
+    /**
+     * Print the report to the OutputFile, or to std::clog, if an event was
+     * profiled.
+     * \param [in] now the simulation time
+     * \param [in] events the events executed by the simulator
+     */
+    void Report(Time now, uint64_t events) const;
+
+  private:
+    /**
+     * Profile an event.
+     * \param [in] event the event
+     */
+    void Profile(EventImpl* event);
+
+    /// \return the gap to the next profiled event
+    uint32_t NextGap();
+
+    /**
+     * \param [in] type the type of the event
+     * \param [in] function the function invoked by the event
+     * \return the name of the target
+     */
+    static std::string GetTargetName(const std::type_index& type, const void* function);
+
+    /// \return the values of the counters
+    std::vector<uint64_t> ReadCounters() const;
+
+    /// Target of an event: the type of the event and the function it invokes
+    typedef std::pair<std::type_index, const void*> Key;
+
+    /// Hash of a Key
+    struct KeyHash
+    {
+        /**
+         * \param [in] key the key
+         * \return the hash of the key
+         */
+        std::size_t operator()(const Key& key) const
+        {
+            return key.first.hash_code() ^ std::hash<const void*>()(key.second);
+        }
+    };
+
+    /// Statistics of the profiled events of a target
+    struct Samples
+    {
+        uint64_t events{0};               //!< Profiled events
+        std::chrono::nanoseconds time{0}; //!< Wall clock time
+        std::vector<uint64_t> counters;   //!< Change of the counters
+    };
+
+    uint32_t m_period;                                  //!< Events per profiled event
+    uint32_t m_countdown;                               //!< Events to the next profiled one
+    uint64_t m_random;                                  //!< State of the gap generator
+    uint32_t m_topN;                                    //!< Targets in the report
+    std::string m_outputFile;                           //!< Report file
+    bool m_started;                                     //!< Start was called
+    std::chrono::steady_clock::time_point m_start;      //!< Wall clock start
+    std::vector<uint64_t> m_startCounters;              //!< Counters at the start
+    std::unordered_map<Key, Samples, KeyHash> m_targets; //!< Samples per target
+    uint64_t m_sampled;                                 //!< Profiled events
+};
+
+/*************************************************
+ **  Inline implementations
+ ************************************************/
+
+inline void
+EventProfiler::Invoke(EventImpl* event)
+{
+    if (--m_countdown != 0)
+    {
+        event->Invoke();
+        return;
+    }
+    Profile(event);
+}
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
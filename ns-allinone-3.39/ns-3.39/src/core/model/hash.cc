@@ -35,7 +35,7 @@ NS_LOG_COMPONENT_DEFINE("Hash");
 Hasher&
 GetStaticHash()
 {
-    static Hasher g_hasher = Hasher();
+    static thread_local Hasher g_hasher = Hasher();
     g_hasher.clear();
     return g_hasher;
 }
@@ -21,6 +21,7 @@
 #include "assert.h"
 #include "environment-variable.h"
 #include "fatal-error.h"
+#include "simulation-context.h"
 #include "string.h"
 
 #include "ns3/core-config.h"
@@ -114,6 +115,18 @@ static TimePrinter g_logTimePrinter = nullptr;
  * The Log NodePrinter.
  */
 static NodePrinter g_logNodePrinter = nullptr;
+/**
+ * \ingroup logging
+ * The Log TimePrinter of the simulator of a replication of a
+ * SimulationContext, which runs in its own thread.
+ */
+static thread_local TimePrinter g_replicationTimePrinter = nullptr;
+/**
+ * \ingroup logging
+ * The Log NodePrinter of the simulator of a replication of a
+ * SimulationContext.
+ */
+static thread_local NodePrinter g_replicationNodePrinter = nullptr;
 
 /**
  * \ingroup logging
@@ -495,7 +508,8 @@ CheckEnvironmentVariables()
 void
 LogSetTimePrinter(TimePrinter printer)
 {
-    g_logTimePrinter = printer;
+    (SimulationContext::GetReplication() >= 0 ? g_replicationTimePrinter : g_logTimePrinter) =
+        printer;
     /** \internal
      *  This is the only place where we are more or less sure that all log variables
      * are registered. See \bugid{1082} for details.
@@ -506,19 +520,22 @@ LogSetTimePrinter(TimePrinter printer)
 TimePrinter
 LogGetTimePrinter()
 {
-    return g_logTimePrinter;
+    return SimulationContext::GetReplication() >= 0 ? g_replicationTimePrinter
+                                                    : g_logTimePrinter;
 }
 
 void
 LogSetNodePrinter(NodePrinter printer)
 {
-    g_logNodePrinter = printer;
+    (SimulationContext::GetReplication() >= 0 ? g_replicationNodePrinter : g_logNodePrinter) =
+        printer;
 }
 
 NodePrinter
 LogGetNodePrinter()
 {
-    return g_logNodePrinter;
+    return SimulationContext::GetReplication() >= 0 ? g_replicationNodePrinter
+                                                    : g_logNodePrinter;
 }
 
 ParameterLogger::ParameterLogger(std::ostream& os)
@@ -353,6 +353,9 @@ EventImpl* MakeEvent(T function);
 #include "event-impl.h"
 #include "type-traits.h"
 
+#include <cstdint>
+#include <cstring>
+
 namespace ns3
 {
 
@@ -392,6 +395,49 @@ struct EventMemberImplObjTraits<T*>
     }
 };
 
+/**
+ * \ingroup makeeventmemptr
+ * Get the code of the class method invoked by an event, to profile it.
+ *
+ * With the Itanium C++ ABI of GCC and Clang, a pointer to a class method
+ * holds the address of the code of a non-virtual method, or one plus the
+ * offset of a virtual method in the virtual table, and the adjustment of
+ * the object pointer.
+ *
+ * \tparam T \deduced The class type.
+ * \tparam MEM \deduced The class method function signature.
+ * \param [in] obj The object the method is invoked on.
+ * \param [in] function The class method.
+ * \return The code of the method, or nullptr with another ABI.
+ */
+template <typename T, typename MEM>
+const void*
+PeekMemberFunction(const T& obj, MEM function)
+{
+#if defined(__GNUC__) && !defined(__arm__) && !defined(__aarch64__)
+    struct
+    {
+        std::uintptr_t ptr;  //!< Code, or one plus the virtual table offset
+        std::ptrdiff_t adj;  //!< Adjustment of the object pointer
+    } pmf;
+
+    if (sizeof(function) != sizeof(pmf))
+    {
+        return nullptr;
+    }
+    std::memcpy(&pmf, &function, sizeof(pmf));
+    if ((pmf.ptr & 1) == 0)
+    {
+        return reinterpret_cast<const void*>(pmf.ptr);
+    }
+    const char* self = reinterpret_cast<const char*>(&obj) + pmf.adj;
+    const char* vtable = *reinterpret_cast<const char* const*>(self);
+    return *reinterpret_cast<const void* const*>(vtable + pmf.ptr - 1);
+#else
+    return nullptr;
+#endif
+}
+
 template <typename MEM, typename OBJ>
 EventImpl*
 MakeEvent(MEM mem_ptr, OBJ obj)
@@ -416,6 +462,12 @@ MakeEvent(MEM mem_ptr, OBJ obj)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)();
         }
 
+        const void* PeekFunction() const override
+        {
+            return PeekMemberFunction(EventMemberImplObjTraits<OBJ>::GetReference(m_obj),
+                                      m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
     }* ev = new EventMemberImpl0(obj, mem_ptr);
@@ -449,6 +501,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)(m_a1);
         }
 
+        const void* PeekFunction() const override
+        {
+            return PeekMemberFunction(EventMemberImplObjTraits<OBJ>::GetReference(m_obj),
+                                      m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -484,6 +542,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)(m_a1, m_a2);
         }
 
+        const void* PeekFunction() const override
+        {
+            return PeekMemberFunction(EventMemberImplObjTraits<OBJ>::GetReference(m_obj),
+                                      m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -521,6 +585,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)(m_a1, m_a2, m_a3);
         }
 
+        const void* PeekFunction() const override
+        {
+            return PeekMemberFunction(EventMemberImplObjTraits<OBJ>::GetReference(m_obj),
+                                      m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -561,6 +631,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
              m_function)(m_a1, m_a2, m_a3, m_a4);
         }
 
+        const void* PeekFunction() const override
+        {
+            return PeekMemberFunction(EventMemberImplObjTraits<OBJ>::GetReference(m_obj),
+                                      m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -609,6 +685,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
              m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
         }
 
+        const void* PeekFunction() const override
+        {
+            return PeekMemberFunction(EventMemberImplObjTraits<OBJ>::GetReference(m_obj),
+                                      m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -660,6 +742,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)
              m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
         }
 
+        const void* PeekFunction() const override
+        {
+            return PeekMemberFunction(EventMemberImplObjTraits<OBJ>::GetReference(m_obj),
+                                      m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -700,6 +788,11 @@ MakeEvent(void (*f)(U1), T1 a1)
             (*m_function)(m_a1);
         }
 
+        const void* PeekFunction() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
     }* ev = new EventFunctionImpl1(f, a1);
@@ -735,6 +828,11 @@ MakeEvent(void (*f)(U1, U2), T1 a1, T2 a2)
             (*m_function)(m_a1, m_a2);
         }
 
+        const void* PeekFunction() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -772,6 +870,11 @@ MakeEvent(void (*f)(U1, U2, U3), T1 a1, T2 a2, T3 a3)
             (*m_function)(m_a1, m_a2, m_a3);
         }
 
+        const void* PeekFunction() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -818,6 +921,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4), T1 a1, T2 a2, T3 a3, T4 a4)
             (*m_function)(m_a1, m_a2, m_a3, m_a4);
         }
 
+        const void* PeekFunction() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -868,6 +976,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4, U5), T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
             (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
         }
 
+        const void* PeekFunction() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -922,6 +1035,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4, U5, U6), T1 a1, T2 a2, T3 a3, T4 a4, T5 a5,
             (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
         }
 
+        const void* PeekFunction() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
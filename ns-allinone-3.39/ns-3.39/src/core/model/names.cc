@@ -21,7 +21,7 @@
 #include "assert.h"
 #include "log.h"
 #include "object.h"
-#include "singleton.h"
+#include "simulation-context.h"
 
 #include <map>
 
@@ -121,15 +121,22 @@ NameNode::~NameNode()
 
 /**
  * \ingroup config
- * The singleton root Names object.
+ * The singleton root Names object, shared by the threads of the process;
+ * every replication of a SimulationContext has its own names.
  */
-class NamesPriv : public Singleton<NamesPriv>
+class NamesPriv
 {
   public:
     /** Constructor. */
     NamesPriv();
     /** Destructor. */
-    ~NamesPriv() override;
+    ~NamesPriv();
+
+    /**
+     * Get the instance of the process, or of the calling replication.
+     * \return A pointer to the instance.
+     */
+    static NamesPriv* Get();
 
     // Doxygen \copydoc bug: won't copy these docs, so we repeat them.
 
@@ -295,6 +302,14 @@ NamesPriv::~NamesPriv()
     m_root.m_name = "";
 }
 
+NamesPriv*
+NamesPriv::Get()
+{
+    static NamesPriv names;
+    static thread_local NamesPriv replicationNames;
+    return SimulationContext::GetReplication() >= 0 ? &replicationNames : &names;
+}
+
 void
 NamesPriv::Clear()
 {
@@ -733,10 +733,11 @@ class Time
      * \cond HIDE_FROM_DOXYGEN
      * Doxygen bug throws a warning here, so hide from Doxygen.
      *
-     * Friend the Simulator class so it can call the private function
-     * ClearMarkedTimes ()
+     * Friend the Simulator and SimulationContext classes so they can call
+     * the private function ClearMarkedTimes ()
      */
     friend class Simulator;
+    friend class SimulationContext;
     /** \endcond */
 
     /**
@@ -150,4 +150,20 @@ ObjectPtrContainerAccessor::HasSetter() const
     return false;
 }
 
+bool
+ObjectPtrContainerAccessor::GetN(const ObjectBase* object, std::size_t* n) const
+{
+    NS_LOG_FUNCTION(this << object << n);
+    return DoGetN(object, n);
+}
+
+Ptr<Object>
+ObjectPtrContainerAccessor::GetItem(const ObjectBase* object,
+                                    std::size_t i,
+                                    std::size_t* index) const
+{
+    NS_LOG_FUNCTION(this << object << i << index);
+    return DoGet(object, i, index);
+}
+
 } // namespace ns3
@@ -233,6 +233,27 @@ class ObjectPtrContainerAccessor : public AttributeAccessor
     bool HasGetter() const override;
     bool HasSetter() const override;
 
+    /**
+     * Get the number of instances in the container.
+     *
+     * Unlike Get(), this does not copy the whole container into
+     * an ObjectPtrContainerValue.
+     *
+     * \param [in] object The container object.
+     * \param [out] n The number of instances in the container.
+     * \returns true if the value could be obtained successfully.
+     */
+    bool GetN(const ObjectBase* object, std::size_t* n) const;
+    /**
+     * Get a single instance from the container, identified by its position.
+     *
+     * \param [in] object The container object.
+     * \param [in] i The position of the instance, in [0, n).
+     * \param [out] index The index of the instance in the container.
+     * \returns The instance.
+     */
+    Ptr<Object> GetItem(const ObjectBase* object, std::size_t i, std::size_t* index) const;
+
   private:
     /**
      * Get the number of instances in the container.
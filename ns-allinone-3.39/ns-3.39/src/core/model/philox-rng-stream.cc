@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "philox-rng-stream.h"
+
+#include "abort.h"
+#include "log.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup rngimpl
+ * ns3::PhiloxRngStream implementation.
+ */
+
+namespace ns3
+{
+
+// As in rng-stream.cc, logging is avoided in the functions that generate
+// the random numbers
+NS_LOG_COMPONENT_DEFINE("PhiloxRngStream");
+
+namespace
+{
+
+/** Multiplier of the first and second words. */
+const uint32_t PHILOX_M0 = 0xD2511F53;
+/** Multiplier of the third and fourth words. */
+const uint32_t PHILOX_M1 = 0xCD9E8D57;
+/** Weyl sequence increment of the first word of the key. */
+const uint32_t PHILOX_W0 = 0x9E3779B9;
+/** Weyl sequence increment of the second word of the key. */
+const uint32_t PHILOX_W1 = 0xBB67AE85;
+/** Number of rounds. */
+const int PHILOX_ROUNDS = 10;
+
+/**
+ * One round of Philox4x32.
+ *
+ * \param [in,out] c0 The first word of the counter.
+ * \param [in,out] c1 The second word of the counter.
+ * \param [in,out] c2 The third word of the counter.
+ * \param [in,out] c3 The fourth word of the counter.
+ * \param [in] k0 The first word of the round key.
+ * \param [in] k1 The second word of the round key.
+ */
+inline void
+PhiloxRound(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint32_t k0, uint32_t k1)
+{
+    uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0;
+    uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2;
+    uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+    c1 = static_cast<uint32_t>(p1);
+    c3 = static_cast<uint32_t>(p0);
+    c0 = n0;
+    c2 = n2;
+}
+
+/**
+ * Convert two random words into a uniform in (0, 1).
+ *
+ * \param [in] hi The high word.
+ * \param [in] lo The low word.
+ * \returns A multiple of 2<sup>-53</sup> plus 2<sup>-54</sup>.
+ */
+inline double
+ToU01(uint32_t hi, uint32_t lo)
+{
+    uint64_t x = (static_cast<uint64_t>(hi) << 32) | lo;
+    return (static_cast<double>(x >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+} // namespace
+
+PhiloxRngStream::PhiloxRngStream(uint32_t seed, uint64_t stream, uint64_t substream)
+    : m_counter(0),
+      m_next(BUFFER_SIZE)
+{
+    NS_LOG_FUNCTION(this << seed << stream << substream);
+    m_key[0] = seed;
+    NS_ABORT_MSG_IF(substream >> 32,
+                    "The run number " << substream << " of a Philox4x32 stream must be below 2^32");
+    m_key[1] = static_cast<uint32_t>(substream);
+    m_stream[0] = static_cast<uint32_t>(stream);
+    m_stream[1] = static_cast<uint32_t>(stream >> 32);
+}
+
+void
+PhiloxRngStream::Philox4x32(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4])
+{
+    uint32_t c0 = ctr[0];
+    uint32_t c1 = ctr[1];
+    uint32_t c2 = ctr[2];
+    uint32_t c3 = ctr[3];
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+    for (int r = 0; r < PHILOX_ROUNDS; r++)
+    {
+        PhiloxRound(c0, c1, c2, c3, k0, k1);
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+void
+PhiloxRngStream::Generate(double* u, std::size_t n)
+{
+    for (std::size_t base = 0; base < n; base += 2 * LANES)
+    {
+        // structure of arrays, so that the rounds of the LANES counters
+        // are computed by the same vector instructions
+        uint32_t c0[LANES];
+        uint32_t c1[LANES];
+        uint32_t c2[LANES];
+        uint32_t c3[LANES];
+        for (std::size_t l = 0; l < LANES; l++)
+        {
+            uint64_t counter = m_counter + l;
+            c0[l] = static_cast<uint32_t>(counter);
+            c1[l] = static_cast<uint32_t>(counter >> 32);
+            c2[l] = m_stream[0];
+            c3[l] = m_stream[1];
+        }
+        uint32_t k0 = m_key[0];
+        uint32_t k1 = m_key[1];
+        for (int r = 0; r < PHILOX_ROUNDS; r++)
+        {
+            for (std::size_t l = 0; l < LANES; l++)
+            {
+                PhiloxRound(c0[l], c1[l], c2[l], c3[l], k0, k1);
+            }
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+        for (std::size_t l = 0; l < LANES; l++)
+        {
+            u[base + 2 * l] = ToU01(c0[l], c1[l]);
+            u[base + 2 * l + 1] = ToU01(c2[l], c3[l]);
+        }
+        m_counter += LANES;
+    }
+}
+
+void
+PhiloxRngStream::Refill()
+{
+    Generate(m_buffer, BUFFER_SIZE);
+    m_next = 0;
+}
+
+void
+PhiloxRngStream::RandU01(double* u, std::size_t n)
+{
+    // first the buffered numbers, so that the sequence is the same as
+    // with n calls to RandU01()
+    std::size_t buffered = std::min(n, BUFFER_SIZE - m_next);
+    std::copy(m_buffer + m_next, m_buffer + m_next + buffered, u);
+    m_next += buffered;
+    u += buffered;
+    n -= buffered;
+
+    std::size_t direct = n - n % (2 * LANES);
+    Generate(u, direct);
+    for (std::size_t i = direct; i < n; i++)
+    {
+        u[i] = RandU01();
+    }
+}
+
+} // namespace ns3
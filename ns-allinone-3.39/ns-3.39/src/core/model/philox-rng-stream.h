@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PHILOX_RNG_STREAM_H
+#define PHILOX_RNG_STREAM_H
+
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup rngimpl
+ * ns3::PhiloxRngStream declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup rngimpl
+ *
+ * \brief Counter-based generator Philox4x32-10
+ *
+ * The Philox4x32-10 generator of Salmon et al., "Parallel random numbers:
+ * as easy as 1, 2, 3" (SC'11), produces four 32 bit words from a 128 bit
+ * counter and a 64 bit key, so that any element of a stream can be computed
+ * independently.  The key is made of the seed and the run number, and the
+ * two high words of the counter hold the stream number, so every
+ * (seed, run, stream) triple has its own sequence of 2<sup>64</sup> blocks.
+ * As the key has a single word for the run, the run number must be below
+ * 2<sup>32</sup>.
+ *
+ * Each block gives two uniforms of 53 bits in (0, 1).  The blocks are
+ * computed for several counters at a time, in loops that the compiler can
+ * vectorize, and the uniforms are buffered.  Drawing n uniforms with
+ * RandU01(double*, std::size_t) returns the same values as n calls to
+ * RandU01().
+ */
+class PhiloxRngStream
+{
+  public:
+    /**
+     * Construct from explicit seed, stream and substream values.
+     *
+     * \param [in] seed The starting seed.
+     * \param [in] stream The stream number.
+     * \param [in] substream The sub-stream (run) number, below 2<sup>32</sup>.
+     */
+    PhiloxRngStream(uint32_t seed, uint64_t stream, uint64_t substream);
+
+    /**
+     * Generate the next random number for this stream.
+     * Uniformly distributed between 0 and 1, both excluded.
+     *
+     * \returns The next random.
+     */
+    double RandU01()
+    {
+        if (m_next == BUFFER_SIZE)
+        {
+            Refill();
+        }
+        return m_buffer[m_next++];
+    }
+
+    /**
+     * Generate the next \pname{n} random numbers for this stream.
+     *
+     * \param [out] u The random numbers.
+     * \param [in] n The number of random numbers.
+     */
+    void RandU01(double* u, std::size_t n);
+
+    /**
+     * The Philox4x32-10 block function.
+     *
+     * \param [in] ctr The counter.
+     * \param [in] key The key.
+     * \param [out] out The four random words.
+     */
+    static void Philox4x32(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]);
+
+  private:
+    /** Number of counters processed together. */
+    static constexpr std::size_t LANES = 8;
+    /** Number of buffered random numbers, a multiple of 2 * LANES. */
+    static constexpr std::size_t BUFFER_SIZE = 64;
+
+    /**
+     * Generate the random numbers of the next blocks.
+     *
+     * \param [out] u The random numbers.
+     * \param [in] n The number of random numbers, a multiple of 2 * LANES.
+     */
+    void Generate(double* u, std::size_t n);
+    /** Fill the buffer with the random numbers of the next blocks. */
+    void Refill();
+
+    uint32_t m_key[2];            //!< The key, from the seed and the run number
+    uint32_t m_stream[2];         //!< The high words of the counter
+    uint64_t m_counter;           //!< The low words of the counter
+    double m_buffer[BUFFER_SIZE]; //!< The buffered random numbers
+    std::size_t m_next;           //!< The next buffered random number
+};
+
+} // namespace ns3
+
+#endif /* PHILOX_RNG_STREAM_H */
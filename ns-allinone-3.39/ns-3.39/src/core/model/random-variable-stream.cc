@@ -109,6 +109,16 @@ RandomVariableStream::GetInteger()
     return static_cast<uint32_t>(GetValue());
 }
 
+void
+RandomVariableStream::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        values[i] = GetValue();
+    }
+}
+
 void
 RandomVariableStream::SetStream(int64_t stream)
 {
@@ -122,7 +132,10 @@ RandomVariableStream::SetStream(int64_t stream)
         // number assignment.
         uint64_t nextStream = RngSeedManager::GetNextStreamIndex();
         NS_ASSERT(nextStream <= ((1ULL) << 63));
-        m_rng = new RngStream(RngSeedManager::GetSeed(), nextStream, RngSeedManager::GetRun());
+        m_rng = new RngStream(RngSeedManager::GetSeed(),
+                              nextStream,
+                              RngSeedManager::GetRun(),
+                              RngSeedManager::GetGenerator());
     }
     else
     {
@@ -130,7 +143,10 @@ RandomVariableStream::SetStream(int64_t stream)
         // number assignment.
         uint64_t base = ((1ULL) << 63);
         uint64_t target = base + stream;
-        m_rng = new RngStream(RngSeedManager::GetSeed(), target, RngSeedManager::GetRun());
+        m_rng = new RngStream(RngSeedManager::GetSeed(),
+                              target,
+                              RngSeedManager::GetRun(),
+                              RngSeedManager::GetGenerator());
     }
     m_stream = stream;
 }
@@ -226,6 +242,25 @@ UniformRandomVariable::GetInteger()
     return static_cast<uint32_t>(GetValue(m_min, m_max + 1));
 }
 
+void
+UniformRandomVariable::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+    // same values as GetValue()
+    Peek()->RandU01(values, n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        values[i] = m_min + values[i] * (m_max - m_min);
+    }
+    if (IsAntithetic())
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            values[i] = m_min + (m_max - values[i]);
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ConstantRandomVariable);
 
 TypeId
@@ -455,6 +490,35 @@ ExponentialRandomVariable::GetValue()
     return GetValue(m_mean, m_bound);
 }
 
+void
+ExponentialRandomVariable::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+    Peek()->RandU01(values, n);
+    if (IsAntithetic())
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            values[i] = 1 - values[i];
+        }
+    }
+    for (std::size_t i = 0; i < n; i++)
+    {
+        values[i] = -m_mean * std::log(values[i]);
+    }
+    if (m_bound != 0)
+    {
+        // redraw the few values beyond the bound
+        for (std::size_t i = 0; i < n; i++)
+        {
+            if (values[i] > m_bound)
+            {
+                values[i] = GetValue(m_mean, m_bound);
+            }
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ParetoRandomVariable);
 
 TypeId
@@ -776,6 +840,42 @@ NormalRandomVariable::GetValue()
     return GetValue(m_mean, m_variance, m_bound);
 }
 
+void
+NormalRandomVariable::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+    // Box-Muller transform of pairs of uniforms, without the rejection
+    // step of the polar method used by GetValue()
+    std::size_t pairs = n - n % 2;
+    Peek()->RandU01(values, pairs);
+    if (IsAntithetic())
+    {
+        for (std::size_t i = 0; i < pairs; i++)
+        {
+            values[i] = 1 - values[i];
+        }
+    }
+    double sigma = std::sqrt(m_variance);
+    for (std::size_t i = 0; i < pairs; i += 2)
+    {
+        double r = sigma * std::sqrt(-2 * std::log(values[i]));
+        double theta = 2 * M_PI * values[i + 1];
+        values[i] = m_mean + r * std::cos(theta);
+        values[i + 1] = m_mean + r * std::sin(theta);
+    }
+    for (std::size_t i = 0; i < pairs; i++)
+    {
+        if (std::fabs(values[i] - m_mean) > m_bound)
+        {
+            values[i] = GetValue(m_mean, m_variance, m_bound);
+        }
+    }
+    if (pairs < n)
+    {
+        values[pairs] = GetValue(m_mean, m_variance, m_bound);
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
 TypeId
@@ -1644,6 +1744,43 @@ EmpiricalRandomVariable::GetValue()
     return value;
 }
 
+void
+EmpiricalRandomVariable::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+
+    if (!m_validated)
+    {
+        Validate();
+    }
+
+    // same values as GetValue()
+    Peek()->RandU01(values, n);
+    if (IsAntithetic())
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            values[i] = 1 - values[i];
+        }
+    }
+    for (std::size_t i = 0; i < n; i++)
+    {
+        double r = values[i];
+        if (r <= m_emp.front().cdf)
+        {
+            values[i] = m_emp.front().value;
+        }
+        else if (r >= m_emp.back().cdf)
+        {
+            values[i] = m_emp.back().value;
+        }
+        else
+        {
+            values[i] = m_interpolate ? DoInterpolate(r) : DoSampleCDF(r);
+        }
+    }
+}
+
 double
 EmpiricalRandomVariable::DoSampleCDF(double r)
 {
@@ -152,6 +152,21 @@ class RandomVariableStream : public Object
     // The base implementation returns `(uint32_t)GetValue()`
     virtual uint32_t GetInteger();
 
+    /**
+     * \brief Get the next random values drawn from the distribution.
+     *
+     * The base implementation calls GetValue() \pname{n} times.  The
+     * uniform, exponential, normal and empirical distributions instead draw
+     * a block of uniforms from the RngStream and transform them together,
+     * which is cheaper, in particular with the Philox4x32 generator.  The
+     * values have the same distribution, but they need not be the ones that
+     * \pname{n} calls to GetValue() would return.
+     *
+     * \param [out] values The random values.
+     * \param [in] n The number of random values.
+     */
+    virtual void GetValues(double* values, std::size_t n);
+
   protected:
     /**
      * \brief Get the pointer to the underlying RngStream.
@@ -275,6 +290,7 @@ class UniformRandomVariable : public RandomVariableStream
      * \note The upper limit is excluded from the output range, unlike GetInteger().
      */
     double GetValue() override;
+    void GetValues(double* values, std::size_t n) override;
 
     /**
      * \copydoc RandomVariableStream::GetInteger()
@@ -590,6 +606,7 @@ class ExponentialRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void GetValues(double* values, std::size_t n) override;
     using RandomVariableStream::GetInteger;
 
   private:
@@ -1015,6 +1032,7 @@ class NormalRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void GetValues(double* values, std::size_t n) override;
     using RandomVariableStream::GetInteger;
 
   private:
@@ -1999,6 +2017,7 @@ class EmpiricalRandomVariable : public RandomVariableStream
      * stepwise continuous function.
      */
     double GetValue() override;
+    void GetValues(double* values, std::size_t n) override;
     using RandomVariableStream::GetInteger;
 
     /**
@@ -20,10 +20,14 @@
 
 #include "attribute-helper.h"
 #include "config.h"
+#include "enum.h"
 #include "global-value.h"
 #include "log.h"
+#include "simulation-context.h"
 #include "uinteger.h"
 
+#include <atomic>
+
 /**
  * \file
  * \ingroup randomvariable
@@ -38,9 +42,28 @@ NS_LOG_COMPONENT_DEFINE("RngSeedManager");
 /**
  * \relates RngSeedManager
  * The next random number generator stream number to use
- * for automatic assignment.
+ * for automatic assignment, shared by the threads of the process.
+ */
+static std::atomic<uint64_t> g_nextStreamIndex{0};
+
+/**
+ * \relates RngSeedManager
+ * The next stream number of the replication of a SimulationContext.
  */
-static uint64_t g_nextStreamIndex = 0;
+static thread_local uint64_t g_replicationNextStreamIndex = 0;
+
+/**
+ * \relates RngSeedManager
+ * Seed and run set by the replication of a SimulationContext, which
+ * override the RngSeed and RngRun global values in its thread only.
+ */
+static thread_local struct
+{
+    bool hasSeed{false}; //!< The seed is set
+    uint32_t seed{0};    //!< The seed
+    bool hasRun{false};  //!< The run is set
+    uint64_t run{0};     //!< The run
+} g_contextRng;
 /**
  * \relates RngSeedManager
  * \anchor GlobalValueRngSeed
@@ -69,11 +92,32 @@ static ns3::GlobalValue g_rngRun("RngRun",
                                  "The substream index used for all streams",
                                  ns3::UintegerValue(1),
                                  ns3::MakeUintegerChecker<uint64_t>());
+/**
+ * \relates RngSeedManager
+ * \anchor GlobalValueRngGenerator
+ * The generator backing the random number generator streams: the
+ * combined multiple-recursive generator MRG32k3a or the counter-based
+ * generator Philox4x32-10.  With Philox4x32-10, RngRun must be below
+ * 2^32.
+ *
+ * This is accessible as "--RngGenerator" from CommandLine.
+ */
+static ns3::GlobalValue g_rngGenerator("RngGenerator",
+                                       "The generator backing all rng streams",
+                                       ns3::EnumValue(RngStream::MRG32K3A),
+                                       ns3::MakeEnumChecker(RngStream::MRG32K3A,
+                                                            "MRG32k3a",
+                                                            RngStream::PHILOX4X32,
+                                                            "Philox4x32"));
 
 uint32_t
 RngSeedManager::GetSeed()
 {
     NS_LOG_FUNCTION_NOARGS();
+    if (g_contextRng.hasSeed)
+    {
+        return g_contextRng.seed;
+    }
     UintegerValue seedValue;
     g_rngSeed.GetValue(seedValue);
     return static_cast<uint32_t>(seedValue.Get());
@@ -83,6 +127,12 @@ void
 RngSeedManager::SetSeed(uint32_t seed)
 {
     NS_LOG_FUNCTION(seed);
+    if (SimulationContext::GetReplication() >= 0)
+    {
+        g_contextRng.hasSeed = true;
+        g_contextRng.seed = seed;
+        return;
+    }
     Config::SetGlobal("RngSeed", UintegerValue(seed));
 }
 
@@ -90,6 +140,12 @@ void
 RngSeedManager::SetRun(uint64_t run)
 {
     NS_LOG_FUNCTION(run);
+    if (SimulationContext::GetReplication() >= 0)
+    {
+        g_contextRng.hasRun = true;
+        g_contextRng.run = run;
+        return;
+    }
     Config::SetGlobal("RngRun", UintegerValue(run));
 }
 
@@ -97,19 +153,41 @@ uint64_t
 RngSeedManager::GetRun()
 {
     NS_LOG_FUNCTION_NOARGS();
+    if (g_contextRng.hasRun)
+    {
+        return g_contextRng.run;
+    }
     UintegerValue value;
     g_rngRun.GetValue(value);
     uint64_t run = value.Get();
     return run;
 }
 
+void
+RngSeedManager::SetGenerator(RngStream::Generator generator)
+{
+    NS_LOG_FUNCTION(generator);
+    Config::SetGlobal("RngGenerator", EnumValue(generator));
+}
+
+RngStream::Generator
+RngSeedManager::GetGenerator()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    EnumValue value;
+    g_rngGenerator.GetValue(value);
+    return static_cast<RngStream::Generator>(value.Get());
+}
+
 uint64_t
 RngSeedManager::GetNextStreamIndex()
 {
     NS_LOG_FUNCTION_NOARGS();
-    uint64_t next = g_nextStreamIndex;
-    g_nextStreamIndex++;
-    return next;
+    if (SimulationContext::GetReplication() >= 0)
+    {
+        return g_replicationNextStreamIndex++;
+    }
+    return g_nextStreamIndex++;
 }
 
 } // namespace ns3
@@ -19,6 +19,8 @@
 #ifndef RNG_SEED_MANAGER_H
 #define RNG_SEED_MANAGER_H
 
+#include "rng-stream.h"
+
 #include <stdint.h>
 
 /**
@@ -55,6 +57,9 @@ class RngSeedManager
      * \note While the underlying RNG takes six integer values as a seed;
      * it is sufficient to set these all to the same integer, so we provide
      * a simpler interface here that just takes one integer.
+     *
+     * \note In a replication of a SimulationContext, the seed is only set
+     * for the replication.
      */
     static void SetSeed(uint32_t seed);
 
@@ -90,6 +95,9 @@ class RngSeedManager
      * \endcode
      *
      * \param [in] run The run number.
+     *
+     * \note In a replication of a SimulationContext, the run is only set
+     * for the replication.
      */
     static void SetRun(uint64_t run);
     /**
@@ -99,6 +107,24 @@ class RngSeedManager
      */
     static uint64_t GetRun();
 
+    /**
+     * \brief Set the generator backing the streams created from now on.
+     *
+     * Both generators use the same seed, run and stream numbers, so that
+     * RandomVariableStream::SetStream and the AssignStreams methods give
+     * reproducible sequences with either of them.
+     *
+     * \param [in] generator The generator.
+     */
+    static void SetGenerator(RngStream::Generator generator);
+
+    /**
+     * \brief Get the generator backing the streams.
+     * \returns The generator.
+     * \see SetGenerator
+     */
+    static RngStream::Generator GetGenerator();
+
     /**
      * Get the next automatically assigned stream index.
      * \returns The next stream index.
@@ -23,6 +23,7 @@
 
 #include "fatal-error.h"
 #include "log.h"
+#include "philox-rng-stream.h"
 
 #include <cstdlib>
 #include <iostream>
@@ -340,6 +341,11 @@ using namespace MRG32k3a;
 double
 RngStream::RandU01()
 {
+    if (m_philox)
+    {
+        return m_philox->RandU01();
+    }
+
     int32_t k;
     double p1;
     double p2;
@@ -375,7 +381,24 @@ RngStream::RandU01()
     return u;
 }
 
-RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
+void
+RngStream::RandU01(double* u, std::size_t n)
+{
+    if (m_philox)
+    {
+        m_philox->RandU01(u, n);
+        return;
+    }
+    for (std::size_t i = 0; i < n; i++)
+    {
+        u[i] = RandU01();
+    }
+}
+
+RngStream::RngStream(uint32_t seedNumber,
+                     uint64_t stream,
+                     uint64_t substream,
+                     Generator generator)
 {
     if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
     {
@@ -385,6 +408,11 @@ RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
     {
         m_currentState[i] = seedNumber;
     }
+    if (generator == PHILOX4X32)
+    {
+        m_philox = std::make_unique<PhiloxRngStream>(seedNumber, stream, substream);
+        return;
+    }
     AdvanceNthBy(stream, 127, m_currentState);
     AdvanceNthBy(substream, 76, m_currentState);
 }
@@ -395,6 +423,14 @@ RngStream::RngStream(const RngStream& r)
     {
         m_currentState[i] = r.m_currentState[i];
     }
+    if (r.m_philox)
+    {
+        m_philox = std::make_unique<PhiloxRngStream>(*r.m_philox);
+    }
+}
+
+RngStream::~RngStream()
+{
 }
 
 void
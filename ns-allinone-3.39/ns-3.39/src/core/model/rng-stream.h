@@ -18,6 +18,8 @@
 
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
+#include <cstddef>
+#include <memory>
 #include <stdint.h>
 #include <string>
 
@@ -30,6 +32,8 @@
 namespace ns3
 {
 
+class PhiloxRngStream;
+
 /**
  * \ingroup randomvariable
  * \defgroup rngimpl RNG Implementation
@@ -45,24 +49,42 @@ namespace ns3
  * holds a static instance of this class.  The details of this
  * class are explained in:
  * http://www.iro.umontreal.ca/~lecuyer/myftp/papers/streams00.pdf
+ *
+ * The stream can instead be backed by the counter-based generator
+ * Philox4x32-10 (see ns3::PhiloxRngStream), selected with the
+ * \ref GlobalValueRngGenerator "RngGenerator" global value, with the
+ * same seed, stream and substream numbering.
  */
 class RngStream
 {
   public:
+    /** The generators backing a stream. */
+    enum Generator
+    {
+        MRG32K3A,  //!< Combined multiple-recursive generator MRG32k3a
+        PHILOX4X32 //!< Counter-based generator Philox4x32-10
+    };
+
     /**
      * Construct from explicit seed, stream and substream values.
      *
      * \param [in] seed The starting seed.
      * \param [in] stream The stream number.
      * \param [in] substream The sub-stream number.
+     * \param [in] generator The generator backing the stream.
      */
-    RngStream(uint32_t seed, uint64_t stream, uint64_t substream);
+    RngStream(uint32_t seed,
+              uint64_t stream,
+              uint64_t substream,
+              Generator generator = MRG32K3A);
     /**
      * Copy constructor.
      *
      * \param [in] r The RngStream to copy.
      */
     RngStream(const RngStream& r);
+    /** Destructor. */
+    ~RngStream();
     /**
      * Generate the next random number for this stream.
      * Uniformly distributed between 0 and 1.
@@ -70,6 +92,14 @@ class RngStream
      * \returns The next random.
      */
     double RandU01();
+    /**
+     * Generate the next \pname{n} random numbers for this stream, the
+     * same as \pname{n} calls to RandU01().
+     *
+     * \param [out] u The random numbers.
+     * \param [in] n The number of random numbers.
+     */
+    void RandU01(double* u, std::size_t n);
 
   private:
     /**
@@ -83,6 +113,8 @@ class RngStream
 
     /** The RNG state vector. */
     double m_currentState[6];
+    /** The counter-based generator, or nullptr for MRG32k3a. */
+    std::unique_ptr<PhiloxRngStream> m_philox;
 };
 
 } // namespace ns3
@@ -58,7 +58,7 @@ class Empty
  * virtual.
  *
  *
- * This template takes 3 arguments but only the first argument is
+ * This template takes 4 arguments but only the first argument is
  * mandatory:
  *
  * \tparam T \explicit The typename of the subclass which derives
@@ -73,10 +73,17 @@ class Empty
  *      a public static method named 'Delete'. This method will be called
  *      whenever the SimpleRefCount template detects that no references
  *      to the object it manages exist anymore.
+ * \tparam COUNTER \explicit The type of the reference count.  By default,
+ *      this typename is uint32_t; std::atomic<uint32_t> makes the
+ *      reference counting thread-safe, for the objects shared by the
+ *      simulations of a SimulationContext (e.g., the attribute checkers).
  *
  * Interesting users of this class include ns3::Object as well as ns3::Packet.
  */
-template <typename T, typename PARENT = Empty, typename DELETER = DefaultDeleter<T>>
+template <typename T,
+          typename PARENT = Empty,
+          typename DELETER = DefaultDeleter<T>,
+          typename COUNTER = uint32_t>
 class SimpleRefCount : public PARENT
 {
   public:
@@ -125,8 +132,7 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
-        m_count--;
-        if (m_count == 0)
+        if (--m_count == 0)
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -151,7 +157,7 @@ class SimpleRefCount : public PARENT
      * Note we make this mutable so that the const methods can still
      * change it.
      */
-    mutable uint32_t m_count;
+    mutable COUNTER m_count;
 };
 
 } // namespace ns3
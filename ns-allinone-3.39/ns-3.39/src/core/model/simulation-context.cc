@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "simulation-context.h"
+
+#include "abort.h"
+#include "log.h"
+#include "nstime.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulationContext implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SimulationContext");
+
+/**
+ * \ingroup simulator
+ * The index of the replication run by the thread, -1 outside a replication.
+ */
+static thread_local int64_t g_replication = -1;
+
+void
+SimulationContext::Run(uint32_t replications, const Replication& replication, uint32_t threads)
+{
+    NS_LOG_FUNCTION(replications << threads);
+    NS_ABORT_MSG_IF(g_replication >= 0, "SimulationContext::Run called from a replication");
+    if (threads == 0)
+    {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, replications);
+
+    // The Time objects created from now on are not marked for a change of
+    // resolution, as the replications create them concurrently.
+    Time::ClearMarkedTimes();
+
+    std::atomic<uint32_t> next{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto runReplication = [&](uint32_t index) {
+        g_replication = index;
+        try
+        {
+            replication(index);
+            Simulator::Destroy();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+            next = replications;
+        }
+    };
+    auto worker = [&]() {
+        for (uint32_t index = next++; index < replications; index = next++)
+        {
+            NS_LOG_LOGIC("replication " << index);
+            // A new thread per replication, whose thread-local state is clean.
+            std::thread thread(runReplication, index);
+            thread.join();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32_t i = 0; i < threads; i++)
+    {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+int64_t
+SimulationContext::GetReplication()
+{
+    return g_replication;
+}
+
+} // namespace ns3
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef SIMULATION_CONTEXT_H
+#define SIMULATION_CONTEXT_H
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulationContext declaration.
+ */
+
+#include <cstdint>
+#include <functional>
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Run independent replications of a simulation in parallel threads.
+ *
+ * The state of a simulation (the simulator and its events, the
+ * SimulationSingleton instances, the NodeList and ChannelList, Names,
+ * Config, the packet uids, the allocated addresses and the random stream
+ * numbers) is per replication, so each replication runs its own simulation.
+ * Every replication is run in a new thread, which starts with a clean state,
+ * and the simulator is destroyed when the replication returns.  The threads
+ * which run no replication, as the reader threads of the emulated devices
+ * and the threads of a MultithreadedSimulatorImpl, share the simulation of
+ * the process:
+ *
+ * \code
+ *   SimulationContext::Run(10, [](uint32_t replication) {
+ *       RngSeedManager::SetRun(replication + 1);
+ *       NodeContainer nodes;
+ *       nodes.Create(2);
+ *       // ...
+ *       Simulator::Run();
+ *       // collect the results of the replication
+ *   });
+ * \endcode
+ *
+ * The results of a replication do not depend on the number of threads.
+ * RngSeedManager::SetSeed and RngSeedManager::SetRun only change the seed
+ * and run of the replication that calls them.
+ *
+ * The process-wide configuration is shared and read-only while the
+ * replications run: the attribute defaults and global values
+ * (Config::SetDefault, Config::SetGlobal), the enabled logs and the time
+ * resolution must be set before calling Run.  The replications must not
+ * share objects or output files.
+ */
+class SimulationContext
+{
+  public:
+    /**
+     * Function run by a replication.
+     * \param [in] replication the index of the replication
+     */
+    typedef std::function<void(uint32_t replication)> Replication;
+
+    /**
+     * Run the replications, each in its own thread, and wait for them.
+     *
+     * If a replication throws, no more replications are started and the
+     * first exception is rethrown once the running ones end.
+     *
+     * \param [in] replications the number of replications
+     * \param [in] replication the function run by each replication
+     * \param [in] threads the maximum number of concurrent replications, or
+     *             zero for the number of hardware threads
+     */
+    static void Run(uint32_t replications, const Replication& replication, uint32_t threads = 0);
+
+    /**
+     * \return the index of the replication run by the calling thread, or -1
+     *         outside a replication
+     */
+    static int64_t GetReplication();
+};
+
+} // namespace ns3
+
+#endif /* SIMULATION_CONTEXT_H */
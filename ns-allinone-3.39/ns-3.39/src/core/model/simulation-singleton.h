@@ -38,6 +38,9 @@ namespace ns3
  *
  * For a singleton with a lifetime bounded by the process,
  * not the simulation run, see Singleton.
+ *
+ * As the simulator, the instance is shared by the threads of the
+ * process, but every replication of a SimulationContext has its own.
  */
 template <typename T>
 class SimulationSingleton
@@ -80,6 +83,7 @@ class SimulationSingleton
  *  Implementation of the templates declared above.
  ********************************************************************/
 
+#include "simulation-context.h"
 #include "simulator.h"
 
 namespace ns3
@@ -98,12 +102,14 @@ T**
 SimulationSingleton<T>::GetObject()
 {
     static T* pobject = nullptr;
-    if (pobject == nullptr)
+    static thread_local T* replicationObject = nullptr;
+    T** ppobject = SimulationContext::GetReplication() >= 0 ? &replicationObject : &pobject;
+    if (*ppobject == nullptr)
     {
-        pobject = new T();
+        *ppobject = new T();
         Simulator::ScheduleDestroy(&SimulationSingleton<T>::DeleteObject);
     }
-    return &pobject;
+    return ppobject;
 }
 
 template <typename T>
@@ -27,6 +27,7 @@
 #include "object-factory.h"
 #include "ptr.h"
 #include "scheduler.h"
+#include "simulation-context.h"
 #include "simulator-impl.h"
 #include "string.h"
 
@@ -80,16 +81,46 @@ static GlobalValue g_schedTypeImpl =
                 TypeIdValue(MapScheduler::GetTypeId()),
                 MakeTypeIdChecker());
 
+/**
+ * \ingroup simulator
+ * The process-wide SimulatorImpl instance.
+ */
+static SimulatorImpl* g_impl = nullptr;
+
+/**
+ * \ingroup simulator
+ * The SimulatorImpl instance of the calling thread, when it does not use
+ * the process-wide one: the simulator of a replication of a
+ * SimulationContext, or the one set by Simulator::SetThreadImplementation.
+ */
+static thread_local SimulatorImpl* g_threadImpl = nullptr;
+
+/**
+ * \ingroup simulator
+ * The SimulatorImpl instance used by the calling thread, g_impl or
+ * g_threadImpl, or null before the first call in the thread.
+ */
+static thread_local SimulatorImpl** g_threadPimpl = nullptr;
+
 /**
  * \ingroup simulator
  * \brief Get the static SimulatorImpl instance.
+ *
+ * All the threads share the process-wide instance, so that the threads
+ * of the emulated devices can schedule events in the simulation, except
+ * the replications of a SimulationContext, which run their own, and the
+ * threads which set theirs with Simulator::SetThreadImplementation.
+ *
  * \return The SimulatorImpl instance pointer.
  */
 static SimulatorImpl**
 PeekImpl()
 {
-    static SimulatorImpl* impl = nullptr;
-    return &impl;
+    if (g_threadPimpl == nullptr)
+    {
+        g_threadPimpl = SimulationContext::GetReplication() >= 0 ? &g_threadImpl : &g_impl;
+    }
+    return g_threadPimpl;
 }
 
 /**
@@ -360,6 +391,16 @@ Simulator::SetImplementation(Ptr<SimulatorImpl> impl)
     LogSetNodePrinter(&DefaultNodePrinter);
 }
 
+void
+Simulator::SetThreadImplementation(SimulatorImpl* impl)
+{
+    NS_LOG_FUNCTION(impl);
+    NS_ASSERT_MSG(SimulationContext::GetReplication() < 0,
+                  "A replication of a SimulationContext runs its own simulator");
+    g_threadImpl = impl;
+    g_threadPimpl = impl ? &g_threadImpl : &g_impl;
+}
+
 Ptr<SimulatorImpl>
 Simulator::GetImplementation()
 {
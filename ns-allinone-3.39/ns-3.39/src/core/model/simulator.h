@@ -85,6 +85,23 @@ class Simulator
      */
     static void SetImplementation(Ptr<SimulatorImpl> impl);
 
+    /**
+     * @brief Use a simulator implementation in the calling thread.
+     *
+     * The threads share the process-wide simulator implementation, so
+     * any thread can, e.g., schedule events with ScheduleWithContext.  A
+     * simulator implementation that runs events in threads of its own
+     * calls this method in each of them, so that the events see that
+     * implementation, and with a null pointer, to use the process-wide
+     * one again, before the thread ends.
+     *
+     * Unlike SetImplementation, the implementation is neither referenced
+     * nor configured: the thread that created it owns it.
+     *
+     * @param [in] impl The simulator implementation, or nullptr.
+     */
+    static void SetThreadImplementation(SimulatorImpl* impl);
+
     /**
      * @brief Get the SimulatorImpl singleton.
      *
@@ -23,6 +23,7 @@
 #include "ptr.h"
 #include "simple-ref-count.h"
 
+#include <atomic>
 #include <stdint.h>
 
 /**
@@ -44,7 +45,10 @@ class ObjectBase;
  * This class abstracts the kind of trace source to which we want to connect
  * and provides services to Connect and Disconnect a sink to a trace source.
  */
-class TraceSourceAccessor : public SimpleRefCount<TraceSourceAccessor>
+class TraceSourceAccessor : public SimpleRefCount<TraceSourceAccessor,
+                                                  Empty,
+                                                  DefaultDeleter<TraceSourceAccessor>,
+                                                  std::atomic<uint32_t>>
 {
   public:
     /** Constructor. */
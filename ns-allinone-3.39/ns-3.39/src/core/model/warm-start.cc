@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::WarmStart implementation.
+ */
+
+#include "warm-start.h"
+
+#include "abort.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <cstdio>
+#include <iostream>
+
+#ifndef __WIN32__
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("WarmStart");
+
+uint32_t WarmStart::m_failures = 0;
+
+uint32_t
+WarmStart::Run(Time warmup, uint32_t variants, uint32_t maxParallel)
+{
+    NS_LOG_FUNCTION(warmup << variants << maxParallel);
+#ifdef __WIN32__
+    NS_FATAL_ERROR("WarmStart requires fork(), which is not available on this platform");
+    return PARENT;
+#else
+    NS_ABORT_MSG_IF(warmup < Simulator::Now(), "Warm-up ends before the current time");
+    if (maxParallel == 0)
+    {
+        maxParallel = variants;
+    }
+
+    Simulator::Stop(warmup - Simulator::Now());
+    Simulator::Run();
+    NS_LOG_INFO("Warm-up finished at " << Simulator::Now().As(Time::S) << ", forking " << variants
+                                       << " variants");
+
+    m_failures = 0;
+    uint32_t running = 0;
+    for (uint32_t variant = 0; variant < variants; variant++)
+    {
+        if (running == maxParallel)
+        {
+            int status;
+            if (wait(&status) > 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0))
+            {
+                m_failures++;
+            }
+            running--;
+        }
+        // buffered output would be written once per process otherwise
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "WarmStart: fork failed");
+        if (pid == 0)
+        {
+            return variant;
+        }
+        NS_LOG_LOGIC("Variant " << variant << " running in process " << pid);
+        running++;
+    }
+    while (running > 0)
+    {
+        int status;
+        if (wait(&status) > 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0))
+        {
+            m_failures++;
+        }
+        running--;
+    }
+    return PARENT;
+#endif
+}
+
+uint32_t
+WarmStart::GetFailures()
+{
+    return m_failures;
+}
+
+} // namespace ns3
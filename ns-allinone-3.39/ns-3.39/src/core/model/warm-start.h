@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WARM_START_H
+#define WARM_START_H
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::WarmStart declaration.
+ */
+
+#include "nstime.h"
+
+#include <limits>
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ *
+ * Run several simulation variants from a common warm-up prefix.
+ *
+ * The simulation is run once up to the end of the warm-up period and the
+ * process is then forked once per variant.  Each child process starts from
+ * an exact copy of the warmed-up state: pending events, queue disc and
+ * device queues, the transmission state machines of the devices and the
+ * state of every random variable stream.  This makes the variants
+ * bit-identical to a full run of the same scenario, while the warm-up
+ * transient is simulated only once.
+ *
+ * Events hold arbitrary callbacks, so the state cannot be written to a
+ * file in general; copying the address space of the process is the only
+ * way to resume from it that works for every model.
+ *
+ * Example usage:
+ *
+ * \code
+ *     // Create the model and connect the tracers
+ *
+ *     std::vector<Time> stops = {Seconds(0.2), Seconds(0.5), Seconds(1)};
+ *     uint32_t variant = WarmStart::Run(MilliSeconds(50), stops.size());
+ *     if (variant == WarmStart::PARENT)
+ *     {
+ *         Simulator::Destroy();
+ *         return WarmStart::GetFailures() == 0 ? 0 : 1;
+ *     }
+ *     // Reopen the output files of this variant, then
+ *     Simulator::Stop(stops[variant] - Simulator::Now());
+ *     Simulator::Run();
+ *     Simulator::Destroy();
+ * \endcode
+ *
+ * Output streams are duplicated by the fork together with any data not
+ * yet written, so the standard streams are flushed before forking.  Any
+ * other file opened before the warm-up must be flushed (or reopened with
+ * a per-variant name) by the user.
+ *
+ * Only available on POSIX systems.
+ */
+class WarmStart
+{
+  public:
+    /** Value returned by Run() in the parent process. */
+    static constexpr uint32_t PARENT = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * Run the simulation until \p warmup and fork one process per variant.
+     *
+     * In each child process the method returns the index of the variant
+     * to simulate, in [0, \p variants).  The parent process waits for all
+     * the children and returns PARENT.
+     *
+     * \param [in] warmup The simulation time at which the state is shared.
+     * \param [in] variants The number of variants to run.
+     * \param [in] maxParallel The maximum number of variants running at the
+     *             same time; zero means all of them.
+     * \returns The variant index in the children, PARENT in the parent.
+     */
+    static uint32_t Run(Time warmup, uint32_t variants, uint32_t maxParallel = 0);
+
+    /**
+     * \returns The number of variants of the last Run() which did not exit
+     * with a zero status.  Only meaningful in the parent process.
+     */
+    static uint32_t GetFailures();
+
+  private:
+    /** Number of failed variants of the last Run(). */
+    static uint32_t m_failures;
+};
+
+} // namespace ns3
+
+#endif /* WARM_START_H */
@@ -864,6 +864,120 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * \ingroup config-tests
+ * Test that compiled paths match the same objects as LookupMatches.
+ */
+class PathMatcherConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    PathMatcherConfigTestCase();
+
+    /** Destructor. */
+    ~PathMatcherConfigTestCase() override
+    {
+    }
+
+    /**
+     * Trace callback without context.
+     * \param oldValue The old value.
+     * \param newValue The new value.
+     */
+    void Trace(int16_t oldValue [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that a compiled path and LookupMatches return the same matches.
+     * \param matcher The compiled path.
+     * \param indices The values of its placeholders.
+     * \param path The equivalent path for LookupMatches.
+     */
+    void CheckSameMatches(const Config::PathMatcher& matcher,
+                          const std::vector<std::size_t>& indices,
+                          std::string path);
+
+    int16_t m_newValue; //!< Flag to detect tracing result.
+};
+
+PathMatcherConfigTestCase::PathMatcherConfigTestCase()
+    : TestCase("Check that compiled paths match the same objects as LookupMatches")
+{
+}
+
+void
+PathMatcherConfigTestCase::CheckSameMatches(const Config::PathMatcher& matcher,
+                                            const std::vector<std::size_t>& indices,
+                                            std::string path)
+{
+    Config::MatchContainer compiled = matcher.Lookup(indices);
+    Config::MatchContainer parsed = Config::LookupMatches(path);
+    NS_TEST_ASSERT_MSG_EQ(compiled.GetN(), parsed.GetN(), "Wrong number of matches for " << path);
+    for (std::size_t i = 0; i < std::min(compiled.GetN(), parsed.GetN()); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(compiled.Get(i), parsed.Get(i), "Wrong object for " << path);
+        NS_TEST_EXPECT_MSG_EQ(compiled.GetMatchedPath(i),
+                              parsed.GetMatchedPath(i),
+                              "Wrong matched path for " << path);
+    }
+}
+
+void
+PathMatcherConfigTestCase::DoRun()
+{
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+
+    Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject>();
+    root->SetNodeA(a);
+    std::vector<Ptr<ConfigTestObject>> objs;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        objs.push_back(CreateObject<ConfigTestObject>());
+        a->AddNodeB(objs.back());
+    }
+    objs[2]->AggregateObject(CreateObject<DerivedConfigObject>());
+
+    Config::PathMatcher indexed("/NodeA/NodesB/{}");
+    NS_TEST_ASSERT_MSG_EQ(indexed.GetNParameters(), 1, "Wrong number of placeholders");
+    for (std::size_t i = 0; i < 5; i++)
+    {
+        CheckSameMatches(indexed, {i}, "/NodeA/NodesB/" + std::to_string(i));
+    }
+    CheckSameMatches(Config::PathMatcher("/NodeA/NodesB/1"), {}, "/NodeA/NodesB/1");
+    CheckSameMatches(Config::PathMatcher("/NodeA/NodesB/[0-1]|3"), {}, "/NodeA/NodesB/[0-1]|3");
+    CheckSameMatches(Config::PathMatcher("/NodeA/NodesB/*/$DerivedConfigObject"),
+                     {},
+                     "/NodeA/NodesB/*/$DerivedConfigObject");
+    CheckSameMatches(Config::PathMatcher("/*/NodesB/*"), {}, "/*/NodesB/*");
+    Config::PathMatcher unknown("/NodeA/NodesB/*/$ns3::NoSuchType");
+    NS_TEST_EXPECT_MSG_EQ(unknown.Lookup({}).GetN(), 0, "Unknown type matched");
+
+    Config::MatchContainer matches = indexed.Lookup({3});
+    bool found = false;
+    for (std::size_t i = 0; i < matches.GetN(); i++)
+    {
+        found |= (matches.Get(i) == objs[3]);
+    }
+    NS_TEST_ASSERT_MSG_EQ(found, true, "Object 3 not matched");
+
+    matches.ConnectWithoutContext("Source",
+                                  MakeCallback(&PathMatcherConfigTestCase::Trace, this));
+    m_newValue = 0;
+    objs[3]->SetAttribute("Source", IntegerValue(-4));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, -4, "Trace 3 did not fire as expected");
+    m_newValue = 0;
+    objs[2]->SetAttribute("Source", IntegerValue(-3));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, 0, "Trace 2 fired unexpectedly");
+
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -882,6 +996,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new PathMatcherConfigTestCase);
 }
 
 /**
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/abort.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-profiler.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator-tests
+ * EventProfiler test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/// Increments made by the events of the tests, per thread
+static thread_local uint64_t g_increments = 0;
+
+/**
+ * \ingroup simulator-tests
+ * Register g_increments as a counter of the EventProfiler.
+ */
+static struct EventProfilerTestCounter
+{
+    EventProfilerTestCounter()
+    {
+        EventProfiler::AddCounter("test increments", []() -> uint64_t { return g_increments; });
+    }
+} g_eventProfilerTestCounter; //!< Static variable for the registration
+
+/// Free function target of the events of the tests
+static void
+EventProfilerFreeFunction()
+{
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Base of the EventProfiler tests: enable the profiler and schedule
+ * events of different targets.
+ */
+class EventProfilerTestBase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] name the name of the test
+     */
+    EventProfilerTestBase(std::string name);
+
+    /// Target of the events: increment the counter twice
+    void Double();
+    /// Target of the events: increment the counter once
+    void Single();
+
+  protected:
+    /**
+     * Set the ProfilingPeriod of the simulator.
+     * \param [in] period the period
+     * \return the profiler
+     */
+    Ptr<EventProfiler> SetPeriod(uint32_t period);
+
+    /**
+     * Find a target by a part of its name.
+     * \param [in] targets the targets
+     * \param [in] name the part of the name
+     * \return the target, or a target without events if not found
+     */
+    static EventProfiler::Target Find(const std::vector<EventProfiler::Target>& targets,
+                                      const std::string& name);
+};
+
+EventProfilerTestBase::EventProfilerTestBase(std::string name)
+    : TestCase(name)
+{
+}
+
+void
+EventProfilerTestBase::Double()
+{
+    g_increments += 2;
+}
+
+void
+EventProfilerTestBase::Single()
+{
+    g_increments++;
+}
+
+Ptr<EventProfiler>
+EventProfilerTestBase::SetPeriod(uint32_t period)
+{
+    Ptr<DefaultSimulatorImpl> impl =
+        DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    NS_ABORT_MSG_UNLESS(impl, "The tests need the DefaultSimulatorImpl");
+    impl->SetAttribute("ProfilingPeriod", UintegerValue(period));
+    return impl->GetEventProfiler();
+}
+
+EventProfiler::Target
+EventProfilerTestBase::Find(const std::vector<EventProfiler::Target>& targets,
+                            const std::string& name)
+{
+    for (const auto& target : targets)
+    {
+        if (target.name.find(name) != std::string::npos)
+        {
+            return target;
+        }
+    }
+    return EventProfiler::Target{name, 0, 0, 0, {}};
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the targets and counters of every event, with a period of one.
+ */
+class EventProfilerExactTestCase : public EventProfilerTestBase
+{
+  public:
+    EventProfilerExactTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventProfilerExactTestCase::EventProfilerExactTestCase()
+    : EventProfilerTestBase("Profile every event")
+{
+}
+
+void
+EventProfilerExactTestCase::DoRun()
+{
+    Ptr<EventProfiler> profiler = SetPeriod(1);
+    NS_TEST_ASSERT_MSG_NE(profiler, nullptr, "The profiler was not created");
+    uint32_t lambdas = 0;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        Simulator::Schedule(MicroSeconds(i), &EventProfilerTestBase::Double, this);
+        if (i % 2 == 0)
+        {
+            Simulator::Schedule(MicroSeconds(i), &EventProfilerTestBase::Single, this);
+        }
+        if (i % 4 == 0)
+        {
+            Simulator::Schedule(MicroSeconds(i), &EventProfilerFreeFunction);
+            Simulator::Schedule(MicroSeconds(i), [&lambdas]() { lambdas++; });
+        }
+    }
+    // cancelled events are not profiled
+    EventId cancelled = Simulator::Schedule(MicroSeconds(1), &EventProfilerTestBase::Single, this);
+    cancelled.Cancel();
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(lambdas, 25, "Wrong lambda events");
+    NS_TEST_EXPECT_MSG_EQ(profiler->GetSampledEvents(), 200, "Wrong profiled events");
+    std::vector<EventProfiler::Target> targets = profiler->GetTargets();
+    NS_TEST_EXPECT_MSG_EQ(targets.size(), 4, "Wrong number of targets");
+    std::vector<std::string> names = profiler->GetCounterNames();
+    std::size_t counter = 0;
+    while (counter < names.size() && names[counter] != "test increments")
+    {
+        counter++;
+    }
+    NS_TEST_ASSERT_MSG_LT(counter, names.size(), "Counter not registered");
+
+    EventProfiler::Target target = Find(targets, "EventProfilerTestBase::Double");
+    NS_TEST_EXPECT_MSG_EQ(target.events, 100, "Wrong events of " << target.name);
+    NS_TEST_EXPECT_MSG_EQ(target.perEvent.at(counter), 2, "Wrong counter of " << target.name);
+    target = Find(targets, "EventProfilerTestBase::Single");
+    NS_TEST_EXPECT_MSG_EQ(target.events, 50, "Wrong events of " << target.name);
+    NS_TEST_EXPECT_MSG_EQ(target.perEvent.at(counter), 1, "Wrong counter of " << target.name);
+    // the symbols of static functions are not exported: the type of the event is given
+    target = Find(targets, "void (*)()");
+    NS_TEST_EXPECT_MSG_EQ(target.events, 25, "Wrong events of " << target.name);
+    target = Find(targets, "lambda");
+    NS_TEST_EXPECT_MSG_EQ(target.events, 25, "Wrong events of " << target.name);
+
+    std::ostringstream os;
+    profiler->Report(os, Simulator::Now(), Simulator::GetEventCount());
+    NS_TEST_EXPECT_MSG_NE(os.str().find("EventProfilerTestBase::Double"),
+                          std::string::npos,
+                          "Target missing from the report");
+
+    SetPeriod(0);
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the estimates of a sampling profiler.
+ */
+class EventProfilerSampledTestCase : public EventProfilerTestBase
+{
+  public:
+    EventProfilerSampledTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventProfilerSampledTestCase::EventProfilerSampledTestCase()
+    : EventProfilerTestBase("Profile one event in ten")
+{
+}
+
+void
+EventProfilerSampledTestCase::DoRun()
+{
+    Ptr<EventProfiler> profiler = SetPeriod(10);
+    for (uint32_t i = 0; i < 20000; i++)
+    {
+        Simulator::Schedule(MicroSeconds(i), &EventProfilerTestBase::Double, this);
+        if (i % 4 == 0)
+        {
+            Simulator::Schedule(MicroSeconds(i), &EventProfilerTestBase::Single, this);
+        }
+    }
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(profiler->GetSampledEvents(), 2500, 100, "Wrong profiled events");
+    std::vector<EventProfiler::Target> targets = profiler->GetTargets();
+    NS_TEST_ASSERT_MSG_EQ(targets.size(), 2, "Wrong number of targets");
+    NS_TEST_EXPECT_MSG_EQ_TOL(Find(targets, "Double").events, 20000, 1000, "Wrong estimate");
+    NS_TEST_EXPECT_MSG_EQ_TOL(Find(targets, "Single").events, 5000, 500, "Wrong estimate");
+
+    SetPeriod(0);
+    NS_TEST_EXPECT_MSG_EQ(SetPeriod(0), nullptr, "The profiler was not removed");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief EventProfiler TestSuite
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+  public:
+    EventProfilerTestSuite();
+};
+
+EventProfilerTestSuite::EventProfilerTestSuite()
+    : TestSuite("event-profiler", UNIT)
+{
+    AddTestCase(new EventProfilerExactTestCase, TestCase::QUICK);
+    AddTestCase(new EventProfilerSampledTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
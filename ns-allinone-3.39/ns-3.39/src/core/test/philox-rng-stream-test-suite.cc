@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/double.h"
+#include "ns3/philox-rng-stream.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/rng-stream.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup randomvariable-tests
+ * Tests of the Philox4x32 generator.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup randomvariable-tests
+ * Check the Philox4x32-10 block function against the known answers
+ * published with the generator.
+ */
+class PhiloxKnownAnswerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    PhiloxKnownAnswerTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PhiloxKnownAnswerTestCase::PhiloxKnownAnswerTestCase()
+    : TestCase("Philox4x32-10 known answers")
+{
+}
+
+void
+PhiloxKnownAnswerTestCase::DoRun()
+{
+    struct
+    {
+        uint32_t ctr[4];
+        uint32_t key[2];
+        uint32_t expected[4];
+    } vectors[] = {
+        {{0, 0, 0, 0}, {0, 0}, {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+        {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+         {0xffffffff, 0xffffffff},
+         {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+        {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+         {0xa4093822, 0x299f31d0},
+         {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}},
+    };
+    for (const auto& v : vectors)
+    {
+        uint32_t out[4];
+        PhiloxRngStream::Philox4x32(v.ctr, v.key, out);
+        for (int i = 0; i < 4; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(out[i], v.expected[i], "Wrong word " << i);
+        }
+    }
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Check the reproducibility of the Philox4x32 streams, that block and
+ * single draws give the same sequence and that different streams and runs
+ * give different sequences.
+ */
+class PhiloxStreamTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    PhiloxStreamTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PhiloxStreamTestCase::PhiloxStreamTestCase()
+    : TestCase("Philox4x32 streams")
+{
+}
+
+void
+PhiloxStreamTestCase::DoRun()
+{
+    const std::size_t n = 1000;
+    RngStream reference(1, 7, 3, RngStream::PHILOX4X32);
+    std::vector<double> expected(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        expected[i] = reference.RandU01();
+        NS_TEST_ASSERT_MSG_EQ((expected[i] > 0 && expected[i] < 1), true, "Value out of (0, 1)");
+    }
+
+    // mix single draws and blocks of several sizes
+    RngStream mixed(1, 7, 3, RngStream::PHILOX4X32);
+    std::vector<double> values(n);
+    std::size_t sizes[] = {1, 5, 64, 17, 100, 3, 250};
+    std::size_t done = 0;
+    for (std::size_t k = 0; done < n; k++)
+    {
+        std::size_t size = std::min(sizes[k % 7], n - done);
+        if (size == 1)
+        {
+            values[done] = mixed.RandU01();
+        }
+        else
+        {
+            mixed.RandU01(&values[done], size);
+        }
+        done += size;
+    }
+    for (std::size_t i = 0; i < n; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(values[i], expected[i], "Block draw differs at " << i);
+    }
+
+    // a copy continues the same sequence
+    RngStream copy(reference);
+    NS_TEST_ASSERT_MSG_EQ(copy.RandU01(), reference.RandU01(), "Copy differs");
+
+    RngStream otherStream(1, 8, 3, RngStream::PHILOX4X32);
+    RngStream otherRun(1, 7, 4, RngStream::PHILOX4X32);
+    RngStream otherSeed(2, 7, 3, RngStream::PHILOX4X32);
+    uint32_t same[3] = {0, 0, 0};
+    for (std::size_t i = 0; i < n; i++)
+    {
+        same[0] += (otherStream.RandU01() == expected[i]);
+        same[1] += (otherRun.RandU01() == expected[i]);
+        same[2] += (otherSeed.RandU01() == expected[i]);
+    }
+    NS_TEST_EXPECT_MSG_EQ(same[0], 0, "Different streams give the same values");
+    NS_TEST_EXPECT_MSG_EQ(same[1], 0, "Different runs give the same values");
+    NS_TEST_EXPECT_MSG_EQ(same[2], 0, "Different seeds give the same values");
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Check the random variables backed by Philox4x32 and their block draws.
+ */
+class PhiloxRandomVariableTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    PhiloxRandomVariableTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PhiloxRandomVariableTestCase::PhiloxRandomVariableTestCase()
+    : TestCase("Random variables backed by Philox4x32")
+{
+}
+
+void
+PhiloxRandomVariableTestCase::DoRun()
+{
+    RngStream::Generator previous = RngSeedManager::GetGenerator();
+    RngSeedManager::SetGenerator(RngStream::PHILOX4X32);
+
+    // streams assigned explicitly are reproducible
+    Ptr<ExponentialRandomVariable> a = CreateObject<ExponentialRandomVariable>();
+    Ptr<ExponentialRandomVariable> b = CreateObject<ExponentialRandomVariable>();
+    a->SetStream(42);
+    b->SetStream(42);
+    for (int i = 0; i < 100; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(a->GetValue(), b->GetValue(), "Same stream, different values");
+    }
+
+    // the uniform and empirical block draws are the values of GetValue()
+    Ptr<UniformRandomVariable> u1 = CreateObject<UniformRandomVariable>();
+    Ptr<UniformRandomVariable> u2 = CreateObject<UniformRandomVariable>();
+    u1->SetStream(5);
+    u2->SetStream(5);
+    u1->SetAttribute("Min", DoubleValue(2));
+    u2->SetAttribute("Min", DoubleValue(2));
+    u1->SetAttribute("Max", DoubleValue(5));
+    u2->SetAttribute("Max", DoubleValue(5));
+    std::vector<double> values(100);
+    u1->GetValues(values.data(), values.size());
+    for (double value : values)
+    {
+        NS_TEST_ASSERT_MSG_EQ(value, u2->GetValue(), "Uniform block draw differs");
+    }
+
+    Ptr<EmpiricalRandomVariable> e1 = CreateObject<EmpiricalRandomVariable>();
+    Ptr<EmpiricalRandomVariable> e2 = CreateObject<EmpiricalRandomVariable>();
+    for (const auto& e : {e1, e2})
+    {
+        e->SetStream(6);
+        e->CDF(10, 0.2);
+        e->CDF(20, 0.7);
+        e->CDF(30, 1.0);
+    }
+    e1->GetValues(values.data(), values.size());
+    for (double value : values)
+    {
+        NS_TEST_ASSERT_MSG_EQ(value, e2->GetValue(), "Empirical block draw differs");
+    }
+
+    // moments of the exponential and normal block draws
+    const std::size_t n = 200000;
+    values.resize(n);
+    Ptr<ExponentialRandomVariable> exponential = CreateObject<ExponentialRandomVariable>();
+    exponential->SetAttribute("Mean", DoubleValue(2));
+    exponential->GetValues(values.data(), n);
+    double sum = 0;
+    for (double value : values)
+    {
+        sum += value;
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(sum / n, 2, 0.05, "Wrong exponential mean");
+
+    Ptr<NormalRandomVariable> normal = CreateObject<NormalRandomVariable>();
+    normal->SetAttribute("Mean", DoubleValue(5));
+    normal->SetAttribute("Variance", DoubleValue(4));
+    normal->GetValues(values.data(), n - 1);
+    sum = 0;
+    double sumSquares = 0;
+    for (std::size_t i = 0; i < n - 1; i++)
+    {
+        sum += values[i];
+        sumSquares += values[i] * values[i];
+    }
+    double mean = sum / (n - 1);
+    NS_TEST_EXPECT_MSG_EQ_TOL(mean, 5, 0.05, "Wrong normal mean");
+    NS_TEST_EXPECT_MSG_EQ_TOL(sumSquares / (n - 1) - mean * mean, 4, 0.1, "Wrong normal variance");
+
+    RngSeedManager::SetGenerator(previous);
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Philox4x32 test suite.
+ */
+class PhiloxRngStreamTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    PhiloxRngStreamTestSuite();
+};
+
+PhiloxRngStreamTestSuite::PhiloxRngStreamTestSuite()
+    : TestSuite("philox-rng-stream", UNIT)
+{
+    AddTestCase(new PhiloxKnownAnswerTestCase);
+    AddTestCase(new PhiloxStreamTestCase);
+    AddTestCase(new PhiloxRandomVariableTestCase);
+}
+
+static PhiloxRngStreamTestSuite g_philoxRngStreamTestSuite; //!< Static variable for test initialization
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulation-context.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator-tests
+ * SimulationContext test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that replications run in parallel give the same results as
+ * run one after the other.
+ */
+class SimulationContextTestCase : public TestCase
+{
+  public:
+    SimulationContextTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Result of a replication
+    struct Result
+    {
+        int64_t replication{-1}; //!< Index seen by the replication
+        uint32_t events{0};      //!< Events run
+        Time last;               //!< Time of the last event
+        double sum{0};           //!< Sum of the random delays
+    };
+
+    /**
+     * Run a chain of events with random delays.
+     * \param result the result of the replication
+     */
+    static void RunReplication(Result& result);
+
+    /**
+     * Event of the chain.
+     * \param result the result of the replication
+     * \param delay the random delays
+     */
+    static void Step(Result* result, Ptr<UniformRandomVariable> delay);
+
+    /**
+     * Run the replications.
+     * \param threads the number of threads
+     * \return the results of the replications
+     */
+    static std::vector<Result> RunAll(uint32_t threads);
+};
+
+SimulationContextTestCase::SimulationContextTestCase()
+    : TestCase("Parallel replications against sequential ones")
+{
+}
+
+void
+SimulationContextTestCase::Step(Result* result, Ptr<UniformRandomVariable> delay)
+{
+    result->events++;
+    result->last = Simulator::Now();
+    double value = delay->GetValue(1, 10);
+    result->sum += value;
+    Simulator::Schedule(MicroSeconds(value), &SimulationContextTestCase::Step, result, delay);
+}
+
+void
+SimulationContextTestCase::RunReplication(Result& result)
+{
+    result.replication = SimulationContext::GetReplication();
+    RngSeedManager::SetRun(result.replication + 1);
+    Ptr<UniformRandomVariable> delay = CreateObject<UniformRandomVariable>();
+    Simulator::Schedule(MicroSeconds(1), &SimulationContextTestCase::Step, &result, delay);
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+}
+
+std::vector<SimulationContextTestCase::Result>
+SimulationContextTestCase::RunAll(uint32_t threads)
+{
+    std::vector<Result> results(8);
+    SimulationContext::Run(
+        results.size(),
+        [&results](uint32_t replication) { RunReplication(results[replication]); },
+        threads);
+    return results;
+}
+
+void
+SimulationContextTestCase::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(SimulationContext::GetReplication(), -1, "Not in a replication");
+    uint64_t run = RngSeedManager::GetRun();
+
+    std::vector<Result> sequential = RunAll(1);
+    std::vector<Result> parallel = RunAll(4);
+
+    NS_TEST_EXPECT_MSG_EQ(RngSeedManager::GetRun(), run, "The run of the process changed");
+    for (std::size_t i = 0; i < sequential.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(sequential[i].replication,
+                              static_cast<int64_t>(i),
+                              "Wrong replication index");
+        NS_TEST_EXPECT_MSG_GT(sequential[i].events, 1000, "Too few events");
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].replication,
+                              static_cast<int64_t>(i),
+                              "Wrong replication index");
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].events, sequential[i].events, "Different events");
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].last, sequential[i].last, "Different last event");
+        NS_TEST_EXPECT_MSG_EQ(parallel[i].sum, sequential[i].sum, "Different random values");
+        if (i > 0)
+        {
+            NS_TEST_EXPECT_MSG_NE(sequential[i].sum, sequential[0].sum, "Same random values");
+        }
+    }
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that the exception of a replication is rethrown.
+ */
+class SimulationContextExceptionTestCase : public TestCase
+{
+  public:
+    SimulationContextExceptionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SimulationContextExceptionTestCase::SimulationContextExceptionTestCase()
+    : TestCase("Exception of a replication")
+{
+}
+
+void
+SimulationContextExceptionTestCase::DoRun()
+{
+    bool thrown = false;
+    try
+    {
+        SimulationContext::Run(
+            4,
+            [](uint32_t replication) {
+                if (replication == 2)
+                {
+                    throw std::runtime_error("replication failed");
+                }
+                Simulator::Stop(Seconds(1));
+                Simulator::Run();
+            },
+            2);
+    }
+    catch (const std::runtime_error& e)
+    {
+        thrown = true;
+    }
+    NS_TEST_EXPECT_MSG_EQ(thrown, true, "The exception was not rethrown");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that a thread which runs no simulation, as the reader thread
+ * of an emulated device, schedules its events in the running simulation.
+ */
+class SimulationContextForeignThreadTestCase : public TestCase
+{
+  public:
+    SimulationContextForeignThreadTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Start the foreign thread and wait for it
+    void StartThread();
+
+    /// Event scheduled by the foreign thread
+    void Receive();
+
+    bool m_printers{false}; //!< The foreign thread has the log printers
+    uint32_t m_received{0}; //!< Events scheduled by the foreign thread and run
+    Time m_time;            //!< Time of the event
+    uint32_t m_context{0};  //!< Context of the event
+};
+
+SimulationContextForeignThreadTestCase::SimulationContextForeignThreadTestCase()
+    : TestCase("Events scheduled from a foreign thread")
+{
+}
+
+void
+SimulationContextForeignThreadTestCase::StartThread()
+{
+    std::thread thread([this]() {
+        m_printers = LogGetTimePrinter() != nullptr && LogGetNodePrinter() != nullptr;
+        Simulator::ScheduleWithContext(7,
+                                       Time(0),
+                                       &SimulationContextForeignThreadTestCase::Receive,
+                                       this);
+    });
+    thread.join();
+}
+
+void
+SimulationContextForeignThreadTestCase::Receive()
+{
+    m_received++;
+    m_time = Simulator::Now();
+    m_context = Simulator::GetContext();
+}
+
+void
+SimulationContextForeignThreadTestCase::DoRun()
+{
+    Simulator::Schedule(Seconds(1), &SimulationContextForeignThreadTestCase::StartThread, this);
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_printers, true, "The foreign thread has no log printers");
+    NS_TEST_EXPECT_MSG_EQ(m_received, 1, "The event of the foreign thread was lost");
+    NS_TEST_EXPECT_MSG_EQ(m_time, Seconds(1), "Wrong time of the event");
+    NS_TEST_EXPECT_MSG_EQ(m_context, 7, "Wrong context of the event");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief SimulationContext TestSuite
+ */
+class SimulationContextTestSuite : public TestSuite
+{
+  public:
+    SimulationContextTestSuite();
+};
+
+SimulationContextTestSuite::SimulationContextTestSuite()
+    : TestSuite("simulation-context", UNIT)
+{
+    AddTestCase(new SimulationContextTestCase, TestCase::QUICK);
+    AddTestCase(new SimulationContextExceptionTestCase, TestCase::QUICK);
+    AddTestCase(new SimulationContextForeignThreadTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static SimulationContextTestSuite g_simulationContextTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
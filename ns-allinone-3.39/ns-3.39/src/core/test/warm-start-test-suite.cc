@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/warm-start.h"
+
+#include <cstdlib>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * WarmStart test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup core-tests
+ * Check that every warm-started variant reproduces a full run.
+ */
+class WarmStartTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    WarmStartTestCase();
+    void DoRun() override;
+
+  private:
+    /** Build the model: a chain of events with random gaps. */
+    void Setup();
+    /** Record a sample and schedule the next event. */
+    void Tick();
+
+    Ptr<UniformRandomVariable> m_rng; //!< Random gaps between events
+    std::vector<double> m_samples;    //!< Recorded samples
+};
+
+WarmStartTestCase::WarmStartTestCase()
+    : TestCase("Check that warm-started variants match a full run")
+{
+}
+
+void
+WarmStartTestCase::Setup()
+{
+    m_samples.clear();
+    m_rng = CreateObject<UniformRandomVariable>();
+    m_rng->SetStream(7);
+    Simulator::Schedule(Seconds(0), &WarmStartTestCase::Tick, this);
+}
+
+void
+WarmStartTestCase::Tick()
+{
+    double gap = m_rng->GetValue(0, 1e-3);
+    m_samples.push_back(Simulator::Now().GetSeconds() + gap);
+    Simulator::Schedule(Seconds(gap), &WarmStartTestCase::Tick, this);
+}
+
+void
+WarmStartTestCase::DoRun()
+{
+    const std::vector<Time> stops = {MilliSeconds(20), MilliSeconds(35), MilliSeconds(50)};
+
+    std::vector<std::vector<double>> reference;
+    for (const auto& stop : stops)
+    {
+        Setup();
+        Simulator::Stop(stop);
+        Simulator::Run();
+        Simulator::Destroy();
+        reference.push_back(m_samples);
+    }
+
+    Setup();
+    uint32_t variant = WarmStart::Run(MilliSeconds(10), stops.size(), 2);
+    if (variant != WarmStart::PARENT)
+    {
+        Simulator::Stop(stops[variant] - Simulator::Now());
+        Simulator::Run();
+        bool ok = Simulator::Now() == stops[variant] && m_samples == reference[variant];
+        std::_Exit(ok ? 0 : 1);
+    }
+    Simulator::Destroy();
+    NS_TEST_ASSERT_MSG_EQ(WarmStart::GetFailures(), 0, "A variant diverged from the full run");
+}
+
+/**
+ * \ingroup core-tests
+ * WarmStart test suite.
+ */
+class WarmStartTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    WarmStartTestSuite()
+        : TestSuite("warm-start")
+    {
+        AddTestCase(new WarmStartTestCase());
+    }
+};
+
+/**
+ * \ingroup core-tests
+ * WarmStartTestSuite instance variable.
+ */
+static WarmStartTestSuite g_warmStartTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -137,6 +137,21 @@ FlowMonitorHelper::InstallAll()
     return m_flowMonitor;
 }
 
+Ptr<FlowMonitor>
+FlowMonitorHelper::InstallEndpoints()
+{
+    for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i)
+    {
+        Ptr<Node> node = *i;
+        if (node->GetNApplications() > 0 &&
+            (node->GetObject<Ipv4L3Protocol>() || node->GetObject<Ipv6L3Protocol>()))
+        {
+            Install(node);
+        }
+    }
+    return m_flowMonitor;
+}
+
 void
 FlowMonitorHelper::SerializeToXmlStream(std::ostream& os,
                                         uint16_t indent,
@@ -171,4 +186,22 @@ FlowMonitorHelper::SerializeToXmlFile(std::string fileName,
     }
 }
 
+void
+FlowMonitorHelper::SerializeToCsvFile(std::string fileName, std::string histogramsFileName)
+{
+    if (m_flowMonitor)
+    {
+        m_flowMonitor->SerializeToCsvFile(fileName, histogramsFileName);
+    }
+}
+
+void
+FlowMonitorHelper::SerializeToBinaryFile(std::string fileName, bool enableHistograms)
+{
+    if (m_flowMonitor)
+    {
+        m_flowMonitor->SerializeToBinaryFile(fileName, enableHistograms);
+    }
+}
+
 } // namespace ns3
@@ -71,6 +71,17 @@ class FlowMonitorHelper
      * \returns a pointer to the FlowMonitor object
      */
     Ptr<FlowMonitor> InstallAll();
+    /**
+     * \brief Enable flow monitoring only on the nodes with applications
+     *
+     * End-to-end flow statistics only need probes where the flows enter and
+     * leave the network; intermediate nodes are not probed, so their drops
+     * are not classified by reason (the packets are eventually counted as
+     * lost).  The applications must be installed before calling this method.
+     *
+     * \returns a pointer to the FlowMonitor object
+     */
+    Ptr<FlowMonitor> InstallEndpoints();
 
     /**
      * \brief Retrieve the FlowMonitor object created by the Install* methods
@@ -119,6 +130,20 @@ class FlowMonitorHelper
      */
     void SerializeToXmlFile(std::string fileName, bool enableHistograms, bool enableProbes);
 
+    /**
+     * Serializes the flow statistics to a file in CSV format
+     * \param fileName name or path of the output file that will be created
+     * \param histogramsFileName if not empty, name of the file where the histograms are written
+     */
+    void SerializeToCsvFile(std::string fileName, std::string histogramsFileName = "");
+
+    /**
+     * Serializes the flow statistics to a file in binary format
+     * \param fileName name or path of the output file that will be created
+     * \param enableHistograms if true, include also the histograms in the output
+     */
+    void SerializeToBinaryFile(std::string fileName, bool enableHistograms);
+
   private:
     ObjectFactory m_monitorFactory;        //!< Object factory
     Ptr<FlowMonitor> m_flowMonitor;        //!< the FlowMonitor object
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "network-calculus-helper.h"
+
+#include "ns3/boolean.h"
+#include "ns3/channel.h"
+#include "ns3/data-rate.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/prio-queue-dscp-disc.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/wdrr-queue-disc.h"
+#include "ns3/wrr-queue-disc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NetworkCalculusHelper");
+
+/// DSCP of the packets served with strict priority by a PrioQueueDscpDisc
+static const uint8_t EXPRESS_DSCP = 46;
+
+/// Largest number of hops of a route, to stop on routing loops
+static const uint32_t MAX_HOPS = 64;
+
+/**
+ * \param device a device
+ * \return the name of the device in the bounds
+ */
+static std::string
+GetDeviceName(Ptr<NetDevice> device)
+{
+    std::ostringstream oss;
+    oss << "node" << device->GetNode()->GetId() << "/dev" << device->GetIfIndex();
+    return oss.str();
+}
+
+/**
+ * \param device a device
+ * \return whether the device is a PointToPointNetDevice with the EnableModel
+ * attribute set, which does not transmit nor switch the UDP and IP headers
+ */
+static bool
+IsModelEnabled(Ptr<NetDevice> device)
+{
+    BooleanValue model(false);
+    return device->GetAttributeFailSafe("EnableModel", model) && model.Get();
+}
+
+NetworkCalculusHelper::NetworkCalculusHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+NetworkCalculusHelper::AddFlow(const std::string& name,
+                               Ptr<Node> source,
+                               Ipv4Address destination,
+                               uint16_t port,
+                               double rate,
+                               double burst,
+                               uint32_t packetSize,
+                               uint8_t dscp)
+{
+    NS_LOG_FUNCTION(this << name << source << destination << port << rate << burst << packetSize
+                         << +dscp);
+    Ipv4Header header;
+    header.SetDestination(destination);
+    header.SetProtocol(17);
+    header.SetDscp(static_cast<Ipv4Header::DscpType>(dscp));
+
+    std::vector<uint32_t> route;
+    Ptr<Node> node = source;
+    for (uint32_t hop = 0;; hop++)
+    {
+        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        NS_ABORT_MSG_UNLESS(ipv4,
+                            "Node " << node->GetId() << " of flow " << name << " has no IPv4");
+        if (ipv4->GetInterfaceForAddress(destination) >= 0)
+        {
+            break;
+        }
+        NS_ABORT_MSG_IF(hop == MAX_HOPS, "Routing loop in the route of flow " << name);
+        Socket::SocketErrno err;
+        Ptr<Ipv4Route> ipv4Route =
+            ipv4->GetRoutingProtocol()->RouteOutput(Create<Packet>(), header, nullptr, err);
+        NS_ABORT_MSG_UNLESS(ipv4Route,
+                            "No route from node " << node->GetId() << " to " << destination);
+        Ptr<NetDevice> device = ipv4Route->GetOutputDevice();
+        Ipv4Address nextHop = ipv4Route->GetGateway();
+        if (nextHop == Ipv4Address::GetAny())
+        {
+            nextHop = destination;
+        }
+        route.push_back(GetPortServer(device, dscp));
+
+        Ptr<NetDevice> peer;
+        Ptr<Channel> channel = device->GetChannel();
+        for (std::size_t i = 0; channel && i < channel->GetNDevices(); i++)
+        {
+            Ptr<NetDevice> candidate = channel->GetDevice(i);
+            Ptr<Ipv4> candidateIpv4 = candidate->GetNode()->GetObject<Ipv4>();
+            if (candidate != device && candidateIpv4 &&
+                candidateIpv4->GetInterfaceForAddress(nextHop) >= 0)
+            {
+                peer = candidate;
+                break;
+            }
+        }
+        NS_ABORT_MSG_UNLESS(peer, "Next hop " << nextHop << " not found on the channel");
+        int32_t fabric = GetFabricServer(peer);
+        if (fabric >= 0)
+        {
+            route.push_back(fabric);
+        }
+        node = peer->GetNode();
+    }
+    m_destinations.push_back(Destination{destination, port});
+    return m_calculus.AddFlow(name, rate, burst, packetSize, route, dscp);
+}
+
+uint32_t
+NetworkCalculusHelper::GetPortServer(Ptr<NetDevice> device, uint8_t dscp)
+{
+    NS_LOG_FUNCTION(this << device << +dscp);
+    auto it = m_ports.find(device);
+    if (it == m_ports.end())
+    {
+        DataRateValue rate;
+        NS_ABORT_MSG_UNLESS(device->GetAttributeFailSafe("DataRate", rate),
+                            "Device " << GetDeviceName(device) << " has no DataRate");
+        TimeValue delay;
+        Ptr<Channel> channel = device->GetChannel();
+        if (channel && !channel->GetAttributeFailSafe("Delay", delay))
+        {
+            delay.Set(Seconds(0));
+        }
+        uint32_t overhead = 28;
+        if (device->GetInstanceTypeId().GetName() == "ns3::PointToPointNetDevice")
+        {
+            overhead = IsModelEnabled(device) ? 2 : 30;
+        }
+        Port port;
+        port.server = m_calculus.AddServer(GetDeviceName(device),
+                                           rate.Get().GetBitRate(),
+                                           0,
+                                           delay.Get().GetSeconds(),
+                                           overhead);
+
+        Ptr<TrafficControlLayer> tc = device->GetNode()->GetObject<TrafficControlLayer>();
+        Ptr<QueueDisc> root = tc ? tc->GetRootQueueDiscOnDevice(device) : nullptr;
+        if (DynamicCast<PrioQueueDscpDisc>(root) && root->GetNQueueDiscClasses() > 1)
+        {
+            // the express DSCP keeps the default queue, of the highest level
+            Ptr<WrrQueueDisc> wrr =
+                DynamicCast<WrrQueueDisc>(root->GetQueueDiscClass(1)->GetQueueDisc());
+            if (wrr)
+            {
+                QuantumValue quantum;
+                MapQueueValue map;
+                wrr->GetAttribute("Quantum", quantum);
+                wrr->GetAttribute("MapQueue", map);
+                for (int q : quantum.Get())
+                {
+                    port.queues.push_back(m_calculus.AddQueue(port.server, 1, std::max(q, 1)));
+                }
+                port.map = map.Get();
+            }
+            if (port.queues.empty())
+            {
+                port.queues.push_back(m_calculus.AddQueue(port.server, 1));
+            }
+        }
+        it = m_ports.emplace(device, port).first;
+    }
+
+    const Port& port = it->second;
+    if (!port.queues.empty())
+    {
+        uint32_t queue = port.express;
+        if (dscp != EXPRESS_DSCP)
+        {
+            auto band = port.map.find(dscp);
+            std::size_t index = band == port.map.end() ? 0 : band->second;
+            NS_ABORT_MSG_IF(index >= port.queues.size(),
+                            "DSCP " << +dscp << " mapped to a WRR queue without quantum");
+            queue = port.queues[index];
+        }
+        m_calculus.MapClass(port.server, dscp, queue);
+    }
+    return port.server;
+}
+
+int32_t
+NetworkCalculusHelper::GetFabricServer(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    auto it = m_fabrics.find(device);
+    if (it != m_fabrics.end())
+    {
+        return it->second;
+    }
+    int32_t server = -1;
+    BooleanValue enabled(false);
+    DataRateValue capacity;
+    if (device->GetAttributeFailSafe("EnableSwithcingTime", enabled) && enabled.Get() &&
+        device->GetAttributeFailSafe("SwitchingCapacity", capacity))
+    {
+        server = m_calculus.AddServer(GetDeviceName(device) + "/fabric",
+                                      capacity.Get().GetBitRate(),
+                                      0,
+                                      0,
+                                      IsModelEnabled(device) ? 0 : 30);
+    }
+    m_fabrics[device] = server;
+    return server;
+}
+
+void
+NetworkCalculusHelper::Evaluate()
+{
+    NS_LOG_FUNCTION(this);
+    m_calculus.Evaluate();
+}
+
+const NetworkCalculus&
+NetworkCalculusHelper::GetNetworkCalculus() const
+{
+    return m_calculus;
+}
+
+void
+NetworkCalculusHelper::PrintBounds(std::ostream& os) const
+{
+    for (uint32_t i = 0; i < m_calculus.GetNServers(); i++)
+    {
+        os << "Server " << m_calculus.GetServerName(i)
+           << " utilization: " << m_calculus.GetUtilization(i)
+           << " backlog bound: " << m_calculus.GetServerBacklogBound(i) << " bytes" << std::endl;
+    }
+    for (uint32_t i = 0; i < m_calculus.GetNFlows(); i++)
+    {
+        os << "Flow " << m_calculus.GetFlowName(i) << " (" << m_destinations[i].address << ":"
+           << m_destinations[i].port << ") delay bound: " << m_calculus.GetDelayBound(i) * 1e6
+           << " us backlog bound: " << m_calculus.GetBacklogBound(i) << " bytes" << std::endl;
+    }
+}
+
+uint32_t
+NetworkCalculusHelper::Compare(Ptr<FlowMonitor> monitor,
+                               Ptr<Ipv4FlowClassifier> classifier,
+                               std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this << monitor << classifier);
+    std::vector<Time> observed(m_destinations.size());
+    std::vector<bool> found(m_destinations.size(), false);
+    for (const auto& entry : monitor->GetFlowStats())
+    {
+        if (entry.second.rxPackets == 0)
+        {
+            continue;
+        }
+        Ipv4FlowClassifier::FiveTuple t = classifier->FindFlow(entry.first);
+        for (std::size_t i = 0; i < m_destinations.size(); i++)
+        {
+            if (t.destinationAddress == m_destinations[i].address &&
+                t.destinationPort == m_destinations[i].port)
+            {
+                observed[i] = std::max(observed[i], entry.second.maxDelay);
+                found[i] = true;
+            }
+        }
+    }
+
+    uint32_t violations = 0;
+    for (uint32_t i = 0; i < m_destinations.size(); i++)
+    {
+        double bound = m_calculus.GetDelayBound(i);
+        os << "Flow " << m_calculus.GetFlowName(i) << " delay bound: " << bound * 1e6 << " us";
+        if (!found[i])
+        {
+            os << " not observed" << std::endl;
+            continue;
+        }
+        os << " max observed: " << observed[i].GetSeconds() * 1e6 << " us";
+        if (observed[i].GetSeconds() > bound)
+        {
+            violations++;
+            os << " VIOLATED";
+        }
+        os << std::endl;
+    }
+    return violations;
+}
+
+} // namespace ns3
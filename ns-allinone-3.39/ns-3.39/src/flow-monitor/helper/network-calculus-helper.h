@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef NETWORK_CALCULUS_HELPER_H
+#define NETWORK_CALCULUS_HELPER_H
+
+#include "ns3/flow-monitor.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/net-device.h"
+#include "ns3/network-calculus.h"
+#include "ns3/node.h"
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class Ipv4FlowClassifier;
+
+/**
+ * \ingroup flow-monitor
+ * \brief Helper to compute network calculus bounds (see ns3::NetworkCalculus)
+ * of UDP flows on the topology of a simulation.
+ *
+ * The route of every flow is followed hop by hop with the IPv4 routing of the
+ * nodes (it must be set up, e.g., with global routing).  Every output device
+ * crossed is a server of rate its "DataRate", followed by the "Delay" of its
+ * channel; with a PrioQueueDscpDisc root queue disc, DSCP EF is served with
+ * strict priority over the other DSCPs, which are served by the DRR quanta
+ * and the DSCP to queue map of a WrrQueueDisc child, if any, and in FIFO
+ * order otherwise.  A receiving device with "EnableSwithcingTime" adds a
+ * switching fabric server of rate its "SwitchingCapacity".  The per-packet
+ * overheads are the UDP, IP and PPP headers (without the UDP and IP headers
+ * on the wire and in the fabric with the "EnableModel" of PointToPointNetDevice).
+ *
+ * The bounds can be computed before the simulation starts (no application is
+ * needed) or at its end, to compare them with the maximum delays observed by a
+ * FlowMonitor.
+ */
+class NetworkCalculusHelper
+{
+  public:
+    NetworkCalculusHelper();
+
+    /**
+     * \brief Add a UDP flow.
+     * \param name the name of the flow
+     * \param source the node sending the flow
+     * \param destination the destination address
+     * \param port the destination port
+     * \param rate the token-bucket rate in bit/s of the UDP payload
+     * \param burst the token-bucket burst in bytes of the UDP payload
+     * \param packetSize the maximum UDP payload size in bytes
+     * \param dscp the DSCP of the packets in the queue discs crossed
+     * \return the index of the flow
+     */
+    uint32_t AddFlow(const std::string& name,
+                     Ptr<Node> source,
+                     Ipv4Address destination,
+                     uint16_t port,
+                     double rate,
+                     double burst,
+                     uint32_t packetSize,
+                     uint8_t dscp = 0);
+
+    /// Compute the bounds
+    void Evaluate();
+
+    /// \return the model, with the servers and flows added so far
+    const NetworkCalculus& GetNetworkCalculus() const;
+
+    /**
+     * \brief Print the delay and backlog bounds of the flows and the
+     * utilization and backlog bound of the servers.
+     * \param os the output stream
+     */
+    void PrintBounds(std::ostream& os) const;
+
+    /**
+     * \brief Compare the delay bounds with the maximum delays observed by a
+     * FlowMonitor (all the monitored flows to the address and port of a flow).
+     * \param monitor the flow monitor
+     * \param classifier the classifier of the flow monitor
+     * \param os the output stream for the comparison
+     * \return the number of flows whose observed maximum exceeds the bound
+     */
+    uint32_t Compare(Ptr<FlowMonitor> monitor,
+                     Ptr<Ipv4FlowClassifier> classifier,
+                     std::ostream& os) const;
+
+  private:
+    /// Queues of the server of an output device
+    struct Port
+    {
+        uint32_t server;                   //!< Index of the server
+        uint32_t express{0};               //!< Queue of DSCP EF (priority)
+        std::vector<uint32_t> queues;      //!< Queues of the other DSCPs (WRR)
+        std::map<int, int> map;            //!< DSCP to WRR queue
+    };
+
+    /**
+     * \param device an output device
+     * \param dscp the DSCP of a flow
+     * \return the index of the server of the device, with the DSCP mapped
+     */
+    uint32_t GetPortServer(Ptr<NetDevice> device, uint8_t dscp);
+
+    /**
+     * \param device a receiving device
+     * \return the index of the switching fabric server of the device, or -1
+     */
+    int32_t GetFabricServer(Ptr<NetDevice> device);
+
+    /// Destination of a flow
+    struct Destination
+    {
+        Ipv4Address address; //!< Destination address
+        uint16_t port;       //!< Destination port
+    };
+
+    NetworkCalculus m_calculus;                        //!< The model
+    std::map<Ptr<NetDevice>, Port> m_ports;           //!< Servers of the output devices
+    std::map<Ptr<NetDevice>, int32_t> m_fabrics;      //!< Servers of the receiving devices
+    std::vector<Destination> m_destinations;          //!< Destination of every flow
+};
+
+} // namespace ns3
+
+#endif /* NETWORK_CALCULUS_HELPER_H */
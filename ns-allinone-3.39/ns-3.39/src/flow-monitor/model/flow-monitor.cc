@@ -22,7 +22,9 @@
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
@@ -80,7 +82,24 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("SamplingRate",
+                          ("Track only 1 in this number of packets of every flow."),
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_samplingRate),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("HistogramBinsPerDecade",
+                          ("If not zero, the delay, jitter and flowInterruptions histograms "
+                           "use this number of logarithmic bins per decade instead of "
+                           "fixed-width bins."),
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&FlowMonitor::m_binsPerDecade),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("HistogramMinValue",
+                          ("Upper limit of the first logarithmic histogram bin."),
+                          DoubleValue(1e-6),
+                          MakeDoubleAccessor(&FlowMonitor::m_histogramMinValue),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
@@ -90,6 +109,126 @@ FlowMonitor::GetInstanceTypeId() const
     return GetTypeId();
 }
 
+FlowMonitor::TrackedPacketTable::TrackedPacketTable()
+    : m_slots(1024),
+      m_used(0),
+      m_shift(64 - 10)
+{
+}
+
+inline std::size_t
+FlowMonitor::TrackedPacketTable::Home(uint64_t key) const
+{
+    // Fibonacci hashing: the high log2(slots) bits of the product are well mixed
+    return (key * 0x9E3779B97F4A7C15ULL) >> m_shift;
+}
+
+std::size_t
+FlowMonitor::TrackedPacketTable::Find(FlowId flowId, FlowPacketId packetId) const
+{
+    uint64_t key = (uint64_t(flowId) << 32) | packetId;
+    std::size_t mask = m_slots.size() - 1;
+    for (std::size_t i = Home(key);; i = (i + 1) & mask)
+    {
+        if (m_slots[i].key == key)
+        {
+            return i;
+        }
+        if (m_slots[i].key == 0)
+        {
+            return NOT_FOUND;
+        }
+    }
+}
+
+FlowMonitor::TrackedPacket&
+FlowMonitor::TrackedPacketTable::Insert(FlowId flowId, FlowPacketId packetId)
+{
+    NS_ASSERT_MSG(flowId != 0, "Flow identifiers must not be zero");
+    if (2 * (m_used + 1) > m_slots.size())
+    {
+        Grow();
+    }
+    uint64_t key = (uint64_t(flowId) << 32) | packetId;
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t i = Home(key);
+    while (m_slots[i].key != 0 && m_slots[i].key != key)
+    {
+        i = (i + 1) & mask;
+    }
+    if (m_slots[i].key == 0)
+    {
+        m_slots[i].key = key;
+        m_used++;
+    }
+    return m_slots[i].packet;
+}
+
+void
+FlowMonitor::TrackedPacketTable::Erase(std::size_t slot)
+{
+    // backward shift deletion: move back the following entries that are
+    // not at their home slot, so that no tombstones are needed
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t hole = slot;
+    for (std::size_t i = (slot + 1) & mask; m_slots[i].key != 0; i = (i + 1) & mask)
+    {
+        std::size_t home = Home(m_slots[i].key);
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            m_slots[hole] = m_slots[i];
+            hole = i;
+        }
+    }
+    m_slots[hole].key = 0;
+    m_used--;
+}
+
+bool
+FlowMonitor::TrackedPacketTable::IsUsed(std::size_t slot) const
+{
+    return m_slots[slot].key != 0;
+}
+
+FlowId
+FlowMonitor::TrackedPacketTable::GetFlowId(std::size_t slot) const
+{
+    return m_slots[slot].key >> 32;
+}
+
+FlowMonitor::TrackedPacket&
+FlowMonitor::TrackedPacketTable::Get(std::size_t slot)
+{
+    return m_slots[slot].packet;
+}
+
+std::size_t
+FlowMonitor::TrackedPacketTable::GetCapacity() const
+{
+    return m_slots.size();
+}
+
+void
+FlowMonitor::TrackedPacketTable::Grow()
+{
+    std::vector<Slot> old(2 * m_slots.size());
+    old.swap(m_slots);
+    m_shift--;
+    std::size_t mask = m_slots.size() - 1;
+    for (const auto& slot : old)
+    {
+        if (slot.key != 0)
+        {
+            std::size_t i = Home(slot.key);
+            while (m_slots[i].key != 0)
+            {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = slot;
+        }
+    }
+}
+
 FlowMonitor::FlowMonitor()
     : m_enabled(false)
 {
@@ -120,24 +259,46 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
+    if (flowId < m_flowIndex.size() && m_flowIndex[flowId])
+    {
+        return *m_flowIndex[flowId];
+    }
     FlowStatsContainerI iter;
     iter = m_flowStats.find(flowId);
     if (iter == m_flowStats.end())
     {
         FlowMonitor::FlowStats& ref = m_flowStats[flowId];
+        // flow identifiers are consecutive, so the index stays dense
+        if (flowId < m_flowStats.size() + 1024)
+        {
+            if (flowId >= m_flowIndex.size())
+            {
+                m_flowIndex.resize(flowId + 1, nullptr);
+            }
+            m_flowIndex[flowId] = &ref;
+        }
         ref.delaySum = Seconds(0);
         ref.jitterSum = Seconds(0);
         ref.lastDelay = Seconds(0);
+        ref.maxDelay = Seconds(0);
         ref.txBytes = 0;
         ref.rxBytes = 0;
         ref.txPackets = 0;
         ref.rxPackets = 0;
+        ref.delaySamples = 0;
         ref.lostPackets = 0;
+        ref.estimatedLostPackets = 0;
         ref.timesForwarded = 0;
         ref.delayHistogram.SetDefaultBinWidth(m_delayBinWidth);
         ref.jitterHistogram.SetDefaultBinWidth(m_jitterBinWidth);
         ref.packetSizeHistogram.SetDefaultBinWidth(m_packetSizeBinWidth);
         ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
+        if (m_binsPerDecade)
+        {
+            ref.delayHistogram.SetLogBins(m_histogramMinValue, m_binsPerDecade);
+            ref.jitterHistogram.SetLogBins(m_histogramMinValue, m_binsPerDecade);
+            ref.flowInterruptionsHistogram.SetLogBins(m_histogramMinValue, m_binsPerDecade);
+        }
         return ref;
     }
     else
@@ -146,6 +307,12 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
     }
 }
 
+inline bool
+FlowMonitor::IsSampled(FlowPacketId packetId) const
+{
+    return m_samplingRate == 1 || packetId % m_samplingRate == 0;
+}
+
 void
 FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
                            uint32_t flowId,
@@ -159,14 +326,17 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         return;
     }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
-    tracked.firstSeenTime = now;
-    tracked.lastSeenTime = tracked.firstSeenTime;
-    tracked.timesForwarded = 0;
-    NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
-                                                                 << packetId << ").");
-
-    probe->AddPacketStats(flowId, packetSize, Seconds(0));
+    if (IsSampled(packetId))
+    {
+        TrackedPacket& tracked = m_trackedPackets.Insert(flowId, packetId);
+        tracked.firstSeenTime = now;
+        tracked.lastSeenTime = tracked.firstSeenTime;
+        tracked.timesForwarded = 0;
+        NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
+                                                                     << packetId << ").");
+
+        probe->AddPacketStats(flowId, packetSize, Seconds(0));
+    }
 
     FlowStats& stats = GetStatsForFlow(flowId);
     stats.txBytes += packetSize;
@@ -190,19 +360,23 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    TrackedPacketMap::iterator tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    if (!IsSampled(packetId))
+    {
+        return;
+    }
+    std::size_t slot = m_trackedPackets.Find(flowId, packetId);
+    if (slot == TrackedPacketTable::NOT_FOUND)
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    TrackedPacket& tracked = m_trackedPackets.Get(slot);
+    tracked.timesForwarded++;
+    tracked.lastSeenTime = Simulator::Now();
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
+    Time delay = (Simulator::Now() - tracked.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 }
 
@@ -218,36 +392,55 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    TrackedPacketMap::iterator tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    bool sampled = IsSampled(packetId);
+    std::size_t slot = TrackedPacketTable::NOT_FOUND;
+    if (sampled)
     {
-        NS_LOG_WARN("Received packet last-tx report (flowId="
-                    << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
-        return;
+        slot = m_trackedPackets.Find(flowId, packetId);
+        if (slot == TrackedPacketTable::NOT_FOUND)
+        {
+            NS_LOG_WARN("Received packet last-tx report (flowId=" << flowId << ", packetId="
+                                                                  << packetId
+                                                                  << ") but not known to be "
+                                                                     "transmitted.");
+            return;
+        }
     }
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
-    probe->AddPacketStats(flowId, packetSize, delay);
-
     FlowStats& stats = GetStatsForFlow(flowId);
-    stats.delaySum += delay;
-    stats.delayHistogram.AddValue(delay.GetSeconds());
-    if (stats.rxPackets > 0)
+    if (sampled)
     {
-        Time jitter = stats.lastDelay - delay;
-        if (jitter > Seconds(0))
-        {
-            stats.jitterSum += jitter;
-            stats.jitterHistogram.AddValue(jitter.GetSeconds());
-        }
-        else
+        TrackedPacket& tracked = m_trackedPackets.Get(slot);
+        Time delay = (now - tracked.firstSeenTime);
+        probe->AddPacketStats(flowId, packetSize, delay);
+
+        stats.delaySum += delay;
+        stats.delayHistogram.AddValue(delay.GetSeconds());
+        if (stats.delaySamples > 0)
         {
-            stats.jitterSum -= jitter;
-            stats.jitterHistogram.AddValue(-jitter.GetSeconds());
+            Time jitter = stats.lastDelay - delay;
+            if (jitter > Seconds(0))
+            {
+                stats.jitterSum += jitter;
+                stats.jitterHistogram.AddValue(jitter.GetSeconds());
+            }
+            else
+            {
+                stats.jitterSum -= jitter;
+                stats.jitterHistogram.AddValue(-jitter.GetSeconds());
+            }
         }
+        stats.lastDelay = delay;
+        stats.maxDelay = std::max(stats.maxDelay, delay);
+        stats.delaySamples++;
+        stats.timesForwarded += tracked.timesForwarded;
+
+        NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
+                                                                      << packetId << ").");
+
+        m_trackedPackets.Erase(slot); // we don't need to track this packet anymore
     }
-    stats.lastDelay = delay;
 
     stats.rxBytes += packetSize;
     stats.packetSizeHistogram.AddValue((double)packetSize);
@@ -266,12 +459,6 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
-
-    NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
-                                                                  << packetId << ").");
-
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
 }
 
 void
@@ -288,7 +475,11 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
         return;
     }
 
-    probe->AddPacketDropStats(flowId, packetSize, reasonCode);
+    bool sampled = IsSampled(packetId);
+    if (sampled)
+    {
+        probe->AddPacketDropStats(flowId, packetSize, reasonCode);
+    }
 
     FlowStats& stats = GetStatsForFlow(flowId);
     stats.lostPackets++;
@@ -302,14 +493,15 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    TrackedPacketMap::iterator tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked != m_trackedPackets.end())
+    std::size_t slot =
+        sampled ? m_trackedPackets.Find(flowId, packetId) : TrackedPacketTable::NOT_FOUND;
+    if (slot != TrackedPacketTable::NOT_FOUND)
     {
         // we don't need to track this packet anymore
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        m_trackedPackets.Erase(slot);
     }
 }
 
@@ -325,22 +517,32 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (TrackedPacketMap::iterator iter = m_trackedPackets.begin();
-         iter != m_trackedPackets.end();)
+    for (std::size_t slot = 0; slot < m_trackedPackets.GetCapacity();)
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
+        if (m_trackedPackets.IsUsed(slot) &&
+            now - m_trackedPackets.Get(slot).lastSeenTime >= maxDelay)
         {
-            // packet is considered lost, add it to the loss statistics
-            FlowStatsContainerI flow = m_flowStats.find(iter->first.first);
+            // packet is considered lost, add it to the loss statistics; a
+            // sampled packet stands for m_samplingRate packets of its flow,
+            // which is an estimate kept apart from the exact counts
+            FlowStatsContainerI flow = m_flowStats.find(m_trackedPackets.GetFlowId(slot));
             NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
-
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
+            if (m_samplingRate > 1)
+            {
+                flow->second.estimatedLostPackets += m_samplingRate;
+            }
+            else
+            {
+                flow->second.lostPackets++;
+            }
+
+            // we won't track it anymore; the erasure may move another
+            // packet into this slot, so it is checked again
+            m_trackedPackets.Erase(slot);
         }
         else
         {
-            iter++;
+            slot++;
         }
     }
 }
@@ -452,10 +654,14 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
         os << "<Flow flowId=\"" << flowI->first
            << "\"" ATTRIB_TIME(timeFirstTxPacket) ATTRIB_TIME(timeFirstRxPacket)
                   ATTRIB_TIME(timeLastTxPacket) ATTRIB_TIME(timeLastRxPacket) ATTRIB_TIME(delaySum)
-                      ATTRIB_TIME(jitterSum) ATTRIB_TIME(lastDelay) ATTRIB(txBytes) ATTRIB(rxBytes)
-                          ATTRIB(txPackets) ATTRIB(rxPackets) ATTRIB(lostPackets)
-                              ATTRIB(timesForwarded)
-           << ">\n";
+                      ATTRIB_TIME(jitterSum) ATTRIB_TIME(lastDelay) ATTRIB_TIME(maxDelay)
+                          ATTRIB(txBytes) ATTRIB(rxBytes) ATTRIB(txPackets) ATTRIB(rxPackets)
+                              ATTRIB(lostPackets) ATTRIB(timesForwarded);
+        if (m_samplingRate > 1)
+        {
+            os ATTRIB(delaySamples) ATTRIB(estimatedLostPackets);
+        }
+        os << ">\n";
 #undef ATTRIB_TIME
 #undef ATTRIB
 
@@ -534,6 +740,159 @@ FlowMonitor::SerializeToXmlFile(std::string fileName, bool enableHistograms, boo
     os.close();
 }
 
+void
+FlowMonitor::SerializeToCsvStream(std::ostream& os)
+{
+    NS_LOG_FUNCTION(this);
+    CheckForLostPackets();
+
+    os << "flowId,timeFirstTxPacket,timeFirstRxPacket,timeLastTxPacket,timeLastRxPacket,"
+          "delaySum,jitterSum,lastDelay,txBytes,rxBytes,txPackets,rxPackets,delaySamples,"
+          "lostPackets,estimatedLostPackets,timesForwarded,packetsDropped,bytesDropped\n";
+    for (const auto& [flowId, stats] : m_flowStats)
+    {
+        os << flowId << "," << stats.timeFirstTxPacket.GetNanoSeconds() << ","
+           << stats.timeFirstRxPacket.GetNanoSeconds() << ","
+           << stats.timeLastTxPacket.GetNanoSeconds() << ","
+           << stats.timeLastRxPacket.GetNanoSeconds() << "," << stats.delaySum.GetNanoSeconds()
+           << "," << stats.jitterSum.GetNanoSeconds() << "," << stats.lastDelay.GetNanoSeconds()
+           << "," << stats.txBytes << "," << stats.rxBytes << "," << stats.txPackets << ","
+           << stats.rxPackets << "," << stats.delaySamples << "," << stats.lostPackets << ","
+           << stats.estimatedLostPackets << "," << stats.timesForwarded;
+        // drops per reason code, separated by semicolons
+        os << ",";
+        for (std::size_t i = 0; i < stats.packetsDropped.size(); i++)
+        {
+            os << (i ? ";" : "") << stats.packetsDropped[i];
+        }
+        os << ",";
+        for (std::size_t i = 0; i < stats.bytesDropped.size(); i++)
+        {
+            os << (i ? ";" : "") << stats.bytesDropped[i];
+        }
+        os << "\n";
+    }
+}
+
+void
+FlowMonitor::SerializeHistogramsToCsvStream(std::ostream& os)
+{
+    NS_LOG_FUNCTION(this);
+    os << "flowId,histogram,start,width,count\n";
+    for (const auto& [flowId, stats] : m_flowStats)
+    {
+        const std::pair<const char*, const Histogram*> histograms[] = {
+            {"delay", &stats.delayHistogram},
+            {"jitter", &stats.jitterHistogram},
+            {"packetSize", &stats.packetSizeHistogram},
+            {"flowInterruptions", &stats.flowInterruptionsHistogram}};
+        for (const auto& [name, histogram] : histograms)
+        {
+            for (uint32_t index = 0; index < histogram->GetNBins(); index++)
+            {
+                if (histogram->GetBinCount(index))
+                {
+                    os << flowId << "," << name << "," << histogram->GetBinStart(index) << ","
+                       << histogram->GetBinWidth(index) << "," << histogram->GetBinCount(index)
+                       << "\n";
+                }
+            }
+        }
+    }
+}
+
+void
+FlowMonitor::SerializeToCsvFile(std::string fileName, std::string histogramsFileName)
+{
+    NS_LOG_FUNCTION(this << fileName << histogramsFileName);
+    std::ofstream os(fileName, std::ios::out);
+    SerializeToCsvStream(os);
+    os.close();
+    if (!histogramsFileName.empty())
+    {
+        std::ofstream hos(histogramsFileName, std::ios::out);
+        SerializeHistogramsToCsvStream(hos);
+        hos.close();
+    }
+}
+
+void
+FlowMonitor::SerializeToBinaryStream(std::ostream& os, bool enableHistograms)
+{
+    NS_LOG_FUNCTION(this << enableHistograms);
+    CheckForLostPackets();
+
+    auto write = [&os](auto value) {
+        os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    os.write("NS3FLOWM", 8);
+    write(uint32_t(1));
+    write(uint32_t(enableHistograms ? 1 : 0));
+    write(uint32_t(m_flowStats.size()));
+    for (const auto& [flowId, stats] : m_flowStats)
+    {
+        write(uint32_t(flowId));
+        for (const Time* t : {&stats.timeFirstTxPacket,
+                              &stats.timeFirstRxPacket,
+                              &stats.timeLastTxPacket,
+                              &stats.timeLastRxPacket,
+                              &stats.delaySum,
+                              &stats.jitterSum,
+                              &stats.lastDelay})
+        {
+            write(int64_t(t->GetNanoSeconds()));
+        }
+        write(uint64_t(stats.txBytes));
+        write(uint64_t(stats.rxBytes));
+        write(uint32_t(stats.txPackets));
+        write(uint32_t(stats.rxPackets));
+        write(uint32_t(stats.delaySamples));
+        write(uint32_t(stats.lostPackets));
+        write(uint32_t(stats.estimatedLostPackets));
+        write(uint32_t(stats.timesForwarded));
+        write(uint32_t(stats.packetsDropped.size()));
+        for (std::size_t i = 0; i < stats.packetsDropped.size(); i++)
+        {
+            write(uint32_t(stats.packetsDropped[i]));
+            write(uint64_t(stats.bytesDropped[i]));
+        }
+        if (enableHistograms)
+        {
+            for (const Histogram* histogram : {&stats.delayHistogram,
+                                               &stats.jitterHistogram,
+                                               &stats.packetSizeHistogram,
+                                               &stats.flowInterruptionsHistogram})
+            {
+                uint32_t nonEmpty = 0;
+                for (uint32_t index = 0; index < histogram->GetNBins(); index++)
+                {
+                    nonEmpty += histogram->GetBinCount(index) ? 1 : 0;
+                }
+                write(nonEmpty);
+                for (uint32_t index = 0; index < histogram->GetNBins(); index++)
+                {
+                    if (histogram->GetBinCount(index))
+                    {
+                        write(index);
+                        write(histogram->GetBinStart(index));
+                        write(histogram->GetBinWidth(index));
+                        write(histogram->GetBinCount(index));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+FlowMonitor::SerializeToBinaryFile(std::string fileName, bool enableHistograms)
+{
+    NS_LOG_FUNCTION(this << fileName << enableHistograms);
+    std::ofstream os(fileName, std::ios::out | std::ios::binary);
+    SerializeToBinaryStream(os, enableHistograms);
+    os.close();
+}
+
 void
 FlowMonitor::ResetAllStats()
 {
@@ -545,11 +904,14 @@ FlowMonitor::ResetAllStats()
         flowStat.delaySum = Seconds(0);
         flowStat.jitterSum = Seconds(0);
         flowStat.lastDelay = Seconds(0);
+        flowStat.maxDelay = Seconds(0);
         flowStat.txBytes = 0;
         flowStat.rxBytes = 0;
         flowStat.txPackets = 0;
         flowStat.rxPackets = 0;
+        flowStat.delaySamples = 0;
         flowStat.lostPackets = 0;
+        flowStat.estimatedLostPackets = 0;
         flowStat.timesForwarded = 0;
         flowStat.bytesDropped.clear();
         flowStat.packetsDropped.clear();
@@ -28,6 +28,7 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -46,6 +47,17 @@ namespace ns3
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * For large simulations the overhead can be reduced by:
+ *  - tracking only 1 in "SamplingRate" packets of each flow: transmitted,
+ *    received and dropped packets and bytes are still counted for all the
+ *    packets, but delays, jitters, forwarding counts, per-probe statistics
+ *    and lost packet timeouts are measured on the sampled packets only, the
+ *    latter in FlowStats::estimatedLostPackets;
+ *  - using logarithmic time histograms ("HistogramBinsPerDecade"), whose size
+ *    does not grow with the largest delay;
+ *  - installing probes only at the nodes where the flows start and end (see
+ *    FlowMonitorHelper::InstallEndpoints);
+ *  - exporting the results to CSV or binary files instead of XML.
  */
 class FlowMonitor : public Object
 {
@@ -89,6 +101,10 @@ class FlowMonitor : public Object
         /// It is stored to measure the packet's Jitter
         Time lastDelay;
 
+        /// Contains the largest end-to-end delay of the received
+        /// packets of the flow (e.g., to compare it with a delay bound)
+        Time maxDelay;
+
         /// Total number of transmitted bytes for the flow
         uint64_t txBytes;
         /// Total number of received bytes for the flow
@@ -98,13 +114,24 @@ class FlowMonitor : public Object
         /// Total number of received packets for the flow
         uint32_t rxPackets;
 
+        /// Number of received packets whose delay was measured, i.e.,
+        /// rxPackets unless packet sampling is enabled
+        uint32_t delaySamples;
+
         /// Total number of packets that are assumed to be lost,
         /// i.e. those that were transmitted but have not been reportedly
         /// received or forwarded for a long time.  By default, packets
         /// missing for a period of over 10 seconds are assumed to be
-        /// lost, although this value can be easily configured in runtime
+        /// lost, although this value can be easily configured in runtime.
+        /// With packet sampling, only the dropped packets are counted here
         uint32_t lostPackets;
 
+        /// Estimated number of packets lost without a drop report when
+        /// packet sampling is enabled: every sampled packet assumed to be
+        /// lost stands for SamplingRate packets of the flow.  Zero without
+        /// sampling, where these packets are counted in lostPackets
+        uint32_t estimatedLostPackets;
+
         /// Contains the number of times a packet has been reportedly
         /// forwarded, summed for all received packets in the flow
         uint32_t timesForwarded;
@@ -273,6 +300,44 @@ class FlowMonitor : public Object
     /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
     void SerializeToXmlFile(std::string fileName, bool enableHistograms, bool enableProbes);
 
+    /// Serializes the flow statistics to an std::ostream in CSV format, one
+    /// line per flow.  Times are in nanoseconds.
+    /// \param os the output stream
+    void SerializeToCsvStream(std::ostream& os);
+
+    /// Serializes the non-empty histogram bins to an std::ostream in CSV
+    /// format, one line per bin: flowId,histogram,start,width,count
+    /// \param os the output stream
+    void SerializeHistogramsToCsvStream(std::ostream& os);
+
+    /// Same as SerializeToCsvStream, but writes to a file instead
+    /// \param fileName name or path of the output file that will be created
+    /// \param histogramsFileName if not empty, name of the file where the histograms are written
+    void SerializeToCsvFile(std::string fileName, std::string histogramsFileName = "");
+
+    /// Serializes the flow statistics in a compact binary format, in the
+    /// native byte order:
+    ///  - header: "NS3FLOWM", uint32 version (1), uint32 flags (bit 0:
+    ///    histograms), uint32 number of flows;
+    ///  - per flow: uint32 flowId; int64 timeFirstTxPacket, timeFirstRxPacket,
+    ///    timeLastTxPacket, timeLastRxPacket, delaySum, jitterSum and lastDelay
+    ///    in nanoseconds; uint64 txBytes, rxBytes; uint32 txPackets, rxPackets,
+    ///    delaySamples, lostPackets, estimatedLostPackets, timesForwarded;
+    ///    uint32 number of drop
+    ///    reasons followed by (uint32 packets, uint64 bytes) per reason;
+    ///  - if histograms are enabled, the delay, jitter, packet size and flow
+    ///    interruptions histograms of the flow, each one as uint32 number of
+    ///    non-empty bins followed by (uint32 index, double start, double
+    ///    width, uint32 count) per bin.
+    /// \param os the output stream
+    /// \param enableHistograms if true, include also the histograms in the output
+    void SerializeToBinaryStream(std::ostream& os, bool enableHistograms);
+
+    /// Same as SerializeToBinaryStream, but writes to a file instead
+    /// \param fileName name or path of the output file that will be created
+    /// \param enableHistograms if true, include also the histograms in the output
+    void SerializeToBinaryFile(std::string fileName, bool enableHistograms);
+
     /// Reset all the statistics
     void ResetAllStats();
 
@@ -289,14 +354,67 @@ class FlowMonitor : public Object
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
     };
 
+    /// Open addressing hash table (linear probing) of the tracked packets,
+    /// keyed by (FlowId,PacketId).  Flow identifiers start at 1, so a zero
+    /// key marks an empty slot.
+    class TrackedPacketTable
+    {
+      public:
+        /// Value returned by Find when the packet is not tracked
+        static constexpr std::size_t NOT_FOUND = SIZE_MAX;
+
+        TrackedPacketTable();
+        /// \param flowId flow identification
+        /// \param packetId Packet ID
+        /// \return the slot of the packet, or NOT_FOUND
+        std::size_t Find(FlowId flowId, FlowPacketId packetId) const;
+        /// Insert a packet, or get it if it is already tracked
+        /// \param flowId flow identification
+        /// \param packetId Packet ID
+        /// \return the tracked packet data
+        TrackedPacket& Insert(FlowId flowId, FlowPacketId packetId);
+        /// Remove the packet in a slot
+        /// \param slot the slot, as returned by Find
+        void Erase(std::size_t slot);
+        /// \param slot a slot
+        /// \return true if the slot holds a packet
+        bool IsUsed(std::size_t slot) const;
+        /// \param slot a used slot
+        /// \return the flow of the packet in the slot
+        FlowId GetFlowId(std::size_t slot) const;
+        /// \param slot a used slot
+        /// \return the tracked packet data
+        TrackedPacket& Get(std::size_t slot);
+        /// \return the number of slots
+        std::size_t GetCapacity() const;
+
+      private:
+        /// Table slot
+        struct Slot
+        {
+            uint64_t key;         //!< (FlowId << 32) | PacketId, zero if empty
+            TrackedPacket packet; //!< Tracked packet data
+        };
+
+        /// \param key a key
+        /// \return the home slot of the key
+        std::size_t Home(uint64_t key) const;
+        /// Double the number of slots
+        void Grow();
+
+        std::vector<Slot> m_slots; //!< Slots (power of two)
+        std::size_t m_used;        //!< Number of used slots
+        uint32_t m_shift;          //!< 64 - log2 of the number of slots
+    };
+
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
+    /// FlowId --> FlowStats, direct index of m_flowStats
+    std::vector<FlowStats*> m_flowIndex;
 
-    /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-    TrackedPacketMap m_trackedPackets; //!< Tracked packets
-    Time m_maxPerHopDelay;             //!< Minimum per-hop delay
-    FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
+    TrackedPacketTable m_trackedPackets; //!< Tracked packets
+    Time m_maxPerHopDelay;               //!< Minimum per-hop delay
+    FlowProbeContainer m_flowProbes;     //!< all the FlowProbes
 
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
@@ -309,12 +427,19 @@ class FlowMonitor : public Object
     double m_packetSizeBinWidth;        //!< packet size bin width (for histograms)
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
+    uint32_t m_samplingRate;            //!< Track 1 in m_samplingRate packets per flow
+    uint32_t m_binsPerDecade;           //!< Logarithmic time histogram bins per decade
+    double m_histogramMinValue;         //!< First logarithmic time histogram bin limit
 
     /// Get the stats for a given flow
     /// \param flowId the Flow identification
     /// \returns the stats of the flow
     FlowStats& GetStatsForFlow(FlowId flowId);
 
+    /// \param packetId Packet ID
+    /// \returns true if the packet is tracked
+    bool IsSampled(FlowPacketId packetId) const;
+
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
 };
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor
+ * \defgroup flow-monitor-test FlowMonitor module tests
+ */
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief Probe reporting synthetic packet events.
+ */
+class TestFlowProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * \param monitor the FlowMonitor
+     */
+    TestFlowProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief Flow statistics with many concurrently tracked packets, drops and losses.
+ */
+class FlowMonitorTrackingTestCase : public TestCase
+{
+  public:
+    FlowMonitorTrackingTestCase();
+    void DoRun() override;
+
+  private:
+    /** Transmit all the packets of all the flows. */
+    void Transmit();
+    /** Receive the packets in reverse order, dropping or losing some of them. */
+    void Receive();
+
+    Ptr<FlowMonitor> m_monitor; //!< Monitor under test
+    Ptr<FlowProbe> m_probe;     //!< Reporting probe
+};
+
+/// Number of flows
+static const uint32_t N_FLOWS = 50;
+/// Number of packets per flow
+static const uint32_t N_PACKETS = 400;
+
+FlowMonitorTrackingTestCase::FlowMonitorTrackingTestCase()
+    : TestCase("FlowMonitor packet tracking")
+{
+}
+
+void
+FlowMonitorTrackingTestCase::Transmit()
+{
+    for (uint32_t p = 0; p < N_PACKETS; p++)
+    {
+        for (FlowId f = 1; f <= N_FLOWS; f++)
+        {
+            m_monitor->ReportFirstTx(m_probe, f, p, 100 + f);
+        }
+    }
+}
+
+void
+FlowMonitorTrackingTestCase::Receive()
+{
+    for (uint32_t p = N_PACKETS; p-- > 0;)
+    {
+        for (FlowId f = 1; f <= N_FLOWS; f++)
+        {
+            if (p % 50 == 3)
+            {
+                m_monitor->ReportDrop(m_probe, f, p, 100 + f, 2);
+            }
+            else if (p % 50 != 7)
+            {
+                m_monitor->ReportForwarding(m_probe, f, p, 100 + f);
+                m_monitor->ReportLastRx(m_probe, f, p, 100 + f);
+            }
+        }
+    }
+}
+
+void
+FlowMonitorTrackingTestCase::DoRun()
+{
+    m_monitor = CreateObject<FlowMonitor>();
+    m_monitor->SetAttribute("MaxPerHopDelay", TimeValue(MilliSeconds(10)));
+    m_monitor->StartRightNow();
+    m_probe = Create<TestFlowProbe>(m_monitor);
+
+    Simulator::Schedule(MilliSeconds(1), &FlowMonitorTrackingTestCase::Transmit, this);
+    Simulator::Schedule(MilliSeconds(3), &FlowMonitorTrackingTestCase::Receive, this);
+    Simulator::Stop(MilliSeconds(20));
+    Simulator::Run();
+    m_monitor->CheckForLostPackets();
+    Simulator::Destroy();
+
+    const FlowMonitor::FlowStatsContainer& stats = m_monitor->GetFlowStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.size(), N_FLOWS, "Wrong number of flows");
+    uint32_t dropped = N_PACKETS / 50;
+    uint32_t received = N_PACKETS - 2 * dropped;
+    for (const auto& [flowId, flow] : stats)
+    {
+        NS_TEST_EXPECT_MSG_EQ(flow.txPackets, N_PACKETS, "Wrong txPackets");
+        NS_TEST_EXPECT_MSG_EQ(flow.txBytes, N_PACKETS * (100 + flowId), "Wrong txBytes");
+        NS_TEST_EXPECT_MSG_EQ(flow.rxPackets, received, "Wrong rxPackets");
+        NS_TEST_EXPECT_MSG_EQ(flow.delaySamples, received, "Wrong delaySamples");
+        NS_TEST_EXPECT_MSG_EQ(flow.delaySum, MilliSeconds(2) * received, "Wrong delaySum");
+        NS_TEST_EXPECT_MSG_EQ(flow.timesForwarded, received, "Wrong timesForwarded");
+        NS_TEST_EXPECT_MSG_EQ(flow.lostPackets, 2 * dropped, "Wrong lostPackets");
+        NS_TEST_EXPECT_MSG_EQ(flow.estimatedLostPackets, 0, "Wrong estimatedLostPackets");
+        NS_TEST_ASSERT_MSG_EQ(flow.packetsDropped.size(), 3, "Wrong drop reasons");
+        NS_TEST_EXPECT_MSG_EQ(flow.packetsDropped[2], dropped, "Wrong packetsDropped");
+    }
+
+    std::ostringstream csv;
+    m_monitor->SerializeToCsvStream(csv);
+    std::string text = csv.str();
+    NS_TEST_EXPECT_MSG_EQ(uint32_t(std::count(text.begin(), text.end(), '\n')),
+                          N_FLOWS + 1,
+                          "Wrong number of CSV lines");
+    std::ostringstream bin;
+    m_monitor->SerializeToBinaryStream(bin, false);
+    NS_TEST_EXPECT_MSG_EQ(bin.str().substr(0, 8), "NS3FLOWM", "Wrong binary header");
+    // header, then per flow 4 + 7 * 8 + 2 * 8 + 7 * 4 bytes plus one drop reason record per code
+    NS_TEST_EXPECT_MSG_EQ(bin.str().size(), 20 + N_FLOWS * (104 + 3 * 12), "Wrong binary size");
+
+    m_monitor->Dispose();
+    m_monitor = nullptr;
+    m_probe = nullptr;
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief Packet sampling and logarithmic histograms.
+ */
+class FlowMonitorSamplingTestCase : public TestCase
+{
+  public:
+    FlowMonitorSamplingTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Transmit a packet and schedule its reception.
+     * \param packetId the packet
+     * \param delay the packet delay
+     */
+    void Transmit(FlowPacketId packetId, Time delay);
+    /**
+     * Receive a packet.
+     * \param packetId the packet
+     */
+    void Receive(FlowPacketId packetId);
+
+    Ptr<FlowMonitor> m_monitor; //!< Monitor under test
+    Ptr<FlowProbe> m_probe;     //!< Reporting probe
+};
+
+FlowMonitorSamplingTestCase::FlowMonitorSamplingTestCase()
+    : TestCase("FlowMonitor packet sampling and logarithmic histograms")
+{
+}
+
+void
+FlowMonitorSamplingTestCase::Transmit(FlowPacketId packetId, Time delay)
+{
+    m_monitor->ReportFirstTx(m_probe, 1, packetId, 1000);
+    Simulator::Schedule(delay, &FlowMonitorSamplingTestCase::Receive, this, packetId);
+}
+
+void
+FlowMonitorSamplingTestCase::Receive(FlowPacketId packetId)
+{
+    m_monitor->ReportLastRx(m_probe, 1, packetId, 1000);
+}
+
+void
+FlowMonitorSamplingTestCase::DoRun()
+{
+    m_monitor = CreateObject<FlowMonitor>();
+    m_monitor->SetAttribute("SamplingRate", UintegerValue(10));
+    m_monitor->SetAttribute("HistogramBinsPerDecade", UintegerValue(10));
+    m_monitor->SetAttribute("MaxPerHopDelay", TimeValue(MilliSeconds(100)));
+    m_monitor->StartRightNow();
+    m_probe = Create<TestFlowProbe>(m_monitor);
+
+    // the sampled packets have delays of 2 us .. 20 ms, the others 1 s
+    const uint32_t delays[] = {2, 20, 200, 2000, 20000};
+    for (uint32_t p = 0; p < 1000; p++)
+    {
+        Time delay = p % 10 == 0 ? MicroSeconds(delays[(p / 10) % 5]) : Seconds(1);
+        Simulator::Schedule(MicroSeconds(p), &FlowMonitorSamplingTestCase::Transmit, this, p, delay);
+    }
+    // 20 packets never received, 2 of them sampled
+    for (uint32_t p = 1000; p < 1020; p++)
+    {
+        Simulator::Schedule(MicroSeconds(p),
+                            &FlowMonitorSamplingTestCase::Transmit,
+                            this,
+                            p,
+                            Seconds(10));
+    }
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+    m_monitor->CheckForLostPackets();
+    Simulator::Destroy();
+
+    const FlowMonitor::FlowStats& flow = m_monitor->GetFlowStats().at(1);
+    NS_TEST_EXPECT_MSG_EQ(flow.txPackets, 1020, "Wrong txPackets");
+    NS_TEST_EXPECT_MSG_EQ(flow.rxPackets, 1000, "Wrong rxPackets");
+    NS_TEST_EXPECT_MSG_EQ(flow.lostPackets, 0, "Estimate counted as exact losses");
+    NS_TEST_EXPECT_MSG_EQ(flow.estimatedLostPackets, 20, "Wrong estimatedLostPackets");
+    NS_TEST_EXPECT_MSG_EQ(flow.rxBytes, 1000000, "Wrong rxBytes");
+    NS_TEST_EXPECT_MSG_EQ(flow.delaySamples, 100, "Wrong delaySamples");
+    NS_TEST_EXPECT_MSG_EQ(flow.delaySum, MicroSeconds(20 * 22222), "Wrong delaySum");
+
+    // [0,1us) plus 10 bins per decade: 2*10^k us falls in bin 10k+4
+    NS_TEST_EXPECT_MSG_EQ(flow.delayHistogram.GetNBins(), 45, "Wrong number of delay bins");
+    NS_TEST_EXPECT_MSG_EQ(flow.delayHistogram.GetBinCount(4), 20, "Wrong delay bin count");
+    NS_TEST_EXPECT_MSG_EQ(flow.delayHistogram.GetBinCount(44), 20, "Wrong delay bin count");
+    NS_TEST_EXPECT_MSG_EQ_TOL(flow.delayHistogram.GetBinStart(44),
+                              1e-6 * std::pow(10.0, 4.3),
+                              1e-9,
+                              "Wrong delay bin start");
+
+    // 100 sampled packets sent and received, and 2 lost
+    FlowProbe::Stats probeStats = m_probe->GetStats();
+    NS_TEST_EXPECT_MSG_EQ(probeStats[1].packets, 202, "Probe stats not sampled");
+
+    m_monitor->Dispose();
+    m_monitor = nullptr;
+    m_probe = nullptr;
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", UNIT)
+{
+    AddTestCase(new FlowMonitorTrackingTestCase, TestCase::QUICK);
+    AddTestCase(new FlowMonitorSamplingTestCase, TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/data-rate.h"
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/network-calculus-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket-factory.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/udp-socket-factory.h"
+
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * Send a packet every period until the stop time.
+ * \param socket the socket
+ * \param destination the destination
+ * \param size the UDP payload size
+ * \param period the period
+ * \param stop the stop time
+ */
+static void
+SendPeriodic(Ptr<Socket> socket, Address destination, uint32_t size, Time period, Time stop)
+{
+    socket->SendTo(Create<Packet>(size), 0, destination);
+    if (Simulator::Now() + period < stop)
+    {
+        Simulator::Schedule(period, &SendPeriodic, socket, destination, size, period, stop);
+    }
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief Check the network calculus bounds of constant rate UDP flows on a
+ * chain of two hops, with DSCP priorities and WRR queues at the first one,
+ * against the maximum delays observed by a FlowMonitor.
+ */
+class NetworkCalculusHelperTestCase : public TestCase
+{
+  public:
+    NetworkCalculusHelperTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+NetworkCalculusHelperTestCase::NetworkCalculusHelperTestCase()
+    : TestCase("NetworkCalculusHelper bounds against FlowMonitor")
+{
+}
+
+void
+NetworkCalculusHelperTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(3);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("100Mbps")));
+    simpleHelper.SetChannelAttribute("Delay", TimeValue(MicroSeconds(100)));
+    NetDeviceContainer first = simpleHelper.Install(NodeContainer(nodes.Get(0), nodes.Get(1)));
+    NetDeviceContainer second = simpleHelper.Install(NodeContainer(nodes.Get(1), nodes.Get(2)));
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    // EF with priority, DSCPs 8 and 16 in two WRR queues at the first hop
+    TrafficControlHelper tch;
+    uint16_t rootHandle = tch.SetRootQueueDisc("ns3::PrioQueueDscpDisc");
+    TrafficControlHelper::ClassIdList cid =
+        tch.AddQueueDiscClasses(rootHandle, 2, "ns3::QueueDiscClass");
+    tch.AddChildQueueDisc(rootHandle, cid[0], "ns3::FifoQueueDisc");
+    tch.AddChildQueueDisc(rootHandle,
+                          cid[1],
+                          "ns3::WrrQueueDisc",
+                          "Quantum",
+                          StringValue("3000 1500"),
+                          "MapQueue",
+                          StringValue("8 0 16 1"));
+    tch.Install(first.Get(0));
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    ipv4.Assign(first);
+    ipv4.SetBase("10.1.2.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(second);
+    Ipv4StaticRoutingHelper staticRouting;
+    staticRouting.GetStaticRouting(nodes.Get(0)->GetObject<Ipv4>())
+        ->AddNetworkRouteTo("10.1.2.0", "255.255.255.0", "10.1.1.2", 1);
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    // three flows of 1000 bytes every 400 us (20 Mbit/s each), starting together
+    const uint8_t dscps[] = {46, 8, 16};
+    const uint32_t size = 1000;
+    const Time period = MicroSeconds(400);
+    NetworkCalculusHelper calculus;
+    Ipv4Address destination = interfaces.GetAddress(1);
+    for (uint16_t i = 0; i < 3; i++)
+    {
+        std::ostringstream name;
+        name << "flow" << i;
+        calculus.AddFlow(name.str(),
+                         nodes.Get(0),
+                         destination,
+                         9000 + i,
+                         8.0 * size / period.GetSeconds(),
+                         size,
+                         size,
+                         dscps[i]);
+        Ptr<Socket> sink = Socket::CreateSocket(nodes.Get(2), UdpSocketFactory::GetTypeId());
+        sink->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9000 + i));
+        Ptr<Socket> source = Socket::CreateSocket(nodes.Get(0), UdpSocketFactory::GetTypeId());
+        source->Bind();
+        source->SetIpTos(dscps[i] << 2);
+        Simulator::Schedule(Seconds(1),
+                            &SendPeriodic,
+                            source,
+                            InetSocketAddress(destination, 9000 + i),
+                            size,
+                            period,
+                            Seconds(1.1));
+    }
+    calculus.Evaluate();
+    const NetworkCalculus& model = calculus.GetNetworkCalculus();
+    NS_TEST_EXPECT_MSG_EQ(model.GetNServers(), 2, "One server per hop expected");
+    NS_TEST_EXPECT_MSG_EQ(model.IsStable(), true, "The network is not stable");
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(std::isfinite(model.GetDelayBound(i)), true, "Infinite bound");
+        // at least the transmission of the packet and the propagation, twice
+        NS_TEST_EXPECT_MSG_GT(model.GetDelayBound(i),
+                              2 * (8.0 * (size + 28) / 100e6 + 100e-6),
+                              "Delay bound below the delay of a packet alone");
+    }
+    // the EF flow only waits for one packet of the WRR queues at the first hop
+    NS_TEST_EXPECT_MSG_LT(model.GetHopDelayBound(0, 0),
+                          model.GetHopDelayBound(0, 1),
+                          "The EF flow is not served with priority");
+
+    FlowMonitorHelper flowmonHelper;
+    Ptr<FlowMonitor> monitor = flowmonHelper.Install(nodes);
+    Simulator::Stop(Seconds(1.2));
+    Simulator::Run();
+
+    std::ostringstream oss;
+    uint32_t violations = calculus.Compare(
+        monitor,
+        DynamicCast<Ipv4FlowClassifier>(flowmonHelper.GetClassifier()),
+        oss);
+    NS_TEST_EXPECT_MSG_EQ(violations, 0, "Observed delays above the bounds: " << oss.str());
+    NS_TEST_EXPECT_MSG_EQ(oss.str().find("not observed"), std::string::npos, "Flows not observed");
+    for (const auto& entry : monitor->GetFlowStats())
+    {
+        NS_TEST_EXPECT_MSG_EQ(entry.second.rxPackets, 250, "Packets lost");
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(entry.second.maxDelay,
+                                    entry.second.delaySum / entry.second.rxPackets,
+                                    "Maximum delay below the mean delay");
+        NS_TEST_EXPECT_MSG_GT(entry.second.maxDelay, MicroSeconds(200), "Maximum delay too low");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief NetworkCalculusHelper TestSuite
+ */
+class NetworkCalculusHelperTestSuite : public TestSuite
+{
+  public:
+    NetworkCalculusHelperTestSuite();
+};
+
+NetworkCalculusHelperTestSuite::NetworkCalculusHelperTestSuite()
+    : TestSuite("network-calculus-helper", UNIT)
+{
+    AddTestCase(new NetworkCalculusHelperTestCase, TestCase::QUICK);
+}
+
+static NetworkCalculusHelperTestSuite
+    g_networkCalculusHelperTestSuite; //!< Static variable for test initialization
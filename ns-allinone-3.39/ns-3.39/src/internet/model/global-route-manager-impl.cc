@@ -31,6 +31,7 @@
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/multithreaded-simulator-impl.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
 
@@ -704,6 +705,9 @@ GlobalRouteManagerImpl::InitializeRoutes()
     // Walk the list of nodes in the system.
     //
     NS_LOG_INFO("About to start SPF calculation");
+    // the partitions of a MultithreadedSimulatorImpl share this process
+    bool multithreaded =
+        bool(DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation()));
     NodeList::Iterator listEnd = NodeList::End();
     for (NodeList::Iterator i = NodeList::Begin(); i != listEnd; i++)
     {
@@ -716,7 +720,7 @@ GlobalRouteManagerImpl::InitializeRoutes()
 
         uint32_t systemId = Simulator::GetSystemId();
         // Ignore nodes that are not assigned to our systemId (distributed sim)
-        if (node->GetSystemId() != systemId)
+        if (node->GetSystemId() != systemId && !multithreaded)
         {
             continue;
         }
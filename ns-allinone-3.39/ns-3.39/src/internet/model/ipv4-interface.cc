@@ -427,4 +427,52 @@ Ipv4Interface::AddAddressCallback(
     m_addAddressCallback = addAddressCallback;
 }
 
+const Ipv4Interface::FragmentationStats&
+Ipv4Interface::GetFragmentationStats() const
+{
+    return m_fragStats;
+}
+
+void
+Ipv4Interface::NotifyFragmentation(uint32_t nFragments)
+{
+    NS_LOG_FUNCTION(this << nFragments);
+    m_fragStats.nFragmentedPackets++;
+    m_fragStats.nFragmentsSent += nFragments;
+}
+
+void
+Ipv4Interface::NotifyFragmentReceived(bool reassembled)
+{
+    NS_LOG_FUNCTION(this << reassembled);
+    m_fragStats.nFragmentsReceived++;
+    if (reassembled)
+    {
+        m_fragStats.nReassembledPackets++;
+    }
+}
+
+void
+Ipv4Interface::NotifyReassemblyTimeout()
+{
+    NS_LOG_FUNCTION(this);
+    m_fragStats.nReassemblyTimeouts++;
+}
+
+void
+Ipv4Interface::FragmentationStats::Print(std::ostream& os) const
+{
+    os << "Fragmented packets: " << nFragmentedPackets << ", fragments sent: " << nFragmentsSent
+       << ", fragments received: " << nFragmentsReceived
+       << ", reassembled packets: " << nReassembledPackets
+       << ", reassembly timeouts: " << nReassemblyTimeouts;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const Ipv4Interface::FragmentationStats& stats)
+{
+    stats.Print(os);
+    return os;
+}
+
 } // namespace ns3
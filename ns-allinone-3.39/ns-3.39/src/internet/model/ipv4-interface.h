@@ -25,6 +25,7 @@
 #include "ns3/ptr.h"
 
 #include <list>
+#include <ostream>
 
 namespace ns3
 {
@@ -213,6 +214,48 @@ class Ipv4Interface : public Object
     void AddAddressCallback(
         Callback<void, Ptr<Ipv4Interface>, Ipv4InterfaceAddress> addAddressCallback);
 
+    /**
+     * \brief Counters of the fragmentation events of this interface
+     */
+    struct FragmentationStats
+    {
+        uint64_t nFragmentedPackets{0};  //!< Packets fragmented to be sent on this interface
+        uint64_t nFragmentsSent{0};      //!< Fragments sent on this interface
+        uint64_t nFragmentsReceived{0};  //!< Fragments received on this interface
+        uint64_t nReassembledPackets{0}; //!< Packets reassembled from received fragments
+        uint64_t nReassemblyTimeouts{0}; //!< Packets whose reassembly timed out
+
+        /**
+         * \brief Print the counters.
+         * \param os the output stream
+         */
+        void Print(std::ostream& os) const;
+    };
+
+    /**
+     * \brief Get the counters of the fragmentation events of this interface
+     * \return the fragmentation counters
+     */
+    const FragmentationStats& GetFragmentationStats() const;
+
+    /**
+     * \brief Record that a packet was fragmented to be sent on this interface
+     * \param nFragments the number of fragments
+     */
+    void NotifyFragmentation(uint32_t nFragments);
+
+    /**
+     * \brief Record that a fragment was received on this interface
+     * \param reassembled true if the fragment completed a packet
+     */
+    void NotifyFragmentReceived(bool reassembled);
+
+    /**
+     * \brief Record that the reassembly of a packet whose first fragment was
+     * received on this interface timed out
+     */
+    void NotifyReassemblyTimeout();
+
   protected:
     void DoDispose() override;
 
@@ -245,12 +288,22 @@ class Ipv4Interface : public Object
     Ptr<NetDevice> m_device;            //!< The associated NetDevice
     Ptr<TrafficControlLayer> m_tc;      //!< The associated TrafficControlLayer
     Ptr<ArpCache> m_cache;              //!< ARP cache
+    FragmentationStats m_fragStats;     //!< Fragmentation counters
     Callback<void, Ptr<Ipv4Interface>, Ipv4InterfaceAddress>
         m_removeAddressCallback; //!< remove address callback
     Callback<void, Ptr<Ipv4Interface>, Ipv4InterfaceAddress>
         m_addAddressCallback; //!< add address callback
 };
 
+/**
+ * \brief Stream insertion operator.
+ *
+ * \param os the reference to the output stream
+ * \param stats the fragmentation counters
+ * \returns the reference to the output stream
+ */
+std::ostream& operator<<(std::ostream& os, const Ipv4Interface::FragmentationStats& stats);
+
 } // namespace ns3
 
 #endif
@@ -71,6 +71,13 @@ Ipv4L3Protocol::GetTypeId()
                           TimeValue(Seconds(30)),
                           MakeTimeAccessor(&Ipv4L3Protocol::m_fragmentExpirationTimeout),
                           MakeTimeChecker())
+            .AddAttribute("ReassemblySlots",
+                          "The number of packets that can be under reassembly "
+                          "without rehashing the buffer of fragments.",
+                          UintegerValue(64),
+                          MakeUintegerAccessor(&Ipv4L3Protocol::SetReassemblySlots,
+                                               &Ipv4L3Protocol::GetReassemblySlots),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("EnableDuplicatePacketDetection",
                           "Enable multicast duplicate packet detection based on RFC 6621",
                           BooleanValue(false),
@@ -303,6 +310,7 @@ Ipv4L3Protocol::SetRoutingProtocol(Ptr<Ipv4RoutingProtocol> routingProtocol)
     NS_LOG_FUNCTION(this << routingProtocol);
     m_routingProtocol = routingProtocol;
     m_routingProtocol->SetIpv4(this);
+    Ipv4RoutingProtocol::InvalidateRouteCaches();
 }
 
 Ptr<Ipv4RoutingProtocol>
@@ -1019,6 +1027,7 @@ Ipv4L3Protocol::SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4
         {
             std::list<Ipv4PayloadHeaderPair> listFragments;
             DoFragmentation(packet, ipHeader, outInterface->GetDevice()->GetMtu(), listFragments);
+            outInterface->NotifyFragmentation(listFragments.size());
             for (std::list<Ipv4PayloadHeaderPair>::iterator it = listFragments.begin();
                  it != listFragments.end();
                  it++)
@@ -1185,6 +1194,7 @@ Ipv4L3Protocol::AddAddress(uint32_t i, Ipv4InterfaceAddress address)
     {
         m_routingProtocol->NotifyAddAddress(i, address);
     }
+    Ipv4RoutingProtocol::InvalidateRouteCaches();
     return retVal;
 }
 
@@ -1216,6 +1226,7 @@ Ipv4L3Protocol::RemoveAddress(uint32_t i, uint32_t addressIndex)
         {
             m_routingProtocol->NotifyRemoveAddress(i, address);
         }
+        Ipv4RoutingProtocol::InvalidateRouteCaches();
         return true;
     }
     return false;
@@ -1239,6 +1250,7 @@ Ipv4L3Protocol::RemoveAddress(uint32_t i, Ipv4Address address)
         {
             m_routingProtocol->NotifyRemoveAddress(i, ifAddr);
         }
+        Ipv4RoutingProtocol::InvalidateRouteCaches();
         return true;
     }
     return false;
@@ -1383,6 +1395,7 @@ Ipv4L3Protocol::SetUp(uint32_t i)
         {
             m_routingProtocol->NotifyInterfaceUp(i);
         }
+        Ipv4RoutingProtocol::InvalidateRouteCaches();
     }
     else
     {
@@ -1404,6 +1417,7 @@ Ipv4L3Protocol::SetDown(uint32_t ifaceIndex)
     {
         m_routingProtocol->NotifyInterfaceDown(ifaceIndex);
     }
+    Ipv4RoutingProtocol::InvalidateRouteCaches();
 }
 
 bool
@@ -1488,7 +1502,9 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
 
     NS_LOG_FUNCTION(this << *packet << outIfaceMtu << &listFragments);
 
-    Ptr<Packet> p = packet->Copy();
+    // The fragments are views of the buffer of the original packet (see
+    // Packet::CreateFragment), hence the payload is never copied.
+    Ptr<const Packet> p = packet;
 
     NS_ASSERT_MSG((ipv4Header.GetSerializedSize() == 5 * 4),
                   "IPv4 fragmentation implementation only works without option headers.");
@@ -1545,11 +1561,6 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
         NS_LOG_LOGIC("Fragment check - " << fragmentHeader.GetFragmentOffset());
 
         NS_LOG_LOGIC("New fragment Header " << fragmentHeader);
-
-        std::ostringstream oss;
-        oss << fragmentHeader;
-        fragment->Print(oss);
-
         NS_LOG_LOGIC("New fragment " << *fragment);
 
         listFragments.emplace_back(fragment, fragmentHeader);
@@ -1570,41 +1581,40 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
         uint32_t(ipHeader.GetIdentification()) << 16 | uint32_t(ipHeader.GetProtocol());
     FragmentKey_t key;
     bool ret = false;
-    Ptr<Packet> p = packet->Copy();
 
     key.first = addressCombination;
     key.second = idProto;
 
-    Ptr<Fragments> fragments;
-
-    MapFragments_t::iterator it = m_fragments.find(key);
-    if (it == m_fragments.end())
+    // a single lookup both finds the fragments of the packet and, for the first
+    // fragment, inserts the (empty) entry
+    auto [it, inserted] = m_fragments.try_emplace(key);
+    if (inserted)
     {
-        fragments = Create<Fragments>();
-        m_fragments.insert(std::make_pair(key, fragments));
-
+        it->second = Create<Fragments>();
         FragmentsTimeoutsListI_t iter = SetTimeout(key, ipHeader, iif);
-        fragments->SetTimeoutIter(iter);
-    }
-    else
-    {
-        fragments = it->second;
+        it->second->SetTimeoutIter(iter);
     }
+    Ptr<Fragments> fragments = it->second;
 
     NS_LOG_LOGIC("Adding fragment - Size: " << packet->GetSize()
                                             << " - Offset: " << (ipHeader.GetFragmentOffset()));
 
-    fragments->AddFragment(p, ipHeader.GetFragmentOffset(), !ipHeader.IsLastFragment());
+    // the packet is a private copy made by LocalDeliver, hence it can be stored as is
+    fragments->AddFragment(packet, ipHeader.GetFragmentOffset(), !ipHeader.IsLastFragment());
 
     if (fragments->IsEntire())
     {
         packet = fragments->GetPacket();
         m_timeoutEventList.erase(fragments->GetTimeoutIter());
-        fragments = nullptr;
-        m_fragments.erase(key);
+        m_fragments.erase(it);
         ret = true;
     }
 
+    if (iif < m_interfaces.size())
+    {
+        m_interfaces[iif]->NotifyFragmentReceived(ret);
+    }
+
     return ret;
 }
 
@@ -1621,14 +1631,12 @@ Ipv4L3Protocol::Fragments::AddFragment(Ptr<Packet> fragment,
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
 
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
-
-    for (it = m_fragments.begin(); it != m_fragments.end(); it++)
+    // Fragments usually arrive in order, hence look for the insertion point
+    // (after the last fragment whose offset is not greater) from the end.
+    auto it = m_fragments.end();
+    while (it != m_fragments.begin() && std::prev(it)->second > fragmentOffset)
     {
-        if (it->second > fragmentOffset)
-        {
-            break;
-        }
+        it--;
     }
 
     if (it == m_fragments.end())
@@ -1771,6 +1779,10 @@ Ipv4L3Protocol::HandleFragmentsTimeout(FragmentKey_t key, Ipv4Header& ipHeader,
         icmp->SendTimeExceededTtl(ipHeader, packet, true);
     }
     m_dropTrace(ipHeader, packet, DROP_FRAGMENT_TIMEOUT, this, iif);
+    if (iif < m_interfaces.size())
+    {
+        m_interfaces[iif]->NotifyReassemblyTimeout();
+    }
 
     // clear the buffers
     it->second = nullptr;
@@ -1778,6 +1790,20 @@ Ipv4L3Protocol::HandleFragmentsTimeout(FragmentKey_t key, Ipv4Header& ipHeader,
     m_fragments.erase(key);
 }
 
+void
+Ipv4L3Protocol::SetReassemblySlots(uint32_t slots)
+{
+    NS_LOG_FUNCTION(this << slots);
+    m_reassemblySlots = slots;
+    m_fragments.reserve(slots);
+}
+
+uint32_t
+Ipv4L3Protocol::GetReassemblySlots() const
+{
+    return m_reassemblySlots;
+}
+
 bool
 Ipv4L3Protocol::UpdateDuplicate(Ptr<const Packet> p, const Ipv4Header& header)
 {
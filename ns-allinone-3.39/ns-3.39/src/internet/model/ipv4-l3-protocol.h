@@ -33,6 +33,7 @@
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 class Ipv4L3ProtocolTestCase;
@@ -501,6 +502,21 @@ class Ipv4L3Protocol : public Ipv4
     /// Key identifying a fragmented packet
     typedef std::pair<uint64_t, uint32_t> FragmentKey_t;
 
+    /// Hash function for the keys identifying fragmented packets
+    struct FragmentKeyHash
+    {
+        /**
+         * \brief Hash a key.
+         * \param key the key identifying a fragmented packet
+         * \return the hash of the key
+         */
+        std::size_t operator()(const FragmentKey_t& key) const
+        {
+            // src+dst addresses mixed with the (multiplicatively hashed) id+proto
+            return std::hash<uint64_t>()(key.first ^ (key.second * 0x9e3779b97f4a7c15ULL));
+        }
+    };
+
     /// Container for fragment timeouts.
     typedef std::list<std::tuple<Time, FragmentKey_t, Ipv4Header, uint32_t>>
         FragmentsTimeoutsList_t;
@@ -590,7 +606,7 @@ class Ipv4L3Protocol : public Ipv4
         bool m_moreFragment;
 
         /**
-         * \brief The current fragments.
+         * \brief The current fragments, sorted by offset.
          */
         std::list<std::pair<Ptr<Packet>, uint16_t>> m_fragments;
 
@@ -601,9 +617,23 @@ class Ipv4L3Protocol : public Ipv4
     };
 
     /// Container of fragments, stored as pairs(src+dst addr, src+dst port) / fragment
-    typedef std::map<FragmentKey_t, Ptr<Fragments>> MapFragments_t;
+    typedef std::unordered_map<FragmentKey_t, Ptr<Fragments>, FragmentKeyHash> MapFragments_t;
+
+    /**
+     * \brief Set the number of packets that can be under reassembly without
+     * rehashing the container of fragments.
+     * \param slots the number of preallocated slots
+     */
+    void SetReassemblySlots(uint32_t slots);
+
+    /**
+     * \brief Get the number of preallocated slots of the container of fragments.
+     * \return the number of preallocated slots
+     */
+    uint32_t GetReassemblySlots() const;
 
     MapFragments_t m_fragments;       //!< Fragmented packets.
+    uint32_t m_reassemblySlots;       //!< Preallocated slots of the container of fragments
     Time m_fragmentExpirationTimeout; //!< Expiration timeout
 
     /// IETF RFC 6621, Section 6.2 de-duplication w/o IPSec
@@ -27,6 +27,8 @@ NS_LOG_COMPONENT_DEFINE("Ipv4RoutingProtocol");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4RoutingProtocol);
 
+std::atomic<uint64_t> Ipv4RoutingProtocol::m_routeGeneration{0};
+
 TypeId
 Ipv4RoutingProtocol::GetTypeId()
 {
@@ -35,4 +37,16 @@ Ipv4RoutingProtocol::GetTypeId()
     return tid;
 }
 
+void
+Ipv4RoutingProtocol::InvalidateRouteCaches()
+{
+    m_routeGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t
+Ipv4RoutingProtocol::GetRouteGeneration()
+{
+    return m_routeGeneration.load(std::memory_order_relaxed);
+}
+
 } // namespace ns3
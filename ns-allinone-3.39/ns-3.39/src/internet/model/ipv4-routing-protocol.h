@@ -28,6 +28,8 @@
 #include "ns3/packet.h"
 #include "ns3/socket.h"
 
+#include <atomic>
+
 namespace ns3
 {
 
@@ -181,6 +183,30 @@ class Ipv4RoutingProtocol : public Object
      */
     virtual void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                                    Time::Unit unit = Time::S) const = 0;
+
+    /**
+     * \brief Invalidate the routes cached by the upper layers (e.g., by UDP
+     * sockets, see the RouteCache attribute of UdpSocketImpl).
+     *
+     * Routing protocols call this method whenever their routes change; the
+     * Ipv4L3Protocol calls it whenever an interface or an address changes.
+     */
+    static void InvalidateRouteCaches();
+
+    /**
+     * \brief Get the generation of the routes, which is incremented every time
+     * the routes cached by the upper layers are invalidated.
+     * \return the generation of the routes
+     */
+    static uint64_t GetRouteGeneration();
+
+  private:
+    /**
+     * Generation of the routes.  It is shared by all the simulations of the
+     * process, so that an invalidation is seen from every thread; a spurious
+     * invalidation caused by another simulation only costs a route lookup.
+     */
+    static std::atomic<uint64_t> m_routeGeneration;
 };
 
 } // namespace ns3
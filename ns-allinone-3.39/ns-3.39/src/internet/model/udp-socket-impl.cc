@@ -33,6 +33,7 @@
 #include "ipv6.h"
 #include "udp-l4-protocol.h"
 
+#include "ns3/boolean.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/inet6-socket-address.h"
 #include "ns3/log.h"
@@ -75,7 +76,16 @@ UdpSocketImpl::GetTypeId()
                           "Callback invoked whenever an icmpv6 error is received on this socket.",
                           CallbackValue(),
                           MakeCallbackAccessor(&UdpSocketImpl::m_icmpCallback6),
-                          MakeCallbackChecker());
+                          MakeCallbackChecker())
+            .AddAttribute("RouteCache",
+                          "Cache the IPv4 route to the last destination and reuse it until "
+                          "the routes change (see Ipv4RoutingProtocol::InvalidateRouteCaches). "
+                          "Only use it with routing protocols that notify their changes "
+                          "(static, global, list routing) and that do not choose a route "
+                          "per packet (e.g., global routing with RandomEcmpRouting).",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&UdpSocketImpl::m_routeCache),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -88,7 +98,9 @@ UdpSocketImpl::UdpSocketImpl()
       m_shutdownSend(false),
       m_shutdownRecv(false),
       m_connected(false),
-      m_rxAvailable(0)
+      m_rxAvailable(0),
+      m_routeCache(false),
+      m_cachedRouteGeneration(0)
 {
     NS_LOG_FUNCTION(this);
     m_allowBroadcast = false;
@@ -181,6 +193,7 @@ UdpSocketImpl::Destroy()
         m_udp->RemoveSocket(this);
     }
     m_endPoint = nullptr;
+    m_cachedRoute = nullptr;
 }
 
 void
@@ -417,6 +430,7 @@ UdpSocketImpl::Connect(const Address& address)
         m_defaultAddress = Address(transport.GetIpv4());
         m_defaultPort = transport.GetPort();
         SetIpTos(transport.GetTos());
+        m_cachedRoute = nullptr;
         m_connected = true;
         NotifyConnectionSucceeded();
     }
@@ -633,13 +647,26 @@ UdpSocketImpl::DoSendTo(Ptr<Packet> p, Ipv4Address dest, uint16_t port, uint8_t
     }
     else if (ipv4->GetRoutingProtocol())
     {
+        if (m_cachedRoute && m_cachedDest == dest &&
+            m_cachedRouteGeneration == Ipv4RoutingProtocol::GetRouteGeneration())
+        {
+            // the route (and the subnet-directed broadcast check) is still valid
+            m_udp->Send(p->Copy(),
+                        m_cachedRoute->GetSource(),
+                        dest,
+                        m_endPoint->GetLocalPort(),
+                        port,
+                        m_cachedRoute);
+            NotifyDataSent(p->GetSize());
+            return p->GetSize();
+        }
+
         Ipv4Header header;
         header.SetDestination(dest);
         header.SetProtocol(UdpL4Protocol::PROT_NUMBER);
         Socket::SocketErrno errno_;
         Ptr<Ipv4Route> route;
         Ptr<NetDevice> oif = m_boundnetdevice; // specify non-zero if bound to a specific device
-        // TBD-- we could cache the route and just check its validity
         route = ipv4->GetRoutingProtocol()->RouteOutput(p, header, oif, errno_);
         if (route)
         {
@@ -661,6 +688,12 @@ UdpSocketImpl::DoSendTo(Ptr<Packet> p, Ipv4Address dest, uint16_t port, uint8_t
             }
 
             header.SetSource(route->GetSource());
+            if (m_routeCache)
+            {
+                m_cachedRoute = route;
+                m_cachedDest = dest;
+                m_cachedRouteGeneration = Ipv4RoutingProtocol::GetRouteGeneration();
+            }
             m_udp->Send(p->Copy(),
                         header.GetSource(),
                         header.GetDestination(),
@@ -984,6 +1017,7 @@ UdpSocketImpl::BindToNetDevice(Ptr<NetDevice> netdevice)
     Ptr<NetDevice> oldBoundNetDevice = m_boundnetdevice;
 
     Socket::BindToNetDevice(netdevice); // Includes sanity check
+    m_cachedRoute = nullptr;
     if (m_endPoint != nullptr)
     {
         m_endPoint->BindToNetDevice(netdevice);
@@ -1244,6 +1278,8 @@ bool
 UdpSocketImpl::SetAllowBroadcast(bool allowBroadcast)
 {
     m_allowBroadcast = allowBroadcast;
+    // the cached route might not have been checked against subnet-directed broadcasts
+    m_cachedRoute = nullptr;
     return true;
 }
 
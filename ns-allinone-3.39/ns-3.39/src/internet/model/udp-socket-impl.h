@@ -42,6 +42,7 @@ class Packet;
 class UdpL4Protocol;
 class Ipv6Header;
 class Ipv6Interface;
+class Ipv4Route;
 
 /**
  * \ingroup socket
@@ -277,6 +278,11 @@ class UdpSocketImpl : public UdpSocket
     int32_t m_ipMulticastIf;  //!< Multicast Interface
     bool m_ipMulticastLoop;   //!< Allow multicast loop
     bool m_mtuDiscover;       //!< Allow MTU discovery
+
+    bool m_routeCache;                //!< Cache the IPv4 route to the last destination
+    Ptr<Ipv4Route> m_cachedRoute;     //!< Cached IPv4 route
+    Ipv4Address m_cachedDest;         //!< Destination the cached route was looked up for
+    uint64_t m_cachedRouteGeneration; //!< Generation of the routes when the route was cached
 };
 
 } // namespace ns3
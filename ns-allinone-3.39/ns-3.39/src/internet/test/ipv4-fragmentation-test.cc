@@ -27,6 +27,7 @@
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-interface.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/ipv4-raw-socket-factory.h"
@@ -454,6 +455,16 @@ Ipv4FragmentationTest::DoRun()
                               "Packet content differs");
     }
 
+    // The packets but the first one are fragmented (in 2, 4, 7 and 44 fragments)
+    const Ipv4Interface::FragmentationStats& clientStats =
+        clientNode->GetObject<Ipv4L3Protocol>()->GetInterface(netdev_idx)->GetFragmentationStats();
+    const Ipv4Interface::FragmentationStats& serverStats =
+        serverNode->GetObject<Ipv4L3Protocol>()->GetInterface(1)->GetFragmentationStats();
+    NS_TEST_EXPECT_MSG_EQ(clientStats.nFragmentedPackets, 4, "Wrong number of fragmented packets");
+    NS_TEST_EXPECT_MSG_EQ(clientStats.nFragmentsSent, 57, "Wrong number of fragments sent");
+    NS_TEST_EXPECT_MSG_EQ(serverStats.nFragmentsReceived, 57, "Wrong number of fragments received");
+    NS_TEST_EXPECT_MSG_EQ(serverStats.nReassembledPackets, 4, "Wrong number of reassemblies");
+
     // Second test: normal channel, no errors, delays each 2 packets.
     // Each other fragment will arrive out-of-order.
     // The packets should be received correctly since reassembly will reorder the fragments.
@@ -518,6 +529,8 @@ Ipv4FragmentationTest::DoRun()
                               "Client did not receive ICMP::TIME_EXCEEDED");
     }
 
+    NS_TEST_EXPECT_MSG_EQ(serverStats.nReassemblyTimeouts, 4, "Wrong number of timeouts");
+
     // Fourth test: normal channel, no errors, no delays.
     // We check tags
     clientDevErrorModel->Disable();
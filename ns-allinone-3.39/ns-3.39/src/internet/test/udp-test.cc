@@ -30,7 +30,10 @@
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv4-list-routing.h"
+#include "ns3/ipv4-packet-info-tag.h"
 #include "ns3/ipv4-queue-disc-item.h"
+#include "ns3/ipv4-routing-table-entry.h"
+#include "ns3/ipv4-static-routing-helper.h"
 #include "ns3/ipv4-static-routing.h"
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
@@ -762,6 +765,243 @@ Udp6SocketImplTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 routing protocol which finds no route and counts the route lookups
+ */
+class Ipv4CountingRouting : public Ipv4RoutingProtocol
+{
+  public:
+    Ptr<Ipv4Route> RouteOutput(Ptr<Packet> p,
+                               const Ipv4Header& header,
+                               Ptr<NetDevice> oif,
+                               Socket::SocketErrno& sockerr) override
+    {
+        m_routeOutputs++;
+        return nullptr;
+    }
+
+    bool RouteInput(Ptr<const Packet> p,
+                    const Ipv4Header& header,
+                    Ptr<const NetDevice> idev,
+                    const UnicastForwardCallback& ucb,
+                    const MulticastForwardCallback& mcb,
+                    const LocalDeliverCallback& lcb,
+                    const ErrorCallback& ecb) override
+    {
+        return false;
+    }
+
+    void NotifyInterfaceUp(uint32_t interface) override
+    {
+    }
+
+    void NotifyInterfaceDown(uint32_t interface) override
+    {
+    }
+
+    void NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress address) override
+    {
+    }
+
+    void NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress address) override
+    {
+    }
+
+    void SetIpv4(Ptr<Ipv4> ipv4) override
+    {
+    }
+
+    void PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit unit) const override
+    {
+    }
+
+    uint32_t m_routeOutputs{0}; //!< Number of route lookups
+};
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check that a UDP socket with the RouteCache attribute set follows
+ * the changes of the static routes
+ */
+class UdpSocketRouteCacheTest : public TestCase
+{
+    uint32_t m_rxDevice; //!< Index of the device that received the last packet
+
+    /**
+     * \brief Send data.
+     * \param socket The sending socket.
+     */
+    void DoSendData(Ptr<Socket> socket);
+
+    /**
+     * \brief Send data and run the simulation.
+     * \param socket The sending socket.
+     */
+    void SendData(Ptr<Socket> socket);
+
+    /**
+     * \brief Set the host route to the destination of the test.
+     * \param routing The static routing of the sender.
+     * \param gateway The gateway.
+     * \param interface The output interface.
+     */
+    void SetHostRoute(Ptr<Ipv4StaticRouting> routing, Ipv4Address gateway, uint32_t interface);
+
+  public:
+    void DoRun() override;
+    UdpSocketRouteCacheTest();
+
+    /**
+     * \brief Receive packets.
+     * \param socket The receiving socket.
+     */
+    void ReceivePkt(Ptr<Socket> socket);
+};
+
+UdpSocketRouteCacheTest::UdpSocketRouteCacheTest()
+    : TestCase("UDP socket route cache"),
+      m_rxDevice(0)
+{
+}
+
+void
+UdpSocketRouteCacheTest::ReceivePkt(Ptr<Socket> socket)
+{
+    Ptr<Packet> packet = socket->Recv(std::numeric_limits<uint32_t>::max(), 0);
+    Ipv4PacketInfoTag tag;
+    NS_TEST_ASSERT_MSG_EQ(packet->RemovePacketTag(tag), true, "No packet info tag");
+    m_rxDevice = tag.GetRecvIf();
+}
+
+void
+UdpSocketRouteCacheTest::DoSendData(Ptr<Socket> socket)
+{
+    NS_TEST_EXPECT_MSG_EQ(socket->Send(Create<Packet>(123), 0), 123, "100");
+}
+
+void
+UdpSocketRouteCacheTest::SendData(Ptr<Socket> socket)
+{
+    m_rxDevice = std::numeric_limits<uint32_t>::max();
+    Simulator::ScheduleWithContext(socket->GetNode()->GetId(),
+                                   Seconds(0),
+                                   &UdpSocketRouteCacheTest::DoSendData,
+                                   this,
+                                   socket);
+    Simulator::Run();
+}
+
+void
+UdpSocketRouteCacheTest::SetHostRoute(Ptr<Ipv4StaticRouting> routing,
+                                      Ipv4Address gateway,
+                                      uint32_t interface)
+{
+    for (uint32_t i = 0; i < routing->GetNRoutes(); i++)
+    {
+        if (routing->GetRoute(i).GetDest() == Ipv4Address("10.0.2.1"))
+        {
+            routing->RemoveRoute(i);
+            break;
+        }
+    }
+    routing->AddHostRouteTo(Ipv4Address("10.0.2.1"), gateway, interface);
+}
+
+void
+UdpSocketRouteCacheTest::DoRun()
+{
+    // Two links between the nodes; the destination address (10.0.2.1) is reachable
+    // through both of them and the sender chooses one with a host route
+    Ptr<Node> rxNode = CreateObject<Node>();
+    Ptr<Node> txNode = CreateObject<Node>();
+    NodeContainer nodes(rxNode, txNode);
+
+    SimpleNetDeviceHelper helperChannel;
+    helperChannel.SetNetDevicePointToPointMode(true);
+    NetDeviceContainer net1 = helperChannel.Install(nodes);
+    NetDeviceContainer net2 = helperChannel.Install(nodes);
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    const char* rxAddresses[] = {"10.0.0.1", "10.0.1.1"};
+    const char* txAddresses[] = {"10.0.0.2", "10.0.1.2"};
+    NetDeviceContainer links[] = {net1, net2};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<Ipv4> ipv4 = rxNode->GetObject<Ipv4>();
+        uint32_t idx = ipv4->AddInterface(links[i].Get(0));
+        ipv4->AddAddress(idx, Ipv4InterfaceAddress(Ipv4Address(rxAddresses[i]), Ipv4Mask("/24")));
+        ipv4->SetUp(idx);
+
+        ipv4 = txNode->GetObject<Ipv4>();
+        idx = ipv4->AddInterface(links[i].Get(1));
+        ipv4->AddAddress(idx, Ipv4InterfaceAddress(Ipv4Address(txAddresses[i]), Ipv4Mask("/24")));
+        ipv4->SetUp(idx);
+    }
+    rxNode->GetObject<Ipv4>()->AddAddress(
+        1,
+        Ipv4InterfaceAddress(Ipv4Address("10.0.2.1"), Ipv4Mask("/32")));
+
+    Ptr<Socket> rxSocket = rxNode->GetObject<UdpSocketFactory>()->CreateSocket();
+    rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1234));
+    rxSocket->SetRecvPktInfo(true);
+    rxSocket->SetRecvCallback(MakeCallback(&UdpSocketRouteCacheTest::ReceivePkt, this));
+
+    Ipv4StaticRoutingHelper routingHelper;
+    Ptr<Ipv4StaticRouting> txRouting =
+        routingHelper.GetStaticRouting(txNode->GetObject<Ipv4>());
+    SetHostRoute(txRouting, Ipv4Address("10.0.0.1"), 1);
+
+    // asked before the static routing, it counts the route lookups of the sender
+    Ptr<Ipv4CountingRouting> counting = CreateObject<Ipv4CountingRouting>();
+    Ptr<Ipv4ListRouting> txListRouting =
+        DynamicCast<Ipv4ListRouting>(txNode->GetObject<Ipv4>()->GetRoutingProtocol());
+    txListRouting->AddRoutingProtocol(counting, 10);
+
+    Ptr<Socket> txSocket = txNode->GetObject<UdpSocketFactory>()->CreateSocket();
+    txSocket->SetAttribute("RouteCache", BooleanValue(true));
+    txSocket->Connect(InetSocketAddress(Ipv4Address("10.0.2.1"), 1234));
+
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_rxDevice, 0, "Packet should be received on the first link");
+    NS_TEST_EXPECT_MSG_EQ(counting->m_routeOutputs, 1, "The route should be looked up");
+    // the cached route is used
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_rxDevice, 0, "Packet should be received on the first link");
+    NS_TEST_EXPECT_MSG_EQ(counting->m_routeOutputs, 1, "The cached route should be used");
+
+    // a route change invalidates the cached route
+    SetHostRoute(txRouting, Ipv4Address("10.0.1.1"), 2);
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_rxDevice, 1, "Packet should be received on the second link");
+
+    // taking an interface down (which removes its routes) invalidates the cached route as well
+    txRouting->AddNetworkRouteTo(Ipv4Address("10.0.2.0"),
+                                 Ipv4Mask("/24"),
+                                 Ipv4Address("10.0.0.1"),
+                                 1);
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_rxDevice, 1, "Packet should be received on the second link");
+    txNode->GetObject<Ipv4>()->SetDown(2);
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_rxDevice, 0, "Packet should be received on the first link");
+
+    // the cached network route, whose destination is the network address, is used as well
+    uint32_t routeOutputs = counting->m_routeOutputs;
+    SendData(txSocket);
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_rxDevice, 0, "Packet should be received on the first link");
+    NS_TEST_EXPECT_MSG_EQ(counting->m_routeOutputs,
+                          routeOutputs,
+                          "The cached network route should be used");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -775,6 +1015,7 @@ class UdpTestSuite : public TestSuite
     {
         AddTestCase(new UdpSocketImplTest, TestCase::QUICK);
         AddTestCase(new UdpSocketLoopbackTest, TestCase::QUICK);
+        AddTestCase(new UdpSocketRouteCacheTest, TestCase::QUICK);
         AddTestCase(new Udp6SocketImplTest, TestCase::QUICK);
         AddTestCase(new Udp6SocketLoopbackTest, TestCase::QUICK);
     }
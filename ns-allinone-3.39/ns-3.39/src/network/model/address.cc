@@ -22,6 +22,7 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -146,9 +147,8 @@ uint8_t
 Address::Register()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static uint8_t type = 1;
-    type++;
-    return type;
+    static std::atomic<uint8_t> type = 1;
+    return ++type;
 }
 
 uint32_t
@@ -54,7 +54,7 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
-uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -79,9 +79,10 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+// one free list per thread, so that concurrent simulations do not share it
+thread_local uint32_t Buffer::g_maxSize = 0;
+thread_local Buffer::FreeList* Buffer::g_freeList = nullptr;
+thread_local Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 {
@@ -102,10 +103,11 @@ Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
     g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
+    /* feed into free list, unless this thread never created a buffer (the
+     * buffer was created by another partition of a MultithreadedSimulatorImpl)
+     */
+    if (data->m_size < g_maxSize || !IS_INITIALIZED(g_freeList) || g_freeList->size() > 1000)
     {
         Buffer::Deallocate(data);
     }
@@ -435,6 +437,46 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
+    uint32_t zeroSize = m_zeroAreaEnd - m_zeroAreaStart;
+    uint32_t otherZeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
+    if (m_data != o.m_data && otherZeroSize == 0)
+    {
+        /**
+         * The other buffer holds only real bytes (e.g., headers or
+         * trailers): append them after our end data and keep our
+         * zero area virtual instead of materializing it.
+         */
+        uint32_t otherSize = o.GetSize();
+        AddAtEnd(otherSize);
+        Buffer::Iterator dst = End();
+        dst.Prev(otherSize);
+        dst.Write(o.Begin(), o.End());
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+    if (m_data != o.m_data && zeroSize == 0)
+    {
+        /**
+         * We hold only real bytes: build the result around the zero
+         * area of the other buffer so that it stays virtual.
+         */
+        uint32_t size = GetSize();
+        uint32_t otherStart = o.m_zeroAreaStart - o.m_start;
+        uint32_t otherEnd = o.m_end - o.m_zeroAreaEnd;
+        Buffer tmp(otherZeroSize);
+        tmp.AddAtStart(size + otherStart);
+        Buffer::Iterator i = tmp.Begin();
+        i.Write(Begin(), End());
+        i.Write(o.m_data->m_data + o.m_start, otherStart);
+        tmp.AddAtEnd(otherEnd);
+        i = tmp.End();
+        i.Prev(otherEnd);
+        i.Write(o.m_data->m_data + o.m_zeroAreaStart, otherEnd);
+        *this = tmp;
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
     *this = CreateFullCopy();
     AddAtEnd(o.GetSize());
     Buffer::Iterator destStart = End();
@@ -838,27 +880,30 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    // the destination does not overlap our zero area: it lies either before
+    // or after it, in which case the zero area is not stored in m_data
+    uint8_t* to = &m_data[m_current <= m_zeroStart ? m_current
+                                                   : m_current - (m_zeroEnd - m_zeroStart)];
+    m_current += size;
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
-    m_current += toCopy;
 }
 
 void
@@ -1153,6 +1198,15 @@ Buffer::Iterator::CalculateIpChecksum(uint16_t size, uint32_t initialChecksum)
 
     for (int j = 0; j < size / 2; j++)
     {
+        if (m_current >= m_zeroStart && m_current + 2 <= m_zeroEnd)
+        {
+            /* words of the virtual zero area do not contribute to the
+             * sum: skip them without reading them one by one. */
+            int words = std::min<int>((m_zeroEnd - m_current) / 2, size / 2 - j);
+            m_current += 2 * words;
+            j += words - 1;
+            continue;
+        }
         sum += ReadU16();
     }
 
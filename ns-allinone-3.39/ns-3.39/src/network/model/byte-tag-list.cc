@@ -56,13 +56,19 @@ struct ByteTagListData
  *
  * Internal use only.
  */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
+class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
 {
   public:
     ~ByteTagListDataFreeList();
-} g_freeList; //!< Container for struct ByteTagListData
+};
+
+static thread_local ByteTagListDataFreeList g_freeList; //!< Container for struct ByteTagListData
+
+static thread_local uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
 
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+/// The free list of the thread was destroyed: the thread-local objects are
+/// destroyed before the static ones, which may still release tags at exit
+static thread_local bool g_freeListDestroyed = false;
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
@@ -72,6 +78,7 @@ ByteTagListDataFreeList::~ByteTagListDataFreeList()
         uint8_t* buffer = (uint8_t*)(*i);
         delete[] buffer;
     }
+    g_freeListDestroyed = true;
 }
 #endif /* USE_FREE_LIST */
 
@@ -355,7 +362,7 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
+    while (!g_freeListDestroyed && !g_freeList.empty())
     {
         ByteTagListData* data = g_freeList.back();
         g_freeList.pop_back();
@@ -389,7 +396,8 @@ ByteTagList::Deallocate(ByteTagListData* data)
     data->count--;
     if (data->count == 0)
     {
-        if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
+        if (g_freeListDestroyed || g_freeList.size() > FREE_LIST_SIZE ||
+            data->size < g_maxSize)
         {
             uint8_t* buffer = (uint8_t*)data;
             delete[] buffer;
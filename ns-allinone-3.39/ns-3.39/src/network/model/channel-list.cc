@@ -23,6 +23,7 @@
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
+#include "ns3/simulation-context.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -130,14 +131,18 @@ Ptr<ChannelListPriv>*
 ChannelListPriv::DoGet()
 {
     NS_LOG_FUNCTION_NOARGS();
+    // one list per simulation: the one of the process, shared by its
+    // threads, or the one of a replication of a SimulationContext
     static Ptr<ChannelListPriv> ptr = nullptr;
-    if (!ptr)
+    static thread_local Ptr<ChannelListPriv> replicationPtr = nullptr;
+    Ptr<ChannelListPriv>* pptr = SimulationContext::GetReplication() >= 0 ? &replicationPtr : &ptr;
+    if (!*pptr)
     {
-        ptr = CreateObject<ChannelListPriv>();
-        Config::RegisterRootNamespaceObject(ptr);
+        *pptr = CreateObject<ChannelListPriv>();
+        Config::RegisterRootNamespaceObject(*pptr);
         Simulator::ScheduleDestroy(&ChannelListPriv::Delete);
     }
-    return &ptr;
+    return pptr;
 }
 
 void
@@ -0,0 +1,769 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "multithreaded-simulator-impl.h"
+
+#include "channel-list.h"
+#include "channel.h"
+#include "net-device.h"
+#include "node-list.h"
+#include "node.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/make-event.h"
+#include "ns3/nstime.h"
+#include "ns3/simulation-context.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <thread>
+
+namespace ns3
+{
+
+// Logging in the event loop is avoided, as in DefaultSimulatorImpl
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+/// Timestamp of a partition without events
+static const uint64_t NO_EVENT = std::numeric_limits<uint64_t>::max();
+
+/**
+ * \ingroup network
+ *
+ * \brief Lock-free single-producer single-consumer queue of the events
+ * scheduled by a partition in another one.
+ *
+ * The sending partition pushes while it runs a window; the receiving
+ * partition pops at the end of the window.  The nodes are linked from the
+ * oldest, a dummy node which the consumer owns, to the newest, which the
+ * producer owns.
+ */
+class MultithreadedSimulatorImpl::RemoteQueue
+{
+  public:
+    /// An event for another partition
+    struct Item
+    {
+        uint64_t ts;       //!< Absolute timestamp
+        uint32_t context;  //!< Context
+        EventImpl* event;  //!< Event, with the reference of the sender
+    };
+
+    RemoteQueue()
+        : m_head(new Node),
+          m_tail(m_head)
+    {
+    }
+
+    ~RemoteQueue()
+    {
+        Item item;
+        while (Pop(item))
+        {
+            item.event->Unref();
+        }
+        delete m_head;
+    }
+
+    /**
+     * Push an item, from the producer thread.
+     * \param item the item
+     */
+    void Push(const Item& item)
+    {
+        Node* node = new Node;
+        node->item = item;
+        m_tail->next.store(node, std::memory_order_release);
+        m_tail = node;
+    }
+
+    /**
+     * Pop the oldest item, from the consumer thread.
+     * \param [out] item the item
+     * \return false if the queue is empty
+     */
+    bool Pop(Item& item)
+    {
+        Node* next = m_head->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return false;
+        }
+        item = next->item;
+        delete m_head;
+        m_head = next;
+        return true;
+    }
+
+  private:
+    /// A node of the list
+    struct Node
+    {
+        Item item;                       //!< The item
+        std::atomic<Node*> next{nullptr}; //!< The next (newer) node
+    };
+
+    Node* m_head; //!< Dummy node before the oldest item (consumer)
+    Node* m_tail; //!< Newest node (producer)
+};
+
+thread_local MultithreadedSimulatorImpl::Partition* MultithreadedSimulatorImpl::m_current = nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::MultithreadedSimulatorImpl")
+                            .SetParent<SimulatorImpl>()
+                            .SetGroupName("Network")
+                            .AddConstructor<MultithreadedSimulatorImpl>();
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_uid(EventId::UID::VALID),
+      m_currentUid(EventId::UID::INVALID),
+      m_currentTs(0),
+      m_currentContext(Simulator::NO_CONTEXT),
+      m_unscheduledEvents(0),
+      m_eventCount(0),
+      m_running(false),
+      m_lookahead(NO_EVENT),
+      m_windows(0),
+      m_stopRequested(false),
+      m_barrierCount(0),
+      m_barrierGeneration(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& partition : m_partitions)
+    {
+        while (!partition->events->IsEmpty())
+        {
+            Scheduler::Event next = partition->events->RemoveNext();
+            next.impl->Unref();
+        }
+    }
+    m_partitions.clear();
+    while (m_global && !m_global->events->IsEmpty())
+    {
+        Scheduler::Event next = m_global->events->RemoveNext();
+        next.impl->Unref();
+    }
+    m_global = nullptr;
+    while (m_events && !m_events->IsEmpty())
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+        next.impl->Unref();
+    }
+    m_events = nullptr;
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ABORT_MSG_IF(m_running, "The scheduler cannot be changed after the simulation ran");
+    m_schedulerFactory = schedulerFactory;
+    Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+    if (m_events)
+    {
+        while (!m_events->IsEmpty())
+        {
+            scheduler->Insert(m_events->RemoveNext());
+        }
+    }
+    m_events = scheduler;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return m_current && m_current != m_global.get() ? m_current->id : 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition(uint32_t context) const
+{
+    if (context < m_partitionOf.size())
+    {
+        return m_partitionOf[context];
+    }
+    return m_current ? m_current->id : 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::Insert(Partition& partition,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = partition.uid++;
+    partition.unscheduledEvents++;
+    partition.events->Insert(ev);
+    return ev.key.m_uid;
+}
+
+void
+MultithreadedSimulatorImpl::CreatePartitions()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t nPartitions = 1;
+    m_partitionOf.clear();
+    for (auto i = NodeList::Begin(); i != NodeList::End(); ++i)
+    {
+        m_partitionOf.push_back((*i)->GetSystemId());
+        nPartitions = std::max(nPartitions, (*i)->GetSystemId() + 1);
+    }
+
+    // the lookahead is the smallest delay of the channels between partitions
+    m_lookahead = NO_EVENT;
+    for (auto i = ChannelList::Begin(); i != ChannelList::End(); ++i)
+    {
+        std::set<uint32_t> partitions;
+        for (std::size_t d = 0; d < (*i)->GetNDevices(); d++)
+        {
+            partitions.insert((*i)->GetDevice(d)->GetNode()->GetSystemId());
+        }
+        if (partitions.size() < 2)
+        {
+            continue;
+        }
+        TimeValue delay;
+        if (!(*i)->GetAttributeFailSafe("Delay", delay))
+        {
+            NS_FATAL_ERROR("Channel " << (*i)->GetId() << " between partitions has no delay");
+        }
+        NS_ABORT_MSG_IF(!delay.Get().IsStrictlyPositive(),
+                        "Channel " << (*i)->GetId() << " between partitions without delay");
+        m_lookahead = std::min(m_lookahead, static_cast<uint64_t>(delay.Get().GetTimeStep()));
+    }
+    NS_LOG_INFO(nPartitions << " partitions, lookahead " << m_lookahead);
+
+    // the events without a node context are the last partition, with its
+    // own queue in every partition
+    for (uint32_t id = 0; id <= nPartitions; id++)
+    {
+        auto partition = std::make_unique<Partition>();
+        partition->id = id;
+        partition->events = m_schedulerFactory.Create<Scheduler>();
+        partition->currentTs = m_currentTs;
+        partition->currentContext = Simulator::NO_CONTEXT;
+        partition->currentUid = EventId::UID::INVALID;
+        partition->uid = m_uid;
+        for (uint32_t source = 0; source <= nPartitions; source++)
+        {
+            partition->inbound.push_back(std::make_unique<RemoteQueue>());
+        }
+        if (id == nPartitions)
+        {
+            m_global = std::move(partition);
+            break;
+        }
+        m_partitions.push_back(std::move(partition));
+    }
+    while (!m_events->IsEmpty())
+    {
+        Scheduler::Event ev = m_events->RemoveNext();
+        Partition& partition = ev.key.m_context < m_partitionOf.size()
+                                   ? *m_partitions[m_partitionOf[ev.key.m_context]]
+                                   : *m_global;
+        partition.events->Insert(ev);
+        partition.unscheduledEvents++;
+    }
+    m_unscheduledEvents = 0;
+    for (const auto& key : m_stopKeys)
+    {
+        for (auto& partition : m_partitions)
+        {
+            Scheduler::Event ev;
+            ev.impl = MakeEvent(&MultithreadedSimulatorImpl::StopPartition);
+            ev.key = key;
+            partition->events->Insert(ev);
+            partition->unscheduledEvents++;
+        }
+        Scheduler::Event ev;
+        ev.impl = MakeEvent(&MultithreadedSimulatorImpl::StopPartition);
+        ev.key = key;
+        m_global->events->Insert(ev);
+        m_global->unscheduledEvents++;
+    }
+    m_stopKeys.clear();
+    m_nextTs.assign(nPartitions + 1, NO_EVENT);
+}
+
+void
+MultithreadedSimulatorImpl::Wait()
+{
+    uint32_t generation = m_barrierGeneration.load(std::memory_order_acquire);
+    if (m_barrierCount.fetch_add(1, std::memory_order_acq_rel) + 1 == m_partitions.size())
+    {
+        m_barrierCount.store(0, std::memory_order_relaxed);
+        m_barrierGeneration.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    while (m_barrierGeneration.load(std::memory_order_acquire) == generation)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent(Partition& partition)
+{
+    Scheduler::Event next = partition.events->RemoveNext();
+
+    PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+    NS_ASSERT(next.key.m_ts >= partition.currentTs);
+    partition.unscheduledEvents--;
+    partition.eventCount++;
+
+    partition.currentTs = next.key.m_ts;
+    partition.currentContext = next.key.m_context;
+    partition.currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::ReceiveRemoteEvents(Partition& partition)
+{
+    // the events of the last window from the other partitions, in the
+    // order of their partitions
+    for (auto& queue : partition.inbound)
+    {
+        RemoteQueue::Item item;
+        while (queue->Pop(item))
+        {
+            Insert(partition, item.ts, item.context, item.event);
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunPartition(uint32_t id)
+{
+    Simulator::SetThreadImplementation(this);
+    Partition& partition = *m_partitions[id];
+    m_current = &partition;
+    while (true)
+    {
+        // read before the barrier: Simulator::Stop is only called in a window
+        bool stopRequested = m_stopRequested.load(std::memory_order_relaxed);
+
+        ReceiveRemoteEvents(partition);
+        m_nextTs[id] = partition.stop || partition.events->IsEmpty()
+                           ? NO_EVENT
+                           : partition.events->PeekNext().key.m_ts;
+        if (id == 0)
+        {
+            ReceiveRemoteEvents(*m_global);
+            m_nextTs.back() = m_global->stop || m_global->events->IsEmpty()
+                                  ? NO_EVENT
+                                  : m_global->events->PeekNext().key.m_ts;
+        }
+        Wait();
+
+        uint64_t next = *std::min_element(m_nextTs.begin(), m_nextTs.end());
+        if (next == NO_EVENT || stopRequested)
+        {
+            break;
+        }
+        uint64_t globalTs = m_nextTs.back();
+        if (globalTs == next)
+        {
+            if (id == 0)
+            {
+                RunGlobalEvents(globalTs);
+            }
+            Wait();
+            continue;
+        }
+        partition.windowEnd = next >= NO_EVENT - m_lookahead ? NO_EVENT : next + m_lookahead;
+        partition.windowEnd = std::min(partition.windowEnd, globalTs);
+        if (id == 0)
+        {
+            m_windows++;
+        }
+        while (!partition.stop && !partition.events->IsEmpty() &&
+               partition.events->PeekNext().key.m_ts < partition.windowEnd)
+        {
+            ProcessOneEvent(partition);
+        }
+        Wait();
+    }
+    m_current = nullptr;
+    Simulator::SetThreadImplementation(nullptr);
+}
+
+void
+MultithreadedSimulatorImpl::RunGlobalEvents(uint64_t ts)
+{
+    Partition* partition = m_current;
+    m_current = m_global.get();
+    // the partitions have run the events before ts, and no other
+    m_global->windowEnd = ts;
+    while (!m_global->stop && !m_global->events->IsEmpty() &&
+           m_global->events->PeekNext().key.m_ts == ts)
+    {
+        ProcessOneEvent(*m_global);
+    }
+    m_current = partition;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_current)
+    {
+        return m_current->stop || m_current->events->IsEmpty();
+    }
+    if (!m_running)
+    {
+        return m_events->IsEmpty();
+    }
+    for (const auto& partition : m_partitions)
+    {
+        if (!partition->stop && !partition->events->IsEmpty())
+        {
+            return false;
+        }
+    }
+    return m_global->stop || m_global->events->IsEmpty();
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_running, "MultithreadedSimulatorImpl::Run can only be called once");
+    // the threads of the partitions share the NodeList, Config... of the process
+    NS_ABORT_MSG_IF(SimulationContext::GetReplication() >= 0,
+                    "MultithreadedSimulatorImpl cannot run in a replication of a "
+                    "SimulationContext");
+    m_running = true;
+    CreatePartitions();
+
+    std::vector<std::thread> threads;
+    for (uint32_t id = 0; id < m_partitions.size(); id++)
+    {
+        threads.emplace_back(&MultithreadedSimulatorImpl::RunPartition, this, id);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& partition : m_partitions)
+    {
+        m_currentTs = std::max(m_currentTs, partition->currentTs);
+        m_eventCount += partition->eventCount;
+    }
+    m_currentTs = std::max(m_currentTs, m_global->currentTs);
+    m_eventCount += m_global->eventCount;
+}
+
+void
+MultithreadedSimulatorImpl::StopPartition()
+{
+    m_current->stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_current)
+    {
+        m_current->stop = true;
+        m_stopRequested = true;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Stop(): Negative delay");
+    if (!m_current)
+    {
+        Scheduler::EventKey key;
+        key.m_ts = m_currentTs + delay.GetTimeStep();
+        key.m_context = Simulator::NO_CONTEXT;
+        key.m_uid = m_uid++;
+        m_stopKeys.push_back(key);
+        return;
+    }
+    // the other partitions may have run up to the end of the window
+    uint64_t ts = m_current->currentTs + delay.GetTimeStep();
+    Insert(*m_current,
+           ts,
+           Simulator::NO_CONTEXT,
+           MakeEvent(&MultithreadedSimulatorImpl::StopPartition));
+    for (auto& partition : m_partitions)
+    {
+        if (partition.get() != m_current)
+        {
+            partition->inbound[m_current->id]->Push(
+                {std::max(ts, m_current->windowEnd),
+                 Simulator::NO_CONTEXT,
+                 MakeEvent(&MultithreadedSimulatorImpl::StopPartition)});
+        }
+    }
+    if (m_current != m_global.get())
+    {
+        m_global->inbound[m_current->id]->Push(
+            {std::max(ts, m_current->windowEnd),
+             Simulator::NO_CONTEXT,
+             MakeEvent(&MultithreadedSimulatorImpl::StopPartition)});
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+    if (m_current)
+    {
+        uint64_t ts = m_current->currentTs + delay.GetTimeStep();
+        uint32_t uid = Insert(*m_current, ts, m_current->currentContext, event);
+        return EventId(event, ts, m_current->currentContext, uid);
+    }
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = m_currentTs + delay.GetTimeStep();
+    ev.key.m_context = m_currentContext;
+    ev.key.m_uid = m_uid++;
+    m_unscheduledEvents++;
+    m_events->Insert(ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+    if (!m_current)
+    {
+        Scheduler::Event ev;
+        ev.impl = event;
+        ev.key.m_ts = m_currentTs + delay.GetTimeStep();
+        ev.key.m_context = context;
+        ev.key.m_uid = m_uid++;
+        m_unscheduledEvents++;
+        m_events->Insert(ev);
+        return;
+    }
+    uint64_t ts = m_current->currentTs + delay.GetTimeStep();
+    uint32_t target = GetPartition(context);
+    if (target == m_current->id)
+    {
+        Insert(*m_current, ts, context, event);
+        return;
+    }
+    if (ts < m_current->windowEnd)
+    {
+        NS_FATAL_ERROR("Event for node " << context << " in partition " << target
+                                         << " with a delay below the lookahead");
+    }
+    m_partitions[target]->inbound[m_current->id]->Push({ts, context, event});
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    EventId id(Ptr<EventImpl>(event, false), Now().GetTimeStep(), 0xffffffff, 2);
+    std::unique_lock lock{m_destroyMutex};
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(m_current ? m_current->currentTs : m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    return TimeStep(id.GetTs()) - Now();
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        std::unique_lock lock{m_destroyMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    if (m_current)
+    {
+        m_current->events->Remove(event);
+        m_current->unscheduledEvents--;
+    }
+    else
+    {
+        m_events->Remove(event);
+        m_unscheduledEvents--;
+    }
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        std::unique_lock lock{m_destroyMutex};
+        for (const auto& event : m_destroyEvents)
+        {
+            if (event == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    uint64_t currentTs = m_current ? m_current->currentTs : m_currentTs;
+    uint32_t currentUid = m_current ? m_current->currentUid : m_currentUid;
+    return id.PeekEventImpl() == nullptr || id.GetTs() < currentTs ||
+           (id.GetTs() == currentTs && id.GetUid() <= currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return m_current ? m_current->currentContext : m_currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    return m_current ? m_current->eventCount : m_eventCount;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions() const
+{
+    return m_partitions.size();
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    return m_lookahead == NO_EVENT ? GetMaximumSimulationTime() : TimeStep(m_lookahead);
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetNWindows() const
+{
+    return m_windows;
+}
+
+} // namespace ns3
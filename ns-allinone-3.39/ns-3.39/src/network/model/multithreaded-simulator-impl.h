@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/object-factory.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief A conservative parallel simulator implementation for a single
+ * scenario, with one thread per partition of the nodes.
+ *
+ * The nodes are partitioned by their system id (see NodeContainer::Create),
+ * as in a distributed simulation.  Every partition is a logical process with
+ * its own event queue, run by its own thread; the events are routed to the
+ * partition of their context (the node id), and the events without a node
+ * context run in the partition that scheduled them.  The events without a
+ * node context scheduled before Simulator::Run, and those they schedule,
+ * may reach any node (e.g., Ipv4GlobalRoutingHelper::RecomputeRoutingTables
+ * or a change of the topology): they run alone, while the partitions wait.
+ *
+ * The partitions advance in windows: all of them run the events earlier than
+ * the first pending event of the simulation plus the lookahead, the smallest
+ * Delay attribute of the channels between partitions, and earlier than the
+ * next event without a node context.  An event scheduled in
+ * another partition, by a PointToPointChannel between partitions, is sent
+ * through a lock-free single-producer single-consumer queue per pair of
+ * partitions and inserted in its partition at the end of the window, in the
+ * order of the sending partitions.  So the order of the events, and the
+ * results, depend on the partitions but not on the timing of the threads.
+ *
+ * Select it with
+ * \code
+ *   GlobalValue::Bind("SimulatorImplementationType",
+ *                     StringValue("ns3::MultithreadedSimulatorImpl"));
+ * \endcode
+ * before any other call to the Simulator.
+ *
+ * The partitions share no objects: only point-to-point links may join
+ * nodes of different partitions, and trace sinks connected to nodes of
+ * different partitions must not share state.  The threads of the partitions
+ * share the NodeList, ChannelList, Names, Config and the packet uids of the
+ * process, which the events may read; the topology, the traces and the
+ * random variables are set up before Simulator::Run, which can be called
+ * once, and not in a replication of a SimulationContext.  The packet uids
+ * are unique, but their values depend on the timing of the threads.
+ * Simulator::Stop with a delay stops every partition; called without a
+ * delay, it stops the simulation at the end of the current window.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    MultithreadedSimulatorImpl();
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    void Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /// \return the number of partitions (and threads) of the run
+    uint32_t GetNPartitions() const;
+
+    /// \return the lookahead of the run
+    Time GetLookahead() const;
+
+    /// \return the number of windows of the run
+    uint64_t GetNWindows() const;
+
+  private:
+    void DoDispose() override;
+
+    class RemoteQueue;
+
+    /// A logical process: the events of the nodes of a partition
+    struct Partition
+    {
+        uint32_t id;                   //!< System id of the nodes
+        Ptr<Scheduler> events;         //!< Event queue
+        uint64_t currentTs{0};         //!< Timestamp of the current event
+        uint32_t currentContext;       //!< Context of the current event
+        uint32_t currentUid;           //!< Uid of the current event
+        uint32_t uid;                  //!< Next event uid
+        uint64_t unscheduledEvents{0}; //!< Events in the queue
+        uint64_t eventCount{0};        //!< Events run
+        uint64_t windowEnd{0};         //!< End of the current window (excluded)
+        bool stop{false};              //!< The partition is stopped
+        /// Events scheduled by the other partitions, by sending partition
+        std::vector<std::unique_ptr<RemoteQueue>> inbound;
+    };
+
+    /// Create the partitions and move the events scheduled so far to them
+    void CreatePartitions();
+
+    /**
+     * Run the events without a node context of a timestamp, while the
+     * partitions wait.
+     * \param ts the timestamp
+     */
+    void RunGlobalEvents(uint64_t ts);
+
+    /**
+     * Run the windows of a partition, in its thread.
+     * \param id the partition
+     */
+    void RunPartition(uint32_t id);
+
+    /**
+     * Insert in a partition the events sent by the other partitions in the
+     * last window.
+     * \param partition the partition
+     */
+    static void ReceiveRemoteEvents(Partition& partition);
+
+    /**
+     * Insert an event in the queue of a partition.
+     * \param partition the partition
+     * \param ts the timestamp of the event
+     * \param context the context of the event
+     * \param event the event
+     * \return the uid of the event
+     */
+    static uint32_t Insert(Partition& partition, uint64_t ts, uint32_t context, EventImpl* event);
+
+    /**
+     * Run the next event of a partition.
+     * \param partition the partition
+     */
+    void ProcessOneEvent(Partition& partition);
+
+    /**
+     * \param context an event context
+     * \return the partition of the events of the context
+     */
+    uint32_t GetPartition(uint32_t context) const;
+
+    /// Wait until all the partitions reach this point
+    void Wait();
+
+    /// Stop the partition of the calling thread
+    static void StopPartition();
+
+    /// Partition run by the calling thread, null in the main thread
+    static thread_local Partition* m_current;
+
+    /// Container type for the events to run at Simulator::Destroy()
+    typedef std::list<EventId> DestroyEvents;
+    DestroyEvents m_destroyEvents; //!< The events to run at Destroy
+    mutable std::mutex m_destroyMutex; //!< Protects the events to run at Destroy
+
+    ObjectFactory m_schedulerFactory; //!< Factory of the event queues
+    Ptr<Scheduler> m_events;          //!< Events scheduled before the run
+    std::vector<Scheduler::EventKey> m_stopKeys; //!< Stops scheduled before the run
+    uint32_t m_uid;                   //!< Next event uid before the run
+    uint32_t m_currentUid;            //!< Uid of the current event (main thread)
+    uint64_t m_currentTs;             //!< Current time (main thread)
+    uint32_t m_currentContext;        //!< Current context (main thread)
+    uint64_t m_unscheduledEvents;     //!< Events scheduled before the run
+    uint64_t m_eventCount;            //!< Events run by the finished run
+    bool m_running;                   //!< The partitions are created
+
+    std::vector<std::unique_ptr<Partition>> m_partitions; //!< The partitions
+    std::unique_ptr<Partition> m_global; //!< The events without a node context
+    std::vector<uint32_t> m_partitionOf;                   //!< Partition of every node
+    /// Next event of every partition, and of m_global, at a window start
+    std::vector<uint64_t> m_nextTs;
+    uint64_t m_lookahead;             //!< Smallest delay between partitions (time steps)
+    uint64_t m_windows;               //!< Windows run
+    std::atomic<bool> m_stopRequested; //!< Simulator::Stop was called in the window
+    std::atomic<uint32_t> m_barrierCount;      //!< Partitions at the barrier
+    std::atomic<uint32_t> m_barrierGeneration; //!< Barriers passed
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
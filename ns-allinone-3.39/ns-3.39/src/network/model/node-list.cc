@@ -26,6 +26,7 @@
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
+#include "ns3/simulation-context.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -133,14 +134,18 @@ Ptr<NodeListPriv>*
 NodeListPriv::DoGet()
 {
     NS_LOG_FUNCTION_NOARGS();
+    // one list per simulation: the one of the process, shared by its
+    // threads, or the one of a replication of a SimulationContext
     static Ptr<NodeListPriv> ptr = nullptr;
-    if (!ptr)
+    static thread_local Ptr<NodeListPriv> replicationPtr = nullptr;
+    Ptr<NodeListPriv>* pptr = SimulationContext::GetReplication() >= 0 ? &replicationPtr : &ptr;
+    if (!*pptr)
     {
-        ptr = CreateObject<NodeListPriv>();
-        Config::RegisterRootNamespaceObject(ptr);
+        *pptr = CreateObject<NodeListPriv>();
+        Config::RegisterRootNamespaceObject(*pptr);
         Simulator::ScheduleDestroy(&NodeListPriv::Delete);
     }
-    return &ptr;
+    return pptr;
 }
 
 void
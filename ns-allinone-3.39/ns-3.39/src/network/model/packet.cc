@@ -19,9 +19,12 @@
 #include "packet.h"
 
 #include "ns3/assert.h"
+#include "ns3/event-profiler.h"
 #include "ns3/log.h"
+#include "ns3/simulation-context.h"
 #include "ns3/simulator.h"
 
+#include <atomic>
 #include <cstdarg>
 #include <string>
 
@@ -30,7 +33,32 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+/**
+ * Global counter of packets Uid, shared by the threads of the process, as
+ * the partitions of a MultithreadedSimulatorImpl.
+ */
+static std::atomic<uint32_t> g_globalUid{0};
+
+/// Counter of packets Uid of the replication of a SimulationContext
+static thread_local uint32_t g_replicationUid = 0;
+
+/**
+ * Allocate the Uid of a new packet.
+ * \return the Uid
+ */
+static uint32_t
+AllocateUid()
+{
+    if (SimulationContext::GetReplication() >= 0)
+    {
+        return g_replicationUid++;
+    }
+    return g_globalUid.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Packets created, as a counter of the EventProfiler
+static EventProfiler::CounterRegistration g_packetProfilerCounter("packets created",
+                                                                  &Packet::GetNPacketsCreated);
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -146,10 +174,9 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | AllocateUid(), 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -186,10 +213,9 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -213,10 +239,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -599,6 +624,16 @@ Packet::EnablePrinting()
     PacketMetadata::Enable();
 }
 
+uint64_t
+Packet::GetNPacketsCreated()
+{
+    if (SimulationContext::GetReplication() >= 0)
+    {
+        return g_replicationUid;
+    }
+    return g_globalUid.load(std::memory_order_relaxed);
+}
+
 void
 Packet::EnableChecking()
 {
@@ -537,6 +537,15 @@ class Packet : public SimpleRefCount<Packet>
      */
     static void EnableChecking();
 
+    /**
+     * \brief Get the number of packets created (not copied) in the
+     * simulation of the calling thread, i.e., the next packet uid: the
+     * one of the process, or of the replication of a SimulationContext.
+     *
+     * \returns the number of packets created
+     */
+    static uint64_t GetNPacketsCreated();
+
     /**
      * \brief Returns number of bytes required for packet
      * serialization.
@@ -794,8 +803,6 @@ class Packet : public SimpleRefCount<Packet>
 
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
-
-    static uint32_t m_globalUid; //!< Global counter of packets Uid
 };
 
 /**
@@ -393,6 +393,56 @@ BufferTest::DoRun()
     val2 <<= 8;
     val2 |= i.ReadU8();
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
+
+    // Appending real bytes to a virtual payload (and the reverse) must
+    // keep the zero area virtual.
+    buffer = Buffer(1000);
+    Buffer trailer;
+    trailer.AddAtStart(2);
+    i = trailer.Begin();
+    i.WriteU8(0x1);
+    i.WriteU8(0x2);
+    buffer.AddAtEnd(trailer);
+    NS_TEST_ASSERT_MSG_EQ(buffer.GetSize(), 1002, "Bad size after AddAtEnd");
+    NS_TEST_ASSERT_MSG_LT(buffer.GetSerializedSize(), 100, "Zero area was materialized");
+    buffer.AddAtStart(1);
+    buffer.Begin().WriteU8(0x9);
+    Buffer head;
+    head.AddAtStart(3);
+    i = head.Begin();
+    i.WriteU8(0x3);
+    i.WriteU8(0x4);
+    i.WriteU8(0x5);
+    head.AddAtEnd(buffer);
+    NS_TEST_ASSERT_MSG_EQ(head.GetSize(), 1006, "Bad size after AddAtEnd");
+    NS_TEST_ASSERT_MSG_LT(head.GetSerializedSize(), 100, "Zero area was materialized");
+    i = head.Begin();
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0x3, "Bad head byte");
+    i.Next(2);
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0x9, "Bad prefix byte");
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0, "Bad zero byte");
+    i = head.End();
+    i.Prev(3);
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0, "Bad zero byte");
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0x1, "Bad trailer byte");
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0x2, "Bad trailer byte");
+
+    // The checksum skips the zero area but must match the one of the
+    // materialized buffer.
+    Buffer real;
+    real.AddAtStart(head.GetSize());
+    i = real.Begin();
+    i.Write(head.Begin(), head.End());
+    NS_TEST_ASSERT_MSG_EQ(head.Begin().CalculateIpChecksum(head.GetSize()),
+                          real.Begin().CalculateIpChecksum(real.GetSize()),
+                          "Checksum over virtual zero area differs");
+    i = head.Begin();
+    i.Next(1);
+    Buffer::Iterator j = real.Begin();
+    j.Next(1);
+    NS_TEST_ASSERT_MSG_EQ(i.CalculateIpChecksum(head.GetSize() - 2),
+                          j.CalculateIpChecksum(real.GetSize() - 2),
+                          "Checksum over virtual zero area differs");
 }
 
 /**
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "header-serialization-test.h"
+
+#include "ns3/ecpri-header.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+#include "ns3/vlan-header.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check the wire format of the eCPRI and 802.1Q headers.
+ */
+class EcpriVlanHeaderTestCase : public HeaderSerializationTestCase
+{
+  public:
+    EcpriVlanHeaderTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the serialized bytes of a header.
+     * \param header the header
+     * \param expected the expected bytes
+     * \param size the number of expected bytes
+     */
+    void CheckBytes(const Header& header, const uint8_t* expected, uint32_t size);
+};
+
+EcpriVlanHeaderTestCase::EcpriVlanHeaderTestCase()
+    : HeaderSerializationTestCase("Check the eCPRI and 802.1Q headers")
+{
+}
+
+void
+EcpriVlanHeaderTestCase::CheckBytes(const Header& header, const uint8_t* expected, uint32_t size)
+{
+    NS_TEST_ASSERT_MSG_EQ(header.GetSerializedSize(), size, "Wrong header size");
+    Buffer buffer;
+    buffer.AddAtStart(size);
+    header.Serialize(buffer.Begin());
+    Buffer::Iterator i = buffer.Begin();
+    for (uint32_t j = 0; j < size; j++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(+i.ReadU8(), +expected[j], "Wrong byte " << j);
+    }
+}
+
+void
+EcpriVlanHeaderTestCase::DoRun()
+{
+    // IQ data message of an eAxC: 1000 bytes of payload after the PC_ID and SEQ_ID
+    EcpriHeader ecpri;
+    ecpri.SetMessageType(EcpriHeader::IQ_DATA);
+    ecpri.SetPayloadSize(1004);
+    ecpri.SetPcId(0x0005);
+    ecpri.SetSeqId(0x1280);
+    const uint8_t ecpriBytes[] = {0x10, 0x00, 0x03, 0xec, 0x00, 0x05, 0x12, 0x80};
+    CheckBytes(ecpri, ecpriBytes, sizeof(ecpriBytes));
+    TestHeaderSerialization(ecpri);
+
+    // other message types only have the common header
+    EcpriHeader delay;
+    delay.SetMessageType(5);
+    delay.SetPayloadSize(20);
+    delay.SetConcatenated(true);
+    const uint8_t delayBytes[] = {0x11, 0x05, 0x00, 0x14};
+    CheckBytes(delay, delayBytes, sizeof(delayBytes));
+    TestHeaderSerialization(delay);
+
+    VlanTag tag(7, 100);
+    NS_TEST_EXPECT_MSG_EQ(tag.GetTci(), 0xe064, "Wrong TCI");
+    tag.SetDei(true);
+    NS_TEST_EXPECT_MSG_EQ(tag.GetTci(), 0xf064, "Wrong TCI with DEI");
+    tag.SetPcp(3);
+    NS_TEST_EXPECT_MSG_EQ(+tag.GetPcp(), 3, "Wrong PCP");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetVid(), 100, "The VID changed with the PCP");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetDei(), true, "The DEI changed with the PCP");
+
+    VlanHeader vlan(VlanTag(7, 100), EcpriHeader::PROT_NUMBER);
+    const uint8_t vlanBytes[] = {0xe0, 0x64, 0xae, 0xfe};
+    CheckBytes(vlan, vlanBytes, sizeof(vlanBytes));
+    TestHeaderSerialization(vlan);
+
+    // the headers and the tag travel with a packet
+    Ptr<Packet> packet = Create<Packet>(1000);
+    packet->AddHeader(ecpri);
+    packet->AddHeader(vlan);
+    packet->AddPacketTag(VlanTag(5, 4094));
+    NS_TEST_EXPECT_MSG_EQ(packet->GetSize(), 1012, "Wrong packet size");
+
+    VlanTag packetTag;
+    NS_TEST_ASSERT_MSG_EQ(packet->PeekPacketTag(packetTag), true, "No VLAN tag");
+    NS_TEST_EXPECT_MSG_EQ(+packetTag.GetPcp(), 5, "Wrong PCP of the packet tag");
+    NS_TEST_EXPECT_MSG_EQ(packetTag.GetVid(), 4094, "Wrong VID of the packet tag");
+
+    VlanHeader vlanRx;
+    packet->RemoveHeader(vlanRx);
+    NS_TEST_EXPECT_MSG_EQ(+vlanRx.GetTag().GetPcp(), 7, "Wrong PCP");
+    NS_TEST_EXPECT_MSG_EQ(vlanRx.GetTag().GetVid(), 100, "Wrong VID");
+    NS_TEST_EXPECT_MSG_EQ(vlanRx.GetType(), EcpriHeader::PROT_NUMBER, "Wrong Ethertype");
+    EcpriHeader ecpriRx;
+    packet->RemoveHeader(ecpriRx);
+    NS_TEST_EXPECT_MSG_EQ(+ecpriRx.GetRevision(), 1, "Wrong revision");
+    NS_TEST_EXPECT_MSG_EQ(+ecpriRx.GetMessageType(), +EcpriHeader::IQ_DATA, "Wrong type");
+    NS_TEST_EXPECT_MSG_EQ(ecpriRx.GetPayloadSize(), 1004, "Wrong payload size");
+    NS_TEST_EXPECT_MSG_EQ(ecpriRx.GetPcId(), 5, "Wrong PC_ID");
+    NS_TEST_EXPECT_MSG_EQ(ecpriRx.GetSeqId(), 0x1280, "Wrong SEQ_ID");
+    NS_TEST_EXPECT_MSG_EQ(ecpriRx.IsConcatenated(), false, "Wrong concatenation bit");
+    NS_TEST_EXPECT_MSG_EQ(packet->GetSize(), 1000, "Wrong payload");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief eCPRI and 802.1Q headers TestSuite
+ */
+class EcpriHeaderTestSuite : public TestSuite
+{
+  public:
+    EcpriHeaderTestSuite();
+};
+
+EcpriHeaderTestSuite::EcpriHeaderTestSuite()
+    : TestSuite("ecpri-header", UNIT)
+{
+    AddTestCase(new EcpriVlanHeaderTestCase, TestCase::QUICK);
+}
+
+static EcpriHeaderTestSuite g_ecpriHeaderTestSuite; //!< Static variable for test initialization
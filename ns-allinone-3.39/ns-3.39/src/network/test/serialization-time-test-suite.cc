@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/data-rate.h"
+#include "ns3/serialization-time.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Exact integer reference: rounded time of a number of bytes.
+ * \param bytes the number of bytes
+ * \param bps the rate, in bit/s
+ * \return the time in time steps, rounded to the nearest one
+ */
+static int64_t
+ReferenceSteps(uint64_t bytes, uint64_t bps)
+{
+    unsigned __int128 steps = static_cast<unsigned __int128>(bytes) * 8 *
+                              static_cast<uint64_t>(Time::FromInteger(1, Time::S).GetTimeStep());
+    return static_cast<int64_t>((steps + bps / 2) / bps);
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check the serialization times of single frames against an exact
+ * reference, with and without the cache, and against DataRate.
+ */
+class SerializationTimeFrameTestCase : public TestCase
+{
+  public:
+    SerializationTimeFrameTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SerializationTimeFrameTestCase::SerializationTimeFrameTestCase()
+    : TestCase("Serialization time of single frames")
+{
+}
+
+void
+SerializationTimeFrameTestCase::DoRun()
+{
+    // integer, periodic and irregular times per byte
+    for (uint64_t bps : {10000000000ULL, 3000000000ULL, 9953280000ULL, 1000000007ULL})
+    {
+        SerializationTime txTime{DataRate(bps)};
+        for (uint32_t bytes = 0; bytes < 2 * SerializationTime::MAX_CACHED_BYTES; bytes += 7)
+        {
+            Time expected = TimeStep(ReferenceSteps(bytes, bps));
+            NS_TEST_ASSERT_MSG_EQ(txTime.GetBytesTxTime(bytes),
+                                  expected,
+                                  "Wrong time of " << bytes << " bytes at " << bps);
+            // a second time, from the cache
+            NS_TEST_ASSERT_MSG_EQ(txTime.GetBytesTxTime(bytes), expected, "Wrong cached time");
+            NS_TEST_ASSERT_MSG_EQ(DataRate(bps).CalculateBytesTxTime(bytes),
+                                  expected,
+                                  "DataRate disagrees for " << bytes << " bytes at " << bps);
+        }
+    }
+
+    SerializationTime txTime(DataRate("10Gbps"));
+    NS_TEST_EXPECT_MSG_EQ(txTime.GetBytesTxTime(1500), NanoSeconds(1200), "Wrong 1500 B time");
+    txTime.SetRate(DataRate("1Gbps"));
+    NS_TEST_EXPECT_MSG_EQ(txTime.GetBytesTxTime(1500), MicroSeconds(12), "Rate not updated");
+    NS_TEST_EXPECT_MSG_EQ(txTime.GetRate(), DataRate("1Gbps"), "Wrong rate");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that a long sequence of frames serialized one after another
+ * accumulates no drift.
+ */
+class SerializationTimeDriftTestCase : public TestCase
+{
+  public:
+    /**
+     * \param bps the rate, in bit/s
+     * \param packets the number of frames
+     * \param cut whether every third frame is cut short after its start
+     */
+    SerializationTimeDriftTestCase(uint64_t bps, uint64_t packets, bool cut = false);
+
+  private:
+    void DoRun() override;
+
+    uint64_t m_bps;     //!< Rate, in bit/s
+    uint64_t m_packets; //!< Number of frames
+    bool m_cut;         //!< Whether every third frame is cut short
+};
+
+SerializationTimeDriftTestCase::SerializationTimeDriftTestCase(uint64_t bps,
+                                                               uint64_t packets,
+                                                               bool cut)
+    : TestCase("Cumulative drift of " + std::to_string(packets) + " frames at " +
+               std::to_string(bps) + " bps" + (cut ? " with cut frames" : "")),
+      m_bps(bps),
+      m_packets(packets),
+      m_cut(cut)
+{
+}
+
+void
+SerializationTimeDriftTestCase::DoRun()
+{
+    // stop marking the Times to convert, as a simulation does
+    Simulator::Run();
+    SerializationTime txTime{DataRate(m_bps)};
+    uint64_t bytes = 0;
+    int64_t steps = 0;
+    int64_t maxError = 0;
+    uint32_t size = 64;
+    for (uint64_t i = 0; i < m_packets; i++)
+    {
+        // sizes from 64 to 1518 bytes, not periodic with the rate
+        size += 733;
+        if (size > 1518)
+        {
+            size -= 1455;
+        }
+        Time time = txTime.NextBytesTxTime(size);
+        if (m_cut && i % 3 == 0)
+        {
+            // as a preempted frame: only its first bytes are sent
+            time = txTime.CutLastBytesTxTime(size, size / 2);
+            bytes += size / 2;
+        }
+        else
+        {
+            bytes += size;
+        }
+        steps += time.GetTimeStep();
+        if ((i & 0xffffff) == 0)
+        {
+            maxError = std::max(maxError, std::abs(steps - ReferenceSteps(bytes, m_bps)));
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(steps, ReferenceSteps(bytes, m_bps), "Cumulative drift");
+    NS_TEST_EXPECT_MSG_EQ(maxError, 0, "Drift in the middle of the sequence");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief SerializationTime TestSuite
+ */
+class SerializationTimeTestSuite : public TestSuite
+{
+  public:
+    SerializationTimeTestSuite();
+};
+
+SerializationTimeTestSuite::SerializationTimeTestSuite()
+    : TestSuite("serialization-time", UNIT)
+{
+    AddTestCase(new SerializationTimeFrameTestCase, TestCase::QUICK);
+    AddTestCase(new SerializationTimeDriftTestCase(3000000000ULL, 10000000ULL), TestCase::QUICK);
+    AddTestCase(new SerializationTimeDriftTestCase(3000000000ULL, 10000000ULL, true),
+                TestCase::QUICK);
+    AddTestCase(new SerializationTimeDriftTestCase(9953280000ULL, 1000000000ULL),
+                TestCase::EXTENSIVE);
+}
+
+static SerializationTimeTestSuite g_serializationTimeTestSuite; //!< Static variable for test initialization
@@ -19,6 +19,8 @@
 
 #include "data-rate.h"
 
+#include "serialization-time.h"
+
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 #include "ns3/nstime.h"
@@ -300,7 +302,7 @@ DataRate::CalculateBitsTxTime(uint32_t bits) const
 {
     NS_LOG_FUNCTION(this << bits);
     // std::cout << " - DataRate: " << m_bps << std::endl;
-    return Seconds(int64x64_t(bits) / m_bps);
+    return SerializationTime::BitsTxTime(bits, m_bps);
 }
 
 uint64_t
@@ -240,7 +240,9 @@ class DataRate
     /**
      * \brief Calculate transmission time
      *
-     * Calculates the transmission time at this data rate
+     * Calculates the transmission time at this data rate, exactly in
+     * integer arithmetic and rounded to the nearest time step
+     * (see SerializationTime).
      * \param bits The number of bits (not bytes) for which to calculate
      * \return The transmission time for the number of bits specified
      */
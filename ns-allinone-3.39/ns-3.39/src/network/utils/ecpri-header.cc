@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ecpri-header.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EcpriHeader");
+
+NS_OBJECT_ENSURE_REGISTERED(EcpriHeader);
+
+EcpriHeader::EcpriHeader()
+    : m_revision(1),
+      m_concatenated(false),
+      m_messageType(IQ_DATA),
+      m_payloadSize(0),
+      m_pcId(0),
+      m_seqId(0)
+{
+}
+
+TypeId
+EcpriHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::EcpriHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("Network")
+                            .AddConstructor<EcpriHeader>();
+    return tid;
+}
+
+TypeId
+EcpriHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+EcpriHeader::Print(std::ostream& os) const
+{
+    os << "revision " << +m_revision << " type " << +m_messageType << " payload "
+       << m_payloadSize;
+    if (HasMessageHeader())
+    {
+        os << " pc_id " << m_pcId << " seq_id " << m_seqId;
+    }
+    if (m_concatenated)
+    {
+        os << " concatenated";
+    }
+}
+
+bool
+EcpriHeader::HasMessageHeader() const
+{
+    return m_messageType <= REAL_TIME_CONTROL;
+}
+
+uint32_t
+EcpriHeader::GetSerializedSize() const
+{
+    return HasMessageHeader() ? 8 : 4;
+}
+
+void
+EcpriHeader::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+    i.WriteU8((m_revision << 4) | (m_concatenated ? 1 : 0));
+    i.WriteU8(m_messageType);
+    i.WriteHtonU16(m_payloadSize);
+    if (HasMessageHeader())
+    {
+        i.WriteHtonU16(m_pcId);
+        i.WriteHtonU16(m_seqId);
+    }
+}
+
+uint32_t
+EcpriHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+    uint8_t first = i.ReadU8();
+    m_revision = first >> 4;
+    m_concatenated = (first & 1) != 0;
+    m_messageType = i.ReadU8();
+    m_payloadSize = i.ReadNtohU16();
+    if (HasMessageHeader())
+    {
+        m_pcId = i.ReadNtohU16();
+        m_seqId = i.ReadNtohU16();
+    }
+    return GetSerializedSize();
+}
+
+void
+EcpriHeader::SetMessageType(uint8_t type)
+{
+    m_messageType = type;
+}
+
+uint8_t
+EcpriHeader::GetMessageType() const
+{
+    return m_messageType;
+}
+
+void
+EcpriHeader::SetPayloadSize(uint16_t size)
+{
+    m_payloadSize = size;
+}
+
+uint16_t
+EcpriHeader::GetPayloadSize() const
+{
+    return m_payloadSize;
+}
+
+void
+EcpriHeader::SetConcatenated(bool concatenated)
+{
+    m_concatenated = concatenated;
+}
+
+bool
+EcpriHeader::IsConcatenated() const
+{
+    return m_concatenated;
+}
+
+uint8_t
+EcpriHeader::GetRevision() const
+{
+    return m_revision;
+}
+
+void
+EcpriHeader::SetPcId(uint16_t pcId)
+{
+    m_pcId = pcId;
+}
+
+uint16_t
+EcpriHeader::GetPcId() const
+{
+    return m_pcId;
+}
+
+void
+EcpriHeader::SetSeqId(uint16_t seqId)
+{
+    m_seqId = seqId;
+}
+
+uint16_t
+EcpriHeader::GetSeqId() const
+{
+    return m_seqId;
+}
+
+} // namespace ns3
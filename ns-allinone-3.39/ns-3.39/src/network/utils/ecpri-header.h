@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ECPRI_HEADER_H
+#define ECPRI_HEADER_H
+
+#include "ns3/header.h"
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Header of an eCPRI message carried directly over Ethernet.
+ *
+ * The 4-byte common header (revision, concatenation bit, message type and
+ * payload size) is followed, for the IQ data, bit sequence and real-time
+ * control messages used by the O-RAN fronthaul U-plane and C-plane, by the
+ * 4-byte message header with the PC_ID (or RTC_ID) of the eAxC and the
+ * SEQ_ID.  The payload size counts the bytes after the common header, that
+ * is, the message header and the payload.
+ */
+class EcpriHeader : public Header
+{
+  public:
+    /// Ethertype of eCPRI over Ethernet
+    static const uint16_t PROT_NUMBER = 0xAEFE;
+
+    /// Message types
+    enum MessageType : uint8_t
+    {
+        IQ_DATA = 0,         //!< IQ data (O-RAN U-plane)
+        BIT_SEQUENCE = 1,    //!< Bit sequence
+        REAL_TIME_CONTROL = 2 //!< Real-time control data (O-RAN C-plane)
+    };
+
+    EcpriHeader();
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    void Print(std::ostream& os) const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+
+    /**
+     * \param type the message type
+     */
+    void SetMessageType(uint8_t type);
+    /// \return the message type
+    uint8_t GetMessageType() const;
+
+    /**
+     * \param size the bytes after the common header
+     */
+    void SetPayloadSize(uint16_t size);
+    /// \return the bytes after the common header
+    uint16_t GetPayloadSize() const;
+
+    /**
+     * \param concatenated whether another message follows in the same frame
+     */
+    void SetConcatenated(bool concatenated);
+    /// \return whether another message follows in the same frame
+    bool IsConcatenated() const;
+
+    /// \return the protocol revision
+    uint8_t GetRevision() const;
+
+    /**
+     * \param pcId the PC_ID (or RTC_ID) of the eAxC
+     */
+    void SetPcId(uint16_t pcId);
+    /// \return the PC_ID (or RTC_ID) of the eAxC
+    uint16_t GetPcId() const;
+
+    /**
+     * \param seqId the SEQ_ID of the message
+     */
+    void SetSeqId(uint16_t seqId);
+    /// \return the SEQ_ID of the message
+    uint16_t GetSeqId() const;
+
+  private:
+    /// \return true if the message type has the PC_ID and SEQ_ID fields
+    bool HasMessageHeader() const;
+
+    uint8_t m_revision;     //!< Protocol revision
+    bool m_concatenated;    //!< Concatenation indicator
+    uint8_t m_messageType;  //!< Message type
+    uint16_t m_payloadSize; //!< Bytes after the common header
+    uint16_t m_pcId;        //!< PC_ID or RTC_ID
+    uint16_t m_seqId;       //!< SEQ_ID
+};
+
+} // namespace ns3
+
+#endif /* ECPRI_HEADER_H */
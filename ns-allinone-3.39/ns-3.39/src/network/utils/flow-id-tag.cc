@@ -102,7 +102,7 @@ uint32_t
 FlowIdTag::AllocateFlowId()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static uint32_t nextFlowId = 1;
+    static thread_local uint32_t nextFlowId = 1;
     uint32_t flowId = nextFlowId;
     nextFlowId++;
     return flowId;
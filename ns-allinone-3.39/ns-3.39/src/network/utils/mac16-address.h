@@ -227,7 +227,7 @@ class Mac16Address
      */
     friend std::istream& operator>>(std::istream& is, Mac16Address& address);
 
-    static uint64_t m_allocationIndex; //!< Address allocation index
+    static thread_local uint64_t m_allocationIndex; //!< Address allocation index, per thread
     uint8_t m_address[2];              //!< address value
 };
 
@@ -64,7 +64,7 @@ AsciiToLowCase(char c)
     }
 }
 
-uint64_t Mac48Address::m_allocationIndex = 0;
+thread_local uint64_t Mac48Address::m_allocationIndex = 0;
 
 Mac48Address::Mac48Address()
 {
@@ -212,7 +212,7 @@ class Mac48Address
      */
     friend std::istream& operator>>(std::istream& is, Mac48Address& address);
 
-    static uint64_t m_allocationIndex; //!< Address allocation index
+    static thread_local uint64_t m_allocationIndex; //!< Address allocation index, per thread
     uint8_t m_address[6];              //!< address value
 };
 
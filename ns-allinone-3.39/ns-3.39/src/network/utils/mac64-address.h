@@ -179,7 +179,7 @@ class Mac64Address
      */
     friend std::istream& operator>>(std::istream& is, Mac64Address& address);
 
-    static uint64_t m_allocationIndex; //!< Address allocation index
+    static thread_local uint64_t m_allocationIndex; //!< Address allocation index, per thread
     uint8_t m_address[8];              //!< address value
 };
 
@@ -131,7 +131,7 @@ class Mac8Address
     static void ResetAllocationIndex();
 
   private:
-    static uint8_t m_allocationIndex; //!< Address allocation index
+    static thread_local uint8_t m_allocationIndex; //!< Address allocation index, per thread
     uint8_t m_address;                //!< The address.
 
     /**
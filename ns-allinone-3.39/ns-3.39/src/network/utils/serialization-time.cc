@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "serialization-time.h"
+
+#include "ns3/abort.h"
+#include "ns3/int64x64.h"
+#include "ns3/log.h"
+
+#include <numeric>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SerializationTime");
+
+namespace
+{
+
+/**
+ * \ingroup network
+ * \brief Divide the product of two integers.
+ * \param [in] a the first factor
+ * \param [in] b the second factor
+ * \param [in] d the divisor
+ * \param [out] rem the remainder of the division
+ * \return the quotient of a * b / d
+ */
+uint64_t
+MulDiv(uint64_t a, uint64_t b, uint64_t d, uint64_t& rem)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    rem = static_cast<uint64_t>(product % d);
+    return static_cast<uint64_t>(product / d);
+#else
+    // 128-bit product from 32-bit halves
+    uint64_t aLo = a & 0xffffffff;
+    uint64_t aHi = a >> 32;
+    uint64_t bLo = b & 0xffffffff;
+    uint64_t bHi = b >> 32;
+    uint64_t lo = aLo * bLo;
+    uint64_t mid1 = aHi * bLo;
+    uint64_t mid2 = aLo * bHi;
+    uint64_t hi = aHi * bHi + (mid1 >> 32) + (mid2 >> 32);
+    uint64_t midLo = (mid1 & 0xffffffff) + (mid2 & 0xffffffff) + (lo >> 32);
+    hi += midLo >> 32;
+    lo = (midLo << 32) | (lo & 0xffffffff);
+    // restoring division, one bit at a time
+    uint64_t quotient = 0;
+    rem = 0;
+    for (int bit = 127; bit >= 0; bit--)
+    {
+        bool overflow = (rem >> 63) != 0;
+        uint64_t next = (bit >= 64) ? (hi >> (bit - 64)) & 1 : (lo >> bit) & 1;
+        rem = (rem << 1) | next;
+        quotient <<= 1;
+        if (overflow || rem >= d)
+        {
+            rem -= d;
+            quotient |= 1;
+        }
+    }
+    return quotient;
+#endif
+}
+
+/// \return the time steps of one second at the current resolution
+uint64_t
+StepsPerSecond()
+{
+    return static_cast<uint64_t>(Time::FromInteger(1, Time::S).GetTimeStep());
+}
+
+} // namespace
+
+SerializationTime::SerializationTime()
+    : m_bps(0),
+      m_unit(Time::LAST),
+      m_num(0),
+      m_den(1),
+      m_carry(0)
+{
+}
+
+SerializationTime::SerializationTime(const DataRate& rate)
+    : SerializationTime()
+{
+    SetRate(rate);
+}
+
+void
+SerializationTime::SetRate(const DataRate& rate)
+{
+    if (rate.GetBitRate() == m_bps)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << rate);
+    m_bps = rate.GetBitRate();
+    m_unit = Time::LAST;
+    m_cache.clear();
+}
+
+DataRate
+SerializationTime::GetRate() const
+{
+    return DataRate(m_bps);
+}
+
+void
+SerializationTime::Update()
+{
+    if (m_unit != Time::LAST)
+    {
+        return;
+    }
+    NS_ABORT_MSG_IF(m_bps == 0, "Serialization time at a null rate");
+    m_unit = Time::GetResolution();
+    // one byte lasts 8 * steps per second / bps time steps
+    m_num = 8 * StepsPerSecond();
+    m_den = m_bps;
+    uint64_t divisor = std::gcd(m_num, m_den);
+    m_num /= divisor;
+    m_den /= divisor;
+    m_carry = m_den / 2;
+    m_cache.clear();
+    NS_LOG_DEBUG("One byte at " << m_bps << " bit/s lasts " << m_num << "/" << m_den
+                                << " time steps");
+}
+
+SerializationTime::Entry
+SerializationTime::Compute(uint32_t bytes)
+{
+    Update();
+    Entry entry;
+    entry.steps = static_cast<int64_t>(MulDiv(bytes, m_num, m_den, entry.rem));
+    // round half up, as Time does
+    entry.rounded = entry.steps + (entry.rem >= m_den - m_den / 2 ? 1 : 0);
+    if (bytes <= MAX_CACHED_BYTES)
+    {
+        if (bytes >= m_cache.size())
+        {
+            m_cache.resize(bytes + 1, Entry{-1, -1, 0});
+        }
+        m_cache[bytes] = entry;
+    }
+    return entry;
+}
+
+Time
+SerializationTime::CutLastBytesTxTime(uint32_t bytes, uint32_t cut)
+{
+    Entry last = (bytes < m_cache.size() && m_cache[bytes].steps >= 0) ? m_cache[bytes]
+                                                                       : Compute(bytes);
+    // back to the remainder carried before the last frame
+    m_carry = (m_carry + m_den - last.rem) % m_den;
+    return NextBytesTxTime(cut);
+}
+
+void
+SerializationTime::ResetCarry()
+{
+    Update();
+    m_carry = m_den / 2;
+}
+
+Time
+SerializationTime::BitsTxTime(uint64_t bits, uint64_t bps)
+{
+    NS_ABORT_MSG_IF(bps == 0, "Serialization time at a null rate");
+    uint64_t rem;
+    uint64_t steps = MulDiv(bits, StepsPerSecond(), bps, rem);
+    return TimeStep(steps + (rem >= bps - bps / 2 ? 1 : 0));
+}
+
+} // namespace ns3
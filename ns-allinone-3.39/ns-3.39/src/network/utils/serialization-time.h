@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef SERIALIZATION_TIME_H
+#define SERIALIZATION_TIME_H
+
+#include "data-rate.h"
+
+#include "ns3/nstime.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Exact serialization times of a transmitter or switching fabric.
+ *
+ * The time of one byte at the rate is kept as an exact rational number of
+ * simulator time steps, num / den, reduced by their greatest common divisor.
+ * The time of n bytes is split into its whole steps and the remainder of
+ * n * num / den, and both are cached for the frame sizes up to
+ * MAX_CACHED_BYTES, so the usual frames cost no division at all.
+ *
+ * GetBytesTxTime() rounds every time to the nearest step, as
+ * DataRate::CalculateBytesTxTime() does.  NextBytesTxTime() is meant for a
+ * resource that serializes one frame after another: the remainders are
+ * carried from one frame to the next, so the sum of the times returned is
+ * the exact (rounded) time of the sum of the bytes, without cumulative
+ * drift however many frames are sent.
+ *
+ * The rate is converted to time steps on first use, so the object can be
+ * built before Time::SetResolution() is called, but not used across a
+ * change of resolution.
+ */
+class SerializationTime
+{
+  public:
+    /// Frame sizes (in bytes) whose times are cached
+    static const uint32_t MAX_CACHED_BYTES = 9216;
+
+    SerializationTime();
+
+    /**
+     * \param rate the rate of the transmitter
+     */
+    explicit SerializationTime(const DataRate& rate);
+
+    /**
+     * \brief Set the rate, if different from the current one.
+     *
+     * A new rate clears the cache and the carried remainder.
+     * \param rate the rate of the transmitter
+     */
+    void SetRate(const DataRate& rate);
+
+    /// \return the rate of the transmitter
+    DataRate GetRate() const;
+
+    /**
+     * \param bytes the size of the frame
+     * \return the time to serialize the frame, rounded to the nearest time step
+     */
+    inline Time GetBytesTxTime(uint32_t bytes);
+
+    /**
+     * \brief Serialize the next frame of a sequence.
+     * \param bytes the size of the frame
+     * \return the time to serialize the frame, such that the sum of the
+     *         times of the sequence is its exact time
+     */
+    inline Time NextBytesTxTime(uint32_t bytes);
+
+    /**
+     * \brief Cut short the last frame of the sequence.
+     *
+     * The frame given to the last NextBytesTxTime() call is replaced by a
+     * shorter one (e.g., a preempted fragment), whose remainder is the one
+     * carried to the next frame.
+     * \param bytes the size given to the last NextBytesTxTime() call
+     * \param cut the size of the shorter frame
+     * \return the time to serialize the shorter frame
+     */
+    Time CutLastBytesTxTime(uint32_t bytes, uint32_t cut);
+
+    /// Forget the remainder carried from the previous frames
+    void ResetCarry();
+
+    /**
+     * \brief Exact time of a number of bits at a bit rate.
+     * \param bits the number of bits
+     * \param bps the bit rate, in bit/s
+     * \return the time, rounded to the nearest time step
+     */
+    static Time BitsTxTime(uint64_t bits, uint64_t bps);
+
+  private:
+    /// Time of a frame size: whole time steps and remainder (in 1/den steps)
+    struct Entry
+    {
+        int64_t steps;   //!< Whole time steps, negative if not computed yet
+        int64_t rounded; //!< Time steps rounded to the nearest one
+        uint64_t rem;    //!< Remainder, lower than den
+    };
+
+    /**
+     * \brief Convert the rate to the current time resolution, if not done yet.
+     */
+    void Update();
+
+    /**
+     * \brief Compute the time of a frame and cache it, if small enough.
+     * \param bytes the size of the frame
+     * \return the time of the frame
+     */
+    Entry Compute(uint32_t bytes);
+
+    uint64_t m_bps;              //!< Rate, in bit/s
+    Time::Unit m_unit;           //!< Time resolution of num and den
+    uint64_t m_num;              //!< Time steps of one byte, numerator
+    uint64_t m_den;              //!< Time steps of one byte, denominator
+    uint64_t m_carry;            //!< Remainder carried to the next frame
+    std::vector<Entry> m_cache;  //!< Times by frame size
+};
+
+/*************************************************
+ ** Inline implementations
+ ************************************************/
+
+Time
+SerializationTime::GetBytesTxTime(uint32_t bytes)
+{
+    if (bytes < m_cache.size() && m_cache[bytes].steps >= 0)
+    {
+        return TimeStep(m_cache[bytes].rounded);
+    }
+    return TimeStep(Compute(bytes).rounded);
+}
+
+Time
+SerializationTime::NextBytesTxTime(uint32_t bytes)
+{
+    Entry entry = (bytes < m_cache.size() && m_cache[bytes].steps >= 0) ? m_cache[bytes]
+                                                                        : Compute(bytes);
+    // both are lower than den, so at most one more step
+    m_carry += entry.rem;
+    if (m_carry >= m_den)
+    {
+        m_carry -= m_den;
+        entry.steps++;
+    }
+    return TimeStep(entry.steps);
+}
+
+} // namespace ns3
+
+#endif /* SERIALIZATION_TIME_H */
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "vlan-header.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("VlanHeader");
+
+NS_OBJECT_ENSURE_REGISTERED(VlanTag);
+NS_OBJECT_ENSURE_REGISTERED(VlanHeader);
+
+VlanTag::VlanTag()
+    : m_tci(0)
+{
+}
+
+VlanTag::VlanTag(uint8_t pcp, uint16_t vid, bool dei)
+    : m_tci(0)
+{
+    SetPcp(pcp);
+    SetVid(vid);
+    SetDei(dei);
+}
+
+void
+VlanTag::SetPcp(uint8_t pcp)
+{
+    NS_ABORT_MSG_IF(pcp > 7, "Invalid PCP " << +pcp);
+    m_tci = (m_tci & 0x1fff) | (pcp << 13);
+}
+
+uint8_t
+VlanTag::GetPcp() const
+{
+    return m_tci >> 13;
+}
+
+void
+VlanTag::SetVid(uint16_t vid)
+{
+    NS_ABORT_MSG_IF(vid > 0xfff, "Invalid VID " << vid);
+    m_tci = (m_tci & 0xf000) | vid;
+}
+
+uint16_t
+VlanTag::GetVid() const
+{
+    return m_tci & 0xfff;
+}
+
+void
+VlanTag::SetDei(bool dei)
+{
+    m_tci = (m_tci & 0xefff) | (dei ? 0x1000 : 0);
+}
+
+bool
+VlanTag::GetDei() const
+{
+    return (m_tci & 0x1000) != 0;
+}
+
+uint16_t
+VlanTag::GetTci() const
+{
+    return m_tci;
+}
+
+void
+VlanTag::SetTci(uint16_t tci)
+{
+    m_tci = tci;
+}
+
+TypeId
+VlanTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::VlanTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("Network")
+                            .AddConstructor<VlanTag>();
+    return tid;
+}
+
+TypeId
+VlanTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+uint32_t
+VlanTag::GetSerializedSize() const
+{
+    return 2;
+}
+
+void
+VlanTag::Serialize(TagBuffer i) const
+{
+    i.WriteU16(m_tci);
+}
+
+void
+VlanTag::Deserialize(TagBuffer i)
+{
+    m_tci = i.ReadU16();
+}
+
+void
+VlanTag::Print(std::ostream& os) const
+{
+    os << "PCP=" << +GetPcp() << " DEI=" << GetDei() << " VID=" << GetVid();
+}
+
+VlanHeader::VlanHeader()
+    : m_tci(0),
+      m_type(0)
+{
+}
+
+VlanHeader::VlanHeader(const VlanTag& tag, uint16_t type)
+    : m_tci(tag.GetTci()),
+      m_type(type)
+{
+}
+
+VlanTag
+VlanHeader::GetTag() const
+{
+    VlanTag tag;
+    tag.SetTci(m_tci);
+    return tag;
+}
+
+uint16_t
+VlanHeader::GetType() const
+{
+    return m_type;
+}
+
+TypeId
+VlanHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::VlanHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("Network")
+                            .AddConstructor<VlanHeader>();
+    return tid;
+}
+
+TypeId
+VlanHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+VlanHeader::Print(std::ostream& os) const
+{
+    GetTag().Print(os);
+    os << " type 0x";
+    os.setf(std::ios::hex, std::ios::basefield);
+    os << m_type;
+    os.setf(std::ios::dec, std::ios::basefield);
+}
+
+uint32_t
+VlanHeader::GetSerializedSize() const
+{
+    return 4;
+}
+
+void
+VlanHeader::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+    i.WriteHtonU16(m_tci);
+    i.WriteHtonU16(m_type);
+}
+
+uint32_t
+VlanHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+    m_tci = i.ReadNtohU16();
+    m_type = i.ReadNtohU16();
+    return GetSerializedSize();
+}
+
+} // namespace ns3
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef VLAN_HEADER_H
+#define VLAN_HEADER_H
+
+#include "ns3/header.h"
+#include "ns3/tag.h"
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief IEEE 802.1Q tag of a frame, as seen by the layers above the device.
+ *
+ * The priority code point (PCP), drop eligible indicator (DEI) and VLAN
+ * identifier (VID) travel with the packet as a packet tag.  Devices that
+ * frame packets as Ethernet insert them in the frame as a VlanHeader and
+ * restore the tag on reception.
+ */
+class VlanTag : public Tag
+{
+  public:
+    VlanTag();
+
+    /**
+     * \param pcp the priority code point (0 to 7)
+     * \param vid the VLAN identifier (0 to 4095)
+     * \param dei the drop eligible indicator
+     */
+    VlanTag(uint8_t pcp, uint16_t vid, bool dei = false);
+
+    /**
+     * \param pcp the priority code point (0 to 7)
+     */
+    void SetPcp(uint8_t pcp);
+    /// \return the priority code point
+    uint8_t GetPcp() const;
+
+    /**
+     * \param vid the VLAN identifier (0 to 4095)
+     */
+    void SetVid(uint16_t vid);
+    /// \return the VLAN identifier
+    uint16_t GetVid() const;
+
+    /**
+     * \param dei the drop eligible indicator
+     */
+    void SetDei(bool dei);
+    /// \return the drop eligible indicator
+    bool GetDei() const;
+
+    /// \return the tag control information (PCP, DEI and VID)
+    uint16_t GetTci() const;
+    /**
+     * \param tci the tag control information (PCP, DEI and VID)
+     */
+    void SetTci(uint16_t tci);
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+    void Print(std::ostream& os) const override;
+
+  private:
+    uint16_t m_tci; //!< Tag control information
+};
+
+/**
+ * \ingroup network
+ *
+ * \brief The 4 bytes that follow the addresses of an IEEE 802.1Q frame
+ * after its TPID (0x8100): tag control information and the Ethertype of
+ * the payload.
+ */
+class VlanHeader : public Header
+{
+  public:
+    /// Tag protocol identifier of 802.1Q
+    static const uint16_t TPID = 0x8100;
+
+    VlanHeader();
+
+    /**
+     * \param tag the PCP, DEI and VID of the frame
+     * \param type the Ethertype of the payload
+     */
+    VlanHeader(const VlanTag& tag, uint16_t type);
+
+    /// \return the PCP, DEI and VID of the frame
+    VlanTag GetTag() const;
+
+    /// \return the Ethertype of the payload
+    uint16_t GetType() const;
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    void Print(std::ostream& os) const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+
+  private:
+    uint16_t m_tci;  //!< Tag control information
+    uint16_t m_type; //!< Ethertype of the payload
+};
+
+} // namespace ns3
+
+#endif /* VLAN_HEADER_H */
@@ -18,14 +18,19 @@
  */
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/log.h"
+#include "ns3/multithreaded-simulator-impl.h"
 #include "ns3/names.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/packet.h"
+#include "ns3/queue-item.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-partition-channel.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #ifdef NS3_MPI
 #include "ns3/mpi-interface.h"
@@ -229,6 +234,47 @@ PointToPointHelper::EnableAsciiInternal(Ptr<OutputStreamWrapper> stream,
                     MakeBoundCallback(&AsciiTraceHelper::DefaultDropSinkWithContext, stream));
 }
 
+void
+PointToPointHelper::EnableFlowControl(Ptr<PointToPointNetDevice> device, Ptr<Queue<Packet>> queue)
+{
+    BooleanValue preemption;
+    device->GetAttribute("EnablePreemption", preemption);
+    Ptr<NetDeviceQueueInterface> ndqi =
+        CreateObjectWithAttributes<NetDeviceQueueInterface>("NTxQueues",
+                                                            UintegerValue(preemption.Get() ? 2 : 1));
+    Ptr<NetDeviceQueue> txq = ndqi->GetTxQueue(0);
+    BooleanValue byteQueueLimits;
+    device->GetAttribute("ByteQueueLimits", byteQueueLimits);
+    if (byteQueueLimits.Get())
+    {
+        // the device notifies the transmitted bytes when the transmission completes
+        queue->TraceConnectWithoutContext(
+            "Enqueue",
+            MakeCallback(&NetDeviceQueue::PacketEnqueued<Queue<Packet>>, txq)
+                .Bind(PeekPointer(queue)));
+        queue->TraceConnectWithoutContext(
+            "DropBeforeEnqueue",
+            MakeCallback(&NetDeviceQueue::PacketDiscarded<Queue<Packet>>, txq)
+                .Bind(PeekPointer(queue)));
+    }
+    else
+    {
+        txq->ConnectQueueTraces(queue);
+    }
+    if (preemption.Get())
+    {
+        // the express frames have a transmission queue of their own
+        ndqi->GetTxQueue(1)->ConnectQueueTraces(device->GetExpressQueue());
+        UintegerValue expressPriority;
+        device->GetAttribute("ExpressPriority", expressPriority);
+        uint8_t priority = expressPriority.Get();
+        ndqi->SetSelectQueueCallback([priority](Ptr<QueueItem> item) {
+            return PointToPointNetDevice::SelectTxQueue(item, priority);
+        });
+    }
+    device->AggregateObject(ndqi);
+}
+
 NetDeviceContainer
 PointToPointHelper::Install(NodeContainer c)
 {
@@ -254,50 +300,58 @@ PointToPointHelper::Install(Ptr<Node> a, Ptr<Node> b)
     if (m_enableFlowControl)
     {
         // Aggregate NetDeviceQueueInterface objects
-        Ptr<NetDeviceQueueInterface> ndqiA = CreateObject<NetDeviceQueueInterface>();
-        ndqiA->GetTxQueue(0)->ConnectQueueTraces(queueA);
-        devA->AggregateObject(ndqiA);
-        Ptr<NetDeviceQueueInterface> ndqiB = CreateObject<NetDeviceQueueInterface>();
-        ndqiB->GetTxQueue(0)->ConnectQueueTraces(queueB);
-        devB->AggregateObject(ndqiB);
+        EnableFlowControl(devA, queueA);
+        EnableFlowControl(devB, queueB);
     }
 
     Ptr<PointToPointChannel> channel = nullptr;
 
-    // If MPI is enabled, we need to see if both nodes have the same system id
-    // (rank), and the rank is the same as this instance.  If both are true,
-    // use a normal p2p channel, otherwise use a remote channel
-#ifdef NS3_MPI
-    bool useNormalChannel = true;
-    if (MpiInterface::IsEnabled())
-    {
-        uint32_t n1SystemId = a->GetSystemId();
-        uint32_t n2SystemId = b->GetSystemId();
-        uint32_t currSystemId = MpiInterface::GetSystemId();
-        if (n1SystemId != currSystemId || n2SystemId != currSystemId)
-        {
-            useNormalChannel = false;
-        }
-    }
-    if (useNormalChannel)
+    // With a MultithreadedSimulatorImpl, the nodes of different partitions
+    // run in different threads and must not share packets
+    if (a->GetSystemId() != b->GetSystemId() &&
+        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation()))
     {
-        m_channelFactory.SetTypeId("ns3::PointToPointChannel");
-        channel = m_channelFactory.Create<PointToPointChannel>();
+        ObjectFactory channelFactory = m_channelFactory;
+        channelFactory.SetTypeId("ns3::PointToPointPartitionChannel");
+        channel = channelFactory.Create<PointToPointPartitionChannel>();
     }
     else
     {
-        m_channelFactory.SetTypeId("ns3::PointToPointRemoteChannel");
-        channel = m_channelFactory.Create<PointToPointRemoteChannel>();
-        Ptr<MpiReceiver> mpiRecA = CreateObject<MpiReceiver>();
-        Ptr<MpiReceiver> mpiRecB = CreateObject<MpiReceiver>();
-        mpiRecA->SetReceiveCallback(MakeCallback(&PointToPointNetDevice::Receive, devA));
-        mpiRecB->SetReceiveCallback(MakeCallback(&PointToPointNetDevice::Receive, devB));
-        devA->AggregateObject(mpiRecA);
-        devB->AggregateObject(mpiRecB);
-    }
+        // If MPI is enabled, we need to see if both nodes have the same system id
+        // (rank), and the rank is the same as this instance.  If both are true,
+        // use a normal p2p channel, otherwise use a remote channel
+#ifdef NS3_MPI
+        bool useNormalChannel = true;
+        if (MpiInterface::IsEnabled())
+        {
+            uint32_t n1SystemId = a->GetSystemId();
+            uint32_t n2SystemId = b->GetSystemId();
+            uint32_t currSystemId = MpiInterface::GetSystemId();
+            if (n1SystemId != currSystemId || n2SystemId != currSystemId)
+            {
+                useNormalChannel = false;
+            }
+        }
+        if (useNormalChannel)
+        {
+            m_channelFactory.SetTypeId("ns3::PointToPointChannel");
+            channel = m_channelFactory.Create<PointToPointChannel>();
+        }
+        else
+        {
+            m_channelFactory.SetTypeId("ns3::PointToPointRemoteChannel");
+            channel = m_channelFactory.Create<PointToPointRemoteChannel>();
+            Ptr<MpiReceiver> mpiRecA = CreateObject<MpiReceiver>();
+            Ptr<MpiReceiver> mpiRecB = CreateObject<MpiReceiver>();
+            mpiRecA->SetReceiveCallback(MakeCallback(&PointToPointNetDevice::Receive, devA));
+            mpiRecB->SetReceiveCallback(MakeCallback(&PointToPointNetDevice::Receive, devB));
+            devA->AggregateObject(mpiRecA);
+            devB->AggregateObject(mpiRecB);
+        }
 #else
-    channel = m_channelFactory.Create<PointToPointChannel>();
+        channel = m_channelFactory.Create<PointToPointChannel>();
 #endif
+    }
 
     devA->Attach(channel);
     devB->Attach(channel);
@@ -32,6 +32,7 @@ namespace ns3
 
 class NetDevice;
 class Node;
+class PointToPointNetDevice;
 
 /**
  * \brief Build a set of PointToPointNetDevice objects
@@ -186,6 +187,19 @@ class PointToPointHelper : public PcapHelperForDevice, public AsciiTraceHelperFo
                              Ptr<NetDevice> nd,
                              bool explicitFilename) override;
 
+    /**
+     * \brief Aggregate a NetDeviceQueueInterface to a device and connect the
+     * traces of the device queue to it.
+     *
+     * If the device reports the transmitted bytes itself ("ByteQueueLimits"),
+     * the Dequeue trace of the queue is not connected.  With "EnablePreemption",
+     * the device gets a second transmission queue, for its express queue.
+     *
+     * \param device the device
+     * \param queue the device queue
+     */
+    void EnableFlowControl(Ptr<PointToPointNetDevice> device, Ptr<Queue<Packet>> queue);
+
     ObjectFactory m_queueFactory;   //!< Queue Factory
     ObjectFactory m_channelFactory; //!< Channel Factory
     ObjectFactory m_deviceFactory;  //!< Device Factory
@@ -122,6 +122,13 @@ PointToPointChannel::GetPointToPointDevice(std::size_t i) const
     return m_link[i].m_src;
 }
 
+PointToPointNetDevice*
+PointToPointChannel::PeekPointToPointDevice(std::size_t i) const
+{
+    NS_ASSERT(i < 2);
+    return PeekPointer(m_link[i].m_src);
+}
+
 Ptr<NetDevice>
 PointToPointChannel::GetDevice(std::size_t i) const
 {
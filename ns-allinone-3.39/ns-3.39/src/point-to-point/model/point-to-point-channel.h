@@ -70,7 +70,7 @@ class PointToPointChannel : public Channel
      * \brief Attach a given netdevice to this channel
      * \param device pointer to the netdevice to attach to the channel
      */
-    void Attach(Ptr<PointToPointNetDevice> device);
+    virtual void Attach(Ptr<PointToPointNetDevice> device);
 
     /**
      * \brief Transmit a packet over this channel
@@ -94,6 +94,18 @@ class PointToPointChannel : public Channel
      */
     Ptr<PointToPointNetDevice> GetPointToPointDevice(std::size_t i) const;
 
+    /**
+     * \brief Get PointToPointNetDevice corresponding to index i on this channel,
+     * without a new reference
+     *
+     * The devices of a link between partitions of a MultithreadedSimulatorImpl
+     * run in different threads, which must not share their reference counts.
+     *
+     * \param i Index number of the device requested
+     * \returns the PointToPointNetDevice requested
+     */
+    PointToPointNetDevice* PeekPointToPointDevice(std::size_t i) const;
+
     /**
      * \brief Get NetDevice corresponding to index i on this channel
      * \param i Index number of the device requested
@@ -20,15 +20,23 @@
 #include "point-to-point-channel.h"
 #include "ppp-header.h"
 
+#include "ns3/boolean.h"
 #include "ns3/error-model.h"
+#include "ns3/ethernet-header.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
 #include "ns3/mac48-address.h"
+#include "ns3/net-device-queue-interface.h"
 #include "ns3/pointer.h"
+#include "ns3/queue-item.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
+#include "ns3/tag.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
+#include "ns3/vlan-header.h"
+
+#include <algorithm>
 
 namespace ns3
 {
@@ -37,6 +45,117 @@ NS_LOG_COMPONENT_DEFINE("PointToPointNetDevice");
 
 NS_OBJECT_ENSURE_REGISTERED(PointToPointNetDevice);
 
+/**
+ * \ingroup point-to-point
+ *
+ * \brief Fragment of a preempted frame on the wire.
+ *
+ * The fragments that end in an mCRC are empty packets of their size; the
+ * last fragment carries the whole frame, so that the receiver can pass it
+ * up once it has counted the previous fragments.
+ */
+class PointToPointFragmentTag : public Tag
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    PointToPointFragmentTag();
+
+    /**
+     * \param count the fragment count (index of the fragment in the frame)
+     * \param last true for the last fragment of the frame
+     */
+    PointToPointFragmentTag(uint8_t count, bool last);
+
+    /// \return the fragment count
+    uint8_t GetCount() const;
+
+    /// \return true for the last fragment of the frame
+    bool IsLast() const;
+
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+    void Print(std::ostream& os) const override;
+
+  private:
+    uint8_t m_count; //!< Fragment count
+    bool m_last;     //!< Last fragment of the frame
+};
+
+NS_OBJECT_ENSURE_REGISTERED(PointToPointFragmentTag);
+
+TypeId
+PointToPointFragmentTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::PointToPointFragmentTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("PointToPoint")
+                            .AddConstructor<PointToPointFragmentTag>();
+    return tid;
+}
+
+TypeId
+PointToPointFragmentTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+PointToPointFragmentTag::PointToPointFragmentTag()
+    : m_count(0),
+      m_last(false)
+{
+}
+
+PointToPointFragmentTag::PointToPointFragmentTag(uint8_t count, bool last)
+    : m_count(count),
+      m_last(last)
+{
+}
+
+uint8_t
+PointToPointFragmentTag::GetCount() const
+{
+    return m_count;
+}
+
+bool
+PointToPointFragmentTag::IsLast() const
+{
+    return m_last;
+}
+
+uint32_t
+PointToPointFragmentTag::GetSerializedSize() const
+{
+    return 2;
+}
+
+void
+PointToPointFragmentTag::Serialize(TagBuffer i) const
+{
+    i.WriteU8(m_count);
+    i.WriteU8(m_last ? 1 : 0);
+}
+
+void
+PointToPointFragmentTag::Deserialize(TagBuffer i)
+{
+    m_count = i.ReadU8();
+    m_last = i.ReadU8() != 0;
+}
+
+void
+PointToPointFragmentTag::Print(std::ostream& os) const
+{
+    os << "count=" << +m_count << " last=" << m_last;
+}
+
 TypeId
 PointToPointNetDevice::GetTypeId()
 {
@@ -86,6 +205,41 @@ PointToPointNetDevice::GetTypeId()
                             BooleanValue(false),
                             MakeBooleanAccessor(&PointToPointNetDevice::m_model_enable),
                             MakeBooleanChecker())
+            .AddAttribute("ByteQueueLimits",
+                          "If true, the bytes of a packet are reported to the queue limits "
+                          "(e.g., DynamicQueueLimits) of the device transmission queue when "
+                          "its transmission completes instead of when it leaves the device "
+                          "queue, so that the limits also account for the packet on the wire. "
+                          "It must be set before the PointToPointHelper installs the device.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PointToPointNetDevice::m_byteQueueLimits),
+                          MakeBooleanChecker())
+            .AddAttribute("CompletionBatch",
+                          "In ByteQueueLimits mode, number of transmitted packets whose bytes "
+                          "are reported at once to the queue limits (the report is anticipated "
+                          "if the device queue becomes empty). A larger batch lets the queue "
+                          "disc hand several packets to the device per wake-up.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_completionBatch),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("EnablePreemption",
+                          "If true, the express frames preempt the frames of the transmission "
+                          "queue on the wire (802.1Qbu/802.3br frame preemption).",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PointToPointNetDevice::m_enablePreemption),
+                          MakeBooleanChecker())
+            .AddAttribute("ExpressPriority",
+                          "With EnablePreemption, the frames whose PCP (802.1Q header) or DSCP "
+                          "class selector (IP header) is at least this value are express frames.",
+                          UintegerValue(5),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_expressPriority),
+                          MakeUintegerChecker<uint8_t>(0, 7))
+            .AddAttribute("MinFragmentSize",
+                          "With EnablePreemption, minimum size in bytes of the fragments of a "
+                          "preempted frame, including the 4-byte mCRC.",
+                          UintegerValue(64),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_minFragmentSize),
+                          MakeUintegerChecker<uint32_t>(64))
 
             //
             // Transmit queueing discipline for the device which includes its own set
@@ -96,6 +250,12 @@ PointToPointNetDevice::GetTypeId()
                           PointerValue(),
                           MakePointerAccessor(&PointToPointNetDevice::m_queue),
                           MakePointerChecker<Queue<Packet>>())
+            .AddAttribute("RxQueue",
+                          "The queue the received packets go through before their "
+                          "switching starts.",
+                          PointerValue(),
+                          MakePointerAccessor(&PointToPointNetDevice::m_queuerx),
+                          MakePointerChecker<DropTailQueue<Packet>>())
 
             //
             // Trace sources at the "top" of the net device, where packets transition
@@ -152,6 +312,11 @@ PointToPointNetDevice::GetTypeId()
                             "dropped by the device during transmission",
                             MakeTraceSourceAccessor(&PointToPointNetDevice::m_phyTxDropTrace),
                             "ns3::Packet::TracedCallback")
+            .AddTraceSource("Preemption",
+                            "Trace source indicating a preemptable frame has been "
+                            "preempted by an express frame",
+                            MakeTraceSourceAccessor(&PointToPointNetDevice::m_preemptionTrace),
+                            "ns3::Packet::TracedCallback")
 #if 0
     // Not currently implemented for this device
     .AddTraceSource ("PhyRxBegin",
@@ -224,12 +389,23 @@ PointToPointNetDevice::PointToPointNetDevice()
       m_rxMachineState(ON),
       m_channel(nullptr),
       m_linkUp(false),
-      m_currentPkt(nullptr)
+      m_currentPkt(nullptr),
+      m_completedBytes(0),
+      m_completedPackets(0),
+      m_txExpress(false),
+      m_fragHeader(0),
+      m_fragOffset(0),
+      m_fragEnd(0),
+      m_fragCount(0),
+      m_rxFragCount(0),
+      m_nPreemptions(0),
+      m_nReassembled(0)
 
 {
     NS_LOG_FUNCTION(this);
 
     m_queuerx = CreateObject<DropTailQueue<Packet>>();
+    m_expressQueue = CreateObject<DropTailQueue<Packet>>();
 
 
 }
@@ -248,13 +424,74 @@ PointToPointNetDevice::AddHeader(Ptr<Packet> p, uint16_t protocolNumber)
     p->AddHeader(ppp);
 }
 
+void
+PointToPointNetDevice::AddEthernetHeader(Ptr<Packet> p,
+                                         Mac48Address source,
+                                         Mac48Address dest,
+                                         uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << p << source << dest << protocolNumber);
+    VlanTag tag;
+    if (p->RemovePacketTag(tag))
+    {
+        p->AddHeader(VlanHeader(tag, protocolNumber));
+        protocolNumber = VlanHeader::TPID;
+    }
+    EthernetHeader ethernet(false);
+    ethernet.SetSource(source);
+    ethernet.SetDestination(dest);
+    ethernet.SetLengthType(protocolNumber);
+    p->AddHeader(ethernet);
+}
+
 bool
-PointToPointNetDevice::ProcessHeader(Ptr<Packet> p, uint16_t& param)
+PointToPointNetDevice::ProcessHeader(Ptr<Packet> p,
+                                     uint16_t& param,
+                                     Address& from,
+                                     Address& to,
+                                     NetDevice::PacketType& packetType)
 {
     NS_LOG_FUNCTION(this << p << param);
     PppHeader ppp;
     p->RemoveHeader(ppp);
     param = PppToEther(ppp.GetProtocol());
+    if (param != 0x6558)
+    {
+        return true;
+    }
+
+    // Ethernet frame bridged over PPP
+    EthernetHeader ethernet(false);
+    p->RemoveHeader(ethernet);
+    param = ethernet.GetLengthType();
+    if (param == VlanHeader::TPID)
+    {
+        VlanHeader vlan;
+        p->RemoveHeader(vlan);
+        VlanTag tag = vlan.GetTag();
+        p->ReplacePacketTag(tag);
+        param = vlan.GetType();
+    }
+
+    Mac48Address dest = ethernet.GetDestination();
+    from = ethernet.GetSource();
+    to = dest;
+    if (dest.IsBroadcast())
+    {
+        packetType = NetDevice::PACKET_BROADCAST;
+    }
+    else if (dest.IsGroup())
+    {
+        packetType = NetDevice::PACKET_MULTICAST;
+    }
+    else if (dest == m_address)
+    {
+        packetType = NetDevice::PACKET_HOST;
+    }
+    else
+    {
+        packetType = NetDevice::PACKET_OTHERHOST;
+    }
     return true;
 }
 
@@ -267,12 +504,32 @@ PointToPointNetDevice::DoDispose()
     m_receiveErrorModel = nullptr;
     m_currentPkt = nullptr;
     m_queue = nullptr;
+    m_netDeviceQueue = nullptr;
+    m_txCompleteEvent.Cancel();
+    m_fragEndEvent.Cancel();
+    m_expressQueue = nullptr;
+    m_preemptedPkt = nullptr;
  
   
 
     NetDevice::DoDispose();
 }
 
+void
+PointToPointNetDevice::NotifyNewAggregate()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_netDeviceQueue)
+    {
+        Ptr<NetDeviceQueueInterface> ndqi = GetObject<NetDeviceQueueInterface>();
+        if (ndqi)
+        {
+            m_netDeviceQueue = ndqi->GetTxQueue(0);
+        }
+    }
+    NetDevice::NotifyNewAggregate();
+}
+
 void
 PointToPointNetDevice::SetDataRate(DataRate bps)
 {
@@ -287,10 +544,16 @@ PointToPointNetDevice::SetInterframeGap(Time t)
     m_tInterframeGap = t;
 }
 
+uint32_t
+PointToPointNetDevice::GetTxBytes(Ptr<const Packet> p) const
+{
+    return m_model_enable ? p->GetSize() - 28 : p->GetSize();
+}
+
 bool
-PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
+PointToPointNetDevice::TransmitStart(Ptr<Packet> p, bool express)
 {
-    NS_LOG_FUNCTION(this << p);
+    NS_LOG_FUNCTION(this << p << express);
     NS_LOG_LOGIC("UID is " << p->GetUid() << ")");
     Time txTime;
     //
@@ -303,11 +566,8 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     m_currentPkt = p;
     m_phyTxBeginTrace(m_currentPkt);
     m_snifferTs("IN");
-    if (m_model_enable){
-        txTime = m_bps.CalculateBytesTxTime(p->GetSize()-28);
-    }else{
-        txTime = m_bps.CalculateBytesTxTime(p->GetSize());
-    }
+    m_txTime.SetRate(m_bps);
+    txTime = m_txTime.NextBytesTxTime(GetTxBytes(p));
  
     // std::cout << txTime << " || " << p->GetSize() << std::endl;
     // std::cout << this  << " " <<  Simulator::Now().GetSeconds() << " | Tx: " << p->GetSize() << " " << txTime << std::endl;
@@ -315,7 +575,21 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
    
-    Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+    m_txCompleteEvent =
+        Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+    m_txExpress = express;
+
+    if (m_enablePreemption && !express)
+    {
+        // a preemptable frame is handed to the channel when its last fragment ends
+        m_fragStart = Simulator::Now();
+        m_fragHeader = 0;
+        m_fragOffset = 0;
+        m_fragEnd = GetTxBytes(p);
+        m_fragCount = 0;
+        ScheduleFragmentEnd(txTime);
+        return true;
+    }
 
     bool result = m_channel->TransmitStart(p, this, txTime);
     if (!result)
@@ -328,7 +602,8 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
 Time PointToPointNetDevice::CalculateSwitchingTime(uint32_t bytes){
     
     // std::cout << "Bytes: " << bytes << " " << m_tSwitchingCapacity.GetBitRate() << " "<< int64x64_t(bytes*8)/m_tSwitchingCapacity.GetBitRate()<< std::endl;
-    return MilliSeconds(int64x64_t(bytes*8)/m_tSwitchingCapacity.GetBitRate()*1e3);
+    m_switchingTime.SetRate(m_tSwitchingCapacity);
+    return m_switchingTime.NextBytesTxTime(bytes);
 }
 
 void
@@ -385,7 +660,10 @@ PointToPointNetDevice::SwitchingComplete(Ptr<Packet> packet){
     // normal receive callback sees.
     //
     // std::cout << Simulator::Now().GetSeconds() << " | Rx: " << packet->GetSize() << std::endl;
-    ProcessHeader(packet, protocol);
+    Address from = GetRemote();
+    Address to = GetAddress();
+    NetDevice::PacketType packetType = NetDevice::PACKET_HOST;
+    ProcessHeader(packet, protocol, from, to, packetType);
 
     if (!m_promiscCallback.IsNull())
     {
@@ -393,16 +671,19 @@ PointToPointNetDevice::SwitchingComplete(Ptr<Packet> packet){
         m_promiscCallback(this,
                         packet,
                         protocol,
-                        GetRemote(),
-                        GetAddress(),
-                        NetDevice::PACKET_HOST);
+                        from,
+                        to,
+                        packetType);
                         
     }
 
     m_macRxTrace(originalPacket);
     
            
-    m_rxCallback(this, packet, protocol, GetRemote());   
+    if (packetType != NetDevice::PACKET_OTHERHOST)
+    {
+        m_rxCallback(this, packet, protocol, from);
+    }
     m_promiscSnifferActionrxTrace(packet,"Tx");     
    
           
@@ -444,16 +725,71 @@ PointToPointNetDevice::TransmitComplete()
 
     NS_ASSERT_MSG(m_currentPkt, "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
 
+    bool express = m_txExpress;
+    if (m_enablePreemption && !express)
+    {
+        if (m_tInterframeGap.IsZero())
+        {
+            FragmentEnd();
+        }
+        if (m_fragEnd < GetTxBytes(m_currentPkt))
+        {
+            // the frame was preempted: the express frames go before the rest
+            // of the frame
+            m_fragCount++;
+            m_fragOffset = m_fragEnd;
+            m_preemptedPkt = m_currentPkt;
+            m_currentPkt = nullptr;
+            Ptr<Packet> p = m_expressQueue->Dequeue();
+            if (!p)
+            {
+                ResumeTransmission();
+                return;
+            }
+            m_snifferTrace(p);
+            m_promiscSnifferTrace(p);
+            m_snifferTwait(p, "OUT");
+            TransmitStart(p, true);
+            return;
+        }
+
+        m_fragCount = 0;
+        m_fragOffset = 0;
+    }
+
     m_phyTxEndTrace(m_currentPkt);
+    uint32_t bytes = m_currentPkt->GetSize();
     m_currentPkt = nullptr;
     // std::cout << "Transmit Complete" << std::endl;  
-    Ptr<Packet> p = m_queue->Dequeue();
+    Ptr<Packet> p;
+    bool nextExpress = false;
+    if (m_enablePreemption)
+    {
+        // express frames first, then the preempted frame
+        p = m_expressQueue->Dequeue();
+        nextExpress = (p != nullptr);
+        if (!p && m_preemptedPkt)
+        {
+            ResumeTransmission();
+            return;
+        }
+    }
+    if (!p)
+    {
+        p = m_queue->Dequeue();
+    }
     
     
     if (!p)
     {
         
         NS_LOG_LOGIC("No pending packets in device queue after tx complete");
+        // the express frames do not come from the transmission queue, but the
+        // bytes still pending are reported when the device becomes idle
+        if (!express || m_completedPackets > 0)
+        {
+            NotifyTransmittedBytes(express ? 0 : bytes, true);
+        }
         return;
     }
     // std::cout << this << "  " << Simulator::Now().GetSeconds() << " call dequeue" << std::endl;
@@ -467,7 +803,135 @@ PointToPointNetDevice::TransmitComplete()
     // std::cout << "Transmit Complete" << std::endl;
     // m_promiscSinfferActionTrace(p,"Tx_complete");
     m_snifferTwait(p, "OUT"); // Twait end due to the fact that firstly we have to enqueue the packet
-    TransmitStart(p);
+    TransmitStart(p, nextExpress);
+    if (!express)
+    {
+        NotifyTransmittedBytes(bytes, false);
+    }
+}
+
+void
+PointToPointNetDevice::ResumeTransmission()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_txMachineState == READY, "Must be READY to transmit");
+    m_txMachineState = BUSY;
+    m_currentPkt = m_preemptedPkt;
+    m_preemptedPkt = nullptr;
+    m_txExpress = false;
+    m_fragStart = Simulator::Now();
+    m_fragHeader = CONTINUATION_BYTES;
+    m_fragEnd = GetTxBytes(m_currentPkt);
+    Time txTime = m_txTime.NextBytesTxTime(m_fragHeader + m_fragEnd - m_fragOffset);
+    NS_LOG_LOGIC("Resume " << m_currentPkt << " at byte " << m_fragOffset << " for "
+                           << txTime.As(Time::S));
+    m_txCompleteEvent = Simulator::Schedule(txTime + m_tInterframeGap,
+                                            &PointToPointNetDevice::TransmitComplete,
+                                            this);
+    ScheduleFragmentEnd(txTime);
+}
+
+void
+PointToPointNetDevice::ScheduleFragmentEnd(Time delay)
+{
+    m_fragEndEvent.Cancel();
+    if (!m_tInterframeGap.IsZero())
+    {
+        m_fragEndEvent = Simulator::Schedule(delay, &PointToPointNetDevice::FragmentEnd, this);
+    }
+}
+
+void
+PointToPointNetDevice::FragmentEnd()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_fragEnd < GetTxBytes(m_currentPkt))
+    {
+        // the frame was preempted: the fragment ends here
+        NS_LOG_LOGIC("Fragment " << +m_fragCount << " of " << m_currentPkt << " ends at byte "
+                                 << m_fragEnd);
+        Ptr<Packet> fragment = Create<Packet>(m_fragHeader + m_fragEnd - m_fragOffset + MCRC_BYTES);
+        fragment->AddPacketTag(PointToPointFragmentTag(m_fragCount, false));
+        m_channel->TransmitStart(fragment, this, Seconds(0));
+        return;
+    }
+
+    // last bit of the frame: the channel delivers it (reassembled) now
+    Ptr<Packet> frame = m_currentPkt;
+    if (m_fragCount > 0)
+    {
+        frame = m_currentPkt->Copy();
+        frame->AddPacketTag(PointToPointFragmentTag(m_fragCount, true));
+    }
+    if (!m_channel->TransmitStart(frame, this, Seconds(0)))
+    {
+        m_phyTxDropTrace(m_currentPkt);
+    }
+}
+
+bool
+PointToPointNetDevice::Preempt()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t frame = GetTxBytes(m_currentPkt);
+    if (m_fragEnd < frame)
+    {
+        NS_LOG_LOGIC("The frame is already preempted");
+        return false;
+    }
+    // bytes of the fragment on the wire so far, up to the next byte boundary
+    int64x64_t bits = (Simulator::Now() - m_fragStart).To(Time::S) * m_bps.GetBitRate();
+    uint64_t sent = (bits.GetHigh() + (bits.GetLow() > 0 ? 1 : 0) + 7) / 8;
+    uint32_t minBytes = m_minFragmentSize - MCRC_BYTES;
+    uint64_t cut = m_fragOffset + std::max<uint64_t>(sent > m_fragHeader ? sent - m_fragHeader : 0,
+                                                      minBytes);
+    if (cut + minBytes > frame)
+    {
+        NS_LOG_LOGIC("Too late to preempt " << m_currentPkt);
+        return false;
+    }
+    // the carry of the serialization times counts the fragment, not the
+    // whole frame (or remainder) given to NextBytesTxTime
+    Time end = m_fragStart + m_txTime.CutLastBytesTxTime(m_fragHeader + frame - m_fragOffset,
+                                                         m_fragHeader + cut - m_fragOffset +
+                                                             MCRC_BYTES);
+    m_fragEnd = cut;
+    NS_LOG_LOGIC("Preempt " << m_currentPkt << " at byte " << m_fragEnd << ", "
+                            << end.As(Time::S));
+    m_txCompleteEvent.Cancel();
+    m_txCompleteEvent = Simulator::Schedule(end - Simulator::Now() + m_tInterframeGap,
+                                            &PointToPointNetDevice::TransmitComplete,
+                                            this);
+    ScheduleFragmentEnd(end - Simulator::Now());
+    m_nPreemptions++;
+    m_preemptionTrace(m_currentPkt);
+    return true;
+}
+
+void
+PointToPointNetDevice::NotifyTransmittedBytes(uint32_t bytes, bool idle)
+{
+    NS_LOG_FUNCTION(this << bytes << idle);
+    if (!m_byteQueueLimits || !m_netDeviceQueue)
+    {
+        return;
+    }
+    m_completedBytes += bytes;
+    m_completedPackets++;
+    if (idle || m_completedPackets >= m_completionBatch)
+    {
+        NS_LOG_LOGIC("Report " << m_completedBytes << " bytes of " << m_completedPackets
+                               << " packets to the queue limits");
+        uint32_t completed = m_completedBytes;
+        m_completedBytes = 0;
+        m_completedPackets = 0;
+        // this may wake the queue disc up, which sends more packets to the device
+        m_netDeviceQueue->NotifyTransmittedBytes(completed);
+    }
+    if (!m_queue->WouldOverflow(1, GetMtu()))
+    {
+        m_netDeviceQueue->Wake();
+    }
 }
 
 bool
@@ -509,6 +973,11 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
     NS_LOG_FUNCTION(this << packet);
     uint16_t protocol = 0;
 
+    if (!Reassemble(packet))
+    {
+        return;
+    }
+
     if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt(packet))
     {
         //
@@ -558,7 +1027,10 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
             // normal receive callback sees.
             //
           
-            ProcessHeader(packet, protocol);
+            Address from = GetRemote();
+            Address to = GetAddress();
+            NetDevice::PacketType packetType = NetDevice::PACKET_HOST;
+            ProcessHeader(packet, protocol, from, to, packetType);
 
             if (!m_promiscCallback.IsNull())
             {
@@ -566,16 +1038,19 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
                 m_promiscCallback(this,
                                 packet,
                                 protocol,
-                                GetRemote(),
-                                GetAddress(),
-                                NetDevice::PACKET_HOST);
+                                from,
+                                to,
+                                packetType);
                                
             }
 
             m_macRxTrace(originalPacket);
             
             m_promiscSnifferActionrxTrace(packet,"Rx");
-            m_rxCallback(this, packet, protocol, GetRemote());
+            if (packetType != NetDevice::PACKET_OTHERHOST)
+            {
+                m_rxCallback(this, packet, protocol, from);
+            }
         }
 
 
@@ -598,6 +1073,56 @@ PointToPointNetDevice::GetRxQueue() const
     return m_queuerx;
 }
 
+void
+PointToPointNetDevice::SetExpressQueue(Ptr<Queue<Packet>> queue)
+{
+    NS_LOG_FUNCTION(this << queue);
+    m_expressQueue = queue;
+}
+
+Ptr<Queue<Packet>>
+PointToPointNetDevice::GetExpressQueue() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_expressQueue;
+}
+
+uint64_t
+PointToPointNetDevice::GetNPreemptions() const
+{
+    return m_nPreemptions;
+}
+
+uint64_t
+PointToPointNetDevice::GetNReassembledFrames() const
+{
+    return m_nReassembled;
+}
+
+bool
+PointToPointNetDevice::Reassemble(Ptr<Packet> p)
+{
+    PointToPointFragmentTag tag;
+    if (!p->RemovePacketTag(tag))
+    {
+        return true;
+    }
+    NS_LOG_FUNCTION(this << p << +tag.GetCount() << tag.IsLast());
+    if (tag.GetCount() != m_rxFragCount)
+    {
+        NS_LOG_WARN("Fragment " << +tag.GetCount() << " received instead of "
+                                << +m_rxFragCount);
+    }
+    if (!tag.IsLast())
+    {
+        m_rxFragCount = tag.GetCount() + 1;
+        return false;
+    }
+    m_rxFragCount = 0;
+    m_nReassembled++;
+    return true;
+}
+
 
 void
 PointToPointNetDevice::NotifyLinkUp()
@@ -737,14 +1262,30 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
         return false;
     }
 
+    //
+    // The protocols without a PPP number travel in Ethernet frames
+    //
+    if (protocolNumber != 0x0800 && protocolNumber != 0x86DD && protocolNumber != 0x6558)
+    {
+        AddEthernetHeader(packet, m_address, Mac48Address::ConvertFrom(dest), protocolNumber);
+        protocolNumber = 0x6558;
+    }
+
     //
     // Stick a point to point protocol header on the packet in preparation for
     // shoving it out the door.
     //
+    bool express = m_enablePreemption &&
+                   GetFramePriority(packet, protocolNumber) >= m_expressPriority;
     AddHeader(packet, protocolNumber);
 
     m_macTxTrace(packet);
 
+    if (express)
+    {
+        return SendExpress(packet);
+    }
+
     //
     // We should enqueue and dequeue the packet to hit the tracing hooks.
     //
@@ -761,6 +1302,13 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
         if (m_txMachineState == READY)
         {
             packet = m_queue->Dequeue();
+            if (m_byteQueueLimits && m_netDeviceQueue && !m_queue->WouldOverflow(1, GetMtu()))
+            {
+                // the Dequeue trace is not connected in this mode, hence restart the
+                // transmission queue here (a queue disc that is running this Send
+                // just keeps dequeuing packets)
+                m_netDeviceQueue->Wake();
+            }
             // if (packet != nullptr) {
             //     std::cout << this << "  " << Simulator::Now().GetSeconds() << " call dequeue" << std::endl;
             // }
@@ -779,6 +1327,80 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     return false;
 }
 
+bool
+PointToPointNetDevice::SendExpress(Ptr<Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet);
+    if (!m_expressQueue->Enqueue(packet))
+    {
+        m_macTxDropTrace(packet);
+        return false;
+    }
+    if (m_txMachineState == READY)
+    {
+        packet = m_expressQueue->Dequeue();
+        m_snifferTrace(packet);
+        m_promiscSnifferTrace(packet);
+        m_snifferTwait(packet, "OUT");
+        return TransmitStart(packet, true);
+    }
+    if (!m_txExpress)
+    {
+        Preempt();
+    }
+    return true;
+}
+
+std::size_t
+PointToPointNetDevice::SelectTxQueue(Ptr<QueueItem> item, uint8_t expressPriority)
+{
+    uint8_t priority = 0;
+    VlanTag tag;
+    uint8_t tos;
+    if (item->GetPacket()->PeekPacketTag(tag))
+    {
+        priority = tag.GetPcp();
+    }
+    else if (item->GetUint8Value(QueueItem::IP_DSFIELD, tos))
+    {
+        priority = tos >> 5;
+    }
+    return priority >= expressPriority ? 1 : 0;
+}
+
+uint8_t
+PointToPointNetDevice::GetFramePriority(Ptr<const Packet> p, uint16_t protocolNumber)
+{
+    // Ethernet header, 802.1Q header and the first bytes of an IP header
+    uint8_t buffer[20];
+    uint32_t size = p->CopyData(buffer, sizeof(buffer));
+    uint32_t offset = 0;
+    if (protocolNumber == 0x6558 && size >= 16)
+    {
+        protocolNumber = (buffer[12] << 8) | buffer[13];
+        if (protocolNumber == VlanHeader::TPID)
+        {
+            return buffer[14] >> 5;
+        }
+        offset = 14;
+    }
+    if (offset + 2 > size)
+    {
+        return 0;
+    }
+    if (protocolNumber == 0x0800)
+    {
+        // type of service
+        return buffer[offset + 1] >> 5;
+    }
+    if (protocolNumber == 0x86DD)
+    {
+        // traffic class, after the version
+        return (buffer[offset] & 0x0f) >> 1;
+    }
+    return 0;
+}
+
 bool
 PointToPointNetDevice::SendFrom(Ptr<Packet> packet,
                                 const Address& source,
@@ -786,7 +1408,11 @@ PointToPointNetDevice::SendFrom(Ptr<Packet> packet,
                                 uint16_t protocolNumber)
 {
     NS_LOG_FUNCTION(this << packet << source << dest << protocolNumber);
-    return false;
+    AddEthernetHeader(packet,
+                      Mac48Address::ConvertFrom(source),
+                      Mac48Address::ConvertFrom(dest),
+                      protocolNumber);
+    return Send(packet, dest, 0x6558);
 }
 
 Ptr<Node>
@@ -825,7 +1451,7 @@ bool
 PointToPointNetDevice::SupportsSendFrom() const
 {
     NS_LOG_FUNCTION(this);
-    return false;
+    return true;
 }
 
 void
@@ -842,7 +1468,8 @@ PointToPointNetDevice::GetRemote() const
     NS_ASSERT(m_channel->GetNDevices() == 2);
     for (std::size_t i = 0; i < m_channel->GetNDevices(); ++i)
     {
-        Ptr<NetDevice> tmp = m_channel->GetDevice(i);
+        // no reference: the remote device may run in another thread
+        const PointToPointNetDevice* tmp = m_channel->PeekPointToPointDevice(i);
         if (tmp != this)
         {
             return tmp->GetAddress();
@@ -878,6 +1505,8 @@ PointToPointNetDevice::PppToEther(uint16_t proto)
         return 0x0800; // IPv4
     case 0x0057:
         return 0x86DD; // IPv6
+    case 0x0031:
+        return 0x6558; // Ethernet frame (bridged Ethernet)
     default:
         NS_ASSERT_MSG(false, "PPP Protocol number not defined!");
     }
@@ -894,6 +1523,8 @@ PointToPointNetDevice::EtherToPpp(uint16_t proto)
         return 0x0021; // IPv4
     case 0x86DD:
         return 0x0057; // IPv6
+    case 0x6558:
+        return 0x0031; // Ethernet frame (transparent Ethernet bridging)
     default:
         NS_ASSERT_MSG(false, "PPP Protocol number not defined!");
     }
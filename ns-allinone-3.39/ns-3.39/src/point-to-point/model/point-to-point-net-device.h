@@ -21,6 +21,7 @@
 #include "ns3/address.h"
 #include "ns3/callback.h"
 #include "ns3/data-rate.h"
+#include "ns3/event-id.h"
 #include "ns3/mac48-address.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -28,6 +29,7 @@
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
 #include "ns3/queue-fwd.h"
+#include "ns3/serialization-time.h"
 #include "ns3/traced-callback.h"
 #include "ns3/drop-tail-queue.h"
 
@@ -38,6 +40,8 @@ namespace ns3
 
 class PointToPointChannel;
 class ErrorModel;
+class NetDeviceQueue;
+class QueueItem;
 
 /**
  * \defgroup point-to-point Point-To-Point Network Device
@@ -60,6 +64,32 @@ class ErrorModel;
  * Key parameters or objects that can be specified for this device
  * include a queue, data rate, and interframe transmission gap (the
  * propagation delay is set in the PointToPointChannel).
+ *
+ * IPv4 and IPv6 packets are carried in PPP frames.  Any other protocol
+ * (eCPRI, for instance) and the packets sent with SendFrom are carried in
+ * Ethernet frames bridged over PPP (RFC 3518), without preamble nor FCS, so
+ * the device can be a port of a BridgeNetDevice and a fronthaul network can
+ * be modelled at layer 2 only.  The VlanTag of such a packet becomes the
+ * 802.1Q header of the frame and is restored on reception.  Packets of
+ * Ethertype 0x6558 (transparent Ethernet bridging) already carry their
+ * Ethernet header and are sent as they are.
+ *
+ * With "EnablePreemption", the device has two MAC queues, as an 802.3br
+ * MAC merge sublayer with 802.1Qbu frame preemption: the express frames
+ * (PCP of the 802.1Q header, or class selector of the DSCP of the IP
+ * header, at least "ExpressPriority") go to the express queue and the
+ * other ones to the transmission queue ("TxQueue"), whose frames are
+ * preemptable.  An express frame that finds a preemptable frame on the
+ * wire stops it at the first byte boundary that leaves at least
+ * "MinFragmentSize" bytes (including the 4-byte mCRC of the fragment) on
+ * both sides; the express frames are sent and the rest of the frame
+ * follows as a continuation fragment, with 8 more bytes of preamble, SMD
+ * and fragment count.  The end of the fragment just moves the single
+ * TransmitComplete event of the frame, so a frame costs no more events
+ * than without preemption unless it is actually preempted (or the
+ * "InterframeGap" is not zero: the fragment then goes to the channel at its
+ * last bit, one event before the end of the gap).  The receiver counts the
+ * fragments and passes the frame up when the last one arrives.
  */
 class PointToPointNetDevice : public NetDevice
 {
@@ -133,6 +163,43 @@ class PointToPointNetDevice : public NetDevice
      */
     Ptr<Queue<Packet>> GetQueue() const;
     Ptr<Queue<Packet>> GetRxQueue() const;
+
+    /**
+     * Attach the queue of the express frames (frame preemption).  By default
+     * the device has a DropTailQueue of 100 packets.
+     *
+     * \param queue Ptr to the new queue.
+     */
+    void SetExpressQueue(Ptr<Queue<Packet>> queue);
+
+    /**
+     * \returns Ptr to the queue of the express frames.
+     */
+    Ptr<Queue<Packet>> GetExpressQueue() const;
+
+    /**
+     * Select the device transmission queue of a packet: 1 for the express
+     * frames, 0 otherwise.  The PointToPointHelper installs it as the select
+     * queue callback of the devices with "EnablePreemption", which have a
+     * second transmission queue for the express queue, so that the express
+     * frames are not held in the queue disc by a stopped preemptable queue.
+     *
+     * \param item the packet, as handed to the traffic control layer
+     * \param expressPriority the lowest priority of the express frames
+     * \returns the index of the transmission queue
+     */
+    static std::size_t SelectTxQueue(Ptr<QueueItem> item, uint8_t expressPriority);
+
+    /**
+     * \returns the number of preemptable frames preempted by this device
+     */
+    uint64_t GetNPreemptions() const;
+
+    /**
+     * \returns the number of preempted frames reassembled by this device
+     */
+    uint64_t GetNReassembledFrames() const;
+
     /**
      * Attach a receive ErrorModel to the PointToPointNetDevice.
      *
@@ -207,6 +274,8 @@ class PointToPointNetDevice : public NetDevice
      */
     void DoMpiReceive(Ptr<Packet> p);
 
+    void NotifyNewAggregate() override;
+
   private:
     /**
      * \brief Dispose of the object
@@ -227,15 +296,35 @@ class PointToPointNetDevice : public NetDevice
      */
     void AddHeader(Ptr<Packet> p, uint16_t protocolNumber);
 
+    /**
+     * Adds the Ethernet header (and the 802.1Q header, if the packet has a
+     * VlanTag) of a frame bridged over PPP.
+     * \param p packet
+     * \param source the source address
+     * \param dest the destination address
+     * \param protocolNumber protocol number of the payload
+     */
+    void AddEthernetHeader(Ptr<Packet> p,
+                           Mac48Address source,
+                           Mac48Address dest,
+                           uint16_t protocolNumber);
+
     /**
      * Removes, from a packet of data, all headers and trailers that
      * relate to the protocol implemented by the agent
      * \param p Packet whose headers need to be processed
      * \param param An integer parameter that can be set by the function
+     * \param from the source of the packet, set for Ethernet frames
+     * \param to the destination of the packet, set for Ethernet frames
+     * \param packetType the type of the packet, set for Ethernet frames
      * \return Returns true if the packet should be forwarded up the
      * protocol stack.
      */
-    bool ProcessHeader(Ptr<Packet> p, uint16_t& param);
+    bool ProcessHeader(Ptr<Packet> p,
+                       uint16_t& param,
+                       Address& from,
+                       Address& to,
+                       NetDevice::PacketType& packetType);
 
     /**
      * Start Sending a Packet Down the Wire.
@@ -250,9 +339,68 @@ class PointToPointNetDevice : public NetDevice
      * \see PointToPointChannel::TransmitStart ()
      * \see TransmitComplete()
      * \param p a reference to the packet to send
+     * \param express true if the packet is an express frame (frame preemption)
      * \returns true if success, false on failure
      */
-    bool TransmitStart(Ptr<Packet> p);
+    bool TransmitStart(Ptr<Packet> p, bool express = false);
+
+    /**
+     * \param p a frame, with its PPP header
+     * \returns the bytes of the frame on the wire
+     */
+    uint32_t GetTxBytes(Ptr<const Packet> p) const;
+
+    /**
+     * Get the priority of a frame: the PCP of its 802.1Q header or the class
+     * selector (3 most significant bits) of the DSCP of its IP header.
+     *
+     * \param p a frame, without its PPP header
+     * \param protocolNumber the Ethernet protocol number of the frame
+     * \returns the priority of the frame, zero if it has none
+     */
+    static uint8_t GetFramePriority(Ptr<const Packet> p, uint16_t protocolNumber);
+
+    /**
+     * Queue an express frame, and send it or preempt the frame on the wire.
+     *
+     * \param p the express frame
+     * \returns true if the frame was queued
+     */
+    bool SendExpress(Ptr<Packet> p);
+
+    /**
+     * Stop the preemptable frame on the wire at the first point allowed by
+     * the minimum fragment size, by moving its TransmitComplete event.
+     *
+     * \returns true if the frame is preempted
+     */
+    bool Preempt();
+
+    /**
+     * Send the next fragment of the preempted frame.
+     */
+    void ResumeTransmission();
+
+    /**
+     * Schedule the end of the preemptable fragment on the wire, when the
+     * InterframeGap is not zero (otherwise TransmitComplete ends it).
+     *
+     * \param delay the time to the last bit of the fragment
+     */
+    void ScheduleFragmentEnd(Time delay);
+
+    /**
+     * Hand the preemptable fragment (or frame) which ends now to the channel.
+     */
+    void FragmentEnd();
+
+    /**
+     * Account a fragment of a preempted frame received.
+     *
+     * \param p the fragment, with its fragment tag
+     * \returns true if the fragment completes the frame
+     */
+    bool Reassemble(Ptr<Packet> p);
 
     /**
      * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
@@ -262,6 +410,19 @@ class PointToPointNetDevice : public NetDevice
      */
     void TransmitComplete();
 
+    /**
+     * Report the bytes of a packet whose transmission has completed to the
+     * queue limits of the device transmission queue ("ByteQueueLimits" mode).
+     *
+     * The bytes are accumulated and reported every "CompletionBatch" packets,
+     * or as soon as the device queue is empty, and the transmission queue is
+     * woken up if the device queue has room for another packet.
+     *
+     * \param bytes the size of the transmitted packet
+     * \param idle true if there is no packet left to transmit
+     */
+    void NotifyTransmittedBytes(uint32_t bytes, bool idle);
+
     /**
      * \brief Make the link up and running
      *
@@ -289,6 +450,11 @@ class PointToPointNetDevice : public NetDevice
      */
     DataRate m_bps;
 
+    /**
+     * Exact transmission times at m_bps, carried from one packet to the next
+     */
+    SerializationTime m_txTime;
+
     /**
      * The interframe gap that the Net Device uses to throttle packet
      * transmission
@@ -317,6 +483,12 @@ class PointToPointNetDevice : public NetDevice
      */
 
     Ptr<DropTailQueue<Packet>> m_queuerx;
+
+    /**
+     * The transmission queue of the NetDeviceQueueInterface aggregated to the
+     * device, if any.
+     */
+    Ptr<NetDeviceQueue> m_netDeviceQueue;
    
     
   
@@ -327,6 +499,7 @@ class PointToPointNetDevice : public NetDevice
 
     
     DataRate m_tSwitchingCapacity;
+    SerializationTime m_switchingTime; //!< Exact switching times at m_tSwitchingCapacity
     bool m_enableSwitchingTime;
     bool m_model_enable;
     /**
@@ -481,6 +654,38 @@ class PointToPointNetDevice : public NetDevice
 
     Ptr<Packet> m_currentPkt, m_currentPktrx; //!< Current packet processed
 
+    bool m_byteQueueLimits;     //!< Report the transmitted bytes when the transmission completes
+    uint32_t m_completionBatch; //!< Number of transmitted packets per report
+    uint32_t m_completedBytes;  //!< Transmitted bytes not reported yet
+    uint32_t m_completedPackets; //!< Transmitted packets not reported yet
+
+    /// Bytes of the mCRC that ends a fragment which is not the last one
+    static const uint32_t MCRC_BYTES = 4;
+    /// Bytes of preamble, SMD and fragment count of a continuation fragment
+    static const uint32_t CONTINUATION_BYTES = 8;
+
+    bool m_enablePreemption;           //!< Preempt the frames of the transmission queue
+    uint8_t m_expressPriority;         //!< Lowest priority of the express frames
+    uint32_t m_minFragmentSize;        //!< Minimum size of a fragment, with its mCRC
+    Ptr<Queue<Packet>> m_expressQueue; //!< Queue of the express frames
+    EventId m_txCompleteEvent;         //!< End of the frame (or fragment) on the wire
+    EventId m_fragEndEvent;            //!< Last bit of the fragment, before the gap
+    bool m_txExpress;                  //!< The frame on the wire is an express frame
+    Ptr<Packet> m_preemptedPkt;        //!< Preempted frame waiting for the express frames
+    Time m_fragStart;                  //!< Start of the fragment on the wire
+    uint32_t m_fragHeader;             //!< Overhead bytes at the start of the fragment
+    uint32_t m_fragOffset;             //!< Frame bytes sent in the previous fragments
+    uint32_t m_fragEnd;                //!< Frame bytes sent at the end of the fragment
+    uint8_t m_fragCount;               //!< Fragments of the frame sent so far
+    uint8_t m_rxFragCount;             //!< Fragments of the frame being reassembled
+    uint64_t m_nPreemptions;           //!< Preempted frames
+    uint64_t m_nReassembled;           //!< Reassembled frames
+
+    /**
+     * The trace source fired when a preemptable frame is preempted.
+     */
+    TracedCallback<Ptr<const Packet>> m_preemptionTrace;
+
     /**
      * \brief PPP to Ethernet protocol number mapping
      * \param protocol A PPP protocol number
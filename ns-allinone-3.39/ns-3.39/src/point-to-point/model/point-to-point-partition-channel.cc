@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "point-to-point-partition-channel.h"
+
+#include "point-to-point-net-device.h"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PointToPointPartitionChannel");
+
+NS_OBJECT_ENSURE_REGISTERED(PointToPointPartitionChannel);
+
+TypeId
+PointToPointPartitionChannel::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::PointToPointPartitionChannel")
+                            .SetParent<PointToPointChannel>()
+                            .SetGroupName("PointToPoint")
+                            .AddConstructor<PointToPointPartitionChannel>();
+    return tid;
+}
+
+PointToPointPartitionChannel::PointToPointPartitionChannel()
+    : PointToPointChannel(),
+      m_node{0, 0}
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PointToPointPartitionChannel::~PointToPointPartitionChannel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+PointToPointPartitionChannel::Attach(Ptr<PointToPointNetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    PointToPointChannel::Attach(device);
+    m_node[GetNDevices() - 1] = device->GetNode()->GetId();
+}
+
+bool
+PointToPointPartitionChannel::TransmitStart(Ptr<const Packet> p,
+                                            Ptr<PointToPointNetDevice> src,
+                                            Time txTime)
+{
+    NS_LOG_FUNCTION(this << p << src);
+    NS_LOG_LOGIC("UID is " << p->GetUid() << ")");
+
+    IsInitialized();
+
+    uint32_t wire = PeekPointer(src) == PeekPointToPointDevice(0) ? 0 : 1;
+    std::vector<uint8_t> data(p->GetSerializedSize());
+    p->Serialize(data.data(), data.size());
+    Simulator::ScheduleWithContext(m_node[1 - wire],
+                                   txTime + GetDelay(),
+                                   &PointToPointPartitionChannel::Deliver,
+                                   PeekPointToPointDevice(1 - wire),
+                                   std::move(data));
+    return true;
+}
+
+void
+PointToPointPartitionChannel::Deliver(PointToPointNetDevice* dst, std::vector<uint8_t> data)
+{
+    NS_LOG_FUNCTION(dst);
+    dst->Receive(Create<Packet>(data.data(), data.size(), true));
+}
+
+} // namespace ns3
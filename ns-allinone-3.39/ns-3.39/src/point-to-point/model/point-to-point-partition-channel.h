@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef POINT_TO_POINT_PARTITION_CHANNEL_H
+#define POINT_TO_POINT_PARTITION_CHANNEL_H
+
+#include "point-to-point-channel.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup point-to-point
+ *
+ * \brief A Point-To-Point Channel between two partitions of a
+ * MultithreadedSimulatorImpl
+ *
+ * The two devices run in different threads, so they share no packet nor
+ * reference count: the transmitted packet is serialized in the thread of the
+ * sender and a new packet is deserialized from it in the thread of the
+ * receiver, as with a PointToPointRemoteChannel.  The propagation delay is
+ * the lookahead of the simulation, so it must not be zero.
+ *
+ * The TxRxPointToPoint trace source is not fired, as its sinks would see the
+ * devices of two threads.
+ */
+class PointToPointPartitionChannel : public PointToPointChannel
+{
+  public:
+    /**
+     * \brief Get the TypeId
+     *
+     * \return The TypeId for this class
+     */
+    static TypeId GetTypeId();
+
+    PointToPointPartitionChannel();
+    ~PointToPointPartitionChannel() override;
+
+    void Attach(Ptr<PointToPointNetDevice> device) override;
+
+    /**
+     * \brief Transmit the packet to the device of the other partition
+     *
+     * \param p Packet to transmit
+     * \param src Source PointToPointNetDevice
+     * \param txTime Transmit time to apply
+     * \returns true if successful (currently always true)
+     */
+    bool TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime) override;
+
+  private:
+    /**
+     * \brief Deliver a packet to its destination, in the thread of the destination
+     *
+     * \param dst the destination device
+     * \param data the serialized packet
+     */
+    static void Deliver(PointToPointNetDevice* dst, std::vector<uint8_t> data);
+
+    uint32_t m_node[2]; //!< Id of the node of each device
+};
+
+} // namespace ns3
+
+#endif /* POINT_TO_POINT_PARTITION_CHANNEL_H */
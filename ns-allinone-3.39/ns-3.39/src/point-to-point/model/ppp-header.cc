@@ -68,6 +68,9 @@ PppHeader::Print(std::ostream& os) const
     case 0x0057: /* IPv6 */
         proto = "IPv6 (0x0057)";
         break;
+    case 0x0031: /* Bridged Ethernet */
+        proto = "Bridged Ethernet (0x0031)";
+        break;
     default:
         NS_ASSERT_MSG(false, "PPP Protocol number not defined!");
     }
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/data-rate.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-partition-channel.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup point-to-point
+ * \ingroup tests
+ *
+ * \brief Check that a chain of four nodes gives the same receptions with the
+ * MultithreadedSimulatorImpl, its nodes split in partitions, as with the
+ * default simulator.
+ *
+ * The first and the last node send frames of several sizes to each other;
+ * the nodes in between forward them.  The links have different delays and
+ * rates, so the frames queue in the devices.
+ */
+class PointToPointPartitionTestCase : public TestCase
+{
+  public:
+    /**
+     * \param nPartitions the number of partitions of the chain (1, 2 or 4)
+     */
+    PointToPointPartitionTestCase(uint32_t nPartitions);
+
+  private:
+    void DoRun() override;
+
+    /// Receptions at each end of the chain: (time, size)
+    typedef std::vector<std::pair<Time, uint32_t>> Receptions;
+
+    /**
+     * Run the chain.
+     * \param nPartitions the number of partitions, or zero for the default simulator
+     * \param [out] first the receptions at the first node
+     * \param [out] last the receptions at the last node
+     */
+    void RunChain(uint32_t nPartitions, Receptions& first, Receptions& last);
+
+    /**
+     * Send a frame.
+     * \param device the sending device
+     * \param size the payload size
+     */
+    static void Send(Ptr<PointToPointNetDevice> device, uint32_t size);
+
+    /**
+     * Forward a received frame through another device.
+     * \param out the device to forward through
+     * \param dev the receiving device
+     * \param p the frame
+     * \param protocol the protocol
+     * \param sender the sender
+     * \return true
+     */
+    static bool Forward(Ptr<PointToPointNetDevice> out,
+                        Ptr<NetDevice> dev,
+                        Ptr<const Packet> p,
+                        uint16_t protocol,
+                        const Address& sender);
+
+    /**
+     * Record a received frame.
+     * \param receptions the receptions of the node
+     * \param dev the receiving device
+     * \param p the frame
+     * \param protocol the protocol
+     * \param sender the sender
+     * \return true
+     */
+    static bool Receive(Receptions* receptions,
+                        Ptr<NetDevice> dev,
+                        Ptr<const Packet> p,
+                        uint16_t protocol,
+                        const Address& sender);
+
+    uint32_t m_nPartitions; //!< Number of partitions
+};
+
+PointToPointPartitionTestCase::PointToPointPartitionTestCase(uint32_t nPartitions)
+    : TestCase("Chain of nodes in " + std::to_string(nPartitions) + " partitions"),
+      m_nPartitions(nPartitions)
+{
+}
+
+void
+PointToPointPartitionTestCase::Send(Ptr<PointToPointNetDevice> device, uint32_t size)
+{
+    device->Send(Create<Packet>(size), device->GetBroadcast(), 0x0800);
+}
+
+bool
+PointToPointPartitionTestCase::Forward(Ptr<PointToPointNetDevice> out,
+                                       Ptr<NetDevice> dev,
+                                       Ptr<const Packet> p,
+                                       uint16_t protocol,
+                                       const Address& sender)
+{
+    out->Send(p->Copy(), out->GetBroadcast(), protocol);
+    return true;
+}
+
+bool
+PointToPointPartitionTestCase::Receive(Receptions* receptions,
+                                       Ptr<NetDevice> dev,
+                                       Ptr<const Packet> p,
+                                       uint16_t protocol,
+                                       const Address& sender)
+{
+    receptions->emplace_back(Simulator::Now(), p->GetSize());
+    return true;
+}
+
+void
+PointToPointPartitionTestCase::RunChain(uint32_t nPartitions, Receptions& first, Receptions& last)
+{
+    Ptr<MultithreadedSimulatorImpl> impl;
+    if (nPartitions > 0)
+    {
+        impl = CreateObject<MultithreadedSimulatorImpl>();
+        Simulator::SetImplementation(impl);
+    }
+
+    NodeContainer nodes;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        nodes.Create(1, nPartitions > 0 ? i * nPartitions / 4 : 0);
+    }
+    const char* delays[] = {"1ms", "1500us", "2ms"};
+    const char* rates[] = {"10Mbps", "5Mbps", "20Mbps"};
+    std::vector<Ptr<PointToPointNetDevice>> devices;
+    PointToPointHelper p2p;
+    p2p.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue("1000p"));
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        p2p.SetChannelAttribute("Delay", StringValue(delays[i]));
+        p2p.SetDeviceAttribute("DataRate", StringValue(rates[i]));
+        NetDeviceContainer link = p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+        devices.push_back(DynamicCast<PointToPointNetDevice>(link.Get(0)));
+        devices.push_back(DynamicCast<PointToPointNetDevice>(link.Get(1)));
+        bool partitioned = nodes.Get(i)->GetSystemId() != nodes.Get(i + 1)->GetSystemId();
+        NS_TEST_EXPECT_MSG_EQ(
+            bool(DynamicCast<PointToPointPartitionChannel>(link.Get(0)->GetChannel())),
+            partitioned,
+            "Wrong channel between nodes " << i << " and " << (i + 1));
+    }
+
+    // devices: 0 (node 0), 1 and 2 (node 1), 3 and 4 (node 2), 5 (node 3)
+    devices[0]->SetReceiveCallback(MakeBoundCallback(&Receive, &first));
+    devices[5]->SetReceiveCallback(MakeBoundCallback(&Receive, &last));
+    for (uint32_t i = 1; i < 5; i += 2)
+    {
+        devices[i]->SetReceiveCallback(MakeBoundCallback(&Forward, devices[i + 1]));
+        devices[i + 1]->SetReceiveCallback(MakeBoundCallback(&Forward, devices[i]));
+    }
+
+    const uint32_t sizes[] = {100, 1400, 600, 64, 1000};
+    for (uint32_t k = 0; k < 500; k++)
+    {
+        Simulator::ScheduleWithContext(0,
+                                       NanoSeconds(k * 97001 + 3),
+                                       &Send,
+                                       devices[0],
+                                       sizes[k % 5]);
+        Simulator::ScheduleWithContext(3,
+                                       NanoSeconds(k * 131003 + 11),
+                                       &Send,
+                                       devices[5],
+                                       sizes[(k + 2) % 5]);
+    }
+
+    Simulator::Run();
+    if (impl)
+    {
+        NS_TEST_EXPECT_MSG_EQ(impl->GetNPartitions(), nPartitions, "Wrong number of partitions");
+        if (nPartitions > 1)
+        {
+            // the smallest delay of the links between partitions
+            Time lookahead = nPartitions == 2 ? MicroSeconds(1500) : MilliSeconds(1);
+            NS_TEST_EXPECT_MSG_EQ(impl->GetLookahead(), lookahead, "Wrong lookahead");
+        }
+    }
+    Simulator::Destroy();
+}
+
+void
+PointToPointPartitionTestCase::DoRun()
+{
+    Receptions firstRef;
+    Receptions lastRef;
+    RunChain(0, firstRef, lastRef);
+    Receptions first;
+    Receptions last;
+    RunChain(m_nPartitions, first, last);
+
+    NS_TEST_ASSERT_MSG_EQ(firstRef.size(), 500, "Frames lost");
+    NS_TEST_ASSERT_MSG_EQ(lastRef.size(), 500, "Frames lost");
+    NS_TEST_ASSERT_MSG_EQ(first.size(), firstRef.size(), "Different frames at the first node");
+    NS_TEST_ASSERT_MSG_EQ(last.size(), lastRef.size(), "Different frames at the last node");
+    for (std::size_t k = 0; k < first.size(); k++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(first[k].first, firstRef[k].first, "Different reception time");
+        NS_TEST_EXPECT_MSG_EQ(first[k].second, firstRef[k].second, "Different frame");
+        NS_TEST_EXPECT_MSG_EQ(last[k].first, lastRef[k].first, "Different reception time");
+        NS_TEST_EXPECT_MSG_EQ(last[k].second, lastRef[k].second, "Different frame");
+    }
+}
+
+/**
+ * \ingroup point-to-point
+ * \ingroup tests
+ *
+ * \brief Check that a node of another partition cannot be reached below the
+ * lookahead, and that Simulator::Stop stops every partition.
+ */
+class PointToPointPartitionStopTestCase : public TestCase
+{
+  public:
+    PointToPointPartitionStopTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Send a frame and the next one after an interval.
+     * \param device the sending device
+     * \param count the frames sent so far
+     */
+    static void SendPeriodic(Ptr<PointToPointNetDevice> device, uint32_t* count);
+};
+
+PointToPointPartitionStopTestCase::PointToPointPartitionStopTestCase()
+    : TestCase("Simulator::Stop with partitions")
+{
+}
+
+void
+PointToPointPartitionStopTestCase::SendPeriodic(Ptr<PointToPointNetDevice> device, uint32_t* count)
+{
+    device->Send(Create<Packet>(100), device->GetBroadcast(), 0x0800);
+    (*count)++;
+    Simulator::Schedule(MicroSeconds(100), &SendPeriodic, device, count);
+}
+
+void
+PointToPointPartitionStopTestCase::DoRun()
+{
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    Simulator::SetImplementation(impl);
+    NodeContainer nodes;
+    nodes.Create(1, 0);
+    nodes.Create(1, 1);
+    PointToPointHelper p2p;
+    p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+    NetDeviceContainer link = p2p.Install(nodes);
+
+    uint32_t sent[2] = {0, 0};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Simulator::ScheduleWithContext(i,
+                                       Seconds(0),
+                                       &SendPeriodic,
+                                       DynamicCast<PointToPointNetDevice>(link.Get(i)),
+                                       &sent[i]);
+    }
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+
+    // a frame at 0, 100 us, ..., 9.9 ms
+    NS_TEST_EXPECT_MSG_EQ(sent[0], 100, "Wrong frames sent by the first partition");
+    NS_TEST_EXPECT_MSG_EQ(sent[1], 100, "Wrong frames sent by the second partition");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetLookahead(), MilliSeconds(1), "Wrong lookahead");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MilliSeconds(10), "Wrong stop time");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup point-to-point
+ * \ingroup tests
+ *
+ * \brief TestSuite for the PointToPointPartitionChannel
+ */
+class PointToPointPartitionTestSuite : public TestSuite
+{
+  public:
+    PointToPointPartitionTestSuite();
+};
+
+PointToPointPartitionTestSuite::PointToPointPartitionTestSuite()
+    : TestSuite("point-to-point-partition", UNIT)
+{
+    AddTestCase(new PointToPointPartitionTestCase(1), TestCase::QUICK);
+    AddTestCase(new PointToPointPartitionTestCase(2), TestCase::QUICK);
+    AddTestCase(new PointToPointPartitionTestCase(4), TestCase::QUICK);
+    AddTestCase(new PointToPointPartitionStopTestCase, TestCase::QUICK);
+}
+
+static PointToPointPartitionTestSuite
+    g_pointToPointPartitionTestSuite; //!< The test suite
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/data-rate.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/vlan-header.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup point-to-point
+ * \ingroup tests
+ *
+ * \brief Check the times of a preemptable frame and an express frame sent
+ * while it is on the wire, with and without frame preemption.
+ *
+ * The link runs at 1 Gbit/s (8 ns per byte) without delay.  The preemptable
+ * frame is 1020 bytes long on the wire (1000 bytes of payload, Ethernet and
+ * 802.1Q headers and PPP header) and the express frame 120 bytes.  A frame
+ * (or fragment) is received at its last bit, before the interframe gap.
+ */
+class PointToPointPreemptionTestCase : public TestCase
+{
+  public:
+    /**
+     * \param preemption enable frame preemption
+     * \param expressTime time the express frame is sent
+     * \param expressRx expected reception time of the express frame
+     * \param frameRx expected reception time of the preemptable frame
+     * \param preemptions expected number of preemptions
+     * \param interframeGap the interframe gap of the devices
+     */
+    PointToPointPreemptionTestCase(bool preemption,
+                                   Time expressTime,
+                                   Time expressRx,
+                                   Time frameRx,
+                                   uint64_t preemptions,
+                                   Time interframeGap = Seconds(0));
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Send a frame.
+     * \param device the sending device
+     * \param dest the destination
+     * \param size the payload size
+     * \param pcp the PCP of the frame
+     */
+    void Send(Ptr<PointToPointNetDevice> device, Address dest, uint32_t size, uint8_t pcp);
+
+    /**
+     * Record a received frame.
+     * \param dev the receiving device
+     * \param p the frame
+     * \param protocol the protocol
+     * \param sender the sender
+     * \return true
+     */
+    bool Receive(Ptr<NetDevice> dev, Ptr<const Packet> p, uint16_t protocol, const Address& sender);
+
+    bool m_preemption;       //!< Enable frame preemption
+    Time m_expressTime;      //!< Time the express frame is sent
+    Time m_expressRx;        //!< Expected reception time of the express frame
+    Time m_frameRx;          //!< Expected reception time of the preemptable frame
+    uint64_t m_preemptions;  //!< Expected number of preemptions
+    Time m_interframeGap;    //!< Interframe gap of the devices
+    std::vector<std::pair<uint32_t, Time>> m_received; //!< Sizes and times of the frames received
+};
+
+PointToPointPreemptionTestCase::PointToPointPreemptionTestCase(bool preemption,
+                                                               Time expressTime,
+                                                               Time expressRx,
+                                                               Time frameRx,
+                                                               uint64_t preemptions,
+                                                               Time interframeGap)
+    : TestCase("Express frame sent at " + std::to_string(expressTime.GetNanoSeconds()) +
+               " ns" + (preemption ? " with" : " without") + " preemption" +
+               (interframeGap.IsZero()
+                    ? ""
+                    : " and a gap of " + std::to_string(interframeGap.GetNanoSeconds()) + " ns")),
+      m_preemption(preemption),
+      m_expressTime(expressTime),
+      m_expressRx(expressRx),
+      m_frameRx(frameRx),
+      m_preemptions(preemptions),
+      m_interframeGap(interframeGap)
+{
+}
+
+void
+PointToPointPreemptionTestCase::Send(Ptr<PointToPointNetDevice> device,
+                                     Address dest,
+                                     uint32_t size,
+                                     uint8_t pcp)
+{
+    Ptr<Packet> p = Create<Packet>(size);
+    p->AddPacketTag(VlanTag(pcp, 1));
+    device->Send(p, dest, 0x88FE);
+}
+
+bool
+PointToPointPreemptionTestCase::Receive(Ptr<NetDevice> dev,
+                                        Ptr<const Packet> p,
+                                        uint16_t protocol,
+                                        const Address& sender)
+{
+    m_received.emplace_back(p->GetSize(), Simulator::Now());
+    return true;
+}
+
+void
+PointToPointPreemptionTestCase::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    for (auto dev : {devA, devB})
+    {
+        dev->Attach(channel);
+        dev->SetAddress(Mac48Address::Allocate());
+        dev->SetQueue(CreateObject<DropTailQueue<Packet>>());
+        dev->SetDataRate(DataRate("1Gbps"));
+        dev->SetInterframeGap(m_interframeGap);
+        dev->SetAttribute("EnablePreemption", BooleanValue(m_preemption));
+    }
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+    devB->SetReceiveCallback(MakeCallback(&PointToPointPreemptionTestCase::Receive, this));
+
+    Simulator::Schedule(Seconds(0),
+                        &PointToPointPreemptionTestCase::Send,
+                        this,
+                        devA,
+                        devB->GetAddress(),
+                        1000,
+                        0);
+    Simulator::Schedule(m_expressTime,
+                        &PointToPointPreemptionTestCase::Send,
+                        this,
+                        devA,
+                        devB->GetAddress(),
+                        100,
+                        7);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_received.size(), 2, "Two frames expected");
+    bool expressFirst = m_expressRx < m_frameRx;
+    const auto& express = m_received[expressFirst ? 0 : 1];
+    const auto& frame = m_received[expressFirst ? 1 : 0];
+    NS_TEST_EXPECT_MSG_EQ(express.first, 100, "The express frame was not received");
+    NS_TEST_EXPECT_MSG_EQ(express.second, m_expressRx, "Wrong time of the express frame");
+    NS_TEST_EXPECT_MSG_EQ(frame.first, 1000, "The preemptable frame was not reassembled");
+    NS_TEST_EXPECT_MSG_EQ(frame.second, m_frameRx, "Wrong time of the preemptable frame");
+    NS_TEST_EXPECT_MSG_EQ(devA->GetNPreemptions(), m_preemptions, "Wrong number of preemptions");
+    NS_TEST_EXPECT_MSG_EQ(devB->GetNReassembledFrames(),
+                          m_preemptions,
+                          "Wrong number of reassembled frames");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup point-to-point
+ * \ingroup tests
+ *
+ * \brief Frame preemption TestSuite
+ */
+class PointToPointPreemptionTestSuite : public TestSuite
+{
+  public:
+    PointToPointPreemptionTestSuite();
+};
+
+PointToPointPreemptionTestSuite::PointToPointPreemptionTestSuite()
+    : TestSuite("point-to-point-preemption", UNIT)
+{
+    // without preemption the express frame waits for the whole frame (8160 ns)
+    AddTestCase(new PointToPointPreemptionTestCase(false,
+                                                   NanoSeconds(1000),
+                                                   NanoSeconds(9120),
+                                                   NanoSeconds(8160),
+                                                   0),
+                TestCase::QUICK);
+    // 125 bytes sent: the first fragment ends with its mCRC at 1032 ns, the
+    // express frame takes 960 ns and the continuation fragment 8 + 895 bytes
+    AddTestCase(new PointToPointPreemptionTestCase(true,
+                                                   NanoSeconds(1000),
+                                                   NanoSeconds(1992),
+                                                   NanoSeconds(9216),
+                                                   1),
+                TestCase::QUICK);
+    // 13 bytes sent: the first fragment is stretched to the minimum of 64 bytes
+    // and the continuation fragment carries 8 + 960 bytes
+    AddTestCase(new PointToPointPreemptionTestCase(true,
+                                                   NanoSeconds(100),
+                                                   NanoSeconds(1472),
+                                                   NanoSeconds(9216),
+                                                   1),
+                TestCase::QUICK);
+    // 1000 bytes sent: the rest of the frame would be shorter than a fragment
+    AddTestCase(new PointToPointPreemptionTestCase(true,
+                                                   NanoSeconds(8000),
+                                                   NanoSeconds(9120),
+                                                   NanoSeconds(8160),
+                                                   0),
+                TestCase::QUICK);
+    // a gap of 12 bytes (96 ns) after every frame: the frame arrives at the
+    // same time with and without preemption, and the express frame after
+    // the gap
+    AddTestCase(new PointToPointPreemptionTestCase(false,
+                                                   NanoSeconds(8000),
+                                                   NanoSeconds(9216),
+                                                   NanoSeconds(8160),
+                                                   0,
+                                                   NanoSeconds(96)),
+                TestCase::QUICK);
+    AddTestCase(new PointToPointPreemptionTestCase(true,
+                                                   NanoSeconds(8000),
+                                                   NanoSeconds(9216),
+                                                   NanoSeconds(8160),
+                                                   0,
+                                                   NanoSeconds(96)),
+                TestCase::QUICK);
+    // the first fragment arrives at 1032 ns, the express frame at
+    // 1128 + 960 ns and the continuation fragment at 2184 + 7224 ns
+    AddTestCase(new PointToPointPreemptionTestCase(true,
+                                                   NanoSeconds(1000),
+                                                   NanoSeconds(2088),
+                                                   NanoSeconds(9408),
+                                                   1,
+                                                   NanoSeconds(96)),
+                TestCase::QUICK);
+}
+
+static PointToPointPreemptionTestSuite
+    g_pointToPointPreemptionTestSuite; //!< The test suite
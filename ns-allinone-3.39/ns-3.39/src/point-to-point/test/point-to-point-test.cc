@@ -17,12 +17,18 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/boolean.h"
+#include "ns3/data-rate.h"
 #include "ns3/drop-tail-queue.h"
+#include "ns3/dynamic-queue-limits.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-helper.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <string>
 
@@ -139,6 +145,128 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \brief Test of the byte queue limits mode of PointToPointNetDevice
+ *
+ * A backlog of packets is sent to a device whose transmission queue has
+ * queue limits of 4000 bytes, as a queue disc would do: the packets are sent
+ * while the queue is not stopped and again every time the queue is woken up.
+ * The bytes in the device (queued or being transmitted) must never exceed
+ * the limit by more than one packet, and the completion batches must let
+ * several packets be sent per wake-up.
+ */
+class PointToPointByteQueueLimitsTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    PointToPointByteQueueLimitsTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Send packets of the backlog while the transmission queue is not stopped
+     */
+    void Wake();
+
+    /**
+     * \brief Callback function which counts the received packets
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param mode The protocol mode used.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    Ptr<PointToPointNetDevice> m_device; //!< Transmitting device
+    Ptr<NetDeviceQueue> m_txQueue;       //!< Device transmission queue
+    uint32_t m_backlog;                  //!< Packets left to send
+    uint32_t m_wakeUps;                  //!< Wake-ups that sent packets
+    uint32_t m_maxInDevice;              //!< Maximum number of packets in the device
+    uint32_t m_received;                 //!< Received packets
+};
+
+/// Number of packets sent in the byte queue limits test
+static const uint32_t BQL_PACKETS = 40;
+
+PointToPointByteQueueLimitsTest::PointToPointByteQueueLimitsTest()
+    : TestCase("PointToPoint byte queue limits"),
+      m_backlog(BQL_PACKETS),
+      m_wakeUps(0),
+      m_maxInDevice(0),
+      m_received(0)
+{
+}
+
+void
+PointToPointByteQueueLimitsTest::Wake()
+{
+    bool sent = false;
+    while (m_backlog > 0 && !m_txQueue->IsStopped())
+    {
+        // 1000 bytes with the PPP header
+        m_device->Send(Create<Packet>(998), m_device->GetBroadcast(), 0x800);
+        m_backlog--;
+        sent = true;
+        // the packets in the device queue plus the one being transmitted
+        m_maxInDevice = std::max(m_maxInDevice, m_device->GetQueue()->GetNPackets() + 1);
+    }
+    m_wakeUps += sent ? 1 : 0;
+}
+
+bool
+PointToPointByteQueueLimitsTest::RxPacket(Ptr<NetDevice> dev,
+                                          Ptr<const Packet> pkt,
+                                          uint16_t mode,
+                                          const Address& sender)
+{
+    m_received++;
+    return true;
+}
+
+void
+PointToPointByteQueueLimitsTest::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", DataRateValue(DataRate("8Mbps")));
+    p2p.SetDeviceAttribute("ByteQueueLimits", BooleanValue(true));
+    p2p.SetDeviceAttribute("CompletionBatch", UintegerValue(4));
+    p2p.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("100p"));
+    NetDeviceContainer devices = p2p.Install(a, b);
+
+    m_device = DynamicCast<PointToPointNetDevice>(devices.Get(0));
+    m_txQueue = m_device->GetObject<NetDeviceQueueInterface>()->GetTxQueue(0);
+    Ptr<DynamicQueueLimits> dql = CreateObject<DynamicQueueLimits>();
+    dql->SetAttribute("MinLimit", UintegerValue(4000));
+    dql->SetAttribute("MaxLimit", UintegerValue(4000));
+    m_txQueue->SetQueueLimits(dql);
+    m_txQueue->SetWakeCallback(MakeCallback(&PointToPointByteQueueLimitsTest::Wake, this));
+    devices.Get(1)->SetReceiveCallback(
+        MakeCallback(&PointToPointByteQueueLimitsTest::RxPacket, this));
+
+    Simulator::Schedule(Seconds(1.0), &PointToPointByteQueueLimitsTest::Wake, this);
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_received, BQL_PACKETS, "Not all the packets were received");
+    NS_TEST_EXPECT_MSG_EQ(m_txQueue->IsStopped(), false, "The queue was not restarted");
+    // stopped when the bytes in the device exceed the limit
+    NS_TEST_EXPECT_MSG_EQ(m_maxInDevice, 5, "Wrong maximum number of packets in the device");
+    // the first packet, then bursts of 5 and 4 packets
+    NS_TEST_EXPECT_MSG_EQ(m_wakeUps, 2 + (BQL_PACKETS - 6 + 3) / 4, "Wrong number of wake-ups");
+
+    Simulator::Destroy();
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -155,6 +283,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::QUICK);
+    AddTestCase(new PointToPointByteQueueLimitsTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
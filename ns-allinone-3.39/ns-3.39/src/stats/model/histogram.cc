@@ -48,18 +48,30 @@ Histogram::GetNBins() const
 double
 Histogram::GetBinStart(uint32_t index) const
 {
+    if (m_binsPerDecade)
+    {
+        return index == 0 ? 0 : m_logMin * std::pow(10.0, double(index - 1) / m_binsPerDecade);
+    }
     return index * m_binWidth;
 }
 
 double
 Histogram::GetBinEnd(uint32_t index) const
 {
+    if (m_binsPerDecade)
+    {
+        return m_logMin * std::pow(10.0, double(index) / m_binsPerDecade);
+    }
     return (index + 1) * m_binWidth;
 }
 
 double
 Histogram::GetBinWidth(uint32_t index) const
 {
+    if (m_binsPerDecade)
+    {
+        return GetBinEnd(index) - GetBinStart(index);
+    }
     return m_binWidth;
 }
 
@@ -70,6 +82,15 @@ Histogram::SetDefaultBinWidth(double binWidth)
     m_binWidth = binWidth;
 }
 
+void
+Histogram::SetLogBins(double minValue, uint32_t binsPerDecade)
+{
+    NS_ASSERT(m_histogram.empty()); // we can only change the binning if no values were added
+    NS_ASSERT(minValue > 0);
+    m_logMin = minValue;
+    m_binsPerDecade = binsPerDecade;
+}
+
 uint32_t
 Histogram::GetBinCount(uint32_t index) const
 {
@@ -80,7 +101,17 @@ Histogram::GetBinCount(uint32_t index) const
 void
 Histogram::AddValue(double value)
 {
-    uint32_t index = (uint32_t)std::floor(value / m_binWidth);
+    uint32_t index;
+    if (m_binsPerDecade)
+    {
+        index = value < m_logMin
+                    ? 0
+                    : 1 + (uint32_t)std::floor(m_binsPerDecade * std::log10(value / m_logMin));
+    }
+    else
+    {
+        index = (uint32_t)std::floor(value / m_binWidth);
+    }
 
     // check if we need to resize the vector
     NS_LOG_DEBUG("AddValue: index=" << index << ", m_histogram.size()=" << m_histogram.size());
@@ -124,8 +155,8 @@ Histogram::SerializeToXmlStream(std::ostream& os, uint16_t indent, std::string e
             os << std::string(indent, ' ');
             os << "<bin"
                << " index=\"" << (index) << "\""
-               << " start=\"" << (index * m_binWidth) << "\""
-               << " width=\"" << m_binWidth << "\""
+               << " start=\"" << GetBinStart(index) << "\""
+               << " width=\"" << GetBinWidth(index) << "\""
                << " count=\"" << m_histogram[index] << "\""
                << " />\n";
         }
@@ -34,6 +34,12 @@ namespace ns3
  * bin according to the following formula: floor(value/binWidth).
  * Hence, bin \a i groups the data from [i*binWidth, (i+1)binWidth).
  *
+ * Alternatively, the bins can be logarithmically spaced (see SetLogBins):
+ * bin 0 groups the data in [0, minValue) and bin \a i > 0 the data in
+ * [minValue*10^((i-1)/binsPerDecade), minValue*10^(i/binsPerDecade)).
+ * This keeps the number of bins small for data spanning several orders
+ * of magnitude, such as packet delays.
+ *
  * This class only handles \a positive bins, i.e., it does \a not handles negative data.
  *
  * \todo Add support for negative data.
@@ -74,7 +80,7 @@ class Histogram
     /**
      * \brief Returns the bin width.
      *
-     * Note that all the bins have the same width.
+     * Note that all the bins have the same width, unless logarithmic bins are used.
      *
      * \param index the bin index
      * \return the bin width
@@ -88,6 +94,15 @@ class Histogram
      * \param binWidth the bin width
      */
     void SetDefaultBinWidth(double binWidth);
+    /**
+     * \brief Use logarithmically spaced bins.
+     *
+     * Note that you can change the binning only if the histogram is empty.
+     *
+     * \param minValue upper limit of the first bin, must be positive
+     * \param binsPerDecade number of bins per decade above minValue (0 restores fixed-width bins)
+     */
+    void SetLogBins(double minValue, uint32_t binsPerDecade);
     /**
      * \brief Get the number of data added to the bin.
      * \param index the bin index
@@ -118,6 +133,8 @@ class Histogram
   private:
     std::vector<uint32_t> m_histogram; //!< Histogram data
     double m_binWidth;                 //!< Bin width
+    double m_logMin{0};                //!< Upper limit of the first logarithmic bin
+    uint32_t m_binsPerDecade{0};       //!< Logarithmic bins per decade (0 for fixed width)
 };
 
 } // namespace ns3
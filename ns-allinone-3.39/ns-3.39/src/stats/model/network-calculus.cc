@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "network-calculus.h"
+
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NetworkCalculus");
+
+NetworkCalculus::NetworkCalculus()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+NetworkCalculus::AddServer(const std::string& name,
+                           double rate,
+                           double latency,
+                           double delay,
+                           uint32_t overhead)
+{
+    NS_LOG_FUNCTION(this << name << rate << latency << delay << overhead);
+    NS_ASSERT_MSG(rate > 0, "The rate of server " << name << " must be positive");
+    Server server;
+    server.name = name;
+    server.rate = rate;
+    server.latency = latency;
+    server.delay = delay;
+    server.overhead = overhead;
+    server.queues.push_back(Queue{0, 1500});
+    m_servers.push_back(server);
+    return m_servers.size() - 1;
+}
+
+uint32_t
+NetworkCalculus::AddQueue(uint32_t server, uint32_t priority, double quantum)
+{
+    NS_LOG_FUNCTION(this << server << priority << quantum);
+    NS_ASSERT_MSG(quantum > 0, "The quantum of a queue must be positive");
+    Server& s = m_servers.at(server);
+    s.queues.push_back(Queue{priority, quantum});
+    return s.queues.size() - 1;
+}
+
+void
+NetworkCalculus::MapClass(uint32_t server, uint32_t trafficClass, uint32_t queue)
+{
+    NS_LOG_FUNCTION(this << server << trafficClass << queue);
+    Server& s = m_servers.at(server);
+    NS_ASSERT_MSG(queue < s.queues.size(), "Unknown queue " << queue << " of server " << s.name);
+    s.classes[trafficClass] = queue;
+}
+
+uint32_t
+NetworkCalculus::AddFlow(const std::string& name,
+                         double rate,
+                         double burst,
+                         uint32_t packetSize,
+                         const std::vector<uint32_t>& route,
+                         uint32_t trafficClass)
+{
+    NS_LOG_FUNCTION(this << name << rate << burst << packetSize << trafficClass);
+    NS_ASSERT_MSG(packetSize > 0, "The packet size of flow " << name << " must be positive");
+    for (auto server : route)
+    {
+        NS_ASSERT_MSG(server < m_servers.size(), "Unknown server " << server);
+    }
+    Flow flow;
+    flow.name = name;
+    flow.rate = rate;
+    flow.burst = 8 * burst;
+    flow.packetSize = packetSize;
+    flow.route = route;
+    flow.trafficClass = trafficClass;
+    m_flows.push_back(flow);
+    return m_flows.size() - 1;
+}
+
+double
+NetworkCalculus::GetScale(const Flow& flow, const Server& server)
+{
+    return double(flow.packetSize + server.overhead) / flow.packetSize;
+}
+
+std::vector<uint32_t>
+NetworkCalculus::GetOrder() const
+{
+    // Kahn's algorithm on the edges between consecutive servers of the routes
+    std::vector<std::vector<uint32_t>> next(m_servers.size());
+    std::vector<uint32_t> incoming(m_servers.size(), 0);
+    for (const auto& flow : m_flows)
+    {
+        for (std::size_t k = 1; k < flow.route.size(); k++)
+        {
+            next[flow.route[k - 1]].push_back(flow.route[k]);
+            incoming[flow.route[k]]++;
+        }
+    }
+    std::queue<uint32_t> ready;
+    for (uint32_t i = 0; i < m_servers.size(); i++)
+    {
+        if (incoming[i] == 0)
+        {
+            ready.push(i);
+        }
+    }
+    std::vector<uint32_t> order;
+    while (!ready.empty())
+    {
+        uint32_t server = ready.front();
+        ready.pop();
+        order.push_back(server);
+        for (auto n : next[server])
+        {
+            if (--incoming[n] == 0)
+            {
+                ready.push(n);
+            }
+        }
+    }
+    if (order.size() != m_servers.size())
+    {
+        NS_FATAL_ERROR("The routes of the flows are not feed-forward");
+    }
+    return order;
+}
+
+void
+NetworkCalculus::Evaluate()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<std::vector<Hop>> members(m_servers.size());
+    for (uint32_t f = 0; f < m_flows.size(); f++)
+    {
+        Flow& flow = m_flows[f];
+        std::size_t hops = flow.route.size();
+        for (std::size_t k = 0; k < hops; k++)
+        {
+            members[flow.route[k]].emplace_back(f, k);
+        }
+        flow.bursts.assign(hops, 0);
+        flow.rates.assign(hops, 0);
+        flow.latencies.assign(hops, 0);
+        if (hops > 0)
+        {
+            flow.bursts[0] = flow.burst;
+        }
+    }
+    for (auto server : GetOrder())
+    {
+        EvaluateServer(server, members[server]);
+    }
+}
+
+void
+NetworkCalculus::EvaluateServer(uint32_t index, const std::vector<Hop>& members)
+{
+    NS_LOG_FUNCTION(this << index);
+    Server& server = m_servers[index];
+    const double infinity = std::numeric_limits<double>::infinity();
+    std::size_t nQueues = server.queues.size();
+
+    // per queue, in bits at this server: bursts, rates and largest packet
+    std::vector<double> bursts(nQueues, 0);
+    std::vector<double> rates(nQueues, 0);
+    std::vector<double> packets(nQueues, 0);
+    for (const auto& member : members)
+    {
+        const Flow& flow = m_flows[member.first];
+        auto it = server.classes.find(flow.trafficClass);
+        uint32_t q = it == server.classes.end() ? 0 : it->second;
+        double scale = GetScale(flow, server);
+        bursts[q] += flow.bursts[member.second] * scale;
+        rates[q] += flow.rate * scale;
+        packets[q] = std::max(packets[q], 8.0 * (flow.packetSize + server.overhead));
+    }
+
+    double totalRate = 0;
+    double totalBurst = 0;
+    for (std::size_t q = 0; q < nQueues; q++)
+    {
+        totalRate += rates[q];
+        totalBurst += bursts[q];
+    }
+    server.utilization = totalRate / server.rate;
+    server.backlog = totalRate <= server.rate ? totalBurst + totalRate * server.latency : infinity;
+
+    // left-over service curve of every queue
+    std::vector<double> queueRates(nQueues, 0);
+    std::vector<double> queueLatencies(nQueues, infinity);
+    for (std::size_t q = 0; q < nQueues; q++)
+    {
+        if (rates[q] == 0 && bursts[q] == 0)
+        {
+            continue;
+        }
+        uint32_t priority = server.queues[q].priority;
+        double higherRate = 0;
+        double higherBurst = 0;
+        double lowerPacket = 0;
+        double quanta = 0;
+        double others = 0;
+        double levelRate = 0;
+        double levelBurst = 0;
+        for (std::size_t j = 0; j < nQueues; j++)
+        {
+            if (rates[j] == 0 && bursts[j] == 0)
+            {
+                continue;
+            }
+            if (server.queues[j].priority < priority)
+            {
+                higherRate += rates[j];
+                higherBurst += bursts[j];
+            }
+            else if (server.queues[j].priority > priority)
+            {
+                lowerPacket = std::max(lowerPacket, packets[j]);
+            }
+            else
+            {
+                quanta += server.queues[j].quantum;
+                others += j == q ? 0 : packets[j];
+                levelRate += j == q ? 0 : rates[j];
+                levelBurst += j == q ? 0 : bursts[j];
+            }
+        }
+        double leftRate = server.rate - higherRate;
+        if (leftRate <= 0)
+        {
+            continue;
+        }
+        double leftLatency = (server.rate * server.latency + higherBurst + lowerPacket) / leftRate;
+        double quantum = server.queues[q].quantum;
+        queueRates[q] = leftRate * quantum / quanta;
+        // DRR latency, in bits: (Q - Q_q) (1 + L_q / Q_q) + sum of L_j
+        queueLatencies[q] =
+            leftLatency +
+            (8 * (quanta - quantum) * (1 + packets[q] / 8 / quantum) + others) / leftRate;
+        // blind multiplexing with the other queues of the level, if better
+        double blindRate = leftRate - levelRate;
+        if (blindRate > 0)
+        {
+            double blindLatency = (leftRate * leftLatency + levelBurst) / blindRate;
+            if (queueRates[q] < rates[q] ||
+                (blindRate >= rates[q] && blindLatency + bursts[q] / blindRate <
+                                              queueLatencies[q] + bursts[q] / queueRates[q]))
+            {
+                queueRates[q] = blindRate;
+                queueLatencies[q] = blindLatency;
+            }
+        }
+    }
+
+    for (const auto& member : members)
+    {
+        Flow& flow = m_flows[member.first];
+        std::size_t k = member.second;
+        auto it = server.classes.find(flow.trafficClass);
+        uint32_t q = it == server.classes.end() ? 0 : it->second;
+        double scale = GetScale(flow, server);
+        double rate = flow.rate * scale;
+        double burst = flow.bursts[k] * scale;
+        // blind multiplexing with the other flows of the queue
+        double leftover = queueRates[q] - (rates[q] - rate);
+        double latency = infinity;
+        if (leftover > 0 && leftover >= rate && !std::isinf(queueLatencies[q]) &&
+            !std::isinf(burst))
+        {
+            latency = (queueRates[q] * queueLatencies[q] + bursts[q] - burst) / leftover +
+                      8.0 * (flow.packetSize + server.overhead) / server.rate;
+        }
+        else
+        {
+            leftover = 0;
+        }
+        flow.rates[k] = leftover;
+        flow.latencies[k] = latency;
+        if (k + 1 < flow.route.size())
+        {
+            flow.bursts[k + 1] =
+                std::isinf(latency) ? infinity : flow.bursts[k] + flow.rate * latency;
+        }
+    }
+    NS_LOG_DEBUG("Server " << server.name << " utilization " << server.utilization
+                           << " backlog bound " << server.backlog / 8 << " bytes");
+}
+
+uint32_t
+NetworkCalculus::GetNServers() const
+{
+    return m_servers.size();
+}
+
+uint32_t
+NetworkCalculus::GetNFlows() const
+{
+    return m_flows.size();
+}
+
+std::string
+NetworkCalculus::GetServerName(uint32_t server) const
+{
+    return m_servers.at(server).name;
+}
+
+std::string
+NetworkCalculus::GetFlowName(uint32_t flow) const
+{
+    return m_flows.at(flow).name;
+}
+
+double
+NetworkCalculus::GetUtilization(uint32_t server) const
+{
+    return m_servers.at(server).utilization;
+}
+
+bool
+NetworkCalculus::IsStable() const
+{
+    for (const auto& server : m_servers)
+    {
+        if (server.utilization > 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+double
+NetworkCalculus::GetDelayBound(uint32_t flow) const
+{
+    const Flow& f = m_flows.at(flow);
+    NS_ASSERT_MSG(f.rates.size() == f.route.size(), "The network has not been evaluated");
+    // pay bursts only once: concatenation of the left-over service curves
+    double latency = 0;
+    double rate = std::numeric_limits<double>::infinity();
+    double delay = 0;
+    for (std::size_t k = 0; k < f.route.size(); k++)
+    {
+        const Server& server = m_servers[f.route[k]];
+        latency += f.latencies[k];
+        rate = std::min(rate, f.rates[k] / GetScale(f, server));
+        delay += server.delay;
+    }
+    if (rate == 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return latency + (std::isinf(rate) ? 0 : f.burst / rate) + delay;
+}
+
+double
+NetworkCalculus::GetBacklogBound(uint32_t flow) const
+{
+    const Flow& f = m_flows.at(flow);
+    NS_ASSERT_MSG(f.rates.size() == f.route.size(), "The network has not been evaluated");
+    double latency = 0;
+    for (auto l : f.latencies)
+    {
+        latency += l;
+    }
+    return (f.burst + f.rate * latency) / 8;
+}
+
+double
+NetworkCalculus::GetHopDelayBound(uint32_t server, uint32_t flow) const
+{
+    const Flow& f = m_flows.at(flow);
+    auto it = std::find(f.route.begin(), f.route.end(), server);
+    NS_ASSERT_MSG(it != f.route.end(), "Flow " << f.name << " does not cross server " << server);
+    std::size_t k = it - f.route.begin();
+    NS_ASSERT_MSG(k < f.rates.size(), "The network has not been evaluated");
+    const Server& s = m_servers[server];
+    if (f.rates[k] == 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return f.latencies[k] + f.bursts[k] * GetScale(f, s) / f.rates[k] + s.delay;
+}
+
+double
+NetworkCalculus::GetServerBacklogBound(uint32_t server) const
+{
+    return m_servers.at(server).backlog / 8;
+}
+
+} // namespace ns3
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef NETWORK_CALCULUS_H
+#define NETWORK_CALCULUS_H
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup stats
+ *
+ * \brief Deterministic network calculus bounds of a feed-forward network of
+ * output ports and switching fabrics.
+ *
+ * Every server (a port or a fabric) offers a rate-latency service curve
+ * beta(t) = R [t - T]+, followed by a fixed delay (e.g., propagation), and
+ * adds a per-packet overhead in bytes.  Every flow has a token-bucket arrival
+ * curve alpha(t) = b + r t at its first server (burst b and rate r, excluding
+ * the overheads), a maximum packet size, a traffic class and a route.
+ *
+ * The traffic classes are mapped to the queues of every server (AddQueue and
+ * MapClass).  A queue has a strict priority level (0 is the highest,
+ * non-preemptive) and a DRR quantum in bytes shared with the other queues of
+ * its level; the classes not mapped go to the default queue 0 (level 0).
+ * Within a queue the flows are multiplexed in FIFO order.
+ *
+ * The bounds follow the separated flow analysis with pay bursts only once
+ * (Le Boudec and Thiran, Network Calculus, 2001).  The servers are visited in
+ * topological order; at every server the left-over service curve of a flow is
+ * a rate-latency curve obtained from:
+ * - the level: R_l = R - r_H and T_l = (R T + b_H + L_low) / R_l, with
+ *   r_H and b_H the rates and bursts of the higher levels and L_low the
+ *   largest packet of the lower ones (non-preemption);
+ * - the queue, among the other backlogged queues of its level with DRR:
+ *   R_q = R_l Q_q / Q and T_q = T_l + ((Q - Q_q) (1 + L_q / Q_q) +
+ *   sum_{j != q} L_j) / R_l (Boyer, Stea and Sofack, 2012), with Q the sum
+ *   of the quanta and L_j the largest packet of queue j; when it gives a
+ *   lower delay bound (e.g., a quantum too small for the rate of the queue),
+ *   blind multiplexing with the other queues of the level is used instead,
+ *   R_q = R_l - r_L and T_q = (R_l T_l + b_L) / R_q, with r_L and b_L the
+ *   rates and bursts of the other queues of the level;
+ * - the flow, with blind multiplexing among the other flows of the queue:
+ *   R_f = R_q - r_o and T_f = (R_q T_q + b_o) / R_f;
+ * - store and forward: the packetizer adds the transmission of a largest
+ *   packet of the flow at the rate of the server, L_f / R, to T_f.
+ *
+ * The burst of the flow at the next server is b + r T_f.  The end-to-end
+ * service curve of a flow is the concatenation of its left-over curves, of
+ * rate the minimum rate and latency the sum of latencies, so the delay bound
+ * is sum(T_f) + b / min(R_f) plus the fixed delays, and the backlog bound
+ * b + r sum(T_f).  The backlog bound of a server is the sum of the bursts
+ * plus the sum of the rates times T.
+ *
+ * Rates are in bit/s, sizes in bytes and times in seconds; a flow crossing a
+ * server whose left-over rate is lower than the rate of the flow has infinite
+ * bounds.
+ */
+class NetworkCalculus
+{
+  public:
+    NetworkCalculus();
+
+    /**
+     * \brief Add a server.
+     * \param name the name of the server
+     * \param rate the rate R of the service curve in bit/s
+     * \param latency the latency T of the service curve in seconds
+     * \param delay the fixed delay after the server in seconds
+     * \param overhead the bytes added to every packet at this server
+     * \return the index of the server
+     */
+    uint32_t AddServer(const std::string& name,
+                       double rate,
+                       double latency = 0,
+                       double delay = 0,
+                       uint32_t overhead = 0);
+
+    /**
+     * \brief Add a queue to a server.
+     * \param server the index of the server
+     * \param priority the priority level of the queue (0 is the highest)
+     * \param quantum the DRR quantum of the queue within its level, in bytes
+     * \return the index of the queue in the server
+     */
+    uint32_t AddQueue(uint32_t server, uint32_t priority, double quantum = 1500);
+
+    /**
+     * \brief Map a traffic class to a queue of a server.
+     * \param server the index of the server
+     * \param trafficClass the traffic class
+     * \param queue the index of the queue
+     */
+    void MapClass(uint32_t server, uint32_t trafficClass, uint32_t queue);
+
+    /**
+     * \brief Add a flow.
+     * \param name the name of the flow
+     * \param rate the token-bucket rate in bit/s, excluding the overheads
+     * \param burst the token-bucket burst in bytes, excluding the overheads
+     * \param packetSize the maximum packet size in bytes, excluding the overheads
+     * \param route the indices of the servers crossed, in order
+     * \param trafficClass the traffic class
+     * \return the index of the flow
+     */
+    uint32_t AddFlow(const std::string& name,
+                     double rate,
+                     double burst,
+                     uint32_t packetSize,
+                     const std::vector<uint32_t>& route,
+                     uint32_t trafficClass = 0);
+
+    /// Compute the bounds of the current network
+    void Evaluate();
+
+    /// \return the number of servers
+    uint32_t GetNServers() const;
+
+    /// \return the number of flows
+    uint32_t GetNFlows() const;
+
+    /**
+     * \param server the index of the server
+     * \return the name of the server
+     */
+    std::string GetServerName(uint32_t server) const;
+
+    /**
+     * \param flow the index of the flow
+     * \return the name of the flow
+     */
+    std::string GetFlowName(uint32_t flow) const;
+
+    /**
+     * \param server the index of the server
+     * \return the utilization of the server
+     */
+    double GetUtilization(uint32_t server) const;
+
+    /// \return true if the rate of every server is at least the sum of the rates of its flows
+    bool IsStable() const;
+
+    /**
+     * \param flow the index of the flow
+     * \return the end-to-end delay bound of the flow
+     */
+    double GetDelayBound(uint32_t flow) const;
+
+    /**
+     * \param flow the index of the flow
+     * \return the end-to-end backlog bound of the flow, in bytes
+     */
+    double GetBacklogBound(uint32_t flow) const;
+
+    /**
+     * \param server the index of the server
+     * \param flow the index of a flow crossing the server
+     * \return the delay bound of the flow at the server alone
+     */
+    double GetHopDelayBound(uint32_t server, uint32_t flow) const;
+
+    /**
+     * \param server the index of the server
+     * \return the backlog bound of the server, in bytes
+     */
+    double GetServerBacklogBound(uint32_t server) const;
+
+  private:
+    /// Queue of a server
+    struct Queue
+    {
+        uint32_t priority; //!< Priority level
+        double quantum;    //!< DRR quantum (bytes)
+    };
+
+    /// A server
+    struct Server
+    {
+        std::string name;                     //!< Name
+        double rate;                          //!< Rate (bit/s)
+        double latency;                       //!< Latency (s)
+        double delay;                         //!< Fixed delay (s)
+        uint32_t overhead;                    //!< Overhead per packet (bytes)
+        std::vector<Queue> queues;            //!< Queues (the first one is the default)
+        std::map<uint32_t, uint32_t> classes; //!< Queue of every mapped traffic class
+        double utilization{0};                //!< Utilization
+        double backlog{0};                    //!< Backlog bound (bits)
+    };
+
+    /// A flow
+    struct Flow
+    {
+        std::string name;            //!< Name
+        double rate;                 //!< Rate (bit/s)
+        double burst;                //!< Burst (bits)
+        uint32_t packetSize;         //!< Maximum packet size (bytes)
+        std::vector<uint32_t> route; //!< Servers crossed
+        uint32_t trafficClass;       //!< Traffic class
+        std::vector<double> bursts;  //!< Burst at every server of the route (bits)
+        std::vector<double> rates;   //!< Left-over rate at every server of the route
+        std::vector<double> latencies; //!< Left-over latency at every server of the route
+    };
+
+    /**
+     * \param flow the flow
+     * \param server the server
+     * \return the ratio of the bytes of the flow at the server to its bytes
+     */
+    static double GetScale(const Flow& flow, const Server& server);
+
+    /**
+     * \return the servers in topological order of the routes
+     */
+    std::vector<uint32_t> GetOrder() const;
+
+    /// Hop of a flow: index of the flow and position of the server in its route
+    typedef std::pair<uint32_t, std::size_t> Hop;
+
+    /**
+     * \brief Compute the left-over service curves of the flows crossing a server.
+     * \param index the index of the server
+     * \param members the hops of the flows crossing the server
+     */
+    void EvaluateServer(uint32_t index, const std::vector<Hop>& members);
+
+    std::vector<Server> m_servers; //!< Servers
+    std::vector<Flow> m_flows;     //!< Flows
+};
+
+} // namespace ns3
+
+#endif /* NETWORK_CALCULUS_H */
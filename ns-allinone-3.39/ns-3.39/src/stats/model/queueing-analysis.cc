@@ -0,0 +1,473 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "queueing-analysis.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("QueueingAnalysis");
+
+QueueingAnalysis::QueueingAnalysis()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+QueueingAnalysis::AddStation(const std::string& name,
+                             double capacity,
+                             double delay,
+                             uint32_t overhead)
+{
+    NS_LOG_FUNCTION(this << name << capacity << delay << overhead);
+    NS_ASSERT_MSG(capacity > 0, "The capacity of station " << name << " must be positive");
+    Station station;
+    station.name = name;
+    station.capacity = capacity;
+    station.delay = delay;
+    station.overhead = overhead;
+    station.queues.push_back(Queue{0, 1});
+    m_stations.push_back(station);
+    return m_stations.size() - 1;
+}
+
+void
+QueueingAnalysis::SetQueue(uint32_t station, uint32_t trafficClass, uint32_t priority, double weight)
+{
+    NS_LOG_FUNCTION(this << station << trafficClass << priority << weight);
+    NS_ASSERT_MSG(weight > 0, "The weight of a queue must be positive");
+    Station& s = m_stations.at(station);
+    auto it = s.classes.find(trafficClass);
+    if (it == s.classes.end())
+    {
+        s.classes[trafficClass] = s.queues.size();
+        s.queues.push_back(Queue{priority, weight});
+    }
+    else
+    {
+        s.queues[it->second] = Queue{priority, weight};
+    }
+}
+
+uint32_t
+QueueingAnalysis::AddFlow(const std::string& name,
+                          double rate,
+                          double packetSize,
+                          const std::vector<uint32_t>& route,
+                          uint32_t trafficClass,
+                          double arrivalScv,
+                          double sizeScv)
+{
+    NS_LOG_FUNCTION(this << name << rate << packetSize << trafficClass << arrivalScv << sizeScv);
+    NS_ASSERT_MSG(packetSize > 0, "The packet size of flow " << name << " must be positive");
+    for (auto station : route)
+    {
+        NS_ASSERT_MSG(station < m_stations.size(), "Unknown station " << station);
+    }
+    Flow flow;
+    flow.name = name;
+    flow.rate = rate;
+    flow.packetSize = packetSize;
+    flow.route = route;
+    flow.trafficClass = trafficClass;
+    flow.arrivalScv = arrivalScv;
+    flow.sizeScv = sizeScv;
+    m_flows.push_back(flow);
+    return m_flows.size() - 1;
+}
+
+uint32_t
+QueueingAnalysis::GetQueue(const Station& station, uint32_t trafficClass)
+{
+    auto it = station.classes.find(trafficClass);
+    return it == station.classes.end() ? 0 : it->second;
+}
+
+double
+QueueingAnalysis::GetLevelLoad(const Station& station, uint32_t trafficClass)
+{
+    uint32_t priority = station.queues[GetQueue(station, trafficClass)].priority;
+    double load = 0;
+    for (std::size_t q = 0; q < station.queues.size(); q++)
+    {
+        load += station.queues[q].priority <= priority ? station.loads[q] : 0;
+    }
+    return load;
+}
+
+double
+QueueingAnalysis::GetServiceScv(const Flow& flow, const Station& station)
+{
+    // the overhead is constant: it only adds to the mean
+    double ratio = flow.packetSize / (flow.packetSize + station.overhead);
+    return flow.sizeScv * ratio * ratio;
+}
+
+double
+QueueingAnalysis::PriorityWait(double residual, double higherLoad, double load)
+{
+    double total = higherLoad + load;
+    if (total >= 1)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return residual / ((1 - higherLoad) * (1 - total));
+}
+
+std::vector<double>
+QueueingAnalysis::FairShare(double capacity,
+                            const std::vector<double>& demands,
+                            const std::vector<double>& weights)
+{
+    NS_ASSERT(demands.size() == weights.size());
+    std::vector<double> shares(demands.size(), 0);
+    std::vector<bool> satisfied(demands.size(), false);
+    double remaining = capacity;
+    bool progress = true;
+    while (progress && remaining > 0)
+    {
+        // share what remains among the unsatisfied queues, by weight, and
+        // satisfy all the queues whose demand fits in their share
+        double weightSum = 0;
+        for (std::size_t i = 0; i < demands.size(); i++)
+        {
+            weightSum += satisfied[i] ? 0 : weights[i];
+        }
+        if (weightSum == 0)
+        {
+            break;
+        }
+        progress = false;
+        for (std::size_t i = 0; i < demands.size(); i++)
+        {
+            if (!satisfied[i] && demands[i] <= remaining * weights[i] / weightSum)
+            {
+                satisfied[i] = true;
+                shares[i] = demands[i];
+                progress = true;
+            }
+        }
+        if (progress)
+        {
+            remaining = capacity;
+            for (std::size_t i = 0; i < demands.size(); i++)
+            {
+                remaining -= satisfied[i] ? shares[i] : 0;
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < demands.size(); i++)
+            {
+                shares[i] = satisfied[i] ? shares[i] : remaining * weights[i] / weightSum;
+            }
+            return shares;
+        }
+    }
+    // all the demands are satisfied: the queues also get the capacity left
+    // over when they are backlogged
+    double weightSum = 0;
+    for (auto w : weights)
+    {
+        weightSum += w;
+    }
+    for (std::size_t i = 0; i < demands.size() && remaining > 0; i++)
+    {
+        shares[i] += remaining * weights[i] / weightSum;
+    }
+    return shares;
+}
+
+void
+QueueingAnalysis::Evaluate()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& station : m_stations)
+    {
+        station.loads.assign(station.queues.size(), 0);
+        station.utilization = 0;
+        station.stable = true;
+    }
+    for (auto& flow : m_flows)
+    {
+        for (auto index : flow.route)
+        {
+            Station& station = m_stations[index];
+            double load = flow.rate * (flow.packetSize + station.overhead) / flow.packetSize /
+                          station.capacity;
+            station.loads[GetQueue(station, flow.trafficClass)] += load;
+            station.utilization += load;
+        }
+    }
+
+    // variability of the arrivals along the routes (departures of the previous station)
+    for (auto& flow : m_flows)
+    {
+        std::size_t hops = flow.route.size();
+        flow.scv.assign(hops, flow.arrivalScv);
+        flow.waits.assign(hops, 0);
+        flow.service.assign(hops, 0);
+        flow.busy.assign(hops, 0);
+        for (std::size_t k = 1; k < hops; k++)
+        {
+            const Station& previous = m_stations[flow.route[k - 1]];
+            double rho = std::min(GetLevelLoad(previous, flow.trafficClass), 1.0);
+            flow.scv[k] = rho * rho * GetServiceScv(flow, previous) + (1 - rho * rho) * flow.scv[k - 1];
+        }
+    }
+
+    for (uint32_t i = 0; i < m_stations.size(); i++)
+    {
+        EvaluateStation(i);
+    }
+}
+
+void
+QueueingAnalysis::EvaluateStation(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    Station& station = m_stations[index];
+    std::size_t nQueues = station.queues.size();
+
+    // per queue: arrival rate, load, sum of lambda E[S^2] and of lambda ca^2
+    std::vector<double> lambda(nQueues, 0);
+    std::vector<double> load(nQueues, 0);
+    std::vector<double> moment(nQueues, 0);
+    std::vector<double> variability(nQueues, 0);
+    // the flows crossing the station, and their position in the route
+    std::vector<std::pair<uint32_t, std::size_t>> members;
+    double residual = 0;
+    for (uint32_t f = 0; f < m_flows.size(); f++)
+    {
+        Flow& flow = m_flows[f];
+        for (std::size_t k = 0; k < flow.route.size(); k++)
+        {
+            if (flow.route[k] != index)
+            {
+                continue;
+            }
+            double l = flow.rate / (8 * flow.packetSize);
+            double s = 8 * (flow.packetSize + station.overhead) / station.capacity;
+            double s2 = s * s * (1 + GetServiceScv(flow, station));
+            uint32_t q = GetQueue(station, flow.trafficClass);
+            lambda[q] += l;
+            load[q] += l * s;
+            moment[q] += l * s2;
+            variability[q] += l * flow.scv[k];
+            residual += l * s2 / 2;
+            flow.service[k] = s;
+            members.emplace_back(f, k);
+        }
+    }
+
+    std::vector<double> waits(nQueues, 0);
+    std::vector<uint32_t> levels;
+    for (const auto& queue : station.queues)
+    {
+        levels.push_back(queue.priority);
+    }
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+
+    double higherLoad = 0;
+    for (auto level : levels)
+    {
+        std::vector<std::size_t> queues;
+        double levelLoad = 0;
+        for (std::size_t q = 0; q < nQueues; q++)
+        {
+            if (station.queues[q].priority == level && lambda[q] > 0)
+            {
+                queues.push_back(q);
+                levelLoad += load[q];
+            }
+        }
+        double levelWait = PriorityWait(residual, higherLoad, levelLoad);
+        if (std::isinf(levelWait))
+        {
+            station.stable = false;
+        }
+        if (queues.size() == 1 || std::isinf(levelWait))
+        {
+            for (auto q : queues)
+            {
+                waits[q] = levelWait;
+            }
+        }
+        else if (queues.size() > 1)
+        {
+            // WRR: each queue as an M/G/1 at its fair share of the capacity
+            // left to the level, scaled to satisfy the conservation law
+            std::vector<double> demands;
+            std::vector<double> weights;
+            for (auto q : queues)
+            {
+                demands.push_back(load[q] * station.capacity);
+                weights.push_back(station.queues[q].weight);
+            }
+            std::vector<double> shares =
+                FairShare(station.capacity * (1 - higherLoad), demands, weights);
+            double sum = 0;
+            for (std::size_t j = 0; j < queues.size(); j++)
+            {
+                std::size_t q = queues[j];
+                double speedup = station.capacity / shares[j];
+                double rho = load[q] * speedup;
+                double own = rho < 1 ? moment[q] * speedup * speedup / (2 * (1 - rho))
+                                     : std::numeric_limits<double>::infinity();
+                waits[q] = residual + own;
+                sum += load[q] * waits[q];
+            }
+            for (auto q : queues)
+            {
+                waits[q] *= levelLoad * levelWait / sum;
+            }
+        }
+        higherLoad += levelLoad;
+    }
+
+    // non-Poisson arrivals (Allen-Cunneen)
+    for (std::size_t q = 0; q < nQueues; q++)
+    {
+        if (lambda[q] == 0 || std::isinf(waits[q]))
+        {
+            continue;
+        }
+        double mean = load[q] / lambda[q];
+        double serviceScv = moment[q] / lambda[q] / (mean * mean) - 1;
+        double arrivalScv = variability[q] / lambda[q];
+        waits[q] *= (arrivalScv + serviceScv) / (1 + serviceScv);
+    }
+
+    for (const auto& member : members)
+    {
+        Flow& flow = m_flows[member.first];
+        uint32_t q = GetQueue(station, flow.trafficClass);
+        flow.waits[member.second] = waits[q];
+        flow.busy[member.second] = std::min(station.utilization, 1.0);
+    }
+    NS_LOG_DEBUG("Station " << station.name << " utilization " << station.utilization);
+}
+
+uint32_t
+QueueingAnalysis::GetNStations() const
+{
+    return m_stations.size();
+}
+
+uint32_t
+QueueingAnalysis::GetNFlows() const
+{
+    return m_flows.size();
+}
+
+std::string
+QueueingAnalysis::GetStationName(uint32_t station) const
+{
+    return m_stations.at(station).name;
+}
+
+std::string
+QueueingAnalysis::GetFlowName(uint32_t flow) const
+{
+    return m_flows.at(flow).name;
+}
+
+double
+QueueingAnalysis::GetUtilization(uint32_t station) const
+{
+    return m_stations.at(station).utilization;
+}
+
+double
+QueueingAnalysis::GetMaxUtilization() const
+{
+    double max = 0;
+    for (const auto& station : m_stations)
+    {
+        max = std::max(max, station.utilization);
+    }
+    return max;
+}
+
+bool
+QueueingAnalysis::IsStable() const
+{
+    for (const auto& station : m_stations)
+    {
+        if (!station.stable)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+double
+QueueingAnalysis::GetMeanWait(uint32_t station, uint32_t flow) const
+{
+    const Flow& f = m_flows.at(flow);
+    auto it = std::find(f.route.begin(), f.route.end(), station);
+    NS_ASSERT_MSG(it != f.route.end(), "Flow " << f.name << " does not cross station " << station);
+    std::size_t k = it - f.route.begin();
+    NS_ASSERT_MSG(k < f.waits.size(), "The network has not been evaluated");
+    return f.waits[k];
+}
+
+double
+QueueingAnalysis::GetMeanDelay(uint32_t flow) const
+{
+    const Flow& f = m_flows.at(flow);
+    NS_ASSERT_MSG(f.waits.size() == f.route.size(), "The network has not been evaluated");
+    double delay = 0;
+    for (std::size_t k = 0; k < f.route.size(); k++)
+    {
+        delay += f.waits[k] + f.service[k] + m_stations[f.route[k]].delay;
+    }
+    return delay;
+}
+
+double
+QueueingAnalysis::GetDelayQuantile(uint32_t flow, double epsilon) const
+{
+    NS_ASSERT_MSG(epsilon > 0 && epsilon < 1, "The probability must be in (0, 1)");
+    const Flow& f = m_flows.at(flow);
+    NS_ASSERT_MSG(f.waits.size() == f.route.size(), "The network has not been evaluated");
+    double perStation = epsilon / f.route.size();
+    double delay = 0;
+    for (std::size_t k = 0; k < f.route.size(); k++)
+    {
+        delay += f.service[k] + m_stations[f.route[k]].delay;
+        double p = f.busy[k];
+        if (f.waits[k] > 0 && perStation < p)
+        {
+            // P(W > t) = p exp(-t p / E[W])
+            delay += f.waits[k] / p * std::log(p / perStation);
+        }
+    }
+    return delay;
+}
+
+} // namespace ns3
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef QUEUEING_ANALYSIS_H
+#define QUEUEING_ANALYSIS_H
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup stats
+ *
+ * \brief Analytic queueing model of a network of output ports and switching
+ * fabrics, to screen scenarios in microseconds before simulating them.
+ *
+ * The network is a set of stations (a link or a backplane, each a single
+ * server of a given capacity in bit/s, with a fixed delay and a per-packet
+ * overhead in bytes) crossed by flows (a rate in bit/s, a mean packet size,
+ * the squared coefficients of variation of the inter-arrival times and of the
+ * packet sizes, a traffic class and a route).
+ *
+ * At every station a traffic class can be given its own queue (SetQueue), with
+ * a strict priority level (0 is the highest) and a weight.  Queues of the same
+ * level share the capacity left by the higher levels by weighted round robin.
+ * The other classes share a FIFO queue of level 0 and weight 1, so a
+ * station without any mapping is a FIFO.
+ *
+ * Evaluate computes, per station:
+ * - the utilization, sum over the flows of their rate (including the
+ *   overhead) over the capacity;
+ * - the mean waiting time of every level with the M/G/1 non-preemptive
+ *   priority formula (Cobham): W_l = R / ((1 - s_{l-1}) (1 - s_l)), with
+ *   R the mean residual service time, sum of lambda E[S^2] / 2 over all the
+ *   flows, and s_l the utilization of the levels up to l;
+ * - for the queues of a level sharing by WRR, a decomposition: every queue is
+ *   served at its max-min fair share (by weight) of the capacity left to the
+ *   level, plus the unused share, and waits R plus its own M/G/1 wait at that
+ *   rate.  These waits are then scaled so that their load-weighted sum is the
+ *   one of the level (Kleinrock's conservation law), which makes a single
+ *   queue per level exact;
+ * - the waiting times of queues whose arrivals are not Poisson are scaled by
+ *   (ca^2 + cs^2) / (1 + cs^2) (Allen-Cunneen, Kingman's formula for a FIFO),
+ *   where ca^2 is the squared coefficient of variation of the inter-arrival
+ *   times of the queue and cs^2 the one of its service times.
+ *
+ * Along a route, the arrival variability of a flow at the next station is the
+ * one of the departures of the previous one, ca'^2 = rho^2 cs^2 +
+ * (1 - rho^2) ca^2 (Whitt's QNA), with rho the utilization of the level of the
+ * flow and the higher ones (the lower levels do not delay its departures).  The mean end-to-end delay is the sum of the
+ * mean waits, service times and fixed delays of the stations of the route
+ * (Kleinrock's independence approximation).  The end-to-end delay quantile
+ * bound assumes exponential tails at every station, P(W > t) = rho
+ * exp(-t rho / E[W]), and splits the violation probability evenly among the
+ * stations (union bound).
+ *
+ * Times are in seconds; an unstable station (a level with a utilization of one
+ * or more) gives infinite waits.
+ */
+class QueueingAnalysis
+{
+  public:
+    QueueingAnalysis();
+
+    /**
+     * \brief Add a station.
+     * \param name the name of the station
+     * \param capacity the capacity in bit/s
+     * \param delay the fixed (e.g., propagation) delay in seconds
+     * \param overhead the bytes added to every packet at this station
+     * \return the index of the station
+     */
+    uint32_t AddStation(const std::string& name,
+                        double capacity,
+                        double delay = 0,
+                        uint32_t overhead = 0);
+
+    /**
+     * \brief Give a traffic class its own queue at a station.
+     * \param station the index of the station
+     * \param trafficClass the traffic class
+     * \param priority the priority level of the queue (0 is the highest)
+     * \param weight the WRR weight of the queue within its level
+     */
+    void SetQueue(uint32_t station, uint32_t trafficClass, uint32_t priority, double weight = 1);
+
+    /**
+     * \brief Add a flow.
+     * \param name the name of the flow
+     * \param rate the rate in bit/s, excluding the overheads of the stations
+     * \param packetSize the mean packet size in bytes
+     * \param route the indices of the stations crossed, in order
+     * \param trafficClass the traffic class
+     * \param arrivalScv the squared coefficient of variation of the
+     *        inter-arrival times at the first station (1 for Poisson, 0 for CBR)
+     * \param sizeScv the squared coefficient of variation of the packet sizes
+     *        (0 for constant, 1 for exponential)
+     * \return the index of the flow
+     */
+    uint32_t AddFlow(const std::string& name,
+                     double rate,
+                     double packetSize,
+                     const std::vector<uint32_t>& route,
+                     uint32_t trafficClass = 0,
+                     double arrivalScv = 1,
+                     double sizeScv = 0);
+
+    /// Compute the utilizations and delays of the current network
+    void Evaluate();
+
+    /// \return the number of stations
+    uint32_t GetNStations() const;
+
+    /// \return the number of flows
+    uint32_t GetNFlows() const;
+
+    /**
+     * \param station the index of the station
+     * \return the name of the station
+     */
+    std::string GetStationName(uint32_t station) const;
+
+    /**
+     * \param flow the index of the flow
+     * \return the name of the flow
+     */
+    std::string GetFlowName(uint32_t flow) const;
+
+    /**
+     * \param station the index of the station
+     * \return the utilization of the station
+     */
+    double GetUtilization(uint32_t station) const;
+
+    /// \return the maximum utilization of the stations
+    double GetMaxUtilization() const;
+
+    /// \return true if all the stations are stable
+    bool IsStable() const;
+
+    /**
+     * \param station the index of the station
+     * \param flow the index of a flow crossing the station
+     * \return the mean waiting time of the flow at the station
+     */
+    double GetMeanWait(uint32_t station, uint32_t flow) const;
+
+    /**
+     * \param flow the index of the flow
+     * \return the mean end-to-end delay of the flow
+     */
+    double GetMeanDelay(uint32_t flow) const;
+
+    /**
+     * \param flow the index of the flow
+     * \param epsilon the probability of exceeding the bound
+     * \return the approximate (1 - epsilon) quantile of the end-to-end delay of the flow
+     */
+    double GetDelayQuantile(uint32_t flow, double epsilon) const;
+
+    /**
+     * \brief Mean waiting time of an M/G/1 non-preemptive priority level.
+     * \param residual the mean residual service time R
+     * \param higherLoad the utilization of the higher priority levels
+     * \param load the utilization of the level
+     * \return the mean waiting time, or infinity if the level is unstable
+     */
+    static double PriorityWait(double residual, double higherLoad, double load);
+
+    /**
+     * \brief Max-min fair share of a capacity by weight, with the capacity
+     * left over shared by weight among all the queues.
+     * \param capacity the capacity to share
+     * \param demands the demands of the queues
+     * \param weights the weights of the queues
+     * \return the capacities allocated to the queues
+     */
+    static std::vector<double> FairShare(double capacity,
+                                         const std::vector<double>& demands,
+                                         const std::vector<double>& weights);
+
+  private:
+    /// Queue of a station
+    struct Queue
+    {
+        uint32_t priority; //!< Priority level
+        double weight;     //!< WRR weight within the level
+    };
+
+    /// A station
+    struct Station
+    {
+        std::string name;                    //!< Name
+        double capacity;                     //!< Capacity (bit/s)
+        double delay;                        //!< Fixed delay (s)
+        uint32_t overhead;                   //!< Overhead per packet (bytes)
+        std::map<uint32_t, uint32_t> classes; //!< Queue of every mapped traffic class
+        std::vector<Queue> queues;           //!< Queues (the first one is the default)
+        std::vector<double> loads;           //!< Utilization of the queues
+        double utilization{0};               //!< Utilization
+        bool stable{true};                   //!< All the levels are stable
+    };
+
+    /// A flow
+    struct Flow
+    {
+        std::string name;             //!< Name
+        double rate;                  //!< Rate (bit/s)
+        double packetSize;            //!< Mean packet size (bytes)
+        std::vector<uint32_t> route;  //!< Stations crossed
+        uint32_t trafficClass;        //!< Traffic class
+        double arrivalScv;            //!< SCV of the inter-arrival times at the first station
+        double sizeScv;               //!< SCV of the packet sizes
+        std::vector<double> scv;      //!< SCV of the inter-arrival times at every station of the route
+        std::vector<double> waits;    //!< Mean wait at every station of the route
+        std::vector<double> service;  //!< Mean service time at every station of the route
+        std::vector<double> busy;     //!< Probability of waiting at every station of the route
+    };
+
+    /**
+     * \param station the station
+     * \param trafficClass the traffic class
+     * \return the index of the queue of the class at the station
+     */
+    static uint32_t GetQueue(const Station& station, uint32_t trafficClass);
+
+    /**
+     * \param station the station
+     * \param trafficClass the traffic class
+     * \return the utilization of the level of the class and the higher ones
+     */
+    static double GetLevelLoad(const Station& station, uint32_t trafficClass);
+
+    /**
+     * \param flow the flow
+     * \param station the station
+     * \return the SCV of the service times of the flow at the station
+     */
+    static double GetServiceScv(const Flow& flow, const Station& station);
+
+    /**
+     * \brief Compute the mean waits of the flows crossing a station.
+     * \param index the index of the station
+     */
+    void EvaluateStation(uint32_t index);
+
+    std::vector<Station> m_stations; //!< Stations
+    std::vector<Flow> m_flows;       //!< Flows
+};
+
+} // namespace ns3
+
+#endif /* QUEUEING_ANALYSIS_H */
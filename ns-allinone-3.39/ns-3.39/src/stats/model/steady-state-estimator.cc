@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "steady-state-estimator.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SteadyStateEstimator");
+
+NS_OBJECT_ENSURE_REGISTERED(SteadyStateEstimator);
+
+TypeId
+SteadyStateEstimator::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SteadyStateEstimator")
+            .SetParent<Object>()
+            .SetGroupName("Stats")
+            .AddConstructor<SteadyStateEstimator>()
+            .AddAttribute("BatchCount",
+                          "Number of batches of the batch means method",
+                          UintegerValue(20),
+                          MakeUintegerAccessor(&SteadyStateEstimator::m_batches),
+                          MakeUintegerChecker<uint32_t>(2))
+            .AddAttribute("ConfidenceLevel",
+                          "Confidence level of the intervals",
+                          DoubleValue(0.95),
+                          MakeDoubleAccessor(&SteadyStateEstimator::m_confidence),
+                          MakeDoubleChecker<double>(0.5, 0.9999))
+            .AddAttribute("RelativeHalfWidth",
+                          "Target half-width of the intervals relative to the mean",
+                          DoubleValue(0.05),
+                          MakeDoubleAccessor(&SteadyStateEstimator::m_relativeHalfWidth),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("MinSamples",
+                          "Minimum number of samples of a flow before it can converge",
+                          UintegerValue(1000),
+                          MakeUintegerAccessor(&SteadyStateEstimator::m_minSamples),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("MaxGroups",
+                          "Maximum number of group means stored per flow; adjacent "
+                          "groups are merged when it is reached",
+                          UintegerValue(10000),
+                          MakeUintegerAccessor(&SteadyStateEstimator::m_maxGroups),
+                          MakeUintegerChecker<uint32_t>(100))
+            .AddAttribute("CheckInterval",
+                          "Simulation time between convergence checks (zero disables them)",
+                          TimeValue(MilliSeconds(10)),
+                          MakeTimeAccessor(&SteadyStateEstimator::m_checkInterval),
+                          MakeTimeChecker())
+            .AddAttribute("StopSimulation",
+                          "Stop the simulation once all the monitored flows have converged",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&SteadyStateEstimator::m_stopSimulation),
+                          MakeBooleanChecker())
+            .AddTraceSource("Converged",
+                            "All the monitored flows have converged",
+                            MakeTraceSourceAccessor(&SteadyStateEstimator::m_convergedTrace),
+                            "ns3::SteadyStateEstimator::ConvergedTracedCallback");
+    return tid;
+}
+
+SteadyStateEstimator::SteadyStateEstimator()
+    : m_done(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SteadyStateEstimator::~SteadyStateEstimator()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+SteadyStateEstimator::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_checkEvent.Cancel();
+    m_flows.clear();
+    Object::DoDispose();
+}
+
+void
+SteadyStateEstimator::Monitor(uint32_t flowId)
+{
+    NS_LOG_FUNCTION(this << flowId);
+    m_flows[flowId].monitored = true;
+}
+
+void
+SteadyStateEstimator::AddSample(uint32_t flowId, double value)
+{
+    FlowState& state = m_flows[flowId];
+    state.samples++;
+    state.partialSum += value;
+    if (++state.partialCount == state.groupSize)
+    {
+        state.groups.push_back(state.partialSum / state.groupSize);
+        state.partialSum = 0;
+        state.partialCount = 0;
+        if (state.groups.size() >= (m_maxGroups & ~1U))
+        {
+            for (std::size_t i = 0; i < state.groups.size() / 2; i++)
+            {
+                state.groups[i] = (state.groups[2 * i] + state.groups[2 * i + 1]) / 2;
+            }
+            state.groups.resize(state.groups.size() / 2);
+            state.groupSize *= 2;
+        }
+    }
+
+    if (!m_done && !m_checkEvent.IsRunning() && m_checkInterval.IsStrictlyPositive())
+    {
+        m_checkEvent =
+            Simulator::Schedule(m_checkInterval, &SteadyStateEstimator::PeriodicCheck, this);
+    }
+}
+
+void
+SteadyStateEstimator::AddDelay(uint32_t flowId, Time delay)
+{
+    AddSample(flowId, delay.GetSeconds());
+}
+
+void
+SteadyStateEstimator::Estimate(FlowState& state) const
+{
+    state.warmupDone = false;
+    state.converged = false;
+    const std::vector<double>& g = state.groups;
+    std::size_t k = g.size();
+    if (k < 2 * m_batches)
+    {
+        return;
+    }
+
+    // MSER: truncation point minimizing the variance of the remaining
+    // group means over their number, with suffix sums built from the end.
+    double sum = 0;
+    double sumSq = 0;
+    double best = std::numeric_limits<double>::max();
+    std::size_t truncation = 0;
+    for (std::size_t d = k; d-- > 0;)
+    {
+        sum += g[d];
+        sumSq += g[d] * g[d];
+        std::size_t m = k - d;
+        if (d > k / 2)
+        {
+            continue;
+        }
+        double mser = std::max(0.0, sumSq - sum * sum / m) / (double(m) * m);
+        if (mser <= best)
+        {
+            best = mser;
+            truncation = d;
+        }
+    }
+    state.warmup = truncation * state.groupSize;
+    if (truncation == k / 2)
+    {
+        return;
+    }
+    state.warmupDone = true;
+
+    // Batch means over the most recent groups after the truncation point.
+    std::size_t perBatch = (k - truncation) / m_batches;
+    std::size_t first = k - perBatch * m_batches;
+    double mean = 0;
+    std::vector<double> batchMeans(m_batches, 0);
+    for (uint32_t b = 0; b < m_batches; b++)
+    {
+        for (std::size_t j = 0; j < perBatch; j++)
+        {
+            batchMeans[b] += g[first + b * perBatch + j];
+        }
+        batchMeans[b] /= perBatch;
+        mean += batchMeans[b];
+    }
+    mean /= m_batches;
+    double var = 0;
+    for (double x : batchMeans)
+    {
+        var += (x - mean) * (x - mean);
+    }
+    var /= (m_batches - 1);
+
+    state.mean = mean;
+    state.halfWidth = StudentQuantile((1 + m_confidence) / 2, m_batches - 1) *
+                      std::sqrt(var / m_batches);
+    state.converged = state.samples >= m_minSamples &&
+                      state.halfWidth <= m_relativeHalfWidth * std::fabs(state.mean);
+}
+
+bool
+SteadyStateEstimator::Check()
+{
+    NS_LOG_FUNCTION(this);
+    bool anyMonitored = false;
+    for (auto& [flowId, state] : m_flows)
+    {
+        anyMonitored |= state.monitored;
+    }
+
+    bool all = !m_flows.empty();
+    for (auto& [flowId, state] : m_flows)
+    {
+        Estimate(state);
+        NS_LOG_DEBUG("Flow " << flowId << " samples " << state.samples << " warmup "
+                             << state.warmup << " mean " << state.mean << " +- "
+                             << state.halfWidth << (state.converged ? " converged" : ""));
+        if (state.monitored || !anyMonitored)
+        {
+            all &= state.converged;
+        }
+    }
+    return all;
+}
+
+void
+SteadyStateEstimator::PeriodicCheck()
+{
+    NS_LOG_FUNCTION(this);
+    if (Check())
+    {
+        NS_LOG_INFO("All flows converged at " << Simulator::Now().As(Time::S));
+        m_done = true;
+        m_convergedTrace(Simulator::Now());
+        if (m_stopSimulation)
+        {
+            Simulator::Stop();
+        }
+        return;
+    }
+    m_checkEvent = Simulator::Schedule(m_checkInterval, &SteadyStateEstimator::PeriodicCheck, this);
+}
+
+const SteadyStateEstimator::FlowState&
+SteadyStateEstimator::GetFlow(uint32_t flowId) const
+{
+    auto it = m_flows.find(flowId);
+    NS_ABORT_MSG_IF(it == m_flows.end(), "Unknown flow " << flowId);
+    return it->second;
+}
+
+uint64_t
+SteadyStateEstimator::GetSamples(uint32_t flowId) const
+{
+    return GetFlow(flowId).samples;
+}
+
+uint64_t
+SteadyStateEstimator::GetWarmupSamples(uint32_t flowId) const
+{
+    return GetFlow(flowId).warmup;
+}
+
+bool
+SteadyStateEstimator::IsWarmupDone(uint32_t flowId) const
+{
+    return GetFlow(flowId).warmupDone;
+}
+
+double
+SteadyStateEstimator::GetMean(uint32_t flowId) const
+{
+    return GetFlow(flowId).mean;
+}
+
+double
+SteadyStateEstimator::GetHalfWidth(uint32_t flowId) const
+{
+    return GetFlow(flowId).halfWidth;
+}
+
+bool
+SteadyStateEstimator::HasConverged(uint32_t flowId) const
+{
+    return GetFlow(flowId).converged;
+}
+
+double
+SteadyStateEstimator::StudentQuantile(double p, uint32_t dof)
+{
+    NS_ASSERT(p > 0 && p < 1 && dof > 0);
+    if (dof == 1)
+    {
+        return std::tan(M_PI * (p - 0.5));
+    }
+    if (dof == 2)
+    {
+        return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+    }
+
+    // Normal quantile (Acklam's rational approximation)
+    static const double a[] = {-3.969683028665376e+01,
+                               2.209460984245205e+02,
+                               -2.759285104469687e+02,
+                               1.383577518672690e+02,
+                               -3.066479806614716e+01,
+                               2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01,
+                               1.615858368580409e+02,
+                               -1.556989798598866e+02,
+                               6.680131188771972e+01,
+                               -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03,
+                               -3.223964580411365e-01,
+                               -2.400758277161838e+00,
+                               -2.549732539343734e+00,
+                               4.374664141464968e+00,
+                               2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03,
+                               3.224671290700398e-01,
+                               2.445134137142996e+00,
+                               3.754408661907416e+00};
+    const double low = 0.02425;
+    double z;
+    if (p < low || p > 1 - low)
+    {
+        double q = std::sqrt(-2 * std::log(p < low ? p : 1 - p));
+        z = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+        z = p < low ? z : -z;
+    }
+    else
+    {
+        double q = p - 0.5;
+        double r = q * q;
+        z = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+    }
+
+    // Cornish-Fisher expansion (Abramowitz and Stegun 26.7.5)
+    double z2 = z * z;
+    double g1 = (z2 + 1) * z / 4;
+    double g2 = ((5 * z2 + 16) * z2 + 3) * z / 96;
+    double g3 = (((3 * z2 + 19) * z2 + 17) * z2 - 15) * z / 384;
+    double g4 = ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) * z / 92160;
+    double n = dof;
+    return z + g1 / n + g2 / (n * n) + g3 / (n * n * n) + g4 / (n * n * n * n);
+}
+
+} // namespace ns3
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef STEADY_STATE_ESTIMATOR_H
+#define STEADY_STATE_ESTIMATOR_H
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup stats
+ *
+ * \brief Online steady-state estimator of per-flow means (e.g., delays).
+ *
+ * Samples are grouped in consecutive groups (initially of 5 samples) whose
+ * means are stored.  The end of the initial transient of every flow is
+ * detected with the MSER-5 rule over these group means: the truncation
+ * point is the one minimizing the variance of the remaining means divided
+ * by their number, searched in the first half of the series.  If the
+ * minimum lies at the end of that half the transient is not over yet.
+ *
+ * The samples after the truncation point are split into "BatchCount"
+ * batches and the confidence interval of the mean is computed with the
+ * batch means method.  A flow has converged when the half-width of the
+ * interval, relative to the mean, is below "RelativeHalfWidth".
+ *
+ * The check is done every "CheckInterval" of simulation time.  When all
+ * the monitored flows (all the flows, if none has been explicitly
+ * monitored) have converged the "Converged" trace is fired and, if
+ * "StopSimulation" is set, the simulation is stopped.
+ *
+ * Memory is bounded: when the number of stored group means reaches
+ * "MaxGroups" adjacent groups are merged and the group size is doubled.
+ */
+class SteadyStateEstimator : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SteadyStateEstimator();
+    ~SteadyStateEstimator() override;
+
+    /**
+     * \brief Require a flow to converge before the simulation is stopped.
+     * \param flowId the flow identifier
+     */
+    void Monitor(uint32_t flowId);
+
+    /**
+     * \brief Add a sample of a flow.
+     * \param flowId the flow identifier
+     * \param value the sample value
+     */
+    void AddSample(uint32_t flowId, double value);
+
+    /**
+     * \brief Add a delay sample of a flow, in seconds.
+     * \param flowId the flow identifier
+     * \param delay the delay
+     */
+    void AddDelay(uint32_t flowId, Time delay);
+
+    /**
+     * \brief Run the convergence check of all the flows now.
+     * \return true if all the monitored flows have converged
+     */
+    bool Check();
+
+    /**
+     * \param flowId the flow identifier
+     * \return the number of samples of the flow
+     */
+    uint64_t GetSamples(uint32_t flowId) const;
+
+    /**
+     * \param flowId the flow identifier
+     * \return the number of samples discarded as initial transient, as of the last check
+     */
+    uint64_t GetWarmupSamples(uint32_t flowId) const;
+
+    /**
+     * \param flowId the flow identifier
+     * \return true if the end of the transient has been detected in the last check
+     */
+    bool IsWarmupDone(uint32_t flowId) const;
+
+    /**
+     * \param flowId the flow identifier
+     * \return the steady-state mean estimated in the last check
+     */
+    double GetMean(uint32_t flowId) const;
+
+    /**
+     * \param flowId the flow identifier
+     * \return the confidence interval half-width estimated in the last check
+     */
+    double GetHalfWidth(uint32_t flowId) const;
+
+    /**
+     * \param flowId the flow identifier
+     * \return true if the flow has converged in the last check
+     */
+    bool HasConverged(uint32_t flowId) const;
+
+    /**
+     * \brief Quantile of the Student t distribution.
+     * \param p the probability
+     * \param dof the degrees of freedom
+     * \return the quantile
+     */
+    static double StudentQuantile(double p, uint32_t dof);
+
+    /**
+     * TracedCallback signature for convergence of all the flows.
+     *
+     * \param [in] time the simulation time at which convergence was detected
+     */
+    typedef void (*ConvergedTracedCallback)(Time time);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// Online state of a flow
+    struct FlowState
+    {
+        std::vector<double> groups; //!< Means of the closed groups
+        uint32_t groupSize{5};      //!< Number of samples per group
+        double partialSum{0};       //!< Sum of the samples of the open group
+        uint32_t partialCount{0};   //!< Number of samples of the open group
+        uint64_t samples{0};        //!< Total number of samples
+        uint64_t warmup{0};         //!< Samples discarded as transient
+        bool warmupDone{false};     //!< The end of the transient was detected
+        double mean{0};             //!< Steady-state mean
+        double halfWidth{0};        //!< Confidence interval half-width
+        bool converged{false};      //!< The target precision was reached
+        bool monitored{false};      //!< Required for the simulation to stop
+    };
+
+    /**
+     * \brief Update the estimates of a flow.
+     * \param state the flow state
+     */
+    void Estimate(FlowState& state) const;
+
+    /// Periodic convergence check
+    void PeriodicCheck();
+
+    /**
+     * \param flowId the flow identifier
+     * \return the state of the flow, which must exist
+     */
+    const FlowState& GetFlow(uint32_t flowId) const;
+
+    std::unordered_map<uint32_t, FlowState> m_flows; //!< Flow states
+    uint32_t m_batches;                              //!< Number of batches
+    double m_confidence;                             //!< Confidence level
+    double m_relativeHalfWidth;                      //!< Target relative half-width
+    uint64_t m_minSamples;        //!< Minimum number of samples per flow
+    uint32_t m_maxGroups;         //!< Maximum number of stored group means
+    Time m_checkInterval;         //!< Interval between checks
+    bool m_stopSimulation;        //!< Stop the simulation on convergence
+    bool m_done;                  //!< Convergence has already been notified
+    EventId m_checkEvent;         //!< Next periodic check
+    TracedCallback<Time> m_convergedTrace; //!< Convergence trace
+};
+
+} // namespace ns3
+
+#endif /* STEADY_STATE_ESTIMATOR_H */
@@ -20,6 +20,8 @@
 #include "ns3/histogram.h"
 #include "ns3/test.h"
 
+#include <cmath>
+
 using namespace ns3;
 
 /**
@@ -69,6 +71,25 @@ HistogramTestCase::DoRun()
         NS_TEST_EXPECT_MSG_EQ(h0.GetNBins(), 22, "");
         NS_TEST_EXPECT_MSG_EQ(h0.GetBinCount(21), 1, "");
     }
+
+    {
+        // Testing logarithmic bins: [0,1e-6) [1e-6,1e-5.5) [1e-5.5,1e-5) ...
+        Histogram h1;
+        h1.SetLogBins(1e-6, 2);
+        h1.AddValue(0);
+        h1.AddValue(2e-6);
+        h1.AddValue(4e-6);
+        h1.AddValue(1.5e-3);
+        NS_TEST_EXPECT_MSG_EQ(h1.GetNBins(), 8, "");
+        NS_TEST_EXPECT_MSG_EQ(h1.GetBinCount(0), 1, "");
+        NS_TEST_EXPECT_MSG_EQ(h1.GetBinCount(1), 1, "");
+        NS_TEST_EXPECT_MSG_EQ(h1.GetBinCount(2), 1, "");
+        NS_TEST_EXPECT_MSG_EQ(h1.GetBinCount(7), 1, "");
+        NS_TEST_EXPECT_MSG_EQ_TOL(h1.GetBinStart(1), 1e-6, 1e-12, "");
+        NS_TEST_EXPECT_MSG_EQ_TOL(h1.GetBinEnd(2), 1e-5, 1e-12, "");
+        NS_TEST_EXPECT_MSG_EQ_TOL(h1.GetBinStart(7), 1e-3, 1e-9, "");
+        NS_TEST_EXPECT_MSG_EQ_TOL(h1.GetBinWidth(7), 1e-3 * (std::sqrt(10.0) - 1), 1e-9, "");
+    }
 }
 
 /**
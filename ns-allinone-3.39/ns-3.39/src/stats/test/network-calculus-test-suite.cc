@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/network-calculus.h"
+#include "ns3/test.h"
+
+#include <cmath>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Bounds of a single server and of a tandem (pay bursts only once).
+ */
+class NetworkCalculusTandemTestCase : public TestCase
+{
+  public:
+    NetworkCalculusTandemTestCase();
+    void DoRun() override;
+};
+
+NetworkCalculusTandemTestCase::NetworkCalculusTandemTestCase()
+    : TestCase("Single server and tandem")
+{
+}
+
+void
+NetworkCalculusTandemTestCase::DoRun()
+{
+    // R = 1 Gbit/s, T = 1 us; b = L = 1500 bytes, r = 100 Mbit/s
+    NetworkCalculus single;
+    uint32_t server = single.AddServer("port", 1e9, 1e-6, 2e-6);
+    uint32_t flow = single.AddFlow("flow", 1e8, 1500, 1500, {server});
+    single.Evaluate();
+    // T_f = T + L / R = 13 us, plus b / R = 12 us and the fixed delay
+    NS_TEST_EXPECT_MSG_EQ_TOL(single.GetDelayBound(flow), 27e-6, 1e-12, "Bad delay bound");
+    NS_TEST_EXPECT_MSG_EQ_TOL(single.GetHopDelayBound(server, flow), 27e-6, 1e-12, "Bad hop bound");
+    NS_TEST_EXPECT_MSG_EQ_TOL(single.GetBacklogBound(flow), 1662.5, 1e-9, "Bad backlog bound");
+    NS_TEST_EXPECT_MSG_EQ_TOL(single.GetServerBacklogBound(server), 1512.5, 1e-9, "Bad backlog");
+    NS_TEST_EXPECT_MSG_EQ(single.IsStable(), true, "The network is stable");
+
+    // the burst is paid once, at the slowest server
+    NetworkCalculus tandem;
+    uint32_t first = tandem.AddServer("first", 1e9);
+    uint32_t second = tandem.AddServer("second", 5e8);
+    flow = tandem.AddFlow("flow", 1e8, 1000, 1000, {first, second});
+    tandem.Evaluate();
+    NS_TEST_EXPECT_MSG_EQ_TOL(tandem.GetDelayBound(flow), 40e-6, 1e-12, "Bad delay bound");
+    // 16 us at the first server, then 16 us + (8000 + 800) / 5e8 at the second one
+    NS_TEST_EXPECT_MSG_EQ_TOL(tandem.GetHopDelayBound(first, flow), 16e-6, 1e-12, "Bad hop bound");
+    NS_TEST_EXPECT_MSG_EQ_TOL(tandem.GetHopDelayBound(second, flow),
+                              33.6e-6,
+                              1e-12,
+                              "Bad hop bound");
+
+    // overloaded server
+    NetworkCalculus overload;
+    server = overload.AddServer("port", 1e9, 0, 0, 30);
+    overload.AddFlow("flow", 1e9, 1000, 1000, {server});
+    overload.Evaluate();
+    NS_TEST_EXPECT_MSG_EQ(overload.IsStable(), false, "The server is overloaded");
+    NS_TEST_EXPECT_MSG_EQ(std::isinf(overload.GetDelayBound(0)), true, "Infinite bound expected");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Left-over service of strict priority, DRR and FIFO queues.
+ */
+class NetworkCalculusSchedulerTestCase : public TestCase
+{
+  public:
+    NetworkCalculusSchedulerTestCase();
+    void DoRun() override;
+};
+
+NetworkCalculusSchedulerTestCase::NetworkCalculusSchedulerTestCase()
+    : TestCase("Priority, DRR and FIFO queues")
+{
+}
+
+void
+NetworkCalculusSchedulerTestCase::DoRun()
+{
+    NetworkCalculus priority;
+    uint32_t server = priority.AddServer("port", 1e9);
+    priority.MapClass(server, 1, priority.AddQueue(server, 0));
+    priority.MapClass(server, 2, priority.AddQueue(server, 1));
+    uint32_t high = priority.AddFlow("high", 1e8, 1000, 1000, {server}, 1);
+    uint32_t low = priority.AddFlow("low", 2e8, 2000, 1500, {server}, 2);
+    priority.Evaluate();
+    // blocked by one low priority packet (12 us), own packet (8 us), burst (8 us)
+    NS_TEST_EXPECT_MSG_EQ_TOL(priority.GetDelayBound(high), 28e-6, 1e-12, "Bad high bound");
+    // R_l = 900 Mbit/s, T_l = 8000 / R_l, own packet 12 us, burst 16000 / R_l
+    NS_TEST_EXPECT_MSG_EQ_TOL(priority.GetDelayBound(low),
+                              24000 / 9e8 + 12e-6,
+                              1e-12,
+                              "Bad low bound");
+
+    // two DRR queues with quanta of one packet: R_q = R / 2 and
+    // T_q = ((Q - Q_q) (1 + L / Q_q) + L) / R = 36 us, better than blind
+    // multiplexing with the large burst of the other queue
+    NetworkCalculus drr;
+    server = drr.AddServer("port", 1e9);
+    drr.MapClass(server, 1, drr.AddQueue(server, 0, 1500));
+    drr.MapClass(server, 2, drr.AddQueue(server, 0, 1500));
+    uint32_t flow = drr.AddFlow("first", 1e8, 1500, 1500, {server}, 1);
+    uint32_t second = drr.AddFlow("second", 4e8, 15000, 1500, {server}, 2);
+    drr.Evaluate();
+    NS_TEST_EXPECT_MSG_EQ_TOL(drr.GetDelayBound(flow),
+                              36e-6 + 12e-6 + 24e-6,
+                              1e-12,
+                              "Bad DRR bound");
+    // the other queue: blind multiplexing, R_q = 900 Mbit/s and T_q = 12000 / R_q
+    NS_TEST_EXPECT_MSG_EQ_TOL(drr.GetDelayBound(second),
+                              132000 / 9e8 + 12e-6,
+                              1e-12,
+                              "Bad blind bound");
+
+    // FIFO: the burst of the other flow is served first
+    NetworkCalculus fifo;
+    server = fifo.AddServer("port", 1e9);
+    flow = fifo.AddFlow("first", 1e8, 1000, 1000, {server});
+    fifo.AddFlow("second", 1e8, 3000, 1000, {server});
+    fifo.Evaluate();
+    // R_f = 900 Mbit/s, T_f = 24000 / R_f + 8 us
+    NS_TEST_EXPECT_MSG_EQ_TOL(fifo.GetDelayBound(flow),
+                              32000 / 9e8 + 8e-6,
+                              1e-12,
+                              "Bad FIFO bound");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief NetworkCalculus TestSuite
+ */
+class NetworkCalculusTestSuite : public TestSuite
+{
+  public:
+    NetworkCalculusTestSuite();
+};
+
+NetworkCalculusTestSuite::NetworkCalculusTestSuite()
+    : TestSuite("network-calculus", UNIT)
+{
+    AddTestCase(new NetworkCalculusTandemTestCase, TestCase::QUICK);
+    AddTestCase(new NetworkCalculusSchedulerTestCase, TestCase::QUICK);
+}
+
+static NetworkCalculusTestSuite
+    g_networkCalculusTestSuite; //!< Static variable for test initialization
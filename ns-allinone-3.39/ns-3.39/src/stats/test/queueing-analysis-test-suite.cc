@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/queueing-analysis.h"
+#include "ns3/test.h"
+
+#include <cmath>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief A FIFO station against the M/D/1 and M/M/1 formulas.
+ */
+class QueueingAnalysisFifoTestCase : public TestCase
+{
+  public:
+    QueueingAnalysisFifoTestCase();
+    void DoRun() override;
+};
+
+QueueingAnalysisFifoTestCase::QueueingAnalysisFifoTestCase()
+    : TestCase("FIFO station")
+{
+}
+
+void
+QueueingAnalysisFifoTestCase::DoRun()
+{
+    // 1000-byte packets at 500 Mbit/s on 1 Gbit/s: S = 8 us, rho = 0.5
+    QueueingAnalysis model;
+    uint32_t link = model.AddStation("link", 1e9, 1e-6);
+    uint32_t constant = model.AddFlow("constant", 5e8, 1000, {link});
+    model.Evaluate();
+    NS_TEST_EXPECT_MSG_EQ_TOL(model.GetUtilization(link), 0.5, 1e-12, "Bad utilization");
+    NS_TEST_EXPECT_MSG_EQ(model.IsStable(), true, "The station is stable");
+    // M/D/1: W = rho S / (2 (1 - rho))
+    NS_TEST_EXPECT_MSG_EQ_TOL(model.GetMeanWait(link, constant), 4e-6, 1e-12, "Bad M/D/1 wait");
+    NS_TEST_EXPECT_MSG_EQ_TOL(model.GetMeanDelay(constant), 13e-6, 1e-12, "Bad M/D/1 delay");
+    // exponential tail: S + W / rho ln(rho / epsilon)
+    NS_TEST_EXPECT_MSG_EQ_TOL(model.GetDelayQuantile(constant, 0.01),
+                              9e-6 + 8e-6 * std::log(50),
+                              1e-12,
+                              "Bad delay quantile");
+
+    // exponential sizes: W = rho S / (1 - rho)
+    QueueingAnalysis exponential;
+    link = exponential.AddStation("link", 1e9);
+    uint32_t flow = exponential.AddFlow("exponential", 5e8, 1000, {link}, 0, 1, 1);
+    exponential.Evaluate();
+    NS_TEST_EXPECT_MSG_EQ_TOL(exponential.GetMeanWait(link, flow), 8e-6, 1e-12, "Bad M/M/1 wait");
+
+    // the overhead of the station adds to the load
+    QueueingAnalysis overhead;
+    link = overhead.AddStation("link", 1e9, 0, 30);
+    overhead.AddFlow("flow", 5e8, 1000, {link});
+    overhead.AddFlow("more", 5e8, 1000, {link});
+    overhead.Evaluate();
+    NS_TEST_EXPECT_MSG_EQ_TOL(overhead.GetUtilization(link), 1.03, 1e-12, "Bad utilization");
+    NS_TEST_EXPECT_MSG_EQ(overhead.IsStable(), false, "The station is overloaded");
+    NS_TEST_EXPECT_MSG_EQ(std::isinf(overhead.GetMeanDelay(0)), true, "Infinite delay expected");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Strict priority and WRR queues.
+ */
+class QueueingAnalysisSchedulerTestCase : public TestCase
+{
+  public:
+    QueueingAnalysisSchedulerTestCase();
+    void DoRun() override;
+};
+
+QueueingAnalysisSchedulerTestCase::QueueingAnalysisSchedulerTestCase()
+    : TestCase("Priority and WRR queues")
+{
+}
+
+void
+QueueingAnalysisSchedulerTestCase::DoRun()
+{
+    // class 0: 1000 bytes, rho 0.2; class 1: 500 bytes, rho 0.4; R = 1.6 us
+    QueueingAnalysis priority;
+    uint32_t link = priority.AddStation("link", 1e9);
+    priority.SetQueue(link, 0, 0);
+    priority.SetQueue(link, 1, 1);
+    uint32_t high = priority.AddFlow("high", 2e8, 1000, {link}, 0);
+    uint32_t low = priority.AddFlow("low", 4e8, 500, {link}, 1);
+    priority.Evaluate();
+    NS_TEST_EXPECT_MSG_EQ_TOL(priority.GetMeanWait(link, high), 2e-6, 1e-12, "Bad wait of class 0");
+    NS_TEST_EXPECT_MSG_EQ_TOL(priority.GetMeanWait(link, low), 5e-6, 1e-12, "Bad wait of class 1");
+    NS_TEST_EXPECT_MSG_EQ_TOL(QueueingAnalysis::PriorityWait(1.6e-6, 0.2, 0.4),
+                              5e-6,
+                              1e-12,
+                              "Bad priority wait");
+
+    // two symmetric WRR queues wait as a FIFO with both
+    QueueingAnalysis symmetric;
+    link = symmetric.AddStation("link", 1e9);
+    symmetric.SetQueue(link, 1, 0, 1);
+    symmetric.SetQueue(link, 2, 0, 1);
+    uint32_t first = symmetric.AddFlow("first", 2.5e8, 1000, {link}, 1);
+    uint32_t second = symmetric.AddFlow("second", 2.5e8, 1000, {link}, 2);
+    symmetric.Evaluate();
+    NS_TEST_EXPECT_MSG_EQ_TOL(symmetric.GetMeanWait(link, first), 4e-6, 1e-12, "Bad WRR wait");
+    NS_TEST_EXPECT_MSG_EQ_TOL(symmetric.GetMeanWait(link, second), 4e-6, 1e-12, "Bad WRR wait");
+
+    // a larger weight waits less, and the waits satisfy the conservation law
+    QueueingAnalysis weighted;
+    link = weighted.AddStation("link", 1e9);
+    weighted.SetQueue(link, 1, 0, 10);
+    weighted.SetQueue(link, 2, 0, 1);
+    first = weighted.AddFlow("first", 4e8, 1000, {link}, 1);
+    second = weighted.AddFlow("second", 4e8, 1000, {link}, 2);
+    weighted.Evaluate();
+    double w1 = weighted.GetMeanWait(link, first);
+    double w2 = weighted.GetMeanWait(link, second);
+    NS_TEST_EXPECT_MSG_LT(w1, w2, "The larger weight should wait less");
+    // M/D/1 at rho 0.8: 16 us
+    NS_TEST_EXPECT_MSG_EQ_TOL(0.4 * w1 + 0.4 * w2, 0.8 * 16e-6, 1e-12, "Conservation law");
+
+    std::vector<double> shares = QueueingAnalysis::FairShare(10, {1, 8}, {1, 1});
+    NS_TEST_EXPECT_MSG_EQ_TOL(shares[0], 1.5, 1e-12, "Bad share");
+    NS_TEST_EXPECT_MSG_EQ_TOL(shares[1], 8.5, 1e-12, "Bad share");
+    shares = QueueingAnalysis::FairShare(10, {1, 20, 20}, {1, 1, 2});
+    NS_TEST_EXPECT_MSG_EQ_TOL(shares[0], 1, 1e-12, "Bad share");
+    NS_TEST_EXPECT_MSG_EQ_TOL(shares[1], 3, 1e-12, "Bad share");
+    NS_TEST_EXPECT_MSG_EQ_TOL(shares[2], 6, 1e-12, "Bad share");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief A tandem of stations.
+ */
+class QueueingAnalysisTandemTestCase : public TestCase
+{
+  public:
+    QueueingAnalysisTandemTestCase();
+    void DoRun() override;
+};
+
+QueueingAnalysisTandemTestCase::QueueingAnalysisTandemTestCase()
+    : TestCase("Tandem of stations")
+{
+}
+
+void
+QueueingAnalysisTandemTestCase::DoRun()
+{
+    // constant rate flow of constant size packets: no queueing
+    QueueingAnalysis cbr;
+    uint32_t first = cbr.AddStation("first", 1e9, 2e-6);
+    uint32_t second = cbr.AddStation("second", 2e9, 3e-6);
+    uint32_t flow = cbr.AddFlow("cbr", 5e8, 1000, {first, second}, 0, 0, 0);
+    cbr.Evaluate();
+    NS_TEST_EXPECT_MSG_EQ(cbr.GetMeanWait(first, flow), 0, "No wait expected");
+    NS_TEST_EXPECT_MSG_EQ_TOL(cbr.GetMeanDelay(flow), 17e-6, 1e-12, "Bad delay");
+    NS_TEST_EXPECT_MSG_EQ_TOL(cbr.GetDelayQuantile(flow, 1e-3), 17e-6, 1e-12, "Bad quantile");
+
+    // Poisson arrivals are smoothed by the first station: ca^2 = 1 - rho^2
+    QueueingAnalysis poisson;
+    first = poisson.AddStation("first", 1e9);
+    second = poisson.AddStation("second", 1e9);
+    flow = poisson.AddFlow("poisson", 5e8, 1000, {first, second});
+    poisson.Evaluate();
+    NS_TEST_EXPECT_MSG_EQ_TOL(poisson.GetMeanWait(first, flow), 4e-6, 1e-12, "Bad wait");
+    NS_TEST_EXPECT_MSG_EQ_TOL(poisson.GetMeanWait(second, flow), 3e-6, 1e-12, "Bad wait");
+    NS_TEST_EXPECT_MSG_EQ_TOL(poisson.GetMeanDelay(flow), 23e-6, 1e-12, "Bad delay");
+    NS_TEST_EXPECT_MSG_GT(poisson.GetDelayQuantile(flow, 1e-3),
+                          poisson.GetDelayQuantile(flow, 1e-2),
+                          "The quantiles should grow");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief QueueingAnalysis TestSuite
+ */
+class QueueingAnalysisTestSuite : public TestSuite
+{
+  public:
+    QueueingAnalysisTestSuite();
+};
+
+QueueingAnalysisTestSuite::QueueingAnalysisTestSuite()
+    : TestSuite("queueing-analysis", UNIT)
+{
+    AddTestCase(new QueueingAnalysisFifoTestCase, TestCase::QUICK);
+    AddTestCase(new QueueingAnalysisSchedulerTestCase, TestCase::QUICK);
+    AddTestCase(new QueueingAnalysisTandemTestCase, TestCase::QUICK);
+}
+
+static QueueingAnalysisTestSuite g_queueingAnalysisTestSuite; //!< Static variable for test initialization
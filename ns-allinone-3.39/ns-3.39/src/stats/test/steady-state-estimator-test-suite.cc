@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/steady-state-estimator.h"
+#include "ns3/test.h"
+
+#include <cmath>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Student t quantiles against tabulated values.
+ */
+class StudentQuantileTestCase : public TestCase
+{
+  public:
+    StudentQuantileTestCase();
+    void DoRun() override;
+};
+
+StudentQuantileTestCase::StudentQuantileTestCase()
+    : TestCase("Student t quantiles")
+{
+}
+
+void
+StudentQuantileTestCase::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ_TOL(SteadyStateEstimator::StudentQuantile(0.975, 1), 12.706, 1e-3, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(SteadyStateEstimator::StudentQuantile(0.975, 2), 4.303, 1e-3, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(SteadyStateEstimator::StudentQuantile(0.95, 10), 1.812, 2e-3, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(SteadyStateEstimator::StudentQuantile(0.975, 19), 2.093, 2e-3, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(SteadyStateEstimator::StudentQuantile(0.995, 29), 2.756, 2e-3, "");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Transient detection and batch means on a synthetic series.
+ */
+class SteadyStateWarmupTestCase : public TestCase
+{
+  public:
+    SteadyStateWarmupTestCase();
+    void DoRun() override;
+};
+
+SteadyStateWarmupTestCase::SteadyStateWarmupTestCase()
+    : TestCase("Steady-state warm-up detection")
+{
+}
+
+void
+SteadyStateWarmupTestCase::DoRun()
+{
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    Ptr<SteadyStateEstimator> estimator = CreateObject<SteadyStateEstimator>();
+    estimator->SetAttribute("CheckInterval", TimeValue(Seconds(0)));
+
+    // decaying transient followed by a stationary series of mean 10
+    for (uint32_t i = 0; i < 40000; i++)
+    {
+        estimator->AddSample(3, 10 + 90 * std::exp(-(i / 300.0)) + rng->GetValue(-1, 1));
+    }
+    NS_TEST_EXPECT_MSG_EQ(estimator->Check(), true, "The flow did not converge");
+    NS_TEST_EXPECT_MSG_EQ(estimator->IsWarmupDone(3), true, "Transient not detected");
+    NS_TEST_EXPECT_MSG_GT(estimator->GetWarmupSamples(3), 500, "Transient truncated too early");
+    NS_TEST_EXPECT_MSG_LT(estimator->GetWarmupSamples(3), 5000, "Transient truncated too late");
+    NS_TEST_EXPECT_MSG_EQ_TOL(estimator->GetMean(3), 10, 0.05, "Bad steady-state mean");
+    NS_TEST_EXPECT_MSG_LT(estimator->GetHalfWidth(3), 0.05, "Bad half-width");
+
+    // the transient is not over while the series keeps decreasing
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        estimator->AddSample(4, 1000.0 - i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(estimator->Check(), false, "Non-stationary flow converged");
+    NS_TEST_EXPECT_MSG_EQ(estimator->IsWarmupDone(4), false, "Non-stationary flow warmed up");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Automatic stop of the simulation once the monitored flows converge.
+ */
+class SteadyStateStopTestCase : public TestCase
+{
+  public:
+    SteadyStateStopTestCase();
+    void DoRun() override;
+
+  private:
+    /** Feed one sample to each flow and reschedule. */
+    void Generate();
+    /**
+     * Convergence trace sink.
+     * \param time the convergence time
+     */
+    void Converged(Time time);
+
+    Ptr<UniformRandomVariable> m_rng;      //!< Sample generator
+    Ptr<SteadyStateEstimator> m_estimator; //!< Estimator under test
+    bool m_converged{false};               //!< Converged trace fired
+};
+
+SteadyStateStopTestCase::SteadyStateStopTestCase()
+    : TestCase("Steady-state automatic stop")
+{
+}
+
+void
+SteadyStateStopTestCase::Generate()
+{
+    m_estimator->AddSample(0, m_rng->GetValue(1, 3));
+    m_estimator->AddSample(1, m_rng->GetValue(5, 15));
+    Simulator::Schedule(MicroSeconds(10), &SteadyStateStopTestCase::Generate, this);
+}
+
+void
+SteadyStateStopTestCase::Converged(Time time)
+{
+    m_converged = true;
+}
+
+void
+SteadyStateStopTestCase::DoRun()
+{
+    m_rng = CreateObject<UniformRandomVariable>();
+    m_rng->SetStream(2);
+    m_estimator = CreateObject<SteadyStateEstimator>();
+    m_estimator->SetAttribute("RelativeHalfWidth", DoubleValue(0.01));
+    m_estimator->SetAttribute("CheckInterval", TimeValue(MilliSeconds(1)));
+    m_estimator->Monitor(0);
+    m_estimator->Monitor(1);
+    m_estimator->TraceConnectWithoutContext(
+        "Converged",
+        MakeCallback(&SteadyStateStopTestCase::Converged, this));
+
+    Simulator::Schedule(Seconds(0), &SteadyStateStopTestCase::Generate, this);
+    Simulator::Stop(Seconds(100));
+    Simulator::Run();
+    Time end = Simulator::Now();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_converged, true, "Converged trace not fired");
+    NS_TEST_EXPECT_MSG_LT(end, Seconds(10), "Simulation not stopped on convergence");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_estimator->GetMean(0), 2, 0.02, "Bad mean of flow 0");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_estimator->GetMean(1), 10, 0.1, "Bad mean of flow 1");
+    m_estimator = nullptr;
+    m_rng = nullptr;
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SteadyStateEstimator TestSuite
+ */
+class SteadyStateEstimatorTestSuite : public TestSuite
+{
+  public:
+    SteadyStateEstimatorTestSuite();
+};
+
+SteadyStateEstimatorTestSuite::SteadyStateEstimatorTestSuite()
+    : TestSuite("steady-state-estimator", UNIT)
+{
+    AddTestCase(new StudentQuantileTestCase, TestCase::QUICK);
+    AddTestCase(new SteadyStateWarmupTestCase, TestCase::QUICK);
+    AddTestCase(new SteadyStateStopTestCase, TestCase::QUICK);
+}
+
+static SteadyStateEstimatorTestSuite
+    g_steadyStateEstimatorTestSuite; //!< Static variable for test initialization
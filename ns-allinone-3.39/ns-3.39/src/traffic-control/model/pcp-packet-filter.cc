@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcp-packet-filter.h"
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/queue-item.h"
+#include "ns3/uinteger.h"
+#include "ns3/vlan-header.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcpPacketFilter");
+
+NS_OBJECT_ENSURE_REGISTERED(PcpPacketFilter);
+
+TypeId
+PcpPacketFilter::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::PcpPacketFilter")
+                            .SetParent<PacketFilter>()
+                            .SetGroupName("TrafficControl")
+                            .AddConstructor<PcpPacketFilter>()
+                            .AddAttribute("NBands",
+                                          "The number of bands the PCP values are mapped to",
+                                          UintegerValue(8),
+                                          MakeUintegerAccessor(&PcpPacketFilter::m_nBands),
+                                          MakeUintegerChecker<uint32_t>(1, 8));
+    return tid;
+}
+
+PcpPacketFilter::PcpPacketFilter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PcpPacketFilter::~PcpPacketFilter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+bool
+PcpPacketFilter::CheckProtocol(Ptr<QueueDiscItem> item) const
+{
+    NS_LOG_FUNCTION(this << item);
+    VlanTag tag;
+    return item->GetPacket()->PeekPacketTag(tag);
+}
+
+int32_t
+PcpPacketFilter::DoClassify(Ptr<QueueDiscItem> item) const
+{
+    NS_LOG_FUNCTION(this << item);
+    VlanTag tag;
+    item->GetPacket()->PeekPacketTag(tag);
+    int32_t band = (7 - tag.GetPcp()) * m_nBands / 8;
+    NS_LOG_LOGIC("PCP " << +tag.GetPcp() << " band " << band);
+    return band;
+}
+
+} // namespace ns3
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCP_PACKET_FILTER_H
+#define PCP_PACKET_FILTER_H
+
+#include "packet-filter.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic-control
+ *
+ * PcpPacketFilter classifies the packets by the priority code point (PCP)
+ * of their VlanTag, as an IEEE 802.1Q bridge maps its traffic classes to the
+ * queues of a port.  The highest PCP (7) goes to the first band, which is
+ * the highest priority band of a PrioQueueDisc, and the eight PCP values are
+ * spread evenly over the NBands bands: the band of a packet is
+ * (7 - PCP) * NBands / 8.  Packets without a VlanTag are not classified, so
+ * the queue disc falls back on its own classification (the priomap of a
+ * PrioQueueDisc, for instance).
+ */
+class PcpPacketFilter : public PacketFilter
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    PcpPacketFilter();
+    ~PcpPacketFilter() override;
+
+  private:
+    bool CheckProtocol(Ptr<QueueDiscItem> item) const override;
+    int32_t DoClassify(Ptr<QueueDiscItem> item) const override;
+
+    uint32_t m_nBands; //!< Number of bands
+};
+
+} // namespace ns3
+
+#endif /* PCP_PACKET_FILTER_H */
@@ -19,6 +19,7 @@
 #include "queue-disc.h"
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/object-vector.h"
@@ -260,6 +261,12 @@ QueueDisc::GetTypeId()
                           UintegerValue(DEFAULT_QUOTA),
                           MakeUintegerAccessor(&QueueDisc::SetQuota, &QueueDisc::GetQuota),
                           MakeUintegerChecker<uint32_t>())
+            .AddAttribute("BurstMode",
+                          "Whether a qdisc run dequeues a burst of up to Quota packets "
+                          "while the (single queue) device can accept them",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&QueueDisc::m_burstMode),
+                          MakeBooleanChecker())
             .AddAttribute("InternalQueueList",
                           "The list of internal queues.",
                           ObjectVectorValue(),
@@ -322,6 +329,7 @@ QueueDisc::QueueDisc(QueueDiscSizePolicy policy)
     : m_nPackets(0),
       m_nBytes(0),
       m_maxSize(QueueSize("1p")), // to avoid that setting the mode at construction time is ignored
+      m_burstMode(false),
       m_running(false),
       m_peeked(false),
       m_sizePolicy(policy),
@@ -379,6 +387,7 @@ void
 QueueDisc::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_runEvent.Cancel();
     m_queues.clear();
     m_filters.clear();
     m_classes.clear();
@@ -957,6 +966,19 @@ QueueDisc::Run()
 
     if (RunBegin())
     {
+        if (m_burstMode && (!m_devQueueIface || m_devQueueIface->GetNTxQueues() == 1))
+        {
+            uint32_t sent = RunBurst(m_quota);
+            RunEnd();
+            if (sent == m_quota && GetNPackets() > 0 &&
+                (!m_devQueueIface || !m_devQueueIface->GetTxQueue(0)->IsStopped()) &&
+                !m_runEvent.IsRunning())
+            {
+                m_runEvent = Simulator::ScheduleNow(&QueueDisc::Run, this);
+            }
+            return;
+        }
+
         uint32_t quota = m_quota;
         while (Restart())
         {
@@ -971,6 +993,40 @@ QueueDisc::Run()
     }
 }
 
+uint32_t
+QueueDisc::RunBurst(uint32_t quota)
+{
+    NS_LOG_FUNCTION(this << quota);
+    NS_ASSERT_MSG(m_send, "Send callback not set");
+
+    Ptr<NetDeviceQueue> txq = (m_devQueueIface ? m_devQueueIface->GetTxQueue(0) : nullptr);
+    SocketPriorityTag priorityTag;
+    uint32_t sent = 0;
+
+    while (sent < quota)
+    {
+        // If the device does not support flow control, the device queue is never stopped
+        if (txq && txq->IsStopped())
+        {
+            NS_LOG_LOGIC("Device queue stopped after " << sent << " packets");
+            break;
+        }
+
+        Ptr<QueueDiscItem> item = DequeuePacket();
+        if (!item)
+        {
+            NS_LOG_LOGIC("No packet to send");
+            break;
+        }
+
+        // a single queue device makes no use of the priority tag
+        item->GetPacket()->RemovePacketTag(priorityTag);
+        m_send(item);
+        sent++;
+    }
+    return sent;
+}
+
 bool
 QueueDisc::RunBegin()
 {
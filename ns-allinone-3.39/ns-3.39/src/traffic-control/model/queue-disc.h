@@ -21,6 +21,7 @@
 
 #include "packet-filter.h"
 
+#include "ns3/event-id.h"
 #include "ns3/object.h"
 #include "ns3/queue-fwd.h"
 #include "ns3/queue-item.h"
@@ -421,6 +422,11 @@ class QueueDisc : public Object
      * Modelled after the Linux function __qdisc_run (net/sched/sch_generic.c)
      * Dequeues multiple packets, until a quota is exceeded or sending a packet
      * to the device failed.
+     *
+     * If the BurstMode attribute is set and the device has a single transmission
+     * queue, packets are dequeued in a burst by RunBurst and, if the quota is
+     * exhausted while packets are still queued and the device can accept them,
+     * another run is scheduled at the current time (as netif_schedule does).
      */
     void Run();
 
@@ -670,6 +676,16 @@ class QueueDisc : public Object
      */
     bool Transmit(Ptr<QueueDiscItem> item);
 
+    /**
+     * Dequeue up to the given number of packets and send them to the (single queue)
+     * device, as long as the device queue is not stopped. The device queue is checked
+     * before each dequeue, hence packets are never requeued and the order in which
+     * they are sent is the same as that of the Restart loop.
+     * \param quota the maximum number of packets to send
+     * \return the number of packets sent to the device
+     */
+    uint32_t RunBurst(uint32_t quota);
+
     /**
      * \brief Perform the actions required when the queue disc is notified of
      *        a packet enqueue
@@ -698,6 +714,8 @@ class QueueDisc : public Object
 
     Stats m_stats;    //!< The collected statistics
     uint32_t m_quota; //!< Maximum number of packets dequeued in a qdisc run
+    bool m_burstMode; //!< Dequeue bursts of packets in a qdisc run
+    EventId m_runEvent; //!< Qdisc run scheduled when the quota is exhausted (burst mode)
     Ptr<NetDeviceQueueInterface> m_devQueueIface; //!< NetDevice queue interface
     SendCallback m_send;           //!< Callback used to send a packet to the receiving object
     bool m_running;                //!< The queue disc is performing multiple dequeue operations
@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "queue-monitor.h"
+
+#include "queue-disc.h"
+#include "traffic-control-layer.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/queue.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("QueueMonitor");
+
+NS_OBJECT_ENSURE_REGISTERED(QueueMonitor);
+
+QueueOccupancy::QueueOccupancy(Time start, uint32_t byteBinWidth, Time interval)
+    : m_start(start),
+      m_last(start),
+      m_packets(0),
+      m_bytes(0),
+      m_maxPackets(0),
+      m_maxBytes(0),
+      m_packetSteps(),
+      m_byteSteps(),
+      m_byteBinWidth(byteBinWidth),
+      m_packetLevels(1, 0),
+      m_byteLevels(1, 0),
+      m_interval(interval),
+      m_intervalStart(start),
+      m_intervalPacketSteps(),
+      m_intervalByteSteps(),
+      m_intervalMaxPackets(0),
+      m_intervalMaxBytes(0)
+{
+    NS_ABORT_MSG_IF(byteBinWidth == 0, "The bins of the bytes CCDF cannot be empty");
+}
+
+void
+QueueOccupancy::SetPackets(Time now, uint32_t packets)
+{
+    Advance(now);
+    m_packets = packets;
+    if (packets >= m_packetLevels.size())
+    {
+        m_packetLevels.resize(packets + 1, 0);
+    }
+    m_maxPackets = std::max(m_maxPackets, packets);
+    m_intervalMaxPackets = std::max(m_intervalMaxPackets, packets);
+}
+
+void
+QueueOccupancy::SetBytes(Time now, uint32_t bytes)
+{
+    Advance(now);
+    m_bytes = bytes;
+    if (bytes / m_byteBinWidth >= m_byteLevels.size())
+    {
+        m_byteLevels.resize(bytes / m_byteBinWidth + 1, 0);
+    }
+    m_maxBytes = std::max(m_maxBytes, bytes);
+    m_intervalMaxBytes = std::max(m_intervalMaxBytes, bytes);
+}
+
+void
+QueueOccupancy::Advance(Time now)
+{
+    if (now <= m_last)
+    {
+        return;
+    }
+    if (m_interval.IsStrictlyPositive())
+    {
+        // close the intervals ended since the last change
+        while (now >= m_intervalStart + m_interval)
+        {
+            Account(m_intervalStart + m_interval);
+            double steps = m_interval.GetTimeStep();
+            m_series.push_back(Sample{m_intervalStart,
+                                      Divide(m_intervalPacketSteps, steps),
+                                      Divide(m_intervalByteSteps, steps),
+                                      m_intervalMaxPackets,
+                                      m_intervalMaxBytes});
+            m_intervalStart += m_interval;
+            m_intervalPacketSteps = Integral();
+            m_intervalByteSteps = Integral();
+            m_intervalMaxPackets = m_packets;
+            m_intervalMaxBytes = m_bytes;
+        }
+    }
+    Account(now);
+}
+
+#if defined(HAVE_UINT128_T) || defined(HAVE___UINT128_T)
+void
+QueueOccupancy::Integrate(Integral& integral, uint32_t level, uint64_t steps)
+{
+    integral += static_cast<Integral>(level) * steps;
+}
+
+double
+QueueOccupancy::Divide(const Integral& integral, double steps)
+{
+    return static_cast<double>(integral) / steps;
+}
+#else
+void
+QueueOccupancy::Integrate(Integral& integral, uint32_t level, uint64_t steps)
+{
+    // level times the low and the high halves of steps, each below 2^64
+    uint64_t low = level * (steps & 0xffffffff);
+    uint64_t high = level * (steps >> 32);
+    integral.low += low;
+    integral.high += integral.low < low ? 1 : 0;
+    uint64_t middle = high << 32;
+    integral.low += middle;
+    integral.high += (integral.low < middle ? 1 : 0) + (high >> 32);
+}
+
+double
+QueueOccupancy::Divide(const Integral& integral, double steps)
+{
+    return (std::ldexp(static_cast<double>(integral.high), 64) +
+            static_cast<double>(integral.low)) /
+           steps;
+}
+#endif
+
+void
+QueueOccupancy::Account(Time now)
+{
+    if (now <= m_last)
+    {
+        return;
+    }
+    uint64_t steps = (now - m_last).GetTimeStep();
+    Integrate(m_packetSteps, m_packets, steps);
+    Integrate(m_byteSteps, m_bytes, steps);
+    Integrate(m_intervalPacketSteps, m_packets, steps);
+    Integrate(m_intervalByteSteps, m_bytes, steps);
+    m_packetLevels[m_packets] += steps;
+    m_byteLevels[m_bytes / m_byteBinWidth] += steps;
+    m_last = now;
+}
+
+Time
+QueueOccupancy::GetDuration() const
+{
+    return m_last - m_start;
+}
+
+uint32_t
+QueueOccupancy::GetPackets() const
+{
+    return m_packets;
+}
+
+uint32_t
+QueueOccupancy::GetBytes() const
+{
+    return m_bytes;
+}
+
+double
+QueueOccupancy::GetMeanPackets() const
+{
+    int64_t steps = GetDuration().GetTimeStep();
+    return steps > 0 ? Divide(m_packetSteps, steps) : 0;
+}
+
+double
+QueueOccupancy::GetMeanBytes() const
+{
+    int64_t steps = GetDuration().GetTimeStep();
+    return steps > 0 ? Divide(m_byteSteps, steps) : 0;
+}
+
+uint32_t
+QueueOccupancy::GetMaxPackets() const
+{
+    return m_maxPackets;
+}
+
+uint32_t
+QueueOccupancy::GetMaxBytes() const
+{
+    return m_maxBytes;
+}
+
+uint32_t
+QueueOccupancy::GetByteBinWidth() const
+{
+    return m_byteBinWidth;
+}
+
+std::vector<double>
+QueueOccupancy::GetCcdf(const std::vector<uint64_t>& levels) const
+{
+    int64_t steps = GetDuration().GetTimeStep();
+    if (steps <= 0)
+    {
+        return {};
+    }
+    std::vector<double> ccdf(levels.size());
+    uint64_t above = 0;
+    for (std::size_t k = levels.size(); k-- > 0;)
+    {
+        above += levels[k];
+        ccdf[k] = static_cast<double>(above) / steps;
+    }
+    return ccdf;
+}
+
+std::vector<double>
+QueueOccupancy::GetPacketsCcdf() const
+{
+    return GetCcdf(m_packetLevels);
+}
+
+std::vector<double>
+QueueOccupancy::GetBytesCcdf() const
+{
+    return GetCcdf(m_byteLevels);
+}
+
+std::size_t
+QueueOccupancy::GetQuantile(const std::vector<uint64_t>& levels, double quantile) const
+{
+    double target = quantile * GetDuration().GetTimeStep();
+    uint64_t below = 0;
+    for (std::size_t k = 0; k < levels.size(); k++)
+    {
+        below += levels[k];
+        if (below >= target)
+        {
+            return k;
+        }
+    }
+    return levels.size() - 1;
+}
+
+uint32_t
+QueueOccupancy::GetPacketsQuantile(double quantile) const
+{
+    return GetQuantile(m_packetLevels, quantile);
+}
+
+uint64_t
+QueueOccupancy::GetBytesQuantile(double quantile) const
+{
+    if (GetDuration().IsZero())
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(GetQuantile(m_byteLevels, quantile) + 1) * m_byteBinWidth;
+}
+
+const std::vector<QueueOccupancy::Sample>&
+QueueOccupancy::GetSeries() const
+{
+    return m_series;
+}
+
+TypeId
+QueueMonitor::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::QueueMonitor")
+            .SetParent<Object>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<QueueMonitor>()
+            .AddAttribute("Interval",
+                          "The interval of the downsampled series of the queues added "
+                          "afterwards, or zero for no series.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&QueueMonitor::m_interval),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("ByteBinWidth",
+                          "The width in bytes of the bins of the bytes CCDF of the queues "
+                          "added afterwards.",
+                          UintegerValue(1500),
+                          MakeUintegerAccessor(&QueueMonitor::m_byteBinWidth),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+QueueMonitor::QueueMonitor()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+QueueMonitor::~QueueMonitor()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+QueueMonitor::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& entry : m_entries)
+    {
+        entry.object->TraceDisconnectWithoutContext("PacketsInQueue", entry.packetsSink);
+        entry.object->TraceDisconnectWithoutContext("BytesInQueue", entry.bytesSink);
+    }
+    m_entries.clear();
+    Object::DoDispose();
+}
+
+void
+QueueMonitor::Add(const std::string& name,
+                  Ptr<Object> object,
+                  Ptr<QueueDisc> queueDisc,
+                  uint32_t packets,
+                  uint32_t bytes)
+{
+    NS_LOG_FUNCTION(this << name << object << packets << bytes);
+    uint32_t index = m_entries.size();
+    m_entries.push_back(Entry{name,
+                              object,
+                              queueDisc,
+                              0,
+                              QueueOccupancy(Simulator::Now(), m_byteBinWidth, m_interval),
+                              MakeCallback(&QueueMonitor::PacketsChanged, this, index),
+                              MakeCallback(&QueueMonitor::BytesChanged, this, index)});
+    Entry& entry = m_entries.back();
+    entry.occupancy.SetPackets(Simulator::Now(), packets);
+    entry.occupancy.SetBytes(Simulator::Now(), bytes);
+    object->TraceConnectWithoutContext("PacketsInQueue", entry.packetsSink);
+    object->TraceConnectWithoutContext("BytesInQueue", entry.bytesSink);
+    if (queueDisc)
+    {
+        AddClasses(index);
+    }
+}
+
+void
+QueueMonitor::AddClasses(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    // the entries may be reallocated by the additions
+    Ptr<QueueDisc> queueDisc = m_entries[index].queueDisc;
+    std::string name = m_entries[index].name;
+    for (std::size_t k = m_entries[index].nClasses; k < queueDisc->GetNQueueDiscClasses(); k++)
+    {
+        m_entries[index].nClasses = k + 1;
+        Ptr<QueueDisc> child = queueDisc->GetQueueDiscClass(k)->GetQueueDisc();
+        if (child)
+        {
+            std::ostringstream oss;
+            oss << name << "/QueueDiscClassList/" << k << "/QueueDisc";
+            AddQueueDisc(oss.str(), child);
+        }
+    }
+}
+
+void
+QueueMonitor::AddQueue(const std::string& name, Ptr<QueueBase> queue)
+{
+    NS_LOG_FUNCTION(this << name << queue);
+    Add(name, queue, nullptr, queue->GetNPackets(), queue->GetNBytes());
+}
+
+void
+QueueMonitor::AddQueueDisc(const std::string& name, Ptr<QueueDisc> queueDisc)
+{
+    NS_LOG_FUNCTION(this << name << queueDisc);
+    Add(name, queueDisc, queueDisc, queueDisc->GetNPackets(), queueDisc->GetNBytes());
+}
+
+void
+QueueMonitor::AddNetDevice(const std::string& name, Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << name << device);
+    for (const std::string attribute : {"TxQueue", "RxQueue"})
+    {
+        PointerValue queue;
+        if (device->GetAttributeFailSafe(attribute, queue) && queue.Get<QueueBase>())
+        {
+            AddQueue(name + "/" + attribute, queue.Get<QueueBase>());
+        }
+    }
+    Ptr<Node> node = device->GetNode();
+    Ptr<TrafficControlLayer> tc = node ? node->GetObject<TrafficControlLayer>() : nullptr;
+    if (tc && tc->GetRootQueueDiscOnDevice(device))
+    {
+        AddQueueDisc(name + "/RootQueueDisc", tc->GetRootQueueDiscOnDevice(device));
+    }
+}
+
+void
+QueueMonitor::AddAll()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto i = NodeList::Begin(); i != NodeList::End(); ++i)
+    {
+        for (uint32_t j = 0; j < (*i)->GetNDevices(); j++)
+        {
+            std::ostringstream oss;
+            oss << "/NodeList/" << (*i)->GetId() << "/DeviceList/" << j;
+            AddNetDevice(oss.str(), (*i)->GetDevice(j));
+        }
+    }
+}
+
+void
+QueueMonitor::PacketsChanged(uint32_t index, uint32_t oldValue, uint32_t newValue)
+{
+    Entry& entry = m_entries[index];
+    entry.occupancy.SetPackets(Simulator::Now(), newValue);
+    if (entry.queueDisc && entry.queueDisc->GetNQueueDiscClasses() != entry.nClasses)
+    {
+        AddClasses(index);
+    }
+}
+
+void
+QueueMonitor::BytesChanged(uint32_t index, uint32_t oldValue, uint32_t newValue)
+{
+    m_entries[index].occupancy.SetBytes(Simulator::Now(), newValue);
+}
+
+void
+QueueMonitor::Advance()
+{
+    for (auto& entry : m_entries)
+    {
+        entry.occupancy.Advance(Simulator::Now());
+    }
+}
+
+uint32_t
+QueueMonitor::GetNQueues() const
+{
+    return m_entries.size();
+}
+
+std::string
+QueueMonitor::GetName(uint32_t i) const
+{
+    return m_entries.at(i).name;
+}
+
+const QueueOccupancy&
+QueueMonitor::GetOccupancy(uint32_t i)
+{
+    m_entries.at(i).occupancy.Advance(Simulator::Now());
+    return m_entries[i].occupancy;
+}
+
+void
+QueueMonitor::WriteSummary(std::ostream& os)
+{
+    Advance();
+    os << "queue,seconds,mean_packets,max_packets,p99_packets,mean_bytes,max_bytes,p99_bytes"
+       << std::endl;
+    for (const auto& entry : m_entries)
+    {
+        const QueueOccupancy& occupancy = entry.occupancy;
+        os << entry.name << "," << occupancy.GetDuration().GetSeconds() << ","
+           << occupancy.GetMeanPackets() << "," << occupancy.GetMaxPackets() << ","
+           << occupancy.GetPacketsQuantile(0.99) << "," << occupancy.GetMeanBytes() << ","
+           << occupancy.GetMaxBytes() << "," << occupancy.GetBytesQuantile(0.99) << std::endl;
+    }
+}
+
+void
+QueueMonitor::WriteCcdf(std::ostream& os)
+{
+    Advance();
+    os << "queue,unit,level,ccdf" << std::endl;
+    for (const auto& entry : m_entries)
+    {
+        const QueueOccupancy& occupancy = entry.occupancy;
+        std::vector<double> ccdf = occupancy.GetPacketsCcdf();
+        for (std::size_t k = 0; k < ccdf.size(); k++)
+        {
+            os << entry.name << ",packets," << k << "," << ccdf[k] << std::endl;
+        }
+        ccdf = occupancy.GetBytesCcdf();
+        for (std::size_t k = 0; k < ccdf.size(); k++)
+        {
+            os << entry.name << ",bytes," << k * occupancy.GetByteBinWidth() << "," << ccdf[k]
+               << std::endl;
+        }
+    }
+}
+
+void
+QueueMonitor::WriteSeries(std::ostream& os)
+{
+    Advance();
+    os << "queue,start_s,mean_packets,max_packets,mean_bytes,max_bytes" << std::endl;
+    for (const auto& entry : m_entries)
+    {
+        for (const auto& sample : entry.occupancy.GetSeries())
+        {
+            os << entry.name << "," << sample.start.GetSeconds() << "," << sample.meanPackets
+               << "," << sample.maxPackets << "," << sample.meanBytes << "," << sample.maxBytes
+               << std::endl;
+        }
+    }
+}
+
+void
+QueueMonitor::WriteFiles(const std::string& prefix)
+{
+    NS_LOG_FUNCTION(this << prefix);
+    std::ofstream summary(prefix + "-summary.csv");
+    NS_ABORT_MSG_UNLESS(summary.is_open(), "Cannot open " << prefix << "-summary.csv");
+    WriteSummary(summary);
+    std::ofstream ccdf(prefix + "-ccdf.csv");
+    NS_ABORT_MSG_UNLESS(ccdf.is_open(), "Cannot open " << prefix << "-ccdf.csv");
+    WriteCcdf(ccdf);
+    if (m_interval.IsStrictlyPositive())
+    {
+        std::ofstream series(prefix + "-series.csv");
+        NS_ABORT_MSG_UNLESS(series.is_open(), "Cannot open " << prefix << "-series.csv");
+        WriteSeries(series);
+    }
+}
+
+} // namespace ns3
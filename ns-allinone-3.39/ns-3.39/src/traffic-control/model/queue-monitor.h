@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef QUEUE_MONITOR_H
+#define QUEUE_MONITOR_H
+
+#include "ns3/callback.h"
+#include "ns3/core-config.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class NetDevice;
+class QueueBase;
+class QueueDisc;
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Time-weighted occupancy of a queue, updated at every change
+ *
+ * The occupancy in packets and bytes is integrated over time in time steps,
+ * so the means are exact, without sampling.  The time spent with every
+ * number of packets, and with every bin of ByteBinWidth bytes, gives the
+ * CCDF of the occupancy.  With a positive interval, the mean and maximum
+ * occupancy of every complete interval are kept as a downsampled series.
+ * Every change costs O(1), plus one sample per interval boundary crossed.
+ *
+ * The integrals are kept in 128 bits, as the bytes times the time steps
+ * exceed 64 bits within seconds at picosecond resolution (5 MB for 4 s):
+ * native integers where the compiler has them, as for int64x64_t, otherwise
+ * two 64-bit words.  The time spent in every level never exceeds the
+ * duration, which is a Time.
+ */
+class QueueOccupancy
+{
+  public:
+    /// Occupancy during an interval of the downsampled series
+    struct Sample
+    {
+        Time start;          //!< Start of the interval
+        double meanPackets;  //!< Time-weighted mean packets
+        double meanBytes;    //!< Time-weighted mean bytes
+        uint32_t maxPackets; //!< Maximum packets
+        uint32_t maxBytes;   //!< Maximum bytes
+    };
+
+    /**
+     * Constructor.
+     * \param start the time the monitoring starts
+     * \param byteBinWidth the width of the bins of the bytes CCDF
+     * \param interval the interval of the series, or zero for no series
+     */
+    QueueOccupancy(Time start, uint32_t byteBinWidth, Time interval);
+
+    /**
+     * Set the packets in the queue.
+     * \param now the current time
+     * \param packets the packets
+     */
+    void SetPackets(Time now, uint32_t packets);
+
+    /**
+     * Set the bytes in the queue.
+     * \param now the current time
+     * \param bytes the bytes
+     */
+    void SetBytes(Time now, uint32_t bytes);
+
+    /**
+     * Account the current occupancy up to a time.
+     * \param now the current time
+     */
+    void Advance(Time now);
+
+    /// \return the time monitored, up to the last change or Advance
+    Time GetDuration() const;
+    /// \return the packets in the queue
+    uint32_t GetPackets() const;
+    /// \return the bytes in the queue
+    uint32_t GetBytes() const;
+    /// \return the time-weighted mean packets
+    double GetMeanPackets() const;
+    /// \return the time-weighted mean bytes
+    double GetMeanBytes() const;
+    /// \return the maximum packets
+    uint32_t GetMaxPackets() const;
+    /// \return the maximum bytes
+    uint32_t GetMaxBytes() const;
+    /// \return the width of the bins of the bytes CCDF
+    uint32_t GetByteBinWidth() const;
+
+    /**
+     * \return the CCDF of the packets: element k is the fraction of time
+     *         with at least k packets
+     */
+    std::vector<double> GetPacketsCcdf() const;
+
+    /**
+     * \return the CCDF of the bytes: element k is the fraction of time with
+     *         at least k times ByteBinWidth bytes
+     */
+    std::vector<double> GetBytesCcdf() const;
+
+    /**
+     * \param quantile the quantile, in (0, 1]
+     * \return the least packets not exceeded for the given fraction of time
+     */
+    uint32_t GetPacketsQuantile(double quantile) const;
+
+    /**
+     * \param quantile the quantile, in (0, 1]
+     * \return the least multiple of ByteBinWidth bytes not exceeded for the
+     *         given fraction of time
+     */
+    uint64_t GetBytesQuantile(double quantile) const;
+
+    /// \return the complete intervals of the downsampled series
+    const std::vector<Sample>& GetSeries() const;
+
+  private:
+#if defined(HAVE_UINT128_T)
+    typedef uint128_t Integral; //!< Integral of an occupancy, in time steps
+#elif defined(HAVE___UINT128_T)
+    typedef __uint128_t Integral; //!< Integral of an occupancy, in time steps
+#else
+    /// Integral of an occupancy, in time steps, in two 64-bit words
+    struct Integral
+    {
+        uint64_t high; //!< High word
+        uint64_t low;  //!< Low word
+    };
+#endif
+
+    /**
+     * Add an occupancy held for some time steps to an integral.
+     * \param integral the integral
+     * \param level the packets or bytes
+     * \param steps the time steps
+     */
+    static void Integrate(Integral& integral, uint32_t level, uint64_t steps);
+
+    /**
+     * Divide an integral by a number of time steps.
+     * \param integral the integral
+     * \param steps the time steps
+     * eturn the time-weighted mean
+     */
+    static double Divide(const Integral& integral, double steps);
+
+    /**
+     * Account the current occupancy from the last change to a time within
+     * the current interval of the series.
+     * \param now the time
+     */
+    void Account(Time now);
+
+    /**
+     * Compute a CCDF from the time spent in every level.
+     * \param levels the time in every level
+     * \return the CCDF
+     */
+    std::vector<double> GetCcdf(const std::vector<uint64_t>& levels) const;
+
+    /**
+     * Compute a quantile from the time spent in every level.
+     * \param levels the time in every level
+     * \param quantile the quantile
+     * \return the least level not exceeded for the given fraction of time
+     */
+    std::size_t GetQuantile(const std::vector<uint64_t>& levels, double quantile) const;
+
+    Time m_start;                            //!< Start of the monitoring
+    Time m_last;                             //!< Time the occupancy was last accounted
+    uint32_t m_packets;                      //!< Packets in the queue
+    uint32_t m_bytes;                        //!< Bytes in the queue
+    uint32_t m_maxPackets;                   //!< Maximum packets
+    uint32_t m_maxBytes;                     //!< Maximum bytes
+    Integral m_packetSteps;                  //!< Integral of the packets, in time steps
+    Integral m_byteSteps;                    //!< Integral of the bytes, in time steps
+    uint32_t m_byteBinWidth;                 //!< Width of the bins of the bytes CCDF
+    std::vector<uint64_t> m_packetLevels;    //!< Time steps with every number of packets
+    std::vector<uint64_t> m_byteLevels;      //!< Time steps in every bin of bytes
+
+    Time m_interval;                         //!< Interval of the series, or zero
+    Time m_intervalStart;                    //!< Start of the current interval
+    Integral m_intervalPacketSteps;          //!< Integral of the packets in the current interval
+    Integral m_intervalByteSteps;            //!< Integral of the bytes in the current interval
+    uint32_t m_intervalMaxPackets;           //!< Maximum packets in the current interval
+    uint32_t m_intervalMaxBytes;             //!< Maximum bytes in the current interval
+    std::vector<Sample> m_series;            //!< Complete intervals
+};
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Monitor the occupancy of device queues and queue discs
+ *
+ * A QueueOccupancy is kept for every monitored queue, updated by the
+ * PacketsInQueue and BytesInQueue traces of the queue, that is, at every
+ * enqueue and dequeue.  For a queue disc, the queue discs of its classes
+ * are monitored as well, including the classes added later, as WdrrQueueDisc
+ * and WfqQueueDisc do at the first packet of a flow.  The queues are named
+ * by their configuration paths, e.g., "/NodeList/3/DeviceList/1/TxQueue",
+ * ".../RxQueue" for the reception (switching) queue of a
+ * PointToPointNetDevice, ".../RootQueueDisc" and
+ * ".../RootQueueDisc/QueueDiscClassList/0/QueueDisc".
+ *
+ * The results, accounted up to the current time, are written as CSV: a
+ * summary (mean, maximum and 99th percentile of packets and bytes), the
+ * CCDFs and, with an Interval, the downsampled series.
+ */
+class QueueMonitor : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    QueueMonitor();
+    ~QueueMonitor() override;
+
+    /**
+     * Monitor a queue.
+     * \param name the name of the queue
+     * \param queue the queue
+     */
+    void AddQueue(const std::string& name, Ptr<QueueBase> queue);
+
+    /**
+     * Monitor a queue disc and the queue discs of its classes.
+     * \param name the name of the queue disc
+     * \param queueDisc the queue disc
+     */
+    void AddQueueDisc(const std::string& name, Ptr<QueueDisc> queueDisc);
+
+    /**
+     * Monitor the queues of a device: its TxQueue and RxQueue, if it has
+     * these attributes, and its root queue disc, if any.
+     * \param name the name of the device
+     * \param device the device
+     */
+    void AddNetDevice(const std::string& name, Ptr<NetDevice> device);
+
+    /// Monitor the queues of all the devices of all the nodes
+    void AddAll();
+
+    /// \return the number of monitored queues
+    uint32_t GetNQueues() const;
+
+    /**
+     * \param i the index of the queue
+     * \return the name of the queue
+     */
+    std::string GetName(uint32_t i) const;
+
+    /**
+     * \param i the index of the queue
+     * \return the occupancy of the queue, accounted up to now
+     */
+    const QueueOccupancy& GetOccupancy(uint32_t i);
+
+    /**
+     * Write a CSV line per queue with the duration and the mean, maximum and
+     * 99th percentile of the packets and bytes.
+     * \param os the output stream
+     */
+    void WriteSummary(std::ostream& os);
+
+    /**
+     * Write a CSV line per queue, unit (packets or bytes) and level with the
+     * fraction of time with at least that occupancy.
+     * \param os the output stream
+     */
+    void WriteCcdf(std::ostream& os);
+
+    /**
+     * Write a CSV line per queue and complete interval of the series.
+     * \param os the output stream
+     */
+    void WriteSeries(std::ostream& os);
+
+    /**
+     * Write the summary, the CCDFs and, with an Interval, the series, to
+     * the files with the given prefix and the suffixes "-summary.csv",
+     * "-ccdf.csv" and "-series.csv".
+     * \param prefix the prefix of the files
+     */
+    void WriteFiles(const std::string& prefix);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * Start monitoring an object with the PacketsInQueue and BytesInQueue traces.
+     * \param name the name of the queue
+     * \param object the queue or queue disc
+     * \param queueDisc the queue disc, or null for a queue
+     * \param packets the packets in the queue
+     * \param bytes the bytes in the queue
+     */
+    void Add(const std::string& name,
+             Ptr<Object> object,
+             Ptr<QueueDisc> queueDisc,
+             uint32_t packets,
+             uint32_t bytes);
+
+    /**
+     * Monitor the classes of a queue disc not monitored yet.
+     * \param index the index of the queue disc
+     */
+    void AddClasses(uint32_t index);
+
+    /**
+     * The packets in a queue changed.
+     * \param index the index of the queue
+     * \param oldValue the previous packets
+     * \param newValue the packets
+     */
+    void PacketsChanged(uint32_t index, uint32_t oldValue, uint32_t newValue);
+
+    /**
+     * The bytes in a queue changed.
+     * \param index the index of the queue
+     * \param oldValue the previous bytes
+     * \param newValue the bytes
+     */
+    void BytesChanged(uint32_t index, uint32_t oldValue, uint32_t newValue);
+
+    /// Account the occupancy of all the queues up to now
+    void Advance();
+
+    /// A monitored queue
+    struct Entry
+    {
+        std::string name;                               //!< Name of the queue
+        Ptr<Object> object;                             //!< Queue or queue disc
+        Ptr<QueueDisc> queueDisc;                       //!< Queue disc, or null
+        std::size_t nClasses;                           //!< Classes monitored
+        QueueOccupancy occupancy;                       //!< Occupancy
+        Callback<void, uint32_t, uint32_t> packetsSink; //!< PacketsInQueue callback
+        Callback<void, uint32_t, uint32_t> bytesSink;   //!< BytesInQueue callback
+    };
+
+    Time m_interval;              //!< Interval of the series
+    uint32_t m_byteBinWidth;      //!< Width of the bins of the bytes CCDF
+    std::vector<Entry> m_entries; //!< Monitored queues
+};
+
+} // namespace ns3
+
+#endif /* QUEUE_MONITOR_H */
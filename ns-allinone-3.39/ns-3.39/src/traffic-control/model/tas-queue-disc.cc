@@ -0,0 +1,542 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "tas-queue-disc.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/object-factory.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TasQueueDisc");
+
+NS_OBJECT_ENSURE_REGISTERED(TasQueueDisc);
+
+TypeId
+TasQueueDisc::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TasQueueDisc")
+            .SetParent<QueueDisc>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<TasQueueDisc>()
+            .AddAttribute("GateControlList",
+                          "The gate control list, as \"<gate states> <duration>\" entries "
+                          "separated by semicolons (bit i of the gate states for class i)",
+                          StringValue(""),
+                          MakeStringAccessor(&TasQueueDisc::SetGateControlList,
+                                             &TasQueueDisc::GetGateControlList),
+                          MakeStringChecker())
+            .AddAttribute("BaseTime",
+                          "The start of the first cycle of the gate control list",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&TasQueueDisc::m_baseTime),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("LinkRate",
+                          "The rate of the link, to enforce the guard bands (zero disables them)",
+                          DataRateValue(DataRate(0)),
+                          MakeDataRateAccessor(&TasQueueDisc::m_linkRate),
+                          MakeDataRateChecker())
+            .AddAttribute("Overhead",
+                          "The bytes added to the packets by the device (the PPP header of a "
+                          "PointToPointNetDevice by default)",
+                          UintegerValue(2),
+                          MakeUintegerAccessor(&TasQueueDisc::m_overhead),
+                          MakeUintegerChecker<uint32_t>())
+            .AddTraceSource("Latency",
+                            "The sojourn time and gate-induced latency of a dequeued packet",
+                            MakeTraceSourceAccessor(&TasQueueDisc::m_latencyTrace),
+                            "ns3::TasQueueDisc::LatencyTracedCallback");
+    return tid;
+}
+
+TasQueueDisc::TasQueueDisc()
+    : QueueDisc(QueueDiscSizePolicy::NO_LIMITS),
+      m_base(0),
+      m_cycle(0),
+      m_txEnd(0),
+      m_nGateEvents(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TasQueueDisc::~TasQueueDisc()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TasQueueDisc::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_gateEvent.Cancel();
+    m_held.clear();
+    QueueDisc::DoDispose();
+}
+
+void
+TasQueueDisc::AddGateControlEntry(uint8_t gateStates, Time duration)
+{
+    NS_LOG_FUNCTION(this << +gateStates << duration);
+    NS_ABORT_MSG_UNLESS(duration.IsStrictlyPositive(),
+                        "The entries of the gate control list must last");
+    m_gcl.push_back(GateControlEntry{gateStates, duration});
+    if (IsInitialized())
+    {
+        Precompute();
+    }
+}
+
+void
+TasQueueDisc::SetGateControlList(std::string gcl)
+{
+    NS_LOG_FUNCTION(this << gcl);
+    m_gcl.clear();
+    std::istringstream entries(gcl);
+    std::string entry;
+    while (std::getline(entries, entry, ';'))
+    {
+        std::istringstream fields(entry);
+        std::string gates;
+        std::string duration;
+        if (!(fields >> gates))
+        {
+            continue;
+        }
+        NS_ABORT_MSG_UNLESS(fields >> duration, "Missing duration in GCL entry \"" << entry << "\"");
+        AddGateControlEntry(static_cast<uint8_t>(std::stoul(gates, nullptr, 0)), Time(duration));
+    }
+    if (IsInitialized())
+    {
+        Precompute();
+    }
+}
+
+std::string
+TasQueueDisc::GetGateControlList() const
+{
+    std::ostringstream gcl;
+    for (std::size_t k = 0; k < m_gcl.size(); k++)
+    {
+        gcl << (k ? "; " : "") << "0x" << std::hex << +m_gcl[k].gateStates << std::dec << " "
+            << m_gcl[k].duration.GetPicoSeconds() << "ps";
+    }
+    return gcl.str();
+}
+
+Time
+TasQueueDisc::GetCycleTime() const
+{
+    Time cycle;
+    for (const auto& entry : m_gcl)
+    {
+        cycle += entry.duration;
+    }
+    return cycle;
+}
+
+bool
+TasQueueDisc::IsGateOpen(uint32_t cls) const
+{
+    int64_t now = Simulator::Now().GetTimeStep();
+    return GetNextOpen(cls, now) == now;
+}
+
+const TasClassStats&
+TasQueueDisc::GetClassStats(uint32_t cls) const
+{
+    return m_stats.at(cls);
+}
+
+uint64_t
+TasQueueDisc::GetNGateEvents() const
+{
+    return m_nGateEvents;
+}
+
+void
+TasQueueDisc::Precompute()
+{
+    NS_LOG_FUNCTION(this);
+    std::size_t n = m_gcl.size();
+    uint32_t nClasses = GetNQueueDiscClasses();
+    m_base = m_baseTime.GetTimeStep();
+    m_cycle = 0;
+    m_start.clear();
+    for (const auto& entry : m_gcl)
+    {
+        m_start.push_back(m_cycle);
+        m_cycle += entry.duration.GetTimeStep();
+    }
+    m_openBefore.assign(nClasses * n, 0);
+    m_closeAfter.assign(nClasses * n, 0);
+    m_openAfter.assign(nClasses * n, 0);
+    m_openPerCycle.assign(nClasses, 0);
+    m_maxWindow.assign(nClasses, NEVER);
+
+    for (uint32_t c = 0; c < nClasses; c++)
+    {
+        auto open = [this, c](std::size_t k) { return (m_gcl[k].gateStates >> c) & 1; };
+        auto duration = [this](std::size_t k) { return m_gcl[k].duration.GetTimeStep(); };
+        int64_t* openBefore = m_openBefore.data() + c * n;
+        int64_t* closeAfter = m_closeAfter.data() + c * n;
+        int64_t* openAfter = m_openAfter.data() + c * n;
+
+        for (std::size_t k = 0; k < n; k++)
+        {
+            openBefore[k] = m_openPerCycle[c];
+            m_openPerCycle[c] += open(k) ? duration(k) : 0;
+        }
+        if (n == 0 || m_openPerCycle[c] == m_cycle)
+        {
+            std::fill(closeAfter, closeAfter + n, NEVER);
+            continue;
+        }
+        if (m_openPerCycle[c] == 0)
+        {
+            std::fill(openAfter, openAfter + n, NEVER);
+            m_maxWindow[c] = 0;
+            continue;
+        }
+
+        // walk the cycle backwards from an entry with the gate closed (open)
+        // to accumulate the time to the closing (opening) of the gate
+        std::size_t closed = 0;
+        while (open(closed))
+        {
+            closed++;
+        }
+        for (std::size_t i = 1; i < n; i++)
+        {
+            std::size_t k = (closed + n - i) % n;
+            closeAfter[k] = open(k) ? duration(k) + closeAfter[(k + 1) % n] : 0;
+        }
+        std::size_t opened = 0;
+        while (!open(opened))
+        {
+            opened++;
+        }
+        for (std::size_t i = 1; i < n; i++)
+        {
+            std::size_t k = (opened + n - i) % n;
+            openAfter[k] = open(k) ? 0 : duration(k) + openAfter[(k + 1) % n];
+        }
+        m_maxWindow[c] = 0;
+        for (std::size_t k = 0; k < n; k++)
+        {
+            if (open(k) && !open((k + n - 1) % n))
+            {
+                m_maxWindow[c] = std::max(m_maxWindow[c], closeAfter[k]);
+            }
+        }
+    }
+}
+
+uint32_t
+TasQueueDisc::GetClass(Ptr<QueueDiscItem> item)
+{
+    NS_LOG_FUNCTION(this << item);
+    uint32_t nClasses = GetNQueueDiscClasses();
+    int32_t ret = Classify(item);
+    if (ret != PacketFilter::PF_NO_MATCH)
+    {
+        if (ret >= 0 && static_cast<uint32_t>(ret) < nClasses)
+        {
+            return ret;
+        }
+        NS_LOG_DEBUG("Class " << ret << " out of range, using the lowest priority class");
+        return nClasses - 1;
+    }
+
+    uint8_t priority = 0;
+    uint8_t tos;
+    SocketPriorityTag priorityTag;
+    if (item->GetUint8Value(QueueItem::IP_DSFIELD, tos))
+    {
+        priority = tos >> 5;
+    }
+    else if (item->GetPacket()->PeekPacketTag(priorityTag))
+    {
+        priority = priorityTag.GetPriority() & 0x07;
+    }
+    return (7 - priority) * nClasses / 8;
+}
+
+int64_t
+TasQueueDisc::GetTxTime(Ptr<const QueueDiscItem> item) const
+{
+    return m_linkRate.CalculateBytesTxTime(item->GetSize() + m_overhead).GetTimeStep();
+}
+
+std::size_t
+TasQueueDisc::GetEntry(int64_t t) const
+{
+    int64_t offset = (t - m_base) % m_cycle;
+    return std::upper_bound(m_start.begin(), m_start.end(), offset) - m_start.begin() - 1;
+}
+
+int64_t
+TasQueueDisc::GetNextOpen(uint32_t cls, int64_t t) const
+{
+    if (m_gcl.empty() || t < m_base)
+    {
+        return t;
+    }
+    std::size_t n = m_gcl.size();
+    std::size_t k = GetEntry(t);
+    int64_t openAfter = m_openAfter[cls * n + k];
+    if (openAfter == 0 || openAfter == NEVER)
+    {
+        return openAfter == 0 ? t : NEVER;
+    }
+    return t - ((t - m_base) % m_cycle - m_start[k]) + openAfter;
+}
+
+int64_t
+TasQueueDisc::GetNextClose(uint32_t cls, int64_t t) const
+{
+    if (m_gcl.empty())
+    {
+        return NEVER;
+    }
+    std::size_t n = m_gcl.size();
+    int64_t closeAfter;
+    int64_t entryStart;
+    if (t < m_base)
+    {
+        closeAfter = m_closeAfter[cls * n];
+        entryStart = m_base;
+    }
+    else
+    {
+        std::size_t k = GetEntry(t);
+        closeAfter = m_closeAfter[cls * n + k];
+        entryStart = t - ((t - m_base) % m_cycle - m_start[k]);
+    }
+    return closeAfter == NEVER ? NEVER : entryStart + closeAfter;
+}
+
+int64_t
+TasQueueDisc::GetOpenTime(uint32_t cls, int64_t t) const
+{
+    if (m_gcl.empty() || t < m_base)
+    {
+        return t - m_base;
+    }
+    std::size_t n = m_gcl.size();
+    std::size_t k = GetEntry(t);
+    int64_t offset = (t - m_base) % m_cycle;
+    int64_t open = (t - m_base) / m_cycle * m_openPerCycle[cls] + m_openBefore[cls * n + k];
+    if ((m_gcl[k].gateStates >> cls) & 1)
+    {
+        open += offset - m_start[k];
+    }
+    return open;
+}
+
+int32_t
+TasQueueDisc::SelectClass(int64_t now, int64_t& next, bool countHolds)
+{
+    NS_LOG_FUNCTION(this << now << countHolds);
+    next = NEVER;
+    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
+    {
+        Ptr<QueueDisc> qd = GetQueueDiscClass(i)->GetQueueDisc();
+        if (qd->GetNPackets() == 0)
+        {
+            continue;
+        }
+        int64_t open = GetNextOpen(i, now);
+        if (open != now)
+        {
+            NS_LOG_LOGIC("Gate " << i << " closed until " << open);
+            next = std::min(next, open);
+            continue;
+        }
+        if (m_linkRate.GetBitRate() > 0)
+        {
+            int64_t close = GetNextClose(i, now);
+            Ptr<const QueueDiscItem> head = qd->Peek();
+            if (close != NEVER && now + GetTxTime(head) > close)
+            {
+                NS_LOG_LOGIC("Packet of class " << i << " held by the guard band");
+                if (countHolds && m_held[i] != head)
+                {
+                    m_held[i] = head;
+                    m_stats[i].nGuardBandHolds++;
+                }
+                next = std::min(next, GetNextOpen(i, close));
+                continue;
+            }
+        }
+        return i;
+    }
+    return -1;
+}
+
+void
+TasQueueDisc::ScheduleGateEvent(int64_t t)
+{
+    NS_LOG_FUNCTION(this << t);
+    if (m_gateEvent.IsRunning())
+    {
+        if (static_cast<int64_t>(m_gateEvent.GetTs()) <= t)
+        {
+            return;
+        }
+        m_gateEvent.Cancel();
+    }
+    m_gateEvent = Simulator::Schedule(TimeStep(t - Simulator::Now().GetTimeStep()),
+                                      &QueueDisc::Run,
+                                      this);
+    m_nGateEvents++;
+}
+
+bool
+TasQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
+{
+    NS_LOG_FUNCTION(this << item);
+    uint32_t cls = GetClass(item);
+    if (m_linkRate.GetBitRate() > 0 && m_maxWindow[cls] != NEVER &&
+        GetTxTime(item) > m_maxWindow[cls])
+    {
+        NS_LOG_LOGIC("Packet of class " << cls << " longer than the windows of its gate");
+        DropBeforeEnqueue(item, OVERSIZE_DROP);
+        return false;
+    }
+    bool retval = GetQueueDiscClass(cls)->GetQueueDisc()->Enqueue(item);
+    // If Queue::Enqueue fails, QueueDisc::Drop is called by the child queue disc
+    // because QueueDisc::AddQueueDiscClass sets the drop callback
+    NS_LOG_LOGIC("Number packets class " << cls << ": "
+                                         << GetQueueDiscClass(cls)->GetQueueDisc()->GetNPackets());
+    return retval;
+}
+
+Ptr<QueueDiscItem>
+TasQueueDisc::DoDequeue()
+{
+    NS_LOG_FUNCTION(this);
+    int64_t now = Simulator::Now().GetTimeStep();
+    // the selection happens when the link is free
+    int64_t start = std::max(now, m_txEnd);
+    int64_t next;
+    int32_t cls = SelectClass(start, next, true);
+    if (cls < 0 || start > now)
+    {
+        if (cls >= 0)
+        {
+            next = start;
+        }
+        if (next != NEVER)
+        {
+            ScheduleGateEvent(next);
+        }
+        NS_LOG_LOGIC("No gate open for the waiting packets");
+        return nullptr;
+    }
+
+    Ptr<QueueDiscItem> item = GetQueueDiscClass(cls)->GetQueueDisc()->Dequeue();
+    if (m_linkRate.GetBitRate() > 0)
+    {
+        m_txEnd = now + GetTxTime(item);
+    }
+    int64_t arrival = item->GetTimeStamp().GetTimeStep();
+    Time sojourn = TimeStep(now - arrival);
+    Time gateDelay =
+        TimeStep((now - arrival) - (GetOpenTime(cls, now) - GetOpenTime(cls, arrival)));
+    TasClassStats& stats = m_stats[cls];
+    stats.nPackets++;
+    stats.totalSojourn += sojourn;
+    stats.maxSojourn = std::max(stats.maxSojourn, sojourn);
+    stats.totalGateDelay += gateDelay;
+    stats.maxGateDelay = std::max(stats.maxGateDelay, gateDelay);
+    m_latencyTrace(cls, sojourn, gateDelay);
+    NS_LOG_LOGIC("Dequeued from class " << cls << " after " << sojourn.As(Time::US) << ", "
+                                        << gateDelay.As(Time::US) << " with the gate closed");
+    return item;
+}
+
+Ptr<const QueueDiscItem>
+TasQueueDisc::DoPeek()
+{
+    NS_LOG_FUNCTION(this);
+    int64_t now = Simulator::Now().GetTimeStep();
+    int64_t next;
+    int32_t cls = SelectClass(now, next, false);
+    if (cls < 0 || m_txEnd > now)
+    {
+        return nullptr;
+    }
+    return GetQueueDiscClass(cls)->GetQueueDisc()->Peek();
+}
+
+bool
+TasQueueDisc::CheckConfig()
+{
+    NS_LOG_FUNCTION(this);
+    if (GetNInternalQueues() > 0)
+    {
+        NS_LOG_ERROR("TasQueueDisc cannot have internal queues");
+        return false;
+    }
+
+    if (GetNQueueDiscClasses() == 0)
+    {
+        // create 3 fifo queue discs
+        ObjectFactory factory;
+        factory.SetTypeId("ns3::FifoQueueDisc");
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            Ptr<QueueDisc> qd = factory.Create<QueueDisc>();
+            qd->Initialize();
+            Ptr<QueueDiscClass> c = CreateObject<QueueDiscClass>();
+            c->SetQueueDisc(qd);
+            AddQueueDiscClass(c);
+        }
+    }
+
+    if (GetNQueueDiscClasses() > 8)
+    {
+        NS_LOG_ERROR("TasQueueDisc has at most 8 classes, one per gate");
+        return false;
+    }
+
+    return true;
+}
+
+void
+TasQueueDisc::InitializeParams()
+{
+    NS_LOG_FUNCTION(this);
+    m_stats.assign(GetNQueueDiscClasses(), TasClassStats());
+    m_held.assign(GetNQueueDiscClasses(), nullptr);
+    Precompute();
+}
+
+} // namespace ns3
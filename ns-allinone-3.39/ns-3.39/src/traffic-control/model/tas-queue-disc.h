@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef TAS_QUEUE_DISC_H
+#define TAS_QUEUE_DISC_H
+
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/queue-disc.h"
+#include "ns3/traced-callback.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Statistics of a class of a TasQueueDisc
+ */
+struct TasClassStats
+{
+    uint64_t nPackets{0};        //!< Packets dequeued
+    Time totalSojourn;           //!< Sum of the sojourn times of the dequeued packets
+    Time maxSojourn;             //!< Maximum sojourn time
+    Time totalGateDelay;         //!< Sum of the gate-induced latencies
+    Time maxGateDelay;           //!< Maximum gate-induced latency
+    uint64_t nGuardBandHolds{0}; //!< Times the head packet was held by the guard band
+};
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief An IEEE 802.1Qbv time-aware shaper (TAS)
+ *
+ * Every class has a gate, opened and closed by a cyclic gate control list
+ * (GCL): each entry of the list gives the state of the gates (bit i for
+ * class i, set if open) and how long it lasts.  The first cycle starts at
+ * BaseTime; before it all the gates are open, as they are without a GCL.
+ * The packets are transmitted in strict priority among the classes whose
+ * gate is open, the first class being the highest priority one.
+ *
+ * With a LinkRate, guard bands are enforced: a packet is only dequeued if
+ * its transmission (with Overhead bytes of framing) ends before its gate
+ * closes.  Packets that do not fit in the longest window of their gate are
+ * dropped at enqueue, as 802.1Qbv does with the frames larger than the
+ * queueMaxSDU.
+ *
+ * As the transmission selection of the hardware, only the gate events that
+ * matter are scheduled: when packets are waiting but none of them can be
+ * dequeued, a single event is scheduled at the earliest time one of them
+ * can, computed from the GCL in O(log n).  Nothing is scheduled while the
+ * queues are empty, whatever the length of the GCL.  The queue disc must be
+ * the root queue disc of the device.  With a LinkRate, it also keeps the end
+ * of the transmission of the last packet released and holds the next one
+ * until then, as the MAC does, so that the packets do not wait for their
+ * transmission in the device queue after the selection.
+ *
+ * Packets are classified by the packet filters (e.g., a PcpPacketFilter
+ * with as many bands as classes).  Otherwise, as the PcpPacketFilter does,
+ * the priority p of a packet gives the class (7 - p) * N / 8 out of N: the
+ * priority is the class selector of the DSCP (DSCP / 8) of IP packets, so
+ * that the marking of a MarkerQueueDisc is honoured, or the priority of the
+ * SocketPriorityTag.  Any queue disc can be the queue disc of a class, e.g.,
+ * a PrioQueueDscpDisc to keep the DSCP priorities within a gate.  By default
+ * three FIFO classes are created.
+ *
+ * For every class, the sojourn time and the gate-induced latency (the time
+ * the packet spent in the queue disc while its gate was closed) are traced
+ * and accumulated in TasClassStats.
+ */
+class TasQueueDisc : public QueueDisc
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TasQueueDisc();
+    ~TasQueueDisc() override;
+
+    /**
+     * \brief Append an entry to the gate control list.
+     * \param gateStates the state of the gates, bit i set if the gate of class i is open
+     * \param duration the duration of the entry
+     */
+    void AddGateControlEntry(uint8_t gateStates, Time duration);
+
+    /**
+     * \brief Set the gate control list.
+     *
+     * The entries are separated by semicolons, each with the gate states
+     * (decimal, or hexadecimal with the 0x prefix) and the duration, e.g.
+     * "0x01 100us; 0xfe 400us".  An empty string removes the list.
+     *
+     * \param gcl the gate control list
+     */
+    void SetGateControlList(std::string gcl);
+
+    /// \return the gate control list, in the format of SetGateControlList
+    std::string GetGateControlList() const;
+
+    /// \return the duration of a cycle of the gate control list (zero without a list)
+    Time GetCycleTime() const;
+
+    /**
+     * \param cls the class
+     * \return true if the gate of the class is open now
+     */
+    bool IsGateOpen(uint32_t cls) const;
+
+    /**
+     * \param cls the class
+     * \return the statistics of the class
+     */
+    const TasClassStats& GetClassStats(uint32_t cls) const;
+
+    /// \return the number of gate events scheduled
+    uint64_t GetNGateEvents() const;
+
+    /**
+     * TracedCallback signature for the latency of a dequeued packet.
+     *
+     * \param [in] cls the class of the packet
+     * \param [in] sojourn the time spent in the queue disc
+     * \param [in] gateDelay the time spent with the gate closed
+     */
+    typedef void (*LatencyTracedCallback)(uint32_t cls, Time sojourn, Time gateDelay);
+
+    // Reasons for dropping packets
+    static constexpr const char* OVERSIZE_DROP =
+        "Oversize drop"; //!< The packet does not fit in any window of its gate
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    bool DoEnqueue(Ptr<QueueDiscItem> item) override;
+    Ptr<QueueDiscItem> DoDequeue() override;
+    Ptr<const QueueDiscItem> DoPeek() override;
+    bool CheckConfig() override;
+    void InitializeParams() override;
+
+    /// An entry of the gate control list
+    struct GateControlEntry
+    {
+        uint8_t gateStates; //!< Bit i set if the gate of class i is open
+        Time duration;      //!< Duration of the entry
+    };
+
+    /// Value of the precomputed times of a gate that never closes or never opens
+    static constexpr int64_t NEVER = INT64_MAX;
+
+    /// Precompute the gate times from the GCL
+    void Precompute();
+
+    /**
+     * \param item the packet
+     * \return the class of the packet
+     */
+    uint32_t GetClass(Ptr<QueueDiscItem> item);
+
+    /**
+     * \param item the packet
+     * \return the transmission time of the packet in time steps
+     */
+    int64_t GetTxTime(Ptr<const QueueDiscItem> item) const;
+
+    /**
+     * \param t a time, in time steps
+     * \return the entry of the GCL active at time t (t not before the base time)
+     */
+    std::size_t GetEntry(int64_t t) const;
+
+    /**
+     * \param cls the class
+     * \param t a time, in time steps
+     * \return the first time from t the gate of the class is open, or NEVER
+     */
+    int64_t GetNextOpen(uint32_t cls, int64_t t) const;
+
+    /**
+     * \param cls the class
+     * \param t a time the gate of the class is open, in time steps
+     * \return the time the gate of the class closes, or NEVER
+     */
+    int64_t GetNextClose(uint32_t cls, int64_t t) const;
+
+    /**
+     * \param cls the class
+     * \param t a time, in time steps
+     * \return the time the gate of the class has been open since the base
+     *         time (negative before the base time, when the gates are open)
+     */
+    int64_t GetOpenTime(uint32_t cls, int64_t t) const;
+
+    /**
+     * \brief Select the class to dequeue from.
+     * \param now the current time, in time steps
+     * \param next set to the earliest time a class can be dequeued if none can now
+     * \param countHolds count the holds by the guard band in the statistics
+     * \return the class, or -1 if none can be dequeued now
+     */
+    int32_t SelectClass(int64_t now, int64_t& next, bool countHolds);
+
+    /**
+     * \brief Schedule the run of the queue disc at a gate event.
+     * \param t the time of the gate event, in time steps
+     */
+    void ScheduleGateEvent(int64_t t);
+
+    std::vector<GateControlEntry> m_gcl; //!< Gate control list
+    Time m_baseTime;                     //!< Start of the first cycle
+    DataRate m_linkRate;                 //!< Rate for the guard bands (zero disables them)
+    uint32_t m_overhead;                 //!< Framing bytes added to the packets by the device
+
+    // Precomputed from the GCL, in time steps (per class: index cls * nEntries + entry)
+    int64_t m_base;                      //!< Base time
+    int64_t m_cycle;                     //!< Cycle time
+    std::vector<int64_t> m_start;        //!< Start of the entries in the cycle
+    std::vector<int64_t> m_openBefore;   //!< Open time of a gate in the cycle before an entry
+    std::vector<int64_t> m_closeAfter;   //!< Time from the start of an entry to the gate closing
+    std::vector<int64_t> m_openAfter;    //!< Time from the start of an entry to the gate opening
+    std::vector<int64_t> m_openPerCycle; //!< Open time of a gate per cycle
+    std::vector<int64_t> m_maxWindow;    //!< Longest window of a gate
+
+    int64_t m_txEnd;                     //!< End of the last transmission (with a LinkRate)
+    EventId m_gateEvent;                 //!< Next gate event
+    uint64_t m_nGateEvents;              //!< Gate events scheduled
+    std::vector<TasClassStats> m_stats;  //!< Statistics per class
+    std::vector<Ptr<const QueueDiscItem>> m_held; //!< Last packet held by the guard band per class
+
+    /// Traced callback: latency of the dequeued packets
+    TracedCallback<uint32_t, Time, Time> m_latencyTrace;
+};
+
+} // namespace ns3
+
+#endif /* TAS_QUEUE_DISC_H */
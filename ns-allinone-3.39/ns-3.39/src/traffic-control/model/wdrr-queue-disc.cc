@@ -326,7 +326,6 @@ WdrrQueueDisc::DoDequeue()
                 NS_LOG_DEBUG("Found a new flow " << flow->GetIndex() << " with positive deficit");
                 found = true;
             }
-            Bufferlog << "New - Queue status: " <<flow->GetIndex() << " " << flow->GetQueueDisc()->GetNPackets()<<std::endl;
         }
 
         while (!found && !m_oldFlows.empty())
@@ -344,7 +343,6 @@ WdrrQueueDisc::DoDequeue()
                 NS_LOG_DEBUG("Found an old flow " << flow->GetIndex() << " with positive deficit");
                 found = true;
             }
-            Bufferlog << "Old - Queue status: "<<flow->GetIndex() << " " << flow->GetQueueDisc()->GetNPackets()<<std::endl;
         }
 
         if (!found)
@@ -376,7 +374,6 @@ WdrrQueueDisc::DoDequeue()
         }
     } while (!item);
 
-    Bufferlog << flow->GetIndex() << " " << item->GetSize() <<std::endl;
     flow->IncreaseDeficit(item->GetSize() * -1);
 
     return item;
@@ -485,7 +482,6 @@ WdrrQueueDisc::InitializeParams()
     m_flowFactory.SetTypeId("ns3::WdrrFlow");
     m_queueDiscFactory.SetTypeId("ns3::FifoQueueDisc");
     m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
-    Bufferlog.open("./sim_results/sched-wdrr-decision.log", std::fstream::out);
 }
 
 
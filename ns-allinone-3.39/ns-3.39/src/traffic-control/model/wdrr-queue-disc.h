@@ -32,7 +32,6 @@
 #include <vector>
 #include <array>
 #include <iostream>
-#include <fstream>
 
 namespace ns3
 {
@@ -182,7 +181,6 @@ class WdrrQueueDisc : public QueueDisc
      * \return the index of the queue for the given flow
      */
 
-    std::ofstream Bufferlog;
  
     uint32_t WdrrDrop();
    
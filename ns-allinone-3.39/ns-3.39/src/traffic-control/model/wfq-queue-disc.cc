@@ -20,6 +20,7 @@
 #include "ns3/wdrr-queue-disc.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 
 namespace ns3
@@ -249,7 +250,6 @@ WfqQueueDisc::DoDequeue()
     Ptr<WfqFlow> flow;
     Ptr<QueueDiscItem> item;
     Ptr<const QueueDiscItem> pkt;
-    double bw;
    
     Time minFinishTime = ns3::Time::Max();
     do
@@ -259,8 +259,13 @@ WfqQueueDisc::DoDequeue()
         for (auto &currentFlow : m_Flows) {
             if (currentFlow->GetQueueDisc()->GetNPackets() != 0) {
                 pkt = currentFlow->GetQueueDisc()->Peek();
-                bw = (double(currentFlow->GetDeficit()) / double(100)) * ((m_dataRate) * double(1e9 / 8));
-                Time finishTime = std::max(pkt->GetTimeStamp(),queue_tail_time[currentFlow->GetIndex()]) + Seconds((double(pkt->GetSize()) / bw));
+                // the flow gets its deficit (in %) of the rate (in Gb/s); a
+                // share that rounds to 0 bit/s gets 1 bit/s, as a null rate
+                // has no serialization time, so the flow is served last
+                double bps = std::round(currentFlow->GetDeficit() * m_dataRate * 1e7);
+                SerializationTime& txTime = m_flowTxTime[currentFlow->GetIndex()];
+                txTime.SetRate(DataRate(bps < 1 ? 1 : static_cast<uint64_t>(bps)));
+                Time finishTime = std::max(pkt->GetTimeStamp(),queue_tail_time[currentFlow->GetIndex()]) + txTime.GetBytesTxTime(pkt->GetSize());
                 // std::cout << "Checking flow: " << currentFlow->GetIndex() << " InitQueueArr " <<  pkt->GetTimeStamp() << "||"<< queue_tail_time[currentFlow->GetIndex()] << " " << " TxTime " << Seconds(((pkt->GetSize()) / bw)) << " finishTime: "<<finishTime <<std::endl;
                 if (finishTime < minFinishTime) {
                     minFinishTime = finishTime;
@@ -310,7 +315,6 @@ WfqQueueDisc::DoDequeue()
             // std::cout << "***Flow sent: " << flow->GetIndex() << " - Pkt Size: " << item->GetPacket()->GetSize() << std::endl;
         }
     } while (!item);
-    Bufferlog << flow->GetIndex() << " " << item->GetSize() <<std::endl;
    
 
     return item;
@@ -363,6 +367,7 @@ WfqQueueDisc::CheckConfig()
             }
         }    
         queue_tail_time.push_back(Time(0));
+        m_flowTxTime.emplace_back();
 
     }
 
@@ -425,7 +430,6 @@ WfqQueueDisc::InitializeParams()
     m_flowFactory.SetTypeId("ns3::WfqFlow");
     m_queueDiscFactory.SetTypeId("ns3::FifoQueueDisc");
     m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
-    Bufferlog.open("./sim_results/sched-wfq-decision.log", std::fstream::out);
 }
 
 
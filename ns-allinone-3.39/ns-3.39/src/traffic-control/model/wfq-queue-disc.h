@@ -23,6 +23,7 @@
 
 #include "ns3/object-factory.h"
 #include "ns3/queue-disc.h"
+#include "ns3/serialization-time.h"
 #include "ns3/vector.h"
 #include "ns3/attribute.h"
 #include "ns3/object-vector.h"
@@ -33,7 +34,6 @@
 #include <vector>
 #include <array>
 #include <iostream>
-#include <fstream>
 
 
 namespace ns3
@@ -184,7 +184,6 @@ class WfqQueueDisc : public QueueDisc
      * \return the index of the queue for the given flow
      */
 
-    std::ofstream Bufferlog;
     uint32_t WfqDrop();
    
     uint32_t m_flows;                //!< Number of flow queues
@@ -194,6 +193,7 @@ class WfqQueueDisc : public QueueDisc
     uint32_t m_dropBatchSize;        //!< Max number of packets dropped from the fat flow
     std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
     std::vector<Time> queue_tail_time;
+    std::vector<SerializationTime> m_flowTxTime; //!< Exact packet times at the rate of each flow
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
 
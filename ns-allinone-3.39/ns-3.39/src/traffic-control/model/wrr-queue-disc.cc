@@ -312,7 +312,6 @@ WrrQueueDisc::DoDequeue()
             NS_LOG_DEBUG("Dequeued packet " << item->GetPacket()->GetSize());
         }
     } while (!item);
-    // Bufferlog << flow->GetIndex() << " " << item->GetSize() <<std::endl;
     flow->IncreaseDeficit(-1);
 
     return item;
@@ -422,7 +421,6 @@ WrrQueueDisc::InitializeParams()
     m_queueDiscFactory.SetTypeId("ns3::FifoQueueDisc");
     // m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
     // m_queueDiscFactory.Set("MaxSize", QueueSizeValue(QueueSize("1p")));
-    Bufferlog.open("./sim_results/sched-wrr-decision.log", std::fstream::out);
 }
 
 
@@ -33,7 +33,6 @@
 #include <vector>
 #include <array>
 #include <iostream>
-#include <fstream>
 
 namespace ns3
 {
@@ -183,7 +182,6 @@ class WrrQueueDisc : public QueueDisc
      * \return the index of the queue for the given flow
      */
 
-    std::ofstream Bufferlog;
     uint32_t WrrDrop();
    
     uint32_t m_flows;                //!< Number of flow queues
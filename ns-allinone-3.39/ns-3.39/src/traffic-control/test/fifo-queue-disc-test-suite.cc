@@ -18,9 +18,11 @@
  *
  */
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/fifo-queue-disc.h"
 #include "ns3/log.h"
+#include "ns3/net-device-queue-interface.h"
 #include "ns3/object-factory.h"
 #include "ns3/packet.h"
 #include "ns3/queue.h"
@@ -265,6 +267,130 @@ FifoQueueDiscTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Check that a queue disc run in burst mode sends the same packets,
+ * in the same order and with the same stops of the device queue, as a
+ * regular run, and that a run exhausting the quota is rescheduled
+ */
+class FifoQueueDiscBurstTestCase : public TestCase
+{
+  public:
+    FifoQueueDiscBurstTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Send callback of the queue discs: store the UID of the packet and stop
+     * the device queue when it holds m_deviceSlots packets
+     * \param txq the device queue
+     * \param uids the UIDs of the sent packets
+     * \param item the item sent to the device
+     */
+    void Send(Ptr<NetDeviceQueue> txq, std::vector<uint64_t>* uids, Ptr<QueueDiscItem> item);
+    /**
+     * Enqueue packets in the queue disc and run it, waking the device queue
+     * after every run, until the queue disc is empty
+     * \param burst whether the queue disc works in burst mode
+     * \param nPackets the number of packets to enqueue
+     * \param deviceSlots the number of packets accepted by the device between wake-ups
+     * \param uids the UIDs of the enqueued packets, in order
+     * \return the UIDs of the sent packets, in order
+     */
+    std::vector<uint64_t> RunQueueDisc(bool burst,
+                                       uint32_t nPackets,
+                                       uint32_t deviceSlots,
+                                       std::vector<uint64_t>& uids);
+
+    uint32_t m_deviceSlots; //!< Packets accepted by the device between wake-ups
+    uint32_t m_inDevice;    //!< Packets held by the device
+};
+
+FifoQueueDiscBurstTestCase::FifoQueueDiscBurstTestCase()
+    : TestCase("Check the burst mode of the queue disc run"),
+      m_deviceSlots(0),
+      m_inDevice(0)
+{
+}
+
+void
+FifoQueueDiscBurstTestCase::Send(Ptr<NetDeviceQueue> txq,
+                                 std::vector<uint64_t>* uids,
+                                 Ptr<QueueDiscItem> item)
+{
+    uids->push_back(item->GetPacket()->GetUid());
+    if (m_deviceSlots > 0 && ++m_inDevice == m_deviceSlots)
+    {
+        txq->Stop();
+    }
+}
+
+std::vector<uint64_t>
+FifoQueueDiscBurstTestCase::RunQueueDisc(bool burst,
+                                         uint32_t nPackets,
+                                         uint32_t deviceSlots,
+                                         std::vector<uint64_t>& uids)
+{
+    Ptr<FifoQueueDisc> q = CreateObjectWithAttributes<FifoQueueDisc>("MaxSize",
+                                                                    StringValue("100p"),
+                                                                    "Quota",
+                                                                    UintegerValue(8),
+                                                                    "BurstMode",
+                                                                    BooleanValue(burst));
+    Ptr<NetDeviceQueueInterface> ndqi = CreateObject<NetDeviceQueueInterface>();
+    Ptr<NetDeviceQueue> txq = ndqi->GetTxQueue(0);
+    std::vector<uint64_t> sent;
+    q->SetNetDeviceQueueInterface(ndqi);
+    q->SetSendCallback([this, txq, &sent](Ptr<QueueDiscItem> item) { Send(txq, &sent, item); });
+    q->Initialize();
+
+    m_deviceSlots = deviceSlots;
+    m_inDevice = 0;
+    uids.clear();
+    Address dest;
+    for (uint32_t i = 0; i < nPackets; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(100);
+        uids.push_back(p->GetUid());
+        q->Enqueue(Create<FifoQueueDiscTestItem>(p, dest));
+    }
+
+    q->Run();
+    Simulator::Run();
+    while (q->GetNPackets() > 0 && deviceSlots > 0)
+    {
+        m_inDevice = 0;
+        txq->Start();
+        q->Run();
+        Simulator::Run();
+    }
+    q->Dispose();
+    return sent;
+}
+
+void
+FifoQueueDiscBurstTestCase::DoRun()
+{
+    std::vector<uint64_t> uids;
+    std::vector<uint64_t> sent;
+
+    // a device accepting 3 packets at a time stops both kinds of run
+    sent = RunQueueDisc(false, 20, 3, uids);
+    NS_TEST_ASSERT_MSG_EQ((sent == uids), true, "Packets sent out of order (regular run)");
+    sent = RunQueueDisc(true, 20, 3, uids);
+    NS_TEST_ASSERT_MSG_EQ((sent == uids), true, "Packets sent out of order (burst mode)");
+
+    // a device that is never stopped: a regular run stops at the quota, while
+    // a run in burst mode is rescheduled until the queue disc is empty
+    sent = RunQueueDisc(false, 20, 0, uids);
+    NS_TEST_ASSERT_MSG_EQ(sent.size(), 8, "A regular run should send a quota of packets");
+    sent = RunQueueDisc(true, 20, 0, uids);
+    NS_TEST_ASSERT_MSG_EQ((sent == uids), true, "Burst mode should drain the queue disc in order");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup traffic-control-test
  *
@@ -277,5 +403,6 @@ static class FifoQueueDiscTestSuite : public TestSuite
         : TestSuite("fifo-queue-disc", UNIT)
     {
         AddTestCase(new FifoQueueDiscTestCase(), TestCase::QUICK);
+        AddTestCase(new FifoQueueDiscBurstTestCase(), TestCase::QUICK);
     }
 } g_fifoQueueTestSuite; ///< the test suite
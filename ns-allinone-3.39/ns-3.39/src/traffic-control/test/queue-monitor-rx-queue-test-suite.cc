@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/data-rate.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/queue-monitor.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Check that QueueMonitor monitors the reception (switching) queue
+ * of a PointToPointNetDevice.
+ *
+ * A burst of packets is sent to a device with switching time enabled.  The
+ * burst waits in the TxQueue of the sender; at the receiver, every packet
+ * goes through the RxQueue, which the device empties as soon as the switching
+ * of the packet starts.
+ */
+class QueueMonitorRxQueueTestCase : public TestCase
+{
+  public:
+    QueueMonitorRxQueueTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Send a packet.
+     * \param device the device
+     * \param dest the destination
+     */
+    void Send(Ptr<NetDevice> device, Address dest);
+};
+
+QueueMonitorRxQueueTestCase::QueueMonitorRxQueueTestCase()
+    : TestCase("Monitor the RxQueue of a PointToPointNetDevice with switching time")
+{
+}
+
+void
+QueueMonitorRxQueueTestCase::Send(Ptr<NetDevice> device, Address dest)
+{
+    device->Send(Create<Packet>(1000), dest, 0x0800);
+}
+
+void
+QueueMonitorRxQueueTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    p2p.SetDeviceAttribute("EnableSwithcingTime", BooleanValue(true));
+    p2p.SetDeviceAttribute("SwitchingCapacity", DataRateValue(DataRate("1Gbps")));
+    p2p.SetChannelAttribute("Delay", StringValue("1us"));
+    NetDeviceContainer devices = p2p.Install(nodes);
+
+    Ptr<QueueMonitor> monitor = CreateObject<QueueMonitor>();
+    monitor->AddAll();
+    std::ostringstream txName;
+    txName << "/NodeList/" << nodes.Get(0)->GetId() << "/DeviceList/0/TxQueue";
+    std::ostringstream rxName;
+    rxName << "/NodeList/" << nodes.Get(1)->GetId() << "/DeviceList/0/RxQueue";
+    uint32_t txQueue = monitor->GetNQueues();
+    uint32_t rxQueue = monitor->GetNQueues();
+    for (uint32_t i = 0; i < monitor->GetNQueues(); i++)
+    {
+        if (monitor->GetName(i) == txName.str())
+        {
+            txQueue = i;
+        }
+        if (monitor->GetName(i) == rxName.str())
+        {
+            rxQueue = i;
+        }
+    }
+    NS_TEST_ASSERT_MSG_LT(txQueue, monitor->GetNQueues(), "TxQueue of the sender not found");
+    NS_TEST_ASSERT_MSG_LT(rxQueue, monitor->GetNQueues(), "RxQueue of the receiver not found");
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Simulator::Schedule(MicroSeconds(10),
+                            &QueueMonitorRxQueueTestCase::Send,
+                            this,
+                            devices.Get(0),
+                            devices.Get(1)->GetAddress());
+    }
+    Simulator::Stop(MicroSeconds(200));
+    Simulator::Run();
+
+    const QueueOccupancy& tx = monitor->GetOccupancy(txQueue);
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(tx.GetMaxPackets(), 5, "The burst did not wait");
+    NS_TEST_EXPECT_MSG_GT(tx.GetMeanPackets(), 0, "No time-weighted occupancy");
+    NS_TEST_EXPECT_MSG_EQ(tx.GetPackets(), 0, "The TxQueue was not drained");
+    const QueueOccupancy& rx = monitor->GetOccupancy(rxQueue);
+    NS_TEST_EXPECT_MSG_EQ(rx.GetMaxPackets(), 1, "The received packets did not go through");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetMaxBytes(), 1002, "Wrong size in the RxQueue");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetPackets(), 0, "The RxQueue was not drained");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief QueueMonitor with point-to-point devices TestSuite
+ */
+static class QueueMonitorRxQueueTestSuite : public TestSuite
+{
+  public:
+    QueueMonitorRxQueueTestSuite()
+        : TestSuite("queue-monitor-rx-queue", UNIT)
+    {
+        AddTestCase(new QueueMonitorRxQueueTestCase(), TestCase::QUICK);
+    }
+} g_queueMonitorRxQueueTestSuite; ///< the test suite
@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/data-rate.h"
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/prio-queue-disc.h"
+#include "ns3/queue-monitor.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/traffic-control-layer.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Queue Monitor Test Item
+ */
+class QueueMonitorTestItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param p the packet
+     * \param addr the address
+     * \param priority the packet priority
+     */
+    QueueMonitorTestItem(Ptr<Packet> p, const Address& addr, uint8_t priority);
+    void AddHeader() override;
+    bool Mark() override;
+};
+
+QueueMonitorTestItem::QueueMonitorTestItem(Ptr<Packet> p, const Address& addr, uint8_t priority)
+    : QueueDiscItem(p, addr, 0)
+{
+    SocketPriorityTag priorityTag;
+    priorityTag.SetPriority(priority);
+    p->ReplacePacketTag(priorityTag);
+}
+
+void
+QueueMonitorTestItem::AddHeader()
+{
+}
+
+bool
+QueueMonitorTestItem::Mark()
+{
+    return false;
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Check the statistics of a QueueOccupancy against hand computed values.
+ */
+class QueueOccupancyTestCase : public TestCase
+{
+  public:
+    QueueOccupancyTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+QueueOccupancyTestCase::QueueOccupancyTestCase()
+    : TestCase("Time-weighted occupancy, CCDF, quantiles and series")
+{
+}
+
+void
+QueueOccupancyTestCase::DoRun()
+{
+    // 0 packets in [0, 1) s, 2 packets of 150 bytes in [1, 3) s, 1 packet in [3, 4) s
+    QueueOccupancy occupancy(Seconds(0), 100, Seconds(1));
+    occupancy.SetPackets(Seconds(1), 1);
+    occupancy.SetBytes(Seconds(1), 150);
+    occupancy.SetPackets(Seconds(1), 2);
+    occupancy.SetBytes(Seconds(1), 300);
+    occupancy.SetPackets(Seconds(3), 1);
+    occupancy.SetBytes(Seconds(3), 150);
+    occupancy.Advance(Seconds(4));
+
+    NS_TEST_EXPECT_MSG_EQ(occupancy.GetDuration(), Seconds(4), "Wrong duration");
+    NS_TEST_EXPECT_MSG_EQ_TOL(occupancy.GetMeanPackets(), 1.25, 1e-12, "Wrong mean packets");
+    NS_TEST_EXPECT_MSG_EQ_TOL(occupancy.GetMeanBytes(), 187.5, 1e-12, "Wrong mean bytes");
+    NS_TEST_EXPECT_MSG_EQ(occupancy.GetMaxPackets(), 2, "Wrong maximum packets");
+    NS_TEST_EXPECT_MSG_EQ(occupancy.GetMaxBytes(), 300, "Wrong maximum bytes");
+
+    std::vector<double> ccdf = occupancy.GetPacketsCcdf();
+    std::vector<double> expected = {1, 0.75, 0.5};
+    NS_TEST_ASSERT_MSG_EQ(ccdf.size(), expected.size(), "Wrong packets CCDF size");
+    for (std::size_t k = 0; k < ccdf.size(); k++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(ccdf[k], expected[k], 1e-12, "Wrong packets CCDF at " << k);
+    }
+    // bins of 100 bytes: [0, 100) for 1 s, [100, 200) for 1 s, [300, 400) for 2 s
+    ccdf = occupancy.GetBytesCcdf();
+    expected = {1, 0.75, 0.5, 0.5};
+    NS_TEST_ASSERT_MSG_EQ(ccdf.size(), expected.size(), "Wrong bytes CCDF size");
+    for (std::size_t k = 0; k < ccdf.size(); k++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(ccdf[k], expected[k], 1e-12, "Wrong bytes CCDF at " << k);
+    }
+    NS_TEST_EXPECT_MSG_EQ(occupancy.GetPacketsQuantile(0.5), 1, "Wrong median packets");
+    NS_TEST_EXPECT_MSG_EQ(occupancy.GetPacketsQuantile(0.99), 2, "Wrong 99th percentile");
+    NS_TEST_EXPECT_MSG_EQ(occupancy.GetBytesQuantile(0.25), 100, "Wrong bytes quantile");
+    NS_TEST_EXPECT_MSG_EQ(occupancy.GetBytesQuantile(0.99), 400, "Wrong bytes quantile");
+
+    const std::vector<QueueOccupancy::Sample>& series = occupancy.GetSeries();
+    std::vector<double> meanPackets = {0, 2, 2, 1};
+    NS_TEST_ASSERT_MSG_EQ(series.size(), meanPackets.size(), "Wrong number of samples");
+    for (std::size_t k = 0; k < series.size(); k++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(series[k].start, Seconds(k), "Wrong start of sample " << k);
+        NS_TEST_EXPECT_MSG_EQ_TOL(series[k].meanPackets,
+                                  meanPackets[k],
+                                  1e-12,
+                                  "Wrong mean packets of sample " << k);
+    }
+    NS_TEST_EXPECT_MSG_EQ(series[0].maxPackets, 0, "Wrong maximum of the first sample");
+    NS_TEST_EXPECT_MSG_EQ(series[1].maxBytes, 300, "Wrong maximum of the second sample");
+
+    // a change in the middle of an interval
+    occupancy.SetPackets(Seconds(4.5), 0);
+    occupancy.SetBytes(Seconds(4.5), 0);
+    occupancy.Advance(Seconds(5));
+    NS_TEST_ASSERT_MSG_EQ(series.size(), 5, "Wrong number of samples");
+    NS_TEST_EXPECT_MSG_EQ_TOL(series[4].meanPackets, 0.5, 1e-12, "Wrong mean of a partial busy");
+    NS_TEST_EXPECT_MSG_EQ_TOL(series[4].meanBytes, 75, 1e-12, "Wrong mean of a partial busy");
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Check the integrals of a large occupancy held for seconds at
+ * picosecond resolution, which exceed 64 bits.
+ */
+class QueueOccupancyLargeTestCase : public TestCase
+{
+  public:
+    QueueOccupancyLargeTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+QueueOccupancyLargeTestCase::QueueOccupancyLargeTestCase()
+    : TestCase("Time-weighted occupancy of megabytes for seconds at picosecond resolution")
+{
+}
+
+void
+QueueOccupancyLargeTestCase::DoRun()
+{
+    if (Time::GetResolution() != Time::PS)
+    {
+        Time::SetResolution(Time::PS);
+    }
+
+    // 5 MB in [0, 7.5) s, 2.5 MB in [7.5, 10) s: 4.375e19 byte steps in total
+    QueueOccupancy occupancy(Seconds(0), 1500, Seconds(5));
+    occupancy.SetPackets(Seconds(0), 5000);
+    occupancy.SetBytes(Seconds(0), 5000000);
+    occupancy.SetPackets(Seconds(7.5), 2500);
+    occupancy.SetBytes(Seconds(7.5), 2500000);
+    occupancy.Advance(Seconds(10));
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(occupancy.GetMeanBytes(), 4.375e6, 1e-3, "Wrong mean bytes");
+    NS_TEST_EXPECT_MSG_EQ_TOL(occupancy.GetMeanPackets(), 4375, 1e-9, "Wrong mean packets");
+    NS_TEST_EXPECT_MSG_EQ(occupancy.GetMaxBytes(), 5000000, "Wrong maximum bytes");
+    NS_TEST_EXPECT_MSG_EQ(occupancy.GetBytesQuantile(0.5), 5001000, "Wrong median bytes");
+    std::vector<double> ccdf = occupancy.GetBytesCcdf();
+    NS_TEST_ASSERT_MSG_EQ(ccdf.size(), 5000000 / 1500 + 1, "Wrong bytes CCDF size");
+    NS_TEST_EXPECT_MSG_EQ_TOL(ccdf[2500000 / 1500], 1, 1e-12, "Wrong CCDF at 2.5 MB");
+    NS_TEST_EXPECT_MSG_EQ_TOL(ccdf.back(), 0.75, 1e-12, "Wrong CCDF at 5 MB");
+
+    // each interval holds more than 2^64 byte steps
+    const std::vector<QueueOccupancy::Sample>& series = occupancy.GetSeries();
+    NS_TEST_ASSERT_MSG_EQ(series.size(), 2, "Wrong number of samples");
+    NS_TEST_EXPECT_MSG_EQ_TOL(series[0].meanBytes, 5e6, 1e-3, "Wrong mean of the first sample");
+    NS_TEST_EXPECT_MSG_EQ_TOL(series[1].meanBytes, 3.75e6, 1e-3, "Wrong mean of the second");
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Check that the classes of a queue disc, including those added after
+ * the queue disc is monitored, are monitored.
+ */
+class QueueMonitorClassesTestCase : public TestCase
+{
+  public:
+    QueueMonitorClassesTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Enqueue a packet.
+     * \param qdisc the queue disc
+     * \param priority the priority of the packet
+     */
+    void Enqueue(Ptr<QueueDisc> qdisc, uint8_t priority);
+    /**
+     * Dequeue a packet.
+     * \param qdisc the queue disc
+     */
+    void Dequeue(Ptr<QueueDisc> qdisc);
+};
+
+QueueMonitorClassesTestCase::QueueMonitorClassesTestCase()
+    : TestCase("Monitor the classes of a queue disc")
+{
+}
+
+void
+QueueMonitorClassesTestCase::Enqueue(Ptr<QueueDisc> qdisc, uint8_t priority)
+{
+    Address dest;
+    qdisc->Enqueue(Create<QueueMonitorTestItem>(Create<Packet>(100), dest, priority));
+}
+
+void
+QueueMonitorClassesTestCase::Dequeue(Ptr<QueueDisc> qdisc)
+{
+    qdisc->Dequeue();
+}
+
+void
+QueueMonitorClassesTestCase::DoRun()
+{
+    Ptr<PrioQueueDisc> qdisc = CreateObject<PrioQueueDisc>();
+    Ptr<QueueMonitor> monitor = CreateObject<QueueMonitor>();
+    monitor->AddQueueDisc("prio", qdisc);
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetNQueues(), 1, "Classes found before they were added");
+
+    // classes added after the queue disc is monitored
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        Ptr<FifoQueueDisc> child = CreateObject<FifoQueueDisc>();
+        child->Initialize();
+        Ptr<QueueDiscClass> c = CreateObject<QueueDiscClass>();
+        c->SetQueueDisc(child);
+        qdisc->AddQueueDiscClass(c);
+    }
+    qdisc->SetAttribute("Priomap", StringValue("0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1"));
+    qdisc->Initialize();
+
+    // priority 1 goes to class 1: two packets in [1, 2) ms, one in [2, 4) ms
+    Simulator::Schedule(MilliSeconds(1), &QueueMonitorClassesTestCase::Enqueue, this, qdisc, 1);
+    Simulator::Schedule(MilliSeconds(1), &QueueMonitorClassesTestCase::Enqueue, this, qdisc, 1);
+    Simulator::Schedule(MilliSeconds(2), &QueueMonitorClassesTestCase::Dequeue, this, qdisc);
+    Simulator::Schedule(MilliSeconds(4), &QueueMonitorClassesTestCase::Dequeue, this, qdisc);
+    Simulator::Stop(MilliSeconds(5));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(monitor->GetNQueues(), 3, "The classes were not monitored");
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetName(2),
+                          "prio/QueueDiscClassList/1/QueueDisc",
+                          "Wrong name of the class");
+    const QueueOccupancy& root = monitor->GetOccupancy(0);
+    NS_TEST_EXPECT_MSG_EQ(root.GetDuration(), MilliSeconds(5), "Wrong duration");
+    NS_TEST_EXPECT_MSG_EQ_TOL(root.GetMeanPackets(), 0.8, 1e-12, "Wrong mean of the root");
+    NS_TEST_EXPECT_MSG_EQ(root.GetMaxPackets(), 2, "Wrong maximum of the root");
+    // the class is monitored from the first enqueue, at 1 ms
+    const QueueOccupancy& used = monitor->GetOccupancy(2);
+    NS_TEST_EXPECT_MSG_EQ(used.GetDuration(), MilliSeconds(4), "Wrong duration of the class");
+    NS_TEST_EXPECT_MSG_EQ_TOL(used.GetMeanPackets(), 1, 1e-12, "Wrong mean of the class");
+    NS_TEST_EXPECT_MSG_EQ(used.GetMaxBytes(), 200, "Wrong maximum of the class");
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetOccupancy(1).GetMaxPackets(), 0, "Wrong unused class");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Check that the queues of the devices are found and reported.
+ */
+class QueueMonitorDevicesTestCase : public TestCase
+{
+  public:
+    QueueMonitorDevicesTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+QueueMonitorDevicesTestCase::QueueMonitorDevicesTestCase()
+    : TestCase("Monitor the queues of the devices")
+{
+}
+
+void
+QueueMonitorDevicesTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    nodes.Get(0)->AggregateObject(CreateObject<TrafficControlLayer>());
+    SimpleNetDeviceHelper simple;
+    simple.SetDeviceAttribute("DataRate", DataRateValue(DataRate("8Mbps")));
+    NetDeviceContainer devices = simple.Install(nodes);
+    TrafficControlHelper tch;
+    tch.SetRootQueueDisc("ns3::FifoQueueDisc");
+    tch.Install(devices.Get(0));
+
+    Ptr<QueueMonitor> monitor = CreateObject<QueueMonitor>();
+    monitor->SetAttribute("Interval", TimeValue(MilliSeconds(1)));
+    monitor->AddAll();
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < monitor->GetNQueues(); i++)
+    {
+        names.push_back(monitor->GetName(i));
+    }
+    std::ostringstream oss;
+    oss << "/NodeList/" << nodes.Get(0)->GetId() << "/DeviceList/0";
+    std::vector<std::string> expected = {oss.str() + "/TxQueue", oss.str() + "/RootQueueDisc"};
+    NS_TEST_ASSERT_MSG_EQ(names.size(), 3, "Wrong number of queues");
+    NS_TEST_EXPECT_MSG_EQ(names[0], expected[0], "Wrong device queue");
+    NS_TEST_EXPECT_MSG_EQ(names[1], expected[1], "Wrong root queue disc");
+
+    // a burst of ten packets of 1000 bytes, 1 ms each at 8 Mbps
+    Ptr<TrafficControlLayer> tc = nodes.Get(0)->GetObject<TrafficControlLayer>();
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Simulator::Schedule(MilliSeconds(1),
+                            &TrafficControlLayer::Send,
+                            tc,
+                            devices.Get(0),
+                            Create<QueueMonitorTestItem>(Create<Packet>(1000),
+                                                         devices.Get(1)->GetAddress(),
+                                                         0));
+    }
+    Simulator::Stop(MilliSeconds(20));
+    Simulator::Run();
+
+    uint32_t maxPackets = monitor->GetOccupancy(0).GetMaxPackets() +
+                          monitor->GetOccupancy(1).GetMaxPackets();
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(maxPackets, 9, "The burst was not queued");
+    std::ostringstream summary;
+    monitor->WriteSummary(summary);
+    std::ostringstream series;
+    monitor->WriteSeries(series);
+    std::size_t lines = 0;
+    std::istringstream iss(series.str());
+    for (std::string line; std::getline(iss, line);)
+    {
+        lines++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(lines, 1 + 3 * 20, "Wrong number of lines of the series");
+    NS_TEST_EXPECT_MSG_NE(summary.str().find(expected[1]), std::string::npos, "Queue missing");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Queue Monitor Test Suite
+ */
+static class QueueMonitorTestSuite : public TestSuite
+{
+  public:
+    QueueMonitorTestSuite()
+        : TestSuite("queue-monitor", UNIT)
+    {
+        AddTestCase(new QueueOccupancyTestCase(), TestCase::QUICK);
+        AddTestCase(new QueueOccupancyLargeTestCase(), TestCase::QUICK);
+        AddTestCase(new QueueMonitorClassesTestCase(), TestCase::QUICK);
+        AddTestCase(new QueueMonitorDevicesTestCase(), TestCase::QUICK);
+    }
+} g_queueMonitorTestSuite; ///< the test suite
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/data-rate.h"
+#include "ns3/mac48-address.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/tas-queue-disc.h"
+#include "ns3/test.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/uinteger.h"
+#include "ns3/vlan-header.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Tas Queue Disc Test Item
+ */
+class TasQueueDiscTestItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param p the packet
+     * \param addr the address
+     */
+    TasQueueDiscTestItem(Ptr<Packet> p, const Address& addr);
+
+    // Delete default constructor, copy constructor and assignment operator to avoid misuse
+    TasQueueDiscTestItem() = delete;
+    TasQueueDiscTestItem(const TasQueueDiscTestItem&) = delete;
+    TasQueueDiscTestItem& operator=(const TasQueueDiscTestItem&) = delete;
+
+    void AddHeader() override;
+    bool Mark() override;
+};
+
+TasQueueDiscTestItem::TasQueueDiscTestItem(Ptr<Packet> p, const Address& addr)
+    : QueueDiscItem(p, addr, 0)
+{
+}
+
+void
+TasQueueDiscTestItem::AddHeader()
+{
+}
+
+bool
+TasQueueDiscTestItem::Mark()
+{
+    return false;
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Check the gates, the guard bands and the gate events of a TasQueueDisc
+ * on a 10 Mb/s device, with the cycle
+ *
+ *     class 0: open [0, 100) us, class 1: open [100, 1000) us
+ */
+class TasQueueDiscTestCase : public TestCase
+{
+  public:
+    TasQueueDiscTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Send a packet through the traffic control layer.
+     * \param device the device
+     * \param pcp the PCP of the packet
+     * \param size the size of the packet
+     */
+    void Send(Ptr<NetDevice> device, uint8_t pcp, uint32_t size);
+
+    /**
+     * Record a dequeued packet.
+     * \param cls the class of the packet
+     * \param sojourn the time spent in the queue disc
+     * \param gateDelay the time spent with the gate closed
+     */
+    void Dequeued(uint32_t cls, Time sojourn, Time gateDelay);
+
+    /// A dequeued packet
+    struct Record
+    {
+        Time time;      //!< Dequeue time
+        uint32_t cls;   //!< Class
+        Time sojourn;   //!< Sojourn time
+        Time gateDelay; //!< Gate-induced latency
+    };
+
+    std::vector<Record> m_records; //!< Dequeued packets
+};
+
+TasQueueDiscTestCase::TasQueueDiscTestCase()
+    : TestCase("Sanity check on the gates of the TAS queue disc")
+{
+}
+
+void
+TasQueueDiscTestCase::Send(Ptr<NetDevice> device, uint8_t pcp, uint32_t size)
+{
+    Ptr<Packet> packet = Create<Packet>(size);
+    packet->AddPacketTag(VlanTag(pcp, 1));
+    Ptr<TrafficControlLayer> tc = device->GetNode()->GetObject<TrafficControlLayer>();
+    tc->Send(device, Create<TasQueueDiscTestItem>(packet, device->GetBroadcast()));
+}
+
+void
+TasQueueDiscTestCase::Dequeued(uint32_t cls, Time sojourn, Time gateDelay)
+{
+    m_records.push_back(Record{Simulator::Now(), cls, sojourn, gateDelay});
+}
+
+void
+TasQueueDiscTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    nodes.Get(0)->AggregateObject(CreateObject<TrafficControlLayer>());
+    SimpleNetDeviceHelper simple;
+    simple.SetDeviceAttribute("DataRate", DataRateValue(DataRate("10Mbps")));
+    simple.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("1p"));
+    NetDeviceContainer devices = simple.Install(nodes);
+
+    TrafficControlHelper tch;
+    uint16_t handle = tch.SetRootQueueDisc("ns3::TasQueueDisc",
+                                           "GateControlList",
+                                           StringValue("0x1 100us; 0x2 900us"),
+                                           "LinkRate",
+                                           DataRateValue(DataRate("10Mbps")),
+                                           "Overhead",
+                                           UintegerValue(0));
+    tch.AddPacketFilter(handle, "ns3::PcpPacketFilter", "NBands", UintegerValue(2));
+    TrafficControlHelper::ClassIdList cid = tch.AddQueueDiscClasses(handle, 2, "ns3::QueueDiscClass");
+    tch.AddChildQueueDiscs(handle, cid, "ns3::FifoQueueDisc");
+    QueueDiscContainer qdiscs = tch.Install(devices.Get(0));
+    Ptr<TasQueueDisc> tas = DynamicCast<TasQueueDisc>(qdiscs.Get(0));
+    tas->TraceConnectWithoutContext("Latency", MakeCallback(&TasQueueDiscTestCase::Dequeued, this));
+
+    NS_TEST_EXPECT_MSG_EQ(tas->GetCycleTime(), MicroSeconds(1000), "Wrong cycle time");
+    StringValue gcl;
+    tas->GetAttribute("GateControlList", gcl);
+    NS_TEST_EXPECT_MSG_EQ(gcl.Get(),
+                          "0x1 100000000ps; 0x2 900000000ps",
+                          "Wrong gate control list");
+
+    // 100 bytes take 80 us, 200 bytes (160 us) never fit in the window of class 0
+    Ptr<NetDevice> device = devices.Get(0);
+    // class 1 with its gate closed: sent when it opens, at 100 us
+    Simulator::Schedule(MicroSeconds(0), &TasQueueDiscTestCase::Send, this, device, 0, 100);
+    // class 0 with its gate closed: sent when it opens, at 1000 us
+    Simulator::Schedule(MicroSeconds(200), &TasQueueDiscTestCase::Send, this, device, 7, 100);
+    // class 1 with only 50 us of open gate: held by the guard band until 1100 us
+    Simulator::Schedule(MicroSeconds(950), &TasQueueDiscTestCase::Send, this, device, 0, 100);
+    // class 0 longer than its window: dropped
+    Simulator::Schedule(MicroSeconds(2000), &TasQueueDiscTestCase::Send, this, device, 7, 200);
+    // class 1 with its gate open: sent at once
+    Simulator::Schedule(MicroSeconds(2500), &TasQueueDiscTestCase::Send, this, device, 0, 100);
+
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_records.size(), 4, "Wrong number of packets dequeued");
+    const Time expectedTime[] = {MicroSeconds(100),
+                                 MicroSeconds(1000),
+                                 MicroSeconds(1100),
+                                 MicroSeconds(2500)};
+    const uint32_t expectedClass[] = {1, 0, 1, 1};
+    const Time expectedGateDelay[] = {MicroSeconds(100),
+                                      MicroSeconds(800),
+                                      MicroSeconds(100),
+                                      MicroSeconds(0)};
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_records[i].time, expectedTime[i], "Wrong time of packet " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_records[i].cls, expectedClass[i], "Wrong class of packet " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_records[i].gateDelay,
+                              expectedGateDelay[i],
+                              "Wrong gate delay of packet " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_records[2].sojourn, MicroSeconds(150), "Wrong sojourn time");
+
+    const TasClassStats& stats0 = tas->GetClassStats(0);
+    const TasClassStats& stats1 = tas->GetClassStats(1);
+    NS_TEST_EXPECT_MSG_EQ(stats0.nPackets, 1, "Wrong packets of class 0");
+    NS_TEST_EXPECT_MSG_EQ(stats1.nPackets, 3, "Wrong packets of class 1");
+    NS_TEST_EXPECT_MSG_EQ(stats1.maxGateDelay, MicroSeconds(100), "Wrong max gate delay");
+    NS_TEST_EXPECT_MSG_EQ(stats1.totalGateDelay, MicroSeconds(200), "Wrong total gate delay");
+    NS_TEST_EXPECT_MSG_EQ(stats1.nGuardBandHolds, 1, "Wrong guard band holds");
+    NS_TEST_EXPECT_MSG_EQ(tas->GetStats().GetNDroppedPackets(TasQueueDisc::OVERSIZE_DROP),
+                          1,
+                          "The oversize packet was not dropped");
+    // only the gate openings that release a packet, not one per GCL entry
+    NS_TEST_EXPECT_MSG_EQ(tas->GetNGateEvents(), 3, "Wrong number of gate events");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Check the classification of the packets without packet filter
+ */
+class TasQueueDiscClassifyTestCase : public TestCase
+{
+  public:
+    TasQueueDiscClassifyTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+TasQueueDiscClassifyTestCase::TasQueueDiscClassifyTestCase()
+    : TestCase("Classification of the TAS queue disc by socket priority")
+{
+}
+
+void
+TasQueueDiscClassifyTestCase::DoRun()
+{
+    // three FIFO classes by default; without gates, strict priority
+    Ptr<TasQueueDisc> tas = CreateObject<TasQueueDisc>();
+    tas->Initialize();
+    NS_TEST_ASSERT_MSG_EQ(tas->GetNQueueDiscClasses(), 3, "Three classes expected");
+    NS_TEST_EXPECT_MSG_EQ(tas->IsGateOpen(2), true, "Gates open without a GCL");
+
+    const uint8_t priorities[] = {0, 6, 3};
+    for (uint8_t priority : priorities)
+    {
+        Ptr<Packet> packet = Create<Packet>(100);
+        SocketPriorityTag tag;
+        tag.SetPriority(priority);
+        packet->AddPacketTag(tag);
+        tas->Enqueue(Create<TasQueueDiscTestItem>(packet, Mac48Address()));
+    }
+    // classes (7 - p) * 3 / 8: 2, 0 and 1
+    for (uint32_t cls = 0; cls < 3; cls++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(tas->GetQueueDiscClass(cls)->GetQueueDisc()->GetNPackets(),
+                              1,
+                              "Wrong packets in class " << cls);
+    }
+    const uint8_t expected[] = {6, 3, 0};
+    for (uint8_t priority : expected)
+    {
+        Ptr<QueueDiscItem> item = tas->Dequeue();
+        NS_TEST_ASSERT_MSG_NE(item, nullptr, "No packet dequeued");
+        SocketPriorityTag tag;
+        item->GetPacket()->PeekPacketTag(tag);
+        NS_TEST_EXPECT_MSG_EQ(+tag.GetPriority(), +priority, "Not dequeued by priority");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Tas Queue Disc Test Suite
+ */
+static class TasQueueDiscTestSuite : public TestSuite
+{
+  public:
+    TasQueueDiscTestSuite()
+        : TestSuite("tas-queue-disc", UNIT)
+    {
+        AddTestCase(new TasQueueDiscTestCase(), TestCase::QUICK);
+        AddTestCase(new TasQueueDiscClassifyTestCase(), TestCase::QUICK);
+    }
+} g_tasQueueDiscTestSuite; ///< the test suite
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the cost of wiring one trace sink per application,
+// as the fronthaul scenarios do for every flow, with three methods:
+//
+//  - "string":  Config::ConnectWithoutContext with a path built per flow
+//               ("/NodeList/N/ApplicationList/K/$Type/Tx")
+//  - "matcher": a Config::PathMatcher compiled once
+//               ("/NodeList/{}/ApplicationList/{}/$Type") and resolved per flow
+//  - "handle":  TraceConnectWithoutContext on the application handles kept
+//               from the installation
+//
+// Each method connects its own sink to every application.  After the wiring
+// every trace source is fired once to check that all the sinks are connected.
+// One CSV line is printed per method.
+//
+// Sample usage:
+//   ./ns3 run 'bench-config-paths --nodes=10 --appsPerNode=1000'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Application with a single trace source, fired on demand.
+ */
+class BenchTraceApplication : public Application
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("BenchTraceApplication")
+                .SetParent<Application>()
+                .AddConstructor<BenchTraceApplication>()
+                .AddTraceSource("Tx",
+                                "A packet has been sent",
+                                MakeTraceSourceAccessor(&BenchTraceApplication::m_txTrace),
+                                "ns3::Packet::TracedCallback");
+        return tid;
+    }
+
+    /**
+     * Fire the trace source.
+     * \param packet the packet traced
+     */
+    void Fire(Ptr<const Packet> packet)
+    {
+        m_txTrace(packet);
+    }
+
+  private:
+    TracedCallback<Ptr<const Packet>> m_txTrace; //!< Tx trace source
+};
+
+/**
+ * Trace sink counting its invocations.
+ */
+struct BenchSink
+{
+    /**
+     * Trace sink.
+     * \param packet the packet traced
+     */
+    void Tx(Ptr<const Packet> packet)
+    {
+        m_count++;
+    }
+
+    uint64_t m_count{0}; //!< Number of invocations
+};
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nodes = 10;
+    uint32_t appsPerNode = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nodes", "Number of nodes", nodes);
+    cmd.AddValue("appsPerNode", "Number of applications per node", appsPerNode);
+    cmd.Parse(argc, argv);
+
+    NodeContainer container;
+    container.Create(nodes);
+    std::vector<Ptr<BenchTraceApplication>> apps;
+    for (uint32_t n = 0; n < nodes; n++)
+    {
+        for (uint32_t k = 0; k < appsPerNode; k++)
+        {
+            apps.push_back(CreateObject<BenchTraceApplication>());
+            container.Get(n)->AddApplication(apps.back());
+        }
+    }
+
+    BenchSink sinks[3];
+    const char* methods[] = {"string", "matcher", "handle"};
+    std::chrono::steady_clock::duration elapsed[3];
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < nodes; n++)
+    {
+        for (uint32_t k = 0; k < appsPerNode; k++)
+        {
+            std::string path = "/NodeList/" + std::to_string(container.Get(n)->GetId()) +
+                               "/ApplicationList/" + std::to_string(k) +
+                               "/$BenchTraceApplication/Tx";
+            Config::ConnectWithoutContext(path, MakeCallback(&BenchSink::Tx, &sinks[0]));
+        }
+    }
+    elapsed[0] = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    Config::PathMatcher matcher("/NodeList/{}/ApplicationList/{}/$BenchTraceApplication");
+    for (uint32_t n = 0; n < nodes; n++)
+    {
+        for (uint32_t k = 0; k < appsPerNode; k++)
+        {
+            matcher.Lookup({container.Get(n)->GetId(), k})
+                .ConnectWithoutContext("Tx", MakeCallback(&BenchSink::Tx, &sinks[1]));
+        }
+    }
+    elapsed[1] = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& app : apps)
+    {
+        app->TraceConnectWithoutContext("Tx", MakeCallback(&BenchSink::Tx, &sinks[2]));
+    }
+    elapsed[2] = std::chrono::steady_clock::now() - start;
+
+    Ptr<Packet> packet = Create<Packet>(100);
+    for (const auto& app : apps)
+    {
+        app->Fire(packet);
+    }
+
+    std::cout << "method,nodes,apps_per_node,sinks,ms_total,us_per_sink" << std::endl;
+    for (uint32_t m = 0; m < 3; m++)
+    {
+        NS_ABORT_MSG_IF(sinks[m].m_count != apps.size(),
+                        "Method " << methods[m] << " connected " << sinks[m].m_count << " of "
+                                  << apps.size() << " sinks");
+        double us = std::chrono::duration<double, std::micro>(elapsed[m]).count();
+        std::cout << methods[m] << "," << nodes << "," << appsPerNode << "," << apps.size() << ","
+                  << std::fixed << std::setprecision(3) << us / 1000 << "," << us / apps.size()
+                  << std::endl;
+    }
+
+    Simulator::Destroy();
+    return 0;
+}
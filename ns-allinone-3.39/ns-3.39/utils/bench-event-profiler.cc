@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the overhead of the EventProfiler of the
+// DefaultSimulatorImpl.  A set of cells, one Poissonapp each, sends to one
+// PacketSink per cell over SimpleNetDevices; the same scenario is run
+// without profiling and with every ProfilingPeriod given.  One CSV line is
+// printed per run with the period, the executed events, the profiled events
+// and the wall clock time of the run, and the report of the last profiled
+// run is printed to std::clog.
+//
+// Sample usage:
+//   ./ns3 run 'bench-event-profiler --cells=100 --duration=1 --periods=1,100,10000'
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t cells = 100;
+    double duration = 1;
+    double interval = 100e-6;
+    uint32_t packetSize = 1000;
+    std::string periodList = "1,100,10000";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("cells", "Number of cells", cells);
+    cmd.AddValue("duration", "Simulated time (s)", duration);
+    cmd.AddValue("interval", "Mean inter-arrival time of a cell (s)", interval);
+    cmd.AddValue("packetSize", "Mean packet size (bytes)", packetSize);
+    cmd.AddValue("periods", "Comma separated profiling periods", periodList);
+    cmd.Parse(argc, argv);
+
+    std::vector<uint32_t> periods{0};
+    std::istringstream iss(periodList);
+    std::string period;
+    while (std::getline(iss, period, ','))
+    {
+        periods.push_back(std::stoul(period));
+    }
+
+    std::cout << "period,events,profiled,rx_bytes,wall_s" << std::endl;
+    for (std::size_t p = 0; p < periods.size(); p++)
+    {
+        // a fresh thread per run, so that every run draws the same random numbers
+        SimulationContext::Run(
+            1,
+            [&](uint32_t) {
+                Config::SetDefault("ns3::DefaultSimulatorImpl::ProfilingPeriod",
+                                   UintegerValue(periods[p]));
+                NodeContainer sources;
+                sources.Create(cells);
+                Ptr<Node> sink = CreateObject<Node>();
+                NodeContainer nodes(sources, NodeContainer(sink));
+                SimpleNetDeviceHelper simpleHelper;
+                NetDeviceContainer devices = simpleHelper.Install(nodes);
+                InternetStackHelper internet;
+                internet.Install(nodes);
+                Ipv4AddressHelper ipv4;
+                ipv4.SetBase("10.1.0.0", "255.255.0.0");
+                Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+                NeighborCacheHelper neighborCache;
+                neighborCache.PopulateNeighborCache();
+
+                ApplicationContainer sinkApps;
+                ApplicationContainer sourceApps;
+                for (uint32_t c = 0; c < cells; c++)
+                {
+                    InetSocketAddress address(interfaces.GetAddress(cells), 8080 + c);
+                    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory", address);
+                    sinkApps.Add(sinkHelper.Install(sink));
+                    PoissonHelper poissonHelper("ns3::UdpSocketFactory", address);
+                    poissonHelper.SetAttribute("PacketSize", UintegerValue(packetSize));
+                    poissonHelper.SetAttribute("Interval", DoubleValue(interval));
+                    sourceApps.Add(poissonHelper.Install(sources.Get(c)));
+                }
+                sinkApps.Start(Seconds(0));
+                sourceApps.Start(Seconds(0));
+                Simulator::Stop(Seconds(duration));
+
+                auto start = std::chrono::steady_clock::now();
+                Simulator::Run();
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+                uint64_t bytes = 0;
+                for (uint32_t i = 0; i < sinkApps.GetN(); i++)
+                {
+                    bytes += DynamicCast<PacketSink>(sinkApps.Get(i))->GetTotalRx();
+                }
+                Ptr<DefaultSimulatorImpl> impl =
+                    DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+                Ptr<EventProfiler> profiler = impl->GetEventProfiler();
+                std::cout << periods[p] << "," << Simulator::GetEventCount() << ","
+                          << (profiler ? profiler->GetSampledEvents() : 0) << "," << bytes
+                          << "," << std::fixed << std::setprecision(2) << elapsed.count()
+                          << std::endl;
+                if (p + 1 < periods.size())
+                {
+                    // only the last run prints its report
+                    impl->SetAttribute("ProfilingPeriod", UintegerValue(0));
+                }
+                Simulator::Destroy();
+            },
+            1);
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+// This program measures the wall clock time of a network split in partitions
+// run by the MultithreadedSimulatorImpl, against the default simulator.  The
+// network is a ring of regions joined by links with a 1 ms delay; every
+// region is a hub with leaf nodes, each sending a Poisson UDP flow to a leaf
+// of the next region.  The regions are distributed round robin over the
+// partitions.  One CSV line is printed per run with the number of partitions
+// (0 for the default simulator), the events, the packets and bytes received
+// (the same for every run), the synchronization windows and the wall clock
+// time.  There is one thread per partition, so the speedup is bounded by the
+// hardware threads.
+//
+// Sample usage:
+//   ./ns3 run 'bench-multithreaded-simulator --regions=8 --leaves=8 --maxPartitions=4'
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/// Result of a run
+struct RunResult
+{
+    uint64_t events;  //!< Events executed
+    uint64_t packets; //!< Packets received
+    uint64_t bytes;   //!< Bytes received
+    uint64_t windows; //!< Synchronization windows
+};
+
+/**
+ * Count a received packet.
+ * \param count the packets received by the sink
+ * \param packet the packet
+ * \param from the source address
+ */
+static void
+Received(uint64_t* count, Ptr<const Packet> packet, const Address& from)
+{
+    (*count)++;
+}
+
+/**
+ * Build and run the ring, without destroying the simulation.
+ * \param partitions the number of partitions, or zero for the default simulator
+ * \param regions the number of regions
+ * \param leaves the number of leaves per region
+ * \param interval the mean inter-arrival time of the flows, in seconds
+ * \param duration the simulated time, in seconds
+ * \return the result of the run
+ */
+static RunResult
+RunRing(uint32_t partitions,
+        uint32_t regions,
+        uint32_t leaves,
+        double interval,
+        double duration)
+{
+    Ptr<MultithreadedSimulatorImpl> impl;
+    if (partitions > 0)
+    {
+        impl = CreateObject<MultithreadedSimulatorImpl>();
+        Simulator::SetImplementation(impl);
+    }
+
+    std::vector<NodeContainer> hubs(regions);
+    std::vector<NodeContainer> regionLeaves(regions);
+    for (uint32_t r = 0; r < regions; r++)
+    {
+        uint32_t systemId = partitions > 0 ? r % partitions : 0;
+        hubs[r].Create(1, systemId);
+        regionLeaves[r].Create(leaves, systemId);
+    }
+    InternetStackHelper internet;
+    for (uint32_t r = 0; r < regions; r++)
+    {
+        internet.Install(hubs[r]);
+        internet.Install(regionLeaves[r]);
+    }
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.255.252");
+    PointToPointHelper ring;
+    ring.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    ring.SetChannelAttribute("Delay", StringValue("1ms"));
+    for (uint32_t r = 0; r < regions; r++)
+    {
+        ipv4.Assign(ring.Install(hubs[r].Get(0), hubs[(r + 1) % regions].Get(0)));
+        ipv4.NewNetwork();
+    }
+    PointToPointHelper access;
+    access.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    access.SetChannelAttribute("Delay", StringValue("10us"));
+    std::vector<std::vector<Ipv4Address>> addresses(regions);
+    for (uint32_t r = 0; r < regions; r++)
+    {
+        for (uint32_t l = 0; l < leaves; l++)
+        {
+            Ipv4InterfaceContainer interfaces =
+                ipv4.Assign(access.Install(regionLeaves[r].Get(l), hubs[r].Get(0)));
+            addresses[r].push_back(interfaces.GetAddress(0));
+            ipv4.NewNetwork();
+        }
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    std::vector<uint64_t> received(regions * leaves, 0);
+    ApplicationContainer sinks;
+    ApplicationContainer sources;
+    for (uint32_t r = 0; r < regions; r++)
+    {
+        for (uint32_t l = 0; l < leaves; l++)
+        {
+            InetSocketAddress address(addresses[(r + 1) % regions][l], 9000);
+            PacketSinkHelper sinkHelper("ns3::UdpSocketFactory", address);
+            ApplicationContainer sink = sinkHelper.Install(regionLeaves[(r + 1) % regions].Get(l));
+            sink.Get(0)->TraceConnectWithoutContext(
+                "Rx",
+                MakeBoundCallback(&Received, &received[r * leaves + l]));
+            sinks.Add(sink);
+            PoissonHelper poissonHelper("ns3::UdpSocketFactory", address);
+            poissonHelper.SetAttribute("PacketSize", UintegerValue(1000));
+            poissonHelper.SetAttribute("Interval", DoubleValue(interval));
+            sources.Add(poissonHelper.Install(regionLeaves[r].Get(l)));
+        }
+    }
+    sinks.Start(Seconds(0));
+    sources.Start(Seconds(0));
+    Simulator::Stop(Seconds(duration));
+    Simulator::Run();
+
+    RunResult result{Simulator::GetEventCount(), 0, 0, impl ? impl->GetNWindows() : 0};
+    for (uint32_t i = 0; i < sinks.GetN(); i++)
+    {
+        result.packets += received[i];
+        result.bytes += DynamicCast<PacketSink>(sinks.Get(i))->GetTotalRx();
+    }
+    return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t regions = 8;
+    uint32_t leaves = 8;
+    double interval = 1e-4;
+    double duration = 0.5;
+    uint32_t hardware = std::max(1U, std::thread::hardware_concurrency());
+    uint32_t maxPartitions = 4;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("regions", "Number of regions of the ring", regions);
+    cmd.AddValue("leaves", "Number of leaves per region", leaves);
+    cmd.AddValue("interval", "Mean inter-arrival time of the flows, in seconds", interval);
+    cmd.AddValue("duration", "Simulated time, in seconds", duration);
+    cmd.AddValue("maxPartitions", "Largest number of partitions", maxPartitions);
+    cmd.Parse(argc, argv);
+
+    maxPartitions = std::min(maxPartitions, regions);
+    std::vector<uint32_t> partitionCounts{0, 1};
+    for (uint32_t partitions = 2; partitions <= maxPartitions; partitions *= 2)
+    {
+        partitionCounts.push_back(partitions);
+    }
+
+    std::cout << "# hardware threads: " << hardware << std::endl;
+    std::cout << "partitions,events,packets,bytes,windows,wall_ms" << std::endl;
+    for (uint32_t partitions : partitionCounts)
+    {
+        auto start = std::chrono::steady_clock::now();
+        // in a replication of its own, so that every run draws the same
+        // random streams
+        RunResult result;
+        SimulationContext::Run(
+            1,
+            [&](uint32_t) {
+                result = RunRing(partitions, regions, leaves, interval, duration);
+            },
+            1);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                              start)
+                        .count();
+        std::cout << partitions << "," << result.events << "," << result.packets << ","
+                  << result.bytes << "," << result.windows << "," << std::fixed
+                  << std::setprecision(1) << ms << std::endl;
+    }
+    return 0;
+}
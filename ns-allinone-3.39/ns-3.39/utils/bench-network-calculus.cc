@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+// This program measures the cost of computing the network calculus bounds of
+// a fronthaul/backhaul tree: every site has an access port with its cells as
+// EF flows, the sites of an aggregation node share its switching fabric and
+// its uplink, where the backhaul slices are served by DRR below the EF
+// flows, and all the uplinks share a core port.  One CSV line is printed per
+// size with the servers, the flows, the largest delay bound and the wall
+// clock time of the evaluation (best of the repetitions).
+//
+// Sample usage:
+//   ./ns3 run 'bench-network-calculus --cells=12 --repetitions=5'
+
+#include "ns3/command-line.h"
+#include "ns3/network-calculus.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t cells = 12;
+    uint32_t sitesPerNode = 10;
+    uint32_t slices = 3;
+    uint32_t repetitions = 5;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("cells", "Number of cells per site", cells);
+    cmd.AddValue("sitesPerNode", "Number of sites per aggregation node", sitesPerNode);
+    cmd.AddValue("slices", "Number of backhaul slices per aggregation node", slices);
+    cmd.AddValue("repetitions", "Evaluations per size", repetitions);
+    cmd.Parse(argc, argv);
+
+    std::cout << "sites,servers,flows,max_delay_us,wall_ms" << std::endl;
+    for (uint32_t sites : {10, 100, 1000, 10000})
+    {
+        NetworkCalculus calculus;
+        uint32_t nodes = std::max(1U, sites / sitesPerNode);
+        uint32_t core = calculus.AddServer("core", 400e9 * nodes, 0, 1e-6, 2);
+        for (uint32_t n = 0; n < nodes; n++)
+        {
+            std::string node = "node" + std::to_string(n);
+            uint32_t fabric = calculus.AddServer(node + "/fabric", 2000e9, 0, 0, 0);
+            uint32_t uplink = calculus.AddServer(node + "/uplink", 400e9, 0, 1e-6, 2);
+            for (uint32_t s = 0; s < slices; s++)
+            {
+                uint32_t queue = calculus.AddQueue(uplink, 1, 1500 * (s + 1));
+                calculus.MapClass(uplink, 8 * (s + 1), queue);
+                calculus.AddFlow(node + "/bh" + std::to_string(s),
+                                 5e9,
+                                 3000,
+                                 1500,
+                                 {fabric, uplink, core},
+                                 8 * (s + 1));
+            }
+            for (uint32_t i = 0; i < sitesPerNode; i++)
+            {
+                std::string site = node + "/site" + std::to_string(i);
+                uint32_t access = calculus.AddServer(site, 100e9, 0, 5e-6, 2);
+                for (uint32_t c = 0; c < cells; c++)
+                {
+                    calculus.AddFlow(site + "/cell" + std::to_string(c),
+                                     1e9,
+                                     7680,
+                                     7680,
+                                     {access, fabric, uplink, core},
+                                     46);
+                }
+            }
+        }
+
+        double best = std::numeric_limits<double>::infinity();
+        for (uint32_t r = 0; r < repetitions; r++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            calculus.Evaluate();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        double maxDelay = 0;
+        for (uint32_t f = 0; f < calculus.GetNFlows(); f++)
+        {
+            maxDelay = std::max(maxDelay, calculus.GetDelayBound(f));
+        }
+        std::cout << nodes * sitesPerNode << "," << calculus.GetNServers() << ","
+                  << calculus.GetNFlows() << "," << std::fixed << std::setprecision(2)
+                  << maxDelay * 1e6 << "," << best * 1e3 << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+// This program measures the cost of carrying fronthaul traffic over a chain
+// of switches in the two ways the scenarios can build it:
+//
+//  - "ip": every node has an internet stack, the switches are IPv4 routers
+//          with global routing and the cells are Poissonapps over UDP
+//          received by a MultiPortSink
+//  - "l2": the switches are bridges of point-to-point ports and the cells
+//          are OfhEcpriApplications sending eCPRI messages in VLAN tagged
+//          Ethernet frames over packet sockets, received by a PacketSink
+//
+// Both modes send the same messages (size and period) from the DU to the RU.
+// One CSV line is printed per mode with the executed events, the bytes
+// received and the wall clock time of the run.
+//
+// Sample usage:
+//   ./ns3 run 'bench-ofh-l2 --hops=4 --cells=12 --duration=1'
+
+#include "ns3/applications-module.h"
+#include "ns3/bridge-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t hops = 4;
+    uint32_t cells = 12;
+    double duration = 1;
+    double interval = 100e-6;
+    uint32_t packetSize = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("hops", "Number of switches between the DU and the RU", hops);
+    cmd.AddValue("cells", "Number of cells (flows) of the DU", cells);
+    cmd.AddValue("duration", "Simulated time (s)", duration);
+    cmd.AddValue("interval", "Inter-arrival time of a cell (s)", interval);
+    cmd.AddValue("packetSize", "Message size (bytes)", packetSize);
+    cmd.Parse(argc, argv);
+
+    std::cout << "mode,hops,cells,events,rx_bytes,wall_s" << std::endl;
+    for (std::string mode : {"ip", "l2"})
+    {
+        // DU, switches and RU
+        NodeContainer nodes;
+        nodes.Create(hops + 2);
+        Ptr<Node> du = nodes.Get(0);
+        Ptr<Node> ru = nodes.Get(hops + 1);
+        PointToPointHelper p2p;
+        p2p.SetDeviceAttribute("DataRate", StringValue("100Gbps"));
+        p2p.SetChannelAttribute("Delay", StringValue("1us"));
+        std::vector<NetDeviceContainer> links;
+        for (uint32_t i = 0; i <= hops; i++)
+        {
+            links.push_back(p2p.Install(nodes.Get(i), nodes.Get(i + 1)));
+        }
+        Ptr<NetDevice> duDevice = links.front().Get(0);
+        Ptr<NetDevice> ruDevice = links.back().Get(1);
+
+        ApplicationContainer sinkApps;
+        ApplicationContainer sourceApps;
+        if (mode == "ip")
+        {
+            InternetStackHelper internet;
+            internet.Install(nodes);
+            Ipv4AddressHelper ipv4;
+            ipv4.SetBase("10.1.0.0", "255.255.255.0");
+            Ipv4Address ruAddress;
+            for (auto& link : links)
+            {
+                ruAddress = ipv4.Assign(link).GetAddress(1);
+                ipv4.NewNetwork();
+            }
+            Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+            MultiPortSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                           InetSocketAddress(ruAddress, 8080),
+                                           cells);
+            sinkApps.Add(sinkHelper.Install(ru));
+            for (uint32_t c = 0; c < cells; c++)
+            {
+                PoissonHelper poissonHelper("ns3::UdpSocketFactory",
+                                            InetSocketAddress(ruAddress, 8080 + c));
+                poissonHelper.SetAttribute("PacketGen", StringValue("cte"));
+                poissonHelper.SetAttribute("PacketSize", UintegerValue(packetSize));
+                poissonHelper.SetAttribute("Interval", DoubleValue(interval));
+                sourceApps.Add(poissonHelper.Install(du));
+            }
+        }
+        else
+        {
+            BridgeHelper bridge;
+            for (uint32_t i = 1; i <= hops; i++)
+            {
+                bridge.Install(nodes.Get(i),
+                               NetDeviceContainer(links[i - 1].Get(1), links[i].Get(0)));
+            }
+            PacketSocketHelper packetSocket;
+            packetSocket.Install(du);
+            packetSocket.Install(ru);
+
+            PacketSocketAddress local;
+            local.SetSingleDevice(ruDevice->GetIfIndex());
+            local.SetProtocol(EcpriHeader::PROT_NUMBER);
+            PacketSinkHelper sinkHelper("ns3::PacketSocketFactory", local);
+            sinkApps.Add(sinkHelper.Install(ru));
+
+            PacketSocketAddress remote;
+            remote.SetSingleDevice(duDevice->GetIfIndex());
+            remote.SetPhysicalAddress(ruDevice->GetAddress());
+            remote.SetProtocol(EcpriHeader::PROT_NUMBER);
+            OfhEcpriHelper ofhHelper(remote);
+            // the eCPRI header is part of the message size
+            ofhHelper.SetAttribute("U-PacketSize",
+                                   UintegerValue(packetSize - EcpriHeader().GetSerializedSize()));
+            std::ostringstream gap;
+            gap << "ns3::ConstantRandomVariable[Constant=" << interval << "]";
+            ofhHelper.SetAttribute("U-Interval", StringValue(gap.str()));
+            for (uint32_t c = 0; c < cells; c++)
+            {
+                ofhHelper.SetAttribute("PcId", UintegerValue(c));
+                sourceApps.Add(ofhHelper.Install(du));
+            }
+        }
+        sinkApps.Start(Seconds(0));
+        sourceApps.Start(Seconds(0));
+        Simulator::Stop(Seconds(duration));
+
+        auto start = std::chrono::steady_clock::now();
+        Simulator::Run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        uint64_t bytes = 0;
+        if (mode == "ip")
+        {
+            bytes = DynamicCast<MultiPortSink>(sinkApps.Get(0))->GetTotalRx();
+        }
+        else
+        {
+            bytes = DynamicCast<PacketSink>(sinkApps.Get(0))->GetTotalRx();
+        }
+        std::cout << mode << "," << hops << "," << cells << "," << Simulator::GetEventCount()
+                  << "," << bytes << "," << std::fixed << std::setprecision(2) << elapsed.count()
+                  << std::endl;
+        Simulator::Destroy();
+    }
+    return 0;
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+// This program measures the fronthaul delay added by the head-of-line
+// blocking of jumbo backhaul frames on a 100 Gbit/s link, and how much of it
+// frame preemption removes.  A DU and a backhaul source are connected to an
+// RU through a bridge, and the port of the bridge towards the RU is the
+// shared link:
+//
+//  - fronthaul: eCPRI messages every "period" (PCP 7, express)
+//  - backhaul:  jumbo frames with exponential inter-arrival times (PCP 0)
+//
+// Three configurations of the port are compared: a FIFO device queue, a
+// strict priority queue disc (PrioQueueDisc) in front of a one-packet device
+// queue, and frame preemption in the device, with an MqQueueDisc that feeds
+// its preemptable and express transmission queues from one FIFO each.  One CSV line is printed per configuration with the fronthaul
+// delays (from the DU application to the RU), the backhaul bytes received,
+// the preemptions and reassembled frames, and the events and wall-clock time.
+//
+// Sample usage:
+//   ./ns3 run 'bench-preemption --duration=0.01 --bhInterval=1'
+
+#include "ns3/applications-module.h"
+#include "ns3/bridge-module.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/// Send times of the fronthaul messages in flight
+static std::deque<Time> g_fhSent;
+/// Fronthaul delays
+static std::vector<Time> g_fhDelays;
+/// Backhaul bytes received
+static uint64_t g_bhBytes = 0;
+
+/**
+ * Record the send time of a fronthaul message.
+ * \param packet the packet
+ */
+static void
+FhSent(Ptr<const Packet> packet)
+{
+    g_fhSent.push_back(Simulator::Now());
+}
+
+/**
+ * Record a message received by the RU.
+ * \param packet the packet
+ * \param from the source address
+ */
+static void
+Received(Ptr<const Packet> packet, const Address& from)
+{
+    VlanTag tag;
+    packet->PeekPacketTag(tag);
+    if (tag.GetPcp() == 7 && !g_fhSent.empty())
+    {
+        g_fhDelays.push_back(Simulator::Now() - g_fhSent.front());
+        g_fhSent.pop_front();
+    }
+    else
+    {
+        g_bhBytes += packet->GetSize();
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    double duration = 0.01;
+    std::string rate = "100Gbps";
+    double period = 2;
+    uint32_t fhSize = 1000;
+    uint32_t bhSize = 8000;
+    double bhInterval = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("duration", "Simulated time (s)", duration);
+    cmd.AddValue("rate", "Rate of the port towards the RU", rate);
+    cmd.AddValue("period", "Period of the fronthaul messages (us)", period);
+    cmd.AddValue("fhSize", "Fronthaul message size (bytes)", fhSize);
+    cmd.AddValue("bhSize", "Backhaul frame size (bytes)", bhSize);
+    cmd.AddValue("bhInterval", "Mean inter-arrival time of the backhaul frames (us)", bhInterval);
+    cmd.Parse(argc, argv);
+
+    std::cout << "config,fh_packets,fh_mean_us,fh_p99_us,fh_max_us,bh_rx_bytes,preemptions,"
+                 "reassembled,events,wall_s"
+              << std::endl;
+    for (std::string config : {"fifo", "prio", "preemption"})
+    {
+        g_fhSent.clear();
+        g_fhDelays.clear();
+        g_bhBytes = 0;
+
+        // DU, bridge, RU and backhaul source
+        NodeContainer nodes;
+        nodes.Create(4);
+        PointToPointHelper p2p;
+        p2p.SetDeviceAttribute("DataRate", StringValue("100Gbps"));
+        p2p.SetDeviceAttribute("Mtu", UintegerValue(9000));
+        p2p.SetChannelAttribute("Delay", StringValue("1us"));
+        NetDeviceContainer duLink = p2p.Install(nodes.Get(0), nodes.Get(1));
+        NetDeviceContainer bhLink = p2p.Install(nodes.Get(3), nodes.Get(1));
+        p2p.SetDeviceAttribute("DataRate", StringValue(rate));
+        p2p.SetDeviceAttribute("EnablePreemption", BooleanValue(config == "preemption"));
+        if (config != "fifo")
+        {
+            // a single packet in the device queue, for the queue disc to schedule
+            p2p.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue("1p"));
+        }
+        else
+        {
+            p2p.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue("1000p"));
+        }
+        NetDeviceContainer ruLink = p2p.Install(nodes.Get(1), nodes.Get(2));
+
+        NetDeviceContainer ports(duLink.Get(1), bhLink.Get(1));
+        ports.Add(ruLink.Get(0));
+        BridgeHelper bridge;
+        bridge.SetDeviceAttribute("EnableTrafficControl", BooleanValue(config != "fifo"));
+        bridge.Install(nodes.Get(1), ports);
+        PacketSocketHelper packetSocket;
+        packetSocket.Install(nodes);
+
+        if (config != "fifo")
+        {
+            nodes.Get(1)->AggregateObject(CreateObject<TrafficControlLayer>());
+            TrafficControlHelper tch;
+            uint16_t handle;
+            if (config == "preemption")
+            {
+                handle = tch.SetRootQueueDisc("ns3::MqQueueDisc");
+            }
+            else
+            {
+                handle = tch.SetRootQueueDisc("ns3::PrioQueueDisc");
+                tch.AddPacketFilter(handle, "ns3::PcpPacketFilter", "NBands", UintegerValue(2));
+            }
+            TrafficControlHelper::ClassIdList cid =
+                tch.AddQueueDiscClasses(handle, 2, "ns3::QueueDiscClass");
+            tch.AddChildQueueDiscs(handle,
+                                   cid,
+                                   "ns3::FifoQueueDisc",
+                                   "MaxSize",
+                                   StringValue("1000p"));
+            tch.Install(ruLink.Get(0));
+        }
+
+        Ptr<NetDevice> ruDevice = ruLink.Get(1);
+        PacketSocketAddress local;
+        local.SetSingleDevice(ruDevice->GetIfIndex());
+        local.SetProtocol(EcpriHeader::PROT_NUMBER);
+        PacketSinkHelper sinkHelper("ns3::PacketSocketFactory", local);
+        ApplicationContainer sinkApps = sinkHelper.Install(nodes.Get(2));
+        sinkApps.Get(0)->TraceConnectWithoutContext("Rx", MakeCallback(&Received));
+
+        PacketSocketAddress remote;
+        remote.SetSingleDevice(duLink.Get(0)->GetIfIndex());
+        remote.SetPhysicalAddress(ruDevice->GetAddress());
+        std::ostringstream fhGap;
+        fhGap << "ns3::ConstantRandomVariable[Constant=" << period * 1e-6 << "]";
+        OfhEcpriHelper fhHelper(remote);
+        fhHelper.SetAttribute("U-PacketSize", UintegerValue(fhSize));
+        fhHelper.SetAttribute("U-Interval", StringValue(fhGap.str()));
+        ApplicationContainer sourceApps = fhHelper.Install(nodes.Get(0));
+        sourceApps.Get(0)->TraceConnectWithoutContext("Tx", MakeCallback(&FhSent));
+
+        remote.SetSingleDevice(bhLink.Get(0)->GetIfIndex());
+        std::ostringstream bhGap;
+        bhGap << "ns3::ExponentialRandomVariable[Mean=" << bhInterval * 1e-6 << "]";
+        OfhEcpriHelper bhHelper(remote);
+        bhHelper.SetAttribute("U-PacketSize", UintegerValue(bhSize));
+        bhHelper.SetAttribute("U-Interval", StringValue(bhGap.str()));
+        bhHelper.SetAttribute("U-Pcp", UintegerValue(0));
+        sourceApps.Add(bhHelper.Install(nodes.Get(3)));
+        bhHelper.AssignStreams(nodes, 1);
+
+        sinkApps.Start(Seconds(0));
+        sourceApps.Start(Seconds(0));
+        sourceApps.Stop(Seconds(duration));
+        Simulator::Stop(Seconds(duration + 0.01));
+
+        auto start = std::chrono::steady_clock::now();
+        Simulator::Run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::sort(g_fhDelays.begin(), g_fhDelays.end());
+        Time total;
+        for (const auto& delay : g_fhDelays)
+        {
+            total += delay;
+        }
+        double mean =
+            g_fhDelays.empty() ? 0 : total.GetNanoSeconds() / 1000.0 / g_fhDelays.size();
+        double p99 = g_fhDelays.empty()
+                         ? 0
+                         : g_fhDelays[g_fhDelays.size() * 99 / 100].GetNanoSeconds() / 1000.0;
+        double worst = g_fhDelays.empty() ? 0 : g_fhDelays.back().GetNanoSeconds() / 1000.0;
+        Ptr<PointToPointNetDevice> port = DynamicCast<PointToPointNetDevice>(ruLink.Get(0));
+        Ptr<PointToPointNetDevice> ru = DynamicCast<PointToPointNetDevice>(ruDevice);
+        std::cout << config << "," << g_fhDelays.size() << "," << std::fixed
+                  << std::setprecision(3) << mean << "," << p99 << "," << worst << ","
+                  << g_bhBytes << "," << port->GetNPreemptions() << ","
+                  << ru->GetNReassembledFrames() << "," << Simulator::GetEventCount() << ","
+                  << std::setprecision(2) << elapsed.count() << std::endl;
+        Simulator::Destroy();
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the per-packet cost of draining the queue disc tree
+// used by the fronthaul scenarios (a PrioQueueDscpDisc root whose classes are
+// a FifoQueueDisc for the EF traffic and a WrrQueueDisc for the rest) with
+// the regular qdisc run and with the burst mode of QueueDisc ("BurstMode").
+//
+// The queue disc is attached to an emulated single queue device that accepts
+// "deviceSlots" packets before stopping its queue (0 means that the queue is
+// never stopped, as for a tc-unaware device).  In every round a batch of
+// packets with a mix of DSCP values is enqueued and then the queue disc is
+// run, waking the device queue after every run, until it is empty.  The
+// enqueue and the drain phases are timed separately.  With "monitors" set to
+// 1 a QueueMonitor records the occupancy of the queue disc and its classes.
+// One CSV line is printed per configuration.
+//
+// Sample usage:
+//   ./ns3 run 'bench-queue-disc --quotas=1,64 --deviceSlots=0,1,8 --monitors=0,1'
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Split a comma separated list of values.
+ * \param list the list
+ * \return the values
+ */
+static std::vector<uint32_t>
+ParseList(const std::string& list)
+{
+    std::vector<uint32_t> values;
+    std::istringstream iss(list);
+    std::string token;
+    while (std::getline(iss, token, ','))
+    {
+        if (!token.empty())
+        {
+            values.push_back(std::stoul(token));
+        }
+    }
+    return values;
+}
+
+/**
+ * Single queue device that accepts a given number of packets before
+ * stopping its transmission queue.
+ */
+class BenchDevice
+{
+  public:
+    /**
+     * Constructor
+     * \param slots the packets accepted between wake-ups (0 for no flow control)
+     */
+    BenchDevice(uint32_t slots)
+        : m_slots(slots),
+          m_inDevice(0),
+          m_sent(0)
+    {
+        m_ndqi = CreateObject<NetDeviceQueueInterface>();
+        m_txq = m_ndqi->GetTxQueue(0);
+    }
+
+    /**
+     * Send callback of the queue disc.
+     * \param item the item sent to the device
+     */
+    void Send(Ptr<QueueDiscItem> item)
+    {
+        m_sent++;
+        if (m_slots > 0 && ++m_inDevice == m_slots)
+        {
+            m_txq->Stop();
+        }
+    }
+
+    /// Transmit the packets held by the device and restart its queue
+    void Wake()
+    {
+        m_inDevice = 0;
+        m_txq->Start();
+    }
+
+    uint32_t m_slots;                      //!< Packets accepted between wake-ups
+    uint32_t m_inDevice;                   //!< Packets held by the device
+    uint64_t m_sent;                       //!< Packets sent to the device
+    Ptr<NetDeviceQueueInterface> m_ndqi;   //!< Device queue interface
+    Ptr<NetDeviceQueue> m_txq;             //!< Transmission queue
+};
+
+/**
+ * Create the Prio(Fifo, Wrr) queue disc tree of the fronthaul scenarios.
+ * \param burst whether the root queue disc runs in burst mode
+ * \param quota the quota of the root queue disc
+ * \return the root queue disc
+ */
+static Ptr<QueueDisc>
+CreateQueueDisc(bool burst, uint32_t quota)
+{
+    Ptr<QueueDisc> root = CreateObjectWithAttributes<PrioQueueDscpDisc>("Quota",
+                                                                       UintegerValue(quota),
+                                                                       "BurstMode",
+                                                                       BooleanValue(burst));
+    Ptr<QueueDisc> ef = CreateObjectWithAttributes<FifoQueueDisc>("MaxSize",
+                                                                  StringValue("100000p"));
+    Ptr<QueueDisc> wrr = CreateObjectWithAttributes<WrrQueueDisc>("Quantum",
+                                                                  StringValue("72 10 18"),
+                                                                  "MapQueue",
+                                                                  StringValue("8 0 16 1 24 2"));
+    for (const auto& child : {ef, wrr})
+    {
+        Ptr<QueueDiscClass> c = CreateObject<QueueDiscClass>();
+        c->SetQueueDisc(child);
+        root->AddQueueDiscClass(c);
+    }
+    return root;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string quotas = "1,16,64";
+    std::string deviceSlots = "0,1,8";
+    std::string monitors = "0";
+    uint32_t packets = 1000000;
+    uint32_t batch = 256;
+    uint32_t size = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("quotas", "Comma separated list of qdisc quotas", quotas);
+    cmd.AddValue("deviceSlots",
+                 "Comma separated list of packets accepted by the device between wake-ups "
+                 "(0 for a device without flow control)",
+                 deviceSlots);
+    cmd.AddValue("monitors",
+                 "Comma separated list of 0 (no monitor) and 1 (queue occupancy monitored)",
+                 monitors);
+    cmd.AddValue("packets", "Number of packets per configuration", packets);
+    cmd.AddValue("batch", "Number of packets enqueued per round", batch);
+    cmd.AddValue("size", "Packet payload size in bytes", size);
+    cmd.Parse(argc, argv);
+
+    // EF, then the three classes of the WRR queue disc
+    const uint8_t dscps[] = {46, 8, 16, 24};
+
+    std::cout << "mode,quota,device_slots,monitor,packets,runs,enqueue_ns_per_pkt,ns_per_pkt"
+              << std::endl;
+    for (uint32_t quota : ParseList(quotas))
+    {
+        for (uint32_t slots : ParseList(deviceSlots))
+        {
+            for (bool burst : {false, true})
+            {
+                for (uint32_t monitor : ParseList(monitors))
+                {
+                    BenchDevice device(slots);
+                    Ptr<QueueDisc> qdisc = CreateQueueDisc(burst, quota);
+                    qdisc->SetNetDeviceQueueInterface(device.m_ndqi);
+                    qdisc->SetSendCallback(
+                        [&device](Ptr<QueueDiscItem> item) { device.Send(item); });
+                    qdisc->Initialize();
+                    Ptr<QueueMonitor> queueMonitor;
+                    if (monitor)
+                    {
+                        queueMonitor = CreateObject<QueueMonitor>();
+                        queueMonitor->AddQueueDisc("root", qdisc);
+                    }
+
+                    std::chrono::steady_clock::duration enqueueElapsed{0};
+                    std::chrono::steady_clock::duration elapsed{0};
+                    uint64_t runs = 0;
+                    uint32_t enqueued = 0;
+                    while (enqueued < packets)
+                    {
+                        auto start = std::chrono::steady_clock::now();
+                        for (uint32_t i = 0; i < batch && enqueued < packets; i++, enqueued++)
+                        {
+                            Ipv4Header hdr;
+                            hdr.SetDscp(static_cast<Ipv4Header::DscpType>(dscps[enqueued % 4]));
+                            hdr.SetPayloadSize(size);
+                            qdisc->Enqueue(Create<Ipv4QueueDiscItem>(Create<Packet>(size),
+                                                                     Address(),
+                                                                     0x0800,
+                                                                     hdr));
+                        }
+                        enqueueElapsed += std::chrono::steady_clock::now() - start;
+
+                        start = std::chrono::steady_clock::now();
+                        while (qdisc->GetNPackets() > 0)
+                        {
+                            device.Wake();
+                            qdisc->Run();
+                            // execute the runs rescheduled in burst mode
+                            Simulator::Run();
+                            runs++;
+                        }
+                        elapsed += std::chrono::steady_clock::now() - start;
+                    }
+
+                    NS_ABORT_MSG_IF(device.m_sent != packets, "Not all the packets were sent");
+                    NS_ABORT_MSG_IF(queueMonitor && queueMonitor->GetNQueues() != 6,
+                                    "The classes of the queue disc were not monitored");
+                    double enqueueNs =
+                        std::chrono::duration<double, std::nano>(enqueueElapsed).count();
+                    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+                    std::cout << (burst ? "burst" : "regular") << "," << quota << "," << slots
+                              << "," << monitor << "," << packets << "," << runs << ","
+                              << std::fixed << std::setprecision(1) << enqueueNs / packets << ","
+                              << ns / packets << std::endl;
+
+                    if (queueMonitor)
+                    {
+                        queueMonitor->Dispose();
+                    }
+                    qdisc->Dispose();
+                    Simulator::Destroy();
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the number of samples per second drawn from the
+// random variables used by the traffic generators with the two generators
+// of RngStream (MRG32k3a and Philox4x32, see the "RngGenerator" global
+// value), one GetValue() call per sample ("scalar") and with GetValues()
+// in blocks of "block" samples ("block").  The "u01" distribution draws
+// directly from the RngStream.  One CSV line is printed per combination.
+//
+// Sample usage:
+//   ./ns3 run 'bench-random-variables --samples=10000000 --block=64'
+
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Random variable giving access to the RngStream of its stream.
+ */
+class BenchU01RandomVariable : public UniformRandomVariable
+{
+  public:
+    /**
+     * \return the RngStream
+     */
+    RngStream* GetRngStream() const
+    {
+        return Peek();
+    }
+};
+
+/**
+ * Create one of the random variables of the benchmark.
+ * \param name the distribution
+ * \return the random variable
+ */
+static Ptr<RandomVariableStream>
+CreateRandomVariable(const std::string& name)
+{
+    if (name == "uniform")
+    {
+        return CreateObjectWithAttributes<UniformRandomVariable>("Min",
+                                                                 DoubleValue(0),
+                                                                 "Max",
+                                                                 DoubleValue(100));
+    }
+    if (name == "exponential")
+    {
+        return CreateObjectWithAttributes<ExponentialRandomVariable>("Mean", DoubleValue(1e-6));
+    }
+    if (name == "normal")
+    {
+        return CreateObjectWithAttributes<NormalRandomVariable>("Mean",
+                                                                DoubleValue(1000),
+                                                                "Variance",
+                                                                DoubleValue(100));
+    }
+    Ptr<EmpiricalRandomVariable> empirical = CreateObject<EmpiricalRandomVariable>();
+    // a packet size distribution with a few modes
+    empirical->CDF(64, 0.3);
+    empirical->CDF(576, 0.5);
+    empirical->CDF(1358, 0.7);
+    empirical->CDF(1450, 0.9);
+    empirical->CDF(7680, 1.0);
+    return empirical;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t samples = 10000000;
+    uint32_t block = 64;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("samples", "Number of samples per combination", samples);
+    cmd.AddValue("block", "Number of samples per GetValues call", block);
+    cmd.Parse(argc, argv);
+
+    std::vector<double> values(block);
+    double sum = 0;
+
+    std::cout << "generator,distribution,mode,samples,msamples_per_s" << std::endl;
+    for (auto generator : {RngStream::MRG32K3A, RngStream::PHILOX4X32})
+    {
+        RngSeedManager::SetGenerator(generator);
+        for (std::string name : {"u01", "uniform", "exponential", "normal", "empirical"})
+        {
+            for (bool blocks : {false, true})
+            {
+                Ptr<RandomVariableStream> rv;
+                RngStream* rng = nullptr;
+                if (name == "u01")
+                {
+                    Ptr<BenchU01RandomVariable> u01 = CreateObject<BenchU01RandomVariable>();
+                    rng = u01->GetRngStream();
+                    rv = u01;
+                }
+                else
+                {
+                    rv = CreateRandomVariable(name);
+                }
+
+                auto start = std::chrono::steady_clock::now();
+                for (uint32_t done = 0; done < samples; done += block)
+                {
+                    if (blocks && rng)
+                    {
+                        rng->RandU01(values.data(), block);
+                    }
+                    else if (blocks)
+                    {
+                        rv->GetValues(values.data(), block);
+                    }
+                    else if (rng)
+                    {
+                        for (uint32_t i = 0; i < block; i++)
+                        {
+                            values[i] = rng->RandU01();
+                        }
+                    }
+                    else
+                    {
+                        for (uint32_t i = 0; i < block; i++)
+                        {
+                            values[i] = rv->GetValue();
+                        }
+                    }
+                    sum += values[done % block];
+                }
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+                std::cout << (generator == RngStream::MRG32K3A ? "MRG32k3a" : "Philox4x32") << ","
+                          << name << "," << (blocks ? "block" : "scalar") << "," << samples << ","
+                          << std::fixed << std::setprecision(1)
+                          << samples / elapsed.count() / 1e6 << std::endl;
+            }
+        }
+    }
+    // keep the samples alive
+    NS_ABORT_MSG_IF(sum < 0, "Negative sum of samples");
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+// This program measures the serialization times per second computed with
+// the former 64.64 fixed-point division of DataRate, with the exact integer
+// DataRate::CalculateBytesTxTime and with a SerializationTime, single
+// (GetBytesTxTime) and carried (NextBytesTxTime).  The frames cycle over
+// sizes from 64 to 1518 bytes.  One CSV line is printed per method with the
+// drift of the sum of the times from the exact time of all the bytes.
+//
+// Sample usage:
+//   ./ns3 run 'bench-serialization-time --frames=100000000 --rate=9953280000bps'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t frames = 100000000;
+    DataRate rate("9953280000bps");
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("frames", "Number of frames per method", frames);
+    cmd.AddValue("rate", "Rate of the transmitter", rate);
+    cmd.Parse(argc, argv);
+    Time::SetResolution(Time::PS);
+    // stop marking the Times to convert, as a simulation does
+    Simulator::Run();
+
+    std::cout << "method,rate_bps,frames,mframes_per_s,drift_ps" << std::endl;
+    const std::string methods[] = {"int64x64", "datarate", "get", "next"};
+    for (int method = 0; method < 4; method++)
+    {
+        SerializationTime txTime(rate);
+        uint64_t bytes = 0;
+        Time total;
+        uint32_t size = 64;
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < frames; i++)
+        {
+            size += 733;
+            if (size > 1518)
+            {
+                size -= 1455;
+            }
+            bytes += size;
+            switch (method)
+            {
+            case 0:
+                total += Seconds(int64x64_t(size * 8) / rate.GetBitRate());
+                break;
+            case 1:
+                total += rate.CalculateBytesTxTime(size);
+                break;
+            case 2:
+                total += txTime.GetBytesTxTime(size);
+                break;
+            default:
+                total += txTime.NextBytesTxTime(size);
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        Time exact = SerializationTime::BitsTxTime(bytes * 8, rate.GetBitRate());
+        std::cout << methods[method] << "," << rate.GetBitRate() << "," << frames << "," << std::fixed
+                  << std::setprecision(1) << frames / elapsed.count() / 1e6 << ","
+                  << (total - exact).GetPicoSeconds() << std::endl;
+    }
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+// This program measures the wall clock time of independent replications of a
+// small network run one after the other and in parallel threads with
+// SimulationContext.  Every replication is a node sending the traffic of a
+// site, one Poissonapp per cell, to a sink node over SimpleNetDevices.  One
+// CSV line is printed per number of threads with the replications, the
+// packets received by all of them (the same for any number of threads), the
+// wall clock time and the speedup over one thread.
+//
+// Sample usage:
+//   ./ns3 run 'bench-simulation-context --replications=8 --cells=12 --maxThreads=8'
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Run a replication.
+ * \param replication the index of the replication
+ * \param cells the number of cells of the site
+ * \param duration the simulated time, in seconds
+ * \return the packets received
+ */
+static uint64_t
+RunReplication(uint32_t replication, uint32_t cells, double duration)
+{
+    RngSeedManager::SetRun(replication + 1);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    ApplicationContainer sinks;
+    ApplicationContainer sources;
+    for (uint32_t c = 0; c < cells; c++)
+    {
+        InetSocketAddress address(interfaces.GetAddress(1), 8000 + c);
+        PacketSinkHelper sinkHelper("ns3::UdpSocketFactory", address);
+        sinks.Add(sinkHelper.Install(nodes.Get(1)));
+        PoissonHelper poissonHelper("ns3::UdpSocketFactory", address);
+        poissonHelper.SetAttribute("PacketSize", UintegerValue(1000));
+        poissonHelper.SetAttribute("Interval", DoubleValue(1e-4));
+        sources.Add(poissonHelper.Install(nodes.Get(0)));
+    }
+    sinks.Start(Seconds(0));
+    sources.Start(Seconds(0));
+    Simulator::Stop(Seconds(duration));
+    Simulator::Run();
+
+    uint64_t packets = 0;
+    for (uint32_t c = 0; c < cells; c++)
+    {
+        packets += DynamicCast<PacketSink>(sinks.Get(c))->GetTotalRx() / 1000;
+    }
+    return packets;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t replications = 8;
+    uint32_t cells = 12;
+    double duration = 1;
+    uint32_t hardware = std::max(1U, std::thread::hardware_concurrency());
+    uint32_t maxThreads = hardware;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("replications", "Number of replications", replications);
+    cmd.AddValue("cells", "Number of cells of the site", cells);
+    cmd.AddValue("duration", "Simulated time of a replication, in seconds", duration);
+    cmd.AddValue("maxThreads", "Largest number of threads", maxThreads);
+    cmd.Parse(argc, argv);
+
+    maxThreads = std::min(maxThreads, replications);
+    std::vector<uint32_t> threadCounts{1};
+    for (uint32_t threads = 2; threads < maxThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    if (maxThreads > 1)
+    {
+        threadCounts.push_back(maxThreads);
+    }
+
+    std::cout << "# hardware threads: " << hardware << std::endl;
+    std::cout << "threads,replications,packets,wall_ms,speedup" << std::endl;
+    double sequentialMs = 0;
+    for (uint32_t threads : threadCounts)
+    {
+        std::vector<uint64_t> packets(replications);
+        auto start = std::chrono::steady_clock::now();
+        SimulationContext::Run(
+            replications,
+            [&](uint32_t replication) {
+                packets[replication] = RunReplication(replication, cells, duration);
+            },
+            threads);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                              start)
+                        .count();
+        if (threads == 1)
+        {
+            sequentialMs = ms;
+        }
+        std::cout << threads << "," << replications << ","
+                  << std::accumulate(packets.begin(), packets.end(), uint64_t{0}) << ","
+                  << std::fixed << std::setprecision(1) << ms << "," << std::setprecision(2)
+                  << sequentialMs / ms << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the cost of generating the traffic of the cells of
+// a site with one Poissonapp per cell and with one SiteTrafficAggregator per
+// site, and of receiving it with one PacketSink per cell and with one
+// MultiPortSink per site.  Each site is a node sending to a sink node over
+// SimpleNetDevices.  One CSV line is printed per combination with the source
+// and sink applications, the executed events and the wall clock time of the
+// run.
+//
+// Sample usage:
+//   ./ns3 run 'bench-site-aggregator --sites=10 --cells=12 --duration=1'
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t sites = 10;
+    uint32_t cells = 12;
+    double duration = 1;
+    double interval = 100e-6;
+    uint32_t packetSize = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("sites", "Number of sites", sites);
+    cmd.AddValue("cells", "Number of cells per site", cells);
+    cmd.AddValue("duration", "Simulated time (s)", duration);
+    cmd.AddValue("interval", "Mean inter-arrival time of a cell (s)", interval);
+    cmd.AddValue("packetSize", "Mean packet size (bytes)", packetSize);
+    cmd.Parse(argc, argv);
+
+    std::cout << "method,sink,sites,cells,apps,sink_apps,events,rx_bytes,wall_s" << std::endl;
+    for (std::string method : {"poissonapp", "aggregator"})
+    {
+        for (std::string sinkType : {"packetsink", "multiport"})
+        {
+            NodeContainer sources;
+            sources.Create(sites);
+            Ptr<Node> sink = CreateObject<Node>();
+            NodeContainer nodes(sources, NodeContainer(sink));
+            SimpleNetDeviceHelper simpleHelper;
+            NetDeviceContainer devices = simpleHelper.Install(nodes);
+            InternetStackHelper internet;
+            internet.Install(nodes);
+            Ipv4AddressHelper ipv4;
+            ipv4.SetBase("10.1.0.0", "255.255.0.0");
+            Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+            NeighborCacheHelper neighborCache;
+            neighborCache.PopulateNeighborCache();
+            Ipv4Address sinkAddress = interfaces.GetAddress(sites);
+
+            ApplicationContainer sinkApps;
+            ApplicationContainer sourceApps;
+            for (uint32_t s = 0; s < sites; s++)
+            {
+                SiteTrafficAggregatorHelper aggregatorHelper("ns3::UdpSocketFactory");
+                if (sinkType == "multiport")
+                {
+                    MultiPortSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                                   InetSocketAddress(sinkAddress, 8080 + s * cells),
+                                                   cells);
+                    sinkApps.Add(sinkHelper.Install(sink));
+                }
+                for (uint32_t c = 0; c < cells; c++)
+                {
+                    InetSocketAddress address(sinkAddress, 8080 + s * cells + c);
+                    if (sinkType == "packetsink")
+                    {
+                        PacketSinkHelper sinkHelper("ns3::UdpSocketFactory", address);
+                        sinkApps.Add(sinkHelper.Install(sink));
+                    }
+                    if (method == "aggregator")
+                    {
+                        aggregatorHelper.AddPoissonFlow(address, packetSize, interval);
+                    }
+                    else
+                    {
+                        PoissonHelper poissonHelper("ns3::UdpSocketFactory", address);
+                        poissonHelper.SetAttribute("PacketSize", UintegerValue(packetSize));
+                        poissonHelper.SetAttribute("Interval", DoubleValue(interval));
+                        sourceApps.Add(poissonHelper.Install(sources.Get(s)));
+                    }
+                }
+                if (method == "aggregator")
+                {
+                    sourceApps.Add(aggregatorHelper.Install(sources.Get(s)));
+                }
+            }
+            sinkApps.Start(Seconds(0));
+            sourceApps.Start(Seconds(0));
+            Simulator::Stop(Seconds(duration));
+
+            auto start = std::chrono::steady_clock::now();
+            Simulator::Run();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            uint64_t bytes = 0;
+            for (uint32_t i = 0; i < sinkApps.GetN(); i++)
+            {
+                if (sinkType == "packetsink")
+                {
+                    bytes += DynamicCast<PacketSink>(sinkApps.Get(i))->GetTotalRx();
+                }
+                else
+                {
+                    bytes += DynamicCast<MultiPortSink>(sinkApps.Get(i))->GetTotalRx();
+                }
+            }
+            std::cout << method << "," << sinkType << "," << sites << "," << cells << ","
+                      << sourceApps.GetN() << "," << sinkApps.GetN() << ","
+                      << Simulator::GetEventCount() << "," << bytes << "," << std::fixed
+                      << std::setprecision(2) << elapsed.count() << std::endl;
+            Simulator::Destroy();
+        }
+    }
+    return 0;
+}
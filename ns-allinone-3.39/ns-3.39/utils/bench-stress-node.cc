@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program stresses a single N-port node using the switching model of
+// PointToPointNetDevice and a queue disc on every output port.  Each port is
+// connected to a peer node whose in-process source injects packets directly
+// at the device layer (no IP stack, no sockets, no applications), so the
+// measured cost is that of PointToPointNetDevice, the channel and the
+// traffic-control layer.
+//
+// The program sweeps the number of ports, the packet size and the offered
+// load per port (as a fraction of the port rate) and prints one CSV line per
+// point with the delay percentiles, the losses and the wall-clock packet
+// rate of the simulator.  It can be used both to obtain the saturation
+// curves of the backplane ("SwitchingCapacity") and as a performance
+// regression benchmark.
+//
+// Sample usage:
+//   ./ns3 run 'bench-stress-node --ports=4,8 --sizes=64,1500 --loads=0.5,0.9'
+
+#include "ns3/command-line.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/traffic-control-module.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/// Protocol number used by the packets exchanged through the node
+static const uint16_t BENCH_PROTOCOL = 0x0800;
+
+/**
+ * Split a comma separated list of values.
+ * \param list the list
+ * \return the values
+ */
+template <typename T>
+static std::vector<T>
+ParseList(const std::string& list)
+{
+    std::vector<T> values;
+    std::istringstream iss(list);
+    std::string token;
+    while (std::getline(iss, token, ','))
+    {
+        if (token.empty())
+        {
+            continue;
+        }
+        std::istringstream value(token);
+        T v;
+        value >> v;
+        values.push_back(v);
+    }
+    return values;
+}
+
+/// Queue disc item without L3 header, used to send raw packets through the
+/// traffic-control layer
+class BenchQueueDiscItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Create a queue disc item.
+     * \param p the packet
+     * \param addr the destination address
+     * \param protocol the protocol number
+     */
+    BenchQueueDiscItem(Ptr<Packet> p, const Address& addr, uint16_t protocol)
+        : QueueDiscItem(p, addr, protocol)
+    {
+    }
+
+    void AddHeader() override
+    {
+    }
+
+    bool Mark() override
+    {
+        return false;
+    }
+};
+
+/// Parameters of a benchmark point
+struct StressConfig
+{
+    uint32_t ports;           //!< Number of ports of the node
+    uint32_t size;            //!< Packet size (bytes)
+    double load;              //!< Offered load per port, as a fraction of the port rate
+    DataRate rate;            //!< Port rate
+    DataRate switching;       //!< Switching capacity of each port
+    bool switchingEnabled;    //!< Enable the switching model
+    std::string queueDisc;    //!< Queue disc type
+    std::string queueDiscSize; //!< Queue disc size
+    std::string deviceQueue;  //!< Device transmission queue size
+    std::string rxQueue;      //!< Switching (reception) queue size
+    std::string pattern;      //!< Traffic pattern
+    bool poisson;             //!< Exponential inter-arrival times
+    Time duration;            //!< Time during which the sources are active
+    Time drain;               //!< Time to drain the queues after the sources stop
+};
+
+/// Results of a benchmark point
+struct StressResult
+{
+    uint64_t sent{0};           //!< Packets injected by the sources
+    uint64_t received{0};       //!< Packets received by the sinks
+    uint64_t forwarded{0};      //!< Packets forwarded by the node
+    uint64_t queueDiscDrops{0}; //!< Packets dropped by the queue discs
+    uint64_t rxQueueDrops{0};   //!< Packets dropped by the switching queues
+    uint64_t txQueueDrops{0};   //!< Packets dropped by the device queues
+    uint64_t events{0};         //!< Simulator events executed
+    double wallSeconds{0};      //!< Wall-clock time of the run
+    std::vector<double> delays; //!< Per packet delays (s)
+};
+
+/**
+ * One N-port node stressed by sources injecting packets at the device layer
+ * of its peers.
+ */
+class StressNode
+{
+  public:
+    /**
+     * Build the topology.
+     * \param config the parameters of the point
+     */
+    StressNode(const StressConfig& config);
+
+    /**
+     * Run the point.
+     * \return the results
+     */
+    StressResult Run();
+
+  private:
+    /**
+     * Send a packet from the source of a port and schedule the next one.
+     * \param port the port
+     */
+    void Send(uint32_t port);
+
+    /**
+     * Forward a packet received by the node to its output port.
+     * \param device the input device
+     * \param packet the packet
+     * \param protocol the protocol number
+     * \param from the source address
+     * \param to the destination address
+     * \param packetType the packet type
+     */
+    void Forward(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from,
+                 const Address& to,
+                 NetDevice::PacketType packetType);
+
+    /**
+     * Account for a packet received by a sink.
+     * \param device the sink device
+     * \param packet the packet
+     * \param protocol the protocol number
+     * \param from the source address
+     * \param to the destination address
+     * \param packetType the packet type
+     */
+    void Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from,
+                 const Address& to,
+                 NetDevice::PacketType packetType);
+
+    /**
+     * Count a dropped packet.
+     * \param counter the counter to increment
+     * \param packet the packet
+     */
+    void CountDrop(uint64_t* counter, Ptr<const Packet> packet);
+
+    /**
+     * Count a dropped queue disc item.
+     * \param item the item
+     */
+    void CountQueueDiscDrop(Ptr<const QueueDiscItem> item);
+
+    StressConfig m_config;                       //!< Parameters of the point
+    Ptr<Node> m_node;                            //!< Node under test
+    Ptr<TrafficControlLayer> m_tc;               //!< Traffic-control layer of the node
+    NetDeviceContainer m_ports;                  //!< Ports of the node
+    NetDeviceContainer m_peers;                  //!< Devices of the peers
+    std::vector<uint32_t> m_portIndex;           //!< Port of each node device, by ifIndex
+    Ptr<RandomVariableStream> m_interArrival;    //!< Inter-arrival times (s)
+    Ptr<UniformRandomVariable> m_output;         //!< Output port selection
+    uint64_t m_firstUid;                         //!< Uid of the first packet
+    std::vector<Time> m_sendTime;                //!< Send time of each packet, by uid
+    StressResult m_result;                       //!< Results
+};
+
+StressNode::StressNode(const StressConfig& config)
+    : m_config(config),
+      m_firstUid(0)
+{
+    m_node = CreateObject<Node>();
+    m_tc = CreateObject<TrafficControlLayer>();
+    m_node->AggregateObject(m_tc);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", DataRateValue(m_config.rate));
+    p2p.SetChannelAttribute("Delay", TimeValue(Seconds(0)));
+    p2p.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue(m_config.deviceQueue));
+
+    NodeContainer peers;
+    peers.Create(m_config.ports);
+    for (uint32_t i = 0; i < m_config.ports; i++)
+    {
+        NetDeviceContainer link = p2p.Install(m_node, peers.Get(i));
+        Ptr<PointToPointNetDevice> port = DynamicCast<PointToPointNetDevice>(link.Get(0));
+        port->SetAttribute("EnableSwithcingTime", BooleanValue(m_config.switchingEnabled));
+        port->SetAttribute("SwitchingCapacity", DataRateValue(m_config.switching));
+        port->GetRxQueue()->SetAttribute("MaxSize", StringValue(m_config.rxQueue));
+        port->GetRxQueue()->TraceConnectWithoutContext(
+            "Drop",
+            MakeCallback(&StressNode::CountDrop, this).Bind(&m_result.rxQueueDrops));
+        port->GetQueue()->TraceConnectWithoutContext(
+            "Drop",
+            MakeCallback(&StressNode::CountDrop, this).Bind(&m_result.txQueueDrops));
+        m_node->RegisterProtocolHandler(MakeCallback(&StressNode::Forward, this), 0, port, false);
+        m_ports.Add(port);
+
+        // the sources must not be limited by the queue of their own device
+        Ptr<PointToPointNetDevice> peer = DynamicCast<PointToPointNetDevice>(link.Get(1));
+        peer->GetQueue()->SetAttribute("MaxSize", StringValue("100000p"));
+        peer->GetQueue()->TraceConnectWithoutContext(
+            "Drop",
+            MakeCallback(&StressNode::CountDrop, this).Bind(&m_result.txQueueDrops));
+        peers.Get(i)->RegisterProtocolHandler(MakeCallback(&StressNode::Receive, this),
+                                              0,
+                                              peer,
+                                              false);
+        m_peers.Add(peer);
+
+        if (m_portIndex.size() <= port->GetIfIndex())
+        {
+            m_portIndex.resize(port->GetIfIndex() + 1);
+        }
+        m_portIndex[port->GetIfIndex()] = i;
+    }
+
+    TrafficControlHelper tch;
+    tch.SetRootQueueDisc(m_config.queueDisc, "MaxSize", StringValue(m_config.queueDiscSize));
+    QueueDiscContainer qdiscs = tch.Install(m_ports);
+    for (uint32_t i = 0; i < qdiscs.GetN(); i++)
+    {
+        qdiscs.Get(i)->TraceConnectWithoutContext(
+            "Drop",
+            MakeCallback(&StressNode::CountQueueDiscDrop, this));
+    }
+
+    double meanGap = m_config.size * 8.0 / (m_config.rate.GetBitRate() * m_config.load);
+    if (m_config.poisson)
+    {
+        Ptr<ExponentialRandomVariable> exp = CreateObject<ExponentialRandomVariable>();
+        exp->SetAttribute("Mean", DoubleValue(meanGap));
+        m_interArrival = exp;
+    }
+    else
+    {
+        Ptr<ConstantRandomVariable> cst = CreateObject<ConstantRandomVariable>();
+        cst->SetAttribute("Constant", DoubleValue(meanGap));
+        m_interArrival = cst;
+    }
+    m_output = CreateObject<UniformRandomVariable>();
+}
+
+void
+StressNode::Send(uint32_t port)
+{
+    if (Simulator::Now() >= m_config.duration)
+    {
+        return;
+    }
+    Ptr<Packet> p = Create<Packet>(m_config.size);
+    uint64_t index = p->GetUid() - m_firstUid;
+    if (m_sendTime.size() <= index)
+    {
+        m_sendTime.resize(std::max<uint64_t>(index + 1, 2 * m_sendTime.size()));
+    }
+    m_sendTime[index] = Simulator::Now();
+    m_result.sent++;
+    Ptr<NetDevice> peer = m_peers.Get(port);
+    peer->Send(p, peer->GetBroadcast(), BENCH_PROTOCOL);
+    Simulator::Schedule(Seconds(m_interArrival->GetValue()), &StressNode::Send, this, port);
+}
+
+void
+StressNode::Forward(Ptr<NetDevice> device,
+                    Ptr<const Packet> packet,
+                    uint16_t protocol,
+                    const Address& from,
+                    const Address& to,
+                    NetDevice::PacketType packetType)
+{
+    uint32_t in = m_portIndex[device->GetIfIndex()];
+    uint32_t out;
+    if (m_config.pattern == "uniform")
+    {
+        // any port but the input one
+        out = m_output->GetInteger(0, m_config.ports - 2);
+        out += out >= in ? 1 : 0;
+    }
+    else
+    {
+        out = (in + 1) % m_config.ports;
+    }
+    m_result.forwarded++;
+    Ptr<NetDevice> port = m_ports.Get(out);
+    m_tc->Send(port, Create<BenchQueueDiscItem>(packet->Copy(), port->GetBroadcast(), protocol));
+}
+
+void
+StressNode::Receive(Ptr<NetDevice> device,
+                    Ptr<const Packet> packet,
+                    uint16_t protocol,
+                    const Address& from,
+                    const Address& to,
+                    NetDevice::PacketType packetType)
+{
+    m_result.received++;
+    Time delay = Simulator::Now() - m_sendTime[packet->GetUid() - m_firstUid];
+    m_result.delays.push_back(delay.GetSeconds());
+}
+
+void
+StressNode::CountDrop(uint64_t* counter, Ptr<const Packet> packet)
+{
+    (*counter)++;
+}
+
+void
+StressNode::CountQueueDiscDrop(Ptr<const QueueDiscItem> item)
+{
+    m_result.queueDiscDrops++;
+}
+
+StressResult
+StressNode::Run()
+{
+    m_firstUid = Create<Packet>()->GetUid() + 1;
+    uint64_t expected = m_config.ports * m_config.duration.GetSeconds() * m_config.load *
+                        m_config.rate.GetBitRate() / (m_config.size * 8.0);
+    m_sendTime.resize(expected + expected / 8 + 1024);
+    m_result.delays.reserve(expected);
+
+    for (uint32_t i = 0; i < m_config.ports; i++)
+    {
+        // desynchronize the sources
+        Simulator::Schedule(Seconds(m_interArrival->GetValue() * i / m_config.ports),
+                            &StressNode::Send,
+                            this,
+                            i);
+    }
+    Simulator::Stop(m_config.duration + m_config.drain);
+
+    SystemWallClockMs clock;
+    clock.Start();
+    Simulator::Run();
+    m_result.wallSeconds = clock.End() / 1000.0;
+    m_result.events = Simulator::GetEventCount();
+    Simulator::Destroy();
+    return m_result;
+}
+
+/**
+ * Get a percentile of a sample.
+ * \param values the sample, partially reordered by the call
+ * \param q the quantile, in [0, 1]
+ * \return the value
+ */
+static double
+Percentile(std::vector<double>& values, double q)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    std::size_t k = std::min<std::size_t>(values.size() - 1, q * values.size());
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string ports = "2,4,8";
+    std::string sizes = "64,512,1500";
+    std::string loads = "0.1,0.3,0.5,0.7,0.8,0.9,0.95";
+    StressConfig config;
+    config.rate = DataRate("10Gbps");
+    config.switching = DataRate("20Gbps");
+    config.switchingEnabled = true;
+    config.queueDisc = "ns3::FifoQueueDisc";
+    config.queueDiscSize = "1000p";
+    config.deviceQueue = "1p";
+    config.rxQueue = "1000p";
+    config.pattern = "permutation";
+    config.poisson = true;
+    config.duration = MilliSeconds(10);
+    config.drain = MilliSeconds(10);
+    uint32_t seed = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("ports", "Comma separated numbers of ports", ports);
+    cmd.AddValue("sizes", "Comma separated packet sizes (bytes)", sizes);
+    cmd.AddValue("loads", "Comma separated offered loads per port (fraction of the rate)", loads);
+    cmd.AddValue("rate", "Port rate", config.rate);
+    cmd.AddValue("switching", "Switching capacity of each port", config.switching);
+    cmd.AddValue("enableSwitching", "Enable the switching model", config.switchingEnabled);
+    cmd.AddValue("queueDisc", "Queue disc of the output ports", config.queueDisc);
+    cmd.AddValue("queueDiscSize", "Size of the queue discs", config.queueDiscSize);
+    cmd.AddValue("deviceQueue", "Size of the device transmission queues", config.deviceQueue);
+    cmd.AddValue("rxQueue", "Size of the switching queues", config.rxQueue);
+    cmd.AddValue("pattern", "Traffic pattern: permutation (port i to i+1) or uniform", config.pattern);
+    cmd.AddValue("poisson", "Exponential inter-arrival times (otherwise constant)", config.poisson);
+    cmd.AddValue("duration", "Time during which the sources are active", config.duration);
+    cmd.AddValue("drain", "Time to drain the queues after the sources stop", config.drain);
+    cmd.AddValue("seed", "Run number of the random number generator", seed);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(config.pattern != "permutation" && config.pattern != "uniform",
+                    "Unknown traffic pattern " << config.pattern);
+    RngSeedManager::SetRun(seed);
+
+    std::cout << "ports,size,load,sent,received,lost,loss,qdisc_drops,rx_drops,tx_drops,"
+                 "p50_us,p90_us,p99_us,p999_us,max_us,wall_s,pkt_per_s,events_per_s"
+              << std::endl;
+    for (uint32_t n : ParseList<uint32_t>(ports))
+    {
+        NS_ABORT_MSG_IF(n < 2, "At least two ports are needed");
+        for (uint32_t size : ParseList<uint32_t>(sizes))
+        {
+            for (double load : ParseList<double>(loads))
+            {
+                config.ports = n;
+                config.size = size;
+                config.load = load;
+                StressResult r = StressNode(config).Run();
+
+                uint64_t lost = r.sent - r.received;
+                double loss = r.sent ? static_cast<double>(lost) / r.sent : 0;
+                // packets handled by the node per second of wall-clock time
+                double pps = r.wallSeconds > 0 ? r.forwarded / r.wallSeconds : 0;
+                double eps = r.wallSeconds > 0 ? r.events / r.wallSeconds : 0;
+                std::cout << n << "," << size << "," << load << "," << r.sent << ","
+                          << r.received << "," << lost << "," << loss << "," << r.queueDiscDrops
+                          << "," << r.rxQueueDrops << "," << r.txQueueDrops << ","
+                          << Percentile(r.delays, 0.5) * 1e6 << ","
+                          << Percentile(r.delays, 0.9) * 1e6 << ","
+                          << Percentile(r.delays, 0.99) * 1e6 << ","
+                          << Percentile(r.delays, 0.999) * 1e6 << ","
+                          << Percentile(r.delays, 1) * 1e6 << "," << r.wallSeconds << ","
+                          << std::fixed << std::setprecision(0) << pps << "," << eps
+                          << std::defaultfloat << std::setprecision(6) << std::endl;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+// This program measures how a time-aware shaper (TasQueueDisc) protects the
+// fronthaul from the bursts of jumbo backhaul frames, compared with a strict
+// priority queue disc (PrioQueueDisc).  A DU and a backhaul source are
+// connected to an RU through a bridge; both queue discs are installed on the
+// bridge port towards the RU, classifying by PCP:
+//
+//  - fronthaul: eCPRI messages every "period" (PCP 7, class 0)
+//  - backhaul:  jumbo frames with exponential inter-arrival times (PCP 0, class 1)
+//
+// The TAS opens the gate of the fronthaul during the first "window" of every
+// period and the gate of the backhaul the rest of the cycle, with guard
+// bands.  One CSV line is printed per queue disc with the fronthaul delays
+// (from the DU application to the RU), the backhaul bytes received, the
+// gate-induced latency per class and the gate events against the GCL
+// entries elapsed.
+//
+// Sample usage:
+//   ./ns3 run 'bench-tas --duration=0.1 --bhInterval=10'
+
+#include "ns3/applications-module.h"
+#include "ns3/bridge-module.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/// Send times of the fronthaul messages in flight
+static std::deque<Time> g_fhSent;
+/// Fronthaul delays
+static std::vector<Time> g_fhDelays;
+/// Backhaul bytes received
+static uint64_t g_bhBytes = 0;
+
+/**
+ * Record the send time of a fronthaul message.
+ * \param packet the packet
+ */
+static void
+FhSent(Ptr<const Packet> packet)
+{
+    g_fhSent.push_back(Simulator::Now());
+}
+
+/**
+ * Record a message received by the RU.
+ * \param packet the packet
+ * \param from the source address
+ */
+static void
+Received(Ptr<const Packet> packet, const Address& from)
+{
+    VlanTag tag;
+    packet->PeekPacketTag(tag);
+    if (tag.GetPcp() == 7 && !g_fhSent.empty())
+    {
+        g_fhDelays.push_back(Simulator::Now() - g_fhSent.front());
+        g_fhSent.pop_front();
+    }
+    else
+    {
+        g_bhBytes += packet->GetSize();
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    double duration = 0.1;
+    std::string rate = "10Gbps";
+    double period = 10;
+    double window = 3;
+    uint32_t fhSize = 1000;
+    uint32_t bhSize = 8000;
+    double bhInterval = 20;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("duration", "Simulated time (s)", duration);
+    cmd.AddValue("rate", "Rate of the port towards the RU", rate);
+    cmd.AddValue("period", "Period of the fronthaul messages and of the GCL (us)", period);
+    cmd.AddValue("window", "Window of the fronthaul gate (us)", window);
+    cmd.AddValue("fhSize", "Fronthaul message size (bytes)", fhSize);
+    cmd.AddValue("bhSize", "Backhaul frame size (bytes)", bhSize);
+    cmd.AddValue("bhInterval", "Mean inter-arrival time of the backhaul frames (us)", bhInterval);
+    cmd.Parse(argc, argv);
+
+    std::cout << "qdisc,fh_packets,fh_mean_us,fh_max_us,bh_rx_bytes,gate_delay0_us,"
+                 "gate_delay1_us,gate_events,gcl_entries,events,wall_s"
+              << std::endl;
+    for (std::string qdisc : {"prio", "tas"})
+    {
+        g_fhSent.clear();
+        g_fhDelays.clear();
+        g_bhBytes = 0;
+
+        // DU, bridge, RU and backhaul source
+        NodeContainer nodes;
+        nodes.Create(4);
+        PointToPointHelper p2p;
+        p2p.SetDeviceAttribute("DataRate", StringValue("100Gbps"));
+        p2p.SetDeviceAttribute("Mtu", UintegerValue(9000));
+        p2p.SetChannelAttribute("Delay", StringValue("1us"));
+        NetDeviceContainer duLink = p2p.Install(nodes.Get(0), nodes.Get(1));
+        NetDeviceContainer bhLink = p2p.Install(nodes.Get(3), nodes.Get(1));
+        // a single packet in the device queue, for the queue disc to schedule
+        p2p.SetDeviceAttribute("DataRate", StringValue(rate));
+        p2p.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue("1p"));
+        NetDeviceContainer ruLink = p2p.Install(nodes.Get(1), nodes.Get(2));
+
+        NetDeviceContainer ports(duLink.Get(1), bhLink.Get(1));
+        ports.Add(ruLink.Get(0));
+        BridgeHelper bridge;
+        bridge.SetDeviceAttribute("EnableTrafficControl", BooleanValue(true));
+        bridge.Install(nodes.Get(1), ports);
+        nodes.Get(1)->AggregateObject(CreateObject<TrafficControlLayer>());
+        PacketSocketHelper packetSocket;
+        packetSocket.Install(nodes);
+
+        TrafficControlHelper tch;
+        uint16_t handle;
+        if (qdisc == "tas")
+        {
+            std::ostringstream gcl;
+            gcl << "0x1 " << window << "us; 0x2 " << period - window << "us";
+            handle = tch.SetRootQueueDisc("ns3::TasQueueDisc",
+                                          "GateControlList",
+                                          StringValue(gcl.str()),
+                                          "LinkRate",
+                                          StringValue(rate));
+        }
+        else
+        {
+            handle = tch.SetRootQueueDisc("ns3::PrioQueueDisc");
+        }
+        tch.AddPacketFilter(handle, "ns3::PcpPacketFilter", "NBands", UintegerValue(2));
+        TrafficControlHelper::ClassIdList cid =
+            tch.AddQueueDiscClasses(handle, 2, "ns3::QueueDiscClass");
+        tch.AddChildQueueDiscs(handle, cid, "ns3::FifoQueueDisc", "MaxSize", StringValue("1000p"));
+        QueueDiscContainer qdiscs = tch.Install(ruLink.Get(0));
+
+        Ptr<NetDevice> ruDevice = ruLink.Get(1);
+        PacketSocketAddress local;
+        local.SetSingleDevice(ruDevice->GetIfIndex());
+        local.SetProtocol(EcpriHeader::PROT_NUMBER);
+        PacketSinkHelper sinkHelper("ns3::PacketSocketFactory", local);
+        ApplicationContainer sinkApps = sinkHelper.Install(nodes.Get(2));
+        sinkApps.Get(0)->TraceConnectWithoutContext("Rx", MakeCallback(&Received));
+
+        PacketSocketAddress remote;
+        remote.SetSingleDevice(duLink.Get(0)->GetIfIndex());
+        remote.SetPhysicalAddress(ruDevice->GetAddress());
+        std::ostringstream fhGap;
+        fhGap << "ns3::ConstantRandomVariable[Constant=" << period * 1e-6 << "]";
+        OfhEcpriHelper fhHelper(remote);
+        fhHelper.SetAttribute("U-PacketSize", UintegerValue(fhSize));
+        fhHelper.SetAttribute("U-Interval", StringValue(fhGap.str()));
+        ApplicationContainer sourceApps = fhHelper.Install(nodes.Get(0));
+        sourceApps.Get(0)->TraceConnectWithoutContext("Tx", MakeCallback(&FhSent));
+
+        remote.SetSingleDevice(bhLink.Get(0)->GetIfIndex());
+        std::ostringstream bhGap;
+        bhGap << "ns3::ExponentialRandomVariable[Mean=" << bhInterval * 1e-6 << "]";
+        OfhEcpriHelper bhHelper(remote);
+        bhHelper.SetAttribute("U-PacketSize", UintegerValue(bhSize));
+        bhHelper.SetAttribute("U-Interval", StringValue(bhGap.str()));
+        bhHelper.SetAttribute("U-Pcp", UintegerValue(0));
+        sourceApps.Add(bhHelper.Install(nodes.Get(3)));
+        bhHelper.AssignStreams(nodes, 1);
+
+        sinkApps.Start(Seconds(0));
+        sourceApps.Start(Seconds(0));
+        sourceApps.Stop(Seconds(duration));
+        Simulator::Stop(Seconds(duration + 0.01));
+
+        auto start = std::chrono::steady_clock::now();
+        Simulator::Run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        Time total;
+        Time worst;
+        for (const auto& delay : g_fhDelays)
+        {
+            total += delay;
+            worst = std::max(worst, delay);
+        }
+        double mean =
+            g_fhDelays.empty() ? 0 : total.GetNanoSeconds() / 1000.0 / g_fhDelays.size();
+        std::cout << qdisc << "," << g_fhDelays.size() << "," << std::fixed
+                  << std::setprecision(3) << mean << "," << worst.GetNanoSeconds() / 1000.0
+                  << "," << g_bhBytes << ",";
+        Ptr<TasQueueDisc> tas = DynamicCast<TasQueueDisc>(qdiscs.Get(0));
+        if (tas)
+        {
+            for (uint32_t cls = 0; cls < 2; cls++)
+            {
+                const TasClassStats& stats = tas->GetClassStats(cls);
+                std::cout << (stats.nPackets ? stats.totalGateDelay.GetNanoSeconds() / 1000.0 /
+                                                   stats.nPackets
+                                             : 0)
+                          << ",";
+            }
+            std::cout << tas->GetNGateEvents() << ","
+                      << static_cast<uint64_t>((duration + 0.01) / (period * 1e-6) * 2) << ",";
+        }
+        else
+        {
+            std::cout << ",,,,";
+        }
+        std::cout << Simulator::GetEventCount() << "," << std::setprecision(2) << elapsed.count()
+                  << std::endl;
+        Simulator::Destroy();
+    }
+    return 0;
+}
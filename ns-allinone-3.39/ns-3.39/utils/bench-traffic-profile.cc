@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the number of packet sizes and gaps per second
+// drawn from the same fitted distribution with EmpiricalRandomVariable
+// (binary search in its CDF) and with a TrafficProfile (alias table and
+// gap quantiles).  The distribution has --points distinct packet sizes and
+// as many gap quantiles.  One CSV line is printed per combination.
+//
+// Sample usage:
+//   ./ns3 run 'bench-traffic-profile --samples=10000000 --points=1000'
+
+#include "ns3/core-module.h"
+#include "ns3/traffic-profile.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t samples = 10000000;
+    uint32_t points = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("samples", "Number of samples per combination", samples);
+    cmd.AddValue("points", "Number of packet sizes and of gap quantiles", points);
+    cmd.Parse(argc, argv);
+
+    // packet sizes with decreasing weights, gaps with a heavy tail
+    std::vector<uint32_t> sizes(points);
+    std::vector<double> weights(points);
+    std::vector<double> gaps(points);
+    for (uint32_t i = 0; i < points; i++)
+    {
+        sizes[i] = 64 + i * 8;
+        weights[i] = 1.0 / (i + 1);
+        double p = static_cast<double>(i) / points;
+        gaps[i] = 1e-6 * p / (1.001 - p);
+    }
+
+    Ptr<TrafficProfile> profile = Create<TrafficProfile>();
+    profile->AddState(sizes, weights, gaps);
+
+    Ptr<EmpiricalRandomVariable> empiricalSizes = CreateObject<EmpiricalRandomVariable>();
+    Ptr<EmpiricalRandomVariable> empiricalGaps = CreateObject<EmpiricalRandomVariable>();
+    empiricalGaps->SetInterpolate(true);
+    double total = 0;
+    for (double w : weights)
+    {
+        total += w;
+    }
+    double cdf = 0;
+    for (uint32_t i = 0; i < points; i++)
+    {
+        cdf += weights[i] / total;
+        empiricalSizes->CDF(sizes[i], std::min(cdf, 1.0));
+        empiricalGaps->CDF(gaps[i], static_cast<double>(i) / (points - 1));
+    }
+    empiricalSizes->CDF(sizes.back(), 1.0);
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+
+    double sum = 0;
+    std::cout << "method,variable,points,samples,msamples_per_s" << std::endl;
+    for (std::string method : {"empirical", "profile"})
+    {
+        for (std::string variable : {"size", "gap"})
+        {
+            auto start = std::chrono::steady_clock::now();
+            if (method == "empirical")
+            {
+                Ptr<EmpiricalRandomVariable> rv =
+                    (variable == "size") ? empiricalSizes : empiricalGaps;
+                for (uint32_t i = 0; i < samples; i++)
+                {
+                    sum += rv->GetValue();
+                }
+            }
+            else if (variable == "size")
+            {
+                for (uint32_t i = 0; i < samples; i++)
+                {
+                    sum += profile->GetPacketSize(0, uniform->GetValue());
+                }
+            }
+            else
+            {
+                for (uint32_t i = 0; i < samples; i++)
+                {
+                    sum += profile->GetGap(0, uniform->GetValue());
+                }
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            std::cout << method << "," << variable << "," << points << "," << samples << ","
+                      << std::fixed << std::setprecision(1) << samples / elapsed.count() / 1e6
+                      << std::endl;
+        }
+    }
+    // keep the samples alive
+    NS_ABORT_MSG_IF(sum < 0, "Negative sum of samples");
+    return 0;
+}
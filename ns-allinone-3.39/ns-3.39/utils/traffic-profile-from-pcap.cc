@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Universidad de Cantabria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program fits a traffic profile (see ns3::TrafficProfile) to the
+// frames of a capture and writes it for the "Profile" generators of
+// Distributionapp.  The packet sizes are the frame sizes or, with
+// --ecpri, the sizes of the eCPRI PDUs (as sent by PcapReplayApplication),
+// in which case the frames that are not eCPRI are ignored.  With a
+// positive --burstGap the profile has a state for the packets within a
+// burst and a state for the last packet of a burst.
+//
+// Sample usage:
+//   ./ns3 run 'traffic-profile-from-pcap --input=fh.pcap --output=fh.tprof
+//              --ecpri=1 --burstGap=2e-6'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/pcap-replay-application.h"
+#include "ns3/traffic-profile.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output = "profile.tprof";
+    bool ecpri = false;
+    double burstGap = 0;
+    uint32_t quantiles = 1001;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("input", "Capture (pcap file with Ethernet frames)", input);
+    cmd.AddValue("output", "Traffic profile", output);
+    cmd.AddValue("ecpri", "Keep the eCPRI PDUs only", ecpri);
+    cmd.AddValue("burstGap", "Longest gap within a burst in seconds (0 for a single state)", burstGap);
+    cmd.AddValue("quantiles", "Number of gap quantiles per state", quantiles);
+    cmd.Parse(argc, argv);
+    NS_ABORT_MSG_IF(input.empty(), "No capture given (--input)");
+
+    PcapFile file;
+    file.Open(input, std::ios::in);
+    NS_ABORT_MSG_IF(file.Fail(), "Cannot open " << input);
+    double scale = file.IsNanoSecMode() ? 1e-9 : 1e-6;
+    std::vector<uint8_t> frame(file.GetSnapLen());
+
+    std::vector<uint32_t> sizes;
+    std::vector<double> times;
+    while (true)
+    {
+        uint32_t tsSec;
+        uint32_t tsFrac;
+        uint32_t inclLen;
+        uint32_t origLen;
+        uint32_t readLen;
+        file.Read(frame.data(), frame.size(), tsSec, tsFrac, inclLen, origLen, readLen);
+        if (file.Fail())
+        {
+            break;
+        }
+        uint32_t size = origLen;
+        if (ecpri)
+        {
+            PcapReplayApplication::EcpriInfo info;
+            if (!PcapReplayApplication::DecodeEcpri(frame.data(), readLen, info))
+            {
+                continue;
+            }
+            size = origLen - info.headerLength;
+        }
+        sizes.push_back(size);
+        times.push_back(tsSec + tsFrac * scale);
+    }
+    file.Close();
+    NS_ABORT_MSG_IF(sizes.size() < 2, "Not enough frames in " << input);
+
+    // the last frame has no gap
+    std::vector<double> gaps(sizes.size() - 1);
+    for (std::size_t i = 0; i + 1 < times.size(); i++)
+    {
+        gaps[i] = std::max(0.0, times[i + 1] - times[i]);
+    }
+    sizes.pop_back();
+
+    Ptr<TrafficProfile> profile = TrafficProfile::Fit(sizes, gaps, burstGap, quantiles);
+    profile->Save(output);
+    std::cout << "Fitted " << profile->GetNStates() << " state(s) to " << sizes.size()
+              << " gaps of " << input << " in " << output << std::endl;
+    return 0;
+}
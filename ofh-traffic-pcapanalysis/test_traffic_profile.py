@@ -0,0 +1,69 @@
+"""Check that traffic_profile.py writes the same files as the C++ fitter.
+
+A capture is fitted by traffic-profile-from-pcap (from the ns-3 build) and
+by fit() and write_profile(), and the two profiles are compared byte for
+byte.  Run from this directory, after building ns-3:
+
+    python3 -m unittest test_traffic_profile
+
+NS3_TRAFFIC_PROFILE_FROM_PCAP overrides the path of the program.
+"""
+
+import os
+import struct
+import subprocess
+import tempfile
+import unittest
+
+import numpy as np
+
+from traffic_profile import fit, write_profile
+
+PROGRAM = os.environ.get(
+    'NS3_TRAFFIC_PROFILE_FROM_PCAP',
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'ns-allinone-3.39',
+                 'ns-3.39', 'build', 'utils', 'ns3.39-traffic-profile-from-pcap'))
+
+
+def write_pcap(filename, sizes, times_ns):
+    """Write zeroed Ethernet frames with nanosecond timestamps."""
+    with open(filename, 'wb') as f:
+        f.write(struct.pack('<IHHiIII', 0xa1b23c4d, 2, 4, 0, 0, 65535, 1))
+        for size, t in zip(sizes, times_ns):
+            f.write(struct.pack('<IIII', t // 10**9, t % 10**9, size, size))
+            f.write(bytes(size))
+
+
+class TrafficProfileTestCase(unittest.TestCase):
+
+    @unittest.skipUnless(os.path.exists(PROGRAM), 'ns-3 is not built')
+    def test_same_file_as_ns3(self):
+        # bursts of frames 1 to 2 us apart, separated by gaps of about 100 us
+        rng = np.random.default_rng(1)
+        n = 5000
+        sizes = rng.choice([64, 1000, 1442, 8000], size=n, p=[0.1, 0.2, 0.6, 0.1])
+        burst_end = rng.random(n) < 0.05
+        gaps_ns = np.where(burst_end, rng.integers(50000, 150000, n), rng.integers(1000, 2000, n))
+        times_ns = np.concatenate(([10**9 - 500000], 10**9 - 500000 + np.cumsum(gaps_ns[:-1])))
+
+        with tempfile.TemporaryDirectory() as tmp:
+            pcap = os.path.join(tmp, 'fh.pcap')
+            write_pcap(pcap, sizes.tolist(), times_ns.tolist())
+            ns3_file = os.path.join(tmp, 'ns3.tprof')
+            subprocess.run([PROGRAM, '--input=' + pcap, '--output=' + ns3_file,
+                            '--burstGap=2e-6'], check=True, capture_output=True)
+
+            # the timestamps and gaps as computed by traffic-profile-from-pcap
+            times = [t // 10**9 + (t % 10**9) * 1e-9 for t in times_ns.tolist()]
+            gaps = [max(0.0, b - a) for a, b in zip(times[:-1], times[1:])]
+            python_file = os.path.join(tmp, 'python.tprof')
+            write_profile(python_file, fit(sizes[:-1], gaps, burst_gap=2e-6))
+
+            with open(ns3_file, 'rb') as f:
+                expected = f.read()
+            with open(python_file, 'rb') as f:
+                self.assertEqual(f.read(), expected)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,112 @@
+"""Traffic profiles for the "Profile" generators of ns3::Distributionapp.
+
+A profile has one or more states, each with an alias table of packet sizes
+and the quantiles of the gaps between packets (in seconds) at equally
+spaced probabilities.  With several states the state changes after every
+packet according to a Markov chain.  The file format is documented in
+src/applications/model/traffic-profile.h; this module writes the same
+tables as ns3::TrafficProfile::Fit.
+
+Example, from the sizes and timestamps of the frames of a capture:
+
+    sizes, gaps = frames[:-1], np.diff(timestamps)
+    write_profile('fh.tprof', fit(sizes, gaps, burst_gap=2e-6))
+"""
+
+import struct
+
+import numpy as np
+
+MAGIC = b'ns3tprof'
+VERSION = 1
+
+
+def alias_table(weights):
+    """Alias table (Vose) of the given weights: (alias, threshold)."""
+    weights = np.asarray(weights, dtype=float)
+    n = len(weights)
+    scaled = weights * n / weights.sum()
+    alias = list(range(n))
+    threshold = [1.0] * n
+    small = [i for i in range(n) if scaled[i] < 1]
+    large = [i for i in range(n) if scaled[i] >= 1]
+    while small and large:
+        s = small.pop()
+        l = large[-1]
+        threshold[s] = scaled[s]
+        alias[s] = l
+        scaled[l] -= 1 - scaled[s]
+        if scaled[l] < 1:
+            large.pop()
+            small.append(l)
+    return alias, threshold
+
+
+def gap_quantiles(values, n):
+    """Quantiles of values at probabilities i / (n - 1), interpolated
+    linearly between order statistics.
+
+    The operations are those of Quantiles() in traffic-profile.cc, so that
+    the values are bit for bit the same (np.quantile rounds differently).
+    """
+    values = sorted(float(v) for v in values)
+    quantiles = []
+    for i in range(n):
+        position = float(i) * (len(values) - 1) / (n - 1)
+        k = int(position)
+        if k + 1 >= len(values):
+            quantiles.append(values[-1])
+        else:
+            quantiles.append(values[k] + (position - k) * (values[k + 1] - values[k]))
+    return np.array(quantiles)
+
+
+def fit(sizes, gaps, burst_gap=0, quantiles=1001):
+    """Fit a profile to the packet sizes and the gap after each packet.
+
+    With a positive burst_gap there are two states: the packets followed by
+    a gap not longer than burst_gap (state 0) and the others (state 1).
+    Returns a dict with the 'states' (list of (sizes, weights, gap
+    quantiles)) and the 'transitions' (matrix of counts or None).
+    """
+    sizes = np.asarray(sizes)
+    gaps = np.asarray(gaps, dtype=float)
+    assert len(sizes) == len(gaps), 'one gap per packet expected'
+    state_of = np.zeros(len(sizes), dtype=int)
+    if burst_gap > 0:
+        state_of = (gaps > burst_gap).astype(int)
+        if state_of.min() == state_of.max():
+            state_of[:] = 0
+    n_states = state_of.max() + 1
+    states = []
+    for s in range(n_states):
+        values, counts = np.unique(sizes[state_of == s], return_counts=True)
+        states.append((values, counts, gap_quantiles(gaps[state_of == s], quantiles)))
+    transitions = None
+    if n_states > 1:
+        transitions = np.zeros((n_states, n_states))
+        np.add.at(transitions, (state_of[:-1], state_of[1:]), 1)
+        for s in range(n_states):
+            if transitions[s].sum() == 0:
+                transitions[s, s] = 1
+    return {'states': states, 'transitions': transitions}
+
+
+def write_profile(filename, profile):
+    """Write a profile returned by fit()."""
+    states = profile['states']
+    with open(filename, 'wb') as f:
+        f.write(MAGIC)
+        f.write(struct.pack('<II', VERSION, len(states)))
+        for values, weights, gap_quantiles in states:
+            alias, threshold = alias_table(weights)
+            f.write(struct.pack('<I', len(values)))
+            for value, a, t in zip(values, alias, threshold):
+                f.write(struct.pack('<IId', int(value), a, t))
+            f.write(struct.pack('<I', len(gap_quantiles)))
+            f.write(struct.pack('<%dd' % len(gap_quantiles), *gap_quantiles))
+        if len(states) > 1:
+            for row in profile['transitions']:
+                alias, threshold = alias_table(row)
+                for a, t in zip(alias, threshold):
+                    f.write(struct.pack('<Id', a, t))